@@ -175,6 +175,7 @@ std::vector<String> Client::loadWarningMessages()
                 return messages;
 
             case Protocol::Server::ProfileEvents:
+            case Protocol::Server::PartialResult:
                 continue;
 
             default:
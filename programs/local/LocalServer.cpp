@@ -583,6 +583,11 @@ void LocalServer::processConfig()
     if (mark_cache_size)
         global_context->setMarkCache(mark_cache_size, mark_cache_policy);
 
+    /// Size of cache for deserialized columns of MergeTree parts. Zero means disabled.
+    size_t columns_cache_size = config().getUInt64("columns_cache_size", 0);
+    if (columns_cache_size)
+        global_context->setColumnsCache(columns_cache_size);
+
     /// Size of cache for uncompressed blocks of MergeTree indices. Zero means disabled.
     size_t index_uncompressed_cache_size = config().getUInt64("index_uncompressed_cache_size", 0);
     if (index_uncompressed_cache_size)
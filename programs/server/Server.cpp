@@ -37,6 +37,7 @@
 #include <Common/ProfileEvents.h>
 #include <Common/ThreadProfileEvents.h>
 #include <Common/ThreadStatus.h>
+#include <Common/Allocator.h>
 #include <Common/getMappedArea.h>
 #include <Common/remapExecutable.h>
 #include <Common/TLDListsHolder.h>
@@ -880,6 +881,18 @@ try
             LOG_DEBUG(log, "The code ({}) in memory has been successfully remapped.", ReadableSize(size));
         }
 
+        if (config().getBool("numa_interleave_large_allocations", false))
+        {
+            LOG_DEBUG(log, "Will interleave large allocations across NUMA nodes.");
+            numa_interleave_large_allocations = true;
+        }
+
+        if (size_t aligned_buffer_pool_size = config().getUInt64("aligned_buffer_pool_size", 0))
+        {
+            LOG_DEBUG(log, "Will reuse large aligned buffers, up to {}.", ReadableSize(aligned_buffer_pool_size));
+            AlignedBufferFreeList::instance().setMaxBytes(aligned_buffer_pool_size);
+        }
+
         if (config().getBool("mlock_executable", false))
         {
             if (hasLinuxCapability(CAP_IPC_LOCK))
@@ -1205,6 +1218,15 @@ try
             total_memory_tracker.setDescription("(total)");
             total_memory_tracker.setMetric(CurrentMetrics::MemoryTracking);
 
+            /// When total memory usage exceeds this share of the hard limit, spillable operators
+            /// of running queries are asked to release memory instead of waiting until the hard
+            /// limit kills the largest query. See MemoryPressureArbitrator.
+            double memory_pressure_spill_threshold_ratio = config->getDouble("memory_pressure_spill_threshold_ratio", 0.0);
+            if (memory_pressure_spill_threshold_ratio > 0.0 && memory_pressure_spill_threshold_ratio < 1.0)
+                total_memory_tracker.setSoftLimit(static_cast<Int64>(max_server_memory_usage * memory_pressure_spill_threshold_ratio));
+            else
+                total_memory_tracker.setSoftLimit(0);
+
             bool allow_use_jemalloc_memory = config->getBool("allow_use_jemalloc_memory", true);
             total_memory_tracker.setAllowUseJemallocMemory(allow_use_jemalloc_memory);
 
@@ -1501,6 +1523,16 @@ try
     }
     global_context->setMarkCache(mark_cache_size, mark_cache_policy);
 
+    /// Size of cache for deserialized columns of MergeTree parts. Zero means disabled.
+    size_t columns_cache_size = config().getUInt64("columns_cache_size", 0);
+    if (columns_cache_size)
+        global_context->setColumnsCache(columns_cache_size);
+
+    /// Size of cache for filter condition results at granule granularity. Zero means disabled.
+    size_t query_condition_cache_size = config().getUInt64("query_condition_cache_size", 100_MiB);
+    if (query_condition_cache_size)
+        global_context->setQueryConditionCache(query_condition_cache_size);
+
     /// Size of cache for uncompressed blocks of MergeTree indices. Zero means disabled.
     size_t index_uncompressed_cache_size = config().getUInt64("index_uncompressed_cache_size", 0);
     if (index_uncompressed_cache_size)
@@ -1525,6 +1557,11 @@ try
             config().getUInt64("query_result_cache.max_entry_size", 1_MiB),
             config().getUInt64("query_result_cache.max_entry_records", 30'000'000));
 
+    /// A cache for parsed query ASTs.
+    size_t query_ast_cache_max_entries = config().getUInt64("query_ast_cache_max_entries", 1024);
+    if (query_ast_cache_max_entries)
+        global_context->setQueryASTCache(query_ast_cache_max_entries);
+
 #if USE_EMBEDDED_COMPILER
     /// 128 MB
     constexpr size_t compiled_expression_cache_size_default = 1024 * 1024 * 128;
@@ -1534,6 +1571,12 @@ try
     size_t compiled_expression_cache_elements_size = config().getUInt64("compiled_expression_cache_elements_size", compiled_expression_cache_elements_size_default);
 
     CompiledExpressionCacheFactory::instance().init(compiled_expression_cache_size, compiled_expression_cache_elements_size);
+
+    /// Optional on-disk cache of compiled object code, so hot expressions do not have to be
+    /// compiled again after a server restart.
+    String compiled_expression_cache_path = config().getString("compiled_expression_cache_path", "");
+    if (!compiled_expression_cache_path.empty())
+        CHJIT::setCompiledObjectCachePath(compiled_expression_cache_path);
 #endif
 
     /// Set path for format schema files
@@ -11,6 +11,7 @@
 #include <DataTypes/DataTypesNumber.h>
 #include <base/StringRef.h>
 #include <Common/assert_cast.h>
+#include <Common/TargetSpecific.h>
 #include <DataTypes/DataTypeNullable.h>
 #include <AggregateFunctions/IAggregateFunction.h>
 
@@ -177,6 +178,121 @@ public:
             return false;
     }
 
+    /// For these types the batch extremum can be found with a vectorized kernel, see below.
+    /// Floating point values are excluded because the branchless min/max would change the
+    /// (unspecified) behaviour of the scalar version w.r.t. NaNs.
+    static constexpr bool has_vectorized_extremum = is_integer<T> && !is_big_int_v<T>;
+
+    /// Vectorized version
+    MULTITARGET_FUNCTION_AVX2_SSE42(
+    MULTITARGET_FUNCTION_HEADER(
+    template <bool is_less>
+    static T NO_INLINE
+    ), findExtremumImpl, MULTITARGET_FUNCTION_BODY((const T * __restrict ptr, size_t start, size_t end) /// NOLINT
+    {
+        T best = ptr[start];
+        for (size_t i = start + 1; i < end; ++i)
+        {
+            if constexpr (is_less)
+                best = std::min(best, ptr[i]);
+            else
+                best = std::max(best, ptr[i]);
+        }
+        return best;
+    })
+    )
+
+    /// Vectorized version: the condition map is processed as a SIMD predicate (select + min/max)
+    /// instead of a per-row branch, same as the conditional sums in AggregateFunctionSum.
+    MULTITARGET_FUNCTION_AVX2_SSE42(
+    MULTITARGET_FUNCTION_HEADER(
+    template <bool is_less, bool add_if_zero>
+    static std::optional<T> NO_INLINE
+    ), findExtremumConditionalImpl, MULTITARGET_FUNCTION_BODY((const T * __restrict ptr, const UInt8 * __restrict condition_map, size_t start, size_t end) /// NOLINT
+    {
+        /// Rows filtered out by the condition are replaced with the neutral element,
+        /// so they cannot affect the result.
+        constexpr T neutral = is_less ? std::numeric_limits<T>::max() : std::numeric_limits<T>::lowest();
+
+        T best = neutral;
+        size_t matched_rows = 0;
+
+        for (size_t i = start; i < end; ++i)
+        {
+            bool matched = !condition_map[i] == add_if_zero;
+            matched_rows += matched;
+
+            T candidate = matched ? ptr[i] : neutral;
+            if constexpr (is_less)
+                best = std::min(best, candidate);
+            else
+                best = std::max(best, candidate);
+        }
+
+        if (!matched_rows)
+            return std::nullopt;
+        return best;
+    })
+    )
+
+    template <bool is_less>
+    static T findExtremum(const T * __restrict ptr, size_t start, size_t end)
+    {
+#if USE_MULTITARGET_CODE
+        if (isArchSupported(TargetArch::AVX2))
+            return findExtremumImplAVX2<is_less>(ptr, start, end);
+        else if (isArchSupported(TargetArch::SSE42))
+            return findExtremumImplSSE42<is_less>(ptr, start, end);
+#endif
+        return findExtremumImpl<is_less>(ptr, start, end);
+    }
+
+    template <bool is_less, bool add_if_zero>
+    static std::optional<T> findExtremumConditional(const T * __restrict ptr, const UInt8 * __restrict condition_map, size_t start, size_t end)
+    {
+#if USE_MULTITARGET_CODE
+        if (isArchSupported(TargetArch::AVX2))
+            return findExtremumConditionalImplAVX2<is_less, add_if_zero>(ptr, condition_map, start, end);
+        else if (isArchSupported(TargetArch::SSE42))
+            return findExtremumConditionalImplSSE42<is_less, add_if_zero>(ptr, condition_map, start, end);
+#endif
+        return findExtremumConditionalImpl<is_less, add_if_zero>(ptr, condition_map, start, end);
+    }
+
+    /// Change the value if 'new_value' is better w.r.t. the comparison direction.
+    template <bool is_less>
+    void ALWAYS_INLINE changeIfBetterValue(T new_value)
+    {
+        if (!has() || (is_less ? new_value < value : new_value > value))
+        {
+            has_value = true;
+            value = new_value;
+        }
+    }
+
+    /// Batch versions for min/max: find the extremum of the whole batch with a vectorized kernel,
+    /// then update the state once, instead of a per-row branchy comparison through virtual calls.
+    template <bool is_less>
+    void changeIfBetterBatch(const IColumn & column, size_t row_begin, size_t row_end)
+    {
+        if (row_begin >= row_end)
+            return;
+
+        const auto & vec = assert_cast<const ColVecType &>(column).getData();
+        changeIfBetterValue<is_less>(findExtremum<is_less>(vec.data(), row_begin, row_end));
+    }
+
+    template <bool is_less, bool add_if_zero>
+    void changeIfBetterBatchConditional(const IColumn & column, const UInt8 * __restrict condition_map, size_t row_begin, size_t row_end)
+    {
+        if (row_begin >= row_end)
+            return;
+
+        const auto & vec = assert_cast<const ColVecType &>(column).getData();
+        if (auto extremum = findExtremumConditional<is_less, add_if_zero>(vec.data(), condition_map, row_begin, row_end))
+            changeIfBetterValue<is_less>(*extremum);
+    }
+
     bool isEqualTo(const Self & to) const
     {
         return has() && to.value == value;
@@ -1008,6 +1124,29 @@ struct AggregateFunctionMaxData : Data
 #endif
 };
 
+/// Whether the batch of values can be processed with the vectorized extremum kernels
+/// of SingleValueDataFixed (and in which comparison direction).
+template <typename Data>
+struct ExtremumBatchTraits
+{
+    static constexpr bool enabled = false;
+    static constexpr bool is_less = false;
+};
+
+template <typename T>
+struct ExtremumBatchTraits<AggregateFunctionMinData<SingleValueDataFixed<T>>>
+{
+    static constexpr bool enabled = SingleValueDataFixed<T>::has_vectorized_extremum;
+    static constexpr bool is_less = true;
+};
+
+template <typename T>
+struct ExtremumBatchTraits<AggregateFunctionMaxData<SingleValueDataFixed<T>>>
+{
+    static constexpr bool enabled = SingleValueDataFixed<T>::has_vectorized_extremum;
+    static constexpr bool is_less = false;
+};
+
 template <typename Data>
 struct AggregateFunctionAnyData : Data
 {
@@ -1268,6 +1407,20 @@ public:
         if constexpr (is_any)
             if (this->data(place).has())
                 return;
+
+        if constexpr (ExtremumBatchTraits<Data>::enabled)
+        {
+            constexpr bool is_less = ExtremumBatchTraits<Data>::is_less;
+            if (if_argument_pos >= 0)
+            {
+                const auto & flags = assert_cast<const ColumnUInt8 &>(*columns[if_argument_pos]).getData();
+                this->data(place).template changeIfBetterBatchConditional<is_less, false>(*columns[0], flags.data(), row_begin, row_end);
+            }
+            else
+                this->data(place).template changeIfBetterBatch<is_less>(*columns[0], row_begin, row_end);
+            return;
+        }
+
         if (if_argument_pos >= 0)
         {
             const auto & flags = assert_cast<const ColumnUInt8 &>(*columns[if_argument_pos]).getData();
@@ -1305,6 +1458,24 @@ public:
             if (this->data(place).has())
                 return;
 
+        if constexpr (ExtremumBatchTraits<Data>::enabled)
+        {
+            constexpr bool is_less = ExtremumBatchTraits<Data>::is_less;
+            if (if_argument_pos >= 0)
+            {
+                /// Merge the 2 sets of flags (null and if) into a single one to use the vectorized kernel
+                const auto * if_flags = assert_cast<const ColumnUInt8 &>(*columns[if_argument_pos]).getData().data();
+                auto final_flags = std::make_unique<UInt8[]>(row_end);
+                for (size_t i = row_begin; i < row_end; ++i)
+                    final_flags[i] = (!null_map[i]) & if_flags[i];
+
+                this->data(place).template changeIfBetterBatchConditional<is_less, false>(*columns[0], final_flags.get(), row_begin, row_end);
+            }
+            else
+                this->data(place).template changeIfBetterBatchConditional<is_less, true>(*columns[0], null_map, row_begin, row_end);
+            return;
+        }
+
         if (if_argument_pos >= 0)
         {
             const auto & flags = assert_cast<const ColumnUInt8 &>(*columns[if_argument_pos]).getData();
@@ -7,7 +7,9 @@
 #include <Core/ColumnNumbers.h>
 #include <Core/Field.h>
 #include <Interpreters/Context_fwd.h>
+#include <IO/ReadBuffer.h>
 #include <base/types.h>
+#include <Common/Arena.h>
 #include <Common/Exception.h>
 #include <Common/ThreadPool.h>
 #include <Core/IResolvedFunction.h>
@@ -332,6 +334,20 @@ public:
         AggregateDataPtr * places,
         size_t place_offset) const noexcept = 0;
 
+    /** Create and deserialize a batch of up to `limit` aggregate states with a single virtual call.
+      * Each state is allocated in the arena, created and deserialized from buf, and appended to places;
+      * deserialization stops early when buf is exhausted. It is used for columns of aggregate states
+      * received from remote shards, where a virtual call per row noticeably slows down the merge.
+      * On exception the state being deserialized is destroyed; states already appended to places
+      * are left to the owner of places, as after a per-row deserialize loop.
+      */
+    virtual void createAndDeserializeBatch(
+        PODArray<AggregateDataPtr> & places,
+        Arena & arena,
+        size_t limit,
+        ReadBuffer & buf,
+        std::optional<size_t> version) const = 0;
+
     /** By default all NULLs are skipped during aggregation.
      *  If it returns nullptr, the default one will be used.
      *  If an aggregate function wants to use something instead of the default one, it overrides this function and returns its own null adapter.
@@ -690,6 +706,39 @@ public:
             static_cast<const Derived *>(this)->destroy(places[i] + place_offset);
         }
     }
+
+    void createAndDeserializeBatch(
+        PODArray<AggregateDataPtr> & places,
+        Arena & arena,
+        size_t limit,
+        ReadBuffer & buf,
+        std::optional<size_t> version) const override
+    {
+        size_t size_of_state = static_cast<const Derived *>(this)->sizeOfData();
+        size_t align_of_state = static_cast<const Derived *>(this)->alignOfData();
+
+        for (size_t i = 0; i < limit; ++i)
+        {
+            if (buf.eof())
+                break;
+
+            AggregateDataPtr place = arena.alignedAlloc(size_of_state, align_of_state);
+
+            static_cast<const Derived *>(this)->create(place);
+
+            try
+            {
+                static_cast<const Derived *>(this)->deserialize(place, buf, version, &arena);
+            }
+            catch (...)
+            {
+                static_cast<const Derived *>(this)->destroy(place);
+                throw;
+            }
+
+            places.push_back(place);
+        }
+    }
 };
 
 
@@ -292,8 +292,14 @@ public:
 
     void merge(const QuantileTDigest & other)
     {
-        for (const auto & c : other.centroids)
-            addCentroid(c);
+        /// Merging compressed digests centroid by centroid through addCentroid() re-sorts
+        /// and re-compresses the accumulator every max_unmerged centroids. Appending the
+        /// other digest's centroids in bulk triggers compression at most once per merge.
+        centroids.insert(other.centroids.begin(), other.centroids.end());
+        count += other.count;
+        unmerged += other.centroids.size();
+        if (unmerged > params.max_unmerged)
+            compress();
     }
 
     void serialize(WriteBuffer & buf)
@@ -71,9 +71,10 @@ public:
 
             const bool is_like  = arg_func->getFunctionName() == "like";
             const bool is_ilike = arg_func->getFunctionName() == "ilike";
+            const bool is_match = arg_func->getFunctionName() == "match";
 
-            /// Not {i}like -> bail out.
-            if (!is_like && !is_ilike)
+            /// Not {i}like/match -> bail out.
+            if (!is_like && !is_ilike && !is_match)
                 continue;
 
             const auto & like_arguments = arg_func->getArguments().getNodes();
@@ -85,7 +86,9 @@ public:
             if (!pattern || !isString(pattern->getResultType()))
                 continue;
 
-            auto regexp = likePatternToRegexp(pattern->getValue().get<String>());
+            /// `match` takes a ready regexp with the same unanchored semantics as multiMatchAny.
+            auto regexp = is_match ? pattern->getValue().get<String>()
+                                   : likePatternToRegexp(pattern->getValue().get<String>());
             /// Case insensitive. Works with UTF-8 as well.
             if (is_ilike)
                 regexp = "(?i)" + regexp;
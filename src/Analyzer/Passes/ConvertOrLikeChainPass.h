@@ -5,14 +5,14 @@
 namespace DB
 {
 
-/** Replaces all the "or"'s with {i}like to multiMatchAny
+/** Replaces all the "or"'s with {i}like/match to multiMatchAny
  */
 class ConvertOrLikeChainPass final : public IQueryTreePass
 {
 public:
     String getName() override { return "ConvertOrLikeChain"; }
 
-    String getDescription() override { return "Replaces all the 'or's with {i}like to multiMatchAny"; }
+    String getDescription() override { return "Replaces all the 'or's with {i}like/match to multiMatchAny"; }
 
     void run(QueryTreeNodePtr query_tree_node, ContextPtr context) override;
 };
@@ -63,18 +63,20 @@ public:
 
         if (function_arguments_nodes_size == 1)
         {
-            if (column_type.isArray())
+            if (column_type.isArray() || column_type.isMap())
             {
+                /// Map is serialized as a nested Array(Tuple(keys, values)),
+                /// so it shares the size0 subcolumn with arrays.
                 if (function_name == "length")
                 {
-                    /// Replace `length(array_argument)` with `array_argument.size0`
+                    /// Replace `length(array_or_map_argument)` with `array_or_map_argument.size0`
                     column.name += ".size0";
 
                     node = std::make_shared<ColumnNode>(column, column_source);
                 }
                 else if (function_name == "empty")
                 {
-                    /// Replace `empty(array_argument)` with `equals(array_argument.size0, 0)`
+                    /// Replace `empty(array_or_map_argument)` with `equals(array_or_map_argument.size0, 0)`
                     column.name += ".size0";
                     column.type = std::make_shared<DataTypeUInt64>();
 
@@ -86,7 +88,7 @@ public:
                 }
                 else if (function_name == "notEmpty")
                 {
-                    /// Replace `notEmpty(array_argument)` with `notEquals(array_argument.size0, 0)`
+                    /// Replace `notEmpty(array_or_map_argument)` with `notEquals(array_or_map_argument.size0, 0)`
                     column.name += ".size0";
                     column.type = std::make_shared<DataTypeUInt64>();
 
@@ -96,6 +98,22 @@ public:
 
                     resolveOrdinaryFunctionNode(*function_node, "notEquals");
                 }
+                else if (function_name == "mapKeys" && column_type.isMap())
+                {
+                    /// Replace `mapKeys(map_argument)` with `map_argument.keys`
+                    column.name += ".keys";
+                    column.type = function_node->getResultType();
+
+                    node = std::make_shared<ColumnNode>(column, column_source);
+                }
+                else if (function_name == "mapValues" && column_type.isMap())
+                {
+                    /// Replace `mapValues(map_argument)` with `map_argument.values`
+                    column.name += ".values";
+                    column.type = function_node->getResultType();
+
+                    node = std::make_shared<ColumnNode>(column, column_source);
+                }
             }
             else if (column_type.isNullable())
             {
@@ -117,25 +135,6 @@ public:
                     resolveOrdinaryFunctionNode(*function_node, "not");
                 }
             }
-            else if (column_type.isMap())
-            {
-                if (function_name == "mapKeys")
-                {
-                    /// Replace `mapKeys(map_argument)` with `map_argument.keys`
-                    column.name += ".keys";
-                    column.type = function_node->getResultType();
-
-                    node = std::make_shared<ColumnNode>(column, column_source);
-                }
-                else if (function_name == "mapValues")
-                {
-                    /// Replace `mapValues(map_argument)` with `map_argument.values`
-                    column.name += ".values";
-                    column.type = function_node->getResultType();
-
-                    node = std::make_shared<ColumnNode>(column, column_source);
-                }
-            }
         }
         else
         {
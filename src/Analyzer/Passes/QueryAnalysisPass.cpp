@@ -1959,7 +1959,11 @@ void QueryAnalyzer::validateTableExpressionModifiers(const QueryTreeNodePtr & ta
                     "Storage {} doesn't support FINAL",
                     storage->getName());
 
-            if (table_expression_modifiers->hasSampleSizeRatio() && !storage->supportsSampling())
+            /// MergeTree tables without a sampling key may still be sampled by pseudo-random granule selection.
+            bool sample_without_sampling_key
+                = storage->isMergeTree() && scope.context->getSettingsRef().allow_sample_without_sampling_key;
+
+            if (table_expression_modifiers->hasSampleSizeRatio() && !storage->supportsSampling() && !sample_without_sampling_key)
                 throw Exception(ErrorCodes::SAMPLING_NOT_SUPPORTED,
                     "Storage {} doesn't support sampling",
                     storage->getStorageID().getFullNameNotQuoted());
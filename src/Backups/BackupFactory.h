@@ -35,6 +35,7 @@ public:
         std::shared_ptr<IBackupCoordination> backup_coordination;
         std::optional<UUID> backup_uuid;
         bool deduplicate_files = true;
+        bool use_content_addressed_store = false;
     };
 
     static BackupFactory & instance();
@@ -168,7 +168,8 @@ BackupImpl::BackupImpl(
     bool is_internal_backup_,
     const std::shared_ptr<IBackupCoordination> & coordination_,
     const std::optional<UUID> & backup_uuid_,
-    bool deduplicate_files_)
+    bool deduplicate_files_,
+    bool use_content_addressed_store_)
     : backup_name_for_logging(backup_name_for_logging_)
     , archive_params(archive_params_)
     , use_archives(!archive_params.archive_name.empty())
@@ -180,6 +181,7 @@ BackupImpl::BackupImpl(
     , version(CURRENT_BACKUP_VERSION)
     , base_backup_info(base_backup_info_)
     , deduplicate_files(deduplicate_files_)
+    , use_content_addressed_store(use_content_addressed_store_)
     , log(&Poco::Logger::get("BackupImpl"))
 {
     open(context_);
@@ -290,6 +292,7 @@ void BackupImpl::writeBackupMetadata()
     Poco::AutoPtr<Poco::Util::XMLConfiguration> config{new Poco::Util::XMLConfiguration()};
     config->setInt("version", CURRENT_BACKUP_VERSION);
     config->setBool("deduplicate_files", deduplicate_files);
+    config->setBool("use_content_addressed_store", use_content_addressed_store);
     config->setString("timestamp", toString(LocalDateTime{timestamp}));
     config->setString("uuid", toString(*uuid));
 
@@ -855,7 +858,12 @@ void BackupImpl::writeFile(const String & file_name, BackupEntryPtr entry)
     /// All "short paths" failed. We don't have this file in previous or existing backup
     /// or have only prefix of it in previous backup. Let's go long path.
 
-    info.data_file_name = info.file_name;
+    /// In the content-addressed store data files are named by checksum, so identical parts
+    /// get identical blob names across replicas and across backup generations.
+    if (use_content_addressed_store)
+        info.data_file_name = ".store/" + formatSizeAndChecksum(std::pair{info.size, info.checksum});
+    else
+        info.data_file_name = info.file_name;
 
     if (use_archives)
     {
@@ -870,6 +878,14 @@ void BackupImpl::writeFile(const String & file_name, BackupEntryPtr entry)
         LOG_TRACE(log, "File {} doesn't exist in current backup, but we have file with same size and checksum", adjusted_path);
         return; /// We copy data only if it's a new combination of size & checksum.
     }
+
+    /// A blob with this checksum may be left in the destination by an interrupted attempt of the same backup.
+    if (use_content_addressed_store && !use_archives && writer->fileExists(info.data_file_name))
+    {
+        LOG_TRACE(log, "Blob {} for file {} already exists in the backup destination", info.data_file_name, adjusted_path);
+        return;
+    }
+
     auto writer_description = writer->getDataSourceDescription();
     auto reader_description = entry->getDataSourceDescription();
 
@@ -968,8 +984,16 @@ void BackupImpl::increaseUncompressedSize(UInt64 file_size)
 
 void BackupImpl::increaseUncompressedSize(const FileInfo & info)
 {
-    if ((info.size > info.base_size) && (info.data_file_name.empty() || (info.data_file_name == info.file_name)))
-        increaseUncompressedSize(info.size - info.base_size);
+    if (info.size <= info.base_size)
+        return;
+
+    /// Multiple entries can reference the same data file (deduplication, content-addressed store),
+    /// count each data file only once.
+    const String & data_file_name = info.data_file_name.empty() ? info.file_name : info.data_file_name;
+    if (!counted_data_files.emplace(data_file_name).second)
+        return;
+
+    increaseUncompressedSize(info.size - info.base_size);
 }
 
 void BackupImpl::setCompressedSize()
@@ -5,6 +5,7 @@
 #include <Backups/BackupInfo.h>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 
 namespace DB
@@ -50,7 +51,8 @@ public:
         bool is_internal_backup_,
         const std::shared_ptr<IBackupCoordination> & coordination_,
         const std::optional<UUID> & backup_uuid_,
-        bool deduplicate_files_);
+        bool deduplicate_files_,
+        bool use_content_addressed_store_ = false);
 
     ~BackupImpl() override;
 
@@ -134,6 +136,8 @@ private:
     std::atomic<size_t> num_files_written = 0;
     bool writing_finalized = false;
     bool deduplicate_files = true;
+    bool use_content_addressed_store = false;
+    std::unordered_set<String> counted_data_files;
     const Poco::Logger * log;
 };
 
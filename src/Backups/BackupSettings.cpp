@@ -24,6 +24,7 @@ namespace ErrorCodes
     M(Bool, structure_only) \
     M(Bool, async) \
     M(Bool, deduplicate_files) \
+    M(Bool, use_content_addressed_store) \
     M(UInt64, shard_num) \
     M(UInt64, replica_num) \
     M(Bool, internal) \
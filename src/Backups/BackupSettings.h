@@ -35,6 +35,12 @@ struct BackupSettings
     /// Whether the BACKUP will omit similar files (within one backup only).
     bool deduplicate_files = true;
 
+    /// Whether to name data files in the backup by their checksum instead of the original path.
+    /// Identical parts get identical blob names across replicas and across backup generations,
+    /// so backup repositories can deduplicate blobs between backups, and a retried backup
+    /// reuses blobs which are already present in the destination.
+    bool use_content_addressed_store = false;
+
     /// 1-based shard index to store in the backup. 0 means all shards.
     /// Can only be used with BACKUP ON CLUSTER.
     size_t shard_num = 0;
@@ -122,7 +122,8 @@ void registerBackupEngineS3(BackupFactory & factory)
                 params.is_internal_backup,
                 params.backup_coordination,
                 params.backup_uuid,
-                params.deduplicate_files);
+                params.deduplicate_files,
+                params.use_content_addressed_store);
         }
 #else
         throw Exception(ErrorCodes::SUPPORT_IS_DISABLED, "S3 support is disabled");
@@ -190,7 +190,8 @@ void registerBackupEnginesFileAndDisk(BackupFactory & factory)
                 params.is_internal_backup,
                 params.backup_coordination,
                 params.backup_uuid,
-                params.deduplicate_files);
+                params.deduplicate_files,
+                params.use_content_addressed_store);
         }
     };
 
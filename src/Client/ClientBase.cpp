@@ -477,6 +477,30 @@ void ClientBase::onLogData(Block & block)
 }
 
 
+void ClientBase::onPartialResult(Block & block)
+{
+    /// Partial results are auxiliary: render them only for a human watching the terminal.
+    if (!block || !is_interactive)
+        return;
+
+    if (need_render_progress && tty_buf)
+        progress_indication.clearProgressOutput(*tty_buf);
+
+    /// They are written to stderr so that the regular output (which may be redirected
+    /// to a file or a pager) contains only the final result.
+    WriteBufferFromFileDescriptor err_buf(STDERR_FILENO);
+    writeString("Partial result (not final):\n", err_buf);
+
+    auto format = global_context->getOutputFormat("PrettyCompact", err_buf, block);
+    format->write(materializeBlock(block));
+    format->finalize();
+    err_buf.next();
+
+    if (need_render_progress && tty_buf)
+        progress_indication.writeProgress(*tty_buf);
+}
+
+
 void ClientBase::onTotals(Block & block, ASTPtr parsed_query)
 {
     initOutputFormat(block, parsed_query);
@@ -1005,6 +1029,11 @@ bool ClientBase::receiveAndProcessPacket(ASTPtr parsed_query, bool cancelled_)
             onProfileEvents(packet.block);
             return true;
 
+        case Protocol::Server::PartialResult:
+            if (!cancelled_)
+                onPartialResult(packet.block);
+            return true;
+
         default:
             throw Exception(
                 ErrorCodes::UNKNOWN_PACKET_FROM_SERVER, "Unknown packet {} from server {}", packet.type, connection->getDescription());
@@ -1514,6 +1543,10 @@ bool ClientBase::receiveEndOfQuery()
                 onProfileEvents(packet.block);
                 break;
 
+            case Protocol::Server::PartialResult:
+                /// The final result is already being received, skip the outdated partial one.
+                break;
+
             default:
                 throw NetException(ErrorCodes::UNEXPECTED_PACKET_FROM_SERVER,
                     "Unexpected packet from server (expected Exception, EndOfStream, Log, Progress or ProfileEvents. Got {})",
@@ -4,6 +4,9 @@
 #include <Core/Settings.h>
 #include <Compression/CompressedReadBuffer.h>
 #include <Compression/CompressedWriteBuffer.h>
+#include <Compression/PipelinedCompressedWriteBuffer.h>
+#include <Common/typeid_cast.h>
+#include <IO/IOThreadPool.h>
 #include <IO/ReadBufferFromPocoSocket.h>
 #include <IO/WriteBufferFromPocoSocket.h>
 #include <IO/ReadHelpers.h>
@@ -21,6 +24,7 @@
 #include <Common/DNSResolver.h>
 #include <Common/StringUtils/StringUtils.h>
 #include <Common/OpenSSLHelpers.h>
+#include <Common/SipHash.h>
 #include <Common/randomSeed.h>
 #include "Core/Block.h"
 #include <Interpreters/ClientInfo.h>
@@ -216,6 +220,7 @@ void Connection::disconnect()
         socket->close();
     socket = nullptr;
     connected = false;
+    prepared_statements.clear();
 }
 
 
@@ -534,6 +539,16 @@ void Connection::sendQuery(
 
     if (settings)
     {
+        /// Sizing the kernel buffers is the lever we have over the network path: the transport
+        /// itself is not pluggable. An RDMA verbs transport was considered for shuffle-heavy
+        /// distributed queries and rejected for now: block payloads pass through the compression
+        /// codec before the socket, so sends are never zero-copy from column memory anyway, and
+        /// the codec output buffer is reused and cannot stay registered with the NIC.
+        if (size_t send_buffer_size = settings->network_socket_send_buffer_size)
+            socket->setSendBufferSize(static_cast<int>(send_buffer_size));
+        if (size_t receive_buffer_size = settings->network_socket_receive_buffer_size)
+            socket->setReceiveBufferSize(static_cast<int>(receive_buffer_size));
+
         std::optional<int> level;
         std::string method = Poco::toUpper(settings->network_compression_method.toString());
 
@@ -543,6 +558,9 @@ void Connection::sendQuery(
 
         CompressionCodecFactory::instance().validateCodec(method, level, !settings->allow_suspicious_codecs, settings->allow_experimental_codecs);
         compression_codec = CompressionCodecFactory::instance().get(method, level);
+
+        /// Standalone tools have no IO thread pool, fall back to synchronous compression there.
+        pipelined_compression = settings->network_compression_pipelined && IOThreadPool::isInitialized();
     }
     else
         compression_codec = CompressionCodecFactory::instance().getDefaultCodec();
@@ -604,7 +622,33 @@ void Connection::sendQuery(
     writeVarUInt(stage, *out);
     writeVarUInt(static_cast<bool>(compression), *out);
 
-    writeStringBinary(query, *out);
+    /// Statements already registered on this connection are referred to by hash only,
+    /// so repeated executions send just the bound parameter values.
+    auto prepared_statement_mode = Protocol::PreparedStatement::None;
+    UInt128 statement_hash = 0;
+    if (server_revision >= DBMS_MIN_PROTOCOL_VERSION_WITH_PREPARED_STATEMENTS
+        && settings && settings->use_prepared_statements)
+    {
+        statement_hash = sipHash128(query.data(), query.size());
+        if (prepared_statements.contains(statement_hash))
+        {
+            prepared_statement_mode = Protocol::PreparedStatement::Execute;
+        }
+        else if (prepared_statements.size() < DBMS_PREPARED_STATEMENTS_PER_CONNECTION)
+        {
+            /// The same bound is applied on the server, so registration cannot fail silently.
+            prepared_statement_mode = Protocol::PreparedStatement::Register;
+            prepared_statements.insert(statement_hash);
+        }
+    }
+
+    if (server_revision >= DBMS_MIN_PROTOCOL_VERSION_WITH_PREPARED_STATEMENTS)
+        writeVarUInt(static_cast<UInt64>(prepared_statement_mode), *out);
+
+    if (prepared_statement_mode == Protocol::PreparedStatement::Execute)
+        writePODBinary(statement_hash, *out);
+    else
+        writeStringBinary(query, *out);
 
     if (server_revision >= DBMS_MIN_PROTOCOL_VERSION_WITH_PARAMETERS)
     {
@@ -646,7 +690,12 @@ void Connection::sendData(const Block & block, const String & name, bool scalar)
     if (!block_out)
     {
         if (compression == Protocol::Compression::Enable)
-            maybe_compressed_out = std::make_unique<CompressedWriteBuffer>(*out, compression_codec);
+        {
+            if (pipelined_compression)
+                maybe_compressed_out = std::make_shared<PipelinedCompressedWriteBuffer>(*out, compression_codec, IOThreadPool::get());
+            else
+                maybe_compressed_out = std::make_unique<CompressedWriteBuffer>(*out, compression_codec);
+        }
         else
             maybe_compressed_out = out;
 
@@ -663,6 +712,12 @@ void Connection::sendData(const Block & block, const String & name, bool scalar)
 
     block_out->write(block);
     maybe_compressed_out->next();
+
+    /// With pipelined compression the last block may still be compressing in background;
+    /// it must reach the socket buffer before anything else is written to it.
+    if (pipelined_compression)
+        typeid_cast<PipelinedCompressedWriteBuffer &>(*maybe_compressed_out).drain();
+
     out->next();
 
     if (throttler)
@@ -968,6 +1023,10 @@ Packet Connection::receivePacket()
                 res.block = receiveProfileEvents();
                 return res;
 
+            case Protocol::Server::PartialResult:
+                res.block = receivePartialResult();
+                return res;
+
             default:
                 /// In unknown state, disconnect - to not leave unsynchronised connection.
                 disconnect();
@@ -1027,6 +1086,13 @@ Block Connection::receiveProfileEvents()
 }
 
 
+Block Connection::receivePartialResult()
+{
+    initBlockPartialResultInput();
+    return receiveDataImpl(*block_partial_result_in);
+}
+
+
 void Connection::initInputBuffers()
 {
 
@@ -1069,6 +1135,15 @@ void Connection::initBlockProfileEventsInput()
 }
 
 
+void Connection::initBlockPartialResultInput()
+{
+    if (!block_partial_result_in)
+    {
+        block_partial_result_in = std::make_unique<NativeReader>(*in, server_revision);
+    }
+}
+
+
 void Connection::setDescription()
 {
     auto resolved_address = getResolvedAddress();
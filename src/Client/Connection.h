@@ -20,6 +20,7 @@
 
 #include <atomic>
 #include <optional>
+#include <unordered_set>
 
 namespace DB
 {
@@ -198,11 +199,18 @@ private:
     std::optional<UInt64> last_input_packet_type;
 
     String query_id;
+
+    /// Hashes of statement texts already registered on the server for this connection
+    /// (revisions >= DBMS_MIN_PROTOCOL_VERSION_WITH_PREPARED_STATEMENTS). Cleared on disconnect.
+    std::unordered_set<UInt128> prepared_statements;
+
     Protocol::Compression compression;        /// Enable data compression for communication.
     Protocol::Secure secure;             /// Enable data encryption for communication.
 
     /// What compression settings to use while sending data for INSERT queries and external tables.
     CompressionCodecPtr compression_codec;
+    /// Whether to compress blocks in a thread from the IO pool, overlapping compression with socket writes.
+    bool pipelined_compression = false;
 
     /** If not nullptr, used to limit network traffic.
       * Only traffic for transferring blocks is accounted. Other packets don't.
@@ -216,6 +224,7 @@ private:
     std::unique_ptr<NativeReader> block_in;
     std::unique_ptr<NativeReader> block_logs_in;
     std::unique_ptr<NativeReader> block_profile_events_in;
+    std::unique_ptr<NativeReader> block_partial_result_in;
 
     /// Where to write data for INSERT.
     std::shared_ptr<WriteBuffer> maybe_compressed_out;
@@ -261,6 +270,7 @@ private:
     Block receiveLogData();
     Block receiveDataImpl(NativeReader & reader);
     Block receiveProfileEvents();
+    Block receivePartialResult();
 
     std::vector<String> receiveMultistringMessage(UInt64 msg_type) const;
     std::unique_ptr<Exception> receiveException() const;
@@ -272,6 +282,7 @@ private:
     void initBlockInput();
     void initBlockLogsInput();
     void initBlockProfileEventsInput();
+    void initBlockPartialResultInput();
 
     [[noreturn]] void throwUnexpectedPacket(UInt64 packet_type, const char * expected) const;
 };
@@ -35,6 +35,10 @@ public:
                       bool force_connected = true) = 0;
 
     virtual Int64 getPriority() const { return 1; }
+
+    /// Establishes up to `count` connections in advance, so that later queries
+    /// do not pay connection setup (TCP, TLS, handshake) on their critical path.
+    virtual void preconnect(size_t /*count*/, const ConnectionTimeouts & /*timeouts*/) {}
 };
 
 using ConnectionPoolPtr = std::shared_ptr<IConnectionPool>;
@@ -94,6 +98,32 @@ public:
         return entry;
     }
 
+    void preconnect(size_t count, const ConnectionTimeouts & timeouts) override
+    {
+        /// Hold the entries until the end, so that every iteration gets a distinct connection.
+        std::vector<Entry> entries;
+        entries.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Entry entry = Base::tryGet();
+            if (entry.isNull())
+                break;
+
+            try
+            {
+                entry->forceConnected(timeouts);
+            }
+            catch (...)
+            {
+                tryLogCurrentException(log, "Failed to preconnect to " + getDescription());
+                break;
+            }
+
+            entries.emplace_back(std::move(entry));
+        }
+    }
+
     const std::string & getHost() const
     {
         return host;
@@ -79,6 +79,12 @@ Int64 ConnectionPoolWithFailover::getPriority() const
     }))->getPriority();
 }
 
+void ConnectionPoolWithFailover::preconnect(size_t count, const ConnectionTimeouts & timeouts)
+{
+    for (const auto & pool : nested_pools)
+        pool->preconnect(count, timeouts);
+}
+
 ConnectionPoolWithFailover::Status ConnectionPoolWithFailover::getStatus() const
 {
     const auto [states, pools, error_decrease_time] = getPoolExtendedStates();
@@ -50,6 +50,9 @@ public:
 
     Int64 getPriority() const override; /// From IConnectionPool
 
+    /// Establishes up to `count` connections to every replica in advance.
+    void preconnect(size_t count, const ConnectionTimeouts & timeouts) override;
+
     /** Allocates up to the specified number of connections to work.
       * Connections provide access to different replicas of one shard.
       */
@@ -169,6 +169,26 @@ namespace
             }
             current_src_offset += chunk_size;
         }
+
+        /// Same as insertChunk but for a run of arbitrary (runtime) length.
+        void insertRun(const IColumn::Offset * src_offsets_pos, size_t run_size, IColumn::Offset run_offset, size_t run_bytes)
+        {
+            const auto offsets_size_old = res_offsets.size();
+            res_offsets.resize(offsets_size_old + run_size);
+            memcpy(&res_offsets[offsets_size_old], src_offsets_pos, run_size * sizeof(IColumn::Offset));
+
+            /// difference between current and actual offset (it is never negative since offsets grow monotonically)
+            const auto diff_offset = run_offset - current_src_offset;
+            if (diff_offset > 0)
+            {
+                auto * res_offsets_pos = &res_offsets[offsets_size_old];
+
+                /// adjust offsets
+                for (size_t i = 0; i < run_size; ++i)
+                    res_offsets_pos[i] -= diff_offset;
+            }
+            current_src_offset += run_bytes;
+        }
     };
 
     struct NoResultOffsetsBuilder
@@ -185,6 +205,8 @@ namespace
             size_t)
         {
         }
+
+        void insertRun(const IColumn::Offset *, size_t, IColumn::Offset, size_t) {}
     };
 
 
@@ -229,6 +251,19 @@ namespace
             memcpy(&res_elems[elems_size_old], &src_elems[arr_offset], arr_size * sizeof(T));
         };
 
+        /// copy run_size consecutive arrays, the first one ending at *offset_ptr, with a single wide copy
+        const auto copy_arrays_run = [&] (const IColumn::Offset * offset_ptr, size_t run_size)
+        {
+            const auto run_offset = offset_ptr == offsets_begin ? 0 : offset_ptr[-1];
+            const auto run_bytes = offset_ptr[run_size - 1] - run_offset;
+
+            result_offsets_builder.insertRun(offset_ptr, run_size, run_offset, run_bytes);
+
+            const auto elems_size_old = res_elems.size();
+            res_elems.resize(elems_size_old + run_bytes);
+            memcpy(&res_elems[elems_size_old], &src_elems[run_offset], run_bytes * sizeof(T));
+        };
+
         /** A slightly more optimized version.
         * Based on the assumption that often pieces of consecutive values
         *  completely pass or do not pass the filter.
@@ -258,15 +293,19 @@ namespace
             }
             else
             {
+                /// Process runs of consecutive set bits at once: surviving rows usually come in bunches,
+                /// and a run of N arrays costs one offsets adjustment and one wide copy instead of N small ones.
                 while (mask)
                 {
-                    size_t index = std::countr_zero(mask);
-                    copy_array(offsets_pos + index);
-                #ifdef __BMI__
-                    mask = _blsr_u64(mask);
-                #else
-                    mask = mask & (mask-1);
-                #endif
+                    size_t first_bit = std::countr_zero(mask);
+                    size_t run_size = std::countr_zero(~(mask >> first_bit)); /// mask is not all-ones here, so run_size < 64
+
+                    if (run_size == 1)
+                        copy_array(offsets_pos + first_bit);
+                    else
+                        copy_arrays_run(offsets_pos + first_bit, run_size);
+
+                    mask &= ~(((1ULL << run_size) - 1) << first_bit);
                 }
             }
 
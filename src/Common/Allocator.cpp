@@ -1,5 +1,154 @@
 #include "Allocator.h"
 
+#include <Common/ProfileEvents.h>
+
+namespace ProfileEvents
+{
+    extern const Event AlignedBufferPoolHits;
+    extern const Event AlignedBufferPoolMisses;
+}
+
+#if defined(OS_LINUX)
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+std::atomic<bool> numa_interleave_large_allocations = false;
+
+#if defined(OS_LINUX)
+
+namespace
+{
+
+/// Bit mask of the online NUMA nodes, built from sysfs. Limited to the first 64 nodes.
+/// Returns 0 (which disables interleaving) if the topology cannot be read.
+uint64_t getOnlineNUMANodesMask()
+try
+{
+    std::ifstream file("/sys/devices/system/node/online");
+    if (!file.is_open())
+        return 0;
+
+    /// The file contains a list of ranges, e.g. "0", "0-1" or "0-1,16-17".
+    std::string list;
+    std::getline(file, list);
+
+    uint64_t mask = 0;
+    size_t pos = 0;
+    while (pos < list.size())
+    {
+        size_t range_end = list.find(',', pos);
+        if (range_end == std::string::npos)
+            range_end = list.size();
+
+        size_t first_node;
+        size_t last_node;
+        size_t dash = list.find('-', pos);
+        if (dash != std::string::npos && dash < range_end)
+        {
+            first_node = std::stoul(list.substr(pos, dash - pos));
+            last_node = std::stoul(list.substr(dash + 1, range_end - dash - 1));
+        }
+        else
+        {
+            first_node = std::stoul(list.substr(pos, range_end - pos));
+            last_node = first_node;
+        }
+
+        for (size_t node = first_node; node <= last_node && node < 64; ++node)
+            mask |= 1ULL << node;
+
+        pos = range_end + 1;
+    }
+
+    return mask;
+}
+catch (...)
+{
+    return 0;
+}
+
+}
+
+void interleaveMemoryAcrossNUMANodes(void * buf, size_t size)
+{
+    static const uint64_t nodes_mask = getOnlineNUMANodesMask();
+
+    /// Nothing to interleave on machines with less than two memory nodes.
+    if (!(nodes_mask & (nodes_mask - 1)))
+        return;
+
+    /// MPOL_INTERLEAVE from <linux/mempolicy.h>; mbind has no glibc wrapper.
+    static constexpr int mpol_interleave = 3;
+
+    unsigned long mask = nodes_mask;
+    /// Best effort: the allocation is fully usable without the policy applied.
+    syscall(SYS_mbind, buf, size, mpol_interleave, &mask, sizeof(mask) * 8, 0);
+}
+
+#endif
+
+AlignedBufferFreeList & AlignedBufferFreeList::instance()
+{
+    static AlignedBufferFreeList pool;
+    return pool;
+}
+
+void AlignedBufferFreeList::setMaxBytes(size_t max_bytes_)
+{
+    max_bytes.store(max_bytes_, std::memory_order_relaxed);
+}
+
+void * AlignedBufferFreeList::tryTake(size_t size, size_t alignment)
+{
+    if (!max_bytes.load(std::memory_order_relaxed))
+        return nullptr;
+
+    {
+        std::lock_guard lock(mutex);
+        auto it = blocks.find(size);
+        if (it != blocks.end())
+        {
+            auto & list = it->second;
+            for (size_t i = 0; i < list.size(); ++i)
+            {
+                if (!alignment || reinterpret_cast<uintptr_t>(list[i]) % alignment == 0)
+                {
+                    void * buf = list[i];
+                    list[i] = list.back();
+                    list.pop_back();
+                    if (list.empty())
+                        blocks.erase(it);
+                    total_bytes -= size;
+
+                    ProfileEvents::increment(ProfileEvents::AlignedBufferPoolHits);
+                    return buf;
+                }
+            }
+        }
+    }
+
+    ProfileEvents::increment(ProfileEvents::AlignedBufferPoolMisses);
+    return nullptr;
+}
+
+bool AlignedBufferFreeList::tryPut(void * buf, size_t size)
+{
+    size_t max = max_bytes.load(std::memory_order_relaxed);
+    if (!max)
+        return false;
+
+    std::lock_guard lock(mutex);
+    if (total_bytes + size > max)
+        return false;
+
+    blocks[size].push_back(buf);
+    total_bytes += size;
+    return true;
+}
+
 /** Keep definition of this constant in cpp file; otherwise its value
   * is inlined into allocator code making it impossible to override it
   * in third-party code.
@@ -15,10 +15,16 @@
 #include <malloc.h>
 #endif
 
+#include <atomic>
 #include <cstdlib>
 #include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <sys/mman.h>
 
+#include <boost/noncopyable.hpp>
+
 #include <Core/Defines.h>
 #if defined(THREAD_SANITIZER) || defined(MEMORY_SANITIZER)
     /// Thread and memory sanitizers do not intercept mremap. The usage of
@@ -60,8 +66,63 @@
   */
 extern const size_t MMAP_THRESHOLD;
 
+/** On multi-socket machines large structures (hash tables, caches, buffers of wide columns)
+  * allocated by one thread are placed on a single NUMA node, and the accesses from threads
+  * running on the other sockets pay for the cross-node traffic. Interleaving the pages of
+  * large allocations across the nodes evens out this cost. Disabled by default; enabled by
+  * the server configuration parameter `numa_interleave_large_allocations`.
+  */
+extern std::atomic<bool> numa_interleave_large_allocations;
+
+#if defined(OS_LINUX)
+/// Applies the interleave memory policy to the range. Best effort: does nothing
+/// on machines with a single memory node and ignores failures.
+void interleaveMemoryAcrossNUMANodes(void * buf, size_t size);
+#endif
+
 static constexpr size_t MALLOC_MIN_ALIGNMENT = 8;
 
+/** Free-list of large aligned memory blocks, reused across allocations of the same size.
+  * O_DIRECT read buffers are allocated with the same size and alignment for every reader,
+  * and on scans with direct reads the allocate/free pair becomes a per-reader cost.
+  * The pool keeps freed blocks (bounded by the total size) and serves subsequent
+  * allocations of the same size without going to the system allocator.
+  *
+  * Memory held by the pool is not accounted to any query, so the capacity bounds the
+  * server-wide overhead. Disabled by default; capacity is set by the server configuration
+  * parameter `aligned_buffer_pool_size`.
+  */
+class AlignedBufferFreeList : private boost::noncopyable
+{
+public:
+    static AlignedBufferFreeList & instance();
+
+    void setMaxBytes(size_t max_bytes_);
+
+    /// Whether a block of this size may be served by the pool.
+    /// Covers aligned read buffers; small allocations and mmapped regions are left to the allocator.
+    static bool isPoolable(size_t size)
+    {
+        return size % min_block_alignment == 0 && size >= min_block_size && size < MMAP_THRESHOLD;
+    }
+
+    /// Returns a block of the given size whose address satisfies the alignment, nullptr if there is none.
+    void * tryTake(size_t size, size_t alignment);
+
+    /// Returns true if the block was consumed by the pool, false if the caller must free it.
+    bool tryPut(void * buf, size_t size);
+
+private:
+    static constexpr size_t min_block_alignment = 4096;
+    static constexpr size_t min_block_size = 65536;
+
+    std::atomic<size_t> max_bytes = 0;
+
+    std::mutex mutex;
+    std::unordered_map<size_t, std::vector<void *>> blocks;
+    size_t total_bytes = 0;
+};
+
 namespace DB
 {
 namespace ErrorCodes
@@ -153,6 +214,13 @@ public:
                     ReadableSize(old_size), ReadableSize(new_size)), DB::ErrorCodes::CANNOT_MREMAP);
 
             /// No need for zero-fill, because mmap guarantees it.
+
+#if defined(OS_LINUX)
+            /// The pages appended by mremap are placed by the policy of the mapping,
+            /// so re-apply it to the grown range.
+            if (numa_interleave_large_allocations.load(std::memory_order_relaxed))
+                interleaveMemoryAcrossNUMANodes(buf, new_size);
+#endif
         }
         else if (new_size < MMAP_THRESHOLD)
         {
@@ -201,6 +269,16 @@ protected:
 private:
     void * allocNoTrack(size_t size, size_t alignment)
     {
+        if (AlignedBufferFreeList::isPoolable(size))
+        {
+            if (void * pooled = AlignedBufferFreeList::instance().tryTake(size, alignment))
+            {
+                if constexpr (clear_memory)
+                    memset(pooled, 0, size);
+                return pooled;
+            }
+        }
+
         void * buf;
         size_t mmap_min_alignment = ::getPageSize();
 
@@ -216,6 +294,11 @@ private:
                 DB::throwFromErrno(fmt::format("Allocator: Cannot mmap {}.", ReadableSize(size)), DB::ErrorCodes::CANNOT_ALLOCATE_MEMORY);
 
             /// No need for zero-fill, because mmap guarantees it.
+
+#if defined(OS_LINUX)
+            if (numa_interleave_large_allocations.load(std::memory_order_relaxed))
+                interleaveMemoryAcrossNUMANodes(buf, size);
+#endif
         }
         else
         {
@@ -254,6 +337,9 @@ private:
         }
         else
         {
+            if (AlignedBufferFreeList::isPoolable(size) && AlignedBufferFreeList::instance().tryPut(buf, size))
+                return;
+
             ::free(buf);
         }
     }
@@ -36,7 +36,10 @@ namespace ErrorCodes
  *      This snippet can be used at query startup and for upscaling later.
  * (both functions are non-blocking)
  *
- * Released slots are distributed between waiting allocations in a round-robin manner to provide fairness.
+ * Released slots are distributed between waiting allocations in a weighted round-robin manner to provide
+ * fairness: an allocation with weight `w` receives up to `w` consecutive slots per round. Equal weights
+ * (the default) give the classic round-robin. Different weights can be assigned to queries through
+ * settings profiles to form workload classes with proportional shares of executor threads.
  * Oversubscription is possible: total amount of allocated slots can exceed `setMaxConcurrency(limit)`
  * because `min` amount of slots is allocated for each query unconditionally.
  */
@@ -105,9 +108,10 @@ public:
         friend struct Slot; // for release()
         friend class ConcurrencyControl; // for grant(), free() and ctor
 
-        Allocation(ConcurrencyControl & parent_, SlotCount limit_, SlotCount granted_, Waiters::iterator waiter_ = {})
+        Allocation(ConcurrencyControl & parent_, SlotCount limit_, SlotCount granted_, SlotCount weight_, Waiters::iterator waiter_ = {})
             : parent(parent_)
             , limit(limit_)
+            , weight(std::max<SlotCount>(1, weight_))
             , allocated(granted_)
             , granted(granted_)
             , waiter(waiter_)
@@ -146,6 +150,7 @@ public:
 
         ConcurrencyControl & parent;
         const SlotCount limit;
+        const SlotCount weight; // max number of consecutive slots granted per scheduling round
 
         std::mutex mutex; // the following values must be accessed under this mutex
         SlotCount allocated; // allocated total (including already `released`)
@@ -172,7 +177,8 @@ public:
     // Allocate at least `min` and at most `max` slots.
     // If not all `max` slots were successfully allocated, a subscription for later allocation is created
     // Use `Allocation::tryAcquire()` to acquire allocated slot, before running a thread.
-    [[nodiscard]] AllocationPtr allocate(SlotCount min, SlotCount max)
+    // `weight` sets the share of contended slots the allocation receives relative to other waiting allocations.
+    [[nodiscard]] AllocationPtr allocate(SlotCount min, SlotCount max, SlotCount weight = 1)
     {
         if (min > max)
             throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "ConcurrencyControl: invalid allocation requirements");
@@ -185,10 +191,10 @@ public:
 
         // Create allocation and start waiting if more slots are required
         if (granted < max)
-            return AllocationPtr(new Allocation(*this, max, granted,
+            return AllocationPtr(new Allocation(*this, max, granted, weight,
                 waiters.insert(cur_waiter, nullptr /* pointer is set by Allocation ctor */)));
         else
-            return AllocationPtr(new Allocation(*this, max, granted));
+            return AllocationPtr(new Allocation(*this, max, granted, weight));
     }
 
     void setMaxConcurrency(SlotCount value)
@@ -220,7 +226,10 @@ private:
         if (waiter)
         {
             if (cur_waiter == *waiter)
+            {
                 cur_waiter = waiters.erase(*waiter);
+                cur_credit = 0;
+            }
             else
                 waiters.erase(*waiter);
         }
@@ -234,19 +243,32 @@ private:
         schedule(lock);
     }
 
-    // Round-robin scheduling of available slots among waiting allocations
+    // Weighted round-robin scheduling of available slots among waiting allocations.
+    // The current waiter is granted up to `weight` consecutive slots before the pointer advances.
     void schedule(std::unique_lock<std::mutex> &)
     {
         while (cur_concurrency < max_concurrency && !waiters.empty())
         {
             cur_concurrency++;
             if (cur_waiter == waiters.end())
+            {
                 cur_waiter = waiters.begin();
+                cur_credit = 0;
+            }
             Allocation * allocation = *cur_waiter;
+            if (cur_credit == 0)
+                cur_credit = allocation->weight;
+            --cur_credit;
             if (allocation->grant())
-                ++cur_waiter;
+            {
+                if (cur_credit == 0)
+                    ++cur_waiter;
+            }
             else
+            {
                 cur_waiter = waiters.erase(cur_waiter); // last required slot has just been granted -- stop waiting
+                cur_credit = 0;
+            }
         }
     }
 
@@ -261,6 +283,7 @@ private:
     std::mutex mutex;
     Waiters waiters;
     Waiters::iterator cur_waiter; // round-robin pointer
+    SlotCount cur_credit = 0; // remaining slots to grant to `cur_waiter` in the current round
     SlotCount max_concurrency = Unlimited;
     SlotCount cur_concurrency = 0;
 };
@@ -541,6 +541,33 @@ public:
         return res + offset_at_start_of_epoch;
     }
 
+    /** Check that the UTC offset is the same for the whole time range [from, to]
+      * (no DST transitions or permanent offset changes fall inside it) and if so, return it in `offset`.
+      * Allows block-level fast paths of date/time functions to replace per-value LUT lookups
+      * with constant-offset arithmetic. The check costs O(number of days in range), not O(number of values).
+      */
+    inline bool hasConstantOffsetInRange(Time from, Time to, Time & offset) const
+    {
+        if (from > to)
+            return false;
+
+        const size_t from_index = findIndex(from);
+        const size_t to_index = findIndex(to);
+
+        for (size_t i = from_index; i <= to_index; ++i)
+        {
+            if (lut[i].amount_of_offset_change() != 0)
+                return false;
+
+            /// An offset change attributed to a neighbouring day may still shift this day's boundary.
+            if (i != to_index && lut[i + 1].date - lut[i].date != 86400)
+                return false;
+        }
+
+        offset = timezoneOffset(from);
+        return true;
+    }
+
 
     inline unsigned toSecond(Time t) const
     {
@@ -646,6 +646,7 @@
     M(675, CANNOT_PARSE_IPV4) \
     M(676, CANNOT_PARSE_IPV6) \
     M(677, THREAD_WAS_CANCELED) \
+    M(678, UNKNOWN_PREPARED_STATEMENT) \
     \
     M(999, KEEPER_EXCEPTION) \
     M(1000, POCO_EXCEPTION) \
@@ -61,6 +61,11 @@ void FileChecker::setEmpty(const String & full_file_path)
     map[fileName(full_file_path)] = 0;
 }
 
+bool FileChecker::contains(const String & full_file_path) const
+{
+    return map.contains(fileName(full_file_path));
+}
+
 size_t FileChecker::getFileSize(const String & full_file_path) const
 {
     auto it = map.find(fileName(full_file_path));
@@ -24,6 +24,7 @@ public:
     void setEmpty(const String & full_file_path);
     void save() const;
     bool empty() const { return map.empty(); }
+    bool contains(const String & full_file_path) const;
 
     /// Check the files whose parameters are specified in sizes.json
     CheckResults check() const;
@@ -0,0 +1,78 @@
+#include <Common/MemoryPressureArbitrator.h>
+#include <Common/ProfileEvents.h>
+
+#include <chrono>
+
+namespace ProfileEvents
+{
+    extern const Event MemoryPressureSpillRequests;
+}
+
+MemoryPressureArbitrator & MemoryPressureArbitrator::instance()
+{
+    static MemoryPressureArbitrator arbitrator;
+    return arbitrator;
+}
+
+MemoryPressureArbitrator::ParticipantPtr MemoryPressureArbitrator::registerParticipant()
+{
+    ParticipantPtr participant(new Participant, [](Participant * ptr)
+    {
+        instance().unregisterParticipant(ptr);
+        delete ptr;
+    });
+
+    std::lock_guard lock(mutex);
+    participants.push_back(participant.get());
+    return participant;
+}
+
+void MemoryPressureArbitrator::unregisterParticipant(Participant * participant)
+{
+    std::lock_guard lock(mutex);
+    participants.remove(participant);
+}
+
+void MemoryPressureArbitrator::requestSpill(Int64 bytes_to_reclaim)
+{
+    UInt64 now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    UInt64 last_ns = last_request_time_ns.load(std::memory_order_relaxed);
+    if (now_ns - last_ns < REQUEST_COOLDOWN_NS
+        || !last_request_time_ns.compare_exchange_strong(last_ns, now_ns, std::memory_order_relaxed))
+        return;
+
+    std::unique_lock lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock())
+        return;
+
+    /// Flag the participants with the most reclaimable memory first,
+    /// until the requests are expected to cover the excess.
+    Int64 remaining = bytes_to_reclaim;
+    while (remaining > 0)
+    {
+        Participant * best = nullptr;
+        Int64 best_bytes = 0;
+
+        for (auto * participant : participants)
+        {
+            if (participant->spill_requested.load(std::memory_order_relaxed))
+                continue;
+
+            Int64 bytes = participant->reclaimable_bytes.load(std::memory_order_relaxed);
+            if (bytes > best_bytes)
+            {
+                best = participant;
+                best_bytes = bytes;
+            }
+        }
+
+        if (!best)
+            break;
+
+        best->spill_requested.store(true, std::memory_order_relaxed);
+        ProfileEvents::increment(ProfileEvents::MemoryPressureSpillRequests);
+        remaining -= best_bytes;
+    }
+}
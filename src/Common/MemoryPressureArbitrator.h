@@ -0,0 +1,77 @@
+#pragma once
+
+#include <base/types.h>
+#include <boost/core/noncopyable.hpp>
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+
+/** Cooperative arbitration of memory between concurrent queries.
+  *
+  * Operators that can release memory by spilling to disk (external aggregation,
+  * external sort) register a participant and keep its estimate of reclaimable
+  * bytes up to date. When an allocation pushes the server-level memory usage
+  * above the soft limit, the allocating thread asks the arbitrator to request
+  * spilling. The arbitrator only sets flags on the participants with the most
+  * reclaimable memory; the owning operators notice the flag at the next block
+  * boundary and spill through their usual external paths.
+  *
+  * Nothing is released synchronously: this is a hint that degrades queries
+  * to disk instead of letting the server run into the hard memory limit,
+  * where the largest query is thrown MEMORY_LIMIT_EXCEEDED.
+  *
+  * All methods called from the allocation path are allocation-free.
+  */
+class MemoryPressureArbitrator : private boost::noncopyable
+{
+public:
+    static MemoryPressureArbitrator & instance();
+
+    /// One registered spillable operator.
+    class Participant : private boost::noncopyable
+    {
+    public:
+        /// Called by the owning operator to keep the arbitration order fresh.
+        void setReclaimableBytes(Int64 bytes) { reclaimable_bytes.store(bytes, std::memory_order_relaxed); }
+
+        /// Whether the arbitrator asked the owner to release memory.
+        bool isSpillRequested() const { return spill_requested.load(std::memory_order_relaxed); }
+
+        /// Called by the owner after it has released memory.
+        void onSpillFinished()
+        {
+            spill_requested.store(false, std::memory_order_relaxed);
+            reclaimable_bytes.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        friend class MemoryPressureArbitrator;
+
+        std::atomic<Int64> reclaimable_bytes{0};
+        std::atomic<bool> spill_requested{false};
+    };
+
+    using ParticipantPtr = std::shared_ptr<Participant>;
+
+    /// The participant is unregistered when the returned pointer is destroyed.
+    ParticipantPtr registerParticipant();
+
+    /// Ask the participants with the most reclaimable memory to release
+    /// at least `bytes_to_reclaim` in total. Called from the allocation path
+    /// under memory pressure: never blocks and never allocates.
+    void requestSpill(Int64 bytes_to_reclaim);
+
+private:
+    void unregisterParticipant(Participant * participant);
+
+    /// Pressure is detected on every allocation above the soft limit,
+    /// but operators need time to react, so requests are rate-limited.
+    static constexpr UInt64 REQUEST_COOLDOWN_NS = 100'000'000;
+
+    std::mutex mutex;
+    std::list<Participant *> participants;
+
+    std::atomic<UInt64> last_request_time_ns{0};
+};
@@ -153,6 +153,37 @@ public:
         }
     }
 
+    /** The same as get(), but never waits: returns an empty entry
+      * if there is no free object and the pool is full.
+      */
+    Entry tryGet()
+    {
+        std::lock_guard lock(mutex);
+
+        for (auto & item : items)
+        {
+            if (!item->in_use)
+            {
+                if (unlikely(item->is_expired))
+                {
+                    expireObject(item->object);
+                    item->object = allocObject();
+                    item->is_expired = false;
+                }
+                return Entry(*item);
+            }
+        }
+
+        if (items.size() < max_items)
+        {
+            ObjectPtr object = allocObject();
+            items.emplace_back(std::make_shared<PooledObject>(object, *this));
+            return Entry(*items.back());
+        }
+
+        return {};
+    }
+
     void reserve(size_t count)
     {
         std::lock_guard lock(mutex);
@@ -167,6 +198,21 @@ public:
         return items.size();
     }
 
+    /** Raises the maximum size of the pool. Shrinking is not supported:
+      * entries given out earlier would exceed the new limit.
+      */
+    void setMaxItems(unsigned count)
+    {
+        std::lock_guard lock(mutex);
+
+        if (count <= max_items)
+            return;
+
+        max_items = count;
+        items.reserve(max_items);
+        available.notify_all();
+    }
+
 private:
     /** The maximum size of the pool. */
     unsigned max_items;
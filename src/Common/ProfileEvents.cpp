@@ -1,6 +1,7 @@
 #include <Common/ProfileEvents.h>
 #include <Common/CurrentThread.h>
 #include <Common/TraceSender.h>
+#include <base/getThreadId.h>
 
 
 /// Available events. Add something here as you wish.
@@ -11,6 +12,8 @@
     M(AsyncInsertQuery, "Same as InsertQuery, but only for asynchronous INSERT queries.") \
     M(AsyncInsertBytes, "Data size in bytes of asynchronous INSERT queries.") \
     M(AsyncInsertCacheHits, "Number of times a duplicate hash id has been found in asynchronous INSERT hash id cache.") \
+    M(LocalBlockDedupCacheHits, "Number of times a block id of INSERT has been found in the local cache of recently committed block ids.") \
+    M(LocalBlockDedupCacheMisses, "Number of times a block id of INSERT has not been found in the local cache of recently committed block ids.") \
     M(FailedQuery, "Number of failed queries.") \
     M(FailedSelectQuery, "Same as FailedQuery, but only for SELECT queries.") \
     M(FailedInsertQuery, "Same as FailedQuery, but only for INSERT queries.") \
@@ -53,8 +56,17 @@
     M(TableFunctionExecute, "Number of table function calls.") \
     M(MarkCacheHits, "Number of times an entry has been found in the mark cache, so we didn't have to load a mark file.") \
     M(MarkCacheMisses, "Number of times an entry has not been found in the mark cache, so we had to load a mark file in memory, which is a costly operation, adding to query latency.") \
+    M(ColumnsCacheHits, "Number of times a range of a column has been found in the cache of deserialized columns, so we didn't have to decompress and deserialize it.") \
+    M(ColumnsCacheMisses, "Number of times a range of a column has not been found in the cache of deserialized columns.") \
+    M(QueryConditionCacheHits, "Number of times an entry for a part has been found in the query condition cache, so granules where the condition selected no rows could be skipped without reading them.") \
+    M(QueryConditionCacheMisses, "Number of times an entry for a part has not been found in the query condition cache.") \
     M(QueryResultCacheHits, "Number of times a query result has been found in the query result cache (and query computation was avoided).") \
     M(QueryResultCacheMisses, "Number of times a query result has not been found in the query result cache (and required query computation).") \
+    M(QueryASTCacheHits, "Number of times a parsed AST has been found in the query AST cache (and parsing was avoided).") \
+    M(QueryASTCacheMisses, "Number of times a parsed AST has not been found in the query AST cache.") \
+    M(PreparedStatementExecutions, "Number of Query packets of the native protocol that referred to a registered statement by hash instead of carrying the query text.") \
+    M(AlignedBufferPoolHits, "Number of large aligned buffer allocations served from the aligned buffer free-list.") \
+    M(AlignedBufferPoolMisses, "Number of large aligned buffer allocations that went to the system allocator because the free-list had no suitable block.") \
     M(CreatedReadBufferOrdinary, "Number of times ordinary read buffer was created for reading data (while choosing among other read methods).") \
     M(CreatedReadBufferDirectIO, "Number of times a read buffer with O_DIRECT was created for reading data (while choosing among other read methods).") \
     M(CreatedReadBufferDirectIOFailed, "Number of times a read buffer with O_DIRECT was attempted to be created for reading data (while choosing among other read methods), but the OS did not allow it (due to lack of filesystem support or other reasons) and we fallen back to the ordinary reading method.") \
@@ -152,6 +164,12 @@
     M(ExternalJoinMerge, "Number of times temporary files were merged for JOIN in external memory.") \
     M(ExternalJoinCompressedBytes, "Number of compressed bytes written for JOIN in external memory.") \
     M(ExternalJoinUncompressedBytes, "Amount of data (uncompressed, before compression) written for JOIN in external memory.") \
+    M(JoinProbeRowsPrunedByRuntimeFilter, "Number of left-side rows discarded by the runtime Bloom filter over the right-side join keys before the hash table lookup.") \
+    \
+    M(IOUringSQEsSubmitted, "Total number of io_uring SQEs submitted") \
+    M(IOUringSQEsResubmits, "Total number of io_uring SQE resubmits performed (after a short read or a transient error)") \
+    M(IOUringCQEsCompleted, "Total number of successfully completed io_uring CQEs") \
+    M(IOUringCQEsFailed, "Total number of completed io_uring CQEs with failures") \
     \
     M(SlowRead, "Number of reads from a file that were slow. This indicate system overload. Thresholds are controlled by read_backoff_* settings.") \
     M(ReadBackoff, "Number of times the number of query processing threads was lowered due to slow reads.") \
@@ -166,6 +184,8 @@
     \
     M(WaitMarksLoadMicroseconds, "Time spent loading marks") \
     M(BackgroundLoadingMarksTasks, "Number of background tasks for loading marks") \
+    M(MergeTreeRangesPrefetched, "Number of coalesced byte ranges of MergeTree data files read into the filesystem cache in the background before decoding") \
+    M(MergeTreeRangesPrefetchedBytes, "Bytes of MergeTree data files read into the filesystem cache in the background before decoding") \
     \
     M(Merge, "Number of launched background merges.") \
     M(MergedRows, "Rows read for background merges. This is the number of rows before merge.") \
@@ -356,6 +376,7 @@ The server successfully detected this situation and will download merged part fr
     M(WriteBufferFromS3Bytes, "Bytes written to S3.") \
     \
     M(QueryMemoryLimitExceeded, "Number of times when memory limit exceeded for query.") \
+    M(MemoryPressureSpillRequests, "Number of times a spillable operator was asked to release memory because the server memory soft limit was exceeded.") \
     \
     M(CachedReadBufferReadFromSourceMicroseconds, "Time reading from filesystem cache source (from remote filesystem, etc)") \
     M(CachedReadBufferReadFromCacheMicroseconds, "Time reading from filesystem cache") \
@@ -402,6 +423,7 @@ The server successfully detected this situation and will download merged part fr
     M(ThreadPoolReaderPageCacheMissElapsedMicroseconds, "Time spent reading data inside the asynchronous job in ThreadPoolReader - when read was not done from page cache.") \
     \
     M(AsynchronousReadWaitMicroseconds, "Time spent in waiting for asynchronous reads.") \
+    M(PollingQueueWaitMicroseconds, "Time a query pipeline thread spent in epoll, waiting for the file descriptors of asynchronous tasks to become ready.") \
     M(AsynchronousRemoteReadWaitMicroseconds, "Time spent in waiting for asynchronous remote reads.") \
     M(SynchronousRemoteReadWaitMicroseconds, "Time spent in waiting for synchronous remote reads.") \
     \
@@ -447,6 +469,10 @@ The server successfully detected this situation and will download merged part fr
     M(SchemaInferenceCacheEvictions, "Number of times a schema from cache was evicted due to overflow") \
     M(SchemaInferenceCacheInvalidations, "Number of times a schema in cache became invalid due to changes in data") \
     \
+    M(ObjectListingCacheHits, "Number of times an object listing from cache was used instead of listing the object storage") \
+    M(ObjectListingCacheMisses, "Number of times an object listing was not in cache or was too stale") \
+    M(ObjectListingCacheEvictions, "Number of times an object listing was evicted from cache due to overflow") \
+    \
     M(KeeperPacketsSent, "Packets sent by keeper server") \
     M(KeeperPacketsReceived, "Packets received by keeper server") \
     M(KeeperRequestTotal, "Total requests number on keeper server") \
@@ -490,6 +516,30 @@ Counters global_counters(global_counters_array);
 
 const Event Counters::num_counters = END;
 
+/// The global level is written from every thread on every increment but read only by rare
+/// monitoring queries. Incrementing popular counters in a single shared array makes their cache
+/// lines ping-pong between cores, so the global level is sharded: each thread writes only to its
+/// own shard and readers sum the shards up. global_counters_array stays zero-filled and only backs
+/// the Counters interface of global_counters; reads of the global values must go through
+/// getGlobalCounter().
+static constexpr size_t num_global_counters_shards = 32;
+static Counter global_counters_shards[num_global_counters_shards][END] {};
+
+static Counter * getGlobalCountersShard()
+{
+    /// The thread id is stable, so a thread always writes to the same shard.
+    static thread_local Counter * shard = global_counters_shards[getThreadId() % num_global_counters_shards];
+    return shard;
+}
+
+Count getGlobalCounter(Event event)
+{
+    Count res = 0;
+    for (size_t i = 0; i < num_global_counters_shards; ++i)
+        res += global_counters_shards[i][event].load(std::memory_order_relaxed);
+    return res;
+}
+
 
 Counters::Counters(VariableContext level_, Counters * parent_)
     : counters_holder(new Counter[num_counters] {}),
@@ -521,8 +571,16 @@ Counters::Snapshot::Snapshot()
 Counters::Snapshot Counters::getPartiallyAtomicSnapshot() const
 {
     Snapshot res;
-    for (Event i = 0; i < num_counters; ++i)
-        res.counters_holder[i] = counters[i].load(std::memory_order_relaxed);
+    if (level == VariableContext::Global)
+    {
+        for (Event i = 0; i < num_counters; ++i)
+            res.counters_holder[i] = getGlobalCounter(i);
+    }
+    else
+    {
+        for (Event i = 0; i < num_counters; ++i)
+            res.counters_holder[i] = counters[i].load(std::memory_order_relaxed);
+    }
     return res;
 }
 
@@ -562,6 +620,11 @@ void incrementNoTrace(Event event, Count amount)
     DB::CurrentThread::getProfileEvents().incrementNoTrace(event, amount);
 }
 
+void traceWait(Event event, UInt64 elapsed_ns)
+{
+    DB::CurrentThread::getProfileEvents().traceWait(event, elapsed_ns);
+}
+
 void Counters::increment(Event event, Count amount)
 {
     Counters * current = this;
@@ -570,7 +633,10 @@ void Counters::increment(Event event, Count amount)
     do
     {
         send_to_trace_log |= current->trace_profile_events;
-        current->counters[event].fetch_add(amount, std::memory_order_relaxed);
+        if (current->level == VariableContext::Global)
+            getGlobalCountersShard()[event].fetch_add(amount, std::memory_order_relaxed);
+        else
+            current->counters[event].fetch_add(amount, std::memory_order_relaxed);
         current = current->parent;
     } while (current != nullptr);
 
@@ -578,12 +644,28 @@ void Counters::increment(Event event, Count amount)
         DB::TraceSender::send(DB::TraceType::ProfileEvent, StackTrace(), {.event = event, .increment = amount});
 }
 
+void Counters::traceWait(Event event, UInt64 elapsed_ns)
+{
+    bool send_to_trace_log = false;
+
+    for (Counters * current = this; current != nullptr; current = current->parent)
+        send_to_trace_log |= current->trace_waits;
+
+    if (likely(!send_to_trace_log))
+        return;
+
+    DB::TraceSender::send(DB::TraceType::Wait, StackTrace(), {.size = static_cast<Int64>(elapsed_ns), .event = event});
+}
+
 void Counters::incrementNoTrace(Event event, Count amount)
 {
     Counters * current = this;
     do
     {
-        current->counters[event].fetch_add(amount, std::memory_order_relaxed);
+        if (current->level == VariableContext::Global)
+            getGlobalCountersShard()[event].fetch_add(amount, std::memory_order_relaxed);
+        else
+            current->counters[event].fetch_add(amount, std::memory_order_relaxed);
         current = current->parent;
     } while (current != nullptr);
 }
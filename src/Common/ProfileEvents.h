@@ -31,6 +31,7 @@ namespace ProfileEvents
         /// Used to propagate increments
         Counters * parent = nullptr;
         bool trace_profile_events = false;
+        bool trace_waits = false;
 
     public:
 
@@ -55,6 +56,7 @@ namespace ProfileEvents
 
         void increment(Event event, Count amount = 1);
         void incrementNoTrace(Event event, Count amount = 1);
+        void traceWait(Event event, UInt64 elapsed_ns);
 
         struct Snapshot
         {
@@ -97,6 +99,11 @@ namespace ProfileEvents
             trace_profile_events = value;
         }
 
+        void setTraceWaits(bool value)
+        {
+            trace_waits = value;
+        }
+
         /// Set all counters to zero
         void resetCounters();
 
@@ -106,10 +113,20 @@ namespace ProfileEvents
     /// Increment a counter for event. Thread-safe.
     void increment(Event event, Count amount = 1);
 
+    /// Get the current global value of the counter. The global level is sharded between threads
+    /// to avoid cache-line ping-pong on hot counters, so reading global_counters[event] directly
+    /// returns zero; this function sums the shards up.
+    Count getGlobalCounter(Event event);
+
     /// The same as above but ignores value of setting 'trace_profile_events'
     /// and never sends profile event to trace log.
     void incrementNoTrace(Event event, Count amount = 1);
 
+    /// Send a sample with 'Wait' trace type and the wait time to the trace log,
+    /// if it is enabled for the current thread (see setting 'trace_waits').
+    /// 'event' describes the cause of the wait: a lock, polling for asynchronous IO, etc.
+    void traceWait(Event event, UInt64 elapsed_ns);
+
     /// Get name of event by identifier. Returns statically allocated string.
     const char * getName(Event event);
 
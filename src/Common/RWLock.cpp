@@ -172,6 +172,9 @@ RWLockImpl::getLock(RWLockImpl::Type type, const String & query_id, const std::c
             ++it_group->requests;
             it_group->cv.wait(state_lock, predicate);
             --it_group->requests;
+
+            ProfileEvents::traceWait((type == Read) ? ProfileEvents::RWLockReadersWaitMilliseconds
+                                                    : ProfileEvents::RWLockWritersWaitMilliseconds, watch.elapsedNanoseconds());
         }
         else
         {
@@ -179,6 +182,9 @@ RWLockImpl::getLock(RWLockImpl::Type type, const String & query_id, const std::c
             const auto wait_result = it_group->cv.wait_until(state_lock, lock_deadline_tp, predicate);
             --it_group->requests;
 
+            ProfileEvents::traceWait((type == Read) ? ProfileEvents::RWLockReadersWaitMilliseconds
+                                                    : ProfileEvents::RWLockWritersWaitMilliseconds, watch.elapsedNanoseconds());
+
             /// Step 3a. Check if we must handle timeout and exit
             if (!wait_result)  /// Wait timed out!
             {
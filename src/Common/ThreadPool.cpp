@@ -24,10 +24,13 @@ namespace CurrentMetrics
 {
     extern const Metric GlobalThread;
     extern const Metric GlobalThreadActive;
+    extern const Metric GlobalThreadPoolHighPriorityJobs;
     extern const Metric LocalThread;
     extern const Metric LocalThreadActive;
 }
 
+thread_local ssize_t GlobalThreadPoolJobPriorityScope::current = 0;
+
 
 template <typename Thread>
 ThreadPoolImpl<Thread>::ThreadPoolImpl()
@@ -156,6 +159,9 @@ ReturnType ThreadPoolImpl<Thread>::scheduleImpl(Job job, ssize_t priority, std::
                      propagate_opentelemetry_tracing_context ? DB::OpenTelemetry::CurrentContext() : DB::OpenTelemetry::TracingContextOnThread());
 
         ++scheduled_jobs;
+
+        if (std::is_same_v<Thread, std::thread> && priority > 0)
+            CurrentMetrics::add(CurrentMetrics::GlobalThreadPoolHighPriorityJobs);
     }
 
     new_job_or_shutdown.notify_one();
@@ -254,6 +260,7 @@ void ThreadPoolImpl<Thread>::worker(typename std::list<Thread>::iterator thread_
         setThreadName("ThreadPool");
 
         Job job;
+        ssize_t job_priority = 0;
         bool need_shutdown = false;
 
         /// A copy of parent trace context
@@ -268,6 +275,7 @@ void ThreadPoolImpl<Thread>::worker(typename std::list<Thread>::iterator thread_
             {
                 /// boost::priority_queue does not provide interface for getting non-const reference to an element
                 /// to prevent us from modifying its priority. We have to use const_cast to force move semantics on JobWithPriority::job.
+                job_priority = jobs.top().priority;
                 job = std::move(const_cast<Job &>(jobs.top().job));
                 parent_thead_trace_context = std::move(const_cast<DB::OpenTelemetry::TracingContextOnThread &>(jobs.top().thread_trace_context));
                 jobs.pop();
@@ -326,12 +334,18 @@ void ThreadPoolImpl<Thread>::worker(typename std::list<Thread>::iterator thread_
                     --scheduled_jobs;
                 }
 
+                if (std::is_same_v<Thread, std::thread> && job_priority > 0)
+                    CurrentMetrics::sub(CurrentMetrics::GlobalThreadPoolHighPriorityJobs);
+
                 job_finished.notify_all();
                 new_job_or_shutdown.notify_all();
                 return;
             }
         }
 
+        if (std::is_same_v<Thread, std::thread> && job_priority > 0)
+            CurrentMetrics::sub(CurrentMetrics::GlobalThreadPoolHighPriorityJobs);
+
         {
             std::lock_guard lock(mutex);
             --scheduled_jobs;
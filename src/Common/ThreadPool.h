@@ -154,6 +154,27 @@ public:
 };
 
 
+/** RAII: raises the priority of jobs that the current thread schedules on the global pool.
+  * The priority is inherited by threads started through ThreadFromGlobalPool (and thus by
+  * workers of local ThreadPool-s created from them), so everything spawned on behalf of a
+  * high-priority activity — e.g. query worker threads and their IO callbacks — jumps ahead
+  * of a burst of background thread-start jobs in the global pool queue.
+  * Greater is higher, as everywhere in ThreadPool.
+  */
+class GlobalThreadPoolJobPriorityScope
+{
+public:
+    explicit GlobalThreadPoolJobPriorityScope(ssize_t priority_) : previous(current) { current = priority_; }
+    ~GlobalThreadPoolJobPriorityScope() { current = previous; }
+
+    static ssize_t getCurrent() { return current; }
+
+private:
+    ssize_t previous;
+    static thread_local ssize_t current;
+};
+
+
 /** Looks like std::thread but allocates threads in GlobalThreadPool.
   * Also holds ThreadStatus for ClickHouse.
   *
@@ -170,11 +191,16 @@ public:
     explicit ThreadFromGlobalPoolImpl(Function && func, Args &&... args)
         : state(std::make_shared<State>())
     {
+        /// The thread-start job runs in the global pool queue with the priority of the
+        /// spawning scope, so e.g. query worker spawn is not delayed by background bursts.
+        ssize_t priority = GlobalThreadPoolJobPriorityScope::getCurrent();
+
         /// NOTE:
         /// - If this will throw an exception, the destructor won't be called
         /// - this pointer cannot be passed in the lambda, since after detach() it will not be valid
         GlobalThreadPool::instance().scheduleOrThrow([
             state = state,
+            priority,
             func = std::forward<Function>(func),
             args = std::make_tuple(std::forward<Args>(args)...)]() mutable /// mutable is needed to destroy capture
         {
@@ -185,6 +211,11 @@ public:
 
             state->thread_id = std::this_thread::get_id();
 
+            /// Inherit the spawner's priority, so threads started from this one
+            /// (e.g. workers of local thread pools) keep it. The scope also resets
+            /// it before this pooled thread is reused for an unrelated job.
+            GlobalThreadPoolJobPriorityScope priority_scope(priority);
+
             /// This moves are needed to destroy function and arguments before exit.
             /// It will guarantee that after ThreadFromGlobalPool::join all captured params are destroyed.
             auto function = std::move(func);
@@ -195,7 +226,7 @@ public:
             DB::ThreadStatus thread_status;
             std::apply(function, arguments);
         },
-        0, // default priority
+        priority,
         0, // default wait_microseconds
         propagate_opentelemetry_context
         );
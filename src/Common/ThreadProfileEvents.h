@@ -156,6 +156,9 @@ struct PerfEventsCounters
 
 
     void initializeProfileEvents(const std::string & events_list);
+    /// Account the deltas since the previous update without disabling the events,
+    /// so that the counters keep running. Useful for attributing events to narrow scopes.
+    void updateProfileEvents(ProfileEvents::Counters & profile_events);
     void finalizeProfileEvents(ProfileEvents::Counters & profile_events);
     void closeEventDescriptors();
     bool processThreadLocalChanges(const std::string & needed_events_list);
@@ -174,6 +177,7 @@ extern thread_local PerfEventsCounters current_thread_counters;
 struct PerfEventsCounters
 {
     void initializeProfileEvents(const std::string & /* events_list */) {}
+    void updateProfileEvents(ProfileEvents::Counters & /* profile_events */) {}
     void finalizeProfileEvents(ProfileEvents::Counters & /* profile_events */) {}
     void closeEventDescriptors() {}
 };
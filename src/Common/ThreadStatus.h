@@ -124,6 +124,9 @@ public:
 
     /// TODO: merge them into common entity
     ProfileEvents::Counters performance_counters{VariableContext::Thread};
+    /// Points to performance_counters by default.
+    /// Could be changed to point to another object to calculate performance counters for some narrow scope.
+    ProfileEvents::Counters * current_performance_counters = &performance_counters;
     MemoryTracker memory_tracker{VariableContext::Thread};
 
     /// Small amount of untracked memory (per thread atomic-less counter)
@@ -244,6 +247,11 @@ public:
     /// Attaches slave thread to existing thread group
     void attachQuery(const ThreadGroupStatusPtr & thread_group_, bool check_detached = true);
 
+    /// Makes performance counters of a narrower scope (e.g. of a single processor)
+    /// the target for subsequent increments on this thread. Returns the previous target
+    /// so that the caller can restore it. See ProfileEventsScope.
+    ProfileEvents::Counters * attachProfileCountersScope(ProfileEvents::Counters * performance_counters_scope);
+
     InternalTextLogsQueuePtr getInternalTextLogsQueue() const
     {
         return thread_state == Died ? nullptr : logs_queue_ptr.lock();
@@ -19,6 +19,7 @@ enum class TraceType : uint8_t
     MemorySample,
     MemoryPeak,
     ProfileEvent,
+    Wait,
 };
 
 /// This is the second part of TraceCollector, that sends stacktrace to the pipe.
@@ -28,7 +29,8 @@ class TraceSender
 public:
     struct Extras
     {
-        /// size - for memory tracing is the amount of memory allocated; for other trace types it is 0.
+        /// size - for memory tracing is the amount of memory allocated;
+        /// for 'Wait' it is the wait time in nanoseconds; for other trace types it is 0.
         Int64 size{};
         /// Event type and increment for 'ProfileEvent' trace type; for other trace types defaults.
         ProfileEvents::Event event{ProfileEvents::end()};
@@ -23,6 +23,10 @@ inline char hexDigitLowercase(unsigned char c)
 
 #include <base/types.h>
 
+#if defined(__SSSE3__)
+#    include <tmmintrin.h>
+#endif
+
 
 /// Maps 0..255 to 00..FF or 00..ff correspondingly
 
@@ -39,6 +43,26 @@ inline void writeHexByteLowercase(UInt8 byte, void * out)
     memcpy(out, &hex_byte_to_char_lowercase_table[static_cast<size_t>(byte) * 2], 2);
 }
 
+/// Converts a sequence of 16 bytes into 32 hex characters at once.
+/// With SSSE3 this is two vector nibble lookups instead of 16 scalar table loads.
+inline void writeHexLowercase16(const UInt8 * __restrict src, UInt8 * __restrict dst)
+{
+#if defined(__SSSE3__)
+    const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+
+    const __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask));
+    const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(input, nibble_mask));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 16), _mm_unpackhi_epi8(hi, lo));
+#else
+    for (size_t i = 0; i < 16; ++i)
+        writeHexByteLowercase(src[i], dst + 2 * i);
+#endif
+}
+
 extern const char * const bin_byte_to_char_table;
 
 inline void writeBinByte(UInt8 byte, void * out)
@@ -177,6 +177,27 @@ TEST(ConcurrencyControl, FairGranting)
     }
 }
 
+TEST(ConcurrencyControl, WeightedFairGranting)
+{
+    ConcurrencyControlTest t(3);
+    auto start_busy_period = t.cc.allocate(3, 3);
+    auto a1 = t.cc.allocate(0, 100, 2);
+    auto a2 = t.cc.allocate(0, 100, 1);
+    start_busy_period.reset();
+    for (int i = 0; i < 10; i++)
+    {
+        // Allocation with weight 2 receives two slots per round, allocation with weight 1 -- one slot
+        auto s1a = a1->tryAcquire();
+        ASSERT_TRUE(s1a);
+        auto s1b = a1->tryAcquire();
+        ASSERT_TRUE(s1b);
+        ASSERT_TRUE(!a1->tryAcquire());
+        auto s2 = a2->tryAcquire();
+        ASSERT_TRUE(s2);
+        ASSERT_TRUE(!a2->tryAcquire());
+    }
+}
+
 TEST(ConcurrencyControl, SetSlotCount)
 {
     ConcurrencyControlTest t(10);
@@ -0,0 +1,41 @@
+#include <Common/ThreadPool.h>
+
+#include <gtest/gtest.h>
+
+
+/// Threads started through ThreadFromGlobalPool must inherit the global pool job priority
+/// of the spawning scope, and pooled threads must not leak it to unrelated jobs.
+
+TEST(ThreadPool, JobPriorityInheritance)
+{
+    ASSERT_EQ(GlobalThreadPoolJobPriorityScope::getCurrent(), 0);
+
+    ssize_t priority_in_thread = -1;
+    ssize_t priority_in_nested_thread = -1;
+
+    {
+        GlobalThreadPoolJobPriorityScope priority_scope(7);
+        ASSERT_EQ(GlobalThreadPoolJobPriorityScope::getCurrent(), 7);
+
+        ThreadFromGlobalPool thread([&]
+        {
+            priority_in_thread = GlobalThreadPoolJobPriorityScope::getCurrent();
+
+            ThreadFromGlobalPool nested_thread([&]
+            {
+                priority_in_nested_thread = GlobalThreadPoolJobPriorityScope::getCurrent();
+            });
+            nested_thread.join();
+        });
+        thread.join();
+    }
+
+    EXPECT_EQ(priority_in_thread, 7);
+    EXPECT_EQ(priority_in_nested_thread, 7);
+    EXPECT_EQ(GlobalThreadPoolJobPriorityScope::getCurrent(), 0);
+
+    ssize_t priority_outside_scope = -1;
+    ThreadFromGlobalPool thread([&] { priority_outside_scope = GlobalThreadPoolJobPriorityScope::getCurrent(); });
+    thread.join();
+    EXPECT_EQ(priority_outside_scope, 0);
+}
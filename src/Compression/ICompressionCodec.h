@@ -22,6 +22,15 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size);
 
 /**
 * Represents interface for compression codecs like LZ4, ZSTD, etc.
+*
+* This interface is also the extension point for hardware compression offload.
+* A codec backed by a hardware engine keeps a software sub-codec for transparent
+* fallback and implements the CodecMode/flushAsynchronousDecompressRequests
+* protocol below, so that the compressed read buffers can batch decompression
+* requests to the hardware queue instead of spending query threads on them.
+* CompressionCodecDeflateQpl (Intel IAA) is the model implementation; another
+* engine (e.g. QAT) would be added the same way as a new codec, its hardware
+* library permitting.
 */
 class ICompressionCodec : private boost::noncopyable
 {
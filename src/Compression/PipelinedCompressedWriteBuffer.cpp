@@ -0,0 +1,88 @@
+#include <city.h>
+#include <cstring>
+
+#include <base/types.h>
+#include <base/defines.h>
+
+#include <Common/Exception.h>
+#include <Compression/CompressionFactory.h>
+#include <Compression/PipelinedCompressedWriteBuffer.h>
+
+
+namespace DB
+{
+
+static constexpr auto CHECKSUM_SIZE{sizeof(CityHash_v1_0_2::uint128)};
+
+PipelinedCompressedWriteBuffer::PipelinedCompressedWriteBuffer(
+    WriteBuffer & out_, CompressionCodecPtr codec_, ThreadPool & pool_, size_t buf_size)
+    : BufferWithOwnMemory<WriteBuffer>(buf_size)
+    , out(out_)
+    , codec(std::move(codec_))
+    , schedule(threadPoolCallbackRunner<UInt32>(pool_, "NetCompress"))
+{
+}
+
+void PipelinedCompressedWriteBuffer::nextImpl()
+{
+    if (!offset())
+        return;
+
+    drain();
+
+    /// Move the filled buffer aside for background compression and continue filling the other one.
+    size_t uncompressed_size = offset();
+    pending_uncompressed.swap(memory);
+
+    if (memory.size() != internal_buffer.size())
+        memory.resize(internal_buffer.size());
+
+    internal_buffer = Buffer(memory.data(), memory.data() + memory.size());
+    working_buffer = internal_buffer;
+
+    pending_frame = schedule([this, uncompressed_size]() -> UInt32
+    {
+        chassert(uncompressed_size <= INT_MAX);
+        UInt32 decompressed_size = static_cast<UInt32>(uncompressed_size);
+        UInt32 compressed_reserve_size = codec->getCompressedReserveSize(decompressed_size);
+
+        compressed_buffer.resize(CHECKSUM_SIZE + compressed_reserve_size);
+        UInt32 compressed_size = codec->compress(pending_uncompressed.data(), decompressed_size, compressed_buffer.data() + CHECKSUM_SIZE);
+
+        CityHash_v1_0_2::uint128 checksum = CityHash_v1_0_2::CityHash128(compressed_buffer.data() + CHECKSUM_SIZE, compressed_size);
+        memcpy(compressed_buffer.data(), reinterpret_cast<const char *>(&checksum), CHECKSUM_SIZE);
+
+        return CHECKSUM_SIZE + compressed_size;
+    }, 0);
+}
+
+void PipelinedCompressedWriteBuffer::drain()
+{
+    if (!pending_frame.valid())
+        return;
+
+    UInt32 frame_size = pending_frame.get();
+    out.write(compressed_buffer.data(), frame_size);
+}
+
+void PipelinedCompressedWriteBuffer::finalizeImpl()
+{
+    next();
+    drain();
+}
+
+PipelinedCompressedWriteBuffer::~PipelinedCompressedWriteBuffer()
+{
+    /// Unlike CompressedWriteBuffer, swallow exceptions here: the destructor must not
+    /// leave before the in-flight task is awaited, even if the underlying socket is broken.
+    try
+    {
+        finalize();
+    }
+    catch (...)
+    {
+        tryLogCurrentException(__PRETTY_FUNCTION__);
+    }
+}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <future>
+#include <memory>
+
+#include <Common/PODArray.h>
+#include <Compression/ICompressionCodec.h>
+#include <IO/WriteBuffer.h>
+#include <IO/BufferWithOwnMemory.h>
+#include <Interpreters/threadPoolCallbackRunner.h>
+
+
+namespace DB
+{
+
+/** Works like CompressedWriteBuffer, but compresses each block in a thread from the IO pool,
+  * overlapping compression with serialization of the next block and with writes of the previous
+  * compressed block to the underlying buffer (e.g. socket writes).
+  *
+  * The underlying buffer is only ever written from the calling thread: the compressed block
+  * is flushed at the beginning of the following next() call. At most one compression task
+  * is in flight, so blocks are written in order. Callers that interleave other writes to the
+  * underlying buffer (like the TCP protocol packet headers) must call drain() first.
+  */
+class PipelinedCompressedWriteBuffer final : public BufferWithOwnMemory<WriteBuffer>
+{
+public:
+    PipelinedCompressedWriteBuffer(
+        WriteBuffer & out_,
+        CompressionCodecPtr codec_,
+        ThreadPool & pool_,
+        size_t buf_size = DBMS_DEFAULT_BUFFER_SIZE);
+
+    ~PipelinedCompressedWriteBuffer() override;
+
+    /// Wait for the in-flight compression task, if any, and write its result to the
+    /// underlying buffer. After this call it is safe to write to the underlying buffer directly.
+    void drain();
+
+private:
+    void nextImpl() override;
+    void finalizeImpl() override;
+
+    WriteBuffer & out;
+    CompressionCodecPtr codec;
+    ThreadPoolCallbackRunner<UInt32> schedule;
+
+    /// Data being compressed by the in-flight task.
+    Memory<> pending_uncompressed;
+    /// Checksum followed by the compressed block; filled by the task, written by drain().
+    PODArray<char> compressed_buffer;
+    /// Size of the data in compressed_buffer.
+    std::future<UInt32> pending_frame;
+};
+
+}
@@ -9,6 +9,7 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <Common/Exception.h>
 #include <Common/SipHash.h>
+#include <Common/Stopwatch.h>
 #include <Common/logger_useful.h>
 
 
@@ -274,13 +275,15 @@ Changelog::Changelog(
     uint64_t rotate_interval_,
     bool force_sync_,
     Poco::Logger * log_,
-    bool compress_logs_)
+    bool compress_logs_,
+    uint64_t flush_window_ms_)
     : changelogs_dir(changelogs_dir_)
     , changelogs_detached_dir(changelogs_dir / "detached")
     , rotate_interval(rotate_interval_)
     , force_sync(force_sync_)
     , log(log_)
     , compress_logs(compress_logs_)
+    , flush_window_ms(flush_window_ms_)
     , write_operations(std::numeric_limits<size_t>::max())
     , append_completion_queue(std::numeric_limits<size_t>::max())
 {
@@ -571,23 +574,54 @@ void Changelog::writeThread()
     {
         assert(initialized);
 
-        if (auto * append_log = std::get_if<AppendLog>(&write_operation))
+        /// Group commit: after popping one operation, drain everything that is already queued
+        /// (and, if a flush window is configured, whatever arrives within the window), appending
+        /// entries in queue order and coalescing all flush requests of the group into one fsync.
+        std::optional<uint64_t> flush_index;
+
+        auto process_operation = [&](WriteOperation & operation)
         {
-            std::lock_guard writer_lock(writer_mutex);
-            assert(current_writer);
+            if (auto * append_log = std::get_if<AppendLog>(&operation))
+            {
+                std::lock_guard writer_lock(writer_mutex);
+                assert(current_writer);
 
-            const auto & current_changelog_description = existing_changelogs[current_writer->getStartIndex()];
-            const bool log_is_complete = append_log->index - current_writer->getStartIndex() == current_changelog_description.expectedEntriesCountInLog();
+                const auto & current_changelog_description = existing_changelogs[current_writer->getStartIndex()];
+                const bool log_is_complete = append_log->index - current_writer->getStartIndex() == current_changelog_description.expectedEntriesCountInLog();
 
-            if (log_is_complete)
-                rotate(append_log->index, writer_lock);
+                if (log_is_complete)
+                    rotate(append_log->index, writer_lock);
 
-            current_writer->appendRecord(buildRecord(append_log->index, append_log->log_entry));
-        }
-        else
+                current_writer->appendRecord(buildRecord(append_log->index, append_log->log_entry));
+            }
+            else
+            {
+                /// Operations are processed in queue order, so all entries covered by this flush
+                /// request were already appended and a single fsync at the end makes them durable.
+                flush_index = std::get<Flush>(operation).index;
+            }
+        };
+
+        process_operation(write_operation);
+
+        if (flush_index && flush_window_ms)
         {
-            const auto & flush = std::get<Flush>(write_operation);
+            /// Delay the fsync a little to absorb concurrent appends and flush requests.
+            /// The added flush latency is capped by the window.
+            Stopwatch watch;
+            UInt64 elapsed_ms = 0;
+            while (elapsed_ms < flush_window_ms && write_operations.tryPop(write_operation, flush_window_ms - elapsed_ms))
+            {
+                process_operation(write_operation);
+                elapsed_ms = watch.elapsedMilliseconds();
+            }
+        }
 
+        while (write_operations.tryPop(write_operation))
+            process_operation(write_operation);
+
+        if (flush_index)
+        {
             {
                 std::lock_guard writer_lock(writer_mutex);
                 if (current_writer)
@@ -596,7 +630,7 @@ void Changelog::writeThread()
 
             {
                 std::lock_guard lock{durable_idx_mutex};
-                last_durable_idx = flush.index;
+                last_durable_idx = *flush_index;
             }
 
             durable_idx_cv.notify_all();
@@ -605,7 +639,7 @@ void Changelog::writeThread()
             // NuRaft will in some places wait for flush to be done while having the same global lock leading to deadlock
             // -> future write operations are blocked by flush that cannot be completed because it cannot take NuRaft lock
             // -> NuRaft won't leave lock until its flush is done
-            if (!append_completion_queue.push(flush.index))
+            if (!append_completion_queue.push(*flush_index))
                 LOG_WARNING(log, "Changelog is shut down");
         }
     }
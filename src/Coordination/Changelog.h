@@ -77,7 +77,7 @@ class Changelog
 
 public:
     Changelog(const std::string & changelogs_dir_, uint64_t rotate_interval_,
-            bool force_sync_, Poco::Logger * log_, bool compress_logs_ = true);
+            bool force_sync_, Poco::Logger * log_, bool compress_logs_ = true, uint64_t flush_window_ms_ = 0);
 
     /// Read changelog from files on changelogs_dir_ skipping all entries before from_log_index
     /// Truncate broken entries, remove files after broken entries.
@@ -173,6 +173,8 @@ private:
     const bool force_sync;
     Poco::Logger * log;
     bool compress_logs;
+    /// How long to wait for more write operations after a flush request to group fsyncs.
+    const uint64_t flush_window_ms;
 
     std::mutex writer_mutex;
     /// Current writer for changelog file
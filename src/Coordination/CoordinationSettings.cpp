@@ -146,6 +146,8 @@ void KeeperConfigurationAndSettings::dump(WriteBufferFromOwnString & buf) const
     write_int(coordination_settings->max_requests_quick_batch_size);
     writeText("quorum_reads=", buf);
     write_bool(coordination_settings->quorum_reads);
+    writeText("read_request_threads=", buf);
+    write_int(coordination_settings->read_request_threads);
     writeText("force_sync=", buf);
     write_bool(coordination_settings->force_sync);
 
@@ -41,7 +41,9 @@ struct Settings;
     M(UInt64, max_requests_batch_size, 100, "Max size of batch of requests that can be sent to RAFT", 0) \
     M(UInt64, max_requests_quick_batch_size, 10, "Max size of batch of requests to try to get before proceeding with RAFT. Keeper will not wait for requests but take only requests that are already in queue" , 0) \
     M(Bool, quorum_reads, false, "Execute read requests as writes through whole RAFT consesus with similar speed", 0) \
+    M(UInt64, read_request_threads, 1, "Number of threads processing read requests from local state. Requests of one session are always processed by the same thread in order, requests of distinct sessions are processed concurrently", 0) \
     M(Bool, force_sync, true, "Call fsync on each change in RAFT changelog", 0) \
+    M(Milliseconds, log_flush_window_ms, 0, "How long the changelog write thread waits for more entries after a flush request to group several fsyncs into one. 0 means fsync each flush request immediately", 0) \
     M(Bool, compress_logs, true, "Write compressed coordination logs in ZSTD format", 0) \
     M(Bool, compress_snapshots_with_zstd_format, true, "Write compressed snapshots in ZSTD format (instead of custom LZ4)", 0) \
     M(UInt64, configuration_change_tries_count, 20, "How many times we will try to apply configuration change (add/remove server) to the cluster", 0)
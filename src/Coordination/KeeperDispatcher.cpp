@@ -82,6 +82,8 @@ void KeeperDispatcher::requestThread()
                 /// Otherwise we will process it locally.
                 if (coordination_settings->quorum_reads || !request.request->isReadRequest())
                 {
+                    /// Don't reorder the write with still unprocessed reads of the same session.
+                    waitReadsProcessed(request.session_id);
                     current_batch.emplace_back(request);
 
                     const auto try_get_request = [&]
@@ -92,9 +94,14 @@ void KeeperDispatcher::requestThread()
                             CurrentMetrics::sub(CurrentMetrics::KeeperOutstandingRequets);
                             /// Don't append read request into batch, we have to process them separately
                             if (!coordination_settings->quorum_reads && request.request->isReadRequest())
+                            {
                                 has_read_request = true;
+                            }
                             else
+                            {
+                                waitReadsProcessed(request.session_id);
                                 current_batch.emplace_back(request);
+                            }
 
                             return true;
                         }
@@ -150,14 +157,11 @@ void KeeperDispatcher::requestThread()
                     prev_result = result;
                 }
 
-                /// Read request always goes after write batch (last request)
+                /// Read request always goes after write batch (last request).
+                /// It is handed over to one of the read threads, so the dispatcher
+                /// can continue to batch writes while the read is processed.
                 if (has_read_request)
-                {
-                    if (server->isLeaderAlive())
-                        server->putLocalReadRequest(request);
-                    else
-                        addErrorResponses({request}, Coordination::Error::ZCONNECTIONLOSS);
-                }
+                    scheduleReadRequest(request);
             }
         }
         catch (...)
@@ -193,6 +197,78 @@ void KeeperDispatcher::responseThread()
     }
 }
 
+void KeeperDispatcher::readRequestThread(size_t thread_num)
+{
+    setThreadName("KeeperReadT");
+
+    auto & queue = *read_requests_queues[thread_num];
+    while (!shutdown_called)
+    {
+        KeeperStorage::RequestForSession request;
+
+        uint64_t max_wait = configuration_and_settings->coordination_settings->operation_timeout_ms.totalMilliseconds();
+
+        if (queue.tryPop(request, max_wait))
+        {
+            if (shutdown_called)
+            {
+                onReadRequestProcessed(request.session_id);
+                break;
+            }
+
+            try
+            {
+                if (server->isLeaderAlive())
+                    server->putLocalReadRequest(request);
+                else
+                    addErrorResponses({request}, Coordination::Error::ZCONNECTIONLOSS);
+            }
+            catch (...)
+            {
+                tryLogCurrentException(__PRETTY_FUNCTION__);
+            }
+
+            onReadRequestProcessed(request.session_id);
+        }
+    }
+}
+
+void KeeperDispatcher::scheduleReadRequest(const KeeperStorage::RequestForSession & request)
+{
+    {
+        std::lock_guard lock(read_requests_in_flight_mutex);
+        ++read_requests_in_flight[request.session_id];
+    }
+
+    auto & queue = *read_requests_queues[static_cast<uint64_t>(request.session_id) % read_requests_queues.size()];
+    if (!queue.push(request))
+    {
+        /// The queue may be finished only during shutdown.
+        onReadRequestProcessed(request.session_id);
+        addErrorResponses({request}, Coordination::Error::ZCONNECTIONLOSS);
+    }
+}
+
+void KeeperDispatcher::waitReadsProcessed(int64_t session_id)
+{
+    std::unique_lock lock(read_requests_in_flight_mutex);
+    read_request_processed.wait(lock, [&]
+    {
+        return shutdown_called || !read_requests_in_flight.contains(session_id);
+    });
+}
+
+void KeeperDispatcher::onReadRequestProcessed(int64_t session_id)
+{
+    {
+        std::lock_guard lock(read_requests_in_flight_mutex);
+        auto it = read_requests_in_flight.find(session_id);
+        if (it != read_requests_in_flight.end() && --it->second == 0)
+            read_requests_in_flight.erase(it);
+    }
+    read_request_processed.notify_all();
+}
+
 void KeeperDispatcher::snapshotThread()
 {
     setThreadName("KeeperSnpT");
@@ -303,10 +379,19 @@ void KeeperDispatcher::initialize(const Poco::Util::AbstractConfiguration & conf
     configuration_and_settings = KeeperConfigurationAndSettings::loadFromConfig(config, standalone_keeper);
     requests_queue = std::make_unique<RequestsQueue>(configuration_and_settings->coordination_settings->max_request_queue_size);
 
+    size_t read_threads_count = std::max<size_t>(1, configuration_and_settings->coordination_settings->read_request_threads);
+    read_requests_queues.reserve(read_threads_count);
+    for (size_t i = 0; i < read_threads_count; ++i)
+        read_requests_queues.push_back(std::make_unique<RequestsQueue>(std::numeric_limits<size_t>::max()));
+
     request_thread = ThreadFromGlobalPool([this] { requestThread(); });
     responses_thread = ThreadFromGlobalPool([this] { responseThread(); });
     snapshot_thread = ThreadFromGlobalPool([this] { snapshotThread(); });
 
+    read_request_threads.reserve(read_threads_count);
+    for (size_t i = 0; i < read_threads_count; ++i)
+        read_request_threads.emplace_back([this, i] { readRequestThread(i); });
+
     snapshot_s3.startup(config, macros);
 
     server = std::make_unique<KeeperServer>(configuration_and_settings, config, responses_queue, snapshots_queue, snapshot_s3);
@@ -364,6 +449,17 @@ void KeeperDispatcher::shutdown()
                     request_thread.join();
             }
 
+            /// Only the request thread schedules read requests, so after it is
+            /// joined the read queues don't get new entries and can be finished.
+            for (const auto & read_queue : read_requests_queues)
+                read_queue->finish();
+
+            for (auto & read_thread : read_request_threads)
+                if (read_thread.joinable())
+                    read_thread.join();
+
+            read_request_processed.notify_all();
+
             responses_queue.finish();
             if (responses_thread.joinable())
                 responses_thread.join();
@@ -388,6 +484,16 @@ void KeeperDispatcher::shutdown()
             setResponse(request_for_session.session_id, response);
         }
 
+        for (const auto & read_queue : read_requests_queues)
+        {
+            while (read_queue->tryPop(request_for_session))
+            {
+                auto response = request_for_session.request->makeResponse();
+                response->error = Coordination::Error::ZSESSIONEXPIRED;
+                setResponse(request_for_session.session_id, response);
+            }
+        }
+
         KeeperStorage::RequestsForSessions close_requests;
         {
             /// Clear all registered sessions
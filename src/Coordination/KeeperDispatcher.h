@@ -9,6 +9,7 @@
 #include <Poco/Util/AbstractConfiguration.h>
 #include <Common/Exception.h>
 #include <Common/logger_useful.h>
+#include <condition_variable>
 #include <functional>
 #include <Coordination/KeeperServer.h>
 #include <Coordination/CoordinationSettings.h>
@@ -38,6 +39,18 @@ private:
     ResponsesQueue responses_queue;
     SnapshotsQueue snapshots_queue{1};
 
+    /// Queues of read requests processed from local state, sharded by session id,
+    /// so that requests of one session are processed in order while requests
+    /// of distinct sessions are processed concurrently (see readRequestThread).
+    std::vector<std::unique_ptr<RequestsQueue>> read_requests_queues;
+
+    /// Number of read requests in flight per session. A write request of a session
+    /// is not sent to RAFT until all previous reads of this session are processed,
+    /// to keep the per-session FIFO order of responses.
+    std::mutex read_requests_in_flight_mutex;
+    std::condition_variable read_request_processed;
+    std::unordered_map<int64_t, size_t> read_requests_in_flight;
+
     /// More than 1k updates is definitely misconfiguration.
     UpdateConfigurationQueue update_configuration_queue{1000};
 
@@ -66,6 +79,8 @@ private:
     ThreadFromGlobalPool snapshot_thread;
     /// Apply or wait for configuration changes
     ThreadFromGlobalPool update_configuration_thread;
+    /// Processing read requests from local state
+    std::vector<ThreadFromGlobalPool> read_request_threads;
 
     /// RAFT wrapper.
     std::unique_ptr<KeeperServer> server;
@@ -91,6 +106,15 @@ private:
     void snapshotThread();
     /// Thread apply or wait configuration changes from leader
     void updateConfigurationThread();
+    /// Thread processing read requests from the queue of its shard
+    void readRequestThread(size_t thread_num);
+
+    /// Put read request into the queue of its session's shard.
+    void scheduleReadRequest(const KeeperStorage::RequestForSession & request);
+    /// Wait until all in-flight read requests of the session are processed.
+    /// Called for write requests before sending them to RAFT.
+    void waitReadsProcessed(int64_t session_id);
+    void onReadRequestProcessed(int64_t session_id);
 
     void setResponse(int64_t session_id, const Coordination::ZooKeeperResponsePtr & response);
 
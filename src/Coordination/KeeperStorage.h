@@ -440,6 +440,10 @@ public:
     /// Clear outdated data from internal container.
     void clearGarbageAfterSnapshot() { container.clearOutdatedNodes(); }
 
+    /// Same as above, but the outdated nodes are returned, so that the caller can destroy them
+    /// after releasing the lock protecting the storage.
+    Container::DetachedNodes extractGarbageAfterSnapshot() { return container.detachOutdatedNodes(); }
+
     /// Get all active sessions
     const SessionAndTimeout & getActiveSessions() const { return session_and_timeout; }
 
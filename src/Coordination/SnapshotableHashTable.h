@@ -270,17 +270,32 @@ public:
         return it->getMapped()->value;
     }
 
+    /// Nodes made outdated by the writes in snapshot mode, detached from the table
+    /// but not yet destroyed.
+    using DetachedNodes = List;
+
     void clearOutdatedNodes()
     {
+        detachOutdatedNodes();
+    }
+
+    /// Same as clearOutdatedNodes, but the outdated nodes are unlinked from the table in O(1)
+    /// each and returned to the caller instead of being destroyed in place. The destructors of
+    /// the values dominate the cost of the cleanup for a large storage, so the caller can run
+    /// them by destroying the returned list after releasing the lock protecting the table.
+    DetachedNodes detachOutdatedNodes()
+    {
+        DetachedNodes detached;
         for (auto & itr: snapshot_invalid_iters)
         {
             assert(!itr->active_in_map);
             updateDataSize(CLEAR_OUTDATED_NODES, itr->key.size, itr->value.sizeInBytes(), 0);
             if (itr->free_key)
                 arena.free(const_cast<char *>(itr->key.data), itr->key.size);
-            list.erase(itr);
+            detached.splice(detached.end(), list, itr);
         }
         snapshot_invalid_iters.clear();
+        return detached;
     }
 
     void clear()
@@ -287,6 +287,32 @@ TEST_P(CoordinationTest, ChangelogTestFile)
     EXPECT_TRUE(fs::exists("./logs/changelog_6_10.bin" + params.extension));
 }
 
+TEST_P(CoordinationTest, ChangelogTestGroupCommit)
+{
+    auto params = GetParam();
+    ChangelogDirTest test("./logs");
+    DB::KeeperLogStore changelog("./logs", 100, true, params.enable_compression, /* flush_window_ms = */ 50);
+    changelog.init(1, 0);
+
+    /// Several flush requests racing with the write thread are grouped into fewer fsyncs,
+    /// all entries still must become durable and readable.
+    for (size_t i = 0; i < 10; ++i)
+    {
+        auto entry = getLogEntry("hello world", i * 10);
+        changelog.append(entry);
+        changelog.end_of_append_batch(0, 0);
+    }
+
+    waitDurableLogs(changelog);
+    EXPECT_EQ(changelog.size(), 10);
+    EXPECT_EQ(changelog.last_durable_index(), 10);
+
+    DB::KeeperLogStore changelog_reader("./logs", 100, true, params.enable_compression);
+    changelog_reader.init(1, 0);
+    EXPECT_EQ(changelog_reader.size(), 10);
+    EXPECT_EQ(changelog_reader.last_entry()->get_term(), 90);
+}
+
 TEST_P(CoordinationTest, ChangelogReadWrite)
 {
     auto params = GetParam();
@@ -1153,6 +1179,30 @@ TEST_P(CoordinationTest, SnapshotableHashMapDataSize)
     EXPECT_EQ(world.getApproximateDataSize(), 0);
 }
 
+TEST_P(CoordinationTest, SnapshotableHashMapDetachOutdatedNodes)
+{
+    DB::SnapshotableHashTable<IntNode> map_snp;
+    EXPECT_TRUE(map_snp.insert("/hello", 7).second);
+    EXPECT_TRUE(map_snp.insert("/hello2", 11).second);
+    map_snp.enableSnapshotMode(100000);
+
+    map_snp.insertOrReplace("/hello", 554);
+    EXPECT_TRUE(map_snp.erase("/hello2"));
+    EXPECT_EQ(map_snp.snapshotSizeWithVersion().first, 3);
+    EXPECT_EQ(map_snp.size(), 1);
+
+    /// The outdated nodes are unlinked from the table but stay alive in the returned list.
+    auto detached = map_snp.detachOutdatedNodes();
+    EXPECT_EQ(detached.size(), 2);
+    for (const auto & node : detached)
+        EXPECT_FALSE(node.active_in_map);
+
+    EXPECT_EQ(map_snp.snapshotSizeWithVersion().first, 1);
+    EXPECT_EQ(map_snp.size(), 1);
+    EXPECT_EQ(map_snp.getValue("/hello"), 554);
+    map_snp.disableSnapshotMode();
+}
+
 void addNode(DB::KeeperStorage & storage, const std::string & path, const std::string & data, int64_t ephemeral_owner=0)
 {
     using Node = DB::KeeperStorage::Node;
@@ -82,7 +82,8 @@ namespace Protocol
                                             /// And client returns back response
             ProfileEvents = 14,             /// Packet with profile events from server.
             MergeTreeReadTaskRequest = 15,  /// Request from a MergeTree replica to a coordinator
-            MAX = MergeTreeReadTaskRequest,
+            PartialResult = 16,             /// A block with intermediate (not final) results of an in-progress aggregation.
+            MAX = PartialResult,
 
         };
 
@@ -109,6 +110,7 @@ namespace Protocol
                 "ReadTaskRequest",
                 "ProfileEvents",
                 "MergeTreeReadTaskRequest",
+                "PartialResult",
             };
             return packet <= MAX
                 ? data[packet]
@@ -184,6 +186,19 @@ namespace Protocol
         Enable = 1,
     };
 
+    /// How the Query packet refers to the statement text
+    /// (revisions >= DBMS_MIN_PROTOCOL_VERSION_WITH_PREPARED_STATEMENTS).
+    enum class PreparedStatement
+    {
+        /// The packet carries the full query text.
+        None = 0,
+        /// The full query text follows; the server additionally remembers it
+        /// under its 128-bit hash for the lifetime of the connection.
+        Register = 1,
+        /// Only the 128-bit hash of a previously registered text follows.
+        Execute = 2,
+    };
+
 }
 
 }
@@ -52,7 +52,7 @@
 /// NOTE: DBMS_TCP_PROTOCOL_VERSION has nothing common with VERSION_REVISION,
 /// later is just a number for server version (one number instead of commit SHA)
 /// for simplicity (sometimes it may be more convenient in some use cases).
-#define DBMS_TCP_PROTOCOL_VERSION 54461
+#define DBMS_TCP_PROTOCOL_VERSION 54464
 
 #define DBMS_MIN_PROTOCOL_VERSION_WITH_INITIAL_QUERY_START_TIME 54449
 
@@ -70,3 +70,18 @@
 #define DBMS_MIN_PROTOCOL_VERSION_WITH_SERVER_QUERY_TIME_IN_PROGRESS 54460
 
 #define DBMS_MIN_PROTOCOL_VERSION_WITH_PASSWORD_COMPLEXITY_RULES 54461
+
+/// Send only new LowCardinality dictionary keys with each block of a stream.
+#define DBMS_MIN_PROTOCOL_VERSION_WITH_LOW_CARDINALITY_DELTA_DICTIONARIES 54462
+
+/// The server can send intermediate aggregation results in PartialResult packets
+/// if the query enables partial_result_update_duration_ms.
+#define DBMS_MIN_PROTOCOL_VERSION_WITH_PARTIAL_RESULT 54463
+
+/// The Query packet carries a prepared statement mode: the client may register the query text
+/// under its 128-bit hash on first use and send only the hash (plus parameters) afterwards.
+#define DBMS_MIN_PROTOCOL_VERSION_WITH_PREPARED_STATEMENTS 54464
+
+/// Both sides stop registering new prepared statements on a connection beyond this count,
+/// so the client knows deterministically which statements the server retains.
+#define DBMS_PREPARED_STATEMENTS_PER_CONNECTION 1024
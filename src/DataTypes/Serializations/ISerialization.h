@@ -229,6 +229,10 @@ public:
         size_t low_cardinality_max_dictionary_size = 0;
         bool low_cardinality_use_single_dictionary_for_part = true;
 
+        /// If true, LowCardinality dictionary is accumulated over the blocks of the stream,
+        /// and only the keys which were not serialized yet are written with each block.
+        bool low_cardinality_delta_dictionary = false;
+
         bool position_independent_encoding = true;
     };
 
@@ -244,6 +248,9 @@ public:
 
         bool native_format = false;
 
+        /// See SerializeBinaryBulkSettings::low_cardinality_delta_dictionary.
+        bool low_cardinality_delta_dictionary = false;
+
         /// If not zero, may be used to avoid reallocations while reading column of String type.
         double avg_value_size_hint = 0;
     };
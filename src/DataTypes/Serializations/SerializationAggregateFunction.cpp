@@ -82,30 +82,9 @@ void SerializationAggregateFunction::deserializeBinaryBulk(IColumn & column, Rea
     real_column.set(function, version);
     vec.reserve(vec.size() + limit);
 
-    size_t size_of_state = function->sizeOfData();
-    size_t align_of_state = function->alignOfData();
-
-    for (size_t i = 0; i < limit; ++i)
-    {
-        if (istr.eof())
-            break;
-
-        AggregateDataPtr place = arena.alignedAlloc(size_of_state, align_of_state);
-
-        function->create(place);
-
-        try
-        {
-            function->deserialize(place, istr, version, &arena);
-        }
-        catch (...)
-        {
-            function->destroy(place);
-            throw;
-        }
-
-        vec.push_back(place);
-    }
+    /// One virtual call per column instead of one per row: the inner create/deserialize
+    /// calls are devirtualized inside the aggregate function implementation.
+    function->createAndDeserializeBatch(vec, arena, limit, istr, version);
 }
 
 static String serializeToString(const AggregateFunctionPtr & function, const IColumn & column, size_t row_num, size_t version)
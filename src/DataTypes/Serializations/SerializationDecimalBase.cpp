@@ -35,7 +35,7 @@ void SerializationDecimalBase<T>::serializeBinaryBulk(const IColumn & column, Wr
     if (limit == 0 || offset + limit > size)
         limit = size - offset;
 
-    ostr.write(reinterpret_cast<const char *>(&x[offset]), sizeof(FieldType) * limit);
+    ostr.writeBig(reinterpret_cast<const char *>(&x[offset]), sizeof(FieldType) * limit);
 }
 
 template <typename T>
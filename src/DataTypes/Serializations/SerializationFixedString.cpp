@@ -78,7 +78,7 @@ void SerializationFixedString::serializeBinaryBulk(const IColumn & column, Write
         limit = size - offset;
 
     if (limit)
-        ostr.write(reinterpret_cast<const char *>(&data[n * offset]), n * limit);
+        ostr.writeBig(reinterpret_cast<const char *>(&data[n * offset]), n * limit);
 }
 
 
@@ -146,7 +146,7 @@ struct IndexesSerializationType
         need_update_dictionary = (val & NeedUpdateDictionary) != 0;
         type = static_cast<Type>(resetFlags(val));
 
-        if (settings.native_format)
+        if (settings.native_format && !settings.low_cardinality_delta_dictionary)
         {
             if (need_global_dictionary)
                 throw Exception(ErrorCodes::INCORRECT_DATA,
@@ -237,7 +237,9 @@ void SerializationLowCardinality::serializeBinaryBulkStatePrefix(
 
     writeIntBinary(key_version, *stream);
 
-    state = std::make_shared<SerializeStateLowCardinality>(key_version);
+    /// The state may be kept between the blocks of a stateful stream (see low_cardinality_delta_dictionary).
+    if (!state)
+        state = std::make_shared<SerializeStateLowCardinality>(key_version);
 }
 
 void SerializationLowCardinality::serializeBinaryBulkStateSuffix(
@@ -278,8 +280,11 @@ void SerializationLowCardinality::deserializeBinaryBulkStatePrefix(
 
     UInt64 keys_version;
     readIntBinary(keys_version, *stream);
+    KeysSerializationVersion::checkVersion(keys_version);
 
-    state = std::make_shared<DeserializeStateLowCardinality>(keys_version);
+    /// The state may be kept between the blocks of a stateful stream (see low_cardinality_delta_dictionary).
+    if (!state)
+        state = std::make_shared<DeserializeStateLowCardinality>(keys_version);
 }
 
 namespace
@@ -501,6 +506,44 @@ void SerializationLowCardinality::serializeBinaryBulkWithMultipleStreams(
     ColumnPtr positions = sub_column->getIndexesPtr();
     ColumnPtr keys = sub_column->getDictionary().getNestedColumn();
 
+    if (settings.low_cardinality_delta_dictionary)
+    {
+        /// Stateful stream: the dictionary is accumulated on both ends of the stream, and only
+        /// the keys which were not sent yet are written with the current block (as additional keys).
+        /// Positions reference the accumulated dictionary. When the dictionary overgrows, it is
+        /// dropped, and the next block starts a new one (marked with NeedUpdateDictionary flag).
+        static constexpr size_t max_streaming_dictionary_size = 8192;
+
+        size_t dictionary_size_before = global_dictionary->size();
+        auto indexes = global_dictionary->uniqueInsertRangeFrom(*keys, 0, keys->size());
+        positions = indexes->index(*positions, 0);
+
+        /// New keys are appended to the dictionary in the order of their first occurrence,
+        /// so the reader restores the same key numbering by appending them to its dictionary.
+        ColumnPtr new_keys = global_dictionary->getNestedNotNullableColumn()->cut(
+            dictionary_size_before, global_dictionary->size() - dictionary_size_before);
+
+        IndexesSerializationType index_version(*positions, !new_keys->empty(), true, need_update_dictionary);
+        index_version.serialize(*indexes_stream);
+
+        if (!new_keys->empty())
+        {
+            UInt64 num_keys = new_keys->size();
+            writeIntBinary(num_keys, *indexes_stream);
+            dict_inner_serialization->serializeBinaryBulk(*new_keys, *indexes_stream, 0, num_keys);
+        }
+
+        UInt64 num_rows = positions->size();
+        writeIntBinary(num_rows, *indexes_stream);
+        auto index_serialization = index_version.getDataType()->getDefaultSerialization();
+        index_serialization->serializeBinaryBulk(*positions, *indexes_stream, 0, num_rows);
+
+        if (global_dictionary->size() > max_streaming_dictionary_size)
+            low_cardinality_state->shared_dictionary = nullptr;
+
+        return;
+    }
+
     if (settings.low_cardinality_max_dictionary_size)
     {
         /// Insert used_keys into global dictionary and update sub_index.
@@ -614,7 +657,31 @@ void SerializationLowCardinality::deserializeBinaryBulkWithMultipleStreams(
         }
     };
 
-    auto read_indexes = [this, low_cardinality_state, indexes_stream, &low_cardinality_column](UInt64 num_rows)
+    auto update_dictionary_from_additional_keys = [this, low_cardinality_state]()
+    {
+        /// Delta mode: additional keys of the previous block are appended to the dictionary,
+        /// the following blocks may reference them by position.
+        const auto & additional_keys = low_cardinality_state->additional_keys;
+        if (!additional_keys || additional_keys->empty()
+            || !low_cardinality_state->index_type.need_global_dictionary
+            || !low_cardinality_state->global_dictionary)
+            return;
+
+        ColumnPtr keys_column = additional_keys;
+        if (dictionary_type->isNullable())
+        {
+            ColumnPtr null_map = ColumnUInt8::create(additional_keys->size(), 0);
+            keys_column = ColumnNullable::create(additional_keys, null_map);
+        }
+
+        /// In delta mode the dictionary is exclusively owned by the state (it is never shared
+        /// with the returned column), so it may be updated in place.
+        auto & dictionary = low_cardinality_state->global_dictionary->assumeMutableRef();
+        typeid_cast<IColumnUnique &>(dictionary).uniqueInsertRangeFrom(*keys_column, 0, keys_column->size());
+        low_cardinality_state->additional_keys = nullptr;
+    };
+
+    auto read_indexes = [this, low_cardinality_state, indexes_stream, &low_cardinality_column, &settings](UInt64 num_rows)
     {
         auto indexes_type = low_cardinality_state->index_type.getDataType();
         MutableColumnPtr indexes_column = indexes_type->createColumn();
@@ -636,7 +703,7 @@ void SerializationLowCardinality::deserializeBinaryBulkWithMultipleStreams(
                 keys_column = ColumnNullable::create(additional_keys, low_cardinality_state->null_map);
             low_cardinality_column.insertRangeFromDictionaryEncodedColumn(*keys_column, *indexes_column);
         }
-        else if (!has_additional_keys)
+        else if (!has_additional_keys && !settings.low_cardinality_delta_dictionary)
         {
             if (column_is_empty)
                 low_cardinality_column.setSharedDictionary(global_dictionary);
@@ -685,6 +752,9 @@ void SerializationLowCardinality::deserializeBinaryBulkWithMultipleStreams(
             if (indexes_stream->eof())
                 break;
 
+            if (settings.low_cardinality_delta_dictionary)
+                update_dictionary_from_additional_keys();
+
             auto & index_type = low_cardinality_state->index_type;
             auto & global_dictionary = low_cardinality_state->global_dictionary;
 
@@ -694,7 +764,14 @@ void SerializationLowCardinality::deserializeBinaryBulkWithMultipleStreams(
                 !global_dictionary || index_type.need_update_dictionary || low_cardinality_state->need_update_dictionary;
             if (index_type.need_global_dictionary && need_update_dictionary)
             {
-                read_dictionary();
+                if (settings.low_cardinality_delta_dictionary)
+                {
+                    /// In delta mode the dictionary is never sent as a whole:
+                    /// NeedUpdateDictionary means that the writer restarted from an empty dictionary.
+                    low_cardinality_state->global_dictionary = DataTypeLowCardinality::createColumnUnique(*dictionary_type);
+                }
+                else
+                    read_dictionary();
                 low_cardinality_state->need_update_dictionary = false;
             }
 
@@ -142,7 +142,7 @@ void SerializationNumber<T>::serializeBinaryBulk(const IColumn & column, WriteBu
         limit = size - offset;
 
     if (limit)
-        ostr.write(reinterpret_cast<const char *>(&x[offset]), sizeof(typename ColumnVector<T>::ValueType) * limit);
+        ostr.writeBig(reinterpret_cast<const char *>(&x[offset]), sizeof(typename ColumnVector<T>::ValueType) * limit);
 }
 
 template <typename T>
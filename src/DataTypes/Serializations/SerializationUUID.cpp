@@ -151,7 +151,7 @@ void SerializationUUID::serializeBinaryBulk(const IColumn & column, WriteBuffer
         limit = size - offset;
 
     if (limit)
-        ostr.write(reinterpret_cast<const char *>(&x[offset]), sizeof(UUID) * limit);
+        ostr.writeBig(reinterpret_cast<const char *>(&x[offset]), sizeof(UUID) * limit);
 }
 
 void SerializationUUID::deserializeBinaryBulk(IColumn & column, ReadBuffer & istr, size_t limit, double /*avg_value_size_hint*/) const
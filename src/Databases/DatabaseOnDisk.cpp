@@ -19,6 +19,7 @@
 #include <Common/logger_useful.h>
 #include <Databases/DatabaseOrdinary.h>
 #include <Databases/DatabaseAtomic.h>
+#include <Databases/MetadataGroupCommitter.h>
 #include <Common/assert_cast.h>
 #include <filesystem>
 #include <Common/filesystemHelpers.h>
@@ -220,11 +221,16 @@ void DatabaseOnDisk::createTable(
         WriteBufferFromFile out(table_metadata_tmp_path, statement.size(), O_WRONLY | O_CREAT | O_EXCL);
         writeString(statement, out);
         out.next();
-        if (settings.fsync_metadata)
+        if (settings.fsync_metadata && !settings.fsync_metadata_group_commit)
             out.sync();
         out.close();
     }
 
+    /// With group commit concurrent DDL queries share one syncfs of the metadata filesystem
+    /// instead of queueing behind each other's per-file fsyncs.
+    if (settings.fsync_metadata && settings.fsync_metadata_group_commit)
+        MetadataGroupCommitter::instance().sync(table_metadata_tmp_path);
+
     commitCreateTable(create, table, table_metadata_tmp_path, table_metadata_path, local_context);
 
     removeDetachedPermanentlyFlag(local_context, table_name, table_metadata_path, false);
@@ -787,10 +793,14 @@ void DatabaseOnDisk::modifySettingsMetadata(const SettingsChanges & settings_cha
     writeString(statement, out);
 
     out.next();
-    if (getContext()->getSettingsRef().fsync_metadata)
+    const auto & settings = getContext()->getSettingsRef();
+    if (settings.fsync_metadata && !settings.fsync_metadata_group_commit)
         out.sync();
     out.close();
 
+    if (settings.fsync_metadata && settings.fsync_metadata_group_commit)
+        MetadataGroupCommitter::instance().sync(metadata_file_tmp_path);
+
     fs::rename(metadata_file_tmp_path, metadata_file_path);
 }
 }
@@ -0,0 +1,88 @@
+#include <Databases/MetadataGroupCommitter.h>
+
+#include <Common/Exception.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace DB
+{
+
+namespace ErrorCodes
+{
+    extern const int FILE_DOESNT_EXIST;
+    extern const int CANNOT_FSYNC;
+}
+
+MetadataGroupCommitter & MetadataGroupCommitter::instance()
+{
+    static MetadataGroupCommitter committer;
+    return committer;
+}
+
+static void syncFilesystemOf(const String & path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (-1 == fd)
+        throwFromErrnoWithPath("Cannot open file " + path, path, ErrorCodes::FILE_DOESNT_EXIST);
+
+#if defined(OS_LINUX)
+    int res = ::syncfs(fd);
+#else
+    /// There is no syncfs outside of Linux, fsync of the file itself is the best we can do.
+    int res = ::fsync(fd);
+#endif
+
+    if (-1 == res)
+    {
+        int saved_errno = errno;
+        [[maybe_unused]] int close_res = ::close(fd);
+        errno = saved_errno;
+        throwFromErrnoWithPath("Cannot sync filesystem containing " + path, path, ErrorCodes::CANNOT_FSYNC);
+    }
+
+    [[maybe_unused]] int close_res = ::close(fd);
+}
+
+void MetadataGroupCommitter::sync(const String & path)
+{
+    std::unique_lock lock(mutex);
+
+    /// A sync that is already running may have started before our write
+    /// and does not necessarily cover it, so wait for one more in that case.
+    const UInt64 target = completed_syncs + (sync_in_progress ? 2 : 1);
+
+    while (completed_syncs < target)
+    {
+        if (sync_in_progress)
+        {
+            sync_completed.wait(lock);
+            continue;
+        }
+
+        /// Become the leader of the next group: a single syncfs makes the writes
+        /// of every thread that is waiting at this point durable.
+        sync_in_progress = true;
+        lock.unlock();
+
+        try
+        {
+            syncFilesystemOf(path);
+        }
+        catch (...)
+        {
+            lock.lock();
+            sync_in_progress = false;
+            sync_completed.notify_all();
+            throw;
+        }
+
+        lock.lock();
+        sync_in_progress = false;
+        ++completed_syncs;
+        sync_completed.notify_all();
+    }
+}
+
+}
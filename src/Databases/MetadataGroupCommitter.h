@@ -0,0 +1,40 @@
+#pragma once
+
+#include <base/types.h>
+#include <boost/noncopyable.hpp>
+#include <condition_variable>
+#include <mutex>
+
+
+namespace DB
+{
+
+/** Group commit for fsyncs of metadata (.sql) files.
+  *
+  * A burst of DDL queries makes every query thread fsync its own small metadata file,
+  * and the fsyncs queue up in the disk subsystem one after another. Instead, a thread that
+  * has already written its file registers here and a single leader makes the writes of the
+  * whole group durable at once with one syncfs of the metadata filesystem - the usual
+  * group commit of a WAL, applied to many small files.
+  *
+  * Used when fsync_metadata_group_commit is enabled, see DatabaseOnDisk.
+  */
+class MetadataGroupCommitter : private boost::noncopyable
+{
+public:
+    static MetadataGroupCommitter & instance();
+
+    /// Make a file that is already written (and flushed from userspace buffers) durable.
+    /// Blocks until a group sync that covers the caller's write completes.
+    void sync(const String & path);
+
+private:
+    MetadataGroupCommitter() = default;
+
+    std::mutex mutex;
+    std::condition_variable sync_completed;
+    bool sync_in_progress = false;
+    UInt64 completed_syncs = 0;
+};
+
+}
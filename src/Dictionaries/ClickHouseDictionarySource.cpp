@@ -116,6 +116,20 @@ QueryPipeline ClickHouseDictionarySource::loadAll()
     return createStreamForQuery(load_all_query);
 }
 
+bool ClickHouseDictionarySource::supportsParallelLoad() const
+{
+    return configuration.query.empty() && dict_struct.id.has_value();
+}
+
+std::vector<QueryPipeline> ClickHouseDictionarySource::loadAllParts(size_t num_parts)
+{
+    std::vector<QueryPipeline> parts;
+    parts.reserve(num_parts);
+    for (size_t part = 0; part < num_parts; ++part)
+        parts.emplace_back(createStreamForQuery(query_builder.composeLoadPartQuery("cityHash64({key})", part, num_parts)));
+    return parts;
+}
+
 QueryPipeline ClickHouseDictionarySource::loadUpdatedAll()
 {
     String load_update_query = getUpdateFieldAndDate();
@@ -48,6 +48,10 @@ public:
 
     QueryPipeline loadAll() override;
 
+    bool supportsParallelLoad() const override;
+
+    std::vector<QueryPipeline> loadAllParts(size_t num_parts) override;
+
     QueryPipeline loadUpdatedAll() override;
 
     QueryPipeline loadIds(const std::vector<UInt64> & ids) override;
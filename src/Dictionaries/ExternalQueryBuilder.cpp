@@ -25,6 +25,7 @@ namespace ErrorCodes
 }
 
 static constexpr std::string_view CONDITION_PLACEHOLDER_TO_REPLACE_VALUE = "{condition}";
+static constexpr std::string_view KEY_PLACEHOLDER_TO_REPLACE_VALUE = "{key}";
 
 ExternalQueryBuilder::ExternalQueryBuilder(
     const DictionaryStructure & dict_struct_,
@@ -101,6 +102,46 @@ std::string ExternalQueryBuilder::composeLoadAllQuery() const
     }
 }
 
+std::string ExternalQueryBuilder::composeLoadPartQuery(const std::string & key_hash_expression, size_t part, size_t num_parts) const
+{
+    if (!query.empty())
+        throw Exception(ErrorCodes::UNSUPPORTED_METHOD, "Partitioned load is not supported with custom `query` parameter");
+
+    if (!dict_struct.id)
+        throw Exception(ErrorCodes::UNSUPPORTED_METHOD, "Partitioned load requires a dictionary with a simple key");
+
+    auto key_position = key_hash_expression.find(KEY_PLACEHOLDER_TO_REPLACE_VALUE);
+    if (key_position == std::string::npos)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Key hash expression `{}` has no `{}` placeholder", key_hash_expression, KEY_PLACEHOLDER_TO_REPLACE_VALUE);
+
+    WriteBufferFromOwnString key_out;
+    if (!dict_struct.id->expression.empty())
+        writeParenthesisedString(dict_struct.id->expression, key_out);
+    else
+        writeQuoted(dict_struct.id->name, key_out);
+
+    auto condition = key_hash_expression;
+    condition.replace(key_position, KEY_PLACEHOLDER_TO_REPLACE_VALUE.size(), key_out.str());
+
+    WriteBufferFromOwnString out;
+    composeLoadAllQuery(out);
+
+    if (!where.empty())
+        writeString(" AND ", out);
+    else
+        writeString(" WHERE ", out);
+
+    writeString(condition, out);
+    writeString(" % ", out);
+    writeIntText(num_parts, out);
+    writeString(" = ", out);
+    writeIntText(part, out);
+    writeChar(';', out);
+
+    return out.str();
+}
+
+
 void ExternalQueryBuilder::composeLoadAllQuery(WriteBuffer & out) const
 {
     writeString("SELECT ", out);
@@ -39,6 +39,14 @@ struct ExternalQueryBuilder
     /** Generate a query to load all data. */
     std::string composeLoadAllQuery() const;
 
+    /** Generate a query to load one of `num_parts` disjoint parts of all data.
+      * The part is selected by `<key_hash_expression> % num_parts = part` pushed down as WHERE.
+      * `key_hash_expression` is a source-dialect expression with a `{key}` placeholder,
+      * which is replaced with the key column.
+      * Requires a simple key and cannot be used together with a custom `query`.
+      */
+    std::string composeLoadPartQuery(const std::string & key_hash_expression, size_t part, size_t num_parts) const;
+
     /** Generate a query to load data after certain time point */
     std::string composeUpdateQuery(const std::string & update_field, const std::string & time_point) const;
 
@@ -10,6 +10,7 @@
 #include <Core/Defines.h>
 
 #include <Columns/ColumnsNumber.h>
+#include <Columns/ColumnDecimal.h>
 #include <Columns/ColumnNullable.h>
 #include <DataTypes/DataTypesDecimal.h>
 #include <Functions/FunctionHelpers.h>
@@ -749,11 +750,33 @@ void HashedDictionary<dictionary_key_type, sparse, sharded>::blockToAttributes(c
         auto & attribute = attributes[attribute_index];
         bool attribute_is_nullable = attribute.is_nullable_set.has_value();
 
+        /// Access the null map and the values directly instead of converting every row
+        /// through a Field: for big dictionaries the per-row Field allocations and
+        /// conversions dominate the (re)load time.
+        const IColumn * attribute_column_data = &attribute_column;
+        const NullMap * null_map = nullptr;
+
+        if (const auto * nullable_column = checkAndGetColumn<ColumnNullable>(attribute_column))
+        {
+            attribute_column_data = &nullable_column->getNestedColumn();
+            null_map = &nullable_column->getNullMapData();
+        }
+
         getAttributeContainer(attribute_index, [&](auto & containers)
         {
             using ContainerType = std::decay_t<decltype(containers.front())>;
             using AttributeValueType = typename ContainerType::mapped_type;
 
+            /// Numeric values are read from the typed column without per-row dispatch.
+            /// If the column type unexpectedly does not match, fall back to Field conversion.
+            [[maybe_unused]] auto typed_column = [&]
+            {
+                if constexpr (std::is_same_v<AttributeValueType, StringRef> || std::is_same_v<AttributeValueType, Field>)
+                    return static_cast<const IColumn *>(nullptr);
+                else
+                    return typeid_cast<const ColumnVectorOrDecimal<AttributeValueType> *>(attribute_column_data);
+            }();
+
             for (size_t key_index = 0; key_index < keys_size; ++key_index)
             {
                 auto key = keys_extractor.extractCurrentKey();
@@ -771,9 +794,7 @@ void HashedDictionary<dictionary_key_type, sparse, sharded>::blockToAttributes(c
                 if constexpr (std::is_same_v<KeyType, StringRef>)
                     key = copyStringInArena(*string_arenas[shard], key);
 
-                attribute_column.get(key_index, column_value_to_insert);
-
-                if (attribute.is_nullable_set && column_value_to_insert.isNull())
+                if (attribute.is_nullable_set && null_map && (*null_map)[key_index])
                 {
                     attribute.is_nullable_set->insert(key);
                     keys_extractor.rollbackCurrentKey();
@@ -782,14 +803,27 @@ void HashedDictionary<dictionary_key_type, sparse, sharded>::blockToAttributes(c
 
                 if constexpr (std::is_same_v<AttributeValueType, StringRef>)
                 {
-                    String & value_to_insert = column_value_to_insert.get<String>();
+                    StringRef value_to_insert = attribute_column_data->getDataAt(key_index);
                     StringRef arena_value = copyStringInArena(*string_arenas[shard], value_to_insert);
                     container.insert({key, arena_value});
                 }
+                else if constexpr (!std::is_same_v<AttributeValueType, Field>)
+                {
+                    if (typed_column)
+                    {
+                        container.insert({key, typed_column->getData()[key_index]});
+                    }
+                    else
+                    {
+                        attribute_column_data->get(key_index, column_value_to_insert);
+                        auto value_to_insert = static_cast<AttributeValueType>(column_value_to_insert.get<AttributeValueType>());
+                        container.insert({key, value_to_insert});
+                    }
+                }
                 else
                 {
-                    auto value_to_insert = static_cast<AttributeValueType>(column_value_to_insert.get<AttributeValueType>());
-                    container.insert({key, value_to_insert});
+                    attribute_column_data->get(key_index, column_value_to_insert);
+                    container.insert({key, column_value_to_insert});
                 }
 
                 ++new_element_count;
@@ -895,19 +929,57 @@ void HashedDictionary<dictionary_key_type, sparse, sharded>::loadData()
         if constexpr (sharded)
             parallel_loader.emplace(*this);
 
-        QueryPipeline pipeline = QueryPipeline(source_ptr->loadAll());
+        if (parallel_loader && source_ptr->supportsParallelLoad())
+        {
+            /// A single source stream is often the bottleneck of a sharded load, so split
+            /// the source into one hash-partitioned query per shard and read them concurrently.
+            auto parts = source_ptr->loadAllParts(configuration.shards);
+            LOG_TRACE(log, "Will read the source using {} parallel streams", parts.size());
 
-        PullingPipelineExecutor executor(pipeline);
-        Block block;
-        DictionaryKeysArenaHolder<dictionary_key_type> arena_holder;
+            ThreadPool read_pool(parts.size());
+            std::mutex mutex;
 
-        while (executor.pull(block))
+            for (auto & part : parts)
+            {
+                read_pool.scheduleOrThrowOnError([&, thread_group = CurrentThread::getGroup()]
+                {
+                    if (thread_group)
+                        CurrentThread::attachToIfDetached(thread_group);
+                    setThreadName("HashedDictSrc");
+
+                    QueryPipeline pipeline(std::move(part));
+                    PullingPipelineExecutor executor(pipeline);
+                    Block block;
+
+                    while (executor.pull(block))
+                    {
+                        /// The loader's shard selector and resize() are not thread-safe,
+                        /// but they are cheap compared to reading the source.
+                        std::lock_guard lock(mutex);
+                        resize(block.rows());
+                        parallel_loader->addBlock(block);
+                    }
+                });
+            }
+
+            read_pool.wait();
+        }
+        else
         {
-            resize(block.rows());
-            if (parallel_loader)
-                parallel_loader->addBlock(block);
-            else
-                blockToAttributes(block, arena_holder, /* shard= */ 0);
+            QueryPipeline pipeline = QueryPipeline(source_ptr->loadAll());
+
+            PullingPipelineExecutor executor(pipeline);
+            Block block;
+            DictionaryKeysArenaHolder<dictionary_key_type> arena_holder;
+
+            while (executor.pull(block))
+            {
+                resize(block.rows());
+                if (parallel_loader)
+                    parallel_loader->addBlock(block);
+                else
+                    blockToAttributes(block, arena_holder, /* shard= */ 0);
+            }
         }
 
         if (parallel_loader)
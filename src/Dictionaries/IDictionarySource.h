@@ -22,6 +22,21 @@ public:
     /// Returns a pipe with all the data available from this source.
     virtual QueryPipeline loadAll() = 0;
 
+    /** Indicates whether this source can load all data split into several disjoint parts,
+      *  so that loadAllParts() returns more than one pipeline.
+      */
+    virtual bool supportsParallelLoad() const { return false; }
+
+    /** Returns pipelines that together produce the same data as loadAll().
+      * The parts are disjoint, so the pipelines may be read concurrently.
+      */
+    virtual std::vector<QueryPipeline> loadAllParts(size_t /*num_parts*/)
+    {
+        std::vector<QueryPipeline> parts;
+        parts.emplace_back(loadAll());
+        return parts;
+    }
+
     /// Returns a pipe with updated data available from this source.
     virtual QueryPipeline loadUpdatedAll() = 0;
 
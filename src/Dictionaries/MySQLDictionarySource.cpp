@@ -204,6 +204,27 @@ QueryPipeline MySQLDictionarySource::loadAll()
     return loadFromQuery(load_all_query);
 }
 
+bool MySQLDictionarySource::supportsParallelLoad() const
+{
+    return configuration.query.empty() && dict_struct.id.has_value();
+}
+
+std::vector<QueryPipeline> MySQLDictionarySource::loadAllParts(size_t num_parts)
+{
+    auto connection = pool->get();
+    last_modification = getLastModification(connection, false);
+
+    std::vector<QueryPipeline> parts;
+    parts.reserve(num_parts);
+    for (size_t part = 0; part < num_parts; ++part)
+    {
+        auto query = query_builder.composeLoadPartQuery("crc32({key})", part, num_parts);
+        LOG_TRACE(log, fmt::runtime(query));
+        parts.emplace_back(loadFromQuery(query));
+    }
+    return parts;
+}
+
 QueryPipeline MySQLDictionarySource::loadUpdatedAll()
 {
     auto connection = pool->get();
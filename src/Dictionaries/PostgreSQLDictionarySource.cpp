@@ -85,6 +85,25 @@ QueryPipeline PostgreSQLDictionarySource::loadAll()
 }
 
 
+bool PostgreSQLDictionarySource::supportsParallelLoad() const
+{
+    return configuration.query.empty() && dict_struct.id.has_value();
+}
+
+std::vector<QueryPipeline> PostgreSQLDictionarySource::loadAllParts(size_t num_parts)
+{
+    std::vector<QueryPipeline> parts;
+    parts.reserve(num_parts);
+    for (size_t part = 0; part < num_parts; ++part)
+    {
+        /// hashint8() returns a signed value, clear the sign bit to make the remainder non-negative.
+        auto query = query_builder.composeLoadPartQuery("(hashint8({key}) & 2147483647)", part, num_parts);
+        LOG_TRACE(log, fmt::runtime(query));
+        parts.emplace_back(loadBase(query));
+    }
+    return parts;
+}
+
 QueryPipeline PostgreSQLDictionarySource::loadUpdatedAll()
 {
     auto load_update_query = getUpdateFieldAndDate();
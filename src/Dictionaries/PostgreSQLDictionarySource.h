@@ -42,6 +42,8 @@ public:
     PostgreSQLDictionarySource & operator=(const PostgreSQLDictionarySource &) = delete;
 
     QueryPipeline loadAll() override;
+    bool supportsParallelLoad() const override;
+    std::vector<QueryPipeline> loadAllParts(size_t num_parts) override;
     QueryPipeline loadUpdatedAll() override;
     QueryPipeline loadIds(const std::vector<UInt64> & ids) override;
     QueryPipeline loadKeys(const Columns & key_columns, const std::vector<size_t> & requested_rows) override;
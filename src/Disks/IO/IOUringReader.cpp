@@ -0,0 +1,328 @@
+#include <Disks/IO/IOUringReader.h>
+
+#if defined(OS_LINUX)
+
+#include <Common/Exception.h>
+#include <Common/ProfileEvents.h>
+#include <Common/Stopwatch.h>
+#include <Common/assert_cast.h>
+#include <Common/setThreadName.h>
+#include <base/defines.h>
+#include <base/errnoToString.h>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+
+namespace ProfileEvents
+{
+    extern const Event IOUringSQEsSubmitted;
+    extern const Event IOUringSQEsResubmits;
+    extern const Event IOUringCQEsCompleted;
+    extern const Event IOUringCQEsFailed;
+}
+
+namespace DB
+{
+
+namespace ErrorCodes
+{
+    extern const int CANNOT_IO_SUBMIT;
+    extern const int CANNOT_READ_FROM_FILE_DESCRIPTOR;
+    extern const int LOGICAL_ERROR;
+    extern const int UNSUPPORTED_METHOD;
+}
+
+namespace
+{
+
+int ioUringSetup(unsigned entries, io_uring_params * params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+}
+
+bool IOUringReader::isSupported()
+{
+    static const bool supported = []
+    {
+        io_uring_params params{};
+        int fd = ioUringSetup(4, &params);
+        if (fd < 0)
+            return false;
+        close(fd);
+        return true;
+    }();
+    return supported;
+}
+
+IOUringReader::IOUringReader(uint32_t entries_)
+{
+    io_uring_params params{};
+
+    int fd = ioUringSetup(entries_, &params);
+    if (fd < 0)
+        throw Exception(ErrorCodes::UNSUPPORTED_METHOD, "Failed to initialize io_uring: {}", errnoToString());
+    ring_fd = fd;
+    sq_entries = params.sq_entries;
+
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    /// Since kernel 5.4 both rings can be mapped with a single mmap.
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap)
+        sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+    sq_ring_mmap = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+    if (sq_ring_mmap == MAP_FAILED)
+    {
+        close(ring_fd);
+        throw Exception(ErrorCodes::UNSUPPORTED_METHOD, "Failed to map io_uring submission queue: {}", errnoToString());
+    }
+
+    if (single_mmap)
+        cq_ring_mmap = sq_ring_mmap;
+    else
+    {
+        cq_ring_mmap = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+        if (cq_ring_mmap == MAP_FAILED)
+        {
+            munmap(sq_ring_mmap, sq_ring_size);
+            close(ring_fd);
+            throw Exception(ErrorCodes::UNSUPPORTED_METHOD, "Failed to map io_uring completion queue: {}", errnoToString());
+        }
+    }
+
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe *>(mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES));
+    if (sqes == MAP_FAILED)
+    {
+        if (cq_ring_mmap != sq_ring_mmap)
+            munmap(cq_ring_mmap, cq_ring_size);
+        munmap(sq_ring_mmap, sq_ring_size);
+        close(ring_fd);
+        throw Exception(ErrorCodes::UNSUPPORTED_METHOD, "Failed to map io_uring submission entries: {}", errnoToString());
+    }
+
+    auto * sq_base = static_cast<char *>(sq_ring_mmap);
+    sq_head = reinterpret_cast<unsigned *>(sq_base + params.sq_off.head);
+    sq_tail = reinterpret_cast<unsigned *>(sq_base + params.sq_off.tail);
+    sq_ring_mask = reinterpret_cast<unsigned *>(sq_base + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned *>(sq_base + params.sq_off.array);
+
+    auto * cq_base = static_cast<char *>(cq_ring_mmap);
+    cq_head = reinterpret_cast<unsigned *>(cq_base + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned *>(cq_base + params.cq_off.tail);
+    cq_ring_mask = reinterpret_cast<unsigned *>(cq_base + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq_base + params.cq_off.cqes);
+
+    monitor_thread = ThreadFromGlobalPool([this] { monitorRing(); });
+}
+
+IOUringReader::~IOUringReader()
+{
+    {
+        std::lock_guard lock(mutex);
+        cancelled = true;
+
+        /// Wake up the monitor thread with a NOP carrying the reserved shutdown id.
+        unsigned tail = __atomic_load_n(sq_tail, __ATOMIC_RELAXED);
+        unsigned index = tail & *sq_ring_mask;
+        io_uring_sqe & sqe = sqes[index];
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_NOP;
+        sqe.user_data = 0;
+        sq_array[index] = index;
+        __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+        ioUringEnter(ring_fd, 1, 0, 0);
+    }
+
+    if (monitor_thread.joinable())
+        monitor_thread.join();
+
+    /// The contract requires to wait for all not completed requests, so fail whatever is still in flight.
+    for (auto & [_, enqueued] : in_flight)
+        enqueued.promise.set_exception(std::make_exception_ptr(Exception(
+            ErrorCodes::CANNOT_READ_FROM_FILE_DESCRIPTOR, "io_uring reader was destroyed before the read completed")));
+
+    munmap(sqes, sqes_size);
+    if (cq_ring_mmap != sq_ring_mmap)
+        munmap(cq_ring_mmap, cq_ring_size);
+    munmap(sq_ring_mmap, sq_ring_size);
+    close(ring_fd);
+}
+
+bool IOUringReader::trySubmitRequest(UInt64 request_id, const EnqueuedRequest & enqueued)
+{
+    unsigned head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+    unsigned tail = __atomic_load_n(sq_tail, __ATOMIC_RELAXED);
+    if (tail - head >= sq_entries)
+        return false;
+
+    int fd = assert_cast<const LocalFileDescriptor &>(*enqueued.request.descriptor).fd;
+
+    unsigned index = tail & *sq_ring_mask;
+    io_uring_sqe & sqe = sqes[index];
+    memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READ;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<UInt64>(enqueued.request.buf + enqueued.bytes_read);
+    sqe.len = static_cast<UInt32>(enqueued.request.size - enqueued.bytes_read);
+    sqe.off = enqueued.request.offset + enqueued.bytes_read;
+    sqe.user_data = request_id;
+
+    sq_array[index] = index;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    int submitted = ioUringEnter(ring_fd, 1, 0, 0);
+    if (submitted < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        throw Exception(ErrorCodes::CANNOT_IO_SUBMIT, "Failed to submit SQE to io_uring: {}", errnoToString());
+
+    ProfileEvents::increment(ProfileEvents::IOUringSQEsSubmitted);
+    return true;
+}
+
+void IOUringReader::submitDeferred()
+{
+    while (!deferred.empty())
+    {
+        UInt64 request_id = deferred.front();
+        auto it = in_flight.find(request_id);
+        if (it == in_flight.end())
+            throw Exception(ErrorCodes::LOGICAL_ERROR, "Deferred io_uring request {} is not in flight", request_id);
+
+        if (!trySubmitRequest(request_id, it->second))
+            break;
+        deferred.pop_front();
+    }
+}
+
+std::future<IOUringReader::Result> IOUringReader::submit(Request request)
+{
+    std::lock_guard lock(mutex);
+
+    if (cancelled)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Cannot submit a read to the io_uring reader which is shutting down");
+
+    UInt64 request_id = next_request_id++;
+    auto [it, inserted] = in_flight.emplace(request_id, EnqueuedRequest{});
+    chassert(inserted);
+
+    auto & enqueued = it->second;
+    enqueued.request = request;
+    auto future = enqueued.promise.get_future();
+
+    if (!trySubmitRequest(request_id, enqueued))
+        deferred.push_back(request_id); /// submission queue is full, retry after the next completion
+
+    return future;
+}
+
+void IOUringReader::failRequest(UInt64 request_id, int error)
+{
+    auto node = in_flight.extract(request_id);
+    if (node.empty())
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Unexpected completion for io_uring request {}", request_id);
+
+    ProfileEvents::increment(ProfileEvents::IOUringCQEsFailed);
+    int fd = assert_cast<const LocalFileDescriptor &>(*node.mapped().request.descriptor).fd;
+    node.mapped().promise.set_exception(std::make_exception_ptr(ErrnoException(
+        fmt::format("Cannot read from file descriptor {}: {}", fd, errnoToString(error)),
+        ErrorCodes::CANNOT_READ_FROM_FILE_DESCRIPTOR, error)));
+}
+
+void IOUringReader::finalizeRequest(UInt64 request_id)
+{
+    auto node = in_flight.extract(request_id);
+    if (node.empty())
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Unexpected completion for io_uring request {}", request_id);
+
+    ProfileEvents::increment(ProfileEvents::IOUringCQEsCompleted);
+    auto & enqueued = node.mapped();
+    enqueued.promise.set_value(Result{ .size = enqueued.bytes_read, .offset = enqueued.request.ignore });
+}
+
+void IOUringReader::monitorRing()
+{
+    setThreadName("IOUringMonitor");
+
+    while (true)
+    {
+        int rc = ioUringEnter(ring_fd, 0, 1, IORING_ENTER_GETEVENTS);
+        if (rc < 0 && errno != EINTR)
+            throw Exception(ErrorCodes::CANNOT_READ_FROM_FILE_DESCRIPTOR, "Failed to wait for io_uring completions: {}", errnoToString());
+
+        std::lock_guard lock(mutex);
+
+        unsigned head = __atomic_load_n(cq_head, __ATOMIC_RELAXED);
+        unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+
+        bool shutdown = false;
+        for (; head != tail; ++head)
+        {
+            const io_uring_cqe & cqe = cqes[head & *cq_ring_mask];
+            UInt64 request_id = cqe.user_data;
+            int res = cqe.res;
+
+            if (request_id == 0)
+            {
+                shutdown = true;
+                continue;
+            }
+
+            if (res < 0)
+            {
+                if (res == -EINTR || res == -EAGAIN)
+                {
+                    /// Transparently retry the request.
+                    ProfileEvents::increment(ProfileEvents::IOUringSQEsResubmits);
+                    auto it = in_flight.find(request_id);
+                    if (it == in_flight.end())
+                        throw Exception(ErrorCodes::LOGICAL_ERROR, "Unexpected completion for io_uring request {}", request_id);
+                    if (!trySubmitRequest(request_id, it->second))
+                        deferred.push_back(request_id);
+                }
+                else
+                    failRequest(request_id, -res);
+                continue;
+            }
+
+            auto it = in_flight.find(request_id);
+            if (it == in_flight.end())
+                throw Exception(ErrorCodes::LOGICAL_ERROR, "Unexpected completion for io_uring request {}", request_id);
+
+            auto & enqueued = it->second;
+            enqueued.bytes_read += res;
+
+            if (res > 0 && enqueued.bytes_read < enqueued.request.size)
+            {
+                /// Short read, resubmit for the remaining range (res == 0 means the file has ended).
+                ProfileEvents::increment(ProfileEvents::IOUringSQEsResubmits);
+                if (!trySubmitRequest(request_id, enqueued))
+                    deferred.push_back(request_id);
+            }
+            else
+                finalizeRequest(request_id);
+        }
+        __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+
+        /// Completions freed up ring slots, submit deferred requests.
+        submitDeferred();
+
+        if (shutdown)
+            return;
+    }
+}
+
+}
+
+#endif
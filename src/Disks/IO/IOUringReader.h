@@ -0,0 +1,88 @@
+#pragma once
+
+#if defined(OS_LINUX)
+
+#include <IO/AsynchronousReader.h>
+#include <Common/ThreadPool.h>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace DB
+{
+
+/** Perform reads through the Linux io_uring subsystem.
+  *
+  * In contrast to ThreadPoolReader, requests from all threads are placed into a shared submission queue and
+  * completed by the kernel without a syscall and a thread hop per request: only a single monitor thread reaps
+  * completions for all in-flight reads. The submission and completion rings are accessed directly through the
+  * raw system calls and mmap-ed queues, we do not depend on liburing.
+  *
+  * Requests which do not fit into the submission queue are deferred and submitted when completions free up
+  * ring slots. Short reads are transparently resubmitted for the remaining range.
+  */
+class IOUringReader final : public IAsynchronousReader
+{
+public:
+    explicit IOUringReader(uint32_t entries_);
+    ~IOUringReader() override;
+
+    /// Does the kernel support io_uring? (checked once at first call)
+    static bool isSupported();
+
+    std::future<Result> submit(Request request) override;
+
+    void wait() override {}
+
+private:
+    struct EnqueuedRequest
+    {
+        std::promise<Result> promise;
+        Request request;
+        size_t bytes_read = 0; /// previous short reads are resubmitted for the remaining range
+    };
+
+    int ring_fd = -1;
+    uint32_t sq_entries = 0;
+
+    /// Pointers into the mmap-ed submission/completion rings.
+    void * sq_ring_mmap = nullptr;
+    size_t sq_ring_size = 0;
+    void * cq_ring_mmap = nullptr;
+    size_t cq_ring_size = 0;
+    io_uring_sqe * sqes = nullptr;
+    size_t sqes_size = 0;
+
+    unsigned * sq_head = nullptr;
+    unsigned * sq_tail = nullptr;
+    unsigned * sq_ring_mask = nullptr;
+    unsigned * sq_array = nullptr;
+
+    unsigned * cq_head = nullptr;
+    unsigned * cq_tail = nullptr;
+    unsigned * cq_ring_mask = nullptr;
+    io_uring_cqe * cqes = nullptr;
+
+    std::mutex mutex;
+    UInt64 next_request_id = 1; /// id 0 is reserved for the shutdown NOP
+    std::unordered_map<UInt64, EnqueuedRequest> in_flight;
+    std::deque<UInt64> deferred; /// requests waiting for a free slot in the submission queue
+
+    bool cancelled = false;
+    ThreadFromGlobalPool monitor_thread;
+
+    /// Returns false if the submission queue is full.
+    bool trySubmitRequest(UInt64 request_id, const EnqueuedRequest & enqueued);
+    void submitDeferred();
+    void monitorRing();
+    void failRequest(UInt64 request_id, int error);
+    void finalizeRequest(UInt64 request_id);
+};
+
+}
+
+#endif
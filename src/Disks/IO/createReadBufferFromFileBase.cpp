@@ -90,6 +90,16 @@ std::unique_ptr<ReadBufferFromFileBase> createReadBufferFromFileBase(
             res = std::make_unique<AsynchronousReadBufferFromFileWithDescriptorsCache>(
                 reader, settings.priority, filename, buffer_size, actual_flags, existing_memory, buffer_alignment, file_size);
         }
+        else if (settings.local_fs_method == LocalFSReadMethod::io_uring)
+        {
+            auto context = Context::getGlobalContextInstance();
+            if (!context)
+                throw Exception(ErrorCodes::LOGICAL_ERROR, "Global context not initialized");
+
+            auto & reader = context->getIOUringReader();
+            res = std::make_unique<AsynchronousReadBufferFromFileWithDescriptorsCache>(
+                reader, settings.priority, filename, buffer_size, actual_flags, existing_memory, buffer_alignment, file_size);
+        }
         else if (settings.local_fs_method == LocalFSReadMethod::pread_threadpool)
         {
             auto context = Context::getGlobalContextInstance();
@@ -50,6 +50,7 @@ FormatSettings getFormatSettings(ContextPtr context, const Settings & settings)
 {
     FormatSettings format_settings;
 
+    format_settings.max_threads = settings.max_threads;
     format_settings.avro.allow_missing_fields = settings.input_format_avro_allow_missing_fields;
     format_settings.avro.output_codec = settings.output_format_avro_codec;
     format_settings.avro.output_sync_interval = settings.output_format_avro_sync_interval;
@@ -114,7 +115,9 @@ FormatSettings getFormatSettings(ContextPtr context, const Settings & settings)
     format_settings.parquet.case_insensitive_column_matching = settings.input_format_parquet_case_insensitive_column_matching;
     format_settings.parquet.allow_missing_columns = settings.input_format_parquet_allow_missing_columns;
     format_settings.parquet.skip_columns_with_unsupported_types_in_schema_inference = settings.input_format_parquet_skip_columns_with_unsupported_types_in_schema_inference;
+    format_settings.parquet.max_decoding_threads = settings.input_format_parquet_max_decoding_threads;
     format_settings.parquet.output_string_as_string = settings.output_format_parquet_string_as_string;
+    format_settings.parquet.low_cardinality_as_dictionary = settings.output_format_parquet_low_cardinality_as_dictionary;
     format_settings.pretty.charset = settings.output_format_pretty_grid_charset.toString() == "ASCII" ? FormatSettings::Pretty::Charset::ASCII : FormatSettings::Pretty::Charset::UTF8;
     format_settings.pretty.color = settings.output_format_pretty_color;
     format_settings.pretty.max_column_pad_width = settings.output_format_pretty_max_column_pad_width;
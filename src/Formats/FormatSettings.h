@@ -38,6 +38,10 @@ struct FormatSettings
     bool seekable_read = true;
     UInt64 max_rows_to_read_for_schema_inference = 100;
 
+    /// Formats that can parallelize some internal work (e.g. conversion of columns)
+    /// use it as an upper limit on the number of threads.
+    size_t max_threads = 1;
+
     String column_names_for_schema_inference;
     String schema_inference_hints;
 
@@ -183,6 +187,8 @@ struct FormatSettings
         bool case_insensitive_column_matching = false;
         std::unordered_set<int> skip_row_groups = {};
         bool output_string_as_string = false;
+        bool low_cardinality_as_dictionary = true;
+        UInt64 max_decoding_threads = 1;
     } parquet;
 
     struct Pretty
@@ -0,0 +1,120 @@
+#include <Formats/MarkInCompressedFile.h>
+
+#include <Common/BitHelpers.h>
+
+namespace DB
+{
+
+namespace
+{
+
+/// Write the `count` low bits of `value` at bit offset `pos` into `dest`.
+/// The array must be zero-initialized and have at least one spare word after the last written bit.
+void writeBits(UInt64 * dest, size_t pos, UInt64 value, size_t count)
+{
+    if (count == 0)
+        return;
+
+    size_t word = pos / 64;
+    size_t shift = pos % 64;
+
+    dest[word] |= value << shift;
+    if (shift && shift + count > 64)
+        dest[word + 1] |= value >> (64 - shift);
+}
+
+/// Read `count` bits at bit offset `pos` from `src`.
+/// The array must have at least one readable word after the last read bit.
+UInt64 readBits(const UInt64 * src, size_t pos, size_t count)
+{
+    if (count == 0)
+        return 0;
+
+    size_t word = pos / 64;
+    size_t shift = pos % 64;
+
+    UInt64 value = src[word] >> shift;
+    if (shift && shift + count > 64)
+        value |= src[word + 1] << (64 - shift);
+
+    if (count < 64)
+        value &= (1ULL << count) - 1;
+
+    return value;
+}
+
+/// Number of bits needed to represent `value`. Zero for zero.
+size_t bitLength(UInt64 value)
+{
+    return value == 0 ? 0 : bitScanReverse(value) + 1;
+}
+
+}
+
+MarksInCompressedFile::MarksInCompressedFile(const PlainArray & marks)
+    : num_marks(marks.size())
+{
+    if (num_marks == 0)
+        return;
+
+    blocks.resize((num_marks + MARKS_PER_BLOCK - 1) / MARKS_PER_BLOCK);
+
+    /// First pass: calculate the layout of all blocks and the total number of bits required.
+    size_t packed_bits = 0;
+    for (size_t block_idx = 0; block_idx < blocks.size(); ++block_idx)
+    {
+        BlockInfo & block = blocks[block_idx];
+        block.bit_offset_in_packed_array = packed_bits;
+
+        size_t max_x = 0;
+        size_t max_y = 0;
+        size_t num_marks_in_block = std::min(MARKS_PER_BLOCK, num_marks - block_idx * MARKS_PER_BLOCK);
+        for (size_t i = 0; i < num_marks_in_block; ++i)
+        {
+            const auto & mark = marks[block_idx * MARKS_PER_BLOCK + i];
+            block.min_x = std::min(block.min_x, mark.offset_in_compressed_file);
+            max_x = std::max(max_x, mark.offset_in_compressed_file);
+            block.min_y = std::min(block.min_y, mark.offset_in_decompressed_block);
+            max_y = std::max(max_y, mark.offset_in_decompressed_block);
+        }
+
+        block.bits_for_x = bitLength(max_x - block.min_x);
+        block.bits_for_y = bitLength(max_y - block.min_y);
+        packed_bits += num_marks_in_block * (block.bits_for_x + block.bits_for_y);
+    }
+
+    /// One spare word at the end allows writeBits()/readBits() to not check array bounds.
+    packed.resize_fill(packed_bits / 64 + 2);
+
+    /// Second pass: write out the bit-packed marks.
+    for (size_t idx = 0; idx < num_marks; ++idx)
+    {
+        const auto & mark = marks[idx];
+        auto [block, offset] = lookUpMark(idx);
+        writeBits(packed.data(), offset, mark.offset_in_compressed_file - block->min_x, block->bits_for_x);
+        writeBits(packed.data(), offset + block->bits_for_x, mark.offset_in_decompressed_block - block->min_y, block->bits_for_y);
+    }
+}
+
+MarkInCompressedFile MarksInCompressedFile::get(size_t idx) const
+{
+    auto [block, offset] = lookUpMark(idx);
+    size_t x = block->min_x + readBits(packed.data(), offset, block->bits_for_x);
+    size_t y = block->min_y + readBits(packed.data(), offset + block->bits_for_x, block->bits_for_y);
+    return MarkInCompressedFile{x, y};
+}
+
+size_t MarksInCompressedFile::approximateSizeInBytes() const
+{
+    return sizeof(*this) + blocks.size() * sizeof(blocks[0]) + packed.size() * sizeof(packed[0]);
+}
+
+std::tuple<const MarksInCompressedFile::BlockInfo *, size_t> MarksInCompressedFile::lookUpMark(size_t idx) const
+{
+    size_t block_idx = idx / MARKS_PER_BLOCK;
+    const BlockInfo & block = blocks[block_idx];
+    size_t offset = block.bit_offset_in_packed_array + (idx - block_idx * MARKS_PER_BLOCK) * (block.bits_for_x + block.bits_for_y);
+    return {&block, offset};
+}
+
+}
@@ -45,15 +45,61 @@ struct MarkInCompressedFile
 
 };
 
-class MarksInCompressedFile : public PODArray<MarkInCompressedFile>
+/** An array of marks in a compact in-memory representation, as stored in the mark cache.
+  *
+  * A plain array of MarkInCompressedFile takes 16 bytes per mark, but the values are extremely
+  * redundant: offset_in_compressed_file grows steadily, offset_in_decompressed_block is usually
+  * zero, and both differences between neighbouring marks fit in much fewer than 64 bits. So we
+  * store the marks delta-encoded relative to a per-block minimum and bit-packed, and decode on
+  * the fly in get(). This typically shrinks the in-memory size by 5-10x, which makes the mark
+  * cache budget go several times further at the same hit rate.
+  */
+class MarksInCompressedFile
 {
 public:
-    explicit MarksInCompressedFile(size_t n) : PODArray(n) {}
+    using PlainArray = PODArray<MarkInCompressedFile>;
+
+    explicit MarksInCompressedFile(const PlainArray & marks);
+
+    MarkInCompressedFile get(size_t idx) const;
 
-    void read(ReadBuffer & buffer, size_t from, size_t count)
+    size_t getNumberOfMarks() const { return num_marks; }
+
+    /// Memory occupied by this array, used for accounting in the mark cache.
+    size_t approximateSizeInBytes() const;
+
+private:
+    /** The marks are split into blocks of MARKS_PER_BLOCK consecutive marks (not to be confused
+      * with compressed data blocks). For each block we remember the minimum of each of the two
+      * components over the block and the number of bits needed for the largest difference from
+      * that minimum; each mark of the block is then stored as two bit-packed differences.
+      * Packed marks of all blocks are concatenated into one contiguous bit array.
+      *
+      * Throughout this class "x" stands for offset_in_compressed_file and "y" stands for
+      * offset_in_decompressed_block.
+      */
+    struct BlockInfo
     {
-        buffer.readStrict(reinterpret_cast<char *>(data() + from), count * sizeof(MarkInCompressedFile));
-    }
+        size_t min_x = std::numeric_limits<size_t>::max();
+        size_t min_y = std::numeric_limits<size_t>::max();
+
+        /// Where the packed marks of this block start in `packed`.
+        size_t bit_offset_in_packed_array = 0;
+
+        /// How many bits each of the two components of a mark takes. May be zero
+        /// (in particular, bits_for_y is zero when y is zero for the whole block).
+        size_t bits_for_x = 0;
+        size_t bits_for_y = 0;
+    };
+
+    static constexpr size_t MARKS_PER_BLOCK = 256;
+
+    size_t num_marks = 0;
+    PODArray<BlockInfo> blocks;
+    PODArray<UInt64> packed;
+
+    /// Mark index -> {block info, bit offset of the mark in `packed`}.
+    std::tuple<const BlockInfo *, size_t> lookUpMark(size_t idx) const;
 };
 
 }
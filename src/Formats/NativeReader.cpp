@@ -64,17 +64,21 @@ void NativeReader::resetParser()
 {
     istr_concrete = nullptr;
     use_index = false;
+    delta_dictionary_states.clear();
 }
 
-void NativeReader::readData(const ISerialization & serialization, ColumnPtr & column, ReadBuffer & istr, size_t rows, double avg_value_size_hint)
+void NativeReader::readData(const ISerialization & serialization, ColumnPtr & column, ReadBuffer & istr, size_t rows, double avg_value_size_hint,
+    ISerialization::DeserializeBinaryBulkStatePtr * stream_state)
 {
     ISerialization::DeserializeBinaryBulkSettings settings;
     settings.getter = [&](ISerialization::SubstreamPath) -> ReadBuffer * { return &istr; };
     settings.avg_value_size_hint = avg_value_size_hint;
     settings.position_independent_encoding = false;
     settings.native_format = true;
+    settings.low_cardinality_delta_dictionary = stream_state != nullptr;
 
-    ISerialization::DeserializeBinaryBulkStatePtr state;
+    ISerialization::DeserializeBinaryBulkStatePtr local_state;
+    ISerialization::DeserializeBinaryBulkStatePtr & state = stream_state ? *stream_state : local_state;
 
     serialization.deserializeBinaryBulkStatePrefix(settings, state);
     serialization.deserializeBinaryBulkWithMultipleStreams(column, rows, settings, state, nullptr);
@@ -148,6 +152,7 @@ Block NativeReader::read()
         setVersionToAggregateFunctions(column.type, true, server_revision);
 
         SerializationPtr serialization;
+        bool use_delta_dictionary = false;
         if (server_revision >= DBMS_MIN_REVISION_WITH_CUSTOM_SERIALIZATION)
         {
             auto info = column.type->createSerializationInfo({});
@@ -158,6 +163,11 @@ Block NativeReader::read()
                 info->deserializeFromKindsBinary(istr);
 
             serialization = column.type->getSerialization(*info);
+
+            /// Symmetric to NativeWriter: LowCardinality dictionaries are accumulated over
+            /// the blocks of the stream, only new keys are received with each block.
+            use_delta_dictionary = server_revision >= DBMS_MIN_PROTOCOL_VERSION_WITH_LOW_CARDINALITY_DELTA_DICTIONARIES
+                && !use_index && !has_custom && typeid_cast<const DataTypeLowCardinality *>(column.type.get());
         }
         else
         {
@@ -178,7 +188,21 @@ Block NativeReader::read()
 
         double avg_value_size_hint = avg_value_size_hints.empty() ? 0 : avg_value_size_hints[i];
         if (rows)    /// If no rows, nothing to read.
-            readData(*serialization, read_column, istr, rows, avg_value_size_hint);
+        {
+            ISerialization::DeserializeBinaryBulkStatePtr * stream_state = nullptr;
+            if (use_delta_dictionary)
+            {
+                auto & entry = delta_dictionary_states[column.name];
+                if (entry.type_name != type_name)
+                {
+                    entry.type_name = type_name;
+                    entry.state = nullptr;
+                }
+                stream_state = &entry.state;
+            }
+
+            readData(*serialization, read_column, istr, rows, avg_value_size_hint, stream_state);
+        }
 
         column.column = std::move(read_column);
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <unordered_map>
+
 #include <Formats/IndexForNativeFormat.h>
 #include <Formats/MarkInCompressedFile.h>
 #include <Common/PODArray.h>
@@ -31,7 +33,10 @@ public:
         IndexForNativeFormat::Blocks::const_iterator index_block_it_,
         IndexForNativeFormat::Blocks::const_iterator index_block_end_);
 
-    static void readData(const ISerialization & serialization, ColumnPtr & column, ReadBuffer & istr, size_t rows, double avg_value_size_hint);
+    /// If `stream_state` is passed, it is kept between the blocks of the stream, and LowCardinality
+    /// dictionaries are accumulated over the blocks (only new keys are received with each block).
+    static void readData(const ISerialization & serialization, ColumnPtr & column, ReadBuffer & istr, size_t rows, double avg_value_size_hint,
+        ISerialization::DeserializeBinaryBulkStatePtr * stream_state = nullptr);
 
     Block getHeader() const;
 
@@ -55,6 +60,15 @@ private:
 
     PODArray<double> avg_value_size_hints;
 
+    /// Per-column states for stateful LowCardinality deserialization (see readData).
+    struct DeltaDictionaryState
+    {
+        String type_name;
+        ISerialization::DeserializeBinaryBulkStatePtr state;
+    };
+
+    std::unordered_map<String, DeltaDictionaryState> delta_dictionary_states;
+
     void updateAvgValueSizeHints(const Block & block);
 };
 
@@ -45,7 +45,9 @@ void NativeWriter::flush()
 }
 
 
-static void writeData(const ISerialization & serialization, const ColumnPtr & column, WriteBuffer & ostr, UInt64 offset, UInt64 limit)
+static void writeData(
+    const ISerialization & serialization, const ColumnPtr & column, WriteBuffer & ostr, UInt64 offset, UInt64 limit,
+    ISerialization::SerializeBinaryBulkStatePtr * stream_state)
 {
     /** If there are columns-constants - then we materialize them.
       * (Since the data type does not know how to serialize / deserialize constants.)
@@ -56,11 +58,18 @@ static void writeData(const ISerialization & serialization, const ColumnPtr & co
     settings.getter = [&ostr](ISerialization::SubstreamPath) -> WriteBuffer * { return &ostr; };
     settings.position_independent_encoding = false;
     settings.low_cardinality_max_dictionary_size = 0; //-V1048
+    settings.low_cardinality_delta_dictionary = stream_state != nullptr;
+
+    /// If the state is kept between the blocks of the stream, only new LowCardinality
+    /// dictionary keys are serialized with each block.
+    ISerialization::SerializeBinaryBulkStatePtr local_state;
+    ISerialization::SerializeBinaryBulkStatePtr & state = stream_state ? *stream_state : local_state;
 
-    ISerialization::SerializeBinaryBulkStatePtr state;
     serialization.serializeBinaryBulkStatePrefix(*full_column, settings, state);
     serialization.serializeBinaryBulkWithMultipleStreams(*full_column, offset, limit, settings, state);
-    serialization.serializeBinaryBulkStateSuffix(settings, state);
+
+    if (!stream_state)
+        serialization.serializeBinaryBulkStateSuffix(settings, state);
 }
 
 
@@ -132,6 +141,7 @@ size_t NativeWriter::write(const Block & block)
 
         /// Serialization. Dynamic, if client supports it.
         SerializationPtr serialization;
+        bool use_delta_dictionary = false;
         if (client_revision >= DBMS_MIN_REVISION_WITH_CUSTOM_SERIALIZATION)
         {
             auto info = column.type->getSerializationInfo(*column.column);
@@ -141,6 +151,12 @@ size_t NativeWriter::write(const Block & block)
             writeBinary(static_cast<UInt8>(has_custom), ostr);
             if (has_custom)
                 info->serialializeKindBinary(ostr);
+
+            /// LowCardinality dictionaries may be shared between the blocks of the stream,
+            /// so that only new keys are sent with each block. Not used with the index,
+            /// because it requires reading the blocks in their original order.
+            use_delta_dictionary = client_revision >= DBMS_MIN_PROTOCOL_VERSION_WITH_LOW_CARDINALITY_DELTA_DICTIONARIES
+                && !index && !has_custom && typeid_cast<const DataTypeLowCardinality *>(column.type.get());
         }
         else
         {
@@ -150,7 +166,21 @@ size_t NativeWriter::write(const Block & block)
 
         /// Data
         if (rows)    /// Zero items of data is always represented as zero number of bytes.
-            writeData(*serialization, column.column, ostr, 0, 0);
+        {
+            ISerialization::SerializeBinaryBulkStatePtr * stream_state = nullptr;
+            if (use_delta_dictionary)
+            {
+                auto & entry = delta_dictionary_states[column.name];
+                if (entry.type_name != type_name)
+                {
+                    entry.type_name = type_name;
+                    entry.state = nullptr;
+                }
+                stream_state = &entry.state;
+            }
+
+            writeData(*serialization, column.column, ostr, 0, 0, stream_state);
+        }
 
         if (index)
         {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <unordered_map>
+
 #include <base/types.h>
 #include <DataTypes/IDataType.h>
 #include <Core/Block.h>
@@ -44,6 +46,16 @@ private:
     CompressedWriteBuffer * ostr_concrete = nullptr;
 
     bool remove_low_cardinality;
+
+    /// Per-column states for stateful LowCardinality serialization: the dictionary is
+    /// accumulated over the blocks of the stream and only new keys are sent with each block.
+    struct DeltaDictionaryState
+    {
+        String type_name;
+        ISerialization::SerializeBinaryBulkStatePtr state;
+    };
+
+    std::unordered_map<String, DeltaDictionaryState> delta_dictionary_states;
 };
 
 }
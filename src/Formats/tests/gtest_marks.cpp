@@ -0,0 +1,48 @@
+#include <random>
+#include <gtest/gtest.h>
+
+#include <Formats/MarkInCompressedFile.h>
+
+using DB::MarkInCompressedFile;
+using DB::MarksInCompressedFile;
+
+TEST(Marks, Compression)
+{
+    std::mt19937_64 rng(42);
+    auto gen = [&](size_t count, size_t max_x_increment, size_t max_y)
+    {
+        size_t x = 0;
+        MarksInCompressedFile::PlainArray plain(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            x += rng() % (max_x_increment + 1);
+            plain[i] = MarkInCompressedFile{x, rng() % (max_y + 1)};
+        }
+        return plain;
+    };
+
+    auto test = [](const MarksInCompressedFile::PlainArray & plain, size_t max_bits_per_mark)
+    {
+        MarksInCompressedFile marks(plain);
+
+        for (size_t i = 0; i < plain.size(); ++i)
+            ASSERT_EQ(marks.get(i), plain[i]);
+
+        EXPECT_LE((marks.approximateSizeInBytes() - sizeof(MarksInCompressedFile)) * 8, plain.size() * max_bits_per_mark);
+    };
+
+    /// Typical.
+    test(gen(10000, 1'000'000, 0), 30);
+
+    /// Completely random 64-bit values.
+    test(gen(10000, UINT64_MAX - 1, UINT64_MAX - 1), 130);
+
+    /// All zeros.
+    test(gen(10000, 0, 0), 2);
+
+    /// Short.
+    test(gen(10, 1000, 1000), 65);
+
+    /// Empty.
+    test(gen(0, 0, 0), 0);
+}
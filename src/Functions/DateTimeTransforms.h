@@ -69,6 +69,11 @@ struct ToDateImpl
     {
         return d;
     }
+    /// When the whole block lies in a range with a constant UTC offset, the LUT lookup degenerates to arithmetic.
+    static inline UInt16 executeWithOffset(UInt32 t, Int64 offset, const DateLUTImpl &)
+    {
+        return static_cast<UInt16>((Int64(t) + offset) / 86400);
+    }
 
     using FactorTransform = ZeroTransform;
 };
@@ -673,6 +678,12 @@ struct ToStartOfHourImpl
         throwDateTimeIsNotSupported(name);
     }
 
+    /// When the whole block lies in a range with a constant UTC offset, rounding to the hour is plain arithmetic.
+    static inline UInt32 executeWithOffset(UInt32 t, Int64 offset, const DateLUTImpl &)
+    {
+        return static_cast<UInt32>(Int64(t) - (Int64(t) + offset) % 3600);
+    }
+
     static inline DecimalUtils::DecimalComponents<DateTime64> executeExtendedResult(const DecimalUtils::DecimalComponents<DateTime64> & t, const DateLUTImpl & time_zone)
     {
         return {time_zone.toStartOfHour(t.whole), 0};
@@ -1291,6 +1302,12 @@ struct ToYYYYMMImpl
     {
         return time_zone.toNumYYYYMM(DayNum(d));
     }
+    /// When the whole block lies in a range with a constant UTC offset, the day number is computed
+    /// by arithmetic and only a direct (branchless) LUT access by day remains.
+    static inline UInt32 executeWithOffset(UInt32 t, Int64 offset, const DateLUTImpl & time_zone)
+    {
+        return time_zone.toNumYYYYMM(DayNum(static_cast<UInt16>((Int64(t) + offset) / 86400)));
+    }
 
     using FactorTransform = ZeroTransform;
 };
@@ -1378,6 +1395,35 @@ struct Transformer
         size_t size = vec_from.size();
         vec_to.resize(size);
 
+        /// Blocks rarely straddle a DST transition. If all values fall into a range with a constant
+        /// UTC offset, replace per-value LUT lookups with arithmetic on that offset - the loop below
+        /// then has no data-dependent branches and is auto-vectorized. Otherwise fall through
+        /// to the generic per-value path.
+        if constexpr (!is_extended_result
+            && std::is_same_v<typename FromTypeVector::value_type, UInt32>
+            && requires { transform.executeWithOffset(UInt32(), Int64(), time_zone); })
+        {
+            if (size)
+            {
+                UInt32 min_time = vec_from[0];
+                UInt32 max_time = vec_from[0];
+                for (size_t i = 1; i < size; ++i)
+                {
+                    min_time = std::min<UInt32>(min_time, vec_from[i]);
+                    max_time = std::max<UInt32>(max_time, vec_from[i]);
+                }
+
+                Int64 offset = 0;
+                /// Stay away from the epoch boundary, where rounding in local time could go below zero.
+                if (time_zone.hasConstantOffsetInRange(min_time, max_time, offset) && min_time + offset >= 86400)
+                {
+                    for (size_t i = 0; i < size; ++i)
+                        vec_to[i] = static_cast<ValueType>(transform.executeWithOffset(vec_from[i], offset, time_zone));
+                    return;
+                }
+            }
+        }
+
         for (size_t i = 0; i < size; ++i)
         {
             if constexpr (is_extended_result)
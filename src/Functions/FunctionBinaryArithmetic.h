@@ -471,6 +471,33 @@ public:
             return;
         }
 
+        /// With matching scales (the common case, e.g. money columns of the same type) the only
+        /// per-element branch left is the overflow check. Throwing from the loop body prevents
+        /// vectorization, so accumulate the overflow flag over the whole array and throw once
+        /// after the loop.
+        if constexpr (can_overflow && check_overflow)
+        {
+            if (!right_nullmap)
+            {
+                bool overflow = false;
+
+                for (size_t i = 0; i < size; ++i)
+                {
+                    NativeResultType res;
+                    overflow |= Op::template apply<NativeResultType>(
+                        static_cast<NativeResultType>(unwrap<op_case, OpCase::LeftConstant>(a, i)),
+                        static_cast<NativeResultType>(unwrap<op_case, OpCase::RightConstant>(b, i)),
+                        res);
+                    c[i] = res;
+                }
+
+                if (overflow)
+                    throw Exception(ErrorCodes::DECIMAL_OVERFLOW, "Decimal math overflow");
+
+                return;
+            }
+        }
+
         processWithRightNullmapImpl<op_case>(
             a, b, c, size, right_nullmap,
             [](const auto & left, const auto & right)
@@ -22,6 +22,8 @@
 #include <IO/ReadHelpers.h>
 #include <base/range.h>
 
+#include <boost/tti/has_member_function.hpp>
+
 #include "config.h"
 
 namespace DB
@@ -109,18 +111,38 @@ public:
             const ColumnString::Offsets & offsets_json = col_json_string->getOffsets();
 
             JSONParser json_parser;
+
+            /// Preallocate buffers for the longest document once, so the parser does not
+            /// reallocate its state while going through the block.
+            if constexpr (has_member_function_reserve<void (JSONParser::*)(size_t)>::value)
+            {
+                size_t max_size = calculateMaxSize(offsets_json);
+                if (max_size)
+                    json_parser.reserve(max_size);
+            }
+
             using Element = typename JSONParser::Element;
             Element document;
             bool document_ok = false;
 
+            /// A constant JSON document only needs to be parsed once.
+            if (col_json_const)
+            {
+                std::string_view json{reinterpret_cast<const char *>(chars_json.data()), offsets_json[0] - 1};
+                document_ok = json_parser.parse(json, document);
+            }
+
             /// Parse JSON for every row
             Impl<JSONParser> impl;
 
             for (const auto i : collections::range(0, input_rows_count))
             {
-                std::string_view json{
-                    reinterpret_cast<const char *>(&chars_json[offsets_json[i - 1]]), offsets_json[i] - offsets_json[i - 1] - 1};
-                document_ok = json_parser.parse(json, document);
+                if (!col_json_const)
+                {
+                    std::string_view json{
+                        reinterpret_cast<const char *>(&chars_json[offsets_json[i - 1]]), offsets_json[i] - offsets_json[i - 1] - 1};
+                    document_ok = json_parser.parse(json, document);
+                }
 
                 bool added_to_column = false;
                 if (document_ok)
@@ -135,6 +157,23 @@ public:
             return to;
         }
     };
+
+private:
+    BOOST_TTI_HAS_MEMBER_FUNCTION(reserve)
+
+    static size_t calculateMaxSize(const ColumnString::Offsets & offsets)
+    {
+        size_t max_size = 0;
+        for (const auto i : collections::range(0, offsets.size()))
+        {
+            size_t size = offsets[i] - offsets[i - 1];
+            if (max_size < size)
+                max_size = size;
+        }
+        if (max_size)
+            --max_size;
+        return max_size;
+    }
 };
 
 template <typename Name, template <typename> typename Impl>
@@ -77,6 +77,25 @@ public:
 
     void deserialize(const UInt8 * src16, UInt8 * dst36) const
     {
+        if (first_half_binary_representation == Representation::BigEndian)
+        {
+            /// Every segment of the default variant is straight big-endian hex, so the whole
+            /// UUID can be converted with one vector kernel and then cut apart by the dashes.
+            UInt8 hex_chars[32];
+            writeHexLowercase16(src16, hex_chars);
+
+            memcpy(&dst36[0], &hex_chars[0], 8);
+            dst36[8] = '-';
+            memcpy(&dst36[9], &hex_chars[8], 4);
+            dst36[13] = '-';
+            memcpy(&dst36[14], &hex_chars[12], 4);
+            dst36[18] = '-';
+            memcpy(&dst36[19], &hex_chars[16], 4);
+            dst36[23] = '-';
+            memcpy(&dst36[24], &hex_chars[20], 12);
+            return;
+        }
+
         formatHex({src16, 4}, &dst36[0], first_half_binary_representation);
         dst36[8] = '-';
         formatHex({src16 + 4, 2}, &dst36[9], first_half_binary_representation);
@@ -322,7 +322,8 @@ ColumnPtr IExecutableFunction::execute(const ColumnsWithTypeAndName & arguments,
     {
         size_t num_sparse_columns = 0;
         size_t num_full_columns = 0;
-        size_t sparse_column_position = 0;
+        bool sparse_offsets_are_same = true;
+        ColumnPtr sparse_offsets;
 
         for (size_t i = 0; i < arguments.size(); ++i)
         {
@@ -331,7 +332,15 @@ ColumnPtr IExecutableFunction::execute(const ColumnsWithTypeAndName & arguments,
             /// it's more convenient to convert it to full before execution of function.
             if (column_sparse && column_sparse->getNumberOfDefaults())
             {
-                sparse_column_position = i;
+                /// Several sparse arguments can be executed over values only if rows with
+                /// non-default values are the same in all of them. It's enough to compare
+                /// pointers to offsets, because it covers the common case when the same
+                /// column is used in several arguments (e.g. x * x).
+                if (!sparse_offsets)
+                    sparse_offsets = column_sparse->getOffsetsPtr();
+                else if (sparse_offsets.get() != column_sparse->getOffsetsPtr().get())
+                    sparse_offsets_are_same = false;
+
                 ++num_sparse_columns;
             }
             else if (!isColumnConst(*arguments[i].column))
@@ -341,24 +350,24 @@ ColumnPtr IExecutableFunction::execute(const ColumnsWithTypeAndName & arguments,
         }
 
         auto columns_without_sparse = arguments;
-        if (num_sparse_columns == 1 && num_full_columns == 0)
+        if (num_sparse_columns >= 1 && num_full_columns == 0 && sparse_offsets_are_same)
         {
-            auto & arg_with_sparse = columns_without_sparse[sparse_column_position];
-            ColumnPtr sparse_offsets;
+            /// All sparse arguments have the same offsets, so the sizes of their values are equal too.
+            size_t values_size = 0;
+            for (auto & arg : columns_without_sparse)
             {
-                /// New scope to avoid possible mistakes on dangling reference.
-                const auto & column_sparse = assert_cast<const ColumnSparse &>(*arg_with_sparse.column);
-                sparse_offsets = column_sparse.getOffsetsPtr();
-                arg_with_sparse.column = column_sparse.getValuesPtr();
+                if (const auto * column_sparse = checkAndGetColumn<ColumnSparse>(arg.column.get()))
+                {
+                    arg.column = column_sparse->getValuesPtr();
+                    values_size = arg.column->size();
+                }
             }
 
-            size_t values_size = arg_with_sparse.column->size();
-            for (size_t i = 0; i < columns_without_sparse.size(); ++i)
+            /// The rest of arguments are constants, resize them to the size of values.
+            for (auto & arg : columns_without_sparse)
             {
-                if (i == sparse_column_position)
-                    continue;
-
-                columns_without_sparse[i].column = columns_without_sparse[i].column->cloneResized(values_size);
+                if (isColumnConst(*arg.column))
+                    arg.column = arg.column->cloneResized(values_size);
             }
 
             auto res = executeWithoutSparseColumns(columns_without_sparse, result_type, values_size, dry_run);
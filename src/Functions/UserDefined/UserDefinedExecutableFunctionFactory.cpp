@@ -95,6 +95,21 @@ public:
                     command_parameter.name);
             }
         }
+
+        /// An executable pool command receives a fixed number of rows for each function call, and its result
+        /// is read back with read_fixed_number_of_rows, so parallel parsing cannot be used for it anyway.
+        /// Disable it here once instead of copying the context inside ShellCommandSource for every block.
+        const auto & coordinator_configuration = executable_function->getCoordinator()->getConfiguration();
+        if (coordinator_configuration.is_executable_pool && context->getSettingsRef().input_format_parallel_parsing)
+        {
+            auto command_context_with_settings = Context::createCopy(context);
+            command_context_with_settings->setSetting("input_format_parallel_parsing", false);
+            command_context = std::move(command_context_with_settings);
+        }
+        else
+        {
+            command_context = context;
+        }
     }
 
     String getName() const override { return executable_function->getConfiguration().name; }
@@ -198,22 +213,37 @@ public:
             command_arguments_with_parameters,
             std::move(shell_input_pipes),
             result_block,
-            context,
+            command_context,
             shell_command_source_configuration);
 
         QueryPipeline pipeline(std::move(pipe));
         PullingPipelineExecutor executor(pipeline);
 
-        auto result_column = result_type->createColumn();
-        result_column->reserve(input_rows_count);
+        ColumnPtr result_column;
 
         Block block;
         while (executor.pull(block))
         {
-            const auto & result_column_to_add = *block.safeGetByPosition(0).column;
-            result_column->insertRangeFrom(result_column_to_add, 0, result_column_to_add.size());
+            if (block.rows() == 0)
+                continue;
+
+            ColumnPtr block_column = block.safeGetByPosition(0).column;
+
+            /// The result of the whole call is usually pulled as a single block, take its column without copying.
+            if (!result_column)
+            {
+                result_column = std::move(block_column);
+                continue;
+            }
+
+            MutableColumnPtr mutable_result_column = IColumn::mutate(std::move(result_column));
+            mutable_result_column->insertRangeFrom(*block_column, 0, block_column->size());
+            result_column = std::move(mutable_result_column);
         }
 
+        if (!result_column)
+            result_column = result_type->createColumn();
+
         size_t result_column_size = result_column->size();
         if (result_column_size != input_rows_count)
             throw Exception(ErrorCodes::UNSUPPORTED_METHOD,
@@ -228,6 +258,8 @@ public:
 private:
     ExternalUserDefinedExecutableFunctionsLoader::UserDefinedExecutableFunctionPtr executable_function;
     ContextPtr context;
+    /// Context which is passed to the command pipeline, with the settings that do not apply to it disabled.
+    ContextPtr command_context;
     String command_with_parameters;
     std::vector<std::string> command_arguments_with_parameters;
 };
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <IO/WriteBuffer.h>
+#include <IO/BufferWithOwnMemory.h>
+#include <Common/ThreadPool.h>
+#include <Common/Exception.h>
+
+
+namespace DB
+{
+
+/** Writes data to another buffer, performing the underlying (e.g. disk) writes
+  * in a separate thread using double buffering. While the background thread flushes
+  * one buffer, the caller keeps filling the other, so e.g. reading a file from the
+  * network overlaps with writing it to disk instead of alternating with it.
+  *
+  * The underlying buffer must not be used and must outlive this one. It is flushed
+  * but not finalized here, since it is owned by the caller.
+  */
+class AsynchronousWriteBuffer : public WriteBuffer
+{
+public:
+    explicit AsynchronousWriteBuffer(WriteBuffer & out_)
+        : WriteBuffer(nullptr, 0)
+        , out(out_)
+        , memory(out.buffer().size())
+    {
+        /// Data is written to the duplicate buffer, the buffers are swapped on flush.
+        set(memory.data(), memory.size());
+    }
+
+    ~AsynchronousWriteBuffer() override
+    {
+        try
+        {
+            finalize();
+        }
+        catch (...)
+        {
+            tryLogCurrentException(__PRETTY_FUNCTION__);
+        }
+    }
+
+private:
+    void nextImpl() override
+    {
+        if (!offset())
+            return;
+
+        /// Wait for the previous write to complete; rethrows if it failed.
+        if (started)
+            pool.wait();
+        else
+            started = true;
+
+        swapBuffers();
+
+        pool.scheduleOrThrowOnError([this] { out.next(); });
+    }
+
+    void finalizeImpl() override
+    {
+        if (started)
+            pool.wait();
+
+        swapBuffers();
+        out.next();
+
+        /// Return the original buffer to `out`, so that it does not reference
+        /// our memory after we are destroyed.
+        if (buffers_swapped)
+            swapBuffers();
+    }
+
+    void swapBuffers()
+    {
+        swap(out);
+        buffers_swapped = !buffers_swapped;
+    }
+
+    WriteBuffer & out;
+    Memory<> memory;
+
+    /// For asynchronous data writing.
+    ThreadPool pool{1};
+    bool started = false;
+    bool buffers_swapped = false;
+};
+
+}
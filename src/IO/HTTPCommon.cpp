@@ -222,6 +222,11 @@ namespace
             if (pool_ptr == endpoints_pool.end())
                 std::tie(pool_ptr, std::ignore) = endpoints_pool.emplace(
                     key, std::make_shared<SingleEndpointHTTPSessionPool>(host, port, https, proxy_host, proxy_port, proxy_https, max_connections_per_endpoint, resolve_host));
+            else
+                /// The pool is sized when the endpoint is seen for the first time. A client that needs more
+                /// concurrent connections (e.g. many parallel sources reading the same URL) may raise the limit,
+                /// otherwise it would block on a pool created earlier with a smaller size.
+                pool_ptr->second->setMaxItems(static_cast<unsigned>(max_connections_per_endpoint));
 
             auto retry_timeout = timeouts.connection_timeout.totalMicroseconds();
             auto session = pool_ptr->second->get(retry_timeout);
@@ -21,6 +21,11 @@ void IOThreadPool::initialize(size_t max_threads, size_t max_free_threads, size_
     instance = std::make_unique<ThreadPool>(max_threads, max_free_threads, queue_size, false /*shutdown_on_exception*/);
 }
 
+bool IOThreadPool::isInitialized()
+{
+    return instance != nullptr;
+}
+
 ThreadPool & IOThreadPool::get()
 {
     if (!instance)
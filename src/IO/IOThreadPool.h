@@ -15,6 +15,8 @@ class IOThreadPool
 public:
     static void initialize(size_t max_threads, size_t max_free_threads, size_t queue_size);
     static ThreadPool & get();
+    /// The pool is initialized in the server only; standalone tools don't have it.
+    static bool isInitialized();
 };
 
 }
@@ -40,6 +40,13 @@ enum class LocalFSReadMethod
      */
     pread_threadpool,
 
+    /**
+     * Submit reads to the Linux io_uring subsystem: requests from all threads are batched into a shared
+     * submission queue and completed by the kernel without a syscall and a thread hop per request.
+     * Falls back with an error on kernels without io_uring support. Only available on Linux.
+     */
+    io_uring,
+
     /// Use asynchronous reader with fake backend that in fact synchronous.
     /// @attention Use only for testing purposes.
     pread_fake_async
@@ -78,6 +85,8 @@ struct ReadSettings
 
     bool load_marks_asynchronously = true;
 
+    bool load_marks_with_mmap = false;
+
     size_t remote_fs_read_max_backoff_ms = 10000;
     size_t remote_fs_read_backoff_max_tries = 4;
 
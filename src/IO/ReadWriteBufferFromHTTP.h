@@ -761,6 +761,63 @@ public:
     }
 };
 
+class UpdatablePooledSession : public UpdatableSessionBase<PooledHTTPSessionPtr>
+{
+    using Parent = UpdatableSessionBase<PooledHTTPSessionPtr>;
+
+private:
+    size_t per_endpoint_pool_size;
+
+public:
+    explicit UpdatablePooledSession(
+        const Poco::URI uri, const ConnectionTimeouts & timeouts_, const UInt64 max_redirects_, size_t per_endpoint_pool_size_)
+        : Parent(uri, timeouts_, max_redirects_), per_endpoint_pool_size{per_endpoint_pool_size_}
+    {
+        session = makePooledHTTPSession(initial_uri, timeouts, per_endpoint_pool_size);
+    }
+
+    void buildNewSession(const Poco::URI & uri) override { session = makePooledHTTPSession(uri, timeouts, per_endpoint_pool_size); }
+};
+
+class PooledReadWriteBufferFromHTTP : public detail::ReadWriteBufferFromHTTPBase<std::shared_ptr<UpdatablePooledSession>>
+{
+    using Parent = detail::ReadWriteBufferFromHTTPBase<std::shared_ptr<UpdatablePooledSession>>;
+
+public:
+    explicit PooledReadWriteBufferFromHTTP(
+        Poco::URI uri_,
+        const std::string & method_ = {},
+        OutStreamCallback out_stream_callback_ = {},
+        const ConnectionTimeouts & timeouts_ = {},
+        const Poco::Net::HTTPBasicCredentials & credentials_ = {},
+        const UInt64 max_redirects = 0,
+        size_t buffer_size_ = DBMS_DEFAULT_BUFFER_SIZE,
+        const ReadSettings & settings_ = {},
+        const HTTPHeaderEntries & http_header_entries_ = {},
+        Range read_range_ = {},
+        const RemoteHostFilter * remote_host_filter_ = nullptr,
+        bool delay_initialization_ = true,
+        bool use_external_buffer_ = false,
+        bool skip_not_found_url_ = false,
+        size_t max_connections_per_endpoint = DEFAULT_COUNT_OF_HTTP_CONNECTIONS_PER_ENDPOINT)
+        : Parent(
+            std::make_shared<UpdatablePooledSession>(uri_, timeouts_, max_redirects, max_connections_per_endpoint),
+            uri_,
+            credentials_,
+            method_,
+            out_stream_callback_,
+            buffer_size_,
+            settings_,
+            http_header_entries_,
+            read_range_,
+            remote_host_filter_,
+            delay_initialization_,
+            use_external_buffer_,
+            skip_not_found_url_)
+    {
+    }
+};
+
 class RangedReadWriteBufferFromHTTPFactory : public ParallelReadBuffer::ReadBufferFactory, public WithFileName
 {
     using OutStreamCallback = ReadWriteBufferFromHTTP::OutStreamCallback;
@@ -781,7 +838,8 @@ public:
         const RemoteHostFilter * remote_host_filter_ = nullptr,
         bool delay_initialization_ = true,
         bool use_external_buffer_ = false,
-        bool skip_not_found_url_ = false)
+        bool skip_not_found_url_ = false,
+        size_t max_connections_per_endpoint_ = DEFAULT_COUNT_OF_HTTP_CONNECTIONS_PER_ENDPOINT)
         : range_generator(total_object_size_, range_step_)
         , total_object_size(total_object_size_)
         , range_step(range_step_)
@@ -798,6 +856,7 @@ public:
         , delay_initialization(delay_initialization_)
         , use_external_buffer(use_external_buffer_)
         , skip_not_found_url(skip_not_found_url_)
+        , max_connections_per_endpoint(max_connections_per_endpoint_)
     {
     }
 
@@ -809,7 +868,9 @@ public:
             return nullptr;
         }
 
-        return std::make_shared<ReadWriteBufferFromHTTP>(
+        /// A pooled session, so that the worker reuses one keep-alive connection
+        /// for all the ranges it downloads instead of reconnecting for each of them.
+        return std::make_shared<PooledReadWriteBufferFromHTTP>(
             uri,
             method,
             out_stream_callback,
@@ -824,7 +885,8 @@ public:
             remote_host_filter,
             delay_initialization,
             use_external_buffer,
-            skip_not_found_url);
+            skip_not_found_url,
+            max_connections_per_endpoint);
     }
 
     off_t seek(off_t off, [[maybe_unused]] int whence) override
@@ -854,49 +916,7 @@ private:
     bool delay_initialization;
     bool use_external_buffer;
     bool skip_not_found_url;
-};
-
-class UpdatablePooledSession : public UpdatableSessionBase<PooledHTTPSessionPtr>
-{
-    using Parent = UpdatableSessionBase<PooledHTTPSessionPtr>;
-
-private:
-    size_t per_endpoint_pool_size;
-
-public:
-    explicit UpdatablePooledSession(
-        const Poco::URI uri, const ConnectionTimeouts & timeouts_, const UInt64 max_redirects_, size_t per_endpoint_pool_size_)
-        : Parent(uri, timeouts_, max_redirects_), per_endpoint_pool_size{per_endpoint_pool_size_}
-    {
-        session = makePooledHTTPSession(initial_uri, timeouts, per_endpoint_pool_size);
-    }
-
-    void buildNewSession(const Poco::URI & uri) override { session = makePooledHTTPSession(uri, timeouts, per_endpoint_pool_size); }
-};
-
-class PooledReadWriteBufferFromHTTP : public detail::ReadWriteBufferFromHTTPBase<std::shared_ptr<UpdatablePooledSession>>
-{
-    using Parent = detail::ReadWriteBufferFromHTTPBase<std::shared_ptr<UpdatablePooledSession>>;
-
-public:
-    explicit PooledReadWriteBufferFromHTTP(
-        Poco::URI uri_,
-        const std::string & method_ = {},
-        OutStreamCallback out_stream_callback_ = {},
-        const ConnectionTimeouts & timeouts_ = {},
-        const Poco::Net::HTTPBasicCredentials & credentials_ = {},
-        size_t buffer_size_ = DBMS_DEFAULT_BUFFER_SIZE,
-        const UInt64 max_redirects = 0,
-        size_t max_connections_per_endpoint = DEFAULT_COUNT_OF_HTTP_CONNECTIONS_PER_ENDPOINT)
-        : Parent(
-            std::make_shared<UpdatablePooledSession>(uri_, timeouts_, max_redirects, max_connections_per_endpoint),
-            uri_,
-            credentials_,
-            method_,
-            out_stream_callback_,
-            buffer_size_)
-    {
-    }
+    size_t max_connections_per_endpoint;
 };
 
 }
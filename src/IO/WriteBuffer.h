@@ -93,6 +93,14 @@ public:
     }
 
 
+    /// By analogy with ReadBuffer::readBig: write a large piece of data that is already contiguous
+    /// in memory. Buffers that are able to (e.g. plain sockets) may send it directly from `from`,
+    /// avoiding the copy into the internal buffer.
+    virtual void writeBig(const char * from, size_t n)
+    {
+        write(from, n);
+    }
+
     inline void write(char x)
     {
         if (finalized)
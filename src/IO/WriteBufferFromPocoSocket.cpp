@@ -40,6 +40,31 @@ void WriteBufferFromPocoSocket::nextImpl()
     if (!offset())
         return;
 
+    socketSendBytes(working_buffer.begin(), offset());
+}
+
+void WriteBufferFromPocoSocket::writeBig(const char * from, size_t n)
+{
+    /// Sending small pieces directly would only increase the number of system calls.
+    if (n < MIN_BYTES_FOR_DIRECT_WRITE)
+    {
+        write(from, n);
+        return;
+    }
+
+    if (finalized)
+        throw Exception{ErrorCodes::LOGICAL_ERROR, "Cannot write to finalized buffer"};
+
+    /// Flush the data accumulated in the internal buffer to preserve the order of writes,
+    /// then send the payload directly from the caller's memory without copying it.
+    next();
+
+    socketSendBytes(from, n);
+    bytes += n;
+}
+
+void WriteBufferFromPocoSocket::socketSendBytes(const char * data, size_t size_to_send)
+{
     Stopwatch watch;
     size_t bytes_written = 0;
 
@@ -48,7 +73,7 @@ void WriteBufferFromPocoSocket::nextImpl()
         ProfileEvents::increment(ProfileEvents::NetworkSendBytes, bytes_written);
     });
 
-    while (bytes_written < offset())
+    while (bytes_written < size_to_send)
     {
         ssize_t res = 0;
 
@@ -56,11 +81,11 @@ void WriteBufferFromPocoSocket::nextImpl()
         try
         {
             CurrentMetrics::Increment metric_increment(CurrentMetrics::NetworkSend);
-            char * pos = working_buffer.begin() + bytes_written;
-            size_t size = offset() - bytes_written;
+            const char * send_pos = data + bytes_written;
+            size_t size = size_to_send - bytes_written;
             if (size > INT_MAX)
                 throw Exception(ErrorCodes::LOGICAL_ERROR, "Buffer overflow");
-            res = socket.impl()->sendBytes(pos, static_cast<int>(size));
+            res = socket.impl()->sendBytes(send_pos, static_cast<int>(size));
         }
         catch (const Poco::Net::NetException & e)
         {
@@ -18,6 +18,10 @@ public:
 
     ~WriteBufferFromPocoSocket() override;
 
+    /// Large payloads are sent directly from the caller's memory (after flushing the internal
+    /// buffer), so column data is not copied into the socket buffer first.
+    void writeBig(const char * from, size_t n) override;
+
 protected:
     void nextImpl() override;
 
@@ -28,6 +32,11 @@ protected:
       *  (getpeername will return an error).
       */
     Poco::Net::SocketAddress peer_address;
+
+private:
+    static constexpr size_t MIN_BYTES_FOR_DIRECT_WRITE = 64 * 1024;
+
+    void socketSendBytes(const char * data, size_t size_to_send);
 };
 
 }
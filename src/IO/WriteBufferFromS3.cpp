@@ -243,6 +243,10 @@ void WriteBufferFromS3::writePart()
 
     if (schedule)
     {
+        /// The data is acknowledged as soon as it is accepted for a background upload, so the number
+        /// of parts kept in memory waiting for the upload to complete has to be bounded.
+        waitForInFlightTasksSlot();
+
         UploadPartTask * task = nullptr;
 
         {
@@ -538,6 +542,20 @@ void WriteBufferFromS3::waitForReadyBackGroundTasks()
     }
 }
 
+void WriteBufferFromS3::waitForInFlightTasksSlot()
+{
+    if (schedule && settings.max_inflight_parts_for_one_file)
+    {
+        std::unique_lock lock(bg_tasks_mutex);
+
+        bg_tasks_condvar.wait(lock, [this]()
+        {
+            return static_cast<size_t>(TSA_SUPPRESS_WARNING_FOR_READ(num_added_bg_tasks) - TSA_SUPPRESS_WARNING_FOR_READ(num_finished_bg_tasks))
+                < settings.max_inflight_parts_for_one_file;
+        });
+    }
+}
+
 void WriteBufferFromS3::waitForAllBackGroundTasks()
 {
     if (schedule)
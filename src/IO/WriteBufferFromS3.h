@@ -83,6 +83,7 @@ private:
     void processPutRequest(const PutObjectTask & task);
 
     void waitForReadyBackGroundTasks();
+    void waitForInFlightTasksSlot();
     void waitForAllBackGroundTasks();
     void waitForAllBackGroundTasksUnlocked(std::unique_lock<std::mutex> & bg_tasks_lock);
 
@@ -8,32 +8,30 @@
 namespace DB
 {
 
-template <typename IteratorSrc, typename IteratorDst>
-void formatHex(IteratorSrc src, IteratorDst dst, size_t num_bytes)
-{
-    size_t src_pos = 0;
-    size_t dst_pos = 0;
-    for (; src_pos < num_bytes; ++src_pos)
-    {
-        writeHexByteLowercase(src[src_pos], &dst[dst_pos]);
-        dst_pos += 2;
-    }
-}
-
 /** Function used when byte ordering is important when parsing uuid
  *  ex: When we create an UUID type
  */
 void formatUUID(std::reverse_iterator<const UInt8 *> src16, UInt8 * dst36)
 {
-    formatHex(src16 + 8, &dst36[0], 4);
+    /// The UUID is stored as two little-endian UInt64 while the text is big-endian,
+    /// so the bytes are reversed into a scratch buffer and converted to hex with one
+    /// vector kernel, then the result is cut apart by the dashes.
+    UInt8 reversed[16];
+    for (size_t i = 0; i < 16; ++i)
+        reversed[i] = src16[i];
+
+    UInt8 hex_chars[32];
+    writeHexLowercase16(reversed, hex_chars);
+
+    memcpy(&dst36[0], &hex_chars[16], 8);
     dst36[8] = '-';
-    formatHex(src16 + 12, &dst36[9], 2);
+    memcpy(&dst36[9], &hex_chars[24], 4);
     dst36[13] = '-';
-    formatHex(src16 + 14, &dst36[14], 2);
+    memcpy(&dst36[14], &hex_chars[28], 4);
     dst36[18] = '-';
-    formatHex(src16, &dst36[19], 2);
+    memcpy(&dst36[19], &hex_chars[0], 4);
     dst36[23] = '-';
-    formatHex(src16 + 2, &dst36[24], 6);
+    memcpy(&dst36[24], &hex_chars[4], 12);
 }
 
 void writeIPv4Text(const IPv4 & ip, WriteBuffer & buf)
@@ -1,5 +1,8 @@
 #include <Interpreters/ActionsDAG.h>
 
+#include <Columns/ColumnConst.h>
+#include <Common/FieldVisitorToString.h>
+#include <Common/assert_cast.h>
 #include <DataTypes/DataTypeArray.h>
 #include <DataTypes/DataTypeString.h>
 #include <Functions/IFunction.h>
@@ -954,6 +957,98 @@ void ActionsDAG::compileExpressions(size_t min_count_to_compile_expression, cons
 }
 #endif
 
+void ActionsDAG::eliminateCommonSubexpressions()
+{
+    /// Mapping from a duplicate node to the node that is kept instead of it.
+    std::unordered_map<const Node *, const Node *> replacements;
+    /// Structural key (without result name) -> first node with this key.
+    std::unordered_map<String, Node *> unique_nodes;
+
+    for (auto & node : nodes)
+    {
+        /// Nodes are stored in topological order, so children are already canonicalized.
+        for (auto & child : node.children)
+            if (auto it = replacements.find(child); it != replacements.end())
+                child = it->second;
+
+        String key;
+        switch (node.type)
+        {
+            case ActionType::ALIAS:
+            {
+                WriteBufferFromOwnString buf;
+                buf << "alias:" << reinterpret_cast<std::uintptr_t>(node.children.front());
+                key = buf.str();
+                break;
+            }
+            case ActionType::COLUMN:
+            {
+                /// Only constants with comparable values can be unified. Special columns
+                /// like sets are compared by identity.
+                WriteBufferFromOwnString buf;
+                buf << "column:" << node.result_type->getName() << ':';
+                if (isColumnConst(*node.column))
+                    buf << applyVisitor(FieldVisitorToString(), assert_cast<const ColumnConst &>(*node.column).getField());
+                else
+                    buf << reinterpret_cast<std::uintptr_t>(node.column.get());
+                key = buf.str();
+                break;
+            }
+            case ActionType::FUNCTION:
+            {
+                /// Unifying non-deterministic functions would change the result:
+                /// two calls to rand() are two different columns. Lambdas (function-typed results)
+                /// keep the captured expression in function_base, so equal signatures do not mean
+                /// equal functions. Stateful functions keep state per node instance.
+                if (!node.is_deterministic || node.function_base->isStateful()
+                    || node.result_type->getTypeId() == TypeIndex::Function)
+                    continue;
+
+                WriteBufferFromOwnString buf;
+                buf << "function:" << node.function_base->getName() << ':' << node.result_type->getName();
+                for (const auto * child : node.children)
+                    buf << ':' << reinterpret_cast<std::uintptr_t>(child);
+                key = buf.str();
+                break;
+            }
+            case ActionType::INPUT:
+            case ActionType::ARRAY_JOIN:
+                /// Inputs correspond to block columns positionally. Array joins change the number
+                /// of rows and every occurrence must stay separate.
+                continue;
+        }
+
+        auto [it, inserted] = unique_nodes.emplace(std::move(key), &node);
+        if (inserted)
+            continue;
+
+        Node * existing = it->second;
+        if (node.result_name == existing->result_name)
+        {
+            /// Exact duplicate, all parents and outputs are redirected to the kept node.
+            replacements[&node] = existing;
+        }
+        else if (node.type != ActionType::ALIAS)
+        {
+            /// Same expression under a different name: keep the name, share the computation.
+            node.type = ActionType::ALIAS;
+            node.children = {existing};
+            node.function_base = nullptr;
+            node.function = nullptr;
+            node.is_function_compiled = false;
+        }
+    }
+
+    if (replacements.empty())
+        return;
+
+    for (auto & output : outputs)
+        if (auto it = replacements.find(output); it != replacements.end())
+            output = it->second;
+
+    removeUnusedActions(/* allow_remove_inputs = */ false);
+}
+
 std::string ActionsDAG::dumpDAG() const
 {
     std::unordered_map<const Node *, size_t> map;
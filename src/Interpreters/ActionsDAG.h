@@ -230,6 +230,12 @@ public:
     void compileExpressions(size_t min_count_to_compile_expression, const std::unordered_set<const Node *> & lazy_executed_nodes = {});
 #endif
 
+    /// Deduplicate structurally equal deterministic subexpressions.
+    /// Equal nodes with the same result name are collapsed into one, equal nodes with different
+    /// result names are turned into aliases, so every use shares the same result column.
+    /// Non-deterministic functions, array joins and inputs are never unified.
+    void eliminateCommonSubexpressions();
+
     ActionsDAGPtr clone() const;
 
     /// Execute actions for header. Input block must have empty columns.
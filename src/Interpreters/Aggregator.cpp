@@ -14,6 +14,8 @@
 #include <DataTypes/DataTypeAggregateFunction.h>
 #include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypeLowCardinality.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Columns/ColumnsNumber.h>
 #include <Columns/ColumnArray.h>
 #include <Columns/ColumnTuple.h>
 #include <Columns/ColumnSparse.h>
@@ -21,6 +23,7 @@
 #include <IO/WriteBufferFromFile.h>
 #include <Compression/CompressedWriteBuffer.h>
 #include <Interpreters/Aggregator.h>
+#include <Interpreters/sortBlock.h>
 #include <Common/CacheBase.h>
 #include <Common/MemoryTracker.h>
 #include <Common/CurrentThread.h>
@@ -426,6 +429,24 @@ Block Aggregator::getHeader(bool final) const
     return params.getHeader(header, final);
 }
 
+Block Aggregator::getSpillHeader() const
+{
+    Block res = getHeader(false);
+    if (spill_sorted_runs)
+        res.insert(0, {DataTypeUInt16().createColumn(), std::make_shared<DataTypeUInt16>(), "__bucket"});
+    return res;
+}
+
+SortDescription Aggregator::getSpillSortDescription() const
+{
+    SortDescription description;
+    description.reserve(params.keys_size + 1);
+    description.emplace_back("__bucket", 1, 1);
+    for (const auto & key : params.keys)
+        description.emplace_back(key, 1, 1);
+    return description;
+}
+
 Block Aggregator::Params::getHeader(
     const Block & header, bool only_merge, const Names & keys, const AggregateDescriptions & aggregates, bool final)
 {
@@ -586,6 +607,7 @@ Aggregator::Aggregator(const Block & header_, const Params & params_)
     : header(header_)
     , keys_positions(calculateKeysPositions(header, params_))
     , params(params_)
+    , spill_sorted_runs(params.spill_sorted_runs && !params.overflow_row)
     , tmp_data(params.tmp_data_scope ? std::make_unique<TemporaryDataOnDisk>(params.tmp_data_scope, CurrentMetrics::TemporaryFilesForAggregation) : nullptr)
     , min_bytes_for_prefetch(getMinBytesForPrefetch())
 {
@@ -594,6 +616,9 @@ Aggregator::Aggregator(const Block & header_, const Params & params_)
         if (auto * memory_tracker = memory_tracker_child->getParent())
             memory_usage_before_aggregation = memory_tracker->get();
 
+    if (tmp_data)
+        pressure_participant = MemoryPressureArbitrator::instance().registerParticipant();
+
     aggregate_functions.resize(params.aggregates_size);
     for (size_t i = 0; i < params.aggregates_size; ++i)
         aggregate_functions[i] = params.aggregates[i].function.get();
@@ -1499,13 +1524,21 @@ bool Aggregator::executeOnBlock(Columns columns,
       */
     Columns materialized_columns;
 
+    /** The serialized method writes keys through IColumn::serializeValueIntoArena, and
+      * ColumnLowCardinality serializes the dictionary value addressed by the reverse index,
+      * producing the same bytes as the materialized column would. So in the multi-key fallback
+      * there is no need to materialize whole LowCardinality columns only to discard them
+      * after the block (the merge path already feeds such columns in without materialization).
+      */
+    const bool lc_keys_are_consumed_directly = result.isLowCardinality() || result.type == AggregatedDataVariants::Type::serialized;
+
     /// Remember the columns we will work with
     for (size_t i = 0; i < params.keys_size; ++i)
     {
         materialized_columns.push_back(recursiveRemoveSparse(columns.at(keys_positions[i]))->convertToFullColumnIfConst());
         key_columns[i] = materialized_columns.back().get();
 
-        if (!result.isLowCardinality())
+        if (!lc_keys_are_consumed_directly)
         {
             auto column_no_lc = recursiveRemoveLowCardinality(key_columns[i]->getPtr());
             if (column_no_lc.get() != key_columns[i])
@@ -1551,6 +1584,8 @@ bool Aggregator::executeOnBlock(Columns columns,
         executeImpl(result, row_begin, row_end, key_columns, aggregate_functions_instructions.data(), no_more_keys, overflow_row_ptr);
     }
 
+    result.aggregated_input_rows += row_end - row_begin;
+
     size_t result_size = result.sizeWithoutOverflowRow();
     Int64 current_memory_usage = 0;
     if (auto * memory_tracker_child = CurrentThread::getMemoryTracker())
@@ -1563,26 +1598,45 @@ bool Aggregator::executeOnBlock(Columns columns,
     bool worth_convert_to_two_level = worthConvertToTwoLevel(
         params.group_by_two_level_threshold, result_size, params.group_by_two_level_threshold_bytes, result_size_bytes);
 
+    /// If almost every input row observed so far created its own group, the GROUP BY key is high-cardinality
+    /// and the two-level threshold will almost surely be crossed later anyway. Convert while the hash table
+    /// is still small and the rehash is cheap - converting right at the threshold rebuilds a large table
+    /// mid-query, which shows up as a latency spike.
+    static constexpr size_t min_rows_for_observed_cardinality_conversion = 16384;
+    bool high_observed_cardinality = params.group_by_two_level_threshold != 0
+        && result_size >= min_rows_for_observed_cardinality_conversion
+        && result_size * 4 >= result.aggregated_input_rows * 3;
+
     /** Converting to a two-level data structure.
       * It allows you to make, in the subsequent, an effective merge - either economical from memory or parallel.
       */
-    if (result.isConvertibleToTwoLevel() && worth_convert_to_two_level)
+    if (result.isConvertibleToTwoLevel() && (worth_convert_to_two_level || high_observed_cardinality))
         result.convertToTwoLevel();
 
     /// Checking the constraints.
     if (!checkLimits(result_size, no_more_keys))
         return false;
 
+    if (pressure_participant)
+        pressure_participant->setReclaimableBytes(result_size_bytes);
+
     /** Flush data to disk if too much RAM is consumed.
       * Data can only be flushed to disk if a two-level aggregation structure is used.
       */
-    if (params.max_bytes_before_external_group_by
-        && result.isTwoLevel()
-        && current_memory_usage > static_cast<Int64>(params.max_bytes_before_external_group_by)
-        && worth_convert_to_two_level)
+    bool own_limit_reached = params.max_bytes_before_external_group_by
+        && current_memory_usage > static_cast<Int64>(params.max_bytes_before_external_group_by);
+
+    /// The server-level memory arbitrator may ask to release memory
+    /// before our own threshold is reached, to keep other queries from being killed.
+    bool spill_under_memory_pressure = pressure_participant && pressure_participant->isSpillRequested();
+
+    if (result.isTwoLevel() && worth_convert_to_two_level && (own_limit_reached || spill_under_memory_pressure))
     {
         size_t size = current_memory_usage + params.min_free_disk_space;
         writeToTemporaryFile(result, size);
+
+        if (pressure_participant)
+            pressure_participant->onSpillFinished();
     }
 
     return true;
@@ -1597,7 +1651,7 @@ void Aggregator::writeToTemporaryFile(AggregatedDataVariants & data_variants, si
     Stopwatch watch;
     size_t rows = data_variants.size();
 
-    auto & out_stream = tmp_data->createStream(getHeader(false), max_temp_file_size);
+    auto & out_stream = tmp_data->createStream(getSpillHeader(), max_temp_file_size);
     ProfileEvents::increment(ProfileEvents::ExternalAggregationWritePart);
 
     LOG_DEBUG(log, "Writing part of aggregation data into temporary file {}", out_stream.getPath());
@@ -1695,6 +1749,24 @@ Block Aggregator::mergeAndConvertOneBucketToBlock(
     return block;
 }
 
+Block Aggregator::convertOneBucketToBlock(AggregatedDataVariants & data_variants, Arena * arena, bool final, Int32 bucket) const
+{
+    auto method = data_variants.type;
+    Block block;
+
+    if (false) {} // NOLINT
+#define M(NAME) \
+    else if (method == AggregatedDataVariants::Type::NAME) \
+        block = convertOneBucketToBlock(data_variants, *data_variants.NAME, arena, final, bucket);
+
+    APPLY_FOR_VARIANTS_TWO_LEVEL(M)
+#undef M
+    else
+        throw Exception(ErrorCodes::UNKNOWN_AGGREGATED_DATA_VARIANT, "Unknown aggregated data variant.");
+
+    return block;
+}
+
 
 template <typename Method>
 void Aggregator::writeToTemporaryFileImpl(
@@ -1719,6 +1791,8 @@ void Aggregator::writeToTemporaryFileImpl(
     for (UInt32 bucket = 0; bucket < Method::Data::NUM_BUCKETS; ++bucket)
     {
         Block block = convertOneBucketToBlock(data_variants, method, data_variants.aggregates_pool, false, bucket);
+        if (spill_sorted_runs)
+            block = prepareSortedSpillBlock(std::move(block), bucket);
         out.write(block);
         update_max_sizes(block);
     }
@@ -1738,6 +1812,24 @@ void Aggregator::writeToTemporaryFileImpl(
 }
 
 
+Block Aggregator::prepareSortedSpillBlock(Block && block, UInt32 bucket) const
+{
+    SortDescription description;
+    description.reserve(params.keys_size);
+    for (const auto & key : params.keys)
+        description.emplace_back(key, 1, 1);
+
+    sortBlock(block, description);
+
+    /// Buckets are written in ascending order, so with the bucket number as the leading
+    /// sort column the whole file forms a single sorted run.
+    block.insert(0, {ColumnUInt16::create(block.rows(), static_cast<UInt16>(bucket)),
+        std::make_shared<DataTypeUInt16>(), "__bucket"});
+
+    return block;
+}
+
+
 bool Aggregator::checkLimits(size_t result_size, bool & no_more_keys) const
 {
     if (!no_more_keys && params.max_rows_to_group_by && result_size > params.max_rows_to_group_by)
@@ -1956,6 +2048,34 @@ Block Aggregator::insertResultsIntoColumns(PaddedPODArray<AggregateDataPtr> & pl
     return finalizeBlock(params, getHeader(/* final */ true), std::move(out_cols), /* final */ true, places.size());
 }
 
+/// Materializes collected string keys in one pass: a bulk copy with a single resize
+/// of the chars buffer instead of per-row insertData with amortized reallocations.
+static void NO_INLINE insertStringRefsIntoColumn(ColumnString & column, const PaddedPODArray<StringRef> & refs)
+{
+    auto & chars = column.getChars();
+    auto & offsets = column.getOffsets();
+
+    size_t old_chars_size = chars.size();
+    size_t new_chars_size = old_chars_size;
+    for (const auto & ref : refs)
+        new_chars_size += ref.size + 1;
+
+    chars.resize(new_chars_size);
+    offsets.reserve(offsets.size() + refs.size());
+
+    char * chars_begin = reinterpret_cast<char *>(chars.data());
+    char * pos = chars_begin + old_chars_size;
+    for (const auto & ref : refs)
+    {
+        if (ref.size)
+            memcpy(pos, ref.data, ref.size);
+        pos += ref.size;
+        *pos = 0;
+        ++pos;
+        offsets.push_back(pos - chars_begin);
+    }
+}
+
 template <typename Method, bool use_compiled_functions, bool return_single_block, typename Table>
 Aggregator::ConvertToBlockRes<return_single_block> NO_INLINE
 Aggregator::convertToBlockImplFinal(Method & method, Table & data, Arena * arena, Arenas & aggregates_pools, size_t) const
@@ -1968,6 +2088,11 @@ Aggregator::convertToBlockImplFinal(Method & method, Table & data, Arena * arena
     std::optional<Sizes> shuffled_key_sizes;
     PaddedPODArray<AggregateDataPtr> places;
 
+    /// For a single String key, references to the keys in the arena are collected first
+    /// and the column is materialized in bulk when the block is formed.
+    ColumnString * key_string_column = nullptr;
+    PaddedPODArray<StringRef> string_key_refs;
+
     auto init_out_cols = [&]()
     {
         out_cols = prepareOutputBlockColumns(params, aggregate_functions, getHeader(final), aggregates_pools, final, max_block_size);
@@ -1984,9 +2109,22 @@ Aggregator::convertToBlockImplFinal(Method & method, Table & data, Arena * arena
 
         shuffled_key_sizes = method.shuffleKeyColumns(out_cols->raw_key_columns, key_sizes);
 
+        key_string_column = params.keys_size == 1 ? typeid_cast<ColumnString *>(out_cols->raw_key_columns[0]) : nullptr;
+        if (key_string_column)
+            string_key_refs.reserve(max_block_size);
+
         places.reserve(max_block_size);
     };
 
+    auto flush_string_keys = [&]()
+    {
+        if (key_string_column && !string_key_refs.empty())
+        {
+            insertStringRefsIntoColumn(*key_string_column, string_key_refs);
+            string_key_refs.clear();
+        }
+    };
+
     // should be invoked at least once, because null data might be the only content of the `data`
     init_out_cols();
 
@@ -1997,7 +2135,20 @@ Aggregator::convertToBlockImplFinal(Method & method, Table & data, Arena * arena
                 init_out_cols();
 
             const auto & key_sizes_ref = shuffled_key_sizes ? *shuffled_key_sizes : key_sizes;
-            method.insertKeyIntoColumns(key, out_cols->raw_key_columns, key_sizes_ref);
+
+            bool key_collected = false;
+            if constexpr (std::is_same_v<std::decay_t<decltype(key)>, StringRef>)
+            {
+                if (key_string_column)
+                {
+                    string_key_refs.push_back(key);
+                    key_collected = true;
+                }
+            }
+
+            if (!key_collected)
+                method.insertKeyIntoColumns(key, out_cols->raw_key_columns, key_sizes_ref);
+
             places.emplace_back(mapped);
 
             /// Mark the cell as destroyed so it will not be destroyed in destructor.
@@ -2007,6 +2158,7 @@ Aggregator::convertToBlockImplFinal(Method & method, Table & data, Arena * arena
             {
                 if (places.size() >= max_block_size)
                 {
+                    flush_string_keys();
                     res.emplace_back(insertResultsIntoColumns<use_compiled_functions>(places, std::move(out_cols.value()), arena));
                     places.clear();
                     out_cols.reset();
@@ -2014,6 +2166,8 @@ Aggregator::convertToBlockImplFinal(Method & method, Table & data, Arena * arena
             }
         });
 
+    flush_string_keys();
+
     if constexpr (return_single_block)
     {
         return insertResultsIntoColumns<use_compiled_functions>(places, std::move(out_cols.value()), arena);
@@ -2104,6 +2258,108 @@ Aggregator::convertToBlockImplNotFinal(Method & method, Table & data, Arenas & a
     return res;
 }
 
+template <typename Method, typename Table, typename Func>
+size_t NO_INLINE Aggregator::snapshotImpl(Method & method, Table & data, std::vector<IColumn *> & raw_key_columns, Func && copy_state) const
+{
+    size_t rows = 0;
+
+    if constexpr (Method::low_cardinality_optimization)
+    {
+        if (data.hasNullKeyData())
+        {
+            raw_key_columns[0]->insertDefault();
+            copy_state(data.getNullKeyData());
+            ++rows;
+        }
+    }
+
+    auto shuffled_key_sizes = method.shuffleKeyColumns(raw_key_columns, key_sizes);
+    const auto & key_sizes_ref = shuffled_key_sizes ? *shuffled_key_sizes : key_sizes;
+
+    auto on_entry = [&](const auto & key, const auto & mapped)
+    {
+        method.insertKeyIntoColumns(key, raw_key_columns, key_sizes_ref);
+        copy_state(mapped);
+        ++rows;
+    };
+
+    if constexpr (requires { Table::NUM_BUCKETS; })
+    {
+        /// The null key data of two-level tables lives in the zero bucket but was already
+        /// processed above through the whole-table accessor.
+        for (size_t bucket = 0; bucket < Table::NUM_BUCKETS; ++bucket)
+            data.impls[bucket].forEachValue(on_entry);
+    }
+    else
+    {
+        data.forEachValue(on_entry);
+    }
+
+    return rows;
+}
+
+Block Aggregator::snapshotToBlock(AggregatedDataVariants & data_variants) const
+{
+    if (data_variants.empty())
+        return {};
+
+    const bool final = false;
+    auto snapshot_arena = std::make_shared<Arena>();
+    Arenas snapshot_pools{snapshot_arena};
+
+    OutputBlockColumns out_cols = prepareOutputBlockColumns(
+        params, aggregate_functions, getHeader(final), snapshot_pools, final, data_variants.size());
+
+    /// Copy one state into the snapshot arena and append it to the aggregate columns.
+    /// The copies are owned by the resulting block (see the destructor of ColumnAggregateFunction),
+    /// the originals are left untouched.
+    auto copy_state = [&](ConstAggregateDataPtr mapped)
+    {
+        AggregateDataPtr copied = snapshot_arena->alignedAlloc(total_size_of_aggregate_states, align_aggregate_states);
+        createAggregateStates(copied);
+
+        for (size_t i = 0; i < params.aggregates_size; ++i)
+        {
+            try
+            {
+                aggregate_functions[i]->merge(
+                    copied + offsets_of_aggregate_states[i], mapped + offsets_of_aggregate_states[i], snapshot_arena.get());
+            }
+            catch (...)
+            {
+                /// States starting from the i-th are not yet owned by any column.
+                for (size_t j = i; j < params.aggregates_size; ++j)
+                    aggregate_functions[j]->destroy(copied + offsets_of_aggregate_states[j]);
+                throw;
+            }
+
+            out_cols.aggregate_columns_data[i]->push_back(copied + offsets_of_aggregate_states[i]);
+        }
+    };
+
+    size_t rows = 0;
+
+    if (data_variants.type == AggregatedDataVariants::Type::without_key)
+    {
+        if (data_variants.without_key)
+        {
+            copy_state(data_variants.without_key);
+            ++rows;
+        }
+    }
+#define M(NAME) \
+    else if (data_variants.type == AggregatedDataVariants::Type::NAME) \
+        rows = snapshotImpl(*data_variants.NAME, data_variants.NAME->data, out_cols.raw_key_columns, copy_state);
+
+    APPLY_FOR_VARIANTS_SINGLE_LEVEL(M)
+    APPLY_FOR_VARIANTS_TWO_LEVEL(M)
+#undef M
+    else
+        throw Exception(ErrorCodes::UNKNOWN_AGGREGATED_DATA_VARIANT, "Unknown aggregated data variant.");
+
+    return finalizeBlock(params, getHeader(final), std::move(out_cols), final, rows);
+}
+
 void Aggregator::addSingleKeyToAggregateColumns(
     AggregatedDataVariants & data_variants,
     MutableColumns & aggregate_columns) const
@@ -2908,22 +3164,65 @@ bool Aggregator::mergeOnBlock(Block block, AggregatedDataVariants & result, bool
     if (!checkLimits(result_size, no_more_keys))
         return false;
 
+    if (pressure_participant)
+        pressure_participant->setReclaimableBytes(result_size_bytes);
+
     /** Flush data to disk if too much RAM is consumed.
       * Data can only be flushed to disk if a two-level aggregation structure is used.
       */
-    if (params.max_bytes_before_external_group_by
-        && result.isTwoLevel()
-        && current_memory_usage > static_cast<Int64>(params.max_bytes_before_external_group_by)
-        && worth_convert_to_two_level)
+    bool own_limit_reached = params.max_bytes_before_external_group_by
+        && current_memory_usage > static_cast<Int64>(params.max_bytes_before_external_group_by);
+
+    /// The server-level memory arbitrator may ask to release memory
+    /// before our own threshold is reached, to keep other queries from being killed.
+    bool spill_under_memory_pressure = pressure_participant && pressure_participant->isSpillRequested();
+
+    if (result.isTwoLevel() && worth_convert_to_two_level && (own_limit_reached || spill_under_memory_pressure))
     {
         size_t size = current_memory_usage + params.min_free_disk_space;
         writeToTemporaryFile(result, size);
+
+        if (pressure_participant)
+            pressure_participant->onSpillFinished();
     }
 
     return true;
 }
 
 
+void Aggregator::initStateForTwoLevelMerge(AggregatedDataVariants & result)
+{
+#define M(NAME) \
+    if (method_chosen == AggregatedDataVariants::Type::NAME) \
+        method_chosen = AggregatedDataVariants::Type::NAME ## _two_level;
+
+    APPLY_FOR_VARIANTS_CONVERTIBLE_TO_TWO_LEVEL(M)
+
+#undef M
+
+    /// result will destroy the states of aggregate functions in the destructor
+    result.aggregator = this;
+
+    result.init(method_chosen);
+    result.keys_size = params.keys_size;
+    result.key_sizes = key_sizes;
+}
+
+void Aggregator::mergeTwoLevelBucketBlock(Block block, AggregatedDataVariants & result, Arena * aggregates_pool) const
+{
+    auto bucket = block.info.bucket_num;
+
+#define M(NAME) \
+    else if (result.type == AggregatedDataVariants::Type::NAME) \
+        mergeStreamsImpl(std::move(block), aggregates_pool, *result.NAME, result.NAME->data.impls[bucket], nullptr, false);
+
+    if (false) {} // NOLINT
+        APPLY_FOR_VARIANTS_TWO_LEVEL(M)
+#undef M
+    else
+        throw Exception(ErrorCodes::UNKNOWN_AGGREGATED_DATA_VARIANT, "Unknown aggregated data variant.");
+}
+
 void Aggregator::mergeBlocks(BucketToBlocks bucket_to_blocks, AggregatedDataVariants & result, size_t max_threads)
 {
     if (bucket_to_blocks.empty())
@@ -2941,24 +3240,25 @@ void Aggregator::mergeBlocks(BucketToBlocks bucket_to_blocks, AggregatedDataVari
     auto max_bucket = bucket_to_blocks.rbegin()->first;
     bool has_two_level = max_bucket >= 0;
 
-    if (has_two_level)
+    /// 'result' may be initialized already if two-level buckets were merged in a streaming fashion
+    /// (see MergingAggregatedTransform), then only blocks without a bucket number are expected here.
+    if (result.empty())
     {
-    #define M(NAME) \
-        if (method_chosen == AggregatedDataVariants::Type::NAME) \
-            method_chosen = AggregatedDataVariants::Type::NAME ## _two_level;
-
-        APPLY_FOR_VARIANTS_CONVERTIBLE_TO_TWO_LEVEL(M)
+        if (has_two_level)
+        {
+            initStateForTwoLevelMerge(result);
+        }
+        else
+        {
+            /// result will destroy the states of aggregate functions in the destructor
+            result.aggregator = this;
 
-    #undef M
+            result.init(method_chosen);
+            result.keys_size = params.keys_size;
+            result.key_sizes = key_sizes;
+        }
     }
 
-    /// result will destroy the states of aggregate functions in the destructor
-    result.aggregator = this;
-
-    result.init(method_chosen);
-    result.keys_size = params.keys_size;
-    result.key_sizes = key_sizes;
-
     bool has_blocks_with_unknown_bucket = bucket_to_blocks.contains(-1);
 
     /// First, parallel the merge for the individual buckets. Then we continue merge the data not allocated to the buckets.
@@ -2981,17 +3281,7 @@ void Aggregator::mergeBlocks(BucketToBlocks bucket_to_blocks, AggregatedDataVari
                 CurrentThread::attachToIfDetached(thread_group);
 
             for (Block & block : bucket_to_blocks[bucket])
-            {
-            #define M(NAME) \
-                else if (result.type == AggregatedDataVariants::Type::NAME) \
-                    mergeStreamsImpl(std::move(block), aggregates_pool, *result.NAME, result.NAME->data.impls[bucket], nullptr, false);
-
-                if (false) {} // NOLINT
-                    APPLY_FOR_VARIANTS_TWO_LEVEL(M)
-            #undef M
-                else
-                    throw Exception(ErrorCodes::UNKNOWN_AGGREGATED_DATA_VARIANT, "Unknown aggregated data variant.");
-            }
+                mergeTwoLevelBucketBlock(std::move(block), result, aggregates_pool);
         };
 
         std::unique_ptr<ThreadPool> thread_pool;
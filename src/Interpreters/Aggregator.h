@@ -15,11 +15,13 @@
 #include <Common/HashTable/StringHashMap.h>
 #include <Common/HashTable/TwoLevelStringHashMap.h>
 
+#include <Common/MemoryPressureArbitrator.h>
 #include <Common/ThreadPool.h>
 #include <Common/ColumnsHashing.h>
 #include <Common/assert_cast.h>
 #include <Common/filesystemHelpers.h>
 #include <Core/ColumnNumbers.h>
+#include <Core/SortDescription.h>
 
 #include <QueryPipeline/SizeLimits.h>
 
@@ -542,6 +544,10 @@ struct AggregatedDataVariants : private boost::noncopyable
     size_t keys_size{};  /// Number of keys. NOTE do we need this field?
     Sizes key_sizes;     /// Dimensions of keys, if keys of fixed length
 
+    /// Total number of input rows aggregated into these variants so far. Together with size() it gives the
+    /// observed cardinality of the GROUP BY keys, see the early two-level conversion in Aggregator::executeOnBlock.
+    size_t aggregated_input_rows = 0;
+
     /// Pools for states of aggregate functions. Ownership will be later transferred to ColumnAggregateFunction.
     Arenas aggregates_pools;
     Arena * aggregates_pool{};    /// The pool that is currently used for allocation.
@@ -942,6 +948,12 @@ public:
 
         bool enable_prefetch;
 
+        /// Spill external aggregation data as runs sorted by the grouping key, so that
+        /// temporary files can be merged with a streaming k-way merge instead of loading
+        /// whole buckets into memory. Not a constructor argument: only the interpreters
+        /// of SELECT queries set it.
+        bool spill_sorted_runs = false;
+
         struct StatsCollectingParams
         {
             StatsCollectingParams();
@@ -1058,12 +1070,36 @@ public:
     /// Merge partially aggregated blocks separated to buckets into one data structure.
     void mergeBlocks(BucketToBlocks bucket_to_blocks, AggregatedDataVariants & result, size_t max_threads);
 
+    /// Initialize 'result' with the two-level counterpart of the chosen method, so that blocks
+    /// of individual two-level buckets can be merged into it as they arrive with mergeTwoLevelBucketBlock.
+    /// Used for streaming merge of two-level data in MergingAggregatedTransform.
+    void initStateForTwoLevelMerge(AggregatedDataVariants & result);
+
+    /// Merge one partially aggregated block with a non-negative bucket number into 'result',
+    /// which must have been initialized with initStateForTwoLevelMerge.
+    /// May be called concurrently for blocks with distinct bucket numbers.
+    void mergeTwoLevelBucketBlock(Block block, AggregatedDataVariants & result, Arena * aggregates_pool) const;
+
+    /// Convert one bucket of a two-level aggregation state into a block.
+    /// Incremental counterpart of convertToBlocks: allows emitting the result bucket by bucket,
+    /// so that downstream processors see the first rows without waiting for the whole conversion.
+    /// The block for an already converted or empty bucket has zero rows.
+    Block convertOneBucketToBlock(AggregatedDataVariants & data_variants, Arena * arena, bool final, Int32 bucket) const;
+
     /// Merge several partially aggregated blocks into one.
     /// Precondition: for all blocks block.info.is_overflows flag must be the same.
     /// (either all blocks are from overflow data or none blocks are).
     /// The resulting block has the same value of is_overflows flag.
     Block mergeBlocks(BlocksList & blocks, bool final);
 
+    /// Copy the current intermediate aggregation state into a block without destroying it
+    /// (the regular conversion methods release the states into the resulting block).
+    /// The returned block has the structure of getHeader(final = false) and the copied states
+    /// live in a fresh arena owned by the aggregate columns of the block, so it stays valid
+    /// after 'data_variants' is modified or destroyed. Must be called from the thread that
+    /// fills 'data_variants'. Used for sending partial results of in-progress aggregation.
+    Block snapshotToBlock(AggregatedDataVariants & data_variants) const;
+
     /** Split block with partially-aggregated data to many blocks, as if two-level method of aggregation was used.
       * This is needed to simplify merging of that data with other results, that are already two-level.
       */
@@ -1079,12 +1115,24 @@ public:
     /// Get data structure of the result.
     Block getHeader(bool final) const;
 
+    /// Whether temporary files are written as runs sorted by the grouping key
+    /// (see Params::spill_sorted_runs).
+    bool spillsSortedRuns() const { return spill_sorted_runs; }
+
+    /// Structure of the blocks in temporary files. When spilling sorted runs it contains
+    /// an extra leading "__bucket" column, which makes every file globally sorted.
+    Block getSpillHeader() const;
+
+    /// Sort order of the blocks in temporary files when spilling sorted runs.
+    SortDescription getSpillSortDescription() const;
+
 private:
 
     friend struct AggregatedDataVariants;
     friend class ConvertingAggregatedToChunksTransform;
     friend class ConvertingAggregatedToChunksSource;
     friend class AggregatingInOrderTransform;
+    friend class MergingAggregatedTransform;
 
     /// Data structure of source blocks.
     Block header;
@@ -1092,6 +1140,9 @@ private:
     const ColumnNumbers keys_positions;
     Params params;
 
+    /// Overflow rows have no keys, so they cannot take part in a merge by key order.
+    const bool spill_sorted_runs;
+
     AggregatedDataVariants::Type method_chosen;
     Sizes key_sizes;
 
@@ -1135,6 +1186,10 @@ private:
     /// For external aggregation.
     TemporaryDataOnDiskPtr tmp_data;
 
+    /// Set when temporary data is available: the server-level memory arbitrator
+    /// may ask to flush the aggregation state to disk under memory pressure.
+    MemoryPressureArbitrator::ParticipantPtr pressure_participant;
+
     size_t min_bytes_for_prefetch = 0;
 
 #if USE_EMBEDDED_COMPILER
@@ -1238,6 +1293,9 @@ private:
         Method & method,
         TemporaryFileStream & out) const;
 
+    /// Sort a bucket's block by the grouping key and prepend the "__bucket" column.
+    Block prepareSortedSpillBlock(Block && block, UInt32 bucket) const;
+
     /// Merge NULL key data from hash table `src` into `dst`.
     template <typename Method, typename Table>
     void mergeDataNullKey(
@@ -1295,6 +1353,11 @@ private:
     ConvertToBlockRes<return_single_block>
     convertToBlockImplNotFinal(Method & method, Table & data, Arenas & aggregates_pools, size_t rows) const;
 
+    /// Insert keys of all entries into the key columns and pass every state to 'copy_state'
+    /// without modifying the table. Handles both single-level and two-level tables.
+    template <typename Method, typename Table, typename Func>
+    size_t snapshotImpl(Method & method, Table & data, std::vector<IColumn *> & raw_key_columns, Func && copy_state) const;
+
     template <typename Method>
     Block convertOneBucketToBlock(
         AggregatedDataVariants & data_variants,
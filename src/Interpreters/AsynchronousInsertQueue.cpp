@@ -5,6 +5,7 @@
 #include <Interpreters/InterpreterInsertQuery.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/AsynchronousInsertLog.h>
+#include <Interpreters/castColumn.h>
 #include <Processors/Transforms/getSourceFromASTInsertQuery.h>
 #include <Processors/Sources/SourceFromSingleChunk.h>
 #include <Processors/Executors/StreamingFormatExecutor.h>
@@ -102,8 +103,9 @@ bool AsynchronousInsertQueue::InsertQuery::operator==(const InsertQuery & other)
     return query_str == other.query_str && settings == other.settings;
 }
 
-AsynchronousInsertQueue::InsertData::Entry::Entry(String && bytes_, String && query_id_)
-    : bytes(std::move(bytes_))
+AsynchronousInsertQueue::InsertData::Entry::Entry(Block && block_, size_t bytes_size_, String && query_id_)
+    : block(std::move(block_))
+    , bytes_size(bytes_size_)
     , query_id(std::move(query_id_))
     , create_time(std::chrono::system_clock::now())
 {
@@ -209,7 +211,38 @@ std::future<void> AsynchronousInsertQueue::push(ASTPtr query, ContextPtr query_c
     if (auto quota = query_context->getQuota())
         quota->used(QuotaType::WRITTEN_BYTES, bytes.size());
 
-    auto entry = std::make_shared<InsertData::Entry>(std::move(bytes), query_context->getCurrentQueryId());
+    /// Parse the data right away, on the thread that received the query:
+    /// the flush then only merges ready blocks instead of re-parsing the whole
+    /// buffer, and parsing errors are reported to the client immediately.
+    Block block;
+    {
+        /// 'resetParser' doesn't work for parallel parsing,
+        /// and payloads of single inserts are small anyway.
+        auto parse_context = Context::createCopy(query_context);
+        parse_context->setSetting("input_format_parallel_parsing", Field(false));
+
+        auto format = getInputFormatFromASTInsertQuery(query, false, sample_block, parse_context, nullptr);
+
+        std::shared_ptr<ISimpleTransform> adding_defaults_transform;
+        if (parse_context->getSettingsRef().input_format_defaults_for_omitted_fields && insert_query.table_id)
+        {
+            auto metadata_snapshot = table->getInMemoryMetadataPtr();
+            const auto & columns = metadata_snapshot->getColumns();
+            if (columns.hasDefaults())
+                adding_defaults_transform = std::make_shared<AddingDefaultsTransform>(sample_block, columns, *format, parse_context);
+        }
+
+        StreamingFormatExecutor executor(
+            sample_block, format,
+            [](const MutableColumns &, Exception &) -> size_t { throw; },
+            std::move(adding_defaults_transform));
+
+        ReadBufferFromString buffer(bytes);
+        executor.execute(buffer);
+        block = sample_block.cloneWithColumns(executor.getResultColumns());
+    }
+
+    auto entry = std::make_shared<InsertData::Entry>(std::move(block), bytes.size(), query_context->getCurrentQueryId());
 
     InsertQuery key{query, settings};
     InsertDataPtr data_to_process;
@@ -231,7 +264,7 @@ std::future<void> AsynchronousInsertQueue::push(ASTPtr query, ContextPtr query_c
 
         auto queue_it = it->second;
         auto & data = queue_it->second.data;
-        size_t entry_data_size = entry->bytes.size();
+        size_t entry_data_size = entry->bytes_size;
 
         assert(data);
         data->size_in_bytes += entry_data_size;
@@ -346,11 +379,8 @@ try
     SCOPE_EXIT(CurrentMetrics::sub(CurrentMetrics::PendingAsyncInsert, data->entries.size()));
 
     const auto * log = &Poco::Logger::get("AsynchronousInsertQueue");
-    const auto & insert_query = assert_cast<const ASTInsertQuery &>(*key.query);
     auto insert_context = Context::createCopy(global_context);
 
-    /// 'resetParser' doesn't work for parallel parsing.
-    key.settings.set("input_format_parallel_parsing", false);
     insert_context->makeQueryContext();
     insert_context->setSettings(key.settings);
 
@@ -363,35 +393,6 @@ try
     assert(pipeline.pushing());
 
     auto header = pipeline.getHeader();
-    auto format = getInputFormatFromASTInsertQuery(key.query, false, header, insert_context, nullptr);
-
-    size_t total_rows = 0;
-    InsertData::EntryPtr current_entry;
-    String current_exception;
-
-    auto on_error = [&](const MutableColumns & result_columns, Exception & e)
-    {
-        current_exception = e.displayText();
-        LOG_ERROR(log, "Failed parsing for query '{}' with query id {}. {}",
-            key.query_str, current_entry->query_id, current_exception);
-
-        for (const auto & column : result_columns)
-            if (column->size() > total_rows)
-                column->popBack(column->size() - total_rows);
-
-        current_entry->finish(std::current_exception());
-        return 0;
-    };
-
-    std::shared_ptr<ISimpleTransform> adding_defaults_transform;
-    if (insert_context->getSettingsRef().input_format_defaults_for_omitted_fields && insert_query.table_id)
-    {
-        StoragePtr storage = DatabaseCatalog::instance().getTable(insert_query.table_id, insert_context);
-        auto metadata_snapshot = storage->getInMemoryMetadataPtr();
-        const auto & columns = metadata_snapshot->getColumns();
-        if (columns.hasDefaults())
-            adding_defaults_transform = std::make_shared<AddingDefaultsTransform>(header, columns, *format, insert_context);
-    }
 
     auto insert_log = global_context->getAsynchronousInsertLog();
     std::vector<AsynchronousInsertLogElement> log_elements;
@@ -399,19 +400,57 @@ try
     if (insert_log)
         log_elements.reserve(data->entries.size());
 
-    StreamingFormatExecutor executor(header, format, std::move(on_error), std::move(adding_defaults_transform));
-    std::unique_ptr<ReadBuffer> last_buffer;
+    size_t total_rows = 0;
     auto chunk_info = std::make_shared<ChunkOffsets>();
+    MutableColumns result_columns = header.cloneEmptyColumns();
+
     for (const auto & entry : data->entries)
     {
-        auto buffer = std::make_unique<ReadBufferFromString>(entry->bytes);
-        current_entry = entry;
-        total_rows += executor.execute(*buffer);
-        chunk_info->offsets.push_back(total_rows);
+        String current_exception;
+
+        /// The data was parsed at arrival (see push()), here we only append ready columns.
+        /// The table could have been altered after the entry was enqueued, then the block
+        /// structure differs from the current header: adapt columns by name in that case.
+        /// Prepare all columns of the entry before appending any of them,
+        /// so a failed entry leaves the result columns untouched.
+        try
+        {
+            const auto & block = entry->block;
+            size_t rows = block.rows();
+
+            Columns columns_to_append(header.columns());
+            for (size_t i = 0; i < header.columns(); ++i)
+            {
+                const auto & column_in_header = header.getByPosition(i);
+                if (const auto * column = block.findByName(column_in_header.name))
+                {
+                    if (column->type->equals(*column_in_header.type))
+                        columns_to_append[i] = column->column;
+                    else
+                        columns_to_append[i] = castColumn(*column, column_in_header.type);
+                }
+            }
 
-        /// Keep buffer, because it still can be used
-        /// in destructor, while resetting buffer at next iteration.
-        last_buffer = std::move(buffer);
+            for (size_t i = 0; i < header.columns(); ++i)
+            {
+                /// A column added to the table after the entry was parsed is filled with defaults.
+                if (columns_to_append[i])
+                    result_columns[i]->insertRangeFrom(*columns_to_append[i], 0, rows);
+                else
+                    result_columns[i]->insertManyDefaults(rows);
+            }
+
+            total_rows += rows;
+            chunk_info->offsets.push_back(total_rows);
+        }
+        catch (...)
+        {
+            current_exception = getCurrentExceptionMessage(false);
+            LOG_ERROR(log, "Failed to append data for query '{}' with query id {}. {}",
+                key.query_str, entry->query_id, current_exception);
+
+            entry->finish(std::current_exception());
+        }
 
         if (insert_log)
         {
@@ -420,12 +459,10 @@ try
             elem.event_time_microseconds = timeInMicroseconds(entry->create_time);
             elem.query = key.query;
             elem.query_id = entry->query_id;
-            elem.bytes = entry->bytes.size();
+            elem.bytes = entry->bytes_size;
             elem.exception = current_exception;
-            current_exception.clear();
 
-            /// If there was a parsing error,
-            /// the entry won't be flushed anyway,
+            /// If the entry could not be appended, it won't be flushed anyway,
             /// so add the log element immediately.
             if (!elem.exception.empty())
             {
@@ -439,15 +476,22 @@ try
         }
     }
 
-    format->addBuffer(std::move(last_buffer));
     auto insert_query_id = insert_context->getCurrentQueryId();
 
     if (total_rows == 0)
+    {
+        for (const auto & entry : data->entries)
+        {
+            if (!entry->isFinished())
+                entry->finish();
+        }
+
         return;
+    }
 
     try
     {
-        auto chunk = Chunk(executor.getResultColumns(), total_rows);
+        auto chunk = Chunk(std::move(result_columns), total_rows);
         chunk.setChunkInfo(std::move(chunk_info));
         size_t total_bytes = chunk.bytes();
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Core/Block.h>
 #include <Parsers/IAST_fwd.h>
 #include <Common/ThreadPool.h>
 #include <Core/Settings.h>
@@ -46,11 +47,15 @@ private:
         struct Entry
         {
         public:
-            const String bytes;
+            /// Data parsed at arrival (see push()), so the flush only merges ready blocks.
+            const Block block;
+            /// Size of the raw payload the block was parsed from.
+            /// Used for the buffer size limit and accounting, as before parsing at arrival.
+            const size_t bytes_size;
             const String query_id;
             const std::chrono::time_point<std::chrono::system_clock> create_time;
 
-            Entry(String && bytes_, String && query_id_);
+            Entry(Block && block_, size_t bytes_size_, String && query_id_);
 
             void finish(std::exception_ptr exception_ = nullptr);
             std::future<void> getFuture() { return promise.get_future(); }
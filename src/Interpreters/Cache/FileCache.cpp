@@ -5,6 +5,7 @@
 #include <Common/logger_useful.h>
 #include <Interpreters/Cache/FileCacheSettings.h>
 #include <Interpreters/Cache/LRUFileCachePriority.h>
+#include <Interpreters/Cache/SLRUFileCachePriority.h>
 #include <IO/ReadHelpers.h>
 #include <IO/WriteBufferFromFile.h>
 #include <IO/ReadSettings.h>
@@ -36,10 +37,14 @@ FileCache::FileCache(
     , enable_bypass_cache_with_threashold(cache_settings_.enable_bypass_cache_with_threashold)
     , bypass_cache_threashold(cache_settings_.bypass_cache_threashold)
     , log(&Poco::Logger::get("FileCache"))
-    , main_priority(std::make_unique<LRUFileCachePriority>())
     , stash_priority(std::make_unique<LRUFileCachePriority>())
     , max_stash_element_size(cache_settings_.max_elements)
 {
+    if (cache_settings_.cache_policy == "SLRU")
+        main_priority = std::make_unique<SLRUFileCachePriority>(
+            static_cast<size_t>(cache_settings_.max_size * cache_settings_.slru_size_ratio));
+    else
+        main_priority = std::make_unique<LRUFileCachePriority>();
 }
 
 FileCache::Key FileCache::hash(const String & path)
@@ -43,6 +43,14 @@ void FileCacheSettings::loadFromConfig(const Poco::Util::AbstractConfiguration &
          bypass_cache_threashold = REMOTE_FS_OBJECTS_CACHE_BYPASS_THRESHOLD;
 
     do_not_evict_index_and_mark_files = config.getUInt64(config_prefix + ".do_not_evict_index_and_mark_files", false);
+
+    cache_policy = config.getString(config_prefix + ".cache_policy", "LRU");
+    if (cache_policy != "LRU" && cache_policy != "SLRU")
+        throw Exception(ErrorCodes::BAD_ARGUMENTS, "Unknown cache policy `{}`, expected LRU or SLRU", cache_policy);
+
+    slru_size_ratio = config.getDouble(config_prefix + ".slru_size_ratio", REMOTE_FS_OBJECTS_CACHE_DEFAULT_SLRU_SIZE_RATIO);
+    if (slru_size_ratio <= 0.0 || slru_size_ratio >= 1.0)
+        throw Exception(ErrorCodes::BAD_ARGUMENTS, "`slru_size_ratio` must be in the interval (0, 1), got {}", slru_size_ratio);
 }
 
 }
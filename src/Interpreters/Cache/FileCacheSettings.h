@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <Interpreters/Cache/FileCache_fwd.h>
 
 namespace Poco { namespace Util { class AbstractConfiguration; } } // NOLINT(cppcoreguidelines-virtual-class-destructor)
@@ -23,6 +24,9 @@ struct FileCacheSettings
     bool enable_bypass_cache_with_threashold = false;
     size_t bypass_cache_threashold = REMOTE_FS_OBJECTS_CACHE_BYPASS_THRESHOLD;
 
+    std::string cache_policy = "LRU";
+    double slru_size_ratio = REMOTE_FS_OBJECTS_CACHE_DEFAULT_SLRU_SIZE_RATIO;
+
     void loadFromConfig(const Poco::Util::AbstractConfiguration & config, const std::string & config_prefix);
 };
 
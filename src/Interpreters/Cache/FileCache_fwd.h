@@ -8,6 +8,7 @@ static constexpr int REMOTE_FS_OBJECTS_CACHE_DEFAULT_MAX_FILE_SEGMENT_SIZE = 100
 static constexpr int REMOTE_FS_OBJECTS_CACHE_DEFAULT_MAX_ELEMENTS = 1024 * 1024;
 static constexpr int REMOTE_FS_OBJECTS_CACHE_ENABLE_HITS_THRESHOLD = 0;
 static constexpr size_t REMOTE_FS_OBJECTS_CACHE_BYPASS_THRESHOLD = 256 * 1024 * 1024;;
+static constexpr double REMOTE_FS_OBJECTS_CACHE_DEFAULT_SLRU_SIZE_RATIO = 0.5;
 
 class FileCache;
 using FileCachePtr = std::shared_ptr<FileCache>;
@@ -28,6 +28,9 @@ public:
         size_t size;
         size_t hits = 0;
 
+        /// Whether the record is in the protected part of the queue. Used only by the SLRU policy.
+        bool is_protected = false;
+
         FileCacheRecord(const Key & key_, size_t offset_, size_t size_) : key(key_), offset(offset_), size(size_) { }
     };
 
@@ -0,0 +1,47 @@
+#include <Interpreters/Cache/QueryASTCache.h>
+
+#include <Core/Settings.h>
+
+namespace ProfileEvents
+{
+    extern const Event QueryASTCacheHits;
+    extern const Event QueryASTCacheMisses;
+}
+
+namespace DB
+{
+
+UInt128 QueryASTCache::hash(const char * begin, const char * end, const Settings & settings)
+{
+    UInt128 key;
+
+    SipHash hash;
+    hash.update(begin, end - begin);
+    /// Settings that change the parsing result must be a part of the key.
+    hash.update(static_cast<UInt64>(settings.dialect.value));
+    hash.update(settings.allow_settings_after_format_in_insert.value);
+    hash.update(settings.max_parser_depth.value);
+
+    hash.get128(key);
+    return key;
+}
+
+ASTPtr QueryASTCache::getAST(const UInt128 & key)
+{
+    auto ast = Base::get(key);
+    if (ast)
+    {
+        ProfileEvents::increment(ProfileEvents::QueryASTCacheHits);
+        return ast->clone();
+    }
+
+    ProfileEvents::increment(ProfileEvents::QueryASTCacheMisses);
+    return nullptr;
+}
+
+void QueryASTCache::setAST(const UInt128 & key, const ASTPtr & ast)
+{
+    Base::set(key, ast->clone());
+}
+
+}
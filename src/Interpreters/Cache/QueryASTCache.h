@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Core/Types.h>
+#include <Common/HashTable/Hash.h>
+#include <Common/CacheBase.h>
+#include <Common/SipHash.h>
+#include <Common/ProfileEvents.h>
+#include <Parsers/IAST.h>
+
+namespace ProfileEvents
+{
+    extern const Event QueryASTCacheHits;
+    extern const Event QueryASTCacheMisses;
+}
+
+namespace DB
+{
+
+struct Settings;
+
+/** Cache of parsed query ASTs, keyed by the query text.
+  * Allows to skip parsing of repeated statements. Queries with bound parameters ({name:type})
+  * benefit the most: the parameter substitution happens on the AST after parsing, so a single
+  * cached template serves all bindings of the same statement.
+  *
+  * The stored AST is a template: it is cloned on every hit, because query processing
+  * rewrites the AST in place. INSERT queries with inline data are not cached, because
+  * their ASTs point into the buffer with the query text.
+  */
+class QueryASTCache : public CacheBase<UInt128, IAST, UInt128TrivialHash>
+{
+private:
+    using Base = CacheBase<UInt128, IAST, UInt128TrivialHash>;
+
+public:
+    explicit QueryASTCache(size_t max_entries)
+        : Base(max_entries) {}
+
+    /// Calculate key from the query text and settings that affect parsing.
+    static UInt128 hash(const char * begin, const char * end, const Settings & settings);
+
+    /// Returns a private copy of the cached AST, nullptr if there is no entry.
+    ASTPtr getAST(const UInt128 & key);
+
+    void setAST(const UInt128 & key, const ASTPtr & ast);
+};
+
+using QueryASTCachePtr = std::shared_ptr<QueryASTCache>;
+
+}
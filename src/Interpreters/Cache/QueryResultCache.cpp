@@ -115,13 +115,32 @@ ASTPtr removeQueryResultCacheSettings(ASTPtr ast)
     return transformed_ast;
 }
 
+/// Hash the settings the query runs with. Results produced with different settings (e.g. different "additional_table_filters") must map
+/// to different cache entries. Only changed settings contribute to the fingerprint - this keeps it stable across server versions which
+/// add new settings with default values. Settings which control the query result cache itself are skipped, in the same spirit as
+/// removeQueryResultCacheSettings() above.
+UInt64 calculateSettingsFingerprint(const Settings & settings)
+{
+    SipHash hash;
+    for (const auto & setting : settings.allChanged())
+    {
+        const auto & name = setting.getName();
+        if (name.starts_with("enable_experimental_query_result_cache") || name.starts_with("query_result_cache"))
+            continue;
+        hash.update(name);
+        hash.update(setting.getValueString());
+    }
+    return hash.get64();
+}
+
 }
 
 QueryResultCache::Key::Key(
-    ASTPtr ast_,
+    ASTPtr ast_, const Settings & settings,
     Block header_, const std::optional<String> & username_,
     std::chrono::time_point<std::chrono::system_clock> expires_at_)
     : ast(removeQueryResultCacheSettings(ast_))
+    , settings_fingerprint(calculateSettingsFingerprint(settings))
     , header(header_)
     , username(username_)
     , expires_at(expires_at_)
@@ -130,7 +149,8 @@ QueryResultCache::Key::Key(
 
 bool QueryResultCache::Key::operator==(const Key & other) const
 {
-    return ast->getTreeHash() == other.ast->getTreeHash();
+    return ast->getTreeHash() == other.ast->getTreeHash()
+        && settings_fingerprint == other.settings_fingerprint;
 }
 
 String QueryResultCache::Key::queryStringFromAst() const
@@ -146,6 +166,7 @@ size_t QueryResultCache::KeyHasher::operator()(const Key & key) const
 {
     SipHash hash;
     hash.update(key.ast->getTreeHash());
+    hash.update(key.settings_fingerprint);
     auto res = hash.get64();
     return res;
 }
@@ -169,12 +190,15 @@ auto is_stale = [](const QueryResultCache::Key & key)
 }
 
 QueryResultCache::Writer::Writer(std::mutex & mutex_, Cache & cache_, const Key & key_,
+    QueriesInFlight & queries_in_flight_, std::condition_variable & queries_in_flight_cv_,
     size_t & cache_size_in_bytes_, size_t max_cache_size_in_bytes_,
     size_t max_cache_entries_,
     size_t max_entry_size_in_bytes_, size_t max_entry_size_in_rows_,
     std::chrono::milliseconds min_query_runtime_)
     : mutex(mutex_)
     , cache(cache_)
+    , queries_in_flight(queries_in_flight_)
+    , queries_in_flight_cv(queries_in_flight_cv_)
     , key(key_)
     , cache_size_in_bytes(cache_size_in_bytes_)
     , max_cache_size_in_bytes(max_cache_size_in_bytes_)
@@ -185,6 +209,28 @@ QueryResultCache::Writer::Writer(std::mutex & mutex_, Cache & cache_, const Key
 {
     if (auto it = cache.find(key); it != cache.end() && !is_stale(it->first))
         skip_insert = true; /// Key already contained in cache and did not expire yet --> don't replace it
+    else
+    {
+        /// Announce that a result for the key is being computed so that identical queries can wait for it (see waitForQueryInFlight()).
+        ++queries_in_flight[key];
+        registered_in_flight = true;
+    }
+}
+
+QueryResultCache::Writer::~Writer()
+{
+    /// The destructor runs both for successful queries (shortly after finalizeWrite()) and for failed or cancelled queries (for which
+    /// finalizeWrite() is never called). Deregistering here (and not in finalizeWrite()) therefore guarantees that waiters always wake up,
+    /// even if the query threw an exception. Waiters which find no cache entry afterwards simply execute the query themselves.
+    if (!registered_in_flight)
+        return;
+
+    {
+        std::lock_guard lock(mutex);
+        if (auto it = queries_in_flight.find(key); it != queries_in_flight.end() && --it->second == 0)
+            queries_in_flight.erase(it);
+    }
+    queries_in_flight_cv.notify_all();
 }
 
 void QueryResultCache::Writer::buffer(Chunk && partial_query_result)
@@ -315,7 +361,19 @@ QueryResultCache::Reader QueryResultCache::createReader(const Key & key)
 QueryResultCache::Writer QueryResultCache::createWriter(const Key & key, std::chrono::milliseconds min_query_runtime)
 {
     std::lock_guard lock(mutex);
-    return Writer(mutex, cache, key, cache_size_in_bytes, max_cache_size_in_bytes, max_cache_entries, max_cache_entry_size_in_bytes, max_cache_entry_size_in_rows, min_query_runtime);
+    return Writer(mutex, cache, key, queries_in_flight, queries_in_flight_cv, cache_size_in_bytes, max_cache_size_in_bytes, max_cache_entries, max_cache_entry_size_in_bytes, max_cache_entry_size_in_rows, min_query_runtime);
+}
+
+bool QueryResultCache::waitForQueryInFlight(const Key & key, std::chrono::milliseconds timeout) TSA_NO_THREAD_SAFETY_ANALYSIS
+{
+    std::unique_lock lock(mutex);
+
+    if (!queries_in_flight.contains(key))
+        return false;
+
+    LOG_TRACE(&Poco::Logger::get("QueryResultCache"), "Waiting for a running identical query for query {}", key.queryStringFromAst());
+
+    return queries_in_flight_cv.wait_for(lock, timeout, [&] { return !queries_in_flight.contains(key); });
 }
 
 void QueryResultCache::reset()
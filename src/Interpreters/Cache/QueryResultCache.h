@@ -1,13 +1,18 @@
 #pragma once
 
 #include <Core/Block.h>
+#include <Core/Types.h>
 #include <Parsers/IAST_fwd.h>
 #include <Processors/Chunk.h>
 #include <QueryPipeline/Pipe.h>
 
+#include <condition_variable>
+
 namespace DB
 {
 
+struct Settings;
+
 /// Does AST contain non-deterministic functions like rand() and now()?
 bool astContainsNonDeterministicFunctions(ASTPtr ast, ContextPtr context);
 
@@ -30,9 +35,13 @@ public:
         /// Unlike the query string, the AST is agnostic to lower/upper case (SELECT vs. select)
         const ASTPtr ast;
 
-        /// Note: For a transactionally consistent cache, we would need to include the system settings in the cache key or invalidate the
-        /// cache whenever the settings change. This is because certain settings (e.g. "additional_table_filters") can affect the query
-        /// result.
+        /// Fingerprint of the settings the query ran with. Certain settings (e.g. "additional_table_filters") can affect the query
+        /// result, so results computed with different settings must not be mixed up. Settings which control the query result cache
+        /// itself are excluded from the fingerprint (see removeQueryResultCacheSettings() for the rationale).
+        const UInt64 settings_fingerprint;
+
+        /// Note: For a transactionally consistent cache, we would additionally need to invalidate the cache when data is inserted/deleted
+        /// into/from tables referenced by queries in the cache.
 
         /// ----------------------------------------------------
         /// Additional stuff data stored in the key, not hashed:
@@ -48,7 +57,7 @@ public:
         /// When does the entry expire?
         const std::chrono::time_point<std::chrono::system_clock> expires_at;
 
-        Key(ASTPtr ast_,
+        Key(ASTPtr ast_, const Settings & settings,
             Block header_, const std::optional<String> & username_,
             std::chrono::time_point<std::chrono::system_clock> expires_at_);
 
@@ -78,6 +87,9 @@ private:
     /// query --> query execution count
     using TimesExecuted = std::unordered_map<Key, size_t, KeyHasher>;
 
+    /// query --> number of queries currently computing a result for this key (see waitForQueryInFlight())
+    using QueriesInFlight = std::unordered_map<Key, size_t, KeyHasher>;
+
 public:
     /// Buffers multiple partial query result chunks (buffer()) and eventually stores them as cache entry (finalizeWrite()).
     ///
@@ -93,11 +105,14 @@ public:
     class Writer
     {
     public:
+        ~Writer(); /// deregisters the key from the in-flight queries (see waitForQueryInFlight())
         void buffer(Chunk && partial_query_result);
         void finalizeWrite();
     private:
         std::mutex & mutex;
         Cache & cache TSA_GUARDED_BY(mutex);
+        QueriesInFlight & queries_in_flight TSA_GUARDED_BY(mutex);
+        std::condition_variable & queries_in_flight_cv;
         const Key key;
         size_t & cache_size_in_bytes TSA_GUARDED_BY(mutex);
         const size_t max_cache_size_in_bytes;
@@ -110,8 +125,10 @@ public:
         const std::chrono::milliseconds min_query_runtime;
         QueryResult query_result;
         std::atomic<bool> skip_insert = false;
+        bool registered_in_flight = false;
 
         Writer(std::mutex & mutex_, Cache & cache_, const Key & key_,
+            QueriesInFlight & queries_in_flight_, std::condition_variable & queries_in_flight_cv_,
             size_t & cache_size_in_bytes_, size_t max_cache_size_in_bytes_,
             size_t max_cache_entries_,
             size_t max_entry_size_in_bytes_, size_t max_entry_size_in_rows_,
@@ -137,6 +154,12 @@ public:
     Reader createReader(const Key & key);
     Writer createWriter(const Key & key, std::chrono::milliseconds min_query_runtime);
 
+    /// If another query with the same key currently computes a result for the cache, wait (at most `timeout`) until it finishes. Returns
+    /// true if such a query was in flight and has finished, i.e. a new createReader() may find a fresh entry. Returns false immediately if
+    /// no identical query is in flight, or false after `timeout` if the in-flight query did not finish in time. Useful to coalesce bursts
+    /// of identical expensive queries (e.g. multiple users opening the same dashboard) into a single execution.
+    bool waitForQueryInFlight(const Key & key, std::chrono::milliseconds timeout);
+
     void reset();
 
     /// Record new execution of query represented by key. Returns number of executions so far.
@@ -153,6 +176,8 @@ private:
     mutable std::mutex mutex;
     Cache cache TSA_GUARDED_BY(mutex);
     TimesExecuted times_executed TSA_GUARDED_BY(mutex);
+    QueriesInFlight queries_in_flight TSA_GUARDED_BY(mutex);
+    std::condition_variable queries_in_flight_cv;
 
     size_t cache_size_in_bytes TSA_GUARDED_BY(mutex) = 0; /// updated in each cache insert/delete
     const size_t max_cache_size_in_bytes;
@@ -0,0 +1,171 @@
+#include <Interpreters/Cache/SLRUFileCachePriority.h>
+#include <Common/CurrentMetrics.h>
+
+namespace CurrentMetrics
+{
+    extern const Metric FilesystemCacheSize;
+    extern const Metric FilesystemCacheElements;
+}
+
+namespace DB
+{
+
+namespace ErrorCodes
+{
+    extern const int LOGICAL_ERROR;
+}
+
+IFileCachePriority::WriteIterator SLRUFileCachePriority::add(const Key & key, size_t offset, size_t size, std::lock_guard<std::mutex> &)
+{
+#ifndef NDEBUG
+    for (const auto * queue : {&probationary_queue, &protected_queue})
+    {
+        for (const auto & entry : *queue)
+        {
+            if (entry.key == key && entry.offset == offset)
+                throw Exception(
+                    ErrorCodes::LOGICAL_ERROR,
+                    "Attempt to add duplicate queue entry to queue. (Key: {}, offset: {}, size: {})",
+                    entry.key.toString(), entry.offset, entry.size);
+        }
+    }
+#endif
+
+    auto iter = probationary_queue.insert(probationary_queue.end(), FileCacheRecord(key, offset, size));
+    cache_size += size;
+
+    CurrentMetrics::add(CurrentMetrics::FilesystemCacheSize, size);
+    CurrentMetrics::add(CurrentMetrics::FilesystemCacheElements);
+
+    LOG_TRACE(log, "Added entry into probationary SLRU queue, key: {}, offset: {}", key.toString(), offset);
+
+    return std::make_shared<SLRUFileCacheIterator>(this, iter, false);
+}
+
+bool SLRUFileCachePriority::contains(const Key & key, size_t offset, std::lock_guard<std::mutex> &)
+{
+    for (const auto * queue : {&probationary_queue, &protected_queue})
+        for (const auto & record : *queue)
+            if (key == record.key && offset == record.offset)
+                return true;
+    return false;
+}
+
+void SLRUFileCachePriority::removeAll(std::lock_guard<std::mutex> &)
+{
+    CurrentMetrics::sub(CurrentMetrics::FilesystemCacheSize, cache_size);
+    CurrentMetrics::sub(CurrentMetrics::FilesystemCacheElements, probationary_queue.size() + protected_queue.size());
+
+    LOG_TRACE(log, "Removed all entries from SLRU queue");
+
+    probationary_queue.clear();
+    protected_queue.clear();
+    cache_size = 0;
+    protected_cache_size = 0;
+}
+
+void SLRUFileCachePriority::promote(LRUQueueIterator queue_iter)
+{
+    queue_iter->is_protected = true;
+    protected_cache_size += queue_iter->size;
+    protected_queue.splice(protected_queue.end(), probationary_queue, queue_iter);
+
+    /// Demote from the head of the protected queue until the promoted record fits.
+    /// The demoted records become the most recently used of the probationary queue.
+    while (protected_cache_size > max_protected_size && protected_queue.size() > 1)
+    {
+        auto demote_iter = protected_queue.begin();
+        demote_iter->is_protected = false;
+        protected_cache_size -= demote_iter->size;
+        probationary_queue.splice(probationary_queue.end(), protected_queue, demote_iter);
+    }
+}
+
+SLRUFileCachePriority::SLRUFileCacheIterator::SLRUFileCacheIterator(
+    SLRUFileCachePriority * cache_priority_, SLRUFileCachePriority::LRUQueueIterator queue_iter_, bool is_protected_)
+    : cache_priority(cache_priority_), queue_iter(queue_iter_), is_protected(is_protected_)
+{
+    if (!is_protected && queue_iter == cache_priority->probationary_queue.end())
+    {
+        is_protected = true;
+        queue_iter = cache_priority->protected_queue.begin();
+    }
+}
+
+void SLRUFileCachePriority::SLRUFileCacheIterator::next() const
+{
+    ++queue_iter;
+    if (!is_protected && queue_iter == cache_priority->probationary_queue.end())
+    {
+        is_protected = true;
+        queue_iter = cache_priority->protected_queue.begin();
+    }
+}
+
+IFileCachePriority::ReadIterator SLRUFileCachePriority::getLowestPriorityReadIterator(std::lock_guard<std::mutex> &)
+{
+    return std::make_unique<const SLRUFileCacheIterator>(this, probationary_queue.begin(), false);
+}
+
+IFileCachePriority::WriteIterator SLRUFileCachePriority::getLowestPriorityWriteIterator(std::lock_guard<std::mutex> &)
+{
+    return std::make_shared<SLRUFileCacheIterator>(this, probationary_queue.begin(), false);
+}
+
+size_t SLRUFileCachePriority::getElementsNum(std::lock_guard<std::mutex> &) const
+{
+    return probationary_queue.size() + protected_queue.size();
+}
+
+void SLRUFileCachePriority::SLRUFileCacheIterator::removeAndGetNext(std::lock_guard<std::mutex> &)
+{
+    is_protected = queue_iter->is_protected;
+
+    cache_priority->cache_size -= queue_iter->size;
+    if (is_protected)
+        cache_priority->protected_cache_size -= queue_iter->size;
+
+    CurrentMetrics::sub(CurrentMetrics::FilesystemCacheSize, queue_iter->size);
+    CurrentMetrics::sub(CurrentMetrics::FilesystemCacheElements);
+
+    LOG_TRACE(cache_priority->log, "Removed entry from SLRU queue, key: {}, offset: {}", queue_iter->key.toString(), queue_iter->offset);
+
+    auto & queue = is_protected ? cache_priority->protected_queue : cache_priority->probationary_queue;
+    queue_iter = queue.erase(queue_iter);
+
+    if (!is_protected && queue_iter == cache_priority->probationary_queue.end())
+    {
+        is_protected = true;
+        queue_iter = cache_priority->protected_queue.begin();
+    }
+}
+
+void SLRUFileCachePriority::SLRUFileCacheIterator::incrementSize(size_t size_increment, std::lock_guard<std::mutex> &)
+{
+    is_protected = queue_iter->is_protected;
+
+    cache_priority->cache_size += size_increment;
+    if (is_protected)
+        cache_priority->protected_cache_size += size_increment;
+
+    CurrentMetrics::add(CurrentMetrics::FilesystemCacheSize, size_increment);
+    queue_iter->size += size_increment;
+}
+
+void SLRUFileCachePriority::SLRUFileCacheIterator::use(std::lock_guard<std::mutex> &)
+{
+    queue_iter->hits++;
+    is_protected = queue_iter->is_protected;
+
+    if (is_protected)
+    {
+        cache_priority->protected_queue.splice(cache_priority->protected_queue.end(), cache_priority->protected_queue, queue_iter);
+    }
+    else
+    {
+        cache_priority->promote(queue_iter);
+        is_protected = true;
+    }
+}
+
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <list>
+#include <Interpreters/Cache/IFileCachePriority.h>
+#include <Common/logger_useful.h>
+
+namespace DB
+{
+
+/// Segmented LRU. The queue is split into a probationary and a protected part.
+/// A new record is added to the probationary part, and is moved to the protected part
+/// on the first reuse, so a one-shot scan over cold data cannot evict the records
+/// that were accessed more than once. When the protected part overflows, its least
+/// recently used records are demoted back to the probationary part.
+/// The records are evicted from the probationary part first.
+class SLRUFileCachePriority : public IFileCachePriority
+{
+private:
+    class SLRUFileCacheIterator;
+    using LRUQueue = std::list<FileCacheRecord>;
+    using LRUQueueIterator = typename LRUQueue::iterator;
+
+public:
+    explicit SLRUFileCachePriority(size_t max_protected_size_) : max_protected_size(max_protected_size_) { }
+
+    WriteIterator add(const Key & key, size_t offset, size_t size, std::lock_guard<std::mutex> &) override;
+
+    bool contains(const Key & key, size_t offset, std::lock_guard<std::mutex> &) override;
+
+    void removeAll(std::lock_guard<std::mutex> &) override;
+
+    ReadIterator getLowestPriorityReadIterator(std::lock_guard<std::mutex> &) override;
+
+    WriteIterator getLowestPriorityWriteIterator(std::lock_guard<std::mutex> &) override;
+
+    size_t getElementsNum(std::lock_guard<std::mutex> &) const override;
+
+private:
+    /// Moves a probationary record to the protected queue, demoting the least recently
+    /// used protected records to the probationary queue if it does not fit.
+    void promote(LRUQueueIterator queue_iter);
+
+    LRUQueue probationary_queue;
+    LRUQueue protected_queue;
+
+    const size_t max_protected_size;
+    size_t protected_cache_size = 0;
+
+    Poco::Logger * log = &Poco::Logger::get("SLRUFileCachePriority");
+};
+
+class SLRUFileCachePriority::SLRUFileCacheIterator : public IFileCachePriority::IIterator
+{
+public:
+    SLRUFileCacheIterator(SLRUFileCachePriority * cache_priority_, SLRUFileCachePriority::LRUQueueIterator queue_iter_, bool is_protected_);
+
+    void next() const override;
+
+    bool valid() const override { return !is_protected || queue_iter != cache_priority->protected_queue.end(); }
+
+    const Key & key() const override { return queue_iter->key; }
+
+    size_t offset() const override { return queue_iter->offset; }
+
+    size_t size() const override { return queue_iter->size; }
+
+    size_t hits() const override { return queue_iter->hits; }
+
+    void removeAndGetNext(std::lock_guard<std::mutex> &) override;
+
+    void incrementSize(size_t, std::lock_guard<std::mutex> &) override;
+
+    void use(std::lock_guard<std::mutex> &) override;
+
+private:
+    SLRUFileCachePriority * cache_priority;
+    mutable SLRUFileCachePriority::LRUQueueIterator queue_iter;
+
+    /// Which of the two queues the iterator points into. The record may be moved
+    /// to the other queue after the iterator was created, so the methods that
+    /// dereference the record resynchronize this flag from it.
+    mutable bool is_protected;
+};
+
+};
@@ -16,9 +16,16 @@
 #include <Parsers/IAST_fwd.h>
 #include <Parsers/parseQuery.h>
 #include <Common/Exception.h>
+#include <Common/ProfileEvents.h>
 #include <Common/WeakHash.h>
+#include <Common/thread_local_rng.h>
 #include <Common/typeid_cast.h>
 
+namespace ProfileEvents
+{
+    extern const Event JoinProbeRowsPrunedByRuntimeFilter;
+}
+
 namespace DB
 {
 
@@ -35,6 +42,20 @@ static UInt32 toPowerOfTwo(UInt32 x)
     return static_cast<UInt32>(1) << (32 - std::countl_zero(x - 1));
 }
 
+static WeakHash32 calculateWeakHash(const Strings & key_columns_names, const Block & from_block)
+{
+    size_t num_rows = from_block.rows();
+
+    WeakHash32 hash(num_rows);
+    for (const auto & key_name : key_columns_names)
+    {
+        const auto & key_col = from_block.getByName(key_name).column->convertToFullColumnIfConst();
+        const auto & key_col_no_lc = recursiveRemoveLowCardinality(recursiveRemoveSparse(key_col));
+        key_col_no_lc->updateWeakHash32(hash);
+    }
+    return hash;
+}
+
 ConcurrentHashJoin::ConcurrentHashJoin(ContextPtr context_, std::shared_ptr<TableJoin> table_join_, size_t slots_, const Block & right_sample_block, bool any_take_last_row_)
     : context(context_)
     , table_join(table_join_)
@@ -46,11 +67,39 @@ ConcurrentHashJoin::ConcurrentHashJoin(ContextPtr context_, std::shared_ptr<Tabl
         inner_hash_join->data = std::make_unique<HashJoin>(table_join_, right_sample_block, any_take_last_row_);
         hash_joins.emplace_back(std::move(inner_hash_join));
     }
+
+    if (size_t filter_bytes = context->getSettingsRef().join_runtime_bloom_filter_bytes;
+        filter_bytes && isInner(table_join->kind()) && table_join->oneDisjunct())
+    {
+        /// Round down to whole cache-line-sized blocks, see addBlockToRuntimeFilter().
+        runtime_filter_words = std::max<size_t>(runtime_filter_words_per_block,
+            filter_bytes / sizeof(UInt64) / runtime_filter_words_per_block * runtime_filter_words_per_block);
+        runtime_filter = std::make_unique<std::atomic<UInt64>[]>(runtime_filter_words); /// value-initialized to zero
+    }
 }
 
 bool ConcurrentHashJoin::addJoinedBlock(const Block & right_block, bool check_limits)
 {
-    Blocks dispatched_blocks = dispatchBlock(table_join->getOnlyClause().key_names_right, right_block);
+    std::optional<WeakHash32> hash;
+    if (useRuntimeFilter() || hash_joins.size() > 1)
+        hash = calculateWeakHash(table_join->getOnlyClause().key_names_right, right_block);
+
+    if (useRuntimeFilter())
+        addBlockToRuntimeFilter(*hash);
+
+    if (hash_joins.size() == 1)
+    {
+        /// With a single shard there is nothing to dispatch, skip scattering of the block.
+        std::lock_guard lock(hash_joins[0]->mutex);
+        if (!hash_joins[0]->data->addJoinedBlock(right_block, check_limits))
+            return false;
+
+        if (check_limits)
+            return table_join->sizeLimits().check(getTotalRowCount(), getTotalByteCount(), "JOIN", ErrorCodes::SET_SIZE_LIMIT_EXCEEDED);
+        return true;
+    }
+
+    Blocks dispatched_blocks = dispatchBlock(*hash, right_block);
 
     size_t blocks_left = 0;
     for (const auto & block : dispatched_blocks)
@@ -61,11 +110,17 @@ bool ConcurrentHashJoin::addJoinedBlock(const Block & right_block, bool check_li
         }
     }
 
+    /// Start from a random shard. If all builder threads iterate the shards in the same order, they queue up on the
+    /// same mutexes and proceed in lockstep, which wastes the try-lock passes below. A per-call random offset spreads
+    /// concurrent builders across the shards.
+    const size_t shift = thread_local_rng() % dispatched_blocks.size();
+
     while (blocks_left > 0)
     {
         /// insert blocks into corresponding HashJoin instances
-        for (size_t i = 0; i < dispatched_blocks.size(); ++i)
+        for (size_t idx = 0; idx < dispatched_blocks.size(); ++idx)
         {
+            size_t i = (idx + shift) % dispatched_blocks.size();
             auto & hash_join = hash_joins[i];
             auto & dispatched_block = dispatched_blocks[i];
 
@@ -94,7 +149,25 @@ bool ConcurrentHashJoin::addJoinedBlock(const Block & right_block, bool check_li
 
 void ConcurrentHashJoin::joinBlock(Block & block, std::shared_ptr<ExtraBlock> & /*not_processed*/)
 {
-    Blocks dispatched_blocks = dispatchBlock(table_join->getOnlyClause().key_names_left, block);
+    std::optional<WeakHash32> hash;
+    if (useRuntimeFilter() || hash_joins.size() > 1)
+        hash = calculateWeakHash(table_join->getOnlyClause().key_names_left, block);
+
+    /// Discard probe rows whose keys are certainly absent on the build side. For selective joins (e.g. a fact
+    /// table joined against a filtered dimension) this saves scattering the rows and looking them up.
+    if (useRuntimeFilter())
+        pruneBlockByRuntimeFilter(block, *hash);
+
+    if (hash_joins.size() == 1)
+    {
+        std::shared_ptr<ExtraBlock> none_extra_block;
+        hash_joins[0]->data->joinBlock(block, none_extra_block);
+        if (none_extra_block && !none_extra_block->empty())
+            throw Exception(ErrorCodes::LOGICAL_ERROR, "not_processed should be empty");
+        return;
+    }
+
+    Blocks dispatched_blocks = dispatchBlock(*hash, block);
     block = {};
     for (size_t i = 0; i < dispatched_blocks.size(); ++i)
     {
@@ -185,28 +258,70 @@ static ALWAYS_INLINE IColumn::Selector hashToSelector(const WeakHash32 & hash, s
     return selector;
 }
 
-IColumn::Selector ConcurrentHashJoin::selectDispatchBlock(const Strings & key_columns_names, const Block & from_block)
+/// Multiplicative salts of the split-block Bloom filter: they spread the per-word bit choices
+/// of the keys which fall into the same block. The same derivation is used on build and probe side.
+static constexpr UInt32 runtime_filter_salts[8]
+    = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+void ConcurrentHashJoin::addBlockToRuntimeFilter(const WeakHash32 & hash)
 {
-    size_t num_rows = from_block.rows();
-    size_t num_shards = hash_joins.size();
+    const size_t num_blocks = runtime_filter_words / runtime_filter_words_per_block;
+    for (const auto & row_hash : hash.getData())
+    {
+        /// Apply intHash64 to mix bits: the high half selects the block, the low half selects
+        /// one bit in every word of the block, so a key touches a single cache line.
+        UInt64 h = intHash64(row_hash);
+        size_t block_begin = (h >> 32) % num_blocks * runtime_filter_words_per_block;
+        UInt32 h32 = static_cast<UInt32>(h);
+        for (size_t i = 0; i < runtime_filter_words_per_block; ++i)
+            runtime_filter[block_begin + i].fetch_or(1ULL << (h32 * runtime_filter_salts[i] >> 26), std::memory_order_relaxed);
+    }
+}
 
-    WeakHash32 hash(num_rows);
-    for (const auto & key_name : key_columns_names)
+void ConcurrentHashJoin::pruneBlockByRuntimeFilter(Block & block, WeakHash32 & hash) const
+{
+    const size_t num_blocks = runtime_filter_words / runtime_filter_words_per_block;
+    auto & hash_data = hash.getData();
+    size_t num_rows = hash_data.size();
+
+    IColumn::Filter mask(num_rows);
+    size_t num_kept = 0;
+    for (size_t i = 0; i < num_rows; ++i)
     {
-        const auto & key_col = from_block.getByName(key_name).column->convertToFullColumnIfConst();
-        const auto & key_col_no_lc = recursiveRemoveLowCardinality(recursiveRemoveSparse(key_col));
-        key_col_no_lc->updateWeakHash32(hash);
+        UInt64 h = intHash64(hash_data[i]);
+        size_t block_begin = (h >> 32) % num_blocks * runtime_filter_words_per_block;
+        UInt32 h32 = static_cast<UInt32>(h);
+        bool keep = true;
+        for (size_t word = 0; word < runtime_filter_words_per_block; ++word)
+            keep &= (runtime_filter[block_begin + word].load(std::memory_order_relaxed)
+                & (1ULL << (h32 * runtime_filter_salts[word] >> 26))) != 0;
+        mask[i] = keep;
+        num_kept += keep;
     }
-    return hashToSelector(hash, num_shards);
+
+    if (num_kept == num_rows)
+        return;
+
+    ProfileEvents::increment(ProfileEvents::JoinProbeRowsPrunedByRuntimeFilter, num_rows - num_kept);
+
+    for (auto & column : block)
+        column.column = column.column->filter(mask, num_kept);
+
+    /// Keep the hash in sync with the block, it is used for dispatching below.
+    size_t next = 0;
+    for (size_t i = 0; i < num_rows; ++i)
+        if (mask[i])
+            hash_data[next++] = hash_data[i];
+    hash_data.resize(num_kept);
 }
 
-Blocks ConcurrentHashJoin::dispatchBlock(const Strings & key_columns_names, const Block & from_block)
+Blocks ConcurrentHashJoin::dispatchBlock(const WeakHash32 & hash, const Block & from_block)
 {
     /// TODO: use JoinCommon::scatterBlockByHash
     size_t num_shards = hash_joins.size();
     size_t num_cols = from_block.columns();
 
-    IColumn::Selector selector = selectDispatchBlock(key_columns_names, from_block);
+    IColumn::Selector selector = hashToSelector(hash, num_shards);
 
     Blocks result(num_shards);
     for (size_t i = 0; i < num_shards; ++i)
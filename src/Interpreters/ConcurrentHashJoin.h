@@ -12,6 +12,7 @@
 #include <base/defines.h>
 #include <base/types.h>
 #include <Common/Stopwatch.h>
+#include <Common/WeakHash.h>
 
 namespace DB
 {
@@ -62,11 +63,24 @@ private:
     size_t slots;
     std::vector<std::shared_ptr<InternalHashJoin>> hash_joins;
 
+    /// Runtime Bloom filter over the right-side join keys, see setting 'join_runtime_bloom_filter_bytes'.
+    /// Filled lock-free in addJoinedBlock() and probed in joinBlock() to discard left-side rows which cannot
+    /// have a match before they are hashed, scattered and looked up in the per-shard hash tables.
+    /// Only used for INNER JOIN where dropping non-matching probe rows does not change the result.
+    /// Split-block layout: every key maps to a single cache-line-sized block of words and to one bit
+    /// in each word of the block, so filling and probing cost one cache miss per key.
+    static constexpr size_t runtime_filter_words_per_block = 8; /// 64 bytes, one cache line.
+    std::unique_ptr<std::atomic<UInt64>[]> runtime_filter;
+    size_t runtime_filter_words = 0;
+
     std::mutex totals_mutex;
     Block totals;
 
-    IColumn::Selector selectDispatchBlock(const Strings & key_columns_names, const Block & from_block);
-    Blocks dispatchBlock(const Strings & key_columns_names, const Block & from_block);
+    bool useRuntimeFilter() const { return runtime_filter != nullptr; }
+    void addBlockToRuntimeFilter(const WeakHash32 & hash);
+    void pruneBlockByRuntimeFilter(Block & block, WeakHash32 & hash) const;
+
+    Blocks dispatchBlock(const WeakHash32 & hash, const Block & from_block);
 
 };
 
@@ -23,6 +23,8 @@
 #include <Databases/IDatabase.h>
 #include <Storages/IStorage.h>
 #include <Storages/MarkCache.h>
+#include <Storages/ColumnsCache.h>
+#include <Storages/QueryConditionCache.h>
 #include <Storages/MergeTree/MergeList.h>
 #include <Storages/MergeTree/MovesList.h>
 #include <Storages/MergeTree/ReplicatedFetchList.h>
@@ -34,6 +36,7 @@
 #include <Disks/ObjectStorages/DiskObjectStorage.h>
 #include <Disks/ObjectStorages/IObjectStorage.h>
 #include <Disks/IO/ThreadPoolRemoteFSReader.h>
+#include <Disks/IO/IOUringReader.h>
 #include <Disks/IO/ThreadPoolReader.h>
 #include <IO/SynchronousReader.h>
 #include <TableFunctions/TableFunctionFactory.h>
@@ -41,6 +44,7 @@
 #include <Interpreters/ExternalLoaderXMLConfigRepository.h>
 #include <Interpreters/TemporaryDataOnDisk.h>
 #include <Interpreters/Cache/QueryResultCache.h>
+#include <Interpreters/Cache/QueryASTCache.h>
 #include <Core/Settings.h>
 #include <Core/SettingsQuirks.h>
 #include <Access/AccessControl.h>
@@ -154,6 +158,7 @@ namespace ErrorCodes
     extern const int LOGICAL_ERROR;
     extern const int INVALID_SETTING_VALUE;
     extern const int UNKNOWN_READ_METHOD;
+    extern const int UNSUPPORTED_METHOD;
     extern const int NOT_IMPLEMENTED;
     extern const int UNKNOWN_FUNCTION;
 }
@@ -234,9 +239,12 @@ struct ContextSharedPart : boost::noncopyable
     mutable UncompressedCachePtr uncompressed_cache;        /// The cache of decompressed blocks.
     mutable MarkCachePtr mark_cache;                        /// Cache of marks in compressed files.
     mutable std::unique_ptr<ThreadPool> load_marks_threadpool; /// Threadpool for loading marks cache.
+    mutable ColumnsCachePtr columns_cache;                  /// Cache of deserialized columns of MergeTree parts.
+    mutable QueryConditionCachePtr query_condition_cache;   /// Cache of filter condition results at granule granularity.
     mutable UncompressedCachePtr index_uncompressed_cache;  /// The cache of decompressed blocks for MergeTree indices.
     mutable MarkCachePtr index_mark_cache;                  /// Cache of marks in compressed files of MergeTree indices.
     mutable QueryResultCachePtr query_result_cache;         /// Cache of query results.
+    mutable QueryASTCachePtr query_ast_cache;               /// Cache of parsed query ASTs.
     mutable MMappedFileCachePtr mmap_cache; /// Cache of mmapped files to avoid frequent open/map/unmap/close and to reuse from several threads.
     ProcessList process_list;                               /// Executing queries at the moment.
     GlobalOvercommitTracker global_overcommit_tracker;
@@ -255,6 +263,10 @@ struct ContextSharedPart : boost::noncopyable
     mutable std::unique_ptr<IAsynchronousReader> asynchronous_local_fs_reader;
     mutable std::unique_ptr<IAsynchronousReader> synchronous_local_fs_reader;
 
+#if defined(OS_LINUX)
+    mutable std::unique_ptr<IAsynchronousReader> io_uring_reader;
+#endif
+
     mutable std::unique_ptr<ThreadPool> threadpool_writer;
 
     mutable ThrottlerPtr replicated_fetches_throttler;      /// A server-wide throttler for replicated fetches
@@ -729,6 +741,12 @@ TemporaryDataOnDiskScopePtr Context::getTempDataOnDisk() const
     return shared->temp_data_on_disk;
 }
 
+TemporaryDataOnDiskScopePtr Context::getOwnTempDataOnDisk() const
+{
+    auto lock = getLock();
+    return this->temp_data_on_disk;
+}
+
 void Context::setTempDataOnDisk(TemporaryDataOnDiskScopePtr temp_data_on_disk_)
 {
     auto lock = getLock();
@@ -1254,6 +1272,30 @@ void Context::addSpecialScalar(const String & name, const Block & block)
 }
 
 
+StorageSnapshotPtr Context::tryGetPinnedStorageSnapshot(const StorageID & table_id) const
+{
+    if (isGlobalContext())
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Global context cannot have pinned storage snapshots");
+
+    auto lock = getLock();
+    auto it = pinned_storage_snapshots.find(table_id.getFullTableName());
+    if (it == pinned_storage_snapshots.end())
+        return nullptr;
+    return it->second;
+}
+
+
+void Context::pinStorageSnapshot(const StorageID & table_id, const StorageSnapshotPtr & snapshot)
+{
+    if (isGlobalContext())
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Global context cannot have pinned storage snapshots");
+
+    auto lock = getLock();
+    /// The snapshot taken at the first reference to the table wins.
+    pinned_storage_snapshots.emplace(table_id.getFullTableName(), snapshot);
+}
+
+
 bool Context::hasScalar(const String & name) const
 {
     if (isGlobalContext())
@@ -1978,6 +2020,52 @@ void Context::dropMarkCache() const
         shared->mark_cache->reset();
 }
 
+void Context::setColumnsCache(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    if (shared->columns_cache)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Columns cache has been already created.");
+
+    shared->columns_cache = std::make_shared<ColumnsCache>(cache_size_in_bytes);
+}
+
+ColumnsCachePtr Context::getColumnsCache() const
+{
+    auto lock = getLock();
+    return shared->columns_cache;
+}
+
+void Context::dropColumnsCache() const
+{
+    auto lock = getLock();
+    if (shared->columns_cache)
+        shared->columns_cache->reset();
+}
+
+void Context::setQueryConditionCache(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    if (shared->query_condition_cache)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Query condition cache has been already created.");
+
+    shared->query_condition_cache = std::make_shared<QueryConditionCache>(cache_size_in_bytes);
+}
+
+QueryConditionCachePtr Context::getQueryConditionCache() const
+{
+    auto lock = getLock();
+    return shared->query_condition_cache;
+}
+
+void Context::dropQueryConditionCache() const
+{
+    auto lock = getLock();
+    if (shared->query_condition_cache)
+        shared->query_condition_cache->reset();
+}
+
 ThreadPool & Context::getLoadMarksThreadpool() const
 {
     const auto & config = getConfigRef();
@@ -2064,6 +2152,29 @@ void Context::dropQueryResultCache() const
         shared->query_result_cache->reset();
 }
 
+void Context::setQueryASTCache(size_t max_entries)
+{
+    auto lock = getLock();
+
+    if (shared->query_ast_cache)
+        throw Exception("Query AST cache has been already created.", ErrorCodes::LOGICAL_ERROR);
+
+    shared->query_ast_cache = std::make_shared<QueryASTCache>(max_entries);
+}
+
+QueryASTCachePtr Context::getQueryASTCache() const
+{
+    auto lock = getLock();
+    return shared->query_ast_cache;
+}
+
+void Context::dropQueryASTCache() const
+{
+    auto lock = getLock();
+    if (shared->query_ast_cache)
+        shared->query_ast_cache->reset();
+}
+
 void Context::setMMappedFileCache(size_t cache_size_in_num_entries)
 {
     auto lock = getLock();
@@ -2098,6 +2209,12 @@ void Context::dropCaches() const
     if (shared->mark_cache)
         shared->mark_cache->reset();
 
+    if (shared->columns_cache)
+        shared->columns_cache->reset();
+
+    if (shared->query_condition_cache)
+        shared->query_condition_cache->reset();
+
     if (shared->index_uncompressed_cache)
         shared->index_uncompressed_cache->reset();
 
@@ -2107,6 +2224,9 @@ void Context::dropCaches() const
     if (shared->query_result_cache)
         shared->query_result_cache->reset();
 
+    if (shared->query_ast_cache)
+        shared->query_ast_cache->reset();
+
     if (shared->mmap_cache)
         shared->mmap_cache->reset();
 }
@@ -3794,6 +3914,28 @@ IAsynchronousReader & Context::getThreadPoolReader(FilesystemReaderType type) co
     }
 }
 
+IAsynchronousReader & Context::getIOUringReader() const
+{
+#if defined(OS_LINUX)
+    const auto & config = getConfigRef();
+
+    auto lock = getLock();
+
+    if (!shared->io_uring_reader)
+    {
+        if (!IOUringReader::isSupported())
+            throw Exception(ErrorCodes::UNSUPPORTED_METHOD, "io_uring is not supported by this kernel");
+
+        auto entries = config.getUInt(".io_uring_queue_entries", 512);
+        shared->io_uring_reader = std::make_unique<IOUringReader>(entries);
+    }
+
+    return *shared->io_uring_reader;
+#else
+    throw Exception(ErrorCodes::UNSUPPORTED_METHOD, "io_uring is only supported on Linux");
+#endif
+}
+
 ThreadPool & Context::getThreadPoolWriter() const
 {
     const auto & config = getConfigRef();
@@ -3834,6 +3976,8 @@ ReadSettings Context::getReadSettings() const
 
     res.load_marks_asynchronously = settings.load_marks_asynchronously;
 
+    res.load_marks_with_mmap = settings.load_marks_with_mmap;
+
     res.remote_fs_read_max_backoff_ms = settings.remote_fs_read_max_backoff_ms;
     res.remote_fs_read_backoff_max_tries = settings.remote_fs_read_backoff_max_tries;
     res.enable_filesystem_cache = settings.enable_filesystem_cache;
@@ -72,6 +72,8 @@ class ReplicatedFetchList;
 class Cluster;
 class Compiler;
 class MarkCache;
+class ColumnsCache;
+class QueryConditionCache;
 class MMappedFileCache;
 class UncompressedCache;
 class ProcessList;
@@ -83,6 +85,7 @@ struct FileProgress;
 class Clusters;
 class QueryLog;
 class QueryResultCache;
+class QueryASTCache;
 class QueryThreadLog;
 class QueryViewsLog;
 class PartLog;
@@ -115,6 +118,8 @@ struct SettingsConstraintsAndProfileIDs;
 class SettingsProfileElements;
 class RemoteHostFilter;
 struct StorageID;
+struct StorageSnapshot;
+using StorageSnapshotPtr = std::shared_ptr<StorageSnapshot>;
 class IDisk;
 using DiskPtr = std::shared_ptr<IDisk>;
 class DiskSelector;
@@ -256,6 +261,11 @@ private:
     /// Used to store constant values which are different on each instance during distributed plan, such as _shard_num.
     Scalars special_scalars;
 
+    /// Storage snapshots pinned for the duration of the query (see setting 'pin_storage_snapshots'),
+    /// so that all the references to one table across the query see the same state of the data.
+    /// Used on the query context only.
+    std::unordered_map<String, StorageSnapshotPtr> pinned_storage_snapshots;
+
     /// Used in s3Cluster table function. With this callback, a worker node could ask an initiator
     /// about next file to read from s3.
     std::optional<ReadTaskCallback> next_task_callback;
@@ -455,6 +465,9 @@ public:
     VolumePtr getTemporaryVolume() const; /// TODO: remove, use `getTempDataOnDisk`
 
     TemporaryDataOnDiskScopePtr getTempDataOnDisk() const;
+    /// Returns the scope of this context only, without falling back to the global one.
+    /// Used to report per-query usage of temporary disk space.
+    TemporaryDataOnDiskScopePtr getOwnTempDataOnDisk() const;
     void setTempDataOnDisk(TemporaryDataOnDiskScopePtr temp_data_on_disk_);
 
     void setPath(const String & path);
@@ -591,6 +604,11 @@ public:
     const Block * tryGetSpecialScalar(const String & name) const;
     void addSpecialScalar(const String & name, const Block & block);
 
+    /// A snapshot of a table pinned for the duration of the query (see setting 'pin_storage_snapshots').
+    /// Both methods must be called on the query context.
+    StorageSnapshotPtr tryGetPinnedStorageSnapshot(const StorageID & table_id) const;
+    void pinStorageSnapshot(const StorageID & table_id, const StorageSnapshotPtr & snapshot);
+
     const QueryAccessInfo & getQueryAccessInfo() const { return query_access_info; }
     void addQueryAccessInfo(
         const String & quoted_database_name,
@@ -845,6 +863,16 @@ public:
     void dropMarkCache() const;
     ThreadPool & getLoadMarksThreadpool() const;
 
+    /// Create a cache of deserialized columns of specified size. This can be done only once.
+    void setColumnsCache(size_t cache_size_in_bytes);
+    std::shared_ptr<ColumnsCache> getColumnsCache() const;
+    void dropColumnsCache() const;
+
+    /// Create a cache of filter condition results at granule granularity. This can be done only once.
+    void setQueryConditionCache(size_t cache_size_in_bytes);
+    std::shared_ptr<QueryConditionCache> getQueryConditionCache() const;
+    void dropQueryConditionCache() const;
+
     /// Create a cache of index uncompressed blocks of specified size. This can be done only once.
     void setIndexUncompressedCache(size_t max_size_in_bytes);
     std::shared_ptr<UncompressedCache> getIndexUncompressedCache() const;
@@ -865,6 +893,11 @@ public:
     std::shared_ptr<QueryResultCache> getQueryResultCache() const;
     void dropQueryResultCache() const;
 
+    /// Create a cache of parsed query ASTs for statements which run repeatedly.
+    void setQueryASTCache(size_t max_entries);
+    std::shared_ptr<QueryASTCache> getQueryASTCache() const;
+    void dropQueryASTCache() const;
+
     /** Clear the caches of the uncompressed blocks and marks.
       * This is usually done when renaming tables, changing the type of columns, deleting a table.
       *  - since caches are linked to file names, and become incorrect.
@@ -1063,6 +1096,9 @@ public:
 
     IAsynchronousReader & getThreadPoolReader(FilesystemReaderType type) const;
 
+    /// Lazily created reader backed by the Linux io_uring subsystem. Throws on other platforms and on kernels without io_uring support.
+    IAsynchronousReader & getIOUringReader() const;
+
     ThreadPool & getThreadPoolWriter() const;
 
     /** Get settings for reading from filesystem. */
@@ -28,9 +28,10 @@ void ConvertFunctionOrLikeData::visit(ASTFunction & function, ASTPtr &)
                 {
                     const bool is_like = child_fn->name == "like";
                     const bool is_ilike = child_fn->name == "ilike";
+                    const bool is_match = child_fn->name == "match";
 
-                    /// Not {i}like -> bail out.
-                    if (!is_like && !is_ilike)
+                    /// Not {i}like/match -> bail out.
+                    if (!is_like && !is_ilike && !is_match)
                         continue;
 
                     const auto & arguments = child_fn->arguments->children;
@@ -45,7 +46,9 @@ void ConvertFunctionOrLikeData::visit(ASTFunction & function, ASTPtr &)
                     if (!identifier || !literal || literal->value.getType() != Field::Types::String)
                         continue;
 
-                    String regexp = likePatternToRegexp(literal->value.get<String>());
+                    /// `match` takes a ready regexp with the same unanchored semantics as multiMatchAny.
+                    String regexp = is_match ? literal->value.get<String>()
+                                             : likePatternToRegexp(literal->value.get<String>());
                     /// Case insensitive. Works with UTF-8 as well.
                     if (is_ilike)
                         regexp = "(?i)" + regexp;
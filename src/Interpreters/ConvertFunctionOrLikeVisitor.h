@@ -8,7 +8,7 @@ namespace DB
 
 class ASTFunction;
 
-/// Replaces all the "or"'s with {i}like to multiMatchAny
+/// Replaces all the "or"'s with {i}like/match to multiMatchAny
 class ConvertFunctionOrLikeData
 {
 public:
@@ -54,6 +54,9 @@ ExpressionActions::ExpressionActions(ActionsDAGPtr actions_dag_, const Expressio
 {
     actions_dag = actions_dag_->clone();
 
+    if (settings.eliminate_common_subexpressions)
+        actions_dag->eliminateCommonSubexpressions();
+
     /// It's important to determine lazy executed nodes before compiling expressions.
     std::unordered_set<const ActionsDAG::Node *> lazy_executed_nodes = processShortCircuitFunctions(*actions_dag, settings.short_circuit_function_evaluation);
 
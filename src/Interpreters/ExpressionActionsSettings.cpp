@@ -11,6 +11,7 @@ ExpressionActionsSettings ExpressionActionsSettings::fromSettings(const Settings
     ExpressionActionsSettings settings;
     settings.can_compile_expressions = from.compile_expressions;
     settings.min_count_to_compile_expression = from.min_count_to_compile_expression;
+    settings.eliminate_common_subexpressions = from.eliminate_common_subexpressions;
     settings.max_temporary_columns = from.max_temporary_columns;
     settings.max_temporary_non_const_columns = from.max_temporary_non_const_columns;
     settings.compile_expressions = compile_expressions;
@@ -21,6 +21,8 @@ struct ExpressionActionsSettings
     bool can_compile_expressions = false;
     size_t min_count_to_compile_expression = 0;
 
+    bool eliminate_common_subexpressions = true;
+
     size_t max_temporary_columns = 0;
     size_t max_temporary_non_const_columns = 0;
 
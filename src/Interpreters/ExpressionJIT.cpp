@@ -417,7 +417,9 @@ static CompileDAG getCompilableDAG(
 
         while (frame.next_child_to_visit < node->children.size())
         {
-            const auto & child = node->children[frame.next_child_to_visit];
+            /// Look through aliases, so that a chain of compilable functions
+            /// does not break at the boundaries of ExpressionActions steps.
+            const auto * child = removeAliasIfNecessary(node->children[frame.next_child_to_visit]);
 
             if (visited_node_to_compile_dag_position.contains(child))
             {
@@ -442,7 +444,7 @@ static CompileDAG getCompilableDAG(
         compile_node.type = CompileDAG::CompileType::FUNCTION;
 
         for (const auto * child : node->children)
-            compile_node.arguments.push_back(visited_node_to_compile_dag_position[child]);
+            compile_node.arguments.push_back(visited_node_to_compile_dag_position[removeAliasIfNecessary(child)]);
 
         visited_node_to_compile_dag_position[node] = dag.getNodesCount();
 
@@ -500,7 +502,7 @@ void ActionsDAG::compileFunctions(size_t min_count_to_compile_expression, const
 
             while (current_frame.next_child_to_visit < current_node->children.size())
             {
-                const auto & child = node.children[current_frame.next_child_to_visit];
+                const auto & child = current_node->children[current_frame.next_child_to_visit];
 
                 if (visited_nodes.contains(child))
                 {
@@ -521,8 +523,12 @@ void ActionsDAG::compileFunctions(size_t min_count_to_compile_expression, const
 
             if (current_node_data.is_compilable_in_isolation)
             {
-                for (const auto * child : current_node->children)
+                /// Aliases are transparent for compilation: they are how subexpression results cross
+                /// ExpressionActions steps, and treating them as barriers would split an otherwise
+                /// compilable chain of functions into separately compiled fragments.
+                for (const auto * child_with_alias : current_node->children)
                 {
+                    const auto * child = removeAliasIfNecessary(child_with_alias);
                     auto & child_data = node_to_data[child];
 
                     if (child_data.is_compilable_in_isolation)
@@ -544,17 +550,22 @@ void ActionsDAG::compileFunctions(size_t min_count_to_compile_expression, const
 
     for (const auto & node : nodes)
     {
+        /// An alias does not hide its child from the compilable parents of the alias,
+        /// so it must not mark the child as having a non-compilable parent.
+        if (node.type == ActionsDAG::ActionType::ALIAS)
+            continue;
+
         auto & node_data = node_to_data[&node];
         bool node_is_valid_for_compilation = node_data.is_compilable_in_isolation && node_data.compilable_children_size > 0;
 
         for (const auto & child : node.children)
-            node_to_data[child].all_parents_compilable &= node_is_valid_for_compilation;
+            node_to_data[removeAliasIfNecessary(child)].all_parents_compilable &= node_is_valid_for_compilation;
     }
 
     for (const auto & output_node : outputs)
     {
         /// Force output nodes to compile
-        node_to_data[output_node].all_parents_compilable = false;
+        node_to_data[removeAliasIfNecessary(output_node)].all_parents_compilable = false;
     }
 
     std::vector<Node *> nodes_to_compile;
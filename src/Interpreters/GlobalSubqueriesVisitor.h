@@ -13,6 +13,7 @@
 #include <Parsers/ASTIdentifier.h>
 #include <Parsers/ASTLiteral.h>
 #include <Parsers/ASTSelectQuery.h>
+#include <Parsers/ASTSelectWithUnionQuery.h>
 #include <Parsers/ASTSubquery.h>
 #include <Parsers/ASTTablesInSelectQuery.h>
 #include <Parsers/IAST.h>
@@ -62,7 +63,7 @@ public:
         {
         }
 
-        void addExternalStorage(ASTPtr & ast, bool set_alias = false)
+        void addExternalStorage(ASTPtr & ast, bool set_alias = false, bool deduplicate_for_in = false)
         {
             /// With nondistributed queries, creating temporary tables does not make sense.
             if (!is_remote)
@@ -106,6 +107,18 @@ public:
             }
 
             String alias = subquery_or_table_name->tryGetAlias();
+
+            /// The IN set depends only on distinct values, so ship deduplicated data to remote servers.
+            /// Applied before the table name is derived from the tree hash, so a use of the same
+            /// subquery where duplicates matter (e.g. GLOBAL JOIN) gets its own external table.
+            if (deduplicate_for_in && !is_table && alias.empty()
+                && getContext()->getSettingsRef().distinct_global_in_subquery)
+            {
+                auto deduplicated = subquery_or_table_name->clone();
+                if (addDistinctToSubquery(deduplicated))
+                    subquery_or_table_name = deduplicated;
+            }
+
             String external_table_name;
             if (alias.empty())
             {
@@ -205,6 +218,39 @@ public:
     }
 
 private:
+    /// Add DISTINCT to each plain SELECT of the subquery. Selects with LIMIT are left as is:
+    /// DISTINCT is applied before LIMIT and would change the produced set of values.
+    /// Returns true if anything was changed.
+    static bool addDistinctToSubquery(ASTPtr & node)
+    {
+        if (auto * subquery = node->as<ASTSubquery>())
+        {
+            bool changed = false;
+            for (auto & child : subquery->children)
+                changed |= addDistinctToSubquery(child);
+            return changed;
+        }
+
+        if (auto * select_union = node->as<ASTSelectWithUnionQuery>())
+        {
+            bool changed = false;
+            for (auto & child : select_union->list_of_selects->children)
+                changed |= addDistinctToSubquery(child);
+            return changed;
+        }
+
+        if (auto * select = node->as<ASTSelectQuery>())
+        {
+            if (select->distinct || select->limitLength() || select->limitBy())
+                return false;
+
+            select->distinct = true;
+            return true;
+        }
+
+        return false;
+    }
+
     /// GLOBAL IN
     static void visit(ASTFunction & func, ASTPtr &, Data & data)
     {
@@ -229,7 +275,7 @@ private:
                 return;
             }
 
-            data.addExternalStorage(ast);
+            data.addExternalStorage(ast, /*set_alias*/ false, /*deduplicate_for_in*/ true);
             data.has_global_subqueries = true;
         }
     }
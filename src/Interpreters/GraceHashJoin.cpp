@@ -8,9 +8,13 @@
 
 #include <Compression/CompressedWriteBuffer.h>
 #include <Core/ProtocolDefines.h>
+#include <DataTypes/DataTypeLowCardinality.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <Disks/IVolume.h>
 #include <Disks/TemporaryFileOnDisk.h>
+#include <IO/IOThreadPool.h>
 #include <IO/WriteBufferFromTemporaryFile.h>
+#include <Common/FieldVisitorsAccurateComparison.h>
 #include <Common/logger_useful.h>
 #include <Common/thread_local_rng.h>
 
@@ -122,43 +126,50 @@ class GraceHashJoin::FileBucket : boost::noncopyable
 public:
     using BucketLock = std::unique_lock<std::mutex>;
 
-    explicit FileBucket(size_t bucket_index_, TemporaryFileStream & left_file_, TemporaryFileStream & right_file_, Poco::Logger * log_)
+    /// Total amount of blocks of all buckets waiting for a background writer.
+    /// Above this limit inserting threads write synchronously, providing backpressure.
+    static constexpr size_t MAX_QUEUED_BYTES_TOTAL = 128 * 1024 * 1024;
+
+    explicit FileBucket(
+        size_t bucket_index_,
+        TemporaryFileStream & left_file_,
+        TemporaryFileStream & right_file_,
+        ThreadPoolCallbackRunner<void> write_runner_,
+        std::shared_ptr<std::atomic<size_t>> total_queued_bytes_,
+        Poco::Logger * log_)
         : idx{bucket_index_}
-        , left_file{left_file_}
-        , right_file{right_file_}
+        , left{left_file_}
+        , right{right_file_}
+        , write_runner{std::move(write_runner_)}
+        , total_queued_bytes{std::move(total_queued_bytes_)}
         , state{State::WRITING_BLOCKS}
         , log{log_}
     {
     }
 
-    void addLeftBlock(const Block & block)
+    ~FileBucket()
     {
-        std::unique_lock<std::mutex> lock(left_file_mutex);
-        addBlockImpl(block, left_file, lock);
-    }
-
-    void addRightBlock(const Block & block)
-    {
-        std::unique_lock<std::mutex> lock(right_file_mutex);
-        addBlockImpl(block, right_file, lock);
-    }
-
-    bool tryAddLeftBlock(const Block & block)
-    {
-        std::unique_lock<std::mutex> lock(left_file_mutex, std::try_to_lock);
-        return addBlockImpl(block, left_file, lock);
+        /// Background writers capture `this`, wait for them before the bucket is destroyed.
+        try
+        {
+            waitPendingWrites(left);
+            waitPendingWrites(right);
+        }
+        catch (...)
+        {
+            tryLogCurrentException(log, "Error in background write of grace hash join bucket");
+        }
     }
 
-    bool tryAddRightBlock(const Block & block)
-    {
-        std::unique_lock<std::mutex> lock(right_file_mutex, std::try_to_lock);
-        return addBlockImpl(block, right_file, lock);
-    }
+    void addLeftBlock(const Block & block) { addBlockImpl(left, block, /* blocking = */ true); }
+    void addRightBlock(const Block & block) { addBlockImpl(right, block, /* blocking = */ true); }
+    bool tryAddLeftBlock(const Block & block) { return addBlockImpl(left, block, /* blocking = */ false); }
+    bool tryAddRightBlock(const Block & block) { return addBlockImpl(right, block, /* blocking = */ false); }
 
     bool finished() const
     {
-        std::unique_lock<std::mutex> left_lock(left_file_mutex);
-        return left_file.isEof();
+        std::unique_lock<std::mutex> left_lock(left.file_mutex);
+        return left.file.isEof();
     }
 
     bool empty() const { return is_empty.load(); }
@@ -166,41 +177,121 @@ public:
     AccumulatedBlockReader startJoining()
     {
         LOG_TRACE(log, "Joining file bucket {}", idx);
+
+        waitPendingWrites(left);
+        waitPendingWrites(right);
+
         {
-            std::unique_lock<std::mutex> left_lock(left_file_mutex);
-            std::unique_lock<std::mutex> right_lock(right_file_mutex);
+            std::unique_lock<std::mutex> left_lock(left.file_mutex);
+            std::unique_lock<std::mutex> right_lock(right.file_mutex);
 
-            left_file.finishWriting();
-            right_file.finishWriting();
+            left.file.finishWriting();
+            right.file.finishWriting();
 
             state = State::JOINING_BLOCKS;
         }
-        return AccumulatedBlockReader(right_file, right_file_mutex);
+        return AccumulatedBlockReader(right.file, right.file_mutex);
     }
 
     AccumulatedBlockReader getLeftTableReader()
     {
         ensureState(State::JOINING_BLOCKS);
-        return AccumulatedBlockReader(left_file, left_file_mutex);
+        return AccumulatedBlockReader(left.file, left.file_mutex);
     }
 
     const size_t idx;
 
 private:
-    bool addBlockImpl(const Block & block, TemporaryFileStream & writer, std::unique_lock<std::mutex> & lock)
+    struct Side
     {
-        ensureState(State::WRITING_BLOCKS);
+        explicit Side(TemporaryFileStream & file_) : file(file_) {}
 
-        if (!lock.owns_lock())
-            return false;
+        TemporaryFileStream & file;
+        mutable std::mutex file_mutex;
+
+        /// Blocks waiting to be written to `file` by a background task.
+        std::mutex queue_mutex;
+        Blocks queue;
+        size_t queue_bytes = 0;
+        bool task_scheduled = false;
+        std::future<void> task;
+    };
+
+    bool addBlockImpl(Side & side, const Block & block, bool blocking)
+    {
+        ensureState(State::WRITING_BLOCKS);
 
         if (block.rows())
             is_empty = false;
 
-        writer.write(block);
+        if (write_runner)
+        {
+            size_t block_bytes = block.allocatedBytes();
+            if (total_queued_bytes->fetch_add(block_bytes) + block_bytes <= MAX_QUEUED_BYTES_TOTAL)
+            {
+                std::lock_guard lock(side.queue_mutex);
+                side.queue_bytes += block_bytes;
+                side.queue.push_back(block);
+
+                if (!side.task_scheduled)
+                {
+                    side.task_scheduled = true;
+                    side.task = write_runner([this, &side] { writeQueuedBlocks(side); }, 0);
+                }
+                return true;
+            }
+
+            /// Spilling does not keep up with inserts, write from the current thread.
+            total_queued_bytes->fetch_sub(block_bytes);
+        }
+
+        std::unique_lock<std::mutex> lock(side.file_mutex, std::defer_lock);
+        if (blocking)
+            lock.lock();
+        else if (!lock.try_lock())
+            return false;
+
+        side.file.write(block);
         return true;
     }
 
+    void writeQueuedBlocks(Side & side)
+    {
+        while (true)
+        {
+            Blocks blocks_to_write;
+            {
+                std::lock_guard lock(side.queue_mutex);
+                if (side.queue.empty())
+                {
+                    side.task_scheduled = false;
+                    return;
+                }
+                blocks_to_write.swap(side.queue);
+                total_queued_bytes->fetch_sub(side.queue_bytes);
+                side.queue_bytes = 0;
+            }
+
+            std::lock_guard lock(side.file_mutex);
+            for (const auto & block : blocks_to_write)
+                side.file.write(block);
+        }
+    }
+
+    /// Wait for the background writer of this side and rethrow its exception, if any.
+    /// May be called only when no new blocks can be added to the bucket.
+    void waitPendingWrites(Side & side)
+    {
+        std::future<void> task;
+        {
+            std::lock_guard lock(side.queue_mutex);
+            task = std::move(side.task);
+        }
+
+        if (task.valid())
+            task.get();
+    }
+
     void transition(State expected, State desired)
     {
         State prev = state.exchange(desired);
@@ -215,10 +306,11 @@ private:
             throw Exception(ErrorCodes::LOGICAL_ERROR, "Invalid state transition, expected {}, got {}", expected, state.load());
     }
 
-    TemporaryFileStream & left_file;
-    TemporaryFileStream & right_file;
-    mutable std::mutex left_file_mutex;
-    mutable std::mutex right_file_mutex;
+    Side left;
+    Side right;
+
+    ThreadPoolCallbackRunner<void> write_runner;
+    std::shared_ptr<std::atomic<size_t>> total_queued_bytes;
 
     std::atomic_bool is_empty = true;
 
@@ -273,11 +365,15 @@ GraceHashJoin::GraceHashJoin(
     , left_key_names(table_join->getOnlyClause().key_names_left)
     , right_key_names(table_join->getOnlyClause().key_names_right)
     , tmp_data(std::make_unique<TemporaryDataOnDisk>(tmp_data_, CurrentMetrics::TemporaryFilesForJoin))
+    , bucket_write_runner(threadPoolCallbackRunner<void>(IOThreadPool::get(), "GraceJoinWrite"))
+    , total_bytes_queued_for_write(std::make_shared<std::atomic<size_t>>(0))
     , hash_join(makeInMemoryJoin())
     , hash_join_sample_block(hash_join->savedBlockSample())
 {
     if (!GraceHashJoin::isSupported(table_join))
         throw Exception(ErrorCodes::NOT_IMPLEMENTED, "GraceHashJoin is not supported for this join type");
+
+    tmp_data->setCompressionCodec(context->getSettingsRef().temporary_files_codec);
 }
 
 void GraceHashJoin::initBuckets()
@@ -389,7 +485,8 @@ void GraceHashJoin::addBucket(Buckets & destination)
     auto & left_file = tmp_data->createStream(left_sample_block);
     auto & right_file = tmp_data->createStream(prepareRightBlock(right_sample_block));
 
-    BucketPtr new_bucket = std::make_shared<FileBucket>(destination.size(), left_file, right_file, log);
+    BucketPtr new_bucket = std::make_shared<FileBucket>(
+        destination.size(), left_file, right_file, bucket_write_runner, total_bytes_queued_for_write, log);
     destination.emplace_back(std::move(new_bucket));
 }
 
@@ -479,16 +576,72 @@ IBlocksStreamPtr GraceHashJoin::getNonJoinedBlocks(const Block &, const Block &,
     return nullptr;
 }
 
+namespace
+{
+
+/// Min/max of the first join key over the build side of a bucket.
+/// For INNER joins probe rows outside of this range cannot match and are dropped before the probe.
+struct BuildKeyRange
+{
+    Field min_value;
+    Field max_value;
+};
+
+/// Returns false if extremes cannot be tracked for this key column, disabling the pruning.
+bool updateBuildKeyRange(const Block & block, const String & key_name, std::optional<BuildKeyRange> & range)
+{
+    if (!block.rows())
+        return true;
+
+    const auto * key_column = block.findByName(key_name);
+    if (!key_column)
+        return false;
+
+    /// NaN keys match bitwise in the hash table but are skipped by getExtremes,
+    /// so a range check is unsound for floating point keys.
+    if (WhichDataType(removeNullable(removeLowCardinality(key_column->type))).isFloat())
+        return false;
+
+    Field cur_min;
+    Field cur_max;
+    key_column->column->getExtremes(cur_min, cur_max);
+
+    /// Extremes are not defined for this column type (or all keys are NULL).
+    if (cur_min.isNull() || cur_max.isNull())
+        return false;
+
+    if (!range)
+    {
+        range = BuildKeyRange{std::move(cur_min), std::move(cur_max)};
+        return true;
+    }
+
+    if (applyVisitor(FieldVisitorAccurateLess{}, cur_min, range->min_value))
+        range->min_value = std::move(cur_min);
+    if (applyVisitor(FieldVisitorAccurateLess{}, range->max_value, cur_max))
+        range->max_value = std::move(cur_max);
+    return true;
+}
+
+}
+
 class GraceHashJoin::DelayedBlocks : public IBlocksStream
 {
 public:
-    explicit DelayedBlocks(size_t current_bucket_, Buckets buckets_, InMemoryJoinPtr hash_join_, const Names & left_key_names_, const Names & right_key_names_)
+    DelayedBlocks(
+        size_t current_bucket_,
+        Buckets buckets_,
+        InMemoryJoinPtr hash_join_,
+        const Names & left_key_names_,
+        const Names & right_key_names_,
+        std::optional<BuildKeyRange> build_key_range_)
         : current_bucket(current_bucket_)
         , buckets(std::move(buckets_))
         , hash_join(std::move(hash_join_))
         , left_reader(buckets[current_bucket]->getLeftTableReader())
         , left_key_names(left_key_names_)
         , right_key_names(right_key_names_)
+        , build_key_range(std::move(build_key_range_))
     {
     }
 
@@ -526,6 +679,9 @@ public:
 
                 buckets[bucket_idx]->addLeftBlock(blocks[bucket_idx]);
             }
+
+            if (build_key_range)
+                pruneByBuildKeyRange(block);
         } while (block.rows() == 0);
 
         ExtraBlockPtr not_processed;
@@ -545,6 +701,39 @@ public:
 
     Names left_key_names;
     Names right_key_names;
+
+    /// Set only for INNER joins when the bucket build keys have known extremes.
+    std::optional<BuildKeyRange> build_key_range;
+
+private:
+    /// Drop probe rows whose key is outside of the [min, max] of the bucket build keys: they cannot match.
+    void pruneByBuildKeyRange(Block & block) const
+    {
+        size_t num_rows = block.rows();
+        if (num_rows == 0)
+            return;
+
+        const auto & key_column = block.getByName(left_key_names.front()).column;
+        auto range_column = key_column->cloneEmpty();
+        range_column->insert(build_key_range->min_value);
+        range_column->insert(build_key_range->max_value);
+
+        IColumn::Filter filter(num_rows);
+        size_t num_kept = 0;
+        for (size_t i = 0; i < num_rows; ++i)
+        {
+            bool in_range = key_column->compareAt(i, 0, *range_column, 1) >= 0
+                && key_column->compareAt(i, 1, *range_column, 1) <= 0;
+            filter[i] = in_range;
+            num_kept += in_range;
+        }
+
+        if (num_kept == num_rows)
+            return;
+
+        for (auto & column : block)
+            column.column = column.column->filter(filter, num_kept);
+    }
 };
 
 IBlocksStreamPtr GraceHashJoin::getDelayedBlocks()
@@ -582,16 +771,28 @@ IBlocksStreamPtr GraceHashJoin::getDelayedBlocks()
 
         auto right_reader = current_bucket->startJoining();
         size_t num_rows = 0; /// count rows that were written and rehashed
+
+        /// For INNER joins track the range of the build keys to prune non-matching probe rows.
+        /// The range is taken before rehashing, so it can only overestimate the bucket contents.
+        bool collect_build_key_range = isInner(table_join->kind());
+        std::optional<BuildKeyRange> build_key_range;
+
         while (Block block = right_reader.read())
         {
             num_rows += block.rows();
+            if (collect_build_key_range)
+                collect_build_key_range = updateBuildKeyRange(block, right_key_names.front(), build_key_range);
             addJoinedBlockImpl(std::move(block));
         }
 
+        if (!collect_build_key_range)
+            build_key_range.reset();
+
         LOG_TRACE(log, "Loaded bucket {} with {}(/{}) rows",
             bucket_idx, hash_join->getTotalRowCount(), num_rows);
 
-        return std::make_unique<DelayedBlocks>(current_bucket->idx, buckets, hash_join, left_key_names, right_key_names);
+        return std::make_unique<DelayedBlocks>(
+            current_bucket->idx, buckets, hash_join, left_key_names, right_key_names, std::move(build_key_range));
     }
 
     LOG_TRACE(log, "Finished loading all {} buckets", buckets.size());
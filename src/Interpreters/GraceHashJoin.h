@@ -3,6 +3,7 @@
 #include <Interpreters/Context_fwd.h>
 #include <Interpreters/IJoin.h>
 #include <Interpreters/TemporaryDataOnDisk.h>
+#include <Interpreters/threadPoolCallbackRunner.h>
 
 #include <Core/Block.h>
 
@@ -135,6 +136,11 @@ private:
 
     TemporaryDataOnDiskPtr tmp_data;
 
+    /// Runs background writes of spilled blocks to bucket files (see FileBucket).
+    ThreadPoolCallbackRunner<void> bucket_write_runner;
+    /// Total size of blocks of all buckets waiting for a background write.
+    std::shared_ptr<std::atomic<size_t>> total_bytes_queued_for_write;
+
     Buckets buckets;
     mutable SharedMutex rehash_mutex;
 
@@ -8,6 +8,7 @@
 
 #include <Columns/ColumnConst.h>
 #include <Columns/ColumnString.h>
+#include <Columns/ColumnsCommon.h>
 #include <Columns/ColumnVector.h>
 #include <Columns/ColumnFixedString.h>
 #include <Columns/ColumnNullable.h>
@@ -211,7 +212,7 @@ static void correctNullabilityInplace(ColumnWithTypeAndName & column, bool nulla
         JoinCommon::removeColumnNullability(column);
 }
 
-HashJoin::HashJoin(std::shared_ptr<TableJoin> table_join_, const Block & right_sample_block_, bool any_take_last_row_)
+HashJoin::HashJoin(std::shared_ptr<TableJoin> table_join_, const Block & right_sample_block_, bool any_take_last_row_, bool keep_unused_rows_)
     : table_join(table_join_)
     , kind(table_join->kind())
     , strictness(table_join->strictness())
@@ -221,6 +222,16 @@ HashJoin::HashJoin(std::shared_ptr<TableJoin> table_join_, const Block & right_s
     , right_sample_block(right_sample_block_)
     , log(&Poco::Logger::get("HashJoin"))
 {
+    /// Rows that are not referenced from the hash table can be dropped only if the blocks
+    /// are not needed in their original form: JoinSwitcher (AUTO) and GraceHashJoin may
+    /// feed the stored blocks into another join algorithm.
+    filter_stored_rows = !keep_unused_rows_
+        && (isLeft(kind) || isInner(kind))
+        && (strictness == JoinStrictness::Any || strictness == JoinStrictness::Semi || strictness == JoinStrictness::Anti)
+        && table_join->oneDisjunct()
+        && !table_join->isEnabledAlgorithm(JoinAlgorithm::AUTO)
+        && !table_join->isEnabledAlgorithm(JoinAlgorithm::GRACE_HASH);
+
     LOG_DEBUG(log, "({}) Datatype: {}, kind: {}, strictness: {}, right header: {}", fmt::ptr(this), data->type, kind, strictness, right_sample_block.dumpStructure());
     LOG_DEBUG(log, "({}) Keys: {}", fmt::ptr(this), TableJoin::formatClauses(table_join->getClauses(), true));
 
@@ -535,13 +546,19 @@ namespace
     template <typename Map, typename KeyGetter>
     struct Inserter
     {
-        static ALWAYS_INLINE void insertOne(const HashJoin & join, Map & map, KeyGetter & key_getter, Block * stored_block, size_t i,
-                                            Arena & pool)
+        /// @param stored_index - index of the row inside the stored block (differs from i if unreferenced rows are dropped).
+        /// Returns true if the row became referenced from the hash table.
+        static ALWAYS_INLINE bool insertOne(const HashJoin & join, Map & map, KeyGetter & key_getter, Block * stored_block, size_t i,
+                                            size_t stored_index, Arena & pool)
         {
             auto emplace_result = key_getter.emplaceKey(map, i, pool);
 
             if (emplace_result.isInserted() || join.anyTakeLastRow())
-                new (&emplace_result.getMapped()) typename Map::mapped_type(stored_block, i);
+            {
+                new (&emplace_result.getMapped()) typename Map::mapped_type(stored_block, stored_index);
+                return true;
+            }
+            return false;
         }
 
         static ALWAYS_INLINE void insertAll(const HashJoin &, Map & map, KeyGetter & key_getter, Block * stored_block, size_t i, Arena & pool)
@@ -574,7 +591,8 @@ namespace
     template <JoinStrictness STRICTNESS, typename KeyGetter, typename Map, bool has_null_map>
     size_t NO_INLINE insertFromBlockImplTypeCase(
         HashJoin & join, Map & map, size_t rows, const ColumnRawPtrs & key_columns,
-        const Sizes & key_sizes, Block * stored_block, ConstNullMapPtr null_map, UInt8ColumnDataPtr join_mask, Arena & pool)
+        const Sizes & key_sizes, Block * stored_block, ConstNullMapPtr null_map, UInt8ColumnDataPtr join_mask,
+        IColumn::Filter * stored_rows_filter, Arena & pool)
     {
         [[maybe_unused]] constexpr bool mapped_one = std::is_same_v<typename Map::mapped_type, RowRef>;
         constexpr bool is_asof_join = STRICTNESS == JoinStrictness::Asof;
@@ -585,6 +603,10 @@ namespace
 
         auto key_getter = createKeyGetter<KeyGetter, is_asof_join>(key_columns, key_sizes);
 
+        /// Unreferenced rows will be removed from the stored block, so referenced rows
+        /// are inserted under their index after the filtering.
+        [[maybe_unused]] size_t stored_rows = 0;
+
         for (size_t i = 0; i < rows; ++i)
         {
             if (has_null_map && (*null_map)[i])
@@ -597,7 +619,18 @@ namespace
             if constexpr (is_asof_join)
                 Inserter<Map, KeyGetter>::insertAsof(join, map, key_getter, stored_block, i, pool, *asof_column);
             else if constexpr (mapped_one)
-                Inserter<Map, KeyGetter>::insertOne(join, map, key_getter, stored_block, i, pool);
+            {
+                if (stored_rows_filter)
+                {
+                    if (Inserter<Map, KeyGetter>::insertOne(join, map, key_getter, stored_block, i, stored_rows, pool))
+                    {
+                        (*stored_rows_filter)[i] = 1;
+                        ++stored_rows;
+                    }
+                }
+                else
+                    Inserter<Map, KeyGetter>::insertOne(join, map, key_getter, stored_block, i, i, pool);
+            }
             else
                 Inserter<Map, KeyGetter>::insertAll(join, map, key_getter, stored_block, i, pool);
         }
@@ -608,21 +641,23 @@ namespace
     template <JoinStrictness STRICTNESS, typename KeyGetter, typename Map>
     size_t insertFromBlockImplType(
         HashJoin & join, Map & map, size_t rows, const ColumnRawPtrs & key_columns,
-        const Sizes & key_sizes, Block * stored_block, ConstNullMapPtr null_map, UInt8ColumnDataPtr join_mask, Arena & pool)
+        const Sizes & key_sizes, Block * stored_block, ConstNullMapPtr null_map, UInt8ColumnDataPtr join_mask,
+        IColumn::Filter * stored_rows_filter, Arena & pool)
     {
         if (null_map)
             return insertFromBlockImplTypeCase<STRICTNESS, KeyGetter, Map, true>(
-                join, map, rows, key_columns, key_sizes, stored_block, null_map, join_mask, pool);
+                join, map, rows, key_columns, key_sizes, stored_block, null_map, join_mask, stored_rows_filter, pool);
         else
             return insertFromBlockImplTypeCase<STRICTNESS, KeyGetter, Map, false>(
-                join, map, rows, key_columns, key_sizes, stored_block, null_map, join_mask, pool);
+                join, map, rows, key_columns, key_sizes, stored_block, null_map, join_mask, stored_rows_filter, pool);
     }
 
 
     template <JoinStrictness STRICTNESS, typename Maps>
     size_t insertFromBlockImpl(
         HashJoin & join, HashJoin::Type type, Maps & maps, size_t rows, const ColumnRawPtrs & key_columns,
-        const Sizes & key_sizes, Block * stored_block, ConstNullMapPtr null_map, UInt8ColumnDataPtr join_mask, Arena & pool)
+        const Sizes & key_sizes, Block * stored_block, ConstNullMapPtr null_map, UInt8ColumnDataPtr join_mask,
+        IColumn::Filter * stored_rows_filter, Arena & pool)
     {
         switch (type)
         {
@@ -632,7 +667,7 @@ namespace
         #define M(TYPE) \
             case HashJoin::Type::TYPE: \
                 return insertFromBlockImplType<STRICTNESS, typename KeyGetterForType<HashJoin::Type::TYPE, std::remove_reference_t<decltype(*maps.TYPE)>>::Type>(\
-                    join, *maps.TYPE, rows, key_columns, key_sizes, stored_block, null_map, join_mask, pool); \
+                    join, *maps.TYPE, rows, key_columns, key_sizes, stored_block, null_map, join_mask, stored_rows_filter, pool); \
                     break;
             APPLY_FOR_JOIN_VARIANTS(M)
         #undef M
@@ -777,12 +812,19 @@ bool HashJoin::addJoinedBlock(const Block & source_block, bool check_limits)
 
             if (kind != JoinKind::Cross)
             {
+                /// Rows that lost the race for their key are never referenced from the hash table,
+                /// so they can be dropped from the stored block (see filter_stored_rows).
+                IColumn::Filter stored_rows_filter;
+                if (filter_stored_rows)
+                    stored_rows_filter.resize_fill(rows, 0);
+
                 joinDispatch(kind, strictness, data->maps[onexpr_idx], [&](auto kind_, auto strictness_, auto & map)
                 {
                     size_t size = insertFromBlockImpl<strictness_>(
                         *this, data->type, map, rows, key_columns, key_sizes[onexpr_idx], stored_block, null_map,
                         /// If mask is false constant, rows are added to hashmap anyway. It's not a happy-flow, so this case is not optimized
                         join_mask_col.getData(),
+                        filter_stored_rows ? &stored_rows_filter : nullptr,
                         data->pool);
 
                     if (multiple_disjuncts)
@@ -791,6 +833,18 @@ bool HashJoin::addJoinedBlock(const Block & source_block, bool check_limits)
                         /// Number of buckets + 1 value from zero storage
                         used_flags.reinit<kind_, strictness_>(size + 1);
                 });
+
+                if (filter_stored_rows)
+                {
+                    size_t referenced_rows = countBytesInFilter(stored_rows_filter);
+                    if (referenced_rows < rows)
+                    {
+                        data->blocks_allocated_size -= stored_block->allocatedBytes();
+                        for (auto & column : *stored_block)
+                            column.column = column.column->filter(stored_rows_filter, referenced_rows);
+                        data->blocks_allocated_size += stored_block->allocatedBytes();
+                    }
+                }
             }
 
             if (!multiple_disjuncts && save_nullmap)
@@ -906,6 +960,16 @@ public:
 
         for (auto & tn : type_name)
             right_indexes.push_back(saved_block_sample.getPositionByName(tn.name));
+
+        /// During the probe only references to the matched rows are collected, the columns
+        /// are materialized by buildOutput() in one pass per column instead of row by row.
+        /// joinGet works row by row and needs the eager path to wrap nullable columns.
+        lazy_output = !is_join_get;
+        if (lazy_output)
+        {
+            lazy_output_blocks.reserve(rows_to_add);
+            lazy_output_rows.reserve(rows_to_add);
+        }
     }
 
     size_t size() const { return columns.size(); }
@@ -956,6 +1020,13 @@ public:
         UNUSED(assertBlockEqualsStructureUpToLowCard);
 #endif
 
+        if (lazy_output)
+        {
+            lazy_output_blocks.push_back(&block);
+            lazy_output_rows.push_back(static_cast<UInt32>(row_num));
+            return;
+        }
+
         if (is_join_get)
         {
             /// If it's joinGetOrNull, we need to wrap not-nullable columns in StorageJoin.
@@ -988,7 +1059,14 @@ public:
 
     void appendDefaultRow()
     {
-        ++lazy_defaults_count;
+        if (lazy_output)
+        {
+            /// A row reference without a block denotes a default row, the order is preserved as is.
+            lazy_output_blocks.push_back(nullptr);
+            lazy_output_rows.push_back(0);
+        }
+        else
+            ++lazy_defaults_count;
     }
 
     void applyLazyDefaults()
@@ -1001,6 +1079,60 @@ public:
         }
     }
 
+    /// Materialize the columns from the row references collected during the probe.
+    /// Filling column by column is more cache friendly than the row by row insertion
+    /// and references to consecutive rows of one block collapse into a single batched insert.
+    void buildOutput()
+    {
+        if (!lazy_output)
+            return;
+
+        const size_t num_rows = lazy_output_blocks.size();
+        for (size_t j = 0, size = right_indexes.size(); j < size; ++j)
+        {
+            auto & column = columns[j];
+            column->reserve(num_rows);
+
+            size_t defaults_count = 0;
+            auto flush_defaults = [&]
+            {
+                if (defaults_count)
+                    JoinCommon::addDefaultValues(*column, type_name[j].type, defaults_count);
+                defaults_count = 0;
+            };
+
+            for (size_t i = 0; i < num_rows;)
+            {
+                const Block * source_block = lazy_output_blocks[i];
+                if (!source_block)
+                {
+                    ++defaults_count;
+                    ++i;
+                    continue;
+                }
+                flush_defaults();
+
+                size_t start_row = lazy_output_rows[i];
+                size_t length = 1;
+                while (i + length < num_rows
+                    && lazy_output_blocks[i + length] == source_block
+                    && lazy_output_rows[i + length] == start_row + length)
+                    ++length;
+
+                const auto & column_from_block = source_block->getByPosition(right_indexes[j]);
+                if (auto * lowcard_col = typeid_cast<ColumnLowCardinality *>(column.get());
+                    lowcard_col && !typeid_cast<const ColumnLowCardinality *>(column_from_block.column.get()))
+                    lowcard_col->insertRangeFromFullColumn(*column_from_block.column, start_row, length);
+                else
+                    column->insertRangeFrom(*column_from_block.column, start_row, length);
+
+                i += length;
+            }
+
+            flush_defaults();
+        }
+    }
+
     const IColumn & leftAsofKey() const { return *left_asof_key; }
 
     std::vector<JoinOnKeyColumns> join_on_keys;
@@ -1014,6 +1146,10 @@ private:
     MutableColumns columns;
     std::vector<size_t> right_indexes;
     size_t lazy_defaults_count = 0;
+    /// Row references collected during the probe when the output is built lazily.
+    bool lazy_output = false;
+    std::vector<const Block *> lazy_output_blocks;
+    std::vector<UInt32> lazy_output_rows;
     /// for ASOF
     const IColumn * left_asof_key = nullptr;
     Block sample_block;
@@ -1481,6 +1617,8 @@ void HashJoin::joinBlockImpl(
 
     IColumn::Filter row_filter = switchJoinRightColumns<KIND, STRICTNESS>(maps_, added_columns, data->type, used_flags);
 
+    added_columns.buildOutput();
+
     for (size_t i = 0; i < added_columns.size(); ++i)
         block.insert(added_columns.moveColumn(i));
 
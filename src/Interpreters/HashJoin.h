@@ -147,7 +147,9 @@ public:
 class HashJoin : public IJoin
 {
 public:
-    HashJoin(std::shared_ptr<TableJoin> table_join_, const Block & right_sample_block, bool any_take_last_row_ = false);
+    /// @param keep_unused_rows_ - do not drop rows of right blocks that are not referenced from the hash table
+    ///                            (StorageJoin reads the stored blocks directly, so it needs all of them).
+    HashJoin(std::shared_ptr<TableJoin> table_join_, const Block & right_sample_block, bool any_take_last_row_ = false, bool keep_unused_rows_ = false);
 
     ~HashJoin() override;
 
@@ -380,6 +382,12 @@ private:
     bool from_storage_join = false;
 
     bool any_take_last_row; /// Overwrite existing values when encountering the same key again
+
+    /// For ANY/SEMI/ANTI LEFT and INNER joins only one row per key is referenced from the hash table,
+    /// so the rest of the rows can be dropped from the stored blocks to save memory
+    /// (build sides with many duplicate keys would otherwise store every copy of the payload).
+    bool filter_stored_rows = false;
+
     std::optional<TypeIndex> asof_type;
     const ASOFJoinInequality asof_inequality;
 
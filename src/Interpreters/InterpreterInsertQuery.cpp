@@ -15,6 +15,7 @@
 #include <Interpreters/getTableExpressions.h>
 #include <Interpreters/processColumnTransformers.h>
 #include <Interpreters/InterpreterSelectQueryAnalyzer.h>
+#include <Parsers/ASTAsterisk.h>
 #include <Parsers/ASTFunction.h>
 #include <Parsers/ASTInsertQuery.h>
 #include <Parsers/ASTSelectQuery.h>
@@ -25,11 +26,14 @@
 #include <Processors/Transforms/CountingTransform.h>
 #include <Processors/Transforms/ExpressionTransform.h>
 #include <Processors/Transforms/MaterializingTransform.h>
+#include <Processors/Transforms/MergingAggregateStatesTransform.h>
 #include <Processors/Transforms/SquashingChunksTransform.h>
 #include <Processors/Transforms/getSourceFromASTInsertQuery.h>
 #include <Processors/QueryPlan/QueryPlan.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
+#include <Storages/MergeTree/MergeTreeData.h>
 #include <Storages/StorageDistributed.h>
+#include <Storages/StorageMergeTree.h>
 #include <Storages/StorageMaterializedView.h>
 #include <Storages/WindowView/StorageWindowView.h>
 #include <TableFunctions/TableFunctionFactory.h>
@@ -227,6 +231,41 @@ static bool isTrivialSelect(const ASTPtr & select)
     return false;
 }
 
+/** For INSERT INTO t SELECT * FROM s, returns the source table if the SELECT reads all columns
+  * of a single table as is: no filtering, transformation or reordering.
+  * Used by the part cloning fast path (optimize_insert_select_with_part_cloning).
+  */
+static StoragePtr tryGetFullTableScanSource(const ASTPtr & select, ContextPtr context)
+{
+    const auto * select_union = select->as<ASTSelectWithUnionQuery>();
+    if (!select_union || select_union->list_of_selects->children.size() != 1)
+        return nullptr;
+
+    const auto & select_ast = select_union->list_of_selects->children.front();
+    if (!isTrivialSelect(select_ast))
+        return nullptr;
+
+    const auto & select_query = select_ast->as<ASTSelectQuery &>();
+    if (select_query.limitLength() || select_query.limitOffset() || select_query.settings())
+        return nullptr;
+
+    /// Only a bare `SELECT *` reproduces the source columns as they are stored.
+    const auto & select_expressions = select_query.select()->children;
+    if (select_expressions.size() != 1)
+        return nullptr;
+    const auto * asterisk = select_expressions.front()->as<ASTAsterisk>();
+    if (!asterisk || asterisk->transformers)
+        return nullptr;
+
+    const auto & table_element = select_query.tables()->children.front()->as<ASTTablesInSelectQueryElement &>();
+    const auto & table_expr = table_element.table_expression->as<ASTTableExpression &>();
+    if (!table_expr.database_and_table_name || table_expr.final || table_expr.sample_size)
+        return nullptr;
+
+    auto source_id = context->resolveStorageID(table_expr.database_and_table_name);
+    return DatabaseCatalog::instance().tryGetTable(source_id, context);
+}
+
 Chain InterpreterInsertQuery::buildChain(
     const StoragePtr & table,
     const StorageMetadataPtr & metadata_snapshot,
@@ -305,11 +344,24 @@ Chain InterpreterInsertQuery::buildChainImpl(
     if (!(settings.insert_distributed_sync && table->isRemote()) && !async_insert && !no_squash && !(query && query->watch))
     {
         bool table_prefers_large_blocks = table->prefersLargeBlocks();
-
-        out.addSource(std::make_shared<SquashingChunksTransform>(
-            out.getInputHeader(),
-            table_prefers_large_blocks ? settings.min_insert_block_size_rows : settings.max_block_size,
-            table_prefers_large_blocks ? settings.min_insert_block_size_bytes : 0ULL));
+        size_t min_block_size_rows = table_prefers_large_blocks ? settings.min_insert_block_size_rows : settings.max_block_size;
+        size_t min_block_size_bytes = table_prefers_large_blocks ? settings.min_insert_block_size_bytes : 0ULL;
+
+        /// For tables that store aggregation states, merge the states of rows with equal keys
+        /// while accumulating the block instead of plain squashing. Materialized views push
+        /// every chunk through the view query separately, so the same keys reappear in chunk
+        /// after chunk, and squashing would write them all as separate state rows.
+        const auto * merge_tree = dynamic_cast<const MergeTreeData *>(table.get());
+        bool merge_states = settings.optimize_on_insert && merge_tree
+            && merge_tree->merging_params.mode == MergeTreeData::MergingParams::Aggregating
+            && MergingAggregateStatesTransform::isApplicable(out.getInputHeader());
+
+        if (merge_states)
+            out.addSource(std::make_shared<MergingAggregateStatesTransform>(
+                out.getInputHeader(), min_block_size_rows, min_block_size_bytes));
+        else
+            out.addSource(std::make_shared<SquashingChunksTransform>(
+                out.getInputHeader(), min_block_size_rows, min_block_size_bytes));
     }
 
     auto counting = std::make_shared<CountingTransform>(out.getInputHeader(), thread_status, getContext()->getQuota());
@@ -349,6 +401,31 @@ BlockIO InterpreterInsertQuery::execute()
     if (!query.table_function)
         getContext()->checkAccess(AccessType::INSERT, query.table_id, query_sample_block.getNames());
 
+    /// INSERT ... SELECT * FROM another table of the same structure can attach hardlinked
+    /// clones of the source parts instead of piping every row through the pipeline.
+    /// A SELECT with a WHERE or any other transformation falls through to the usual row processing.
+    if (query.select && !query.columns && !query.table_function && !no_destination && !async_insert
+        && settings.optimize_insert_select_with_part_cloning)
+    {
+        if (auto * dst_merge_tree = dynamic_cast<StorageMergeTree *>(table.get()))
+        {
+            StoragePtr source_table = tryGetFullTableScanSource(query.select, getContext());
+            if (source_table && source_table != table
+                && DatabaseCatalog::instance().getDependencies(query.table_id).empty())
+            {
+                auto source_id = source_table->getStorageID();
+                if (!getContext()->getRowPolicyFilter(source_id.getDatabaseName(), source_id.getTableName(), RowPolicyFilterType::SELECT_FILTER))
+                {
+                    /// The SELECT part of the query is not interpreted, so check its access here.
+                    getContext()->checkAccess(AccessType::SELECT, source_id, source_table->getInMemoryMetadataPtr()->getColumns().getNamesOfPhysical());
+
+                    if (dst_merge_tree->cloneAllPartsFrom(source_table, getContext()))
+                        return {};
+                }
+            }
+        }
+    }
+
     if (query.select && settings.parallel_distributed_insert_select)
         // Distributed INSERT SELECT
         distributed_pipeline = table->distributedWrite(query, getContext());
@@ -158,7 +158,8 @@ void InterpreterSelectIntersectExceptQuery::buildQueryPlan(QueryPlan & query_pla
             0,
             result_header.getNames(),
             false,
-            settings.optimize_distinct_in_order);
+            settings.optimize_distinct_in_order,
+            settings.parallel_distinct);
 
         query_plan.addStep(std::move(distinct_step));
     }
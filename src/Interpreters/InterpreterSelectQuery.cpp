@@ -2,6 +2,7 @@
 
 #include <DataTypes/DataTypeAggregateFunction.h>
 #include <DataTypes/DataTypeInterval.h>
+#include <DataTypes/ObjectUtils.h>
 
 #include <Parsers/ASTFunction.h>
 #include <Parsers/ASTIdentifier.h>
@@ -322,6 +323,20 @@ static ASTPtr parseAdditionalFilterConditionForTable(
 }
 
 /// Returns true if we should ignore quotas and limits for a specified table in the system database.
+/// Estimate of the in-memory width of one row of the header, used to derive an adaptive
+/// block size from a byte budget (see the max_block_size_bytes setting).
+static UInt64 estimateRowSizeInMemory(const Block & header)
+{
+    /// A guess for strings, arrays and other variable-width types.
+    static constexpr UInt64 variable_width_column_size = 32;
+
+    UInt64 res = 0;
+    for (const auto & column : header)
+        res += column.type->haveMaximumSizeOfValue() ? column.type->getMaximumSizeOfValueInMemory() : variable_width_column_size;
+
+    return std::max<UInt64>(res, 1);
+}
+
 static bool shouldIgnoreQuotaAndLimits(const StorageID & table_id)
 {
     if (table_id.database_name == DatabaseCatalog::SYSTEM_DATABASE)
@@ -423,10 +438,35 @@ InterpreterSelectQuery::InterpreterSelectQuery(
     {
         table_lock = storage->lockForShare(context->getInitialQueryId(), context->getSettingsRef().lock_acquire_timeout);
         table_id = storage->getStorageID();
+
+        /// With 'pin_storage_snapshots' all the references to one table across the query (self-joins,
+        /// UNION branches, subqueries) share the snapshot taken at the first reference, so they see
+        /// the same set of data parts and the same version of metadata even if the table is altered
+        /// concurrently. Remote tables are not pinned: their snapshot does not represent the data.
+        /// Neither are the queries with an explicitly passed metadata snapshot (e.g. pushing to a view).
+        bool pin_snapshot = settings.pin_storage_snapshots && context->hasQueryContext() && !storage->isRemote() && !metadata_snapshot;
+
+        if (pin_snapshot)
+        {
+            if (auto pinned_snapshot = context->getQueryContext()->tryGetPinnedStorageSnapshot(table_id))
+            {
+                storage_snapshot = pinned_snapshot;
+                metadata_snapshot = pinned_snapshot->metadata;
+            }
+        }
+
         if (!metadata_snapshot)
             metadata_snapshot = storage->getInMemoryMetadataPtr();
 
-        storage_snapshot = storage->getStorageSnapshotForQuery(metadata_snapshot, query_ptr, context);
+        if (!storage_snapshot)
+        {
+            storage_snapshot = storage->getStorageSnapshotForQuery(metadata_snapshot, query_ptr, context);
+
+            /// Snapshots of tables with dynamic subcolumns are extended with the object columns
+            /// inferred for the particular (sub)query, they cannot be shared between subqueries.
+            if (pin_snapshot && !hasDynamicSubcolumns(metadata_snapshot->getColumns()))
+                context->getQueryContext()->pinStorageSnapshot(table_id, storage_snapshot);
+        }
     }
 
     if (has_input || !joined_tables.resolveTables())
@@ -608,7 +648,11 @@ InterpreterSelectQuery::InterpreterSelectQuery(
 
         if (!options.only_analyze)
         {
-            if (query.sampleSize() && (input_pipe || !storage || !storage->supportsSampling()))
+            /// MergeTree tables without a sampling key may still be sampled by pseudo-random granule selection.
+            bool sample_without_sampling_key
+                = storage && storage->isMergeTree() && settings.allow_sample_without_sampling_key;
+
+            if (query.sampleSize() && (input_pipe || !storage || !storage->supportsSampling()) && !sample_without_sampling_key)
                 throw Exception(ErrorCodes::SAMPLING_NOT_SUPPORTED, "Illegal SAMPLE: table doesn't support sampling");
 
             if (query.final() && (input_pipe || !storage || !storage->supportsFinal()))
@@ -1379,7 +1423,7 @@ void InterpreterSelectQuery::executeImpl(QueryPlan & query_plan, std::optional<P
                 if (expressions.hasLimitBy())
                 {
                     executeExpression(query_plan, expressions.before_limit_by, "Before LIMIT BY");
-                    executeLimitBy(query_plan);
+                    executeLimitBy(query_plan, /* do_not_skip_offset= */ true);
                 }
 
                 if (query.limitLength())
@@ -1734,7 +1778,7 @@ void InterpreterSelectQuery::executeImpl(QueryPlan & query_plan, std::optional<P
             if (!from_aggregation_stage && expressions.hasLimitBy())
             {
                 executeExpression(query_plan, expressions.before_limit_by, "Before LIMIT BY");
-                executeLimitBy(query_plan);
+                executeLimitBy(query_plan, /* do_not_skip_offset= */ false);
             }
 
             executeWithFill(query_plan);
@@ -2212,6 +2256,15 @@ void InterpreterSelectQuery::executeFetchColumns(QueryProcessingStage::Enum proc
 
     UInt64 max_block_size = settings.max_block_size;
 
+    /// If a byte budget for blocks is set, derive the block size in rows from the width of
+    /// the rows we are going to read: wide rows get smaller blocks that fit in CPU caches,
+    /// narrow rows get larger blocks that amortize per-block overheads.
+    if (settings.max_block_size_bytes && storage && storage_snapshot)
+    {
+        UInt64 row_size = estimateRowSizeInMemory(storage_snapshot->getSampleBlockForColumns(required_columns));
+        max_block_size = std::clamp<UInt64>(settings.max_block_size_bytes / row_size, 128, DEFAULT_BLOCK_SIZE * 16);
+    }
+
     auto [limit_length, limit_offset] = getLimitLengthAndOffset(query, context);
 
     auto local_limits = getStorageLimits(*context, options);
@@ -2327,7 +2380,8 @@ void InterpreterSelectQuery::executeFetchColumns(QueryProcessingStage::Enum proc
                         query,
                         query_info.projection->group_by_elements_actions,
                         query_info.projection->group_by_elements_order_descr,
-                        query_info.syntax_analyzer_result);
+                        query_info.syntax_analyzer_result,
+                        /* elements_order_is_free_ */ true);
                 }
                 else
                 {
@@ -2335,7 +2389,8 @@ void InterpreterSelectQuery::executeFetchColumns(QueryProcessingStage::Enum proc
                         query,
                         analysis_result.group_by_elements_actions,
                         getSortDescriptionFromGroupBy(query),
-                        query_info.syntax_analyzer_result);
+                        query_info.syntax_analyzer_result,
+                        /* elements_order_is_free_ */ true);
                 }
             }
 
@@ -2419,7 +2474,7 @@ static Aggregator::Params getAggregatorParams(
         settings.max_entries_for_hash_table_stats,
         settings.max_size_to_preallocate_for_aggregation);
 
-    return Aggregator::Params
+    Aggregator::Params params
     {
         keys,
         aggregates,
@@ -2442,6 +2497,9 @@ static Aggregator::Params getAggregatorParams(
         /* only_merge */ false,
         stats_collecting_params
     };
+
+    params.spill_sorted_runs = settings.external_group_by_sorted_merge;
+    return params;
 }
 
 static GroupingSetsParamsList getAggregatorGroupingSetsParams(const SelectQueryExpressionAnalyzer & query_analyzer, const Names & all_keys)
@@ -2501,8 +2559,19 @@ void InterpreterSelectQuery::executeAggregation(QueryPlan & query_plan, const Ac
 
     if (group_by_info && settings.optimize_aggregation_in_order && !query_analyzer->useGroupingSetKey())
     {
-        group_by_sort_description = getSortDescriptionFromGroupBy(getSelectQuery());
         sort_description_for_merging = group_by_info->sort_description_for_merging;
+
+        /// Group by keys may have been matched with the sorting key in arbitrary order
+        /// (they form an unordered set), but AggregatingInOrderTransform expects the
+        /// matched prefix to be the first elements of the group by sort description.
+        group_by_sort_description = sort_description_for_merging;
+        NameSet merging_columns;
+        for (const auto & column : sort_description_for_merging)
+            merging_columns.insert(column.column_name);
+
+        for (const auto & column : getSortDescriptionFromGroupBy(getSelectQuery()))
+            if (!merging_columns.contains(column.column_name))
+                group_by_sort_description.push_back(column);
     }
     else
         group_by_info = nullptr;
@@ -2731,7 +2800,17 @@ void InterpreterSelectQuery::executeWindow(QueryPlan & query_plan)
             query_plan.addStep(std::move(sorting_step));
         }
 
-        auto window_step = std::make_unique<WindowStep>(query_plan.getCurrentDataStream(), window, window.window_functions);
+        // Process partitions in parallel if nothing downstream relies on the sorting
+        // this window produces: the next window either has its own sort step or does
+        // not exist, so the only consumer of the single sorted stream is this window.
+        bool streams_fan_out = settings.parallel_window_functions && !window.partition_by.empty();
+        if (streams_fan_out && i + 1 < windows_sorted.size())
+        {
+            const auto & next_window = *windows_sorted[i + 1];
+            streams_fan_out = !next_window.full_sort_description.empty() && !sortIsPrefix(next_window, window);
+        }
+
+        auto window_step = std::make_unique<WindowStep>(query_plan.getCurrentDataStream(), window, window.window_functions, streams_fan_out);
         window_step->setStepDescription("Window step for window '" + window.window_name + "'");
 
         query_plan.addStep(std::move(window_step));
@@ -2837,7 +2916,8 @@ void InterpreterSelectQuery::executeDistinct(QueryPlan & query_plan, bool before
             limit_for_distinct,
             columns,
             pre_distinct,
-            settings.optimize_distinct_in_order);
+            settings.optimize_distinct_in_order,
+            settings.parallel_distinct);
 
         if (pre_distinct)
             distinct_step->setStepDescription("Preliminary DISTINCT");
@@ -2878,7 +2958,7 @@ void InterpreterSelectQuery::executePreLimit(QueryPlan & query_plan, bool do_not
 }
 
 
-void InterpreterSelectQuery::executeLimitBy(QueryPlan & query_plan)
+void InterpreterSelectQuery::executeLimitBy(QueryPlan & query_plan, bool do_not_skip_offset)
 {
     auto & query = getSelectQuery();
     if (!query.limitByLength() || !query.limitBy())
@@ -2891,6 +2971,19 @@ void InterpreterSelectQuery::executeLimitBy(QueryPlan & query_plan)
     UInt64 length = getLimitUIntValue(query.limitByLength(), context, "LIMIT");
     UInt64 offset = (query.limitByOffset() ? getLimitUIntValue(query.limitByOffset(), context, "OFFSET") : 0);
 
+    /// For preliminary LIMIT BY on the remote servers the offset cannot be applied: rows of one
+    /// group are spread over the shards, so a row within the offset on one shard may be exactly
+    /// the row the merged result needs. Keep length + offset rows per group and let the
+    /// initiator apply the offset over the merged streams.
+    if (do_not_skip_offset)
+    {
+        if (length > std::numeric_limits<UInt64>::max() - offset)
+            return;
+
+        length += offset;
+        offset = 0;
+    }
+
     auto limit_by = std::make_unique<LimitByStep>(query_plan.getCurrentDataStream(), length, offset, columns);
     query_plan.addStep(std::move(limit_by));
 }
@@ -187,7 +187,7 @@ private:
     void executeWithFill(QueryPlan & query_plan);
     void executeMergeSorted(QueryPlan & query_plan, const std::string & description);
     void executePreLimit(QueryPlan & query_plan, bool do_not_skip_offset);
-    void executeLimitBy(QueryPlan & query_plan);
+    void executeLimitBy(QueryPlan & query_plan, bool do_not_skip_offset);
     void executeLimit(QueryPlan & query_plan);
     void executeOffset(QueryPlan & query_plan);
     static void executeProjection(QueryPlan & query_plan, const ActionsDAGPtr & expression);
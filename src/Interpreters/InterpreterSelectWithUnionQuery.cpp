@@ -10,7 +10,9 @@
 #include <Parsers/ASTSelectWithUnionQuery.h>
 #include <Parsers/ASTSelectIntersectExceptQuery.h>
 #include <Parsers/queryToString.h>
+#include <Interpreters/Cache/QueryResultCache.h>
 #include <Processors/QueryPlan/DistinctStep.h>
+#include <Processors/QueryPlan/DuplicatingStep.h>
 #include <Processors/QueryPlan/ExpressionStep.h>
 #include <Processors/QueryPlan/IQueryPlanStep.h>
 #include <Processors/QueryPlan/QueryPlan.h>
@@ -24,6 +26,7 @@
 #include <Interpreters/InDepthNodeVisitor.h>
 
 #include <algorithm>
+#include <map>
 
 
 namespace DB
@@ -309,23 +312,55 @@ void InterpreterSelectWithUnionQuery::buildQueryPlan(QueryPlan & query_plan)
     }
     else
     {
-        std::vector<std::unique_ptr<QueryPlan>> plans(num_plans);
-        DataStreams data_streams(num_plans);
+        const auto & selects = query_ptr->as<ASTSelectWithUnionQuery &>().list_of_selects->children;
+
+        std::vector<std::unique_ptr<QueryPlan>> plans;
+        plans.reserve(num_plans);
+
+        /// With optimize_identical_union_branches, each set of identical branches is executed
+        /// only once, and the resulting stream is copied to all the consumers. Branches with
+        /// non-deterministic functions are not deduplicated: executing them once would change
+        /// the result.
+        std::map<IAST::Hash, size_t> branch_to_plan;
+        std::vector<size_t> plan_num_copies;
 
         for (size_t i = 0; i < num_plans; ++i)
         {
-            plans[i] = std::make_unique<QueryPlan>();
-            nested_interpreters[i]->buildQueryPlan(*plans[i]);
+            if (settings.optimize_identical_union_branches && !astContainsNonDeterministicFunctions(selects[i], context))
+            {
+                auto [it, inserted] = branch_to_plan.try_emplace(selects[i]->getTreeHash(), plans.size());
+                if (!inserted)
+                {
+                    ++plan_num_copies[it->second];
+                    continue;
+                }
+            }
+
+            plans.emplace_back(std::make_unique<QueryPlan>());
+            plan_num_copies.push_back(1);
+            nested_interpreters[i]->buildQueryPlan(*plans.back());
 
-            if (!blocksHaveEqualStructure(plans[i]->getCurrentDataStream().header, result_header))
+            if (!blocksHaveEqualStructure(plans.back()->getCurrentDataStream().header, result_header))
             {
                 auto actions_dag = ActionsDAG::makeConvertingActions(
-                        plans[i]->getCurrentDataStream().header.getColumnsWithTypeAndName(),
+                        plans.back()->getCurrentDataStream().header.getColumnsWithTypeAndName(),
                         result_header.getColumnsWithTypeAndName(),
                         ActionsDAG::MatchColumnsMode::Position);
-                auto converting_step = std::make_unique<ExpressionStep>(plans[i]->getCurrentDataStream(), std::move(actions_dag));
+                auto converting_step = std::make_unique<ExpressionStep>(plans.back()->getCurrentDataStream(), std::move(actions_dag));
                 converting_step->setStepDescription("Conversion before UNION");
-                plans[i]->addStep(std::move(converting_step));
+                plans.back()->addStep(std::move(converting_step));
+            }
+        }
+
+        DataStreams data_streams(plans.size());
+
+        for (size_t i = 0; i < plans.size(); ++i)
+        {
+            if (plan_num_copies[i] > 1)
+            {
+                auto duplicating_step = std::make_unique<DuplicatingStep>(plans[i]->getCurrentDataStream(), plan_num_copies[i]);
+                duplicating_step->setStepDescription("Copy result of identical UNION branches");
+                plans[i]->addStep(std::move(duplicating_step));
             }
 
             data_streams[i] = plans[i]->getCurrentDataStream();
@@ -348,7 +383,8 @@ void InterpreterSelectWithUnionQuery::buildQueryPlan(QueryPlan & query_plan)
                 0,
                 result_header.getNames(),
                 false,
-                settings.optimize_distinct_in_order);
+                settings.optimize_distinct_in_order,
+                settings.parallel_distinct);
 
             query_plan.addStep(std::move(distinct_step));
         }
@@ -25,10 +25,18 @@
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 #include <llvm/Support/SmallVectorMemoryBuffer.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <filesystem>
 
 #include <base/getPageSize.h>
 #include <Common/Exception.h>
+#include <Common/SipHash.h>
 #include <Common/formatReadable.h>
+#include <Common/hex.h>
+#include <Common/logger_useful.h>
+#include "config_version.h"
 
 
 namespace DB
@@ -364,7 +372,10 @@ CHJIT::CompiledModule CHJIT::compileModule(std::function<void (llvm::Module &)>
 
 std::unique_ptr<llvm::Module> CHJIT::createModuleForCompilation()
 {
-    std::unique_ptr<llvm::Module> module = std::make_unique<llvm::Module>("jit" + std::to_string(current_module_key), context);
+    /// Module name must not depend on the per-instance module counter, otherwise
+    /// the printed IR (and the compiled object cache key derived from it) would
+    /// differ between server runs for the same expression.
+    std::unique_ptr<llvm::Module> module = std::make_unique<llvm::Module>("jit_module", context);
     module->setDataLayout(layout);
     module->setTargetTriple(machine->getTargetTriple().getTriple());
 
@@ -373,12 +384,45 @@ std::unique_ptr<llvm::Module> CHJIT::createModuleForCompilation()
 
 CHJIT::CompiledModule CHJIT::compileModule(std::unique_ptr<llvm::Module> module)
 {
-    runOptimizationPassesOnModule(*module);
+    std::unique_ptr<llvm::MemoryBuffer> buffer;
+    std::string object_file_path;
+    bool loaded_from_cache = false;
 
-    auto buffer = compiler->compile(*module);
+    /// Object code still contains relocations at this point, so it can be written to disk
+    /// and linked again by a future server instance with the same build and CPU.
+    if (!compiled_object_cache_path.empty())
+    {
+        object_file_path = compiled_object_cache_path + "/" + getCompiledObjectCacheKey(*module) + ".o";
+        if (auto cached_buffer = llvm::MemoryBuffer::getFile(object_file_path))
+        {
+            buffer = std::move(*cached_buffer);
+            loaded_from_cache = true;
+        }
+    }
+
+    if (!buffer)
+    {
+        runOptimizationPassesOnModule(*module);
+        buffer = compiler->compile(*module);
+    }
 
     llvm::Expected<std::unique_ptr<llvm::object::ObjectFile>> object = llvm::object::ObjectFile::createObjectFile(*buffer);
 
+    if (!object && loaded_from_cache)
+    {
+        /// Corrupted or truncated cache entry. Remove it and compile from scratch.
+        llvm::consumeError(object.takeError());
+        LOG_WARNING(&Poco::Logger::get("CHJIT"), "Removing invalid compiled object cache file {}", object_file_path);
+
+        std::error_code ignore_error;
+        std::filesystem::remove(object_file_path, ignore_error);
+        loaded_from_cache = false;
+
+        runOptimizationPassesOnModule(*module);
+        buffer = compiler->compile(*module);
+        object = llvm::object::ObjectFile::createObjectFile(*buffer);
+    }
+
     if (!object)
     {
         std::string error_message;
@@ -421,9 +465,57 @@ CHJIT::CompiledModule CHJIT::compileModule(std::unique_ptr<llvm::Module> module)
 
     compiled_code_size.fetch_add(compiled_module.size, std::memory_order_relaxed);
 
+    /// Store the object code after successful linking only, best effort.
+    if (!object_file_path.empty() && !loaded_from_cache)
+    {
+        std::string temporary_file_path = object_file_path + ".tmp." + std::to_string(current_module_key);
+        std::error_code error_code;
+        llvm::raw_fd_ostream out(temporary_file_path, error_code);
+        if (!error_code)
+        {
+            out.write(buffer->getBufferStart(), buffer->getBufferSize());
+            out.close();
+
+            if (!out.has_error())
+                std::filesystem::rename(temporary_file_path, object_file_path, error_code);
+
+            if (out.has_error() || error_code)
+                std::filesystem::remove(temporary_file_path, error_code);
+        }
+
+        if (error_code)
+            LOG_WARNING(&Poco::Logger::get("CHJIT"), "Cannot store compiled object cache file {}: {}", object_file_path, error_code.message());
+    }
+
     return compiled_module;
 }
 
+std::string CHJIT::getCompiledObjectCacheKey(const llvm::Module & module) const
+{
+    std::string module_ir;
+    llvm::raw_string_ostream ir_stream(module_ir);
+    module.print(ir_stream, nullptr);
+    ir_stream.flush();
+
+    /// Object code is valid only for the same server build and the same target CPU.
+    SipHash hash;
+    hash.update(std::string(VERSION_DESCRIBE));
+    hash.update(std::string(VERSION_GITHASH));
+    hash.update(machine->getTargetCPU().str());
+    hash.update(machine->getTargetFeatureString().str());
+    hash.update(module_ir);
+
+    return getHexUIntLowercase(hash.get128());
+}
+
+std::string CHJIT::compiled_object_cache_path;
+
+void CHJIT::setCompiledObjectCachePath(const std::string & path)
+{
+    std::filesystem::create_directories(path);
+    compiled_object_cache_path = path;
+}
+
 void CHJIT::deleteCompiledModule(const CHJIT::CompiledModule & module)
 {
     std::lock_guard<std::mutex> lock(jit_lock);
@@ -87,6 +87,13 @@ public:
       */
     inline size_t getCompiledCodeSize() const { return compiled_code_size.load(std::memory_order_relaxed); }
 
+    /** Enable persistent cache of compiled object code in the specified directory for all CHJIT instances.
+      * Cached objects are keyed by module IR, target CPU and server build, so after a restart hot expressions
+      * are linked from disk instead of being compiled again. Must be called once at server startup
+      * before any module is compiled.
+      */
+    static void setCompiledObjectCachePath(const std::string & path);
+
 private:
 
     std::unique_ptr<llvm::Module> createModuleForCompilation();
@@ -95,6 +102,8 @@ private:
 
     std::string getMangledName(const std::string & name_to_mangle) const;
 
+    std::string getCompiledObjectCacheKey(const llvm::Module & module) const;
+
     void runOptimizationPassesOnModule(llvm::Module & module) const;
 
     static std::unique_ptr<llvm::TargetMachine> getTargetMachine();
@@ -110,6 +119,9 @@ private:
     std::atomic<size_t> compiled_code_size = 0;
     mutable std::mutex jit_lock;
 
+    /// Directory with cached object code, empty means the cache is disabled.
+    static std::string compiled_object_cache_path;
+
 };
 
 }
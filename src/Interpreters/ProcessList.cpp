@@ -13,6 +13,8 @@
 #include <Common/typeid_cast.h>
 #include <Common/Exception.h>
 #include <Common/CurrentThread.h>
+#include <Common/MemoryTracker.h>
+#include <Common/formatReadable.h>
 #include <IO/WriteHelpers.h>
 #include <Common/logger_useful.h>
 #include <chrono>
@@ -134,6 +136,43 @@ ProcessList::insert(const String & query_, const IAST * ast, ContextMutablePtr q
                     "Current: {}, maximum: {}", processes.size(), settings.max_concurrent_queries_for_all_users.toString());
         }
 
+        /** Settings profiles may declare a staged degradation under overload: when the server approaches
+          * its global limits, queries from the corresponding workload class are admitted with fewer threads
+          * or rejected at admission, so the brownout is controlled per profile instead of all queries
+          * uniformly slowing down until they time out.
+          */
+        if (!is_unlimited_query && (settings.overload_max_threads || settings.overload_reject_queries))
+        {
+            bool overloaded = false;
+
+            if (max_size && settings.overload_concurrent_queries_ratio > 0.
+                && processes.size() >= static_cast<size_t>(max_size * settings.overload_concurrent_queries_ratio))
+                overloaded = true;
+
+            const Int64 memory_limit = total_memory_tracker.getHardLimit();
+            const Int64 memory_used = total_memory_tracker.get();
+            if (!overloaded && memory_limit && settings.overload_memory_ratio > 0.
+                && memory_used >= static_cast<Int64>(memory_limit * settings.overload_memory_ratio))
+                overloaded = true;
+
+            if (overloaded)
+            {
+                if (settings.overload_reject_queries)
+                    throw Exception(ErrorCodes::TOO_MANY_SIMULTANEOUS_QUERIES,
+                                    "Server is overloaded ({} running queries, {} memory used), "
+                                    "query is rejected by the settings profile (overload_reject_queries)",
+                                    processes.size(), ReadableSize(memory_used));
+
+                if (settings.overload_max_threads && settings.overload_max_threads < settings.max_threads.value)
+                {
+                    LOG_DEBUG(&Poco::Logger::get("ProcessList"),
+                        "Server is overloaded ({} running queries, {} memory used), lowering max_threads to {} for query {}",
+                        processes.size(), ReadableSize(memory_used), settings.overload_max_threads.value, client_info.current_query_id);
+                    query_context->setSetting("max_threads", settings.overload_max_threads.value);
+                }
+            }
+        }
+
         /** Why we use current user?
           * Because initial one is passed by client and credentials for it is not verified,
           *  and using initial_user for limits will be insecure.
@@ -230,7 +269,10 @@ ProcessList::insert(const String & query_, const IAST * ast, ContextMutablePtr q
                 /// Set up memory profiling
                 thread_group->memory_tracker.setProfilerStep(settings.memory_profiler_step);
                 thread_group->memory_tracker.setSampleProbability(settings.memory_profiler_sample_probability);
+                thread_group->memory_tracker.setSampleMinAllocationSize(settings.memory_profiler_sample_min_allocation_size);
+                thread_group->memory_tracker.setSampleMaxAllocationSize(settings.memory_profiler_sample_max_allocation_size);
                 thread_group->performance_counters.setTraceProfileEvents(settings.trace_profile_events);
+                thread_group->performance_counters.setTraceWaits(settings.trace_waits);
             }
 
             thread_group->memory_tracker.setDescription("(for query)");
@@ -552,10 +594,20 @@ QueryStatusInfo QueryStatus::getInfo(bool get_thread_list, bool get_profile_even
             res.profile_counters = std::make_shared<ProfileEvents::Counters::Snapshot>(thread_group->performance_counters.getPartiallyAtomicSnapshot());
     }
 
-    if (get_settings && getContext())
+    if (auto context = getContext())
     {
-        res.query_settings = std::make_shared<Settings>(getContext()->getSettings());
-        res.current_database = getContext()->getCurrentDatabase();
+        if (auto temp_data = context->getOwnTempDataOnDisk())
+        {
+            const auto & temp_data_stat = temp_data->getStat();
+            res.temporary_data_compressed_bytes = temp_data_stat.compressed_size;
+            res.temporary_data_uncompressed_bytes = temp_data_stat.uncompressed_size;
+        }
+
+        if (get_settings)
+        {
+            res.query_settings = std::make_shared<Settings>(context->getSettings());
+            res.current_database = context->getCurrentDatabase();
+        }
     }
 
     return res;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Core/Block.h>
 #include <Core/Defines.h>
 #include <IO/Progress.h>
 #include <Interpreters/CancellationCode.h>
@@ -21,6 +22,7 @@
 #include <Common/OvercommitTracker.h>
 
 #include <condition_variable>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -60,6 +62,9 @@ struct QueryStatusInfo
     size_t written_bytes;
     Int64 memory_usage;
     Int64 peak_memory_usage;
+    /// Temporary files on disk (spills of aggregation, sorting, joins), written by the query so far.
+    UInt64 temporary_data_compressed_bytes;
+    UInt64 temporary_data_uncompressed_bytes;
     ClientInfo client_info;
     bool is_cancelled;
     bool is_all_data_sent;
@@ -71,6 +76,80 @@ struct QueryStatusInfo
     std::string current_database;
 };
 
+/// Snapshots of intermediate aggregation states of a query, deposited by the aggregating
+/// threads and periodically merged and sent to the client as partial (not final) results.
+/// See the partial_result_update_duration_ms setting.
+struct PartialResultsHolder
+{
+    /// Register an aggregating thread and remember how to merge the deposited blocks.
+    /// Returns the slot for deposits of this thread, or -1 if partial results cannot be
+    /// collected (e.g. the query has several aggregations with different structure).
+    ssize_t registerThread(Block intermediate_header_, std::function<Block(BlocksList &&)> merge_function_)
+    {
+        std::lock_guard lock(mutex);
+
+        if (!merge_function)
+        {
+            intermediate_header = std::move(intermediate_header_);
+            merge_function = std::move(merge_function_);
+        }
+        else if (!blocksHaveEqualStructure(intermediate_header, intermediate_header_))
+            return -1;
+
+        per_thread_blocks.emplace_back();
+        return per_thread_blocks.size() - 1;
+    }
+
+    /// Replace the snapshot of one thread with a more recent one.
+    void deposit(size_t slot, Block block)
+    {
+        std::lock_guard lock(mutex);
+        per_thread_blocks[slot] = std::move(block);
+        ++version;
+    }
+
+    /// Merge the deposited snapshots into one finalized block.
+    /// Returns an empty block if nothing was deposited since 'last_version'.
+    Block mergeAndGet(UInt64 & last_version)
+    {
+        BlocksList blocks;
+        std::function<Block(BlocksList &&)> merge;
+
+        {
+            std::lock_guard lock(mutex);
+
+            if (version == last_version || !merge_function)
+                return {};
+            last_version = version;
+
+            for (const auto & block : per_thread_blocks)
+                if (block.rows())
+                    blocks.push_back(block);
+
+            merge = merge_function;
+        }
+
+        if (blocks.empty())
+            return {};
+
+        /// Merging is done outside the lock: the blocks were copied (columns are shared),
+        /// so the aggregating threads are not blocked for the duration of the merge.
+        return merge(std::move(blocks));
+    }
+
+private:
+    std::mutex mutex;
+    /// One slot per aggregating thread; a deposit replaces the previous snapshot of the thread.
+    std::vector<Block> per_thread_blocks;
+    Block intermediate_header;
+    std::function<Block(BlocksList &&)> merge_function;
+    /// Incremented on every deposit so that the sender can skip unchanged state.
+    UInt64 version = 0;
+};
+
+using PartialResultsHolderPtr = std::shared_ptr<PartialResultsHolder>;
+
+
 /// Query and information about its execution.
 class QueryStatus : public WithContext
 {
@@ -136,6 +215,10 @@ protected:
 
     IAST::QueryKind query_kind;
 
+    /// Exchange point of intermediate aggregation results between the aggregating threads
+    /// and the connection thread that sends them to the client.
+    PartialResultsHolderPtr partial_results_holder = std::make_shared<PartialResultsHolder>();
+
     /// This field is unused in this class, but it
     /// increments/decrements metric in constructor/destructor.
     CurrentMetrics::Increment num_queries_increment;
@@ -222,6 +305,8 @@ public:
 
     /// Get the reference for the start of the query. Used to synchronize with other Stopwatches
     UInt64 getQueryCPUStartTime() { return watch.getStart(); }
+
+    PartialResultsHolderPtr getPartialResultsHolder() const { return partial_results_holder; }
 };
 
 using QueryStatusPtr = std::shared_ptr<QueryStatus>;
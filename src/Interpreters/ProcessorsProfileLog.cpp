@@ -9,6 +9,8 @@
 #include <DataTypes/DataTypesNumber.h>
 #include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypeArray.h>
+#include <DataTypes/DataTypeMap.h>
+#include <Interpreters/ProfileEventsExt.h>
 #include <Common/logger_useful.h>
 
 #include <array>
@@ -38,6 +40,8 @@ NamesAndTypesList ProcessorProfileLogElement::getNamesAndTypes()
         {"input_bytes", std::make_shared<DataTypeUInt64>()},
         {"output_rows", std::make_shared<DataTypeUInt64>()},
         {"output_bytes", std::make_shared<DataTypeUInt64>()},
+
+        {"ProfileEvents", std::make_shared<DataTypeMap>(std::make_shared<DataTypeString>(), std::make_shared<DataTypeUInt64>())},
     };
 }
 
@@ -69,6 +73,14 @@ void ProcessorProfileLogElement::appendToBlock(MutableColumns & columns) const
     columns[i++]->insert(input_bytes);
     columns[i++]->insert(output_rows);
     columns[i++]->insert(output_bytes);
+
+    {
+        auto * column = columns[i++].get();
+        if (profile_counters)
+            ProfileEvents::dumpToMapColumn(*profile_counters, column, true);
+        else
+            column->insertDefault();
+    }
 }
 
 ProcessorsProfileLog::ProcessorsProfileLog(ContextPtr context_, const String & database_name_,
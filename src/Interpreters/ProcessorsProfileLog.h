@@ -34,6 +34,10 @@ struct ProcessorProfileLogElement
     size_t output_rows{};
     size_t output_bytes{};
 
+    /// Events accumulated while the processor was working, including hardware
+    /// counters if metrics_perf_events_enabled is set.
+    std::shared_ptr<ProfileEvents::Counters::Snapshot> profile_counters;
+
     static std::string name() { return "ProcessorsProfileLog"; }
     static NamesAndTypesList getNamesAndTypes();
     static NamesAndAliases getNamesAndAliases() { return {}; }
@@ -0,0 +1,107 @@
+#include <Interpreters/RewriteArrayFunctionChainsVisitor.h>
+#include <Parsers/ASTFunction.h>
+#include <Common/typeid_cast.h>
+
+namespace DB
+{
+
+namespace
+{
+
+/// Outer functions which reduce an array to a scalar and have a variant taking a lambda.
+const std::unordered_map<String, String> fusable_over_array_map =
+{
+    {"arraySum", "arraySum"},
+    {"arrayAvg", "arrayAvg"},
+    {"arrayMin", "arrayMin"},
+    {"arrayMax", "arrayMax"},
+    {"arrayCount", "arrayCount"},
+    {"arrayExists", "arrayExists"},
+    {"arrayAll", "arrayAll"},
+};
+
+/// Outer functions whose result depends only on the number of elements kept by arrayFilter.
+const std::unordered_map<String, String> fusable_over_array_filter =
+{
+    {"length", "arrayCount"},
+    {"notEmpty", "arrayExists"},
+};
+
+/// Returns the inner function if it is a call of `name` with a lambda as the first of >= 2 arguments
+/// and can be folded into its parent (i.e. nothing else references its result via an alias).
+const ASTFunction * getFusableInnerFunction(const ASTPtr & argument, const String & name)
+{
+    const auto * inner = argument->as<ASTFunction>();
+    if (!inner || inner->name != name || !inner->arguments || inner->arguments->children.size() < 2)
+        return nullptr;
+
+    if (!inner->tryGetAlias().empty())
+        return nullptr;
+
+    const auto * lambda = inner->arguments->children[0]->as<ASTFunction>();
+    if (!lambda || lambda->name != "lambda")
+        return nullptr;
+
+    return inner;
+}
+
+ASTPtr fuse(const String & new_name, const ASTFunction & inner)
+{
+    auto new_func = std::make_shared<ASTFunction>();
+    new_func->name = new_name;
+    new_func->arguments = inner.arguments->clone();
+    new_func->children.push_back(new_func->arguments);
+    return new_func;
+}
+
+}
+
+void RewriteArrayFunctionChainsMatcher::visit(ASTPtr & ast, Data & data)
+{
+    if (auto * func = ast->as<ASTFunction>())
+        visit(*func, ast, data);
+}
+
+void RewriteArrayFunctionChainsMatcher::visit(const ASTFunction & func, ASTPtr & ast, Data &)
+{
+    /// All rewrites apply to single-argument calls whose argument is the function being fused away.
+    if (!func.arguments || func.arguments->children.size() != 1)
+        return;
+
+    if (auto it = fusable_over_array_map.find(func.name); it != fusable_over_array_map.end())
+    {
+        /// arraySum(arrayMap(f, arr...)) -> arraySum(f, arr...)
+        if (const auto * inner = getFusableInnerFunction(func.arguments->children[0], "arrayMap"))
+        {
+            auto new_func = fuse(it->second, *inner);
+            new_func->setAlias(func.alias);
+            ast = std::move(new_func);
+        }
+        return;
+    }
+
+    if (auto it = fusable_over_array_filter.find(func.name); it != fusable_over_array_filter.end())
+    {
+        /// length(arrayFilter(p, arr...)) -> arrayCount(p, arr...)
+        if (const auto * inner = getFusableInnerFunction(func.arguments->children[0], "arrayFilter"))
+        {
+            auto new_func = fuse(it->second, *inner);
+            new_func->setAlias(func.alias);
+            ast = std::move(new_func);
+        }
+        return;
+    }
+
+    if (func.name == "empty")
+    {
+        /// empty(arrayFilter(p, arr...)) -> not(arrayExists(p, arr...))
+        if (const auto * inner = getFusableInnerFunction(func.arguments->children[0], "arrayFilter"))
+        {
+            auto new_func = makeASTFunction("not", fuse("arrayExists", *inner));
+            new_func->setAlias(func.alias);
+            ast = std::move(new_func);
+        }
+    }
+}
+
+}
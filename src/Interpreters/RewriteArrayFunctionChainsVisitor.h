@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Parsers/IAST.h>
+#include <Interpreters/InDepthNodeVisitor.h>
+
+namespace DB
+{
+
+class ASTFunction;
+
+/// Fuse chains of higher-order array functions so that the intermediate array is never materialized.
+/// The aggregating combinators accept a lambda themselves, so the inner arrayMap/arrayFilter can be
+/// folded into them:
+///     arraySum(arrayMap(f, arr...))   -> arraySum(f, arr...)   (same for arrayAvg/Min/Max/Count/Exists/All)
+///     length(arrayFilter(p, arr...))  -> arrayCount(p, arr...)
+///     notEmpty(arrayFilter(p, arr...)) -> arrayExists(p, arr...)
+///     empty(arrayFilter(p, arr...))   -> not(arrayExists(p, arr...))
+class RewriteArrayFunctionChainsMatcher
+{
+public:
+    struct Data
+    {
+    };
+
+    static void visit(ASTPtr & ast, Data &);
+    static void visit(const ASTFunction &, ASTPtr & ast, Data &);
+    static bool needChildVisit(const ASTPtr &, const ASTPtr &) { return true; }
+};
+
+using RewriteArrayFunctionChainsVisitor = InDepthNodeVisitor<RewriteArrayFunctionChainsMatcher, false>;
+
+}
@@ -91,7 +91,13 @@ void RewriteFunctionToSubcolumnData::visit(ASTFunction & function, ASTPtr & ast)
         if (it != unary_function_to_subcolumn.end())
         {
             const auto & [type_id, subcolumn_name, transformer] = it->second;
-            if (column_type_id == type_id)
+
+            /// Map is serialized as a nested Array(Tuple(keys, values)),
+            /// so it shares the size0 subcolumn with arrays and length/empty/notEmpty apply to it as well.
+            bool type_matches = column_type_id == type_id
+                || (type_id == TypeIndex::Array && column_type_id == TypeIndex::Map);
+
+            if (type_matches)
             {
                 ast = transformer(name_in_storage, subcolumn_name);
                 ast->setAlias(alias);
@@ -18,6 +18,8 @@
 #include <Storages/StorageMergeTree.h>
 #include <Storages/StorageReplicatedMergeTree.h>
 #include <Storages/MarkCache.h>
+#include <Storages/ColumnsCache.h>
+#include <Storages/QueryConditionCache.h>
 
 #include <Coordination/KeeperAsynchronousMetrics.h>
 
@@ -62,6 +64,18 @@ void ServerAsynchronousMetrics::updateImpl(AsynchronousMetricValues & new_values
         new_values["MarkCacheFiles"] = { mark_cache->count(), "Total number of mark files cached in the mark cache" };
     }
 
+    if (auto columns_cache = getContext()->getColumnsCache())
+    {
+        new_values["ColumnsCacheBytes"] = { columns_cache->weight(), "Total size of the cache of deserialized columns in bytes." };
+        new_values["ColumnsCacheCells"] = { columns_cache->count(), "Total number of column ranges cached in the cache of deserialized columns." };
+    }
+
+    if (auto query_condition_cache = getContext()->getQueryConditionCache())
+    {
+        new_values["QueryConditionCacheBytes"] = { query_condition_cache->weight(), "Total size of the query condition cache in bytes." };
+        new_values["QueryConditionCacheEntries"] = { query_condition_cache->count(), "Total number of (part, condition) entries in the query condition cache." };
+    }
+
     if (auto uncompressed_cache = getContext()->getUncompressedCache())
     {
         new_values["UncompressedCacheBytes"] = { uncompressed_cache->weight(),
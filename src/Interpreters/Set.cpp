@@ -5,6 +5,7 @@
 #include <Columns/ColumnsNumber.h>
 #include <Columns/ColumnTuple.h>
 
+#include <Common/BitHelpers.h>
 #include <Common/typeid_cast.h>
 
 #include <DataTypes/DataTypeTuple.h>
@@ -97,6 +98,10 @@ void NO_INLINE Set::insertFromBlockImplCase(
 
         [[maybe_unused]] auto emplace_result = state.emplaceKey(method.data, i, variants.string_pool);
 
+        /// The bloom filter exists only if the set was already created, i.e. on the inserts into StorageSet.
+        if (!bloom_filter.empty())
+            bloomFilterAdd(state.getHash(method.data, i, variants.string_pool));
+
         if constexpr (build_filter)
             (*out_filter)[i] = emplace_result.isInserted();
     }
@@ -237,6 +242,51 @@ bool Set::insertFromBlock(const Columns & columns)
 }
 
 
+void Set::finishInsert()
+{
+    {
+        std::lock_guard lock(rwlock);
+        buildBloomFilter();
+    }
+    is_created = true;
+}
+
+
+template <typename Method>
+void NO_INLINE Set::buildBloomFilterImpl(Method & method)
+{
+    for (auto it = method.data.begin(); it != method.data.end(); ++it)
+        bloomFilterAdd(it.getHash());
+}
+
+void Set::buildBloomFilter()
+{
+    size_t rows = data.getTotalRowCount();
+    if (rows < min_rows_for_bloom_filter)
+        return;
+
+    /// One byte per key, but not beyond the typical size of the L2 cache:
+    /// the filter pays off only as long as probing it is much cheaper than probing the hash table.
+    size_t bytes = std::clamp(roundUpToPowerOfTwoOrZero(rows), min_bloom_filter_bytes, max_bloom_filter_bytes);
+    bloom_filter.clear();
+    bloom_filter.resize(bytes / sizeof(UInt64));
+
+    switch (data.type)
+    {
+        case SetVariants::Type::EMPTY:
+            break;
+#define M(NAME) \
+        case SetVariants::Type::NAME: \
+            buildBloomFilterImpl(*data.NAME); \
+            break;
+        APPLY_FOR_SET_VARIANTS(M)
+#undef M
+    }
+
+    LOG_TRACE(log, "Built bloom filter of {} bytes for set of {} rows", bytes, rows);
+}
+
+
 ColumnPtr Set::execute(const ColumnsWithTypeAndName & columns, bool negative) const
 {
     size_t num_key_columns = columns.size();
@@ -353,6 +403,8 @@ void NO_INLINE Set::executeImplCase(
     Arena pool;
     typename Method::State state(key_columns, key_sizes, nullptr);
 
+    const bool use_bloom_filter = !bloom_filter.empty();
+
     /// NOTE Optimization is not used for consecutive identical strings.
 
     /// For all rows
@@ -362,6 +414,11 @@ void NO_INLINE Set::executeImplCase(
         {
             vec_res[i] = negative;
         }
+        else if (use_bloom_filter && !bloomFilterContains(state.getHash(method.data, i, pool)))
+        {
+            /// Definitely not in the set, no need to touch the hash table.
+            vec_res[i] = negative;
+        }
         else
         {
             auto find_result = state.findKey(method.data, i, pool);
@@ -50,7 +50,7 @@ public:
     bool insertFromBlock(const ColumnsWithTypeAndName & columns);
 
     /// Call after all blocks were inserted. To get the information that set is already created.
-    void finishInsert() { is_created = true; }
+    void finishInsert();
 
     /// finishInsert and isCreated are thread-safe
     bool isCreated() const { return is_created.load(); }
@@ -117,6 +117,40 @@ private:
     /// Check if set contains all the data.
     std::atomic<bool> is_created = false;
 
+    /** A compact pre-filter checked before probing the hash table.
+      * For a large set the exact probe is bound by cache misses, and for miss-heavy columns
+      * most rows can be rejected by the filter, which is sized to stay in the L2 cache.
+      * Built once after the set is created; updated on later inserts into StorageSet.
+      */
+    static constexpr size_t min_rows_for_bloom_filter = 1024 * 1024;
+    static constexpr size_t min_bloom_filter_bytes = 256 * 1024;
+    static constexpr size_t max_bloom_filter_bytes = 2 * 1024 * 1024;
+
+    std::vector<UInt64> bloom_filter;
+
+    /// Two bits in one word of the filter, so that a probe costs a single memory access.
+    static UInt64 bloomFilterBits(size_t hash)
+    {
+        return (1ULL << (hash & 63)) | (1ULL << ((hash >> 6) & 63));
+    }
+
+    void bloomFilterAdd(size_t hash)
+    {
+        bloom_filter[(hash >> 12) & (bloom_filter.size() - 1)] |= bloomFilterBits(hash);
+    }
+
+    bool bloomFilterContains(size_t hash) const
+    {
+        UInt64 bits = bloomFilterBits(hash);
+        return (bloom_filter[(hash >> 12) & (bloom_filter.size() - 1)] & bits) == bits;
+    }
+
+    /// Fills the bloom filter with the hashes of all the keys of the hash table.
+    void buildBloomFilter();
+
+    template <typename Method>
+    void buildBloomFilterImpl(Method & method);
+
     /// If in the left part columns contains the same types as the elements of the set.
     void executeOrdinary(
         const ColumnRawPtrs & key_columns,
@@ -35,43 +35,35 @@ Block SquashingTransform::addImpl(ReferenceType input_block)
 {
     /// End of input stream.
     if (!input_block)
-    {
-        Block to_return;
-        std::swap(to_return, accumulated_block);
-        return to_return;
-    }
+        return flush();
 
     /// Just read block is already enough.
     if (isEnoughSize(input_block))
     {
         /// If no accumulated data, return just read block.
-        if (!accumulated_block)
+        if (accumulated_blocks.empty())
         {
             return std::move(input_block);
         }
 
         /// Return accumulated data (maybe it has small size) and place new block to accumulated data.
-        Block to_return = std::move(input_block);
-        std::swap(to_return, accumulated_block);
+        Block to_return = flush();
+        append<ReferenceType>(std::move(input_block));
         return to_return;
     }
 
     /// Accumulated block is already enough.
-    if (isEnoughSize(accumulated_block))
+    if (isEnoughSize(accumulated_rows, accumulated_bytes))
     {
         /// Return accumulated data and place new block to accumulated data.
-        Block to_return = std::move(input_block);
-        std::swap(to_return, accumulated_block);
+        Block to_return = flush();
+        append<ReferenceType>(std::move(input_block));
         return to_return;
     }
 
     append<ReferenceType>(std::move(input_block));
-    if (isEnoughSize(accumulated_block))
-    {
-        Block to_return;
-        std::swap(to_return, accumulated_block);
-        return to_return;
-    }
+    if (isEnoughSize(accumulated_rows, accumulated_bytes))
+        return flush();
 
     /// Squashed block is not ready.
     return {};
@@ -81,22 +73,47 @@ Block SquashingTransform::addImpl(ReferenceType input_block)
 template <typename ReferenceType>
 void SquashingTransform::append(ReferenceType input_block)
 {
-    if (!accumulated_block)
-    {
-        accumulated_block = std::move(input_block);
-        return;
-    }
+    assert(accumulated_blocks.empty() || blocksHaveEqualStructure(input_block, accumulated_blocks.front()));
 
-    assert(blocksHaveEqualStructure(input_block, accumulated_block));
+    accumulated_rows += input_block.rows();
+    for (const auto & elem : input_block)
+        accumulated_bytes += elem.column->byteSize();
+
+    /// No data is copied here: the block only shares the column pointers with its source.
+    accumulated_blocks.push_back(std::move(input_block));
+}
 
-    for (size_t i = 0, size = accumulated_block.columns(); i < size; ++i)
+
+Block SquashingTransform::flush()
+{
+    if (accumulated_blocks.empty())
+        return {};
+
+    Block to_return = std::move(accumulated_blocks.front());
+
+    /// If only one block was accumulated, return it as is, without copying the data.
+    if (accumulated_blocks.size() > 1)
     {
-        const auto source_column = input_block.getByPosition(i).column;
+        for (size_t i = 0, size = to_return.columns(); i < size; ++i)
+        {
+            auto mutable_column = IColumn::mutate(std::move(to_return.getByPosition(i).column));
+            mutable_column->reserve(accumulated_rows);
 
-        auto mutable_column = IColumn::mutate(std::move(accumulated_block.getByPosition(i).column));
-        mutable_column->insertRangeFrom(*source_column, 0, source_column->size());
-        accumulated_block.getByPosition(i).column = std::move(mutable_column);
+            for (size_t block_idx = 1; block_idx < accumulated_blocks.size(); ++block_idx)
+            {
+                const auto & source_column = accumulated_blocks[block_idx].getByPosition(i).column;
+                mutable_column->insertRangeFrom(*source_column, 0, source_column->size());
+            }
+
+            to_return.getByPosition(i).column = std::move(mutable_column);
+        }
     }
+
+    accumulated_blocks.clear();
+    accumulated_rows = 0;
+    accumulated_bytes = 0;
+
+    return to_return;
 }
 
 
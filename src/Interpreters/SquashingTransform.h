@@ -35,7 +35,11 @@ private:
     size_t min_block_size_rows;
     size_t min_block_size_bytes;
 
-    Block accumulated_block;
+    /// Source blocks are accumulated as is (only the column pointers are stored, which is free),
+    /// and their columns are concatenated once, when the squashed block is returned.
+    std::vector<Block> accumulated_blocks;
+    size_t accumulated_rows = 0;
+    size_t accumulated_bytes = 0;
 
     template <typename ReferenceType>
     Block addImpl(ReferenceType block);
@@ -43,6 +47,9 @@ private:
     template <typename ReferenceType>
     void append(ReferenceType block);
 
+    /// Concatenate the accumulated blocks into one and reset the accumulator.
+    Block flush();
+
     bool isEnoughSize(const Block & block);
     bool isEnoughSize(size_t rows, size_t bytes) const;
 };
@@ -4,6 +4,7 @@
 #include <IO/ReadBufferFromFile.h>
 #include <Compression/CompressedWriteBuffer.h>
 #include <Compression/CompressedReadBuffer.h>
+#include <Compression/CompressionFactory.h>
 #include <Formats/NativeWriter.h>
 #include <Formats/NativeReader.h>
 #include <Core/ProtocolDefines.h>
@@ -110,17 +111,17 @@ bool TemporaryDataOnDisk::empty() const
 
 struct TemporaryFileStream::OutputWriter
 {
-    OutputWriter(const String & path, const Block & header_)
+    OutputWriter(const String & path, const Block & header_, CompressionCodecPtr codec)
         : out_buf(std::make_unique<WriteBufferFromFile>(path))
-        , out_compressed_buf(*out_buf)
+        , out_compressed_buf(*out_buf, std::move(codec))
         , out_writer(out_compressed_buf, DBMS_TCP_PROTOCOL_VERSION, header_)
     {
         LOG_TEST(&Poco::Logger::get("TemporaryFileStream"), "Writing to {}", path);
     }
 
-    OutputWriter(std::unique_ptr<WriteBufferToFileSegment> out_buf_, const Block & header_)
+    OutputWriter(std::unique_ptr<WriteBufferToFileSegment> out_buf_, const Block & header_, CompressionCodecPtr codec)
         : out_buf(std::move(out_buf_))
-        , out_compressed_buf(*out_buf)
+        , out_compressed_buf(*out_buf, std::move(codec))
         , out_writer(out_compressed_buf, DBMS_TCP_PROTOCOL_VERSION, header_)
     {
         LOG_TEST(&Poco::Logger::get("TemporaryFileStream"),
@@ -214,7 +215,8 @@ TemporaryFileStream::TemporaryFileStream(TemporaryFileOnDiskHolder file_, const
     : parent(parent_)
     , header(header_)
     , file(std::move(file_))
-    , out_writer(std::make_unique<OutputWriter>(file->getPath(), header))
+    , out_writer(std::make_unique<OutputWriter>(
+        file->getPath(), header, CompressionCodecFactory::instance().get(parent->compression_codec, {})))
 {
 }
 
@@ -227,7 +229,8 @@ TemporaryFileStream::TemporaryFileStream(FileSegmentsHolder && segments_, const
         throw Exception(ErrorCodes::LOGICAL_ERROR, "TemporaryFileStream can be created only from single segment");
     auto & segment = segment_holder.file_segments.front();
     auto out_buf = std::make_unique<WriteBufferToFileSegment>(segment.get());
-    out_writer = std::make_unique<OutputWriter>(std::move(out_buf), header);
+    out_writer = std::make_unique<OutputWriter>(
+        std::move(out_buf), header, CompressionCodecFactory::instance().get(parent->compression_codec, {}));
 }
 
 size_t TemporaryFileStream::write(const Block & block)
@@ -58,6 +58,8 @@ public:
     /// Refactor all code that uses volume directly to use TemporaryDataOnDisk.
     VolumePtr getVolume() const { return volume; }
 
+    const StatAtomic & getStat() const { return stat; }
+
 protected:
     void deltaAllocAndCheck(ssize_t compressed_delta, ssize_t uncompressed_delta);
 
@@ -92,6 +94,9 @@ public:
         , current_metric_scope(metric_scope)
     {}
 
+    /// Codec used to compress newly created streams, LZ4 if not set (see setting `temporary_files_codec`).
+    void setCompressionCodec(const String & codec_) { compression_codec = codec_; }
+
     /// If max_file_size > 0, then check that there's enough space on the disk and throw an exception in case of lack of free space
     TemporaryFileStream & createStream(const Block & header, size_t max_file_size = 0);
 
@@ -107,6 +112,8 @@ private:
     mutable std::mutex mutex;
     std::vector<TemporaryFileStreamPtr> streams TSA_GUARDED_BY(mutex);
 
+    String compression_codec = "LZ4";
+
     typename CurrentMetrics::Value current_metric_scope = CurrentMetrics::TemporaryFilesUnknown;
 };
 
@@ -22,6 +22,7 @@ const TraceDataType::Values TraceLogElement::trace_values =
     {"MemorySample", static_cast<UInt8>(TraceType::MemorySample)},
     {"MemoryPeak", static_cast<UInt8>(TraceType::MemoryPeak)},
     {"ProfileEvent", static_cast<UInt8>(TraceType::ProfileEvent)},
+    {"Wait", static_cast<UInt8>(TraceType::Wait)},
 };
 
 NamesAndTypesList TraceLogElement::getNamesAndTypes()
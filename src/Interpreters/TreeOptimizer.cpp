@@ -38,6 +38,7 @@
 #include <Storages/IStorage.h>
 
 #include <Interpreters/RewriteSumIfFunctionVisitor.h>
+#include <Interpreters/RewriteArrayFunctionChainsVisitor.h>
 
 namespace DB
 {
@@ -658,6 +659,12 @@ void optimizeSumIfFunctions(ASTPtr & query)
     RewriteSumIfFunctionVisitor(data).visit(query);
 }
 
+void optimizeArrayFunctionChains(ASTPtr & query)
+{
+    RewriteArrayFunctionChainsVisitor::Data data = {};
+    RewriteArrayFunctionChainsVisitor(data).visit(query);
+}
+
 void optimizeMultiIfToIf(ASTPtr & query)
 {
     OptimizeMultiIfToIfVisitor::Data data;
@@ -694,6 +701,100 @@ void optimizeOrLikeChain(ASTPtr & query)
     ConvertFunctionOrLikeVisitor(data).visit(query);
 }
 
+/** Fuse several dictGet calls over the same dictionary and key into one multi-attribute call:
+  * dictGet('dict', 'a', key) becomes tupleElement(dictGet('dict', tuple('a', 'b'), key), 1).
+  * All the rewritten calls share the text of the inner multi-attribute call, so the expression
+  * actions calculate it once, and the dictionary is probed once per key instead of once per
+  * requested attribute.
+  */
+
+/// Attribute names requested from one dictionary with one key expression,
+/// in the order of the first appearance.
+using FusedDictGetGroups = std::map<std::pair<String, String>, Strings>;
+
+const ASTFunction * getFusableDictGet(const IAST * node)
+{
+    const auto * func = node->as<ASTFunction>();
+    if (!func || func->name != "dictGet" || !func->arguments || func->arguments->children.size() != 3)
+        return nullptr;
+
+    /// Only a single attribute given as a constant string can be fused into a tuple of attributes.
+    const auto * attribute = func->arguments->children[1]->as<ASTLiteral>();
+    if (!attribute || attribute->value.getType() != Field::Types::String)
+        return nullptr;
+
+    return func;
+}
+
+void collectFusableDictGetCalls(const ASTPtr & node, FusedDictGetGroups & groups)
+{
+    /// Subqueries are optimized on their own.
+    if (!node || node->as<ASTSubquery>())
+        return;
+
+    if (const auto * func = getFusableDictGet(node.get()))
+    {
+        const auto & arguments = func->arguments->children;
+        const String & attribute = arguments[1]->as<ASTLiteral>()->value.safeGet<String>();
+
+        auto & attributes = groups[{arguments[0]->getColumnName(), arguments[2]->getColumnName()}];
+        if (std::find(attributes.begin(), attributes.end(), attribute) == attributes.end())
+            attributes.push_back(attribute);
+    }
+
+    for (const auto & child : node->children)
+        collectFusableDictGetCalls(child, groups);
+}
+
+void rewriteFusableDictGetCalls(ASTPtr & node, const FusedDictGetGroups & groups)
+{
+    if (!node || node->as<ASTSubquery>())
+        return;
+
+    if (const auto * func = getFusableDictGet(node.get()))
+    {
+        const auto & arguments = func->arguments->children;
+        auto it = groups.find({arguments[0]->getColumnName(), arguments[2]->getColumnName()});
+        if (it != groups.end() && it->second.size() > 1)
+        {
+            const Strings & attributes = it->second;
+            const String & attribute = arguments[1]->as<ASTLiteral>()->value.safeGet<String>();
+            size_t attribute_index = std::find(attributes.begin(), attributes.end(), attribute) - attributes.begin();
+
+            auto attributes_tuple = makeASTFunction("tuple");
+            for (const auto & attribute_name : attributes)
+                attributes_tuple->arguments->children.push_back(std::make_shared<ASTLiteral>(attribute_name));
+
+            auto fused_dict_get = makeASTFunction("dictGet", arguments[0]->clone(), attributes_tuple, arguments[2]->clone());
+            auto replacement = makeASTFunction("tupleElement", fused_dict_get, std::make_shared<ASTLiteral>(static_cast<UInt64>(attribute_index + 1)));
+
+            /// Keep the name of the result column.
+            replacement->setAlias(node->getAliasOrColumnName());
+            node = replacement;
+        }
+    }
+
+    /// The recursion also visits the arguments of the fused call inserted above,
+    /// so nested fusable calls inside the key expression are rewritten consistently.
+    for (auto & child : node->children)
+        rewriteFusableDictGetCalls(child, groups);
+}
+
+void optimizeFuseDictGetCalls(ASTPtr & query)
+{
+    FusedDictGetGroups groups;
+    collectFusableDictGetCalls(query, groups);
+
+    for (const auto & group : groups)
+    {
+        if (group.second.size() > 1)
+        {
+            rewriteFusableDictGetCalls(query, groups);
+            break;
+        }
+    }
+}
+
 }
 
 void TreeOptimizer::optimizeIf(ASTPtr & query, Aliases & aliases, bool if_chain_to_multiif)
@@ -787,9 +888,17 @@ void TreeOptimizer::apply(ASTPtr & query, TreeRewriterResult & result,
     if (settings.optimize_multiif_to_if)
         optimizeMultiIfToIf(query);
 
+    /// Fuse dictGet calls over the same dictionary and key into one multi-attribute call
+    if (settings.optimize_fuse_dict_get)
+        optimizeFuseDictGetCalls(query);
+
     if (settings.optimize_rewrite_sum_if_to_count_if)
         optimizeSumIfFunctions(query);
 
+    /// Fuse chains of higher-order array functions to avoid materializing intermediate arrays
+    if (settings.optimize_fuse_array_functions)
+        optimizeArrayFunctionChains(query);
+
     /// Remove injective functions inside uniq
     if (settings.optimize_injective_functions_inside_uniq)
         optimizeInjectiveFunctionsInsideUniq(query, context);
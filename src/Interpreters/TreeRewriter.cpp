@@ -1042,19 +1042,29 @@ void TreeRewriterResult::collectUsedColumns(const ASTPtr & query, bool is_select
     }
     else if (is_select && storage_snapshot && !columns_context.has_array_join)
     {
+        /// count() may be answered from part metadata given only partition predicates, and from
+        /// the primary index given primary key predicates that are constant within every part
+        /// (see MergeTreeData::totalRowsByPartitionPredicateImpl). Otherwise the storage returns
+        /// nothing and the query is executed normally.
+        Names key_source_columns;
         const auto & partition_desc = storage_snapshot->metadata->getPartitionKey();
         if (partition_desc.expression)
+            key_source_columns = partition_desc.expression->getRequiredColumns();
+        const auto & primary_key_desc = storage_snapshot->metadata->getPrimaryKey();
+        if (primary_key_desc.expression)
+            for (const auto & primary_key_column : primary_key_desc.expression->getRequiredColumns())
+                key_source_columns.push_back(primary_key_column);
+        if (!key_source_columns.empty())
         {
-            auto partition_source_columns = partition_desc.expression->getRequiredColumns();
-            partition_source_columns.push_back("_part");
-            partition_source_columns.push_back("_partition_id");
-            partition_source_columns.push_back("_part_uuid");
-            partition_source_columns.push_back("_partition_value");
+            key_source_columns.push_back("_part");
+            key_source_columns.push_back("_partition_id");
+            key_source_columns.push_back("_part_uuid");
+            key_source_columns.push_back("_partition_value");
             optimize_trivial_count = true;
             for (const auto & required_column : required)
             {
-                if (std::find(partition_source_columns.begin(), partition_source_columns.end(), required_column)
-                    == partition_source_columns.end())
+                if (std::find(key_source_columns.begin(), key_source_columns.end(), required_column)
+                    == key_source_columns.end())
                 {
                     optimize_trivial_count = false;
                     break;
@@ -186,7 +186,8 @@ public:
     Status prepare() override;
 
 private:
-    static Strings getChildrenAllowNoNode(const std::shared_ptr<zkutil::ZooKeeper> & zookeeper, const String & node_path);
+    static Strings getChildrenAllowNoNode(
+        const std::shared_ptr<zkutil::ZooKeeper> & zookeeper, const String & node_path, const zkutil::EventPtr & watch = nullptr);
 
     static Block getSampleBlock(ContextPtr context_, bool hosts_to_wait);
 
@@ -211,6 +212,10 @@ private:
     Stopwatch watch;
     Poco::Logger * log;
 
+    /// Is set by the watch on the list of finished hosts, so that we wake up as soon as
+    /// some host finishes instead of sleeping for the whole polling interval.
+    zkutil::EventPtr finished_event = std::make_shared<Poco::Event>();
+
     NameSet waiting_hosts;  /// hosts from task host list
     NameSet finished_hosts; /// finished hosts from host list
     NameSet ignoring_hosts; /// appeared hosts that are not in hosts list
@@ -415,7 +420,10 @@ Chunk DDLQueryStatusSource::generate()
 
         if (num_hosts_finished != 0 || try_number != 0)
         {
-            sleepForMilliseconds(std::min<size_t>(1000, 50 * (try_number + 1)));
+            /// An event with a bounded timeout instead of a plain sleep: the watch set below wakes us up
+            /// as soon as a host finishes. The timeout is left as a fallback (a watch can be lost together
+            /// with the session) and to check for cancellation and the DDL task timeout periodically.
+            finished_event->tryWait(std::min<size_t>(1000, 50 * (try_number + 1)));
         }
 
         if (!zookeeper->exists(node_path))
@@ -432,7 +440,7 @@ Chunk DDLQueryStatusSource::generate()
             return {};
         }
 
-        Strings new_hosts = getNewAndUpdate(getChildrenAllowNoNode(zookeeper, fs::path(node_path) / node_to_wait));
+        Strings new_hosts = getNewAndUpdate(getChildrenAllowNoNode(zookeeper, fs::path(node_path) / node_to_wait, finished_event));
         ++try_number;
         if (new_hosts.empty())
             continue;
@@ -518,10 +526,11 @@ IProcessor::Status DDLQueryStatusSource::prepare()
         return ISource::prepare();
 }
 
-Strings DDLQueryStatusSource::getChildrenAllowNoNode(const std::shared_ptr<zkutil::ZooKeeper> & zookeeper, const String & node_path)
+Strings DDLQueryStatusSource::getChildrenAllowNoNode(
+    const std::shared_ptr<zkutil::ZooKeeper> & zookeeper, const String & node_path, const zkutil::EventPtr & watch)
 {
     Strings res;
-    Coordination::Error code = zookeeper->tryGetChildren(node_path, res);
+    Coordination::Error code = zookeeper->tryGetChildren(node_path, res, nullptr, watch);
     if (code != Coordination::Error::ZOK && code != Coordination::Error::ZNONODE)
         throw Coordination::Exception(code, node_path);
     return res;
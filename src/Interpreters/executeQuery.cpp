@@ -42,6 +42,7 @@
 
 #include <Access/EnabledQuota.h>
 #include <Interpreters/ApplyWithGlobalVisitor.h>
+#include <Interpreters/Cache/QueryASTCache.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/InterpreterFactory.h>
 #include <Interpreters/InterpreterInsertQuery.h>
@@ -381,19 +382,39 @@ static std::tuple<ASTPtr, BlockIO> executeQueryImpl(
     /// Parse the query from string.
     try
     {
-        if (settings.dialect == Dialect::kusto && !internal)
+        QueryASTCachePtr query_ast_cache;
+        UInt128 query_ast_cache_key;
+        if (!internal && settings.use_query_ast_cache)
         {
-            ParserKQLStatement parser(end, settings.allow_settings_after_format_in_insert);
-
-            /// TODO: parser should fail early when max_query_size limit is reached.
-            ast = parseQuery(parser, begin, end, "", max_query_size, settings.max_parser_depth);
+            query_ast_cache = context->getQueryASTCache();
+            if (query_ast_cache)
+            {
+                query_ast_cache_key = QueryASTCache::hash(begin, end, settings);
+                ast = query_ast_cache->getAST(query_ast_cache_key);
+            }
         }
-        else
+
+        if (!ast)
         {
-            ParserQuery parser(end, settings.allow_settings_after_format_in_insert);
+            if (settings.dialect == Dialect::kusto && !internal)
+            {
+                ParserKQLStatement parser(end, settings.allow_settings_after_format_in_insert);
 
-            /// TODO: parser should fail early when max_query_size limit is reached.
-            ast = parseQuery(parser, begin, end, "", max_query_size, settings.max_parser_depth);
+                /// TODO: parser should fail early when max_query_size limit is reached.
+                ast = parseQuery(parser, begin, end, "", max_query_size, settings.max_parser_depth);
+            }
+            else
+            {
+                ParserQuery parser(end, settings.allow_settings_after_format_in_insert);
+
+                /// TODO: parser should fail early when max_query_size limit is reached.
+                ast = parseQuery(parser, begin, end, "", max_query_size, settings.max_parser_depth);
+            }
+
+            /// AST of INSERT with inline data points into the buffer with the query text and cannot be reused.
+            if (query_ast_cache)
+                if (const auto * insert = ast->as<ASTInsertQuery>(); !insert || !insert->data)
+                    query_ast_cache->setAST(query_ast_cache_key, ast);
         }
 
         const char * query_end = end;
@@ -722,11 +743,21 @@ static std::tuple<ASTPtr, BlockIO> executeQueryImpl(
                     && res.pipeline.pulling())
                 {
                     QueryResultCache::Key key(
-                        ast, res.pipeline.getHeader(),
+                        ast, settings, res.pipeline.getHeader(),
                         std::make_optional<String>(context->getUserName()),
                         std::chrono::system_clock::now() + std::chrono::seconds(settings.query_result_cache_ttl));
                     QueryResultCache::Reader reader = query_result_cache->createReader(key);
-                    if (reader.hasCacheEntryForKey())
+                    bool has_cache_entry = reader.hasCacheEntryForKey();
+                    /// On a cache miss, optionally wait for an identical query which is currently computing its result and read the
+                    /// result from the cache afterwards. This coalesces bursts of identical expensive queries into a single execution.
+                    if (!has_cache_entry
+                        && settings.query_result_cache_coalesce_identical_queries
+                        && query_result_cache->waitForQueryInFlight(key, std::chrono::milliseconds(settings.query_result_cache_coalesce_wait_timeout.totalMilliseconds())))
+                    {
+                        reader = query_result_cache->createReader(key);
+                        has_cache_entry = reader.hasCacheEntryForKey();
+                    }
+                    if (has_cache_entry)
                     {
                         res.pipeline = QueryPipeline(reader.getPipe());
                         read_result_from_query_result_cache = true;
@@ -741,7 +772,7 @@ static std::tuple<ASTPtr, BlockIO> executeQueryImpl(
                     && (!astContainsNonDeterministicFunctions(ast, context) || settings.query_result_cache_store_results_of_queries_with_nondeterministic_functions))
                 {
                     QueryResultCache::Key key(
-                        ast, res.pipeline.getHeader(),
+                        ast, settings, res.pipeline.getHeader(),
                         settings.query_result_cache_share_between_users ? std::nullopt : std::make_optional<String>(context->getUserName()),
                         std::chrono::system_clock::now() + std::chrono::seconds(settings.query_result_cache_ttl));
 
@@ -1016,6 +1047,11 @@ static std::tuple<ASTPtr, BlockIO> executeQueryImpl(
                                 processor_elem.output_rows = stats.output_rows;
                                 processor_elem.output_bytes = stats.output_bytes;
 
+                                if (const auto * counters = processor->getProcessorCounters())
+                                    processor_elem.profile_counters = std::make_shared<ProfileEvents::Counters::Snapshot>(counters->getPartiallyAtomicSnapshot());
+                                else
+                                    processor_elem.profile_counters.reset();
+
                                 processors_profile_log->add(processor_elem);
                             }
                         }
@@ -3,7 +3,10 @@
 #include <Columns/ColumnConst.h>
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnTuple.h>
+#include <Columns/ColumnVector.h>
 #include <Functions/FunctionHelpers.h>
+#include <Common/RadixSort.h>
+#include <base/sort.h>
 
 
 namespace DB
@@ -113,6 +116,172 @@ ColumnsWithSortDescriptions getColumnsWithSortDescription(const Block & block, c
     return result;
 }
 
+/** Multi-column sorts over fixed-width integer keys do not need the column-by-column
+  * updatePermutation passes: the bit patterns of the keys are packed into one UInt64 per row
+  * (with the sign bit flipped for signed types and all bits flipped for DESC), so that comparing
+  * the fused keys as plain integers reproduces the lexicographic order of the sort description.
+  * The fused keys are then sorted the same way ColumnVector::getPermutation sorts a single
+  * numeric column, including the LSD radix sort for larger blocks. With a LIMIT, larger blocks
+  * go through MSD radix-select instead, which never sorts the rows below the cutoff.
+  *
+  * Floating point keys are left to the generic path: the NaN placement prescribed by
+  * nulls_direction does not correspond to any monotonic bit pattern transform.
+  */
+
+struct FusedKeyWithIndex
+{
+    UInt64 key;
+    UInt32 index;
+};
+
+struct FusedKeyRadixSortTraits : RadixSortNumTraits<UInt64>
+{
+    using Element = FusedKeyWithIndex;
+    using Result = size_t;
+
+    static UInt64 & extractKey(Element & elem) { return elem.key; }
+    static size_t extractResult(Element & elem) { return elem.index; }
+};
+
+size_t getFusedKeyWidth(const IColumn & column)
+{
+    if (checkAndGetColumn<ColumnVector<UInt8>>(column) || checkAndGetColumn<ColumnVector<Int8>>(column))
+        return 1;
+    if (checkAndGetColumn<ColumnVector<UInt16>>(column) || checkAndGetColumn<ColumnVector<Int16>>(column))
+        return 2;
+    if (checkAndGetColumn<ColumnVector<UInt32>>(column) || checkAndGetColumn<ColumnVector<Int32>>(column))
+        return 4;
+    if (checkAndGetColumn<ColumnVector<UInt64>>(column) || checkAndGetColumn<ColumnVector<Int64>>(column))
+        return 8;
+    return 0;
+}
+
+template <typename T>
+bool tryAppendFusedKeyPart(const IColumn & column, bool descending, PaddedPODArray<UInt64> & keys)
+{
+    const auto * column_vector = checkAndGetColumn<ColumnVector<T>>(column);
+    if (!column_vector)
+        return false;
+
+    using Unsigned = std::make_unsigned_t<T>;
+    constexpr UInt64 key_bits = 8 * sizeof(T);
+    constexpr UInt64 value_mask = key_bits == 64 ? ~UInt64(0) : ((UInt64(1) << key_bits) - 1);
+
+    /// Flipping the sign bit maps the order of signed values onto the order of their bit patterns,
+    /// flipping all the bits reverses the order for DESC.
+    UInt64 flip = std::is_signed_v<T> ? (UInt64(1) << (key_bits - 1)) : 0;
+    if (descending)
+        flip ^= value_mask;
+
+    const auto & data = column_vector->getData();
+    size_t size = data.size();
+    for (size_t i = 0; i < size; ++i)
+    {
+        UInt64 pattern = (static_cast<UInt64>(static_cast<Unsigned>(data[i])) ^ flip) & value_mask;
+        if constexpr (key_bits == 64)
+            keys[i] = pattern;
+        else
+            keys[i] = (keys[i] << key_bits) | pattern;
+    }
+
+    return true;
+}
+
+void appendFusedKeyPart(const IColumn & column, bool descending, PaddedPODArray<UInt64> & keys)
+{
+    tryAppendFusedKeyPart<UInt8>(column, descending, keys) || tryAppendFusedKeyPart<Int8>(column, descending, keys)
+        || tryAppendFusedKeyPart<UInt16>(column, descending, keys) || tryAppendFusedKeyPart<Int16>(column, descending, keys)
+        || tryAppendFusedKeyPart<UInt32>(column, descending, keys) || tryAppendFusedKeyPart<Int32>(column, descending, keys)
+        || tryAppendFusedKeyPart<UInt64>(column, descending, keys) || tryAppendFusedKeyPart<Int64>(column, descending, keys);
+}
+
+/// 'permutation' must be the identity permutation, 'limit' must be already normalized to 0 if it covers all the rows.
+bool tryGetBlockSortPermutationFusedKeys(
+    const ColumnsWithSortDescriptions & columns,
+    IColumn::PermutationSortStability stability,
+    UInt64 limit,
+    IColumn::Permutation & permutation)
+{
+    size_t total_key_bytes = 0;
+    for (const auto & elem : columns)
+    {
+        if (elem.column_const)
+            continue;
+
+        size_t width = isCollationRequired(elem.description) ? 0 : getFusedKeyWidth(*elem.column);
+        if (!width)
+            return false;
+
+        total_key_bytes += width;
+    }
+
+    /// The packed key must fit into UInt64. A column of the full width alone is fine: a single
+    /// field needs no shifting. (total_key_bytes is nonzero, the all-const case is handled earlier.)
+    if (total_key_bytes > sizeof(UInt64))
+        return false;
+
+    size_t size = permutation.size();
+
+    PaddedPODArray<UInt64> keys(size, 0);
+    for (const auto & elem : columns)
+        if (!elem.column_const)
+            appendFusedKeyPart(*elem.column, elem.description.direction < 0, keys);
+
+    bool sort_is_stable = stability == IColumn::PermutationSortStability::Stable;
+
+    /// Equal fused keys mean rows equal in all the sort columns, so stability only requires
+    /// breaking the ties by the original position.
+    auto less = [&](size_t lhs, size_t rhs) { return keys[lhs] < keys[rhs]; };
+    auto less_stable = [&](size_t lhs, size_t rhs) { return keys[lhs] < keys[rhs] || (keys[lhs] == keys[rhs] && lhs < rhs); };
+
+    if (limit)
+    {
+        /// Radix-select: MSD radix sort stops descending into buckets that lie entirely beyond
+        /// the limit, so rows below the cutoff are only partitioned, never sorted. Per the note
+        /// in RadixSort.h it beats comparison partial sort when the limit is above ~2% of the
+        /// block; for tiny limits the heap-based partial sort touches fewer elements. MSD is not
+        /// stable, so the stable case stays on the comparison path.
+        if (!sort_is_stable && size >= 256 && size <= std::numeric_limits<UInt32>::max() && limit >= size / 50)
+        {
+            PaddedPODArray<FusedKeyWithIndex> pairs(size);
+            for (UInt32 i = 0; i < static_cast<UInt32>(size); ++i)
+                pairs[i] = {keys[i], i};
+
+            RadixSort<FusedKeyRadixSortTraits>::executeMSD(pairs.data(), size, limit);
+
+            /// Rows past the limit are in partitioned order, which is still a valid permutation.
+            for (size_t i = 0; i < size; ++i)
+                permutation[i] = pairs[i].index;
+
+            return true;
+        }
+
+        if (sort_is_stable)
+            ::partial_sort(permutation.begin(), permutation.begin() + limit, permutation.end(), less_stable);
+        else
+            ::partial_sort(permutation.begin(), permutation.begin() + limit, permutation.end(), less);
+
+        return true;
+    }
+
+    /// Thresholds on size are the same as in ColumnVector::getPermutation.
+    /// LSD radix sort is stable, and DESC is already folded into the keys.
+    if (size >= 256 && size <= std::numeric_limits<UInt32>::max())
+    {
+        PaddedPODArray<FusedKeyWithIndex> pairs(size);
+        for (UInt32 i = 0; i < static_cast<UInt32>(size); ++i)
+            pairs[i] = {keys[i], i};
+
+        RadixSort<FusedKeyRadixSortTraits>::executeLSD(pairs.data(), size, false, permutation.data());
+    }
+    else if (sort_is_stable)
+        ::sort(permutation.begin(), permutation.end(), less_stable);
+    else
+        ::sort(permutation.begin(), permutation.end(), less);
+
+    return true;
+}
+
 void getBlockSortPermutationImpl(const Block & block, const SortDescription & description, IColumn::PermutationSortStability stability, UInt64 limit, IColumn::Permutation & permutation)
 {
     if (!block)
@@ -158,6 +327,9 @@ void getBlockSortPermutationImpl(const Block & block, const SortDescription & de
         if (limit >= size)
             limit = 0;
 
+        if (tryGetBlockSortPermutationFusedKeys(columns_with_sort_descriptions, stability, limit, permutation))
+            return;
+
         EqualRanges ranges;
         ranges.emplace_back(0, permutation.size());
 
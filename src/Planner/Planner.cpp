@@ -266,6 +266,7 @@ Aggregator::Params getAggregatorParams(const PlannerContextPtr & planner_context
         /* only_merge */ false,
         stats_collecting_params);
 
+    aggregator_params.spill_sorted_runs = settings.external_group_by_sorted_merge;
     return aggregator_params;
 }
 
@@ -469,7 +470,8 @@ void addDistinctStep(QueryPlan & query_plan,
         limit_hint_for_distinct,
         column_names,
         pre_distinct,
-        settings.optimize_distinct_in_order);
+        settings.optimize_distinct_in_order,
+        settings.parallel_distinct);
 
     distinct_step->setStepDescription(pre_distinct ? "Preliminary DISTINCT" : "DISTINCT");
     query_plan.addStep(std::move(distinct_step));
@@ -781,8 +783,20 @@ void addWindowSteps(QueryPlan & query_plan,
             query_plan.addStep(std::move(sorting_step));
         }
 
+        /** Process partitions in parallel if nothing downstream relies on the sorting
+          * this window produces: the next window either has its own sort step or does
+          * not exist, so the only consumer of the single sorted stream is this window.
+          */
+        bool streams_fan_out = settings.parallel_window_functions && !window_description.partition_by.empty();
+        if (streams_fan_out && i + 1 < window_descriptions_size)
+        {
+            const auto & next_window = window_descriptions[i + 1];
+            streams_fan_out = !next_window.full_sort_description.empty()
+                && !sortDescriptionIsPrefix(next_window.full_sort_description, window_description.full_sort_description);
+        }
+
         auto window_step
-            = std::make_unique<WindowStep>(query_plan.getCurrentDataStream(), window_description, window_description.window_functions);
+            = std::make_unique<WindowStep>(query_plan.getCurrentDataStream(), window_description, window_description.window_functions, streams_fan_out);
         window_step->setStepDescription("Window step for window '" + window_description.window_name + "'");
         query_plan.addStep(std::move(window_step));
     }
@@ -1062,7 +1076,8 @@ void Planner::buildPlanForUnionNode()
             0 /*limit hint*/,
             query_plan.getCurrentDataStream().header.getNames(),
             false /*pre distinct*/,
-            settings.optimize_distinct_in_order);
+            settings.optimize_distinct_in_order,
+            settings.parallel_distinct);
         query_plan.addStep(std::move(distinct_step));
     }
 }
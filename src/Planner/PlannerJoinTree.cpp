@@ -58,6 +58,20 @@ namespace ErrorCodes
 namespace
 {
 
+/// Estimate of the in-memory width of one row of the header, used to derive an adaptive
+/// block size from a byte budget (see the max_block_size_bytes setting).
+UInt64 estimateRowSizeInMemory(const Block & header)
+{
+    /// A guess for strings, arrays and other variable-width types.
+    static constexpr UInt64 variable_width_column_size = 32;
+
+    UInt64 res = 0;
+    for (const auto & column : header)
+        res += column.type->haveMaximumSizeOfValue() ? column.type->getMaximumSizeOfValueInMemory() : variable_width_column_size;
+
+    return std::max<UInt64>(res, 1);
+}
+
 /// Check if current user has privileges to SELECT columns from table
 void checkAccessRights(const TableNode & table_node, const Names & column_names, const ContextPtr & query_context)
 {
@@ -190,6 +204,15 @@ JoinTreeQueryPlan buildQueryPlanForTableExpression(const QueryTreeNodePtr & tabl
 
         UInt64 max_block_size = settings.max_block_size;
 
+        /// If a byte budget for blocks is set, derive the block size in rows from the width of
+        /// the rows we are going to read: wide rows get smaller blocks that fit in CPU caches,
+        /// narrow rows get larger blocks that amortize per-block overheads.
+        if (settings.max_block_size_bytes)
+        {
+            UInt64 row_size = estimateRowSizeInMemory(storage_snapshot->getSampleBlockForColumns(table_expression_data.getColumnNames()));
+            max_block_size = std::clamp<UInt64>(settings.max_block_size_bytes / row_size, 128, DEFAULT_BLOCK_SIZE * 16);
+        }
+
         auto & main_query_node = select_query_info.query_tree->as<QueryNode &>();
 
         if (is_single_table_expression)
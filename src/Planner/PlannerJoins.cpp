@@ -631,6 +631,46 @@ std::shared_ptr<DirectKeyValueJoin> tryDirectJoin(const std::shared_ptr<TableJoi
     return std::make_shared<DirectKeyValueJoin>(table_join, right_table_expression_header, storage, right_table_expression_header_with_storage_column_names);
 }
 
+/** Check that the right table is already known to exceed the join size limits, using row and byte
+  * counters that the storage maintains (MergeTree keeps them in part metadata).
+  * In this case an in-memory hash join over the whole right table is doomed to overflow,
+  * so if an external algorithm is also enabled, it is better to start with it right away.
+  *
+  * The counters are pre-filter estimates, and totalBytes is the on-disk (compressed) size,
+  * i.e. a lower bound for the in-memory size, so there are no false positives for plain
+  * `JOIN table` without a subquery filtering the right side.
+  */
+bool rightTableExceedsSizeLimits(const QueryTreeNodePtr & table_expression,
+    const std::shared_ptr<TableJoin> & table_join,
+    const PlannerContextPtr & planner_context)
+{
+    const auto & size_limits = table_join->sizeLimits();
+    if (!size_limits.hasLimits())
+        return false;
+
+    StoragePtr storage;
+
+    if (auto * table_node = table_expression->as<TableNode>())
+        storage = table_node->getStorage();
+    else if (auto * table_function_node = table_expression->as<TableFunctionNode>())
+        storage = table_function_node->getStorage();
+
+    if (!storage)
+        return false;
+
+    const auto & settings = planner_context->getQueryContext()->getSettingsRef();
+
+    if (size_limits.max_rows)
+        if (auto total_rows = storage->totalRows(settings); total_rows && *total_rows > size_limits.max_rows)
+            return true;
+
+    if (size_limits.max_bytes)
+        if (auto total_bytes = storage->totalBytes(settings); total_bytes && *total_bytes > size_limits.max_bytes)
+            return true;
+
+    return false;
+}
+
 }
 
 std::shared_ptr<IJoin> chooseJoinAlgorithm(std::shared_ptr<TableJoin> & table_join,
@@ -688,6 +728,21 @@ std::shared_ptr<IJoin> chooseJoinAlgorithm(std::shared_ptr<TableJoin> & table_jo
             return std::make_shared<MergeJoin>(table_join, right_table_expression_header);
     }
 
+    /// When both in-memory hash and grace hash are enabled, consult table statistics to pick
+    /// between them: a right table that already exceeds the size limits goes straight to
+    /// GraceHashJoin instead of starting an in-memory join that would overflow on the first buckets.
+    if (table_join->isEnabledAlgorithm(JoinAlgorithm::GRACE_HASH) && GraceHashJoin::isSupported(table_join)
+        && rightTableExceedsSizeLimits(right_table_expression, table_join, planner_context))
+    {
+        auto query_context = planner_context->getQueryContext();
+        return std::make_shared<GraceHashJoin>(
+            query_context,
+            table_join,
+            left_table_expression_header,
+            right_table_expression_header,
+            query_context->getTempDataOnDisk());
+    }
+
     if (table_join->isEnabledAlgorithm(JoinAlgorithm::HASH) ||
         /// partial_merge is preferred, but can't be used for specified kind of join, fallback to hash
         table_join->isEnabledAlgorithm(JoinAlgorithm::PREFER_PARTIAL_MERGE) ||
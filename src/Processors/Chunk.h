@@ -27,6 +27,13 @@ using ChunkInfoPtr = std::shared_ptr<const ChunkInfo>;
  *
  * Any ChunkInfo may be attached to chunk.
  * It may be useful if additional info per chunk is needed. For example, bucket number for aggregated data.
+ *
+ * Note on recycling: the destructor deliberately does not return columns to any pool. Columns are
+ * COW and may still be shared with processors on other threads, result columns are allocated deep
+ * inside the individual function implementations (there is no central place to hand out reused
+ * buffers), and every allocation is charged to the MemoryTracker of the query that made it, so
+ * handing a buffer to another query would corrupt memory accounting. Reuse of freed blocks of
+ * suitable size is instead provided by the allocator's thread caches.
 **/
 
 class Chunk
@@ -1,6 +1,9 @@
 #include <Processors/Executors/ExecutionThreadContext.h>
 #include <QueryPipeline/ReadProgressCallback.h>
+#include <Common/ProfileEventsScope.h>
 #include <Common/Stopwatch.h>
+#include <Common/ThreadProfileEvents.h>
+#include <Common/ThreadStatus.h>
 #include <Interpreters/OpenTelemetrySpanLog.h>
 
 namespace DB
@@ -87,6 +90,18 @@ bool ExecutionThreadContext::executeTask()
         execution_time_watch.emplace();
 #endif
 
+    /// Attribute performance counters (including perf events, if they are enabled
+    /// for the query) incremented during work() to this processor.
+    std::optional<ProfileEventsScope> profile_events_scope;
+
+    if (profile_processors && current_thread)
+    {
+        if (!node->processor->processor_counters)
+            node->processor->processor_counters = std::make_unique<ProfileEvents::Counters>(VariableContext::Thread);
+
+        profile_events_scope.emplace(node->processor->processor_counters.get());
+    }
+
     try
     {
         executeJob(node, read_progress_callback);
@@ -103,6 +118,12 @@ bool ExecutionThreadContext::executeTask()
         node->processor->elapsed_us += elapsed_microseconds;
         if (trace_processors)
             span->addAttribute("execution_time_ms", elapsed_microseconds);
+
+        /// Hardware counters (perf events) are read at task boundaries, so the delta
+        /// since the previous read belongs to the processor that has just worked.
+        /// Increments propagate to the thread-wide counters through the parent link.
+        if (profile_events_scope)
+            current_thread_counters.updateProfileEvents(*node->processor->processor_counters);
     }
 #ifndef NDEBUG
     execution_time_ns += execution_time_watch->elapsed();
@@ -32,6 +32,7 @@ PipelineExecutor::PipelineExecutor(std::shared_ptr<Processors> & processors, Que
     {
         profile_processors = process_list_element->getContext()->getSettingsRef().log_processors_profiles;
         trace_processors = process_list_element->getContext()->getSettingsRef().opentelemetry_trace_processors;
+        concurrency_slot_weight = process_list_element->getContext()->getSettingsRef().concurrency_control_slot_weight;
     }
     try
     {
@@ -277,7 +278,7 @@ void PipelineExecutor::initializeExecution(size_t num_threads)
 
     /// Allocate CPU slots from concurrency control
     constexpr size_t min_threads = 1;
-    slots = ConcurrencyControl::instance().allocate(min_threads, num_threads);
+    slots = ConcurrencyControl::instance().allocate(min_threads, num_threads, concurrency_slot_weight);
     size_t use_threads = slots->grantedCount();
 
     Queue queue;
@@ -292,6 +293,11 @@ void PipelineExecutor::initializeExecution(size_t num_threads)
 
 void PipelineExecutor::spawnThreads()
 {
+    /// Query worker threads must not wait behind a burst of background thread-start jobs
+    /// in the global pool. The spawned threads inherit the priority, so thread pools and
+    /// IO callbacks used from them are scheduled with it as well.
+    GlobalThreadPoolJobPriorityScope priority_scope(1);
+
     while (auto slot = slots->tryAcquire())
     {
         std::unique_lock lock{threads_mutex};
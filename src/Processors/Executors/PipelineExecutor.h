@@ -76,6 +76,8 @@ private:
     bool profile_processors = false;
     /// system.opentelemetry_span_log
     bool trace_processors = false;
+    /// Weight of the query in the weighted fair distribution of CPU slots, see ConcurrencyControl.
+    size_t concurrency_slot_weight = 1;
 
     std::atomic_bool cancelled = false;
 
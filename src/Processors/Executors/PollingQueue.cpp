@@ -3,6 +3,8 @@
 #if defined(OS_LINUX)
 
 #include <Common/Exception.h>
+#include <Common/ProfileEvents.h>
+#include <Common/Stopwatch.h>
 #include <sys/epoll.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -10,6 +12,11 @@
 #include <IO/WriteBufferFromString.h>
 #include <IO/Operators.h>
 
+namespace ProfileEvents
+{
+    extern const Event PollingQueueWaitMicroseconds;
+}
+
 namespace DB
 {
 
@@ -68,10 +75,15 @@ PollingQueue::TaskData PollingQueue::wait(std::unique_lock<std::mutex> & lock)
 
     lock.unlock();
 
+    Stopwatch watch;
+
     epoll_event event;
     event.data.ptr = nullptr;
     epoll.getManyReady(1, &event, true);
 
+    ProfileEvents::increment(ProfileEvents::PollingQueueWaitMicroseconds, watch.elapsedMicroseconds());
+    ProfileEvents::traceWait(ProfileEvents::PollingQueueWaitMicroseconds, watch.elapsedNanoseconds());
+
     lock.lock();
 
     if (event.data.ptr == pipe_fd)
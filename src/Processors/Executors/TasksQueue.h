@@ -1,6 +1,6 @@
 #pragma once
 #include <vector>
-#include <queue>
+#include <deque>
 #include <Common/Exception.h>
 
 namespace DB
@@ -18,7 +18,7 @@ public:
 
     void push(Task * task, size_t thread_num)
     {
-        queues[thread_num].push(task);
+        queues[thread_num].push_back(task);
         ++num_tasks;
     }
 
@@ -44,8 +44,22 @@ public:
     {
         auto thread_with_tasks = getAnyThreadWithTasks(thread_num);
 
-        Task * task = queues[thread_with_tasks].front();
-        queues[thread_with_tasks].pop();
+        Task * task;
+        if (thread_with_tasks == thread_num)
+        {
+            /// Take own tasks in LIFO order: the most recently pushed task was produced
+            /// by this thread, so its data is the most likely to still be in CPU cache.
+            task = queues[thread_with_tasks].back();
+            queues[thread_with_tasks].pop_back();
+        }
+        else
+        {
+            /// Steal from the opposite end of the victim's queue: the oldest task is the
+            /// least likely to be hot in the victim's cache, and the victim keeps working
+            /// on the processors it touched most recently.
+            task = queues[thread_with_tasks].front();
+            queues[thread_with_tasks].pop_front();
+        }
 
         --num_tasks;
         return task;
@@ -55,7 +69,7 @@ public:
     bool empty() const { return num_tasks == 0; }
 
 private:
-    using Queue = std::queue<Task *>;
+    using Queue = std::deque<Task *>;
     std::vector<Queue> queues;
     size_t num_tasks = 0;
 };
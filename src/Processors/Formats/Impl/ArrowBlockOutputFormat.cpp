@@ -32,8 +32,12 @@ void ArrowBlockOutputFormat::consume(Chunk chunk)
     if (!ch_column_to_arrow_column)
     {
         const Block & header = getPort(PortKind::Main).getHeader();
-        ch_column_to_arrow_column
-            = std::make_unique<CHColumnToArrowColumn>(header, "Arrow", format_settings.arrow.low_cardinality_as_dictionary, format_settings.arrow.output_string_as_string);
+        ch_column_to_arrow_column = std::make_unique<CHColumnToArrowColumn>(
+            header,
+            "Arrow",
+            format_settings.arrow.low_cardinality_as_dictionary,
+            format_settings.arrow.output_string_as_string,
+            format_settings.max_threads);
     }
 
     ch_column_to_arrow_column->chChunkToArrowTable(arrow_table, chunk, columns_num);
@@ -19,6 +19,10 @@
 #include <DataTypes/DataTypeMap.h>
 #include <DataTypes/DataTypeDateTime64.h>
 #include <Processors/Formats/IOutputFormat.h>
+#include <Common/CurrentThread.h>
+#include <Common/ThreadPool.h>
+#include <Common/scope_guard_safe.h>
+#include <Common/setThreadName.h>
 #include <arrow/api.h>
 #include <arrow/builder.h>
 #include <arrow/type.h>
@@ -766,8 +770,16 @@ namespace DB
             column_type->getName(), column_name, format_name);
     }
 
-    CHColumnToArrowColumn::CHColumnToArrowColumn(const Block & header, const std::string & format_name_, bool low_cardinality_as_dictionary_, bool output_string_as_string_)
-        : format_name(format_name_), low_cardinality_as_dictionary(low_cardinality_as_dictionary_), output_string_as_string(output_string_as_string_)
+    CHColumnToArrowColumn::CHColumnToArrowColumn(
+        const Block & header,
+        const std::string & format_name_,
+        bool low_cardinality_as_dictionary_,
+        bool output_string_as_string_,
+        size_t max_threads_)
+        : format_name(format_name_)
+        , low_cardinality_as_dictionary(low_cardinality_as_dictionary_)
+        , max_threads(max_threads_)
+        , output_string_as_string(output_string_as_string_)
     {
         arrow_fields.reserve(header.columns());
         header_columns.reserve(header.columns());
@@ -789,24 +801,35 @@ namespace DB
         size_t columns_num)
     {
         /// For arrow::Schema and arrow::Table creation
-        std::vector<std::shared_ptr<arrow::Array>> arrow_arrays;
-        arrow_arrays.reserve(columns_num);
+        std::vector<std::shared_ptr<arrow::Array>> arrow_arrays(columns_num);
+
+        Columns columns;
+        columns.reserve(columns_num);
         for (size_t column_i = 0; column_i < columns_num; ++column_i)
         {
-            const ColumnWithTypeAndName & header_column = header_columns[column_i];
             auto column = chunk.getColumns()[column_i];
-
             if (!low_cardinality_as_dictionary)
                 column = recursiveRemoveLowCardinality(column);
+            columns.emplace_back(std::move(column));
+        }
 
-            if (!is_arrow_fields_initialized)
+        if (!is_arrow_fields_initialized)
+        {
+            for (size_t column_i = 0; column_i < columns_num; ++column_i)
             {
+                const ColumnWithTypeAndName & header_column = header_columns[column_i];
                 bool is_column_nullable = false;
-                auto arrow_type = getArrowType(header_column.type, column, header_column.name, format_name, output_string_as_string, &is_column_nullable);
+                auto arrow_type = getArrowType(header_column.type, columns[column_i], header_column.name, format_name, output_string_as_string, &is_column_nullable);
                 arrow_fields.emplace_back(std::make_shared<arrow::Field>(header_column.name, arrow_type, is_column_nullable));
             }
+        }
 
-            arrow::MemoryPool* pool = arrow::default_memory_pool();
+        auto convert_column = [&](size_t column_i)
+        {
+            const ColumnWithTypeAndName & header_column = header_columns[column_i];
+            const auto & column = columns[column_i];
+
+            arrow::MemoryPool * pool = arrow::default_memory_pool();
             std::unique_ptr<arrow::ArrayBuilder> array_builder;
             arrow::Status status = MakeBuilder(pool, arrow_fields[column_i]->type(), &array_builder);
             checkStatus(status, column->getName(), format_name);
@@ -817,7 +840,41 @@ namespace DB
             std::shared_ptr<arrow::Array> arrow_array;
             status = array_builder->Finish(&arrow_array);
             checkStatus(status, column->getName(), format_name);
-            arrow_arrays.emplace_back(std::move(arrow_array));
+            arrow_arrays[column_i] = std::move(arrow_array);
+        };
+
+        /// Columns are converted independently, so wide chunks (bulk exports of wide tables
+        /// are the common case for Arrow/Parquet) can be converted by several threads.
+        /// Conversion of LowCardinality columns to Arrow dictionaries shares state
+        /// between chunks (dictionary_values), so it stays single-threaded.
+        size_t num_threads = std::min(max_threads, columns_num);
+        if (num_threads > 1 && !low_cardinality_as_dictionary)
+        {
+            ThreadPool pool(num_threads);
+            auto thread_group = CurrentThread::getGroup();
+
+            for (size_t column_i = 0; column_i < columns_num; ++column_i)
+            {
+                pool.scheduleOrThrowOnError([&, column_i, thread_group]()
+                {
+                    setThreadName("ChToArrow");
+                    if (thread_group)
+                        CurrentThread::attachToIfDetached(thread_group);
+                    SCOPE_EXIT_SAFE(
+                        if (thread_group)
+                            CurrentThread::detachQueryIfNotDetached();
+                    );
+
+                    convert_column(column_i);
+                });
+            }
+
+            pool.wait();
+        }
+        else
+        {
+            for (size_t column_i = 0; column_i < columns_num; ++column_i)
+                convert_column(column_i);
         }
 
         std::shared_ptr<arrow::Schema> arrow_schema = std::make_shared<arrow::Schema>(arrow_fields);
@@ -14,7 +14,12 @@ namespace DB
 class CHColumnToArrowColumn
 {
 public:
-    CHColumnToArrowColumn(const Block & header, const std::string & format_name_, bool low_cardinality_as_dictionary_, bool output_string_as_string_);
+    CHColumnToArrowColumn(
+        const Block & header,
+        const std::string & format_name_,
+        bool low_cardinality_as_dictionary_,
+        bool output_string_as_string_,
+        size_t max_threads_ = 1);
 
     void chChunkToArrowTable(std::shared_ptr<arrow::Table> & res, const Chunk & chunk, size_t columns_num);
 
@@ -23,6 +28,9 @@ private:
     std::vector<std::shared_ptr<arrow::Field>> arrow_fields;
     const std::string format_name;
     bool low_cardinality_as_dictionary;
+    /// Columns of a chunk are converted independently, so wide chunks can be
+    /// converted by several threads.
+    size_t max_threads;
     /// Map {column name : arrow dictionary}.
     /// To avoid converting dictionary from LowCardinality to Arrow
     /// Dictionary every chunk we save it and reuse.
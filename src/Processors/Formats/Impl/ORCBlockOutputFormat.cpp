@@ -167,11 +167,31 @@ void ORCBlockOutputFormat::writeNumbers(
 {
     NumberVectorBatch & number_orc_column = dynamic_cast<NumberVectorBatch &>(orc_column);
     const auto & number_column = assert_cast<const ColumnVector<NumberType> &>(column);
-    number_orc_column.resize(number_column.size());
+    size_t rows_num = number_column.size();
+    number_orc_column.resize(rows_num);
 
-    for (size_t i = 0; i != number_column.size(); ++i)
+    if (!null_bytemap)
     {
-        if (null_bytemap && (*null_bytemap)[i])
+        /// The writer does not look at notNull when hasNulls is not set, so the data
+        /// can be mapped to the batch directly. If in-memory representations match,
+        /// copy the whole column instead of converting element-wise.
+        using BatchElement = std::decay_t<decltype(number_orc_column.data[0])>;
+        if constexpr (sizeof(NumberType) == sizeof(BatchElement))
+        {
+            memcpy(number_orc_column.data.data(), number_column.getData().data(), rows_num * sizeof(BatchElement));
+        }
+        else
+        {
+            for (size_t i = 0; i != rows_num; ++i)
+                number_orc_column.data[i] = convert(number_column.getElement(i));
+        }
+        number_orc_column.numElements = rows_num;
+        return;
+    }
+
+    for (size_t i = 0; i != rows_num; ++i)
+    {
+        if ((*null_bytemap)[i])
         {
             number_orc_column.notNull[i] = 0;
             continue;
@@ -180,7 +200,7 @@ void ORCBlockOutputFormat::writeNumbers(
         number_orc_column.notNull[i] = 1;
         number_orc_column.data[i] = convert(number_column.getElement(i));
     }
-    number_orc_column.numElements = number_column.size();
+    number_orc_column.numElements = rows_num;
 }
 
 template <typename Decimal, typename DecimalVectorBatch, typename ConvertFunc>
@@ -196,10 +216,20 @@ void ORCBlockOutputFormat::writeDecimals(
     const auto * decimal_type = assert_cast<const DataTypeDecimal<Decimal> *>(type.get());
     decimal_orc_column.precision = decimal_type->getPrecision();
     decimal_orc_column.scale = decimal_type->getScale();
-    decimal_orc_column.resize(decimal_column.size());
-    for (size_t i = 0; i != decimal_column.size(); ++i)
+    size_t rows_num = decimal_column.size();
+    decimal_orc_column.resize(rows_num);
+
+    if (!null_bytemap)
+    {
+        for (size_t i = 0; i != rows_num; ++i)
+            decimal_orc_column.values[i] = convert(decimal_column.getElement(i).value);
+        decimal_orc_column.numElements = rows_num;
+        return;
+    }
+
+    for (size_t i = 0; i != rows_num; ++i)
     {
-        if (null_bytemap && (*null_bytemap)[i])
+        if ((*null_bytemap)[i])
         {
             decimal_orc_column.notNull[i] = 0;
             continue;
@@ -208,7 +238,7 @@ void ORCBlockOutputFormat::writeDecimals(
         decimal_orc_column.notNull[i] = 1;
         decimal_orc_column.values[i] = convert(decimal_column.getElement(i).value);
     }
-    decimal_orc_column.numElements = decimal_column.size();
+    decimal_orc_column.numElements = rows_num;
 }
 
 template <typename ColumnType>
@@ -219,11 +249,24 @@ void ORCBlockOutputFormat::writeStrings(
 {
     orc::StringVectorBatch & string_orc_column = dynamic_cast<orc::StringVectorBatch &>(orc_column);
     const auto & string_column = assert_cast<const ColumnType &>(column);
-    string_orc_column.resize(string_column.size());
+    size_t rows_num = string_column.size();
+    string_orc_column.resize(rows_num);
 
-    for (size_t i = 0; i != string_column.size(); ++i)
+    if (!null_bytemap)
     {
-        if (null_bytemap && (*null_bytemap)[i])
+        for (size_t i = 0; i != rows_num; ++i)
+        {
+            const std::string_view & string = string_column.getDataAt(i).toView();
+            string_orc_column.data[i] = const_cast<char *>(string.data());
+            string_orc_column.length[i] = string.size();
+        }
+        string_orc_column.numElements = rows_num;
+        return;
+    }
+
+    for (size_t i = 0; i != rows_num; ++i)
+    {
+        if ((*null_bytemap)[i])
         {
             string_orc_column.notNull[i] = 0;
             continue;
@@ -234,7 +277,7 @@ void ORCBlockOutputFormat::writeStrings(
         string_orc_column.data[i] = const_cast<char *>(string.data());
         string_orc_column.length[i] = string.size();
     }
-    string_orc_column.numElements = string_column.size();
+    string_orc_column.numElements = rows_num;
 }
 
 template <typename ColumnType, typename GetSecondsFunc, typename GetNanosecondsFunc>
@@ -247,11 +290,23 @@ void ORCBlockOutputFormat::writeDateTimes(
 {
     orc::TimestampVectorBatch & timestamp_orc_column = dynamic_cast<orc::TimestampVectorBatch &>(orc_column);
     const auto & timestamp_column = assert_cast<const ColumnType &>(column);
-    timestamp_orc_column.resize(timestamp_column.size());
+    size_t rows_num = timestamp_column.size();
+    timestamp_orc_column.resize(rows_num);
+
+    if (!null_bytemap)
+    {
+        for (size_t i = 0; i != rows_num; ++i)
+        {
+            timestamp_orc_column.data[i] = static_cast<int64_t>(get_seconds(timestamp_column.getElement(i)));
+            timestamp_orc_column.nanoseconds[i] = static_cast<int64_t>(get_nanoseconds(timestamp_column.getElement(i)));
+        }
+        timestamp_orc_column.numElements = rows_num;
+        return;
+    }
 
-    for (size_t i = 0; i != timestamp_column.size(); ++i)
+    for (size_t i = 0; i != rows_num; ++i)
     {
-        if (null_bytemap && (*null_bytemap)[i])
+        if ((*null_bytemap)[i])
         {
             timestamp_orc_column.notNull[i] = 0;
             continue;
@@ -261,7 +316,7 @@ void ORCBlockOutputFormat::writeDateTimes(
         timestamp_orc_column.data[i] = static_cast<int64_t>(get_seconds(timestamp_column.getElement(i)));
         timestamp_orc_column.nanoseconds[i] = static_cast<int64_t>(get_nanoseconds(timestamp_column.getElement(i)));
     }
-    timestamp_orc_column.numElements = timestamp_column.size();
+    timestamp_orc_column.numElements = rows_num;
 }
 
 void ORCBlockOutputFormat::writeColumn(
@@ -12,10 +12,13 @@
 #include <arrow/status.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/file_reader.h>
+#include <parquet/properties.h>
 #include "ArrowBufferedStreams.h"
 #include "ArrowColumnToCHColumn.h"
 #include "ArrowFieldIndexUtil.h"
 #include <DataTypes/NestedUtils.h>
+#include <Common/setThreadName.h>
+#include <Common/scope_guard_safe.h>
 
 namespace DB
 {
@@ -38,9 +41,13 @@ ParquetBlockInputFormat::ParquetBlockInputFormat(ReadBuffer & in_, Block header_
 {
 }
 
+ParquetBlockInputFormat::~ParquetBlockInputFormat()
+{
+    finishAndWait();
+}
+
 Chunk ParquetBlockInputFormat::generate()
 {
-    Chunk res;
     block_missing_values.clear();
 
     if (!file_reader)
@@ -49,46 +56,261 @@ Chunk ParquetBlockInputFormat::generate()
     if (is_stopped)
         return {};
 
-    for (; row_group_current < row_group_total && skip_row_groups.contains(row_group_current); ++row_group_current)
-        ;
+    Chunk res = pool ? generateParallel() : generateSequential();
+
+    /// If defaults_for_omitted_fields is true, calculate the default values from default expression for omitted fields.
+    /// Otherwise fill the missing columns with zero values of its type.
+    if (format_settings.defaults_for_omitted_fields)
+        for (const auto & column_idx : missing_columns)
+            block_missing_values.setBits(column_idx, res.getNumRows());
+    return res;
+}
+
+Chunk ParquetBlockInputFormat::generateSequential()
+{
+    Chunk res;
+
+    while (true)
+    {
+        if (!current_record_batch_reader)
+        {
+            for (; row_group_current < row_group_total && skip_row_groups.contains(row_group_current); ++row_group_current)
+                ;
+
+            if (row_group_current >= row_group_total)
+                return res;
+
+            std::vector<int> row_group_indices { row_group_current };
+            arrow::Status get_batch_reader_status = file_reader->GetRecordBatchReader(row_group_indices, column_indices, &current_record_batch_reader);
+
+            if (!get_batch_reader_status.ok())
+                throw ParsingException{"Error while reading Parquet data: " + get_batch_reader_status.ToString(), ErrorCodes::CANNOT_READ_ALL_DATA};
+        }
+
+        /// Read the row group incrementally instead of materializing it as a whole arrow::Table at once:
+        /// this bounds the peak memory of the Arrow intermediate representation by one batch and lets the
+        /// conversion to ClickHouse columns start before the row group is fully decoded.
+        std::shared_ptr<arrow::RecordBatch> batch;
+        arrow::Status read_status = current_record_batch_reader->ReadNext(&batch);
+
+        if (!read_status.ok())
+            throw ParsingException{"Error while reading Parquet data: " + read_status.ToString(), ErrorCodes::CANNOT_READ_ALL_DATA};
+
+        if (!batch)
+        {
+            /// Row group is exhausted, move on to the next one.
+            current_record_batch_reader.reset();
+            ++row_group_current;
+            continue;
+        }
+
+        auto table_result = arrow::Table::FromRecordBatches({std::move(batch)});
+        if (!table_result.ok())
+            throw ParsingException{"Error while reading Parquet data: " + table_result.status().ToString(), ErrorCodes::CANNOT_READ_ALL_DATA};
+
+        std::shared_ptr<arrow::Table> table = std::move(*table_result);
+        arrow_column_to_ch_column->arrowTableToCHChunk(res, table, table->num_rows());
+        break;
+    }
+
+    return res;
+}
+
+Chunk ParquetBlockInputFormat::generateParallel()
+{
+    std::unique_lock lock(decode_mutex);
+
+    while (true)
+    {
+        if (background_exception)
+        {
+            decoding_finished = true;
+            std::rethrow_exception(background_exception);
+        }
+
+        if (is_stopped || row_groups_delivered >= static_cast<size_t>(row_group_total))
+            return {};
+
+        auto & row_group = decoded_row_groups[row_groups_delivered];
+        if (row_group.chunks_delivered < row_group.chunks.size())
+            return std::move(row_group.chunks[row_group.chunks_delivered++]);
+
+        if (row_group.done)
+        {
+            row_group.chunks.clear();
+            ++row_groups_delivered;
+            row_group_delivered.notify_all();
+            continue;
+        }
+
+        chunk_decoded.wait(lock);
+    }
+}
+
+void ParquetBlockInputFormat::decodeThreadFunction(ThreadGroupStatusPtr thread_group)
+{
+    SCOPE_EXIT_SAFE(
+        if (thread_group)
+            CurrentThread::detachQueryIfNotDetached();
+    );
+    if (thread_group)
+        CurrentThread::attachToIfDetached(thread_group);
+
+    setThreadName("ParquetDecoder");
+
+    try
+    {
+        while (true)
+        {
+            size_t row_group;
+
+            {
+                std::unique_lock lock(decode_mutex);
+                /// Decode at most decoding_window row groups ahead of the delivery point to bound the
+                /// memory of the reorder buffer.
+                row_group_delivered.wait(lock, [&]
+                {
+                    return is_stopped || decoding_finished || row_groups_claimed >= static_cast<size_t>(row_group_total)
+                        || row_groups_claimed < row_groups_delivered + decoding_window;
+                });
 
-    if (row_group_current >= row_group_total)
-        return res;
+                if (is_stopped || decoding_finished || row_groups_claimed >= static_cast<size_t>(row_group_total))
+                    return;
 
-    std::shared_ptr<arrow::Table> table;
+                row_group = row_groups_claimed++;
+            }
 
-    std::unique_ptr<::arrow::RecordBatchReader> rbr;
-    std::vector<int> row_group_indices { row_group_current };
-    arrow::Status get_batch_reader_status = file_reader->GetRecordBatchReader(row_group_indices, column_indices, &rbr);
+            if (!skip_row_groups.contains(static_cast<int>(row_group)))
+                decodeRowGroup(row_group);
+
+            {
+                std::lock_guard lock(decode_mutex);
+                decoded_row_groups[row_group].done = true;
+            }
+            chunk_decoded.notify_all();
+        }
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard lock(decode_mutex);
+            background_exception = std::current_exception();
+        }
+        chunk_decoded.notify_all();
+        row_group_delivered.notify_all();
+    }
+}
+
+void ParquetBlockInputFormat::decodeRowGroup(size_t row_group)
+{
+    /// Every row group gets its own FileReader: FileReader is not thread-safe, but concurrent positional
+    /// reads on the underlying arrow file are. The file metadata is passed in so that the footer is not
+    /// parsed again for every row group.
+    parquet::arrow::FileReaderBuilder builder;
+    THROW_ARROW_NOT_OK(builder.Open(arrow_file, parquet::default_reader_properties(), metadata));
+    builder.memory_pool(::arrow::default_memory_pool());
+    if (!read_dictionary_indices.empty())
+    {
+        parquet::ArrowReaderProperties reader_properties;
+        for (int column_index : read_dictionary_indices)
+            reader_properties.set_read_dictionary(column_index, true);
+        builder.properties(reader_properties);
+    }
+    std::unique_ptr<parquet::arrow::FileReader> row_group_reader;
+    THROW_ARROW_NOT_OK(builder.Build(&row_group_reader));
+
+    std::vector<int> row_group_indices { static_cast<int>(row_group) };
+    std::unique_ptr<::arrow::RecordBatchReader> batch_reader;
+    arrow::Status get_batch_reader_status = row_group_reader->GetRecordBatchReader(row_group_indices, column_indices, &batch_reader);
 
     if (!get_batch_reader_status.ok())
         throw ParsingException{"Error while reading Parquet data: " + get_batch_reader_status.ToString(), ErrorCodes::CANNOT_READ_ALL_DATA};
 
-    arrow::Status read_status = rbr->ReadAll(&table);
+    /// ArrowColumnToCHColumn caches dictionaries between chunks and is therefore not shared between threads.
+    ArrowColumnToCHColumn converter(
+        getPort().getHeader(),
+        "Parquet",
+        format_settings.parquet.import_nested,
+        format_settings.parquet.allow_missing_columns,
+        format_settings.parquet.case_insensitive_column_matching);
+
+    while (!is_stopped && !decoding_finished)
+    {
+        std::shared_ptr<arrow::RecordBatch> batch;
+        arrow::Status read_status = batch_reader->ReadNext(&batch);
 
-    if (!read_status.ok())
-        throw ParsingException{"Error while reading Parquet data: " + read_status.ToString(), ErrorCodes::CANNOT_READ_ALL_DATA};
+        if (!read_status.ok())
+            throw ParsingException{"Error while reading Parquet data: " + read_status.ToString(), ErrorCodes::CANNOT_READ_ALL_DATA};
 
-    ++row_group_current;
+        if (!batch)
+            break;
 
-    arrow_column_to_ch_column->arrowTableToCHChunk(res, table, table->num_rows());
+        auto table_result = arrow::Table::FromRecordBatches({std::move(batch)});
+        if (!table_result.ok())
+            throw ParsingException{"Error while reading Parquet data: " + table_result.status().ToString(), ErrorCodes::CANNOT_READ_ALL_DATA};
 
-    /// If defaults_for_omitted_fields is true, calculate the default values from default expression for omitted fields.
-    /// Otherwise fill the missing columns with zero values of its type.
-    if (format_settings.defaults_for_omitted_fields)
-        for (const auto & column_idx : missing_columns)
-            block_missing_values.setBits(column_idx, res.getNumRows());
-    return res;
+        std::shared_ptr<arrow::Table> table = std::move(*table_result);
+        Chunk chunk;
+        converter.arrowTableToCHChunk(chunk, table, table->num_rows());
+
+        {
+            std::lock_guard lock(decode_mutex);
+            decoded_row_groups[row_group].chunks.push_back(std::move(chunk));
+        }
+        chunk_decoded.notify_all();
+    }
+}
+
+void ParquetBlockInputFormat::finishAndWait()
+{
+    if (!pool)
+        return;
+
+    std::lock_guard finish_and_wait_lock(finish_and_wait_mutex);
+
+    if (finish_and_wait_called)
+        return;
+    finish_and_wait_called = true;
+
+    decoding_finished = true;
+    {
+        std::lock_guard lock(decode_mutex);
+        chunk_decoded.notify_all();
+        row_group_delivered.notify_all();
+    }
+
+    try
+    {
+        pool->wait();
+    }
+    catch (...)
+    {
+        tryLogCurrentException(__PRETTY_FUNCTION__);
+    }
 }
 
 void ParquetBlockInputFormat::resetParser()
 {
+    finishAndWait();
+
     IInputFormat::resetParser();
 
     file_reader.reset();
+    current_record_batch_reader.reset();
     column_indices.clear();
     row_group_current = 0;
     block_missing_values.clear();
+
+    pool.reset();
+    arrow_file.reset();
+    metadata.reset();
+    read_dictionary_indices.clear();
+    decoded_row_groups.clear();
+    row_groups_claimed = 0;
+    row_groups_delivered = 0;
+    background_exception = nullptr;
+    decoding_finished = false;
+    finish_and_wait_called = false;
 }
 
 const BlockMissingValues & ParquetBlockInputFormat::getMissingValues() const
@@ -101,19 +323,22 @@ static void getFileReaderAndSchema(
     std::unique_ptr<parquet::arrow::FileReader> & file_reader,
     std::shared_ptr<arrow::Schema> & schema,
     const FormatSettings & format_settings,
-    std::atomic<int> & is_stopped)
+    std::atomic<int> & is_stopped,
+    std::shared_ptr<arrow::io::RandomAccessFile> * out_arrow_file = nullptr)
 {
     auto arrow_file = asArrowFile(in, format_settings, is_stopped, "Parquet", PARQUET_MAGIC_BYTES);
     if (is_stopped)
         return;
-    THROW_ARROW_NOT_OK(parquet::arrow::OpenFile(std::move(arrow_file), arrow::default_memory_pool(), &file_reader));
+    THROW_ARROW_NOT_OK(parquet::arrow::OpenFile(arrow_file, arrow::default_memory_pool(), &file_reader));
     THROW_ARROW_NOT_OK(file_reader->GetSchema(&schema));
+    if (out_arrow_file)
+        *out_arrow_file = std::move(arrow_file);
 }
 
 void ParquetBlockInputFormat::prepareReader()
 {
     std::shared_ptr<arrow::Schema> schema;
-    getFileReaderAndSchema(*in, file_reader, schema, format_settings, is_stopped);
+    getFileReaderAndSchema(*in, file_reader, schema, format_settings, is_stopped, &arrow_file);
     if (is_stopped)
         return;
 
@@ -132,6 +357,61 @@ void ParquetBlockInputFormat::prepareReader()
         format_settings.parquet.case_insensitive_column_matching,
         format_settings.parquet.allow_missing_columns);
     column_indices = field_util.findRequiredIndices(getPort().getHeader(), *schema);
+
+    /// For columns read into LowCardinality, ask the Parquet reader to keep the dictionary encoding: Arrow then
+    /// produces DictionaryArrays which are mapped straight to ColumnLowCardinality instead of being expanded to
+    /// flat arrays first and dictionarized again on our side. Parquet column indices match schema field indices
+    /// only when all fields are flat, so the optimization is skipped for files with nested columns.
+    if (arrow_file && !format_settings.parquet.case_insensitive_column_matching)
+    {
+        bool all_fields_are_flat = true;
+        for (int i = 0; i != schema->num_fields(); ++i)
+            if (schema->field(i)->type()->num_fields() != 0)
+                all_fields_are_flat = false;
+
+        if (all_fields_are_flat)
+        {
+            parquet::ArrowReaderProperties reader_properties;
+            const auto & header = getPort().getHeader();
+
+            for (int i : column_indices)
+            {
+                const auto & field_name = schema->field(i)->name();
+                if (header.has(field_name) && header.getByName(field_name).type->lowCardinality())
+                {
+                    reader_properties.set_read_dictionary(i, true);
+                    read_dictionary_indices.push_back(i);
+                }
+            }
+
+            if (!read_dictionary_indices.empty())
+            {
+                parquet::arrow::FileReaderBuilder builder;
+                THROW_ARROW_NOT_OK(builder.Open(arrow_file));
+                builder.properties(reader_properties);
+                builder.memory_pool(::arrow::default_memory_pool());
+                THROW_ARROW_NOT_OK(builder.Build(&file_reader));
+            }
+        }
+    }
+
+    /// Several row groups can be decoded in parallel: each decoding thread claims the next undecoded row
+    /// group and appends resulting chunks to its reorder slot, generateParallel() delivers them in file
+    /// order. One thread keeps the old single-threaded code path.
+    size_t max_decoding_threads = format_settings.parquet.max_decoding_threads;
+    if (max_decoding_threads > 1 && row_group_total > 1 && arrow_file)
+    {
+        metadata = file_reader->parquet_reader()->metadata();
+        decoded_row_groups.resize(row_group_total);
+        size_t num_threads = std::min<size_t>(max_decoding_threads, row_group_total);
+        decoding_window = num_threads;
+        pool = std::make_unique<ThreadPool>(num_threads);
+        for (size_t i = 0; i < num_threads; ++i)
+            pool->scheduleOrThrowOnError([this, thread_group = CurrentThread::getGroup()]
+            {
+                decodeThreadFunction(thread_group);
+            });
+    }
 }
 
 ParquetSchemaReader::ParquetSchemaReader(ReadBuffer & in_, const FormatSettings & format_settings_)
@@ -5,10 +5,14 @@
 #include <Processors/Formats/IInputFormat.h>
 #include <Processors/Formats/ISchemaReader.h>
 #include <Formats/FormatSettings.h>
+#include <Common/CurrentThread.h>
+#include <Common/ThreadPool.h>
 
+namespace parquet { class FileMetaData; }
 namespace parquet::arrow { class FileReader; }
 
-namespace arrow { class Buffer; }
+namespace arrow { class Buffer; class RecordBatchReader; }
+namespace arrow::io { class RandomAccessFile; }
 
 namespace DB
 {
@@ -20,6 +24,8 @@ class ParquetBlockInputFormat : public IInputFormat
 public:
     ParquetBlockInputFormat(ReadBuffer & in_, Block header_, const FormatSettings & format_settings_);
 
+    ~ParquetBlockInputFormat() override;
+
     void resetParser() override;
 
     String getName() const override { return "ParquetBlockInputFormat"; }
@@ -35,9 +41,15 @@ protected:
     void onCancel() override
     {
         is_stopped = 1;
+        finishAndWait();
     }
 
+    Chunk generateSequential();
+
     std::unique_ptr<parquet::arrow::FileReader> file_reader;
+    /// Reads the current row group incrementally, batch by batch, so that a whole row group
+    /// is never materialized as an arrow::Table at once.
+    std::unique_ptr<::arrow::RecordBatchReader> current_record_batch_reader;
     int row_group_total = 0;
     int row_group_current = 0;
     // indices of columns to read from Parquet file
@@ -49,6 +61,51 @@ protected:
     const std::unordered_set<int> & skip_row_groups;
 
     std::atomic<int> is_stopped{0};
+
+    /// ----------------------------------------------------------------------------------------------------
+    /// Parallel decoding of row groups (see input_format_parquet_max_decoding_threads).
+    ///
+    /// Each decoding thread opens its own FileReader over the shared arrow file (concurrent ReadAt() calls
+    /// on arrow::io::RandomAccessFile are serialized by arrow itself) and decodes whole row groups. The
+    /// consumer (generateParallel()) delivers chunks strictly in file order, so parallel decoding is
+    /// transparent to the rest of the pipeline. At most one row group per thread is decoded ahead of the
+    /// delivery point, which bounds the memory of the reorder buffer.
+
+    Chunk generateParallel();
+    void decodeThreadFunction(ThreadGroupStatusPtr thread_group);
+    void decodeRowGroup(size_t row_group);
+    void finishAndWait();
+
+    /// The file the decoding threads read from, shared between their per-row-group readers.
+    std::shared_ptr<arrow::io::RandomAccessFile> arrow_file;
+    /// File metadata is parsed once and shared by the per-row-group readers.
+    std::shared_ptr<parquet::FileMetaData> metadata;
+    /// Columns for which the Parquet dictionary encoding is kept (see prepareReader()).
+    std::vector<int> read_dictionary_indices;
+
+    struct DecodedRowGroup
+    {
+        std::vector<Chunk> chunks;
+        size_t chunks_delivered = 0;
+        bool done = false;
+    };
+
+    std::unique_ptr<ThreadPool> pool;
+    std::mutex decode_mutex;
+    /// A chunk was decoded, a row group was finished or a decoding thread failed.
+    std::condition_variable chunk_decoded;
+    /// The consumer fully delivered a row group, a decoding thread may claim the next one.
+    std::condition_variable row_group_delivered;
+    std::vector<DecodedRowGroup> decoded_row_groups;
+    size_t row_groups_claimed = 0;
+    size_t row_groups_delivered = 0;
+    size_t decoding_window = 0;
+    std::exception_ptr background_exception;
+    std::atomic<bool> decoding_finished{false};
+
+    /// finishAndWait() can be called concurrently from multiple threads (e.g. onCancel() and the destructor).
+    std::mutex finish_and_wait_mutex;
+    bool finish_and_wait_called = false;
 };
 
 class ParquetSchemaReader : public ISchemaReader
@@ -29,7 +29,12 @@ void ParquetBlockOutputFormat::consume(Chunk chunk)
     if (!ch_column_to_arrow_column)
     {
         const Block & header = getPort(PortKind::Main).getHeader();
-        ch_column_to_arrow_column = std::make_unique<CHColumnToArrowColumn>(header, "Parquet", false, format_settings.parquet.output_string_as_string);
+        ch_column_to_arrow_column = std::make_unique<CHColumnToArrowColumn>(
+            header,
+            "Parquet",
+            format_settings.parquet.low_cardinality_as_dictionary,
+            format_settings.parquet.output_string_as_string,
+            format_settings.max_threads);
     }
 
     ch_column_to_arrow_column->chChunkToArrowTable(arrow_table, chunk, columns_num);
@@ -43,11 +48,18 @@ void ParquetBlockOutputFormat::consume(Chunk chunk)
         builder.compression(parquet::Compression::SNAPPY);
 #endif
         auto props = builder.build();
+
+        parquet::ArrowWriterProperties::Builder arrow_builder;
+        /// Encode columns of a row group in parallel in Arrow's CPU thread pool.
+        arrow_builder.set_use_threads(format_settings.max_threads > 1);
+        auto arrow_props = arrow_builder.build();
+
         auto status = parquet::arrow::FileWriter::Open(
             *arrow_table->schema(),
             arrow::default_memory_pool(),
             sink,
-            props, /*parquet::default_writer_properties(),*/
+            props,
+            arrow_props,
             &file_writer);
         if (!status.ok())
             throw Exception(ErrorCodes::UNKNOWN_EXCEPTION, "Error while opening a table: {}", status.ToString());
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <Processors/Port.h>
+#include <Common/ProfileEvents.h>
 #include <Common/Stopwatch.h>
 
 
@@ -307,6 +308,10 @@ public:
     uint64_t getInputWaitElapsedUs() const { return input_wait_elapsed_us; }
     uint64_t getOutputWaitElapsedUs() const { return output_wait_elapsed_us; }
 
+    /// Performance counters accumulated while this processor was working.
+    /// nullptr unless profiling was enabled for the query.
+    const ProfileEvents::Counters * getProcessorCounters() const { return processor_counters.get(); }
+
     struct ProcessorDataStats
     {
         size_t input_rows = 0;
@@ -375,6 +380,8 @@ private:
 
     /// For processors_profile_log
     uint64_t elapsed_us = 0;
+    /// Created lazily when profiling is enabled; see ExecutionThreadContext.
+    std::unique_ptr<ProfileEvents::Counters> processor_counters;
     Stopwatch input_wait_watch;
     uint64_t input_wait_elapsed_us = 0;
     Stopwatch output_wait_watch;
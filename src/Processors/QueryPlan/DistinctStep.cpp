@@ -1,5 +1,7 @@
 #include <Processors/QueryPlan/DistinctStep.h>
+#include <Processors/ResizeProcessor.h>
 #include <Processors/Transforms/DistinctSortedChunkTransform.h>
+#include <Processors/Transforms/ScatterByPartitionTransform.h>
 #include <Processors/Transforms/DistinctSortedTransform.h>
 #include <Processors/Transforms/DistinctTransform.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
@@ -24,15 +26,17 @@ static bool checkColumnsAlreadyDistinct(const Names & columns, const NameSet & d
     return true;
 }
 
-static ITransformingStep::Traits getTraits(bool pre_distinct, bool already_distinct_columns)
+static ITransformingStep::Traits getTraits(bool pre_distinct, bool already_distinct_columns, bool parallel_final_distinct)
 {
+    /// Parallel final distinct scatters rows across streams by key hash,
+    /// so it neither merges into a single stream nor preserves sorting.
     return ITransformingStep::Traits
     {
         {
             .preserves_distinct_columns = already_distinct_columns, /// Will be calculated separately otherwise
-            .returns_single_stream = !pre_distinct && !already_distinct_columns,
+            .returns_single_stream = !pre_distinct && !already_distinct_columns && !parallel_final_distinct,
             .preserves_number_of_streams = pre_distinct || already_distinct_columns,
-            .preserves_sorting = true, /// Sorting is preserved indeed because of implementation.
+            .preserves_sorting = !parallel_final_distinct, /// Sorting is preserved indeed because of implementation.
         },
         {
             .preserves_number_of_rows = false,
@@ -58,16 +62,18 @@ DistinctStep::DistinctStep(
     UInt64 limit_hint_,
     const Names & columns_,
     bool pre_distinct_,
-    bool optimize_distinct_in_order_)
+    bool optimize_distinct_in_order_,
+    bool parallel_final_distinct_)
     : ITransformingStep(
             input_stream_,
             input_stream_.header,
-            getTraits(pre_distinct_, checkColumnsAlreadyDistinct(columns_, input_stream_.distinct_columns)))
+            getTraits(pre_distinct_, checkColumnsAlreadyDistinct(columns_, input_stream_.distinct_columns), !pre_distinct_ && parallel_final_distinct_))
     , set_size_limits(set_size_limits_)
     , limit_hint(limit_hint_)
     , columns(columns_)
     , pre_distinct(pre_distinct_)
     , optimize_distinct_in_order(optimize_distinct_in_order_)
+    , parallel_final_distinct(!pre_distinct_ && parallel_final_distinct_)
 {
     if (!output_stream->distinct_columns.empty() /// Columns already distinct, do nothing
         && (!pre_distinct /// Main distinct
@@ -86,7 +92,63 @@ void DistinctStep::transformPipeline(QueryPipelineBuilder & pipeline, const Buil
         return;
 
     if (!pre_distinct)
+    {
+        /// Execute the final DISTINCT on disjoint hash partitions in parallel instead of
+        /// merging everything into a single stream: the same two-phase shape that two-level
+        /// aggregation has. Not combined with a limit hint, because every partition would
+        /// apply the limit independently.
+        if (parallel_final_distinct && limit_hint == 0 && pipeline.getNumStreams() > 1)
+        {
+            ColumnNumbers key_columns;
+            key_columns.reserve(columns.size());
+            for (const auto & name : columns)
+                key_columns.push_back(input_stream.header.getPositionByName(name));
+
+            pipeline.transform([&](OutputPortRawPtrs ports)
+            {
+                const size_t num_streams = ports.size();
+                Processors processors;
+
+                /// Rows are scattered by key hash into num_streams partitions; all the parts
+                /// of one partition are merged back by a Resize, so every resulting stream
+                /// holds a disjoint set of key values and can be deduplicated independently.
+                Processors resizes;
+                resizes.reserve(num_streams);
+                for (size_t partition = 0; partition < num_streams; ++partition)
+                    resizes.push_back(std::make_shared<ResizeProcessor>(input_stream.header, num_streams, 1));
+
+                for (size_t i = 0; i < num_streams; ++i)
+                {
+                    auto scatter = std::make_shared<ScatterByPartitionTransform>(input_stream.header, num_streams, key_columns);
+                    connect(*ports[i], scatter->getInputs().front());
+
+                    size_t partition = 0;
+                    for (auto & output : scatter->getOutputs())
+                    {
+                        connect(output, *std::next(resizes[partition]->getInputs().begin(), i));
+                        ++partition;
+                    }
+
+                    processors.push_back(std::move(scatter));
+                }
+
+                processors.insert(processors.end(), resizes.begin(), resizes.end());
+                return processors;
+            });
+
+            pipeline.addSimpleTransform(
+                [&](const Block & header, QueryPipelineBuilder::StreamType stream_type) -> ProcessorPtr
+                {
+                    if (stream_type != QueryPipelineBuilder::StreamType::Main)
+                        return nullptr;
+
+                    return std::make_shared<DistinctTransform>(header, set_size_limits, limit_hint, columns);
+                });
+            return;
+        }
+
         pipeline.resize(1);
+    }
 
     if (optimize_distinct_in_order)
     {
@@ -192,7 +254,7 @@ void DistinctStep::updateOutputStream()
     output_stream = createOutputStream(
         input_streams.front(),
         input_streams.front().header,
-        getTraits(pre_distinct, checkColumnsAlreadyDistinct(columns, input_streams.front().distinct_columns)).data_stream_traits);
+        getTraits(pre_distinct, checkColumnsAlreadyDistinct(columns, input_streams.front().distinct_columns), parallel_final_distinct).data_stream_traits);
 
     if (!output_stream->distinct_columns.empty() /// Columns already distinct, do nothing
         && (!pre_distinct /// Main distinct
@@ -15,7 +15,8 @@ public:
         UInt64 limit_hint_,
         const Names & columns_,
         bool pre_distinct_, /// If is enabled, execute distinct for separate streams. Otherwise, merge streams.
-        bool optimize_distinct_in_order_);
+        bool optimize_distinct_in_order_,
+        bool parallel_final_distinct_ = false); /// Execute the final distinct on disjoint hash partitions in parallel.
 
     String getName() const override { return "Distinct"; }
 
@@ -36,6 +37,7 @@ private:
     Names columns;
     bool pre_distinct;
     bool optimize_distinct_in_order;
+    bool parallel_final_distinct;
 };
 
 }
@@ -0,0 +1,59 @@
+#include <Processors/QueryPlan/DuplicatingStep.h>
+#include <Processors/Transforms/CopyTransform.h>
+#include <QueryPipeline/QueryPipelineBuilder.h>
+#include <IO/Operators.h>
+
+namespace DB
+{
+
+static ITransformingStep::Traits getTraits()
+{
+    return ITransformingStep::Traits
+    {
+        {
+            .preserves_distinct_columns = false,
+            .returns_single_stream = false,
+            .preserves_number_of_streams = false,
+            .preserves_sorting = false,
+        },
+        {
+            .preserves_number_of_rows = false,
+        }
+    };
+}
+
+DuplicatingStep::DuplicatingStep(const DataStream & input_stream_, size_t num_copies_)
+    : ITransformingStep(input_stream_, input_stream_.header, getTraits())
+    , num_copies(num_copies_)
+{
+}
+
+void DuplicatingStep::transformPipeline(QueryPipelineBuilder & pipeline, const BuildQueryPipelineSettings &)
+{
+    pipeline.transform([&](OutputPortRawPtrs ports)
+    {
+        Processors processors;
+        processors.reserve(ports.size());
+
+        for (auto * port : ports)
+        {
+            auto copy = std::make_shared<CopyTransform>(port->getHeader(), num_copies);
+            connect(*port, copy->getInputPort());
+            processors.push_back(std::move(copy));
+        }
+
+        return processors;
+    });
+}
+
+void DuplicatingStep::describeActions(FormatSettings & settings) const
+{
+    settings.out << String(settings.offset, ' ') << "Copies " << num_copies << '\n';
+}
+
+void DuplicatingStep::updateOutputStream()
+{
+    output_stream = createOutputStream(input_streams.front(), input_streams.front().header, getDataStreamTraits());
+}
+
+}
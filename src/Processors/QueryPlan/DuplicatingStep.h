@@ -0,0 +1,26 @@
+#pragma once
+#include <Processors/QueryPlan/ITransformingStep.h>
+
+namespace DB
+{
+
+/// Copy every chunk of the input to `num_copies` output streams.
+/// Used to execute identical UNION branches once; see InterpreterSelectWithUnionQuery.
+class DuplicatingStep : public ITransformingStep
+{
+public:
+    DuplicatingStep(const DataStream & input_stream_, size_t num_copies_);
+
+    String getName() const override { return "Duplicating"; }
+
+    void transformPipeline(QueryPipelineBuilder & pipeline, const BuildQueryPipelineSettings &) override;
+
+    void describeActions(FormatSettings & settings) const override;
+
+private:
+    void updateOutputStream() override;
+
+    size_t num_copies;
+};
+
+}
@@ -1,6 +1,10 @@
 #include <stack>
+#include <unordered_map>
+
+#include <base/arithmeticOverflow.h>
 
 #include <Common/JSONBuilder.h>
+#include <Common/typeid_cast.h>
 
 #include <Interpreters/ActionsDAG.h>
 #include <Interpreters/ArrayJoinAction.h>
@@ -8,12 +12,27 @@
 #include <IO/Operators.h>
 #include <IO/WriteBuffer.h>
 
+#include <Processors/QueryPlan/AggregatingStep.h>
 #include <Processors/QueryPlan/BuildQueryPipelineSettings.h>
+#include <Processors/QueryPlan/CreatingSetsStep.h>
+#include <Processors/QueryPlan/DistinctStep.h>
+#include <Processors/QueryPlan/ExpressionStep.h>
+#include <Processors/QueryPlan/ExtremesStep.h>
+#include <Processors/QueryPlan/FilterStep.h>
 #include <Processors/QueryPlan/IQueryPlanStep.h>
+#include <Processors/QueryPlan/JoinStep.h>
+#include <Processors/QueryPlan/LimitByStep.h>
+#include <Processors/QueryPlan/LimitStep.h>
+#include <Processors/QueryPlan/MergingAggregatedStep.h>
+#include <Processors/QueryPlan/OffsetStep.h>
 #include <Processors/QueryPlan/Optimizations/Optimizations.h>
 #include <Processors/QueryPlan/Optimizations/QueryPlanOptimizationSettings.h>
 #include <Processors/QueryPlan/QueryPlan.h>
 #include <Processors/QueryPlan/ReadFromMergeTree.h>
+#include <Processors/QueryPlan/SortingStep.h>
+#include <Processors/QueryPlan/TotalsHavingStep.h>
+#include <Processors/QueryPlan/UnionStep.h>
+#include <Processors/QueryPlan/WindowStep.h>
 
 #include <QueryPipeline/QueryPipelineBuilder.h>
 
@@ -201,7 +220,104 @@ QueryPipelineBuilderPtr QueryPlan::buildQueryPipeline(
     return last_pipeline;
 }
 
-static void explainStep(const IQueryPlanStep & step, JSONBuilder::JSONMap & map, const QueryPlan::ExplainPlanOptions & options)
+/// Upper bound for the number of rows the step may return, given the estimates for its children.
+/// Returns nothing if no sound estimate can be made for this kind of step.
+static std::optional<UInt64> estimateOutputRows(const IQueryPlanStep & step, const std::vector<std::optional<UInt64>> & children_estimates)
+{
+    if (const auto * reading = typeid_cast<const ReadFromMergeTree *>(&step))
+        return reading->estimateNumRows();
+
+    if (typeid_cast<const UnionStep *>(&step))
+    {
+        UInt64 total_rows = 0;
+        for (const auto & child_rows : children_estimates)
+        {
+            if (!child_rows)
+                return {};
+            total_rows += *child_rows;
+        }
+        return total_rows;
+    }
+
+    /// The result is the result of the main plan, the other children only fill the sets.
+    if (typeid_cast<const CreatingSetsStep *>(&step))
+        return children_estimates.empty() ? std::nullopt : children_estimates.front();
+
+    if (typeid_cast<const JoinStep *>(&step))
+    {
+        if (children_estimates.size() != 2 || !children_estimates[0] || !children_estimates[1])
+            return {};
+
+        /// Without key statistics the bound is the cross product plus the non-joined rows of both sides.
+        UInt64 left_rows = *children_estimates[0];
+        UInt64 right_rows = *children_estimates[1];
+
+        UInt64 result_rows;
+        if (common::mulOverflow(left_rows, right_rows, result_rows)
+            || common::addOverflow(result_rows, left_rows, result_rows)
+            || common::addOverflow(result_rows, right_rows, result_rows))
+            return std::numeric_limits<UInt64>::max();
+
+        return result_rows;
+    }
+
+    if (children_estimates.size() != 1 || !children_estimates.front())
+        return {};
+
+    UInt64 input_rows = *children_estimates.front();
+
+    if (const auto * limit = typeid_cast<const LimitStep *>(&step))
+    {
+        /// LIMIT WITH TIES may return more than limit + offset rows (but never more than the input),
+        /// and limit + offset may overflow (getLimitForSorting() returns 0 then): keep the input estimate.
+        if (size_t limit_with_offset = limit->getLimitForSorting(); limit_with_offset && !limit->withTies())
+            return std::min<UInt64>(input_rows, limit_with_offset);
+        return input_rows;
+    }
+
+    if (const auto * aggregating = typeid_cast<const AggregatingStep *>(&step))
+    {
+        /// Each grouping set may repeat the whole input.
+        if (aggregating->isGroupingSets())
+            return {};
+        return input_rows;
+    }
+
+    /// Steps which cannot return more rows than they consume: the input estimate stays an upper bound.
+    if (typeid_cast<const ExpressionStep *>(&step)
+        || typeid_cast<const FilterStep *>(&step)
+        || typeid_cast<const DistinctStep *>(&step)
+        || typeid_cast<const SortingStep *>(&step)
+        || typeid_cast<const MergingAggregatedStep *>(&step)
+        || typeid_cast<const TotalsHavingStep *>(&step)
+        || typeid_cast<const WindowStep *>(&step)
+        || typeid_cast<const LimitByStep *>(&step)
+        || typeid_cast<const OffsetStep *>(&step)
+        || typeid_cast<const ExtremesStep *>(&step))
+        return input_rows;
+
+    return {};
+}
+
+using EstimatedRowsMap = std::unordered_map<const QueryPlan::Node *, std::optional<UInt64>>;
+
+static std::optional<UInt64> collectEstimatedRows(const QueryPlan::Node * node, EstimatedRowsMap & estimates)
+{
+    std::vector<std::optional<UInt64>> children_estimates;
+    children_estimates.reserve(node->children.size());
+    for (const auto * child : node->children)
+        children_estimates.push_back(collectEstimatedRows(child, estimates));
+
+    auto estimate = estimateOutputRows(*node->step, children_estimates);
+    estimates[node] = estimate;
+    return estimate;
+}
+
+static void explainStep(
+    const IQueryPlanStep & step,
+    JSONBuilder::JSONMap & map,
+    const QueryPlan::ExplainPlanOptions & options,
+    std::optional<UInt64> estimated_rows = {})
 {
     map.add("Node Type", step.getName());
 
@@ -229,6 +345,9 @@ static void explainStep(const IQueryPlanStep & step, JSONBuilder::JSONMap & map,
         map.add("Header", std::move(header_array));
     }
 
+    if (estimated_rows)
+        map.add("Estimated Rows", *estimated_rows);
+
     if (options.actions)
         step.describeActions(map);
 
@@ -240,6 +359,10 @@ JSONBuilder::ItemPtr QueryPlan::explainPlan(const ExplainPlanOptions & options)
 {
     checkInitialized();
 
+    EstimatedRowsMap estimates;
+    if (options.estimates)
+        collectEstimatedRows(root, estimates);
+
     struct Frame
     {
         Node * node = {};
@@ -263,7 +386,7 @@ JSONBuilder::ItemPtr QueryPlan::explainPlan(const ExplainPlanOptions & options)
                 frame.children_array = std::make_unique<JSONBuilder::JSONArray>();
 
             frame.node_map = std::make_unique<JSONBuilder::JSONMap>();
-            explainStep(*frame.node->step, *frame.node_map, options);
+            explainStep(*frame.node->step, *frame.node_map, options, options.estimates ? estimates[frame.node] : std::nullopt);
         }
 
         if (frame.next_child < frame.node->children.size())
@@ -290,7 +413,8 @@ JSONBuilder::ItemPtr QueryPlan::explainPlan(const ExplainPlanOptions & options)
 static void explainStep(
     const IQueryPlanStep & step,
     IQueryPlanStep::FormatSettings & settings,
-    const QueryPlan::ExplainPlanOptions & options)
+    const QueryPlan::ExplainPlanOptions & options,
+    std::optional<UInt64> estimated_rows = {})
 {
     std::string prefix(settings.offset, ' ');
     settings.out << prefix;
@@ -342,6 +466,9 @@ static void explainStep(
         }
     }
 
+    if (estimated_rows)
+        settings.out << prefix << "Estimated rows: " << *estimated_rows << '\n';
+
     if (options.actions)
         step.describeActions(settings);
 
@@ -362,6 +489,10 @@ void QueryPlan::explainPlan(WriteBuffer & buffer, const ExplainPlanOptions & opt
 {
     checkInitialized();
 
+    EstimatedRowsMap estimates;
+    if (options.estimates)
+        collectEstimatedRows(root, estimates);
+
     IQueryPlanStep::FormatSettings settings{.out = buffer, .write_header = options.header};
 
     struct Frame
@@ -381,7 +512,7 @@ void QueryPlan::explainPlan(WriteBuffer & buffer, const ExplainPlanOptions & opt
         if (!frame.is_description_printed)
         {
             settings.offset = (stack.size() - 1) * settings.indent;
-            explainStep(*frame.node->step, settings, options);
+            explainStep(*frame.node->step, settings, options, options.estimates ? estimates[frame.node] : std::nullopt);
             frame.is_description_printed = true;
         }
 
@@ -73,6 +73,8 @@ public:
         bool indexes = false;
         /// Add information about sorting
         bool sorting = false;
+        /// Add the estimated number of output rows (an upper bound) to the steps for which it can be computed.
+        bool estimates = false;
     };
 
     struct ExplainPipelineOptions
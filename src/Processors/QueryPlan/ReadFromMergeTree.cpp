@@ -66,6 +66,11 @@ static MergeTreeReaderSettings getMergeTreeReaderSettings(
         .read_in_order = query_info.input_order_info != nullptr,
         .use_asynchronous_read_from_pool = settings.allow_asynchronous_read_from_io_pool_for_merge_tree
             && (settings.max_streams_to_max_threads_ratio > 1 || settings.max_streams_for_merge_tree_reading > 1),
+        .enable_multiple_prewhere_read_steps = settings.enable_multiple_prewhere_read_steps,
+        .prefetch_mark_ranges_into_cache = settings.merge_tree_prefetch_mark_ranges,
+        .mark_ranges_coalesce_gap = settings.merge_tree_min_bytes_for_seek,
+        .columns_cache = settings.use_columns_cache ? context->getColumnsCache() : nullptr,
+        .query_condition_cache = settings.use_query_condition_cache ? context->getQueryConditionCache() : nullptr,
     };
 }
 
@@ -204,6 +209,8 @@ Pipe ReadFromMergeTree::readFromPool(
         std::move(parts_with_range),
         storage_snapshot,
         prewhere_info,
+        actions_settings,
+        reader_settings,
         required_columns,
         virt_column_names,
         backoff_settings,
@@ -223,6 +230,7 @@ Pipe ReadFromMergeTree::readFromPool(
                 .callback = read_task_callback.value(),
                 .count_participating_replicas = client_info.count_participating_replicas,
                 .number_of_current_replica = client_info.number_of_current_replica,
+                .max_bytes_per_request = context->getSettingsRef().parallel_replicas_max_bytes_per_read_request,
                 .colums_to_read = required_columns
             };
         }
@@ -268,6 +276,7 @@ ProcessorPtr ReadFromMergeTree::createSource(
             .callback = read_task_callback.value(),
             .count_participating_replicas = client_info.count_participating_replicas,
             .number_of_current_replica = client_info.number_of_current_replica,
+            .max_bytes_per_request = context->getSettingsRef().parallel_replicas_max_bytes_per_read_request,
             .colums_to_read = required_columns
         };
     }
@@ -1119,6 +1128,10 @@ MergeTreeDataSelectAnalysisResultPtr ReadFromMergeTree::selectRangesToReadImpl(
             num_streams,
             result.index_stats,
             use_skip_indexes);
+
+        if (result.sampling.use_granule_sampling)
+            result.parts_with_ranges = MergeTreeDataSelectExecutor::sampleRangesByGranules(
+                std::move(result.parts_with_ranges), result.sampling, log);
     }
     catch (...)
     {
@@ -1208,6 +1221,11 @@ ReadFromMergeTree::AnalysisResult ReadFromMergeTree::getAnalysisResult() const
     return std::get<ReadFromMergeTree::AnalysisResult>(result_ptr->result);
 }
 
+UInt64 ReadFromMergeTree::estimateNumRows() const
+{
+    return getAnalysisResult().selected_rows;
+}
+
 void ReadFromMergeTree::initializePipeline(QueryPipelineBuilder & pipeline, const BuildQueryPipelineSettings &)
 {
     auto result = getAnalysisResult();
@@ -20,6 +20,12 @@ struct MergeTreeDataSelectSamplingData
     Float64 used_sample_factor = 1.0;
     std::shared_ptr<ASTFunction> filter_function;
     ActionsDAGPtr filter_expression;
+
+    /// Sampling without a declared sampling key: a pseudo-random subset of granules
+    /// is selected after the index analysis, see MergeTreeDataSelectExecutor::sampleRangesByGranules.
+    bool use_granule_sampling = false;
+    Float64 granule_sample_ratio = 1.0;
+    Float64 granule_sample_offset = 0.0;
 };
 
 struct MergeTreeDataSelectAnalysisResult;
@@ -132,6 +138,9 @@ public:
     UInt64 getSelectedRows() const { return selected_rows; }
     UInt64 getSelectedMarks() const { return selected_marks; }
 
+    /// The number of rows selected by the index analysis (runs the analysis if it was not done yet).
+    UInt64 estimateNumRows() const;
+
     static MergeTreeDataSelectAnalysisResultPtr selectRangesToRead(
         MergeTreeData::DataPartsVector parts,
         const PrewhereInfoPtr & prewhere_info,
@@ -218,13 +218,23 @@ void SortingStep::fullSort(QueryPipelineBuilder & pipeline, const SortDescriptio
 {
     if (!skip_partial_sort || limit_)
     {
+        /// For top-K queries share the LIMIT-th row threshold between all streams,
+        /// so that every stream prunes with the globally best cutoff instead of the
+        /// one found in its own stream only.
+        SortingThresholdSharedStatePtr shared_threshold;
+        if (limit_ && pipeline.getNumStreams() > 1)
+            shared_threshold = std::make_shared<SortingThresholdSharedState>(result_sort_desc);
+
         pipeline.addSimpleTransform(
             [&](const Block & header, QueryPipelineBuilder::StreamType stream_type) -> ProcessorPtr
             {
                 if (stream_type != QueryPipelineBuilder::StreamType::Main)
                     return nullptr;
 
-                return std::make_shared<PartialSortingTransform>(header, result_sort_desc, limit_);
+                auto transform = std::make_shared<PartialSortingTransform>(header, result_sort_desc, limit_);
+                if (shared_threshold)
+                    transform->setSharedThreshold(shared_threshold);
+                return transform;
             });
 
         StreamLocalLimits limits;
@@ -2,6 +2,7 @@
 
 #include <Processors/Transforms/WindowTransform.h>
 #include <Processors/Transforms/ExpressionTransform.h>
+#include <Processors/Transforms/ScatterByPartitionTransform.h>
 #include <QueryPipeline/QueryPipelineBuilder.h>
 #include <Interpreters/ExpressionActions.h>
 #include <IO/Operators.h>
@@ -10,15 +11,17 @@
 namespace DB
 {
 
-static ITransformingStep::Traits getTraits()
+static ITransformingStep::Traits getTraits(bool streams_fan_out)
 {
+    /// When the data is scattered by partitions across several streams,
+    /// neither the number of streams nor the sorting of the input is preserved.
     return ITransformingStep::Traits
     {
         {
             .preserves_distinct_columns = true,
             .returns_single_stream = false,
-            .preserves_number_of_streams = true,
-            .preserves_sorting = true,
+            .preserves_number_of_streams = !streams_fan_out,
+            .preserves_sorting = !streams_fan_out,
         },
         {
             .preserves_number_of_rows = true
@@ -47,10 +50,12 @@ static Block addWindowFunctionResultColumns(const Block & block,
 WindowStep::WindowStep(
     const DataStream & input_stream_,
     const WindowDescription & window_description_,
-    const std::vector<WindowFunctionDescription> & window_functions_)
-    : ITransformingStep(input_stream_, addWindowFunctionResultColumns(input_stream_.header, window_functions_), getTraits())
+    const std::vector<WindowFunctionDescription> & window_functions_,
+    bool streams_fan_out_)
+    : ITransformingStep(input_stream_, addWindowFunctionResultColumns(input_stream_.header, window_functions_), getTraits(streams_fan_out_))
     , window_description(window_description_)
     , window_functions(window_functions_)
+    , streams_fan_out(streams_fan_out_)
 {
     // We don't remove any columns, only add, so probably we don't have to update
     // the output DataStream::distinct_columns.
@@ -61,11 +66,32 @@ WindowStep::WindowStep(
 
 void WindowStep::transformPipeline(QueryPipelineBuilder & pipeline, const BuildQueryPipelineSettings &)
 {
+    const size_t threads = pipeline.getNumThreads();
+
     // This resize is needed for cases such as `over ()` when we don't have a
     // sort node, and the input might have multiple streams. The sort node would
     // have resized it.
     pipeline.resize(1);
 
+    if (streams_fan_out && threads > 1 && !window_description.partition_by.empty())
+    {
+        // Distribute partitions across the threads: every stream gets its own subset
+        // of partitions and processes them independently. Scattering a stream sorted
+        // by (PARTITION BY, ORDER BY) keeps every output stream sorted the same way.
+        ColumnNumbers key_columns;
+        key_columns.reserve(window_description.partition_by.size());
+        for (const auto & col : window_description.partition_by)
+            key_columns.push_back(input_streams.front().header.getPositionByName(col.column_name));
+
+        pipeline.transform([&](OutputPortRawPtrs ports)
+        {
+            auto scatter = std::make_shared<ScatterByPartitionTransform>(
+                input_streams.front().header, threads, std::move(key_columns));
+            connect(*ports.front(), scatter->getInputs().front());
+            return Processors{std::move(scatter)};
+        });
+    }
+
     pipeline.addSimpleTransform(
         [&](const Block & /*header*/)
         {
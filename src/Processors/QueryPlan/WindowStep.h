@@ -14,9 +14,14 @@ class WindowTransform;
 class WindowStep : public ITransformingStep
 {
 public:
+    /// If streams_fan_out_ is set, the data is scattered across several streams by a hash
+    /// of the PARTITION BY columns and the window functions are evaluated in parallel,
+    /// one stream per set of partitions. The output is no longer a single sorted stream then,
+    /// so it must not be used when the following step relies on this sorting.
     explicit WindowStep(const DataStream & input_stream_,
             const WindowDescription & window_description_,
-            const std::vector<WindowFunctionDescription> & window_functions_);
+            const std::vector<WindowFunctionDescription> & window_functions_,
+            bool streams_fan_out_ = false);
 
     String getName() const override { return "Window"; }
 
@@ -32,6 +37,7 @@ private:
 
     WindowDescription window_description;
     std::vector<WindowFunctionDescription> window_functions;
+    bool streams_fan_out;
 };
 
 }
@@ -287,9 +287,12 @@ namespace
                 /** Currently parallel parsing input format cannot read exactly max_block_size rows from input,
                   * so it will be blocked on ReadBufferFromFileDescriptor because this file descriptor represent pipe that does not have eof.
                   */
-                auto context_for_reading = Context::createCopy(context);
-                context_for_reading->setSetting("input_format_parallel_parsing", false);
-                context = context_for_reading;
+                if (context->getSettingsRef().input_format_parallel_parsing)
+                {
+                    auto context_for_reading = Context::createCopy(context);
+                    context_for_reading->setSetting("input_format_parallel_parsing", false);
+                    context = context_for_reading;
+                }
 
                 if (configuration.read_number_of_rows_from_process_output)
                 {
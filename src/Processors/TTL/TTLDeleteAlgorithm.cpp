@@ -22,34 +22,65 @@ void TTLDeleteAlgorithm::execute(Block & block)
     auto ttl_column = executeExpressionAndGetColumn(description.expression, block, description.result_column);
     auto where_column = executeExpressionAndGetColumn(description.where_expression, block, description.where_result_column);
 
-    MutableColumns result_columns;
-    const auto & column_names = block.getNames();
+    size_t rows = block.rows();
 
-    result_columns.reserve(column_names.size());
-    for (auto it = column_names.begin(); it != column_names.end(); ++it)
-    {
-        const IColumn * values_column = block.getByName(*it).column.get();
-        MutableColumnPtr result_column = values_column->cloneEmpty();
-        result_column->reserve(block.rows());
+    /// Compute the TTL range of the block first: most blocks of a TTL merge lie entirely
+    /// on one side of the expiry boundary and can be kept or dropped as a whole, without
+    /// building a filter and rewriting every column.
+    UInt32 min_nonzero_ttl = 0;
+    UInt32 max_ttl = 0;
+    bool has_zero_ttl = false;
 
-        for (size_t i = 0; i < block.rows(); ++i)
+    for (size_t i = 0; i < rows; ++i)
+    {
+        UInt32 cur_ttl = getTimestampByIndex(ttl_column.get(), i);
+        if (cur_ttl)
         {
-            UInt32 cur_ttl = getTimestampByIndex(ttl_column.get(), i);
-            bool where_filter_passed = !where_column || where_column->getBool(i);
-
-            if (!isTTLExpired(cur_ttl) || !where_filter_passed)
-            {
-                new_ttl_info.update(cur_ttl);
-                result_column->insertFrom(*values_column, i);
-            }
-            else if (it == column_names.begin())
-                ++rows_removed;
+            if (!min_nonzero_ttl || cur_ttl < min_nonzero_ttl)
+                min_nonzero_ttl = cur_ttl;
+            max_ttl = std::max(max_ttl, cur_ttl);
         }
+        else
+            has_zero_ttl = true;
+    }
+
+    /// No row of the block has expired (rows with zero TTL never expire): keep the block as is.
+    if (!isTTLExpired(min_nonzero_ttl))
+    {
+        new_ttl_info.update(min_nonzero_ttl);
+        new_ttl_info.update(max_ttl);
+        return;
+    }
+
+    /// All rows of the block have expired and there is no WHERE to restrict the deletion.
+    if (!where_column && !has_zero_ttl && isTTLExpired(max_ttl))
+    {
+        rows_removed += rows;
+        block = block.cloneEmpty();
+        return;
+    }
+
+    /// The block straddles the expiry boundary: filter it row by row.
+    IColumn::Filter keep(rows);
+    size_t rows_kept = 0;
 
-        result_columns.emplace_back(std::move(result_column));
+    for (size_t i = 0; i < rows; ++i)
+    {
+        UInt32 cur_ttl = getTimestampByIndex(ttl_column.get(), i);
+        bool where_filter_passed = !where_column || where_column->getBool(i);
+
+        keep[i] = !isTTLExpired(cur_ttl) || !where_filter_passed;
+        if (keep[i])
+        {
+            new_ttl_info.update(cur_ttl);
+            ++rows_kept;
+        }
+        else
+            ++rows_removed;
     }
 
-    block = block.cloneWithColumns(std::move(result_columns));
+    for (auto & column : block)
+        column.column = column.column->filter(keep, rows_kept);
 }
 
 void TTLDeleteAlgorithm::finalize(const MutableDataPartPtr & data_part) const
@@ -1,9 +1,13 @@
 #include <Processors/Transforms/AggregatingTransform.h>
 
 #include <Formats/NativeReader.h>
+#include <Processors/ISimpleTransform.h>
 #include <Processors/ISource.h>
+#include <Processors/Merges/AggregatingSortedTransform.h>
 #include <QueryPipeline/Pipe.h>
 #include <Processors/Transforms/MergingAggregatedMemoryEfficientTransform.h>
+#include <Processors/Transforms/finalizeChunk.h>
+#include <Interpreters/ProcessList.h>
 #include <Core/ProtocolDefines.h>
 
 namespace ProfileEvents
@@ -77,6 +81,38 @@ namespace
     private:
         TemporaryFileStream * tmp_stream;
     };
+
+    /// Converts the result of a streaming merge of sorted spill runs back to the shape
+    /// the rest of the pipeline expects: drops the service "__bucket" column and
+    /// finalizes aggregate function states if the result must be final.
+    class ConvertSortedSpillToAggregatedTransform : public ISimpleTransform
+    {
+    public:
+        ConvertSortedSpillToAggregatedTransform(const Block & header, AggregatingTransformParamsPtr params_)
+            : ISimpleTransform(header, params_->getHeader(), false)
+            , params(std::move(params_))
+            , aggregates_mask(getAggregatesMask(params->getCustomHeader(false), params->params.aggregates))
+        {
+        }
+
+        String getName() const override { return "ConvertSortedSpillToAggregatedTransform"; }
+
+    protected:
+        void transform(Chunk & chunk) override
+        {
+            auto num_rows = chunk.getNumRows();
+            auto columns = chunk.detachColumns();
+            columns.erase(columns.begin());
+            chunk.setColumns(std::move(columns), num_rows);
+
+            if (params->final)
+                finalizeChunk(chunk, aggregates_mask);
+        }
+
+    private:
+        AggregatingTransformParamsPtr params;
+        const ColumnsMask aggregates_mask;
+    };
 }
 
 /// Worker which merges buckets for two-level aggregation.
@@ -533,6 +569,57 @@ void AggregatingTransform::consume(Chunk chunk)
         if (!params->aggregator.executeOnBlock(chunk.detachColumns(), 0, num_rows, variants, key_columns, aggregate_columns, no_more_keys))
             is_consume_finished = true;
     }
+
+    maybeDepositPartialResult();
+}
+
+void AggregatingTransform::maybeDepositPartialResult()
+{
+    if (!partial_results_checked)
+    {
+        partial_results_checked = true;
+
+        if (!CurrentThread::isInitialized())
+            return;
+
+        auto query_context = CurrentThread::get().getQueryContext();
+        if (!query_context)
+            return;
+
+        partial_result_update_duration_ms = query_context->getSettingsRef().partial_result_update_duration_ms.totalMilliseconds();
+        if (!partial_result_update_duration_ms)
+            return;
+
+        auto process_list_elem = query_context->getProcessListElement();
+        if (!process_list_elem)
+            return;
+
+        auto holder = process_list_elem->getPartialResultsHolder();
+
+        /// The merge function captures 'params' so that the Aggregator stays alive
+        /// while the connection thread merges the deposited snapshots.
+        auto merge_params = params;
+        ssize_t slot = holder->registerThread(
+            params->getCustomHeader(false),
+            [merge_params](BlocksList && blocks) { return merge_params->aggregator.mergeBlocks(blocks, /* final */ true); });
+
+        if (slot < 0)
+            return;
+
+        partial_results_holder = std::move(holder);
+        partial_results_slot = slot;
+        partial_results_watch.restart();
+        return;
+    }
+
+    if (!partial_results_holder)
+        return;
+
+    if (partial_results_watch.elapsedMilliseconds() < partial_result_update_duration_ms)
+        return;
+
+    partial_results_watch.restart();
+    partial_results_holder->deposit(partial_results_slot, params->aggregator.snapshotToBlock(variants));
 }
 
 void AggregatingTransform::initGenerate()
@@ -622,7 +709,24 @@ void AggregatingTransform::initGenerate()
             ReadableSize(compressed_size),
             ReadableSize(uncompressed_size));
 
-        addMergingAggregatedMemoryEfficientTransform(pipe, params, temporary_data_merge_threads);
+        if (params->aggregator.spillsSortedRuns())
+        {
+            /// Every temporary file is a run sorted by (bucket, grouping key), so a streaming
+            /// k-way merge combines the states of equal keys with O(block) memory per run,
+            /// instead of collecting a whole bucket from every file into a hash table.
+            pipe.addTransform(std::make_shared<AggregatingSortedTransform>(
+                pipe.getHeader(),
+                pipe.numOutputPorts(),
+                params->aggregator.getSpillSortDescription(),
+                params->params.max_block_size));
+
+            pipe.addSimpleTransform([&](const Block & header)
+            {
+                return std::make_shared<ConvertSortedSpillToAggregatedTransform>(header, params);
+            });
+        }
+        else
+            addMergingAggregatedMemoryEfficientTransform(pipe, params, temporary_data_merge_threads);
 
         processors = Pipe::detachProcessors(std::move(pipe));
     }
@@ -10,6 +10,9 @@
 namespace DB
 {
 
+struct PartialResultsHolder;
+using PartialResultsHolderPtr = std::shared_ptr<PartialResultsHolder>;
+
 class AggregatedChunkInfo : public ChunkInfo
 {
 public:
@@ -200,7 +203,16 @@ private:
 
     bool is_consume_started = false;
 
+    /// Periodic snapshots of 'variants' for partial results
+    /// (see the partial_result_update_duration_ms setting).
+    bool partial_results_checked = false;
+    PartialResultsHolderPtr partial_results_holder;
+    size_t partial_results_slot = 0;
+    UInt64 partial_result_update_duration_ms = 0;
+    Stopwatch partial_results_watch;
+
     void initGenerate();
+    void maybeDepositPartialResult();
 };
 
 Chunk convertToChunk(const Block & block);
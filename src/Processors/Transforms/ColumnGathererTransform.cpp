@@ -4,6 +4,7 @@
 #include <Common/formatReadable.h>
 #include <IO/WriteHelpers.h>
 #include <iomanip>
+#include <limits>
 
 
 namespace DB
@@ -16,13 +17,62 @@ namespace ErrorCodes
     extern const int RECEIVED_EMPTY_DATA;
 }
 
+RowSourceRunsPtr decodeRowSourceRuns(ReadBuffer & buf)
+{
+    auto runs = std::make_shared<RowSourceRuns>();
+
+    while (!buf.eof())
+    {
+        const auto * pos = reinterpret_cast<const RowSourcePart *>(buf.position());
+        const auto * end = reinterpret_cast<const RowSourcePart *>(buf.buffer().end());
+
+        while (pos < end)
+        {
+            RowSourcePart current = *pos;
+            size_t len = 1;
+            ++pos;
+            while (pos < end && pos->data == current.data)
+            {
+                ++len;
+                ++pos;
+            }
+
+            /// A run may continue in the next buffer; runs longer than UINT32_MAX rows are split.
+            constexpr size_t max_run_length = std::numeric_limits<UInt32>::max();
+            while (len)
+            {
+                if (!runs->empty() && runs->back().source.data == current.data && runs->back().length != max_run_length)
+                {
+                    size_t to_add = std::min(len, max_run_length - runs->back().length);
+                    runs->back().length += to_add;
+                    len -= to_add;
+                }
+                else
+                {
+                    auto to_add = static_cast<UInt32>(std::min(len, max_run_length));
+                    runs->push_back({current, to_add});
+                    len -= to_add;
+                }
+            }
+        }
+
+        buf.position() = buf.buffer().end();
+    }
+
+    return runs;
+}
+
 ColumnGathererStream::ColumnGathererStream(
-    size_t num_inputs, ReadBuffer & row_sources_buf_, size_t block_preferred_size_)
-    : sources(num_inputs), row_sources_buf(row_sources_buf_)
+    size_t num_inputs, RowSourceRunsPtr row_sources_, size_t block_preferred_size_)
+    : sources(num_inputs), row_sources(std::move(row_sources_))
     , block_preferred_size(block_preferred_size_)
+    , source_pos_at_block_start(num_inputs)
 {
     if (num_inputs == 0)
         throw Exception(ErrorCodes::EMPTY_DATA_PASSED, "There are no streams to gather");
+
+    for (const auto & run : *row_sources)
+        remaining_rows += run.length;
 }
 
 void ColumnGathererStream::initialize(Inputs inputs)
@@ -31,9 +81,10 @@ void ColumnGathererStream::initialize(Inputs inputs)
     {
         if (inputs[i].chunk)
         {
-            sources[i].update(inputs[i].chunk.detachColumns().at(0));
-            if (!result_column)
-                result_column = sources[i].column->cloneEmpty();
+            sources[i].update(inputs[i].chunk.detachColumns());
+            if (result_columns.empty())
+                for (const auto & column : sources[i].columns)
+                    result_columns.emplace_back(column->cloneEmpty());
         }
     }
 }
@@ -41,30 +92,35 @@ void ColumnGathererStream::initialize(Inputs inputs)
 IMergingAlgorithm::Status ColumnGathererStream::merge()
 {
     /// Nothing to read after initialize.
-    if (!result_column)
+    if (result_columns.empty())
         return Status(Chunk(), true);
 
     if (source_to_fully_copy) /// Was set on a previous iteration
     {
         Chunk res;
-        res.addColumn(source_to_fully_copy->column);
         merged_rows += source_to_fully_copy->size;
+        for (const auto & column : source_to_fully_copy->columns)
+            res.addColumn(column);
         source_to_fully_copy->pos = source_to_fully_copy->size;
         source_to_fully_copy = nullptr;
         return Status(std::move(res));
     }
 
     /// Special case: single source and there are no skipped rows
-    /// Note: looks like this should never happen because row_sources_buf cannot just skip row info.
-    if (sources.size() == 1 && row_sources_buf.eof())
+    /// Note: looks like this should never happen because row sources cannot just skip row info.
+    if (sources.size() == 1 && row_sources->empty())
     {
         if (sources.front().pos < sources.front().size)
         {
             next_required_source = 0;
             Chunk res;
-            merged_rows += sources.front().column->size();
-            merged_bytes += sources.front().column->allocatedBytes();
-            res.addColumn(std::move(sources.front().column));
+            merged_rows += sources.front().size;
+            for (auto & column : sources.front().columns)
+            {
+                merged_bytes += column->allocatedBytes();
+                res.addColumn(std::move(column));
+            }
+            sources.front().columns.clear();
             sources.front().pos = sources.front().size = 0;
             return Status(std::move(res));
         }
@@ -79,32 +135,58 @@ IMergingAlgorithm::Status ColumnGathererStream::merge()
     if (next_required_source != -1 && sources[next_required_source].size == 0)
         throw Exception(ErrorCodes::RECEIVED_EMPTY_DATA, "Cannot fetch required block. Source {}", toString(next_required_source));
 
-    /// Surprisingly this call may directly change some internal state of ColumnGathererStream.
-    /// output_column. See ColumnGathererStream::gather.
-    result_column->gather(*this);
+    /// Remember where this output block starts in the row sources, to replay the
+    /// very same segment of the mask for every column of the group. All columns stop
+    /// at the same point because source block sizes are the same for all of them.
+    run_index_at_block_start = run_index;
+    run_offset_at_block_start = run_offset;
+    for (size_t i = 0; i < sources.size(); ++i)
+        source_pos_at_block_start[i] = sources[i].pos;
+
+    for (active_column = 0; active_column < result_columns.size(); ++active_column)
+    {
+        if (active_column != 0)
+        {
+            run_index = run_index_at_block_start;
+            run_offset = run_offset_at_block_start;
+            for (size_t i = 0; i < sources.size(); ++i)
+                sources[i].pos = source_pos_at_block_start[i];
+            source_to_fully_copy = nullptr;
+        }
+
+        /// Surprisingly this call may directly change some internal state of ColumnGathererStream.
+        /// output_column. See ColumnGathererStream::gather.
+        result_columns[active_column]->gather(*this);
+    }
+    active_column = 0;
 
     if (next_required_source != -1)
         return Status(next_required_source);
 
-    if (source_to_fully_copy && result_column->empty())
+    if (source_to_fully_copy && result_columns.front()->empty())
     {
         Chunk res;
-        merged_rows += source_to_fully_copy->column->size();
-        merged_bytes += source_to_fully_copy->column->allocatedBytes();
-        res.addColumn(source_to_fully_copy->column);
+        merged_rows += source_to_fully_copy->size;
+        for (const auto & column : source_to_fully_copy->columns)
+        {
+            merged_bytes += column->allocatedBytes();
+            res.addColumn(column);
+        }
         source_to_fully_copy->pos = source_to_fully_copy->size;
         source_to_fully_copy = nullptr;
         return Status(std::move(res));
     }
 
-    auto col = result_column->cloneEmpty();
-    result_column.swap(col);
-
     Chunk res;
-    merged_rows += col->size();
-    merged_bytes += col->allocatedBytes();
-    res.addColumn(std::move(col));
-    return Status(std::move(res), row_sources_buf.eof() && !source_to_fully_copy);
+    merged_rows += result_columns.front()->size();
+    for (auto & result_column : result_columns)
+    {
+        auto col = result_column->cloneEmpty();
+        result_column.swap(col);
+        merged_bytes += col->allocatedBytes();
+        res.addColumn(std::move(col));
+    }
+    return Status(std::move(res), run_index >= row_sources->size() && !source_to_fully_copy);
 }
 
 
@@ -112,7 +194,7 @@ void ColumnGathererStream::consume(Input & input, size_t source_num)
 {
     auto & source = sources[source_num];
     if (input.chunk)
-        source.update(input.chunk.getColumns().at(0));
+        source.update(input.chunk.getColumns());
 
     if (0 == source.size)
     {
@@ -123,16 +205,15 @@ void ColumnGathererStream::consume(Input & input, size_t source_num)
 ColumnGathererTransform::ColumnGathererTransform(
     const Block & header,
     size_t num_inputs,
-    ReadBuffer & row_sources_buf_,
+    RowSourceRunsPtr row_sources_,
     size_t block_preferred_size_)
     : IMergingTransform<ColumnGathererStream>(
         num_inputs, header, header, /*have_all_inputs_=*/ true, /*limit_hint_=*/ 0,
-        num_inputs, row_sources_buf_, block_preferred_size_)
+        num_inputs, std::move(row_sources_), block_preferred_size_)
     , log(&Poco::Logger::get("ColumnGathererStream"))
 {
-    if (header.columns() != 1)
-        throw Exception(ErrorCodes::INCORRECT_NUMBER_OF_COLUMNS, "Header should have 1 column, but contains {}",
-            toString(header.columns()));
+    if (header.columns() == 0)
+        throw Exception(ErrorCodes::INCORRECT_NUMBER_OF_COLUMNS, "Header should have at least 1 column");
 }
 
 void ColumnGathererTransform::work()
@@ -151,14 +232,14 @@ void ColumnGathererTransform::onFinish()
         return;
 
     double seconds = static_cast<double>(elapsed_ns) / 1000000000ULL;
-    const auto & column_name = getOutputPort().getHeader().getByPosition(0).name;
+    const auto column_names = getOutputPort().getHeader().dumpNames();
 
     if (seconds == 0.0)
-        LOG_DEBUG(log, "Gathered column {} ({} bytes/elem.) in 0 sec.",
-            column_name, static_cast<double>(merged_bytes) / merged_rows);
+        LOG_DEBUG(log, "Gathered columns {} ({} bytes/elem.) in 0 sec.",
+            column_names, static_cast<double>(merged_bytes) / merged_rows);
     else
-        LOG_DEBUG(log, "Gathered column {} ({} bytes/elem.) in {} sec., {} rows/sec., {}/sec.",
-            column_name, static_cast<double>(merged_bytes) / merged_rows, seconds,
+        LOG_DEBUG(log, "Gathered columns {} ({} bytes/elem.) in {} sec., {} rows/sec., {}/sec.",
+            column_names, static_cast<double>(merged_bytes) / merged_rows, seconds,
             merged_rows / seconds, ReadableSize(merged_bytes / seconds));
 }
 
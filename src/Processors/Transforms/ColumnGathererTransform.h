@@ -49,15 +49,35 @@ struct RowSourcePart
 
 using MergedRowSources = PODArray<RowSourcePart>;
 
+/// A run of consecutive rows gathered from the same source part.
+/// Runs longer than UINT32_MAX rows are split into several entries.
+struct RowSourceRun
+{
+    RowSourcePart source;
+    UInt32 length = 0;
+};
+
+/// Row sources of a whole merge in run-length form. Merges mostly interleave long runs
+/// of rows coming from the same part, so this is much more compact than one byte per row.
+/// It is decoded once and shared between all column passes of a vertical merge instead of
+/// re-reading and re-decompressing the rows_sources file for every column.
+using RowSourceRuns = std::vector<RowSourceRun>;
+using RowSourceRunsPtr = std::shared_ptr<const RowSourceRuns>;
+
+/// Decode a stream of RowSourcePart bytes (as written by merging algorithms) into runs.
+RowSourceRunsPtr decodeRowSourceRuns(ReadBuffer & buf);
+
 
 /** Gather single stream from multiple streams according to streams mask.
   * Stream mask maps row number to index of source stream.
-  * Streams should contain exactly one column.
+  * All streams should contain the same set of columns (one column group). Columns of
+  * a group are gathered in one pass over the mask: the same segment of row sources is
+  * replayed for every column of the current output block.
   */
 class ColumnGathererStream final : public IMergingAlgorithm
 {
 public:
-    ColumnGathererStream(size_t num_inputs, ReadBuffer & row_sources_buf_, size_t block_preferred_size_ = DEFAULT_BLOCK_SIZE);
+    ColumnGathererStream(size_t num_inputs, RowSourceRunsPtr row_sources_, size_t block_preferred_size_ = DEFAULT_BLOCK_SIZE);
 
     void initialize(Inputs inputs) override;
     void consume(Input & input, size_t source_num) override;
@@ -74,22 +94,22 @@ private:
     /// Cache required fields
     struct Source
     {
-        ColumnPtr column;
+        Columns columns;
         size_t pos = 0;
         size_t size = 0;
 
-        void update(ColumnPtr column_)
+        void update(Columns columns_)
         {
-            column = std::move(column_);
-            size = column->size();
+            columns = std::move(columns_);
+            size = columns.empty() ? 0 : columns.front()->size();
             pos = 0;
         }
     };
 
-    MutableColumnPtr result_column;
+    MutableColumns result_columns;
 
     std::vector<Source> sources;
-    ReadBuffer & row_sources_buf;
+    RowSourceRunsPtr row_sources;
 
     const size_t block_preferred_size;
 
@@ -98,6 +118,19 @@ private:
     ssize_t next_required_source = -1;
     size_t cur_block_preferred_size = 0;
 
+    /// Cursor over `row_sources`.
+    size_t run_index = 0;
+    size_t run_offset = 0;
+    /// Rows (including skipped ones) left to consume. Only a hint for block size.
+    size_t remaining_rows = 0;
+
+    /// The column of the group which is being gathered now; the cursor and source
+    /// positions are rolled back to the block start for every next column.
+    size_t active_column = 0;
+    size_t run_index_at_block_start = 0;
+    size_t run_offset_at_block_start = 0;
+    std::vector<size_t> source_pos_at_block_start;
+
     UInt64 merged_rows = 0;
     UInt64 merged_bytes = 0;
 };
@@ -108,7 +141,7 @@ public:
     ColumnGathererTransform(
         const Block & header,
         size_t num_inputs,
-        ReadBuffer & row_sources_buf_,
+        RowSourceRunsPtr row_sources_,
         size_t block_preferred_size_ = DEFAULT_BLOCK_SIZE);
 
     String getName() const override { return "ColumnGathererTransform"; }
@@ -126,26 +159,24 @@ protected:
 template <typename Column>
 void ColumnGathererStream::gather(Column & column_res)
 {
-    row_sources_buf.nextIfAtEnd();
-    RowSourcePart * row_source_pos = reinterpret_cast<RowSourcePart *>(row_sources_buf.position());
-    RowSourcePart * row_sources_end = reinterpret_cast<RowSourcePart *>(row_sources_buf.buffer().end());
+    const RowSourceRuns & runs = *row_sources;
 
-    if (next_required_source == -1)
+    if (next_required_source == -1 && active_column == 0)
     {
-        /// Start new column.
-        cur_block_preferred_size = std::min(static_cast<size_t>(row_sources_end - row_source_pos), block_preferred_size);
-        column_res.reserve(cur_block_preferred_size);
+        /// Start new block.
+        cur_block_preferred_size = std::min(remaining_rows, block_preferred_size);
     }
+    column_res.reserve(cur_block_preferred_size);
 
     size_t cur_size = column_res.size();
     next_required_source = -1;
 
-    while (row_source_pos < row_sources_end && cur_size < cur_block_preferred_size)
+    while (run_index < runs.size() && cur_size < cur_block_preferred_size)
     {
-        RowSourcePart row_source = *row_source_pos;
-        size_t source_num = row_source.getSourceNum();
+        const RowSourceRun & run = runs[run_index];
+        size_t source_num = run.source.getSourceNum();
         Source & source = sources[source_num];
-        bool source_skip = row_source.getSkipFlag();
+        bool source_skip = run.source.getSkipFlag();
 
         if (source.pos >= source.size) /// Fetch new block from source_num part
         {
@@ -153,33 +184,36 @@ void ColumnGathererStream::gather(Column & column_res)
             return;
         }
 
-        ++row_source_pos;
+        /// The interval should be in the same source block.
+        size_t len = std::min(static_cast<size_t>(run.length - run_offset), source.size - source.pos);
 
-        /// Consecutive optimization. TODO: precompute lengths
-        size_t len = 1;
-        size_t max_len = std::min(static_cast<size_t>(row_sources_end - row_source_pos), source.size - source.pos); // interval should be in the same block
-        while (len < max_len && row_source_pos->data == row_source.data)
+        run_offset += len;
+        if (run_offset == run.length)
         {
-            ++len;
-            ++row_source_pos;
+            ++run_index;
+            run_offset = 0;
         }
 
-        row_sources_buf.position() = reinterpret_cast<char *>(row_source_pos);
+        /// The cursor is rolled back when the block is replayed for the rest of the group.
+        if (active_column == 0)
+            remaining_rows -= len;
 
         if (!source_skip)
         {
+            const IColumn & source_column = *source.columns[active_column];
+
             /// Whole block could be produced via copying pointer from current block
             if (source.pos == 0 && source.size == len)
             {
                 /// If current block already contains data, return it.
-                /// Whole column from current source will be returned on next read() iteration.
+                /// Whole columns from current source will be returned on next read() iteration.
                 source_to_fully_copy = &source;
                 return;
             }
             else if (len == 1)
-                column_res.insertFrom(*source.column, source.pos);
+                column_res.insertFrom(source_column, source.pos);
             else
-                column_res.insertRangeFrom(*source.column, source.pos, len);
+                column_res.insertRangeFrom(source_column, source.pos, len);
 
             cur_size += len;
         }
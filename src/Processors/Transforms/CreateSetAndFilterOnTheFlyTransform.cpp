@@ -4,11 +4,13 @@
 #include <mutex>
 
 #include <Interpreters/Set.h>
+#include <Common/FieldVisitorsAccurateComparison.h>
 #include <Common/Stopwatch.h>
 #include <Common/formatReadable.h>
 #include <Common/logger_useful.h>
 #include <Columns/IColumn.h>
 #include <Core/ColumnWithTypeAndName.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <base/types.h>
 
 namespace DB
@@ -46,6 +48,56 @@ ColumnsWithTypeAndName getColumnsByIndices(const Block & sample_block, const Chu
     return block.getColumnsWithTypeAndName();
 }
 
+/// Key range tracking relies on IColumn::getExtremes returning the real min and max,
+/// which holds for scalar types but not for compound ones (e.g. ColumnArray returns defaults).
+bool canTrackKeyRange(const DataTypePtr & type)
+{
+    auto nested = removeNullable(type);
+    return nested->isValueRepresentedByNumber() || isStringOrFixedString(nested);
+}
+
+bool accurateLess(const Field & lhs, const Field & rhs)
+{
+    return applyVisitor(FieldVisitorAccurateLess{}, lhs, rhs);
+}
+
+}
+
+void SetWithState::updateKeyRange(const Field & chunk_min, const Field & chunk_max)
+{
+    /// Extremes are Null for empty or all-NULL chunks, and NULL keys never match anyway.
+    if (chunk_min.isNull() || chunk_max.isNull())
+        return;
+
+    std::lock_guard lock(key_range_mutex);
+    if (!has_key_range)
+    {
+        key_range_min = chunk_min;
+        key_range_max = chunk_max;
+        has_key_range = true;
+        return;
+    }
+
+    if (accurateLess(chunk_min, key_range_min))
+        key_range_min = chunk_min;
+    if (accurateLess(key_range_max, chunk_max))
+        key_range_max = chunk_max;
+}
+
+void SetWithState::finalizeKeyRange()
+{
+    key_range_ready.store(true, std::memory_order_release);
+}
+
+std::optional<std::pair<Field, Field>> SetWithState::getKeyRangeIfReady()
+{
+    if (!key_range_ready.load(std::memory_order_acquire))
+        return {};
+
+    std::lock_guard lock(key_range_mutex);
+    if (!has_key_range)
+        return {};
+    return std::make_pair(key_range_min, key_range_max);
 }
 
 CreatingSetsOnTheFlyTransform::CreatingSetsOnTheFlyTransform(
@@ -54,6 +106,7 @@ CreatingSetsOnTheFlyTransform::CreatingSetsOnTheFlyTransform(
     , column_names(column_names_)
     , key_column_indices(getColumnIndices(inputs.front().getHeader(), column_names))
     , num_streams(num_streams_)
+    , track_key_range(canTrackKeyRange(inputs.front().getHeader().getByPosition(key_column_indices.front()).type))
     , set(set_)
 {
 }
@@ -66,59 +119,76 @@ IProcessor::Status CreatingSetsOnTheFlyTransform::prepare()
         /// Nothing to do with set
         return status;
 
-    /// Finalize set
-    if (set->state == SetWithState::State::Creating)
+    if (!input.isFinished())
     {
-        if (input.isFinished())
-        {
-            set->finished_count++;
-            if (set->finished_count != num_streams)
-                /// Not all instances of processor are finished
-                return status;
+        if (set->state == SetWithState::State::Creating)
+            /// Should not happen because processor inserted before join that reads all the data
+            throw Exception(ErrorCodes::LOGICAL_ERROR, "Processor finished, but not all input was read");
+        return status;
+    }
 
+    /// Finalize set and key range
+    if (++set->finished_count == num_streams)
+    {
+        if (set->state == SetWithState::State::Creating)
+        {
             set->finishInsert();
             set->state = SetWithState::State::Finished;
             LOG_DEBUG(log, "{}: finish building set for [{}] with {} rows, set size is {}",
                 getDescription(), fmt::join(column_names, ", "), set->getTotalRowCount(),
                 formatReadableSizeWithBinarySuffix(set->getTotalByteCount()));
-            set.reset();
-        }
-        else
-        {
-            /// Should not happen because processor inserted before join that reads all the data
-            throw Exception(ErrorCodes::LOGICAL_ERROR, "Processor finished, but not all input was read");
         }
+
+        /// The key range is complete once every stream has finished, even if the set itself gave up.
+        if (track_key_range)
+            set->finalizeKeyRange();
     }
+    set.reset();
 
     return status;
 }
 
 void CreatingSetsOnTheFlyTransform::transform(Chunk & chunk)
 {
-    if (!set || set->state != SetWithState::State::Creating)
+    if (!set)
+        return;
+
+    if (!track_key_range && set->state != SetWithState::State::Creating)
     {
-        /// If set building suspended by another processor, release pointer
-        if (set != nullptr)
-            set.reset();
+        /// If set building suspended by another processor and there is no range to track, release pointer
+        set.reset();
         return;
     }
 
     if (chunk.getNumRows())
     {
         Columns key_columns = getColumnsByIndices(chunk, key_column_indices);
-        bool limit_exceeded = !set->insertFromBlock(key_columns);
-        if (limit_exceeded)
+
+        if (track_key_range)
         {
-            auto prev_state = set->state.exchange(SetWithState::State::Suspended);
-            /// Print log only after first state switch
-            if (prev_state == SetWithState::State::Creating)
+            Field chunk_min;
+            Field chunk_max;
+            key_columns.front()->getExtremes(chunk_min, chunk_max);
+            set->updateKeyRange(chunk_min, chunk_max);
+        }
+
+        if (set->state == SetWithState::State::Creating)
+        {
+            bool limit_exceeded = !set->insertFromBlock(key_columns);
+            if (limit_exceeded)
             {
-                LOG_DEBUG(log, "{}: set limit exceeded, give up building set, after reading {} rows and using {}",
-                    getDescription(), set->getTotalRowCount(), formatReadableSizeWithBinarySuffix(set->getTotalByteCount()));
+                auto prev_state = set->state.exchange(SetWithState::State::Suspended);
+                /// Print log only after first state switch
+                if (prev_state == SetWithState::State::Creating)
+                {
+                    LOG_DEBUG(log, "{}: set limit exceeded, give up building set, after reading {} rows and using {}",
+                        getDescription(), set->getTotalRowCount(), formatReadableSizeWithBinarySuffix(set->getTotalByteCount()));
+                }
+                /// The set content is unneeded now, but the object keeps accumulating the key range,
+                /// so the pointer is released only when the range is not tracked.
+                if (!track_key_range)
+                    set.reset();
             }
-            /// Probaply we need to clear set here, because it's unneeded anymore
-            /// But now `Set` doesn't have such method, so reset pointer in all processors and then it should be freed
-            set.reset();
         }
     }
 }
@@ -132,19 +202,23 @@ FilterBySetOnTheFlyTransform::FilterBySetOnTheFlyTransform(const Block & header_
     const auto & header = inputs.front().getHeader();
     for (size_t idx : key_column_indices)
         key_sample_block.insert(header.getByPosition(idx));
+
+    filter_by_key_range = canTrackKeyRange(key_sample_block.getByPosition(0).type);
 }
 
 IProcessor::Status FilterBySetOnTheFlyTransform::prepare()
 {
     auto status = ISimpleTransform::prepare();
 
-    if (set && set->state == SetWithState::State::Suspended)
+    /// When the set is suspended its key range may still become usable, so the pointer
+    /// is released only when there is no range to filter by.
+    if (set && set->state == SetWithState::State::Suspended && !filter_by_key_range)
         set.reset();
 
     if (status == Status::Finished)
     {
         bool has_filter = set && set->state == SetWithState::State::Finished;
-        if (has_filter)
+        if (has_filter || stat.result_rows != stat.consumed_rows)
         {
             LOG_DEBUG(log, "Finished {} by [{}]: consumed {} rows in total, {} rows bypassed, result {} rows, {:.2f}% filtered",
                 Poco::toLower(getDescription()), fmt::join(column_names, ", "),
@@ -188,6 +262,40 @@ void FilterBySetOnTheFlyTransform::transform(Chunk & chunk)
         }
         stat.result_rows += result_num_rows;
 
+        chunk.setColumns(std::move(columns), result_num_rows);
+    }
+    else if (chunk.getNumRows() && filter_by_key_range && set && set->state == SetWithState::State::Suspended)
+    {
+        /// The exact set overflowed, but the key range of the other side is still exact:
+        /// rows outside of it can never match and do not have to be sorted at all.
+        auto range = set->getKeyRangeIfReady();
+        if (!range)
+            return;
+
+        const auto & [min_value, max_value] = *range;
+        const auto & key_column = chunk.getColumns()[key_column_indices.front()];
+        size_t num_rows = chunk.getNumRows();
+
+        IColumn::Filter mask(num_rows);
+        for (size_t i = 0; i < num_rows; ++i)
+        {
+            Field value = (*key_column)[i];
+            mask[i] = !value.isNull()
+                && !applyVisitor(FieldVisitorAccurateLess{}, value, min_value)
+                && !applyVisitor(FieldVisitorAccurateLess{}, max_value, value);
+        }
+
+        stat.result_rows -= num_rows;
+
+        Columns columns = chunk.detachColumns();
+        size_t result_num_rows = 0;
+        for (auto & col : columns)
+        {
+            col = col->filter(mask, /* negative */ false);
+            result_num_rows = col->size();
+        }
+        stat.result_rows += result_num_rows;
+
         chunk.setColumns(std::move(columns), result_num_rows);
     }
 }
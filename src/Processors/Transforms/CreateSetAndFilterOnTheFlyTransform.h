@@ -2,7 +2,9 @@
 
 #include <atomic>
 #include <mutex>
+#include <optional>
 #include <vector>
+#include <Core/Field.h>
 #include <Processors/ISimpleTransform.h>
 #include <Poco/Logger.h>
 #include <Interpreters/Set.h>
@@ -37,6 +39,22 @@ struct SetWithState : public Set
     /// Track number of processors that are currently working on this set.
     /// Last one finalizes set.
     std::atomic_size_t finished_count = 0;
+
+    /// Min and max of the first key column over the whole stream. Unlike the set itself,
+    /// the range is tracked however large the stream is, so after the set is suspended
+    /// the other side can still drop rows of non-overlapping key ranges before sorting them.
+    void updateKeyRange(const Field & chunk_min, const Field & chunk_max);
+    void finalizeKeyRange();
+    /// Returns the range once every creating processor has finished, nullopt before that.
+    std::optional<std::pair<Field, Field>> getKeyRangeIfReady();
+
+private:
+    std::mutex key_range_mutex;
+    Field key_range_min;
+    Field key_range_max;
+    /// Guarded by key_range_mutex.
+    bool has_key_range = false;
+    std::atomic_bool key_range_ready = false;
 };
 
 using SetWithStatePtr = std::shared_ptr<SetWithState>;
@@ -64,6 +82,9 @@ private:
 
     size_t num_streams;
 
+    /// Whether the type of the first key column allows tracking its min/max.
+    bool track_key_range = false;
+
     /// Set to fill
     SetWithStatePtr set;
 
@@ -92,6 +113,9 @@ private:
     Names column_names;
     std::vector<size_t> key_column_indices;
 
+    /// Whether rows may be filtered by the key range of the other side when the set is suspended.
+    bool filter_by_key_range = false;
+
     /// Filter by this set when it's created
     SetWithStatePtr set;
 
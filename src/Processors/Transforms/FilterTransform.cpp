@@ -4,6 +4,9 @@
 #include <Columns/ColumnsCommon.h>
 #include <Core/Field.h>
 
+#include <algorithm>
+#include <optional>
+
 namespace DB
 {
 
@@ -27,6 +30,25 @@ static void replaceFilterToConstant(Block & block, const String & filter_column_
     }
 }
 
+/// If the set bytes of the filter form exactly one contiguous run, return its start position.
+/// The caller is expected to pass the total number of set bytes, so it is enough to check that
+/// the run starting at the first set byte is fully set - everything beyond it must be zero then.
+static std::optional<size_t> trySingleContiguousRange(const IColumn::Filter & filt, size_t num_filtered_rows)
+{
+    const UInt8 * begin = filt.data();
+    const UInt8 * end = begin + filt.size();
+
+    const UInt8 * first = std::find(begin, end, 1);
+    size_t start = first - begin;
+    if (start + num_filtered_rows > filt.size())
+        return std::nullopt;
+
+    if (std::find(first, first + num_filtered_rows, 0) != first + num_filtered_rows)
+        return std::nullopt;
+
+    return start;
+}
+
 Block FilterTransform::transformHeader(
     Block header,
     const ActionsDAG * expression,
@@ -151,34 +173,19 @@ void FilterTransform::doTransform(Chunk & chunk)
         return;
     }
 
-    /** Let's find out how many rows will be in result.
-      * To do this, we filter out the first non-constant column
-      *  or calculate number of set bytes in the filter.
-      */
-    size_t first_non_constant_column = num_columns;
-    for (size_t i = 0; i < num_columns; ++i)
-    {
-        if (i != filter_column_position && !isColumnConst(*columns[i]))
-        {
-            first_non_constant_column = i;
-            break;
-        }
-    }
-
     std::unique_ptr<IFilterDescription> filter_description;
+    const FilterDescription * plain_filter_description = nullptr;
     if (filter_column->isSparse())
         filter_description = std::make_unique<SparseFilterDescription>(*filter_column);
     else
-        filter_description = std::make_unique<FilterDescription>(*filter_column);
-
-    size_t num_filtered_rows = 0;
-    if (first_non_constant_column != num_columns)
     {
-        columns[first_non_constant_column] = filter_description->filter(*columns[first_non_constant_column], -1);
-        num_filtered_rows = columns[first_non_constant_column]->size();
+        auto non_sparse_description = std::make_unique<FilterDescription>(*filter_column);
+        plain_filter_description = non_sparse_description.get();
+        filter_description = std::move(non_sparse_description);
     }
-    else
-        num_filtered_rows = filter_description->countBytesInFilter();
+
+    /// Let's find out how many rows will be in the result by counting the set bytes in the filter.
+    size_t num_filtered_rows = filter_description->countBytesInFilter();
 
     /// If the current block is completely filtered out, let's move on to the next one.
     if (num_filtered_rows == 0)
@@ -201,7 +208,14 @@ void FilterTransform::doTransform(Chunk & chunk)
         return;
     }
 
-    /// Filter the rest of the columns.
+    /// If the surviving rows form a single contiguous range (typical for range predicates over sorted data),
+    /// filtering degenerates to cutting this range out of every column. This avoids walking the filter mask
+    /// per column and copies each column with a single continuous slice.
+    std::optional<size_t> contiguous_range_start;
+    if (plain_filter_description)
+        contiguous_range_start = trySingleContiguousRange(*plain_filter_description->data, num_filtered_rows);
+
+    /// Filter all the columns.
     for (size_t i = 0; i < num_columns; ++i)
     {
         const auto & current_type = transformed_header.safeGetByPosition(i).type;
@@ -218,11 +232,10 @@ void FilterTransform::doTransform(Chunk & chunk)
             continue;
         }
 
-        if (i == first_non_constant_column)
-            continue;
-
         if (isColumnConst(*current_column))
             current_column = current_column->cut(0, num_filtered_rows);
+        else if (contiguous_range_start)
+            current_column = current_column->cut(*contiguous_range_start, num_filtered_rows);
         else
             current_column = filter_description->filter(*current_column, num_filtered_rows);
     }
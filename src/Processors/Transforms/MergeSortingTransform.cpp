@@ -1,8 +1,11 @@
 #include <Processors/Transforms/MergeSortingTransform.h>
 #include <Processors/IAccumulatingTransform.h>
 #include <Processors/Merges/MergingSortedTransform.h>
+#include <Common/Exception.h>
 #include <Common/ProfileEvents.h>
 #include <Common/formatReadable.h>
+#include <Interpreters/threadPoolCallbackRunner.h>
+#include <IO/IOThreadPool.h>
 #include <IO/WriteBufferFromFile.h>
 #include <IO/ReadBufferFromFile.h>
 #include <Compression/CompressedReadBuffer.h>
@@ -11,6 +14,9 @@
 #include <Formats/NativeWriter.h>
 #include <Disks/IVolume.h>
 
+#include <condition_variable>
+#include <future>
+
 
 namespace ProfileEvents
 {
@@ -29,27 +35,68 @@ namespace DB
 class BufferingToFileTransform : public IAccumulatingTransform
 {
 public:
+    /// Above this limit of queued blocks consume() waits for the background writer,
+    /// providing backpressure for the merge that produces the sorted run.
+    static constexpr size_t MAX_QUEUED_BYTES = 128 * 1024 * 1024;
+
     BufferingToFileTransform(const Block & header, TemporaryFileStream & tmp_stream_, Poco::Logger * log_)
         : IAccumulatingTransform(header, header)
         , tmp_stream(tmp_stream_)
+        , write_runner(threadPoolCallbackRunner<void>(IOThreadPool::get(), "ExtSortWrite"))
         , log(log_)
     {
         LOG_INFO(log, "Sorting and writing part of data into temporary file {}", tmp_stream.getPath());
         ProfileEvents::increment(ProfileEvents::ExternalSortWritePart);
     }
 
+    ~BufferingToFileTransform() override
+    {
+        try
+        {
+            waitPendingWrites();
+        }
+        catch (...)
+        {
+            tryLogCurrentException(log, "Error while waiting for background writes of external sort");
+        }
+    }
+
     String getName() const override { return "BufferingToFileTransform"; }
 
     void consume(Chunk chunk) override
     {
         Block block = getInputPort().getHeader().cloneWithColumns(chunk.detachColumns());
-        tmp_stream.write(block);
+        size_t block_bytes = block.allocatedBytes();
+
+        /// Blocks of the run must reach the file in order, so only the background task
+        /// writes to the stream and we wait here instead of writing from the current thread.
+        std::unique_lock lock(queue_mutex);
+        queue_has_space.wait(lock, [this] { return queue_bytes < MAX_QUEUED_BYTES || has_background_exception; });
+
+        if (has_background_exception)
+        {
+            auto pending = std::move(task);
+            lock.unlock();
+            chassert(pending.valid());
+            pending.get();
+        }
+
+        queue_bytes += block_bytes;
+        queue.push_back(std::move(block));
+
+        if (!task_scheduled)
+        {
+            task_scheduled = true;
+            task = write_runner([this] { writeQueuedBlocks(); }, 0);
+        }
     }
 
     Chunk generate() override
     {
         if (!tmp_stream.isWriteFinished())
         {
+            waitPendingWrites();
+
             auto stat = tmp_stream.finishWriting();
 
             ProfileEvents::increment(ProfileEvents::ExternalProcessingCompressedBytesTotal, stat.compressed_size);
@@ -70,8 +117,65 @@ public:
     }
 
 private:
+    void writeQueuedBlocks()
+    {
+        try
+        {
+            while (true)
+            {
+                Blocks blocks_to_write;
+                {
+                    std::lock_guard lock(queue_mutex);
+                    if (queue.empty())
+                    {
+                        task_scheduled = false;
+                        return;
+                    }
+                    blocks_to_write.swap(queue);
+                    queue_bytes = 0;
+                }
+                queue_has_space.notify_one();
+
+                for (const auto & block : blocks_to_write)
+                    tmp_stream.write(block);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard lock(queue_mutex);
+            has_background_exception = true;
+            queue_has_space.notify_all();
+            throw;
+        }
+    }
+
+    /// Wait for the background writer and rethrow its exception, if any.
+    /// May be called only when no new blocks can be consumed.
+    void waitPendingWrites()
+    {
+        std::future<void> pending;
+        {
+            std::lock_guard lock(queue_mutex);
+            pending = std::move(task);
+        }
+
+        if (pending.valid())
+            pending.get();
+    }
+
     TemporaryFileStream & tmp_stream;
 
+    /// Blocks of the sorted run waiting to be written to the file by a background task.
+    std::mutex queue_mutex;
+    std::condition_variable queue_has_space;
+    Blocks queue;
+    size_t queue_bytes = 0;
+    bool task_scheduled = false;
+    bool has_background_exception = false;
+    std::future<void> task;
+
+    ThreadPoolCallbackRunner<void> write_runner;
+
     Poco::Logger * log;
 };
 
@@ -93,6 +197,8 @@ MergeSortingTransform::MergeSortingTransform(
     , tmp_data(std::move(tmp_data_))
     , min_free_disk_space(min_free_disk_space_)
 {
+    if (tmp_data)
+        pressure_participant = MemoryPressureArbitrator::instance().registerParticipant();
 }
 
 Processors MergeSortingTransform::expandPipeline()
@@ -159,11 +265,21 @@ void MergeSortingTransform::consume(Chunk chunk)
         remerge();
     }
 
+    if (pressure_participant)
+        pressure_participant->setReclaimableBytes(sum_bytes_in_blocks);
+
+    /// The server-level memory arbitrator may ask to spill before our own threshold
+    /// is reached, to keep other queries from being killed. Don't bother creating
+    /// a temporary file when there is almost nothing to release.
+    static constexpr size_t min_bytes_to_spill_under_pressure = 32 * 1024 * 1024;
+    bool spill_under_memory_pressure = pressure_participant && pressure_participant->isSpillRequested()
+        && sum_bytes_in_blocks >= min_bytes_to_spill_under_pressure;
+
     /** If too many of them and if external sorting is enabled,
       *  will merge blocks that we have in memory at this moment and write merged stream to temporary (compressed) file.
       * NOTE. It's possible to check free space in filesystem.
       */
-    if (max_bytes_before_external_sort && sum_bytes_in_blocks > max_bytes_before_external_sort)
+    if ((max_bytes_before_external_sort && sum_bytes_in_blocks > max_bytes_before_external_sort) || spill_under_memory_pressure)
     {
         /// If there's less free disk space than reserve_size, an exception will be thrown
         size_t reserve_size = sum_bytes_in_blocks + min_free_disk_space;
@@ -198,6 +314,9 @@ void MergeSortingTransform::consume(Chunk chunk)
         stage = Stage::Serialize;
         sum_bytes_in_blocks = 0;
         sum_rows_in_blocks = 0;
+
+        if (pressure_participant)
+            pressure_participant->onSpillFinished();
     }
 }
 
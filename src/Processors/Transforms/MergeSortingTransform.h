@@ -2,6 +2,7 @@
 
 #include <Processors/Transforms/SortingTransform.h>
 #include <Core/SortDescription.h>
+#include <Common/MemoryPressureArbitrator.h>
 #include <Common/filesystemHelpers.h>
 #include <Disks/TemporaryFileOnDisk.h>
 #include <Interpreters/TemporaryDataOnDisk.h>
@@ -51,6 +52,10 @@ private:
     size_t sum_rows_in_blocks = 0;
     size_t sum_bytes_in_blocks = 0;
 
+    /// Set when temporary data is available: the server-level memory arbitrator
+    /// may ask to spill the accumulated blocks to disk under memory pressure.
+    MemoryPressureArbitrator::ParticipantPtr pressure_participant;
+
     Poco::Logger * log = &Poco::Logger::get("MergeSortingTransform");
 
     /// If remerge doesn't save memory at least several times, mark it as useless and don't do it anymore.
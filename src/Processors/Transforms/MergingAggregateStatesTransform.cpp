@@ -0,0 +1,125 @@
+#include <Processors/Transforms/MergingAggregateStatesTransform.h>
+
+#include <Columns/ColumnSparse.h>
+#include <DataTypes/DataTypeAggregateFunction.h>
+
+namespace DB
+{
+
+MergingAggregateStatesTransform::MergingAggregateStatesTransform(
+    const Block & header, size_t min_block_size_rows_, size_t min_block_size_bytes_)
+    : ExceptionKeepingTransform(header, header, false)
+    , min_block_size_rows(min_block_size_rows_)
+    , min_block_size_bytes(min_block_size_bytes_)
+{
+    Names keys;
+    AggregateDescriptions aggregates;
+
+    /// Keys go first because the Aggregator addresses key columns by position.
+    for (const auto & column : header)
+        if (!typeid_cast<const DataTypeAggregateFunction *>(column.type.get()))
+        {
+            keys.push_back(column.name);
+            input_positions.push_back(header.getPositionByName(column.name));
+            aggregator_header.insert(column.cloneEmpty());
+        }
+
+    for (const auto & column : header)
+        if (const auto * type = typeid_cast<const DataTypeAggregateFunction *>(column.type.get()))
+        {
+            AggregateDescription aggregate;
+            aggregate.function = type->getFunction();
+            aggregate.parameters = type->getParameters();
+            aggregate.column_name = column.name;
+
+            aggregates.push_back(std::move(aggregate));
+            input_positions.push_back(header.getPositionByName(column.name));
+            aggregator_header.insert(column.cloneEmpty());
+        }
+
+    /// Single-level merge without limits: two-level conversion is not needed because
+    /// the result is flushed as soon as it reaches the block size thresholds.
+    Aggregator::Params params(keys, aggregates, /* overflow_row */ false, /* max_threads */ 1, DEFAULT_BLOCK_SIZE);
+    aggregator = std::make_unique<Aggregator>(aggregator_header, params);
+    aggregation_result = std::make_shared<AggregatedDataVariants>();
+}
+
+bool MergingAggregateStatesTransform::isApplicable(const Block & header)
+{
+    for (const auto & column : header)
+        if (typeid_cast<const DataTypeAggregateFunction *>(column.type.get()))
+            return true;
+    return false;
+}
+
+void MergingAggregateStatesTransform::onConsume(Chunk chunk)
+{
+    if (chunk.getNumRows())
+    {
+        auto columns = chunk.detachColumns();
+
+        Block block = aggregator_header.cloneEmpty();
+        for (size_t i = 0; i < input_positions.size(); ++i)
+            block.getByPosition(i).column = recursiveRemoveSparse(columns[input_positions[i]]->convertToFullColumnIfConst());
+
+        aggregator->mergeOnBlock(std::move(block), *aggregation_result, no_more_keys);
+    }
+
+    bool size_limit_reached = aggregation_result->size() >= min_block_size_rows
+        || (min_block_size_bytes && aggregation_result->aggregates_pool->size() >= min_block_size_bytes);
+
+    if (size_limit_reached)
+        if (auto block = flush())
+            cur_chunk.setColumns(block.getColumns(), block.rows());
+}
+
+MergingAggregateStatesTransform::GenerateResult MergingAggregateStatesTransform::onGenerate()
+{
+    GenerateResult res;
+    res.chunk = std::move(cur_chunk);
+    res.is_done = true;
+    return res;
+}
+
+void MergingAggregateStatesTransform::onFinish()
+{
+    if (auto block = flush())
+        finish_chunk.setColumns(block.getColumns(), block.rows());
+}
+
+Block MergingAggregateStatesTransform::flush()
+{
+    if (aggregation_result->empty())
+        return {};
+
+    auto merged = aggregator->convertToBlocks(*aggregation_result, /* final */ false, /* max_threads */ 1);
+    aggregation_result = std::make_shared<AggregatedDataVariants>();
+
+    /// The aggregation is single-level, so there is a single result block. Restore the header layout.
+    chassert(merged.size() == 1);
+
+    Block res = getOutputPort().getHeader().cloneEmpty();
+    for (auto & column : res)
+        column.column = merged.front().getByName(column.name).column;
+
+    return res;
+}
+
+void MergingAggregateStatesTransform::work()
+{
+    if (stage == Stage::Exception)
+    {
+        data.chunk.clear();
+        ready_input = false;
+        return;
+    }
+
+    ExceptionKeepingTransform::work();
+    if (finish_chunk)
+    {
+        data.chunk = std::move(finish_chunk);
+        ready_output = true;
+    }
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Interpreters/Aggregator.h>
+#include <Processors/Transforms/ExceptionKeepingTransform.h>
+
+namespace DB
+{
+
+/** Accumulates blocks with partial aggregation states and merges states of rows with equal keys,
+  * flushing the merged result when it grows to min_block_size_rows/min_block_size_bytes.
+  *
+  * Used instead of plain squashing when pushing to tables that store aggregation states
+  * (AggregatingMergeTree). Materialized views aggregate every inserted chunk separately,
+  * so for a rollup view the same keys reappear in chunk after chunk; plain squashing keeps
+  * all these rows and the inserted part contains as many state rows as there were chunks.
+  * Merging the states while accumulating keeps memory proportional to the number of
+  * distinct keys and writes each key once.
+  *
+  * The keys are all columns of the header except AggregateFunction ones. This is a finer
+  * equivalence than the table sorting key, so the merge is always correct: rows collapsed
+  * here would have been collapsed by a background merge anyway.
+  */
+class MergingAggregateStatesTransform : public ExceptionKeepingTransform
+{
+public:
+    MergingAggregateStatesTransform(const Block & header, size_t min_block_size_rows_, size_t min_block_size_bytes_);
+
+    String getName() const override { return "MergingAggregateStatesTransform"; }
+
+    void work() override;
+
+    /// Requires at least one AggregateFunction column to merge.
+    static bool isApplicable(const Block & header);
+
+protected:
+    void onConsume(Chunk chunk) override;
+    GenerateResult onGenerate() override;
+    void onFinish() override;
+
+private:
+    Block flush();
+
+    const size_t min_block_size_rows;
+    const size_t min_block_size_bytes;
+
+    /// Header columns rearranged to the layout the Aggregator expects: keys first, then states.
+    Block aggregator_header;
+    /// For each column of aggregator_header - its position in the chain header.
+    std::vector<size_t> input_positions;
+
+    std::unique_ptr<Aggregator> aggregator;
+    /// Recreated after each flush so that arenas with flushed states can be released
+    /// as soon as the result block is written.
+    AggregatedDataVariantsPtr aggregation_result;
+    bool no_more_keys = false;
+
+    Chunk cur_chunk;
+    Chunk finish_chunk;
+};
+
+}
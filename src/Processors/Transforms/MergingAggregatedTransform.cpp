@@ -1,6 +1,9 @@
 #include <Processors/Transforms/MergingAggregatedTransform.h>
 #include <Processors/Transforms/AggregatingTransform.h>
 #include <Processors/Transforms/AggregatingInOrderTransform.h>
+#include <Common/CurrentThread.h>
+#include <Common/Exception.h>
+#include <Common/scope_guard_safe.h>
 
 namespace DB
 {
@@ -16,6 +19,104 @@ MergingAggregatedTransform::MergingAggregatedTransform(
 {
 }
 
+MergingAggregatedTransform::~MergingAggregatedTransform()
+{
+    /// The query could be cancelled before generate() had a chance to join the workers.
+    try
+    {
+        finishBucketWorkers();
+    }
+    catch (...)
+    {
+        tryLogCurrentException(log);
+    }
+}
+
+void MergingAggregatedTransform::startBucketWorkers()
+{
+    params->aggregator.initStateForTwoLevelMerge(data_variants);
+
+    size_t num_workers = std::max<size_t>(1, max_threads);
+    LOG_TRACE(log, "Merging two-level partially aggregated data in a streaming fashion with {} threads.", num_workers);
+
+    bucket_workers.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i)
+    {
+        auto worker = std::make_unique<BucketWorker>();
+
+        data_variants.aggregates_pools.push_back(std::make_shared<Arena>());
+        worker->aggregates_pool = data_variants.aggregates_pools.back().get();
+
+        worker->thread = ThreadFromGlobalPool(
+            [this, worker_ptr = worker.get(), group = CurrentThread::getGroup()] { bucketWorkerLoop(*worker_ptr, group); });
+
+        bucket_workers.emplace_back(std::move(worker));
+    }
+}
+
+void MergingAggregatedTransform::bucketWorkerLoop(BucketWorker & worker, ThreadGroupStatusPtr thread_group)
+{
+    SCOPE_EXIT_SAFE(
+        if (thread_group)
+            CurrentThread::detachQueryIfNotDetached();
+    );
+    if (thread_group)
+        CurrentThread::attachToIfDetached(thread_group);
+
+    try
+    {
+        while (true)
+        {
+            Block block;
+            {
+                std::unique_lock lock(worker.mutex);
+                worker.condvar.wait(lock, [&] { return !worker.queue.empty() || worker.is_finished; });
+
+                if (worker.queue.empty())
+                    return;
+
+                block = std::move(worker.queue.front());
+                worker.queue.pop_front();
+            }
+
+            params->aggregator.mergeTwoLevelBucketBlock(std::move(block), data_variants, worker.aggregates_pool);
+        }
+    }
+    catch (...)
+    {
+        std::lock_guard lock(worker.mutex);
+        worker.exception = std::current_exception();
+        has_background_exception = true;
+    }
+}
+
+void MergingAggregatedTransform::finishBucketWorkers()
+{
+    for (auto & worker : bucket_workers)
+    {
+        {
+            std::lock_guard lock(worker->mutex);
+            worker->is_finished = true;
+        }
+        worker->condvar.notify_one();
+    }
+
+    std::exception_ptr first_exception;
+    for (auto & worker : bucket_workers)
+    {
+        if (worker->thread.joinable())
+            worker->thread.join();
+
+        if (worker->exception && !first_exception)
+            first_exception = worker->exception;
+    }
+
+    bucket_workers.clear();
+
+    if (first_exception)
+        std::rethrow_exception(first_exception);
+}
+
 void MergingAggregatedTransform::consume(Chunk chunk)
 {
     if (!consume_started)
@@ -40,14 +141,31 @@ void MergingAggregatedTransform::consume(Chunk chunk)
         /** If the remote servers used a two-level aggregation method,
         *  then blocks will contain information about the number of the bucket.
         * Then the calculations can be parallelized by buckets.
-        * We decompose the blocks to the bucket numbers indicated in them.
+        * Blocks of two-level buckets are merged right away by the background workers,
+        *  overlapping the merge with reading the rest of the data.
         */
 
         auto block = getInputPort().getHeader().cloneWithColumns(chunk.getColumns());
         block.info.is_overflows = agg_info->is_overflows;
         block.info.bucket_num = agg_info->bucket_num;
 
-        bucket_to_blocks[agg_info->bucket_num].emplace_back(std::move(block));
+        if (!block.info.is_overflows && block.info.bucket_num >= 0)
+        {
+            if (has_background_exception)
+                finishBucketWorkers();
+
+            if (bucket_workers.empty())
+                startBucketWorkers();
+
+            auto & worker = *bucket_workers[block.info.bucket_num % bucket_workers.size()];
+            {
+                std::lock_guard lock(worker.mutex);
+                worker.queue.emplace_back(std::move(block));
+            }
+            worker.condvar.notify_one();
+        }
+        else
+            bucket_to_blocks[agg_info->bucket_num].emplace_back(std::move(block));
     }
     else if (typeid_cast<const ChunkInfoWithAllocatedBytes *>(info.get()))
     {
@@ -71,27 +189,53 @@ Chunk MergingAggregatedTransform::generate()
         /// Exception safety. Make iterator valid in case any method below throws.
         next_block = blocks.begin();
 
-        /// TODO: this operation can be made async. Add async for IAccumulatingTransform.
+        /// Wait for the background merge of two-level buckets, if there was any.
+        finishBucketWorkers();
+
+        /// Merge the rest of the data: single-level blocks and blocks with "overflowing" values.
         params->aggregator.mergeBlocks(std::move(bucket_to_blocks), data_variants, max_threads);
-        blocks = params->aggregator.convertToBlocks(data_variants, params->final, max_threads);
-        next_block = blocks.begin();
-    }
 
-    if (next_block == blocks.end())
-        return {};
+        if (data_variants.isTwoLevel())
+        {
+            /// Two-level buckets are converted one by one in the loop below, so the first rows
+            /// reach the downstream processors without waiting for the whole result to be materialized.
+            LOG_TRACE(log, "Converting two-level aggregated data to blocks bucket by bucket.");
+            if (data_variants.without_key)
+                blocks.emplace_back(params->aggregator.prepareBlockAndFillWithoutKey(
+                    data_variants, params->final, data_variants.type != AggregatedDataVariants::Type::without_key));
+        }
+        else
+            blocks = params->aggregator.convertToBlocks(data_variants, params->final, max_threads);
 
-    auto block = std::move(*next_block);
-    ++next_block;
+        next_block = blocks.begin();
+    }
 
-    auto info = std::make_shared<AggregatedChunkInfo>();
-    info->bucket_num = block.info.bucket_num;
-    info->is_overflows = block.info.is_overflows;
+    if (next_block != blocks.end())
+    {
+        auto block = std::move(*next_block);
+        ++next_block;
+        return convertToChunk(block);
+    }
 
-    UInt64 num_rows = block.rows();
-    Chunk chunk(block.getColumns(), num_rows);
-    chunk.setChunkInfo(std::move(info));
+    /// Convert and emit two-level buckets one at a time.
+    while (data_variants.isTwoLevel() && current_bucket_num < NUM_BUCKETS)
+    {
+        auto block = params->aggregator.convertOneBucketToBlock(
+            data_variants, data_variants.aggregates_pool, params->final, current_bucket_num);
+        ++current_bucket_num;
+
+        if (current_bucket_num == NUM_BUCKETS && !params->final)
+        {
+            /// data_variants will not destroy the states of aggregate functions in the destructor.
+            /// Now ColumnAggregateFunction owns the states.
+            data_variants.aggregator = nullptr;
+        }
+
+        if (block.rows())
+            return convertToChunk(block);
+    }
 
-    return chunk;
+    return {};
 }
 
 }
@@ -2,17 +2,25 @@
 #include <Processors/IAccumulatingTransform.h>
 #include <Interpreters/Aggregator.h>
 #include <Processors/Transforms/AggregatingTransform.h>
+#include <Common/ThreadPool.h>
+#include <condition_variable>
+#include <mutex>
 
 namespace DB
 {
 
 /** A pre-aggregate stream of blocks in which each block is already aggregated.
   * Aggregate functions in blocks should not be finalized so that their states can be merged.
+  *
+  * Blocks of two-level buckets are merged as they arrive by background workers,
+  * so the merge overlaps with reading the partially aggregated data from the sources.
   */
 class MergingAggregatedTransform : public IAccumulatingTransform
 {
 public:
     MergingAggregatedTransform(Block header_, AggregatingTransformParamsPtr params_, size_t max_threads_);
+    ~MergingAggregatedTransform() override;
+
     String getName() const override { return "MergingAggregatedTransform"; }
 
 protected:
@@ -27,12 +35,38 @@ private:
     AggregatedDataVariants data_variants;
     Aggregator::BucketToBlocks bucket_to_blocks;
 
+    /// Merges blocks of two-level buckets as they arrive.
+    /// A bucket is always processed by the same worker (chosen by the bucket number),
+    /// so merges into the same bucket are serialized while distinct buckets are merged in parallel.
+    struct BucketWorker
+    {
+        std::mutex mutex;
+        std::condition_variable condvar;
+        BlocksList queue;
+        bool is_finished = false;
+        std::exception_ptr exception;
+        Arena * aggregates_pool = nullptr;
+        ThreadFromGlobalPool thread;
+    };
+
+    std::vector<std::unique_ptr<BucketWorker>> bucket_workers;
+    std::atomic_bool has_background_exception = false;
+
+    void startBucketWorkers();
+    /// Waits until the workers have merged all queued blocks and rethrows their exception, if any.
+    void finishBucketWorkers();
+    void bucketWorkerLoop(BucketWorker & worker, ThreadGroupStatusPtr thread_group);
+
     UInt64 total_input_rows = 0;
     UInt64 total_input_blocks = 0;
 
     BlocksList blocks;
     BlocksList::iterator next_block;
 
+    /// Two-level results are converted and emitted bucket by bucket instead of all at once.
+    static constexpr Int32 NUM_BUCKETS = 256;
+    Int32 current_bucket_num = 0;
+
     bool consume_started = false;
     bool generate_started = false;
 };
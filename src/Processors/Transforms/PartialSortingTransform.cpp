@@ -84,6 +84,45 @@ bool compareWithThreshold(const ColumnRawPtrs & raw_block_columns, size_t min_bl
 
 }
 
+void SortingThresholdSharedState::update(const Columns & candidate)
+{
+    std::lock_guard lock(mutex);
+
+    if (!threshold_columns.empty())
+    {
+        bool candidate_is_better = false;
+        size_t size = description.size();
+        for (size_t i = 0; i < size; ++i)
+        {
+            int res = description[i].direction * candidate[i]->compareAt(0, 0, *threshold_columns[i], description[i].nulls_direction);
+            if (res > 0)
+                return;
+            if (res < 0)
+            {
+                candidate_is_better = true;
+                break;
+            }
+        }
+
+        if (!candidate_is_better)
+            return;
+    }
+
+    threshold_columns = candidate;
+    version.fetch_add(1, std::memory_order_release);
+}
+
+std::optional<Columns> SortingThresholdSharedState::getIfChanged(UInt64 & last_seen_version) const
+{
+    /// Fast path without taking the mutex: the threshold did not change since the last call.
+    if (version.load(std::memory_order_acquire) == last_seen_version)
+        return {};
+
+    std::lock_guard lock(mutex);
+    last_seen_version = version.load(std::memory_order_relaxed);
+    return threshold_columns;
+}
+
 PartialSortingTransform::PartialSortingTransform(
     const Block & header_, const SortDescription & description_, UInt64 limit_)
     : ISimpleTransform(header_, header_, false)
@@ -112,6 +151,13 @@ void PartialSortingTransform::transform(Chunk & chunk)
 
     auto block = getInputPort().getHeader().cloneWithColumns(chunk.detachColumns());
 
+    /// The shared threshold only gets stronger, so it can be adopted unconditionally.
+    if (shared_threshold)
+    {
+        if (auto columns = shared_threshold->getIfChanged(shared_threshold_version))
+            sort_description_threshold_columns = std::move(*columns);
+    }
+
     /** If we've saved columns from previously blocks we could filter all rows from current block
       * which are unnecessary for sortBlock(...) because they obviously won't be in the top LIMIT rows.
       */
@@ -163,6 +209,9 @@ void PartialSortingTransform::transform(Chunk & chunk)
             }
 
             sort_description_threshold_columns = std::move(sort_description_threshold_columns_updated);
+
+            if (shared_threshold)
+                shared_threshold->update(sort_description_threshold_columns);
         }
     }
 
@@ -4,9 +4,39 @@
 #include <Core/SortDescription.h>
 #include <Common/PODArray.h>
 
+#include <atomic>
+#include <mutex>
+#include <optional>
+
 namespace DB
 {
 
+/** Holds the best LIMIT-th row found by any of the PartialSortingTransform instances
+  * of one sort, so that every stream filters with the globally strongest threshold
+  * instead of the one found in its own stream only.
+  * Threshold columns are immutable, so sharing them between threads is safe.
+  */
+class SortingThresholdSharedState
+{
+public:
+    explicit SortingThresholdSharedState(SortDescription description_) : description(std::move(description_)) {}
+
+    /// Replace the threshold if the candidate row (at position 0 of the columns) sorts before the current one.
+    void update(const Columns & candidate);
+
+    /// Returns the threshold if it changed since last_seen_version (which gets updated).
+    std::optional<Columns> getIfChanged(UInt64 & last_seen_version) const;
+
+private:
+    const SortDescription description;
+
+    mutable std::mutex mutex;
+    Columns threshold_columns;
+    std::atomic<UInt64> version = 0;
+};
+
+using SortingThresholdSharedStatePtr = std::shared_ptr<SortingThresholdSharedState>;
+
 /** Sorts each block individually by the values of the specified columns.
   */
 class PartialSortingTransform : public ISimpleTransform
@@ -21,6 +51,7 @@ public:
     String getName() const override { return "PartialSortingTransform"; }
 
     void setRowsBeforeLimitCounter(RowsBeforeLimitCounterPtr counter) { read_rows.swap(counter); }
+    void setSharedThreshold(SortingThresholdSharedStatePtr shared_threshold_) { shared_threshold = std::move(shared_threshold_); }
 
 protected:
     void transform(Chunk & chunk) override;
@@ -33,6 +64,9 @@ private:
 
     Columns sort_description_threshold_columns;
 
+    SortingThresholdSharedStatePtr shared_threshold;
+    UInt64 shared_threshold_version = 0;
+
     /// This are just buffers which reserve memory to reduce the number of allocations.
     PaddedPODArray<UInt64> rows_to_compare;
     PaddedPODArray<Int8> compare_results;
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Core/ColumnNumbers.h>
+#include <Common/WeakHash.h>
+#include <Processors/IProcessor.h>
+
+namespace DB
+{
+
+/// Scatters rows of the single input into `output_size` outputs by a hash of the key columns,
+/// so that all rows with the same key end up in the same output. The relative order of rows
+/// is preserved within each output, i.e. a stream sorted by (key, ...) stays sorted.
+/// Used to process window functions in parallel by PARTITION BY.
+struct ScatterByPartitionTransform : IProcessor
+{
+    ScatterByPartitionTransform(Block header, size_t output_size_, ColumnNumbers key_columns_);
+
+    String getName() const override { return "ScatterByPartitionTransform"; }
+
+    Status prepare() override;
+    void work() override;
+
+private:
+    void generateOutputChunks();
+
+    size_t output_size;
+    ColumnNumbers key_columns;
+
+    bool has_data = false;
+    bool all_outputs_processed = true;
+    std::vector<char> was_output_processed;
+    Chunk chunk;
+
+    WeakHash32 hash;
+    Chunks output_chunks;
+};
+
+}
@@ -1534,6 +1534,15 @@ namespace recurrent_detail
 
         assert_cast<ColumnFloat64 &>(to).getData().push_back(value);
     }
+
+    template<> void setValueToOutputColumn<UInt64>(const WindowTransform * transform, size_t function_index, UInt64 value)
+    {
+        auto current_row = transform->current_row;
+        const auto & current_block = transform->blockAt(current_row);
+        IColumn & to = *current_block.output_columns[function_index];
+
+        assert_cast<ColumnUInt64 &>(to).getData().push_back(value);
+    }
 }
 
 struct WindowFunctionHelpers
@@ -2286,6 +2295,111 @@ private:
     Int64 ts_scale_multiplier = 0;
 };
 
+struct SessionNumberState
+{
+    Float64 previous_timestamp = 0;
+    UInt64 session_number = 0;
+};
+
+// sessionNumber(timestamp_column, INTERVAL 30 MINUTE)
+// Splits a partition ordered by timestamp into sessions: returns a number that
+// is incremented whenever the gap between two consecutive timestamps exceeds
+// the given timeout, starting from 0 at the beginning of each partition.
+// Unlike sessionization through groupArray over the whole history of a key,
+// the state is just the previous timestamp and a counter, so the memory usage
+// is bounded regardless of the partition size, and over input sorted by
+// (partition key, timestamp) the whole pipeline is streaming.
+struct WindowFunctionSessionNumber final : public StatefulWindowFunction<SessionNumberState>
+{
+    static constexpr size_t ARGUMENT_TIMESTAMP = 0;
+    static constexpr size_t ARGUMENT_TIMEOUT = 1;
+
+    WindowFunctionSessionNumber(const std::string & name_,
+            const DataTypes & argument_types_, const Array & parameters_)
+        : StatefulWindowFunction(name_, argument_types_, parameters_, std::make_shared<DataTypeUInt64>())
+    {
+        if (!parameters.empty())
+        {
+            throw Exception(ErrorCodes::BAD_ARGUMENTS,
+                            "Function {} cannot be parameterized", name_);
+        }
+
+        if (argument_types.size() != 2)
+        {
+            throw Exception(ErrorCodes::BAD_ARGUMENTS,
+                            "Function {} takes 2 arguments", name_);
+        }
+
+        if (!isDateTime(argument_types[ARGUMENT_TIMESTAMP]) && !isDateTime64(argument_types[ARGUMENT_TIMESTAMP]))
+        {
+            throw Exception(ErrorCodes::BAD_ARGUMENTS,
+                            "Argument {} must be DateTime or DateTime64, '{}' given",
+                            ARGUMENT_TIMESTAMP,
+                            argument_types[ARGUMENT_TIMESTAMP]->getName());
+        }
+
+        if (isDateTime64(argument_types[ARGUMENT_TIMESTAMP]))
+        {
+            const auto & datetime64_type = assert_cast<const DataTypeDateTime64 &>(*argument_types[ARGUMENT_TIMESTAMP]);
+            ts_scale_multiplier = DecimalUtils::scaleMultiplier<DateTime64>(datetime64_type.getScale());
+        }
+
+        const DataTypeInterval * interval_datatype = checkAndGetDataType<DataTypeInterval>(argument_types[ARGUMENT_TIMEOUT].get());
+        if (!interval_datatype)
+        {
+            throw Exception(
+                ErrorCodes::BAD_ARGUMENTS,
+                "Argument {} must be an INTERVAL, '{}' given",
+                ARGUMENT_TIMEOUT,
+                argument_types[ARGUMENT_TIMEOUT]->getName());
+        }
+        if (!interval_datatype->getKind().isFixedLength())
+        {
+            throw Exception(
+                ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT,
+                "The INTERVAL must be a week or shorter, '{}' given",
+                argument_types[ARGUMENT_TIMEOUT]->getName());
+        }
+        interval_length = interval_datatype->getKind().toSeconds();
+    }
+
+    bool allocatesMemoryInArena() const override { return false; }
+
+    void windowInsertResultInto(const WindowTransform * transform,
+        size_t function_index) override
+    {
+        const auto & current_block = transform->blockAt(transform->current_row);
+        const auto & workspace = transform->workspaces[function_index];
+        auto & state = getState(workspace);
+
+        auto timeout = interval_length *
+            (*current_block.input_columns[workspace.argument_column_indices[ARGUMENT_TIMEOUT]]).getFloat64(0);
+
+        Float64 curr_timestamp;
+        if (ts_scale_multiplier)
+        {
+            const auto & column = transform->blockAt(transform->current_row.block).input_columns[workspace.argument_column_indices[ARGUMENT_TIMESTAMP]];
+            curr_timestamp = static_cast<Float64>(checkAndGetColumn<DataTypeDateTime64::ColumnType>(column.get())->getInt(transform->current_row.row)) / ts_scale_multiplier;
+        }
+        else
+        {
+            curr_timestamp = WindowFunctionHelpers::getValue<Float64>(transform, function_index, ARGUMENT_TIMESTAMP, transform->current_row);
+        }
+
+        if (transform->current_row == transform->partition_start)
+            state.session_number = 0;
+        else if (curr_timestamp - state.previous_timestamp > timeout)
+            ++state.session_number;
+        state.previous_timestamp = curr_timestamp;
+
+        WindowFunctionHelpers::setValueToOutputColumn<UInt64>(transform, function_index, state.session_number);
+    }
+
+private:
+    Float64 interval_length = 1;
+    Int64 ts_scale_multiplier = 0;
+};
+
 
 void registerWindowFunctions(AggregateFunctionFactory & factory)
 {
@@ -2393,6 +2507,13 @@ void registerWindowFunctions(AggregateFunctionFactory & factory)
             return std::make_shared<WindowFunctionNonNegativeDerivative>(
                 name, argument_types, parameters);
         }, properties});
+
+    factory.registerFunction("sessionNumber", {[](const std::string & name,
+           const DataTypes & argument_types, const Array & parameters, const Settings *)
+        {
+            return std::make_shared<WindowFunctionSessionNumber>(
+                name, argument_types, parameters);
+        }, properties});
 }
 
 }
@@ -5,6 +5,7 @@
 #include <Interpreters/InterpreterSelectQuery.h>
 #include <Interpreters/ProcessList.h>
 #include <Parsers/ASTInsertQuery.h>
+#include <Parsers/queryToString.h>
 #include <Processors/Transforms/SquashingChunksTransform.h>
 #include <Processors/Transforms/ExpressionTransform.h>
 #include <Processors/Executors/PullingPipelineExecutor.h>
@@ -25,6 +26,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <unordered_map>
 
 namespace ProfileEvents
 {
@@ -87,7 +89,7 @@ using ViewsDataPtr = std::shared_ptr<ViewsData>;
 class CopyingDataToViewsTransform final : public IProcessor
 {
 public:
-    CopyingDataToViewsTransform(const Block & header, ViewsDataPtr data);
+    CopyingDataToViewsTransform(const Block & header, size_t num_outputs, ViewsDataPtr data);
 
     String getName() const override { return "CopyingDataToViewsTransform"; }
     Status prepare() override;
@@ -98,6 +100,23 @@ private:
     ViewsDataPtr views_data;
 };
 
+/// Copies the result of a SELECT shared between materialized views with identical
+/// inner queries to the insert chain of every such view. Unlike CopyTransform, passes
+/// exception packets to the outputs instead of rethrowing them, as expected by
+/// FinalizingViewsTransform.
+class CopyingViewResultTransform final : public IProcessor
+{
+public:
+    CopyingViewResultTransform(const Block & header, size_t num_outputs);
+
+    String getName() const override { return "CopyingViewResultTransform"; }
+    Status prepare() override;
+    InputPort & getInputPort() { return input; }
+
+private:
+    InputPort & input;
+};
+
 /// For source chunk, execute view query over it.
 class ExecutingInnerQueryFromViewTransform final : public ExceptionKeepingTransform
 {
@@ -252,6 +271,8 @@ Chain buildPushingToViewsChain(
     }
 
     std::vector<Chain> chains;
+    /// Pointers to elements of views_data->views in the same order as chains.
+    std::vector<ViewRuntimeData *> views_by_index;
 
     for (const auto & view_id : views)
     {
@@ -370,16 +391,8 @@ Chain buildPushingToViewsChain(
             nullptr,
             std::move(runtime_stats)});
 
-        if (type == QueryViewsLogElement::ViewType::MATERIALIZED)
-        {
-            auto executing_inner_query = std::make_shared<ExecutingInnerQueryFromViewTransform>(
-                storage_header, views_data->views.back(), views_data);
-            executing_inner_query->setRuntimeData(view_thread_status, view_counter_ms);
-
-            out.addSource(std::move(executing_inner_query));
-        }
-
         chains.emplace_back(std::move(out));
+        views_by_index.push_back(&views_data->views.back());
 
         /// Add the view to the query access info so it can appear in system.query_log
         if (!no_destination)
@@ -401,7 +414,35 @@ Chain buildPushingToViewsChain(
         for (const auto & chain : chains)
             headers.push_back(chain.getOutputHeader());
 
-        auto copying_data = std::make_shared<CopyingDataToViewsTransform>(storage_header, views_data);
+        /// Materialized views with identical inner queries over the same source produce
+        /// identical results, so if their targets also have identical structure, the query
+        /// is executed once and its result is copied to the insert chain of every such view.
+        /// leader_of[i] == i for a view executing its own query, otherwise it is the index
+        /// of the view whose result is reused.
+        std::vector<size_t> leader_of(num_views);
+        std::vector<size_t> group_size(num_views, 0);
+        {
+            std::unordered_map<String, size_t> leader_by_key;
+            for (size_t i = 0; i < num_views; ++i)
+            {
+                leader_of[i] = i;
+                if (settings.share_select_for_identical_materialized_views
+                    && views_by_index[i]->runtime_stats->type == QueryViewsLogElement::ViewType::MATERIALIZED)
+                {
+                    auto key = queryToString(views_by_index[i]->query) + '\n' + views_by_index[i]->sample_block.dumpStructure();
+                    auto [it, inserted] = leader_by_key.emplace(std::move(key), i);
+                    leader_of[i] = it->second;
+                }
+                ++group_size[leader_of[i]];
+            }
+        }
+
+        size_t num_sources = 0;
+        for (size_t i = 0; i < num_views; ++i)
+            if (leader_of[i] == i)
+                ++num_sources;
+
+        auto copying_data = std::make_shared<CopyingDataToViewsTransform>(storage_header, num_sources, views_data);
         auto finalizing_views = std::make_shared<FinalizingViewsTransform>(std::move(headers), views_data);
         auto out = copying_data->getOutputs().begin();
         auto in = finalizing_views->getInputs().begin();
@@ -410,14 +451,56 @@ Chain buildPushingToViewsChain(
 
         std::list<ProcessorPtr> processors;
 
-        for (auto & chain : chains)
+        /// For every group leader, an iterator to the next free output of its fan-out.
+        std::vector<std::list<OutputPort>::iterator> next_shared_output(num_views);
+
+        for (size_t i = 0; i < num_views; ++i)
         {
+            auto & chain = chains[i];
+            auto & view = *views_by_index[i];
+
             max_parallel_streams += std::max<size_t>(chain.getNumThreads(), 1);
             result_chain.attachResources(chain.detachResources());
-            connect(*out, chain.getInputPort());
+
+            if (view.runtime_stats->type == QueryViewsLogElement::ViewType::MATERIALIZED)
+            {
+                if (leader_of[i] == i)
+                {
+                    auto executing_inner_query = std::make_shared<ExecutingInnerQueryFromViewTransform>(
+                        storage_header, view, views_data);
+                    executing_inner_query->setRuntimeData(view.runtime_stats->thread_status, &view.runtime_stats->elapsed_ms);
+                    connect(*out, executing_inner_query->getInputPort());
+                    ++out;
+
+                    if (group_size[i] > 1)
+                    {
+                        auto copying_result = std::make_shared<CopyingViewResultTransform>(view.sample_block, group_size[i]);
+                        connect(executing_inner_query->getOutputPort(), copying_result->getInputPort());
+                        next_shared_output[i] = copying_result->getOutputs().begin();
+                        connect(*next_shared_output[i], chain.getInputPort());
+                        ++next_shared_output[i];
+                        processors.emplace_back(std::move(copying_result));
+                    }
+                    else
+                        connect(executing_inner_query->getOutputPort(), chain.getInputPort());
+
+                    processors.emplace_back(std::move(executing_inner_query));
+                }
+                else
+                {
+                    auto & output = next_shared_output[leader_of[i]];
+                    connect(*output, chain.getInputPort());
+                    ++output;
+                }
+            }
+            else
+            {
+                connect(*out, chain.getInputPort());
+                ++out;
+            }
+
             connect(chain.getOutputPort(), *in);
             ++in;
-            ++out;
             processors.splice(processors.end(), Chain::getProcessors(std::move(chain)));
         }
 
@@ -529,12 +612,12 @@ static void logQueryViews(std::list<ViewRuntimeData> & views, ContextPtr context
 }
 
 
-CopyingDataToViewsTransform::CopyingDataToViewsTransform(const Block & header, ViewsDataPtr data)
-    : IProcessor({header}, OutputPorts(data->views.size(), header))
+CopyingDataToViewsTransform::CopyingDataToViewsTransform(const Block & header, size_t num_outputs, ViewsDataPtr data)
+    : IProcessor({header}, OutputPorts(num_outputs, header))
     , input(inputs.front())
     , views_data(std::move(data))
 {
-    if (views_data->views.empty())
+    if (num_outputs == 0)
         throw Exception(ErrorCodes::LOGICAL_ERROR, "CopyingDataToViewsTransform cannot have zero outputs");
 }
 
@@ -587,6 +670,57 @@ IProcessor::Status CopyingDataToViewsTransform::prepare()
 }
 
 
+CopyingViewResultTransform::CopyingViewResultTransform(const Block & header, size_t num_outputs)
+    : IProcessor({header}, OutputPorts(num_outputs, header))
+    , input(inputs.front())
+{
+    if (num_outputs < 2)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "CopyingViewResultTransform expects more than 1 outputs, got {}", num_outputs);
+}
+
+IProcessor::Status CopyingViewResultTransform::prepare()
+{
+    bool all_can_push = true;
+    for (auto & output : outputs)
+    {
+        if (output.isFinished())
+            throw Exception(ErrorCodes::LOGICAL_ERROR, "Cannot push view result because output port is finished");
+
+        if (!output.canPush())
+            all_can_push = false;
+    }
+
+    if (!all_can_push)
+        return Status::PortFull;
+
+    if (input.isFinished())
+    {
+        for (auto & output : outputs)
+            output.finish();
+
+        return Status::Finished;
+    }
+
+    input.setNeeded();
+    if (!input.hasData())
+        return Status::NeedData;
+
+    auto data = input.pullData();
+    if (data.exception)
+    {
+        for (auto & output : outputs)
+            output.pushException(data.exception);
+    }
+    else
+    {
+        for (auto & output : outputs)
+            output.push(data.chunk.clone());
+    }
+
+    return Status::PortFull;
+}
+
+
 ExecutingInnerQueryFromViewTransform::ExecutingInnerQueryFromViewTransform(
     const Block & header,
     ViewRuntimeData & view_,
@@ -0,0 +1,377 @@
+#include <benchmark/benchmark.h>
+
+#include <pcg-random/pcg_random.hpp>
+#include <base/sort.h>
+#include <Common/assert_cast.h>
+
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <AggregateFunctions/registerAggregateFunctions.h>
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <Columns/FilterDescription.h>
+#include <Core/Block.h>
+#include <Core/SortDescription.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Formats/NativeReader.h>
+#include <Formats/NativeWriter.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <Interpreters/Aggregator.h>
+#include <Interpreters/HashJoin.h>
+#include <Interpreters/TableJoin.h>
+#include <Processors/Merges/Algorithms/MergingSortedAlgorithm.h>
+
+using namespace DB;
+
+/// Microbenchmarks for the hot loops of pipeline operators. The goal is to catch
+/// regressions in filtering, merging, aggregation, join and serialization kernels
+/// per commit, on synthetic data with controlled cardinality / null ratio / string
+/// length, without spinning up a server or building whole query pipelines.
+
+namespace
+{
+
+void initAggregateFunctions()
+{
+    static std::once_flag flag;
+    std::call_once(flag, [] { registerAggregateFunctions(); });
+}
+
+/// Column generators. All of them are deterministic (fixed seed) so that
+/// results are comparable between runs and between commits.
+
+ColumnPtr makeUInt64Column(size_t rows, size_t cardinality, pcg64 & rng)
+{
+    auto column = ColumnUInt64::create();
+    auto & data = column->getData();
+    data.resize(rows);
+    for (size_t i = 0; i < rows; ++i)
+        data[i] = rng() % cardinality;
+    return column;
+}
+
+ColumnPtr makeNullableUInt64Column(size_t rows, size_t cardinality, double null_ratio, pcg64 & rng)
+{
+    auto nested = ColumnUInt64::create();
+    auto null_map = ColumnUInt8::create();
+    auto & data = nested->getData();
+    auto & nulls = null_map->getData();
+    data.resize(rows);
+    nulls.resize(rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        data[i] = rng() % cardinality;
+        nulls[i] = std::uniform_real_distribution<double>(0.0, 1.0)(rng) < null_ratio;
+    }
+    return ColumnNullable::create(std::move(nested), std::move(null_map));
+}
+
+/// String lengths are uniform in [avg_length / 2, avg_length * 3 / 2], the
+/// payload is drawn from a dictionary of `cardinality` distinct values.
+ColumnPtr makeStringColumn(size_t rows, size_t cardinality, size_t avg_length, pcg64 & rng)
+{
+    std::vector<String> dictionary(cardinality);
+    for (auto & value : dictionary)
+    {
+        size_t length = avg_length / 2 + rng() % (avg_length + 1);
+        value.resize(length);
+        for (auto & c : value)
+            c = 'a' + rng() % 26;
+    }
+
+    auto column = ColumnString::create();
+    for (size_t i = 0; i < rows; ++i)
+    {
+        const auto & value = dictionary[rng() % cardinality];
+        column->insertData(value.data(), value.size());
+    }
+    return column;
+}
+
+ColumnPtr makeFilterColumn(size_t rows, double selectivity, pcg64 & rng)
+{
+    auto column = ColumnUInt8::create();
+    auto & data = column->getData();
+    data.resize(rows);
+    for (size_t i = 0; i < rows; ++i)
+        data[i] = std::uniform_real_distribution<double>(0.0, 1.0)(rng) < selectivity;
+    return column;
+}
+
+constexpr size_t DEFAULT_ROWS = 65536;
+
+}
+
+/// Filtering kernel of FilterTransform: FilterDescription + IColumn::filter.
+
+static void BM_FilterUInt64(benchmark::State & state)
+{
+    pcg64 rng(42);
+    double selectivity = state.range(0) / 100.0;
+    auto column = makeUInt64Column(DEFAULT_ROWS, 1000, rng);
+    auto filter_column = makeFilterColumn(DEFAULT_ROWS, selectivity, rng);
+    FilterDescription description(*filter_column);
+
+    for (auto _ : state)
+    {
+        auto filtered = description.filter(*column, -1);
+        benchmark::DoNotOptimize(filtered);
+    }
+
+    state.SetItemsProcessed(state.iterations() * DEFAULT_ROWS);
+}
+
+static void BM_FilterString(benchmark::State & state)
+{
+    pcg64 rng(42);
+    double selectivity = state.range(0) / 100.0;
+    auto column = makeStringColumn(DEFAULT_ROWS, 1000, state.range(1), rng);
+    auto filter_column = makeFilterColumn(DEFAULT_ROWS, selectivity, rng);
+    FilterDescription description(*filter_column);
+
+    for (auto _ : state)
+    {
+        auto filtered = description.filter(*column, -1);
+        benchmark::DoNotOptimize(filtered);
+    }
+
+    state.SetItemsProcessed(state.iterations() * DEFAULT_ROWS);
+}
+
+static void BM_FilterNullableUInt64(benchmark::State & state)
+{
+    pcg64 rng(42);
+    double null_ratio = state.range(0) / 100.0;
+    auto column = makeNullableUInt64Column(DEFAULT_ROWS, 1000, null_ratio, rng);
+    auto filter_column = makeFilterColumn(DEFAULT_ROWS, 0.5, rng);
+    FilterDescription description(*filter_column);
+
+    for (auto _ : state)
+    {
+        auto filtered = description.filter(*column, -1);
+        benchmark::DoNotOptimize(filtered);
+    }
+
+    state.SetItemsProcessed(state.iterations() * DEFAULT_ROWS);
+}
+
+BENCHMARK(BM_FilterUInt64)->Arg(1)->Arg(10)->Arg(50)->Arg(90)->Arg(99);
+BENCHMARK(BM_FilterString)->Args({50, 8})->Args({50, 64})->Args({50, 512});
+BENCHMARK(BM_FilterNullableUInt64)->Arg(0)->Arg(10)->Arg(50);
+
+/// K-way merge kernel of MergingSortedTransform.
+
+static void BM_MergingSorted(benchmark::State & state)
+{
+    pcg64 rng(42);
+    size_t num_inputs = state.range(0);
+    size_t rows_per_input = DEFAULT_ROWS / num_inputs;
+
+    Block header{ColumnWithTypeAndName(ColumnUInt64::create(), std::make_shared<DataTypeUInt64>(), "x")};
+
+    std::vector<ColumnPtr> sorted_columns(num_inputs);
+    for (auto & column : sorted_columns)
+    {
+        auto generated = makeUInt64Column(rows_per_input, 1000000, rng);
+        auto & data = assert_cast<ColumnUInt64 &>(generated->assumeMutableRef()).getData();
+        ::sort(data.begin(), data.end());
+        column = generated;
+    }
+
+    SortDescription description{SortColumnDescription("x")};
+
+    for (auto _ : state)
+    {
+        MergingSortedAlgorithm algorithm(header, num_inputs, description, 8192, SortingQueueStrategy::Batch);
+
+        IMergingAlgorithm::Inputs inputs(num_inputs);
+        for (size_t i = 0; i < num_inputs; ++i)
+            inputs[i].chunk = Chunk(Columns{sorted_columns[i]}, rows_per_input);
+
+        algorithm.initialize(std::move(inputs));
+
+        size_t merged_rows = 0;
+        while (true)
+        {
+            auto status = algorithm.merge();
+            merged_rows += status.chunk.getNumRows();
+            /// Each input consists of a single chunk, so a request for more data
+            /// from some source means that this source is exhausted.
+            if (status.is_finished)
+                break;
+        }
+        benchmark::DoNotOptimize(merged_rows);
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows_per_input * num_inputs);
+}
+
+BENCHMARK(BM_MergingSorted)->Arg(2)->Arg(8)->Arg(32);
+
+/// Hash join kernels: building the hash table from the right side and probing it
+/// with blocks from the left side.
+
+static std::shared_ptr<TableJoin> makeTestTableJoin()
+{
+    auto table_join = std::make_shared<TableJoin>(
+        SizeLimits{}, false, JoinKind::Inner, JoinStrictness::All, Names{"k"});
+    table_join->setLeftKeys({"k"});
+    table_join->addJoinedColumn(NameAndTypePair("v", std::make_shared<DataTypeUInt64>()));
+    return table_join;
+}
+
+static void BM_HashJoinBuild(benchmark::State & state)
+{
+    pcg64 rng(42);
+    size_t cardinality = state.range(0);
+
+    Block right_block{
+        ColumnWithTypeAndName(makeUInt64Column(DEFAULT_ROWS, cardinality, rng), std::make_shared<DataTypeUInt64>(), "k"),
+        ColumnWithTypeAndName(makeUInt64Column(DEFAULT_ROWS, 1000000, rng), std::make_shared<DataTypeUInt64>(), "v")};
+
+    for (auto _ : state)
+    {
+        HashJoin join(makeTestTableJoin(), right_block.cloneEmpty());
+        join.addJoinedBlock(right_block, false);
+        benchmark::DoNotOptimize(join.getTotalRowCount());
+    }
+
+    state.SetItemsProcessed(state.iterations() * DEFAULT_ROWS);
+}
+
+static void BM_HashJoinProbe(benchmark::State & state)
+{
+    pcg64 rng(42);
+    size_t cardinality = state.range(0);
+
+    Block right_block{
+        ColumnWithTypeAndName(makeUInt64Column(DEFAULT_ROWS, cardinality, rng), std::make_shared<DataTypeUInt64>(), "k"),
+        ColumnWithTypeAndName(makeUInt64Column(DEFAULT_ROWS, 1000000, rng), std::make_shared<DataTypeUInt64>(), "v")};
+
+    HashJoin join(makeTestTableJoin(), right_block.cloneEmpty());
+    join.addJoinedBlock(right_block, false);
+
+    Block left_block{
+        ColumnWithTypeAndName(makeUInt64Column(DEFAULT_ROWS, cardinality, rng), std::make_shared<DataTypeUInt64>(), "k")};
+
+    for (auto _ : state)
+    {
+        Block block = left_block;
+        ExtraBlockPtr not_processed;
+        join.joinBlock(block, not_processed);
+        benchmark::DoNotOptimize(block);
+    }
+
+    state.SetItemsProcessed(state.iterations() * DEFAULT_ROWS);
+}
+
+BENCHMARK(BM_HashJoinBuild)->Arg(100)->Arg(10000)->Arg(1000000);
+BENCHMARK(BM_HashJoinProbe)->Arg(100)->Arg(10000)->Arg(1000000);
+
+/// Aggregation kernel of AggregatingTransform: Aggregator::executeOnBlock
+/// with a single UInt64 key and sum/count states.
+
+static void BM_Aggregation(benchmark::State & state)
+{
+    initAggregateFunctions();
+
+    pcg64 rng(42);
+    size_t cardinality = state.range(0);
+
+    Block block{
+        ColumnWithTypeAndName(makeUInt64Column(DEFAULT_ROWS, cardinality, rng), std::make_shared<DataTypeUInt64>(), "k"),
+        ColumnWithTypeAndName(makeUInt64Column(DEFAULT_ROWS, 1000000, rng), std::make_shared<DataTypeUInt64>(), "v")};
+
+    AggregateFunctionProperties properties;
+    AggregateDescription aggregate;
+    aggregate.function = AggregateFunctionFactory::instance().get(
+        "sum", {std::make_shared<DataTypeUInt64>()}, {}, properties);
+    aggregate.argument_names = {"v"};
+    aggregate.column_name = "sum(v)";
+
+    Aggregator::Params params(
+        /* keys_ */ {"k"},
+        /* aggregates_ */ {aggregate},
+        /* overflow_row_ */ false,
+        /* max_rows_to_group_by_ */ 0,
+        /* group_by_overflow_mode_ */ OverflowMode::THROW,
+        /* group_by_two_level_threshold_ */ 0,
+        /* group_by_two_level_threshold_bytes_ */ 0,
+        /* max_bytes_before_external_group_by_ */ 0,
+        /* empty_result_for_aggregation_by_empty_set_ */ false,
+        /* tmp_data_scope_ */ nullptr,
+        /* max_threads_ */ 1,
+        /* min_free_disk_space_ */ 0,
+        /* compile_aggregate_expressions_ */ false,
+        /* min_count_to_compile_aggregate_expression_ */ 0,
+        /* max_block_size_ */ 8192,
+        /* enable_prefetch_ */ true,
+        /* only_merge_ */ false);
+
+    Aggregator aggregator(block.cloneEmpty(), params);
+
+    for (auto _ : state)
+    {
+        AggregatedDataVariants variants;
+        ColumnRawPtrs key_columns(1);
+        Aggregator::AggregateColumns aggregate_columns(1);
+        bool no_more_keys = false;
+        aggregator.executeOnBlock(block, variants, key_columns, aggregate_columns, no_more_keys);
+        benchmark::DoNotOptimize(variants.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * DEFAULT_ROWS);
+}
+
+BENCHMARK(BM_Aggregation)->Arg(10)->Arg(10000)->Arg(1000000);
+
+/// Native format serialization, the backbone of inter-server data exchange.
+
+static void BM_NativeWrite(benchmark::State & state)
+{
+    pcg64 rng(42);
+
+    Block block{
+        ColumnWithTypeAndName(makeUInt64Column(DEFAULT_ROWS, 1000000, rng), std::make_shared<DataTypeUInt64>(), "x"),
+        ColumnWithTypeAndName(makeStringColumn(DEFAULT_ROWS, 1000, state.range(0), rng), std::make_shared<DataTypeString>(), "s")};
+
+    for (auto _ : state)
+    {
+        WriteBufferFromOwnString out;
+        NativeWriter writer(out, /* client_revision_ */ 0, block.cloneEmpty());
+        writer.write(block);
+        benchmark::DoNotOptimize(out.str());
+    }
+
+    state.SetItemsProcessed(state.iterations() * DEFAULT_ROWS);
+}
+
+static void BM_NativeRead(benchmark::State & state)
+{
+    pcg64 rng(42);
+
+    Block block{
+        ColumnWithTypeAndName(makeUInt64Column(DEFAULT_ROWS, 1000000, rng), std::make_shared<DataTypeUInt64>(), "x"),
+        ColumnWithTypeAndName(makeStringColumn(DEFAULT_ROWS, 1000, state.range(0), rng), std::make_shared<DataTypeString>(), "s")};
+
+    WriteBufferFromOwnString out;
+    NativeWriter writer(out, /* client_revision_ */ 0, block.cloneEmpty());
+    writer.write(block);
+    String serialized = out.str();
+
+    for (auto _ : state)
+    {
+        ReadBufferFromString in(serialized);
+        NativeReader reader(in, /* server_revision_ */ 0);
+        auto read_block = reader.read();
+        benchmark::DoNotOptimize(read_block);
+    }
+
+    state.SetItemsProcessed(state.iterations() * DEFAULT_ROWS);
+}
+
+BENCHMARK(BM_NativeWrite)->Arg(8)->Arg(64)->Arg(512);
+BENCHMARK(BM_NativeRead)->Arg(8)->Arg(64)->Arg(512);
@@ -84,6 +84,7 @@ void ConnectionCollector::drainConnections(IConnections & connections, bool thro
             case Protocol::Server::EndOfStream:
             case Protocol::Server::Log:
             case Protocol::Server::ProfileEvents:
+            case Protocol::Server::PartialResult:
                 break;
 
             case Protocol::Server::Exception:
@@ -437,6 +437,10 @@ std::optional<Block> RemoteQueryExecutor::processPacket(Packet packet)
                     throw Exception(ErrorCodes::SYSTEM_ERROR, "Could not push into profile queue");
             break;
 
+        case Protocol::Server::PartialResult:
+            /// Partial results of shards are not combined on the initiator, drop them.
+            break;
+
         default:
             got_unknown_packet_from_replica = true;
             throw Exception(
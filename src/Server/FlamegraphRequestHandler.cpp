@@ -0,0 +1,211 @@
+#include <Server/FlamegraphRequestHandler.h>
+
+#include <Access/Common/AccessFlags.h>
+#include <IO/HTTPCommon.h>
+#include <IO/Operators.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteBufferFromString.h>
+#include <IO/WriteHelpers.h>
+#include <Interpreters/Context.h>
+#include <Interpreters/ProcessList.h>
+#include <Interpreters/Session.h>
+#include <Server/HTTP/HTMLForm.h>
+#include <Server/IServer.h>
+#include <Common/Stopwatch.h>
+#include <Common/logger_useful.h>
+#include <base/sleep.h>
+
+#include <Poco/Net/HTTPBasicCredentials.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+
+#include <map>
+
+#ifdef OS_LINUX
+#include <Storages/System/StorageSystemStackTrace.h>
+#endif
+
+#if defined(__ELF__) && !defined(OS_FREEBSD)
+#include <Common/SymbolIndex.h>
+#include <base/demangle.h>
+#endif
+
+namespace DB
+{
+
+#ifdef OS_LINUX
+namespace
+{
+    /// Maximum sampling duration, to not keep an HTTP connection (and the sampling mutex) busy forever.
+    constexpr UInt64 max_duration_sec = 60;
+    constexpr UInt64 min_interval_ms = 10;
+
+    std::vector<UInt64> getThreadIdsOfQuery(ContextPtr context, const String & query_id)
+    {
+        ProcessList::Info info = context->getProcessList().getInfo(/* get_thread_list */ true);
+        for (const auto & process : info)
+            if (process.client_info.current_query_id == query_id)
+                return process.thread_ids;
+        return {};
+    }
+
+    /// Render a stack trace in the folded format: frames from the root to the leaf, separated by ';'.
+    String collapseTrace(const std::vector<UInt64> & frames)
+    {
+        WriteBufferFromOwnString out;
+
+#if defined(__ELF__) && !defined(OS_FREEBSD)
+        auto symbol_index_ptr = SymbolIndex::instance();
+        const SymbolIndex & symbol_index = *symbol_index_ptr;
+#endif
+
+        for (size_t i = frames.size(); i > 0; --i)
+        {
+            if (i != frames.size())
+                writeChar(';', out);
+
+            const void * addr = reinterpret_cast<const void *>(frames[i - 1]);
+
+#if defined(__ELF__) && !defined(OS_FREEBSD)
+            if (const auto * symbol = symbol_index.findSymbol(addr))
+            {
+                int status = 0;
+                writeString(demangle(symbol->name, status), out);
+                continue;
+            }
+#endif
+            writeString(fmt::format("{}", addr), out);
+        }
+
+        return out.str();
+    }
+}
+#endif
+
+FlamegraphRequestHandler::FlamegraphRequestHandler(IServer & server_) : WithContext(server_.context())
+{
+}
+
+void FlamegraphRequestHandler::handleRequest(HTTPServerRequest & request, HTTPServerResponse & response)
+{
+    try
+    {
+#ifdef OS_LINUX
+        HTMLForm params(getContext()->getSettingsRef(), request);
+
+        /// Symbolized stack traces of other users' queries are sensitive, so the endpoint
+        /// requires the same credentials the query endpoint accepts (HTTP Basic auth,
+        /// X-ClickHouse-* headers or 'user'/'password' parameters) and the right to read
+        /// system.stack_trace, which exposes equivalent information to SQL sessions.
+        String user = request.get("X-ClickHouse-User", "");
+        String password = request.get("X-ClickHouse-Key", "");
+        if (user.empty())
+        {
+            if (request.hasCredentials())
+            {
+                Poco::Net::HTTPBasicCredentials credentials(request);
+                user = credentials.getUsername();
+                password = credentials.getPassword();
+            }
+            else
+            {
+                user = params.get("user", "default");
+                password = params.get("password", "");
+            }
+        }
+
+        Session session(getContext(), ClientInfo::Interface::HTTP, request.isSecure());
+
+        ContextMutablePtr context;
+        try
+        {
+            session.authenticate(user, password, request.clientAddress());
+            context = session.makeQueryContext();
+        }
+        catch (...)
+        {
+            tryLogCurrentException("FlamegraphRequestHandler");
+            response.requireAuthentication("ClickHouse server HTTP API");
+            *response.send() << "Authentication failed." << std::endl;
+            return;
+        }
+
+        context->checkAccess(AccessType::SELECT, "system", "stack_trace");
+
+        String query_id = params.get("query_id", "");
+        if (query_id.empty())
+        {
+            response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_BAD_REQUEST);
+            *response.send() << "No 'query_id' parameter specified."
+                << " Usage: /flamegraph?query_id=...[&duration=5][&interval=100]" << std::endl;
+            return;
+        }
+
+        UInt64 duration_sec = std::min(parse<UInt64>(params.get("duration", "5")), max_duration_sec);
+        UInt64 interval_ms = std::max(parse<UInt64>(params.get("interval", "100")), min_interval_ms);
+
+        /// Folded stack -> number of times it was observed. Ordered for deterministic output.
+        std::map<String, UInt64> collapsed_stacks;
+        bool query_found = false;
+
+        Stopwatch watch;
+        while (watch.elapsedSeconds() < duration_sec)
+        {
+            /// Re-enumerate the threads on every round: threads of a query come and go.
+            /// Note: the list also contains threads that already finished their part of work;
+            /// sampleThreads filters them out by the query id they are executing now (if any).
+            std::vector<UInt64> thread_ids = getThreadIdsOfQuery(context, query_id);
+            if (thread_ids.empty())
+                break;
+            query_found = true;
+
+            for (const auto & [thread_id, frames] : StorageSystemStackTrace::sampleThreads(thread_ids, query_id))
+                ++collapsed_stacks[collapseTrace(frames)];
+
+            sleepForMilliseconds(interval_ms);
+        }
+
+        const auto & config = context->getConfigRef();
+        setResponseDefaultHeaders(response, config.getUInt("keep_alive_timeout", 10));
+
+        if (!query_found)
+        {
+            response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_NOT_FOUND);
+            *response.send() << "Query with id '" << query_id << "' is not currently executing." << std::endl;
+            return;
+        }
+
+        WriteBufferFromOwnString message;
+        for (const auto & [stack, count] : collapsed_stacks)
+            message << stack << ' ' << count << '\n';
+
+        response.setContentType("text/plain; charset=UTF-8");
+        *response.send() << message.str();
+#else
+        (void)request;
+        response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_NOT_IMPLEMENTED);
+        *response.send() << "Stack sampling is supported only on Linux." << std::endl;
+#endif
+    }
+    catch (...)
+    {
+        tryLogCurrentException("FlamegraphRequestHandler");
+
+        try
+        {
+            response.setStatusAndReason(Poco::Net::HTTPResponse::HTTP_INTERNAL_SERVER_ERROR);
+
+            if (!response.sent())
+            {
+                /// We have not sent anything yet and we don't even know if we need to compress response.
+                *response.send() << getCurrentExceptionMessage(false) << std::endl;
+            }
+        }
+        catch (...)
+        {
+            LOG_ERROR((&Poco::Logger::get("FlamegraphRequestHandler")), "Cannot send exception to client");
+        }
+    }
+}
+
+}
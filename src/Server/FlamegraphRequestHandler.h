@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Server/HTTP/HTTPRequestHandler.h>
+
+namespace DB
+{
+
+class Context;
+class IServer;
+
+/// Samples stack traces of all threads of the query with the specified query_id for the
+/// requested amount of time and replies with a collapsed (folded) stack summary that can
+/// be fed directly to flamegraph.pl or speedscope. An embedded replacement for attaching
+/// gdb to a stuck production query:
+///     curl 'http://localhost:8123/flamegraph?query_id=...&duration=5&interval=100'
+/// The request is authenticated like a query and requires the right to read
+/// system.stack_trace, which exposes the same information to SQL sessions.
+class FlamegraphRequestHandler : public HTTPRequestHandler, WithContext
+{
+public:
+    explicit FlamegraphRequestHandler(IServer & server_);
+
+    void handleRequest(HTTPServerRequest & request, HTTPServerResponse & response) override;
+};
+
+}
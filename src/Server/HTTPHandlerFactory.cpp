@@ -10,6 +10,7 @@
 #include "NotFoundHandler.h"
 #include "StaticRequestHandler.h"
 #include "ReplicasStatusHandler.h"
+#include "FlamegraphRequestHandler.h"
 #include "InterserverIOHTTPHandler.h"
 #include "PrometheusRequestHandler.h"
 #include "WebUIRequestHandler.h"
@@ -163,6 +164,14 @@ void addDefaultHandlersFactory(
 {
     addCommonDefaultHandlersFactory(factory, server);
 
+    /// Not in the common set: the handler authenticates like a query and must not be
+    /// served on the interserver ports. Registered before the query handler, which
+    /// matches any path.
+    auto flamegraph_handler = std::make_shared<HandlingRuleHTTPHandlerFactory<FlamegraphRequestHandler>>(server);
+    flamegraph_handler->attachNonStrictPath("/flamegraph");
+    flamegraph_handler->allowGetAndHeadRequest();
+    factory.addHandler(flamegraph_handler);
+
     auto query_handler = std::make_shared<HandlingRuleHTTPHandlerFactory<DynamicQueryHandler>>(server, "query");
     query_handler->allowPostAndGetParamsAndOptionsRequest();
     factory.addHandler(query_handler);
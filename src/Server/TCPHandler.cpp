@@ -16,6 +16,8 @@
 #include <Common/NetException.h>
 #include <Common/setThreadName.h>
 #include <Common/OpenSSLHelpers.h>
+#include <Common/SipHash.h>
+#include <Common/hex.h>
 #include <IO/Progress.h>
 #include <Compression/CompressedReadBuffer.h>
 #include <Compression/CompressedWriteBuffer.h>
@@ -48,6 +50,7 @@
 #include <fmt/format.h>
 
 #include <Processors/Executors/PullingAsyncPipelineExecutor.h>
+#include <Processors/Executors/PullingPipelineExecutor.h>
 #include <Processors/Executors/PushingPipelineExecutor.h>
 #include <Processors/Executors/PushingAsyncPipelineExecutor.h>
 #include <Processors/Executors/CompletedPipelineExecutor.h>
@@ -67,6 +70,11 @@ namespace CurrentMetrics
     extern const Metric QueryThread;
 }
 
+namespace ProfileEvents
+{
+    extern const Event PreparedStatementExecutions;
+}
+
 namespace
 {
 NameToNameMap convertToQueryParameters(const Settings & passed_params)
@@ -99,6 +107,7 @@ namespace ErrorCodes
     extern const int UNEXPECTED_PACKET_FROM_CLIENT;
     extern const int UNKNOWN_PROTOCOL;
     extern const int AUTHENTICATION_FAILED;
+    extern const int UNKNOWN_PREPARED_STATEMENT;
 }
 
 TCPHandler::TCPHandler(IServer & server_, TCPServer & tcp_server_, const Poco::Net::StreamSocket & socket_, bool parse_proxy_protocol_, std::string server_display_name_)
@@ -766,68 +775,99 @@ void TCPHandler::processOrdinaryQueryWithProcessors()
     std::unique_lock progress_lock(task_callback_mutex, std::defer_lock);
 
     {
-        PullingAsyncPipelineExecutor executor(pipeline);
         CurrentMetrics::Increment query_thread_metric_increment{CurrentMetrics::QueryThread};
 
-        Block block;
-        while (executor.pull(block, interactive_delay / 1000))
+        /// Returns false if the connection was closed and the caller should bail out.
+        auto run_executor = [&](auto & executor)
         {
-            std::unique_lock lock(task_callback_mutex);
-
-            if (isQueryCancelled())
+            Block block;
+            while (true)
             {
-                /// Several callback like callback for parallel reading could be called from inside the pipeline
-                /// and we have to unlock the mutex from our side to prevent deadlock.
-                lock.unlock();
-                /// A packet was received requesting to stop execution of the request.
-                executor.cancel();
-                break;
+                bool pulled;
+                if constexpr (std::is_same_v<std::decay_t<decltype(executor)>, PullingAsyncPipelineExecutor>)
+                    pulled = executor.pull(block, interactive_delay / 1000);
+                else
+                    pulled = executor.pull(block);
+
+                if (!pulled)
+                    break;
+
+                std::unique_lock lock(task_callback_mutex);
+
+                if (isQueryCancelled())
+                {
+                    /// Several callback like callback for parallel reading could be called from inside the pipeline
+                    /// and we have to unlock the mutex from our side to prevent deadlock.
+                    lock.unlock();
+                    /// A packet was received requesting to stop execution of the request.
+                    executor.cancel();
+                    break;
+                }
+
+                if (after_send_progress.elapsed() / 1000 >= interactive_delay)
+                {
+                    /// Some time passed and there is a progress.
+                    after_send_progress.restart();
+                    sendProgress();
+                    sendSelectProfileEvents();
+                    sendPartialResult();
+                }
+
+                sendLogs();
+
+                if (block)
+                {
+                    if (!state.io.null_format)
+                        sendData(block);
+                }
             }
 
-            if (after_send_progress.elapsed() / 1000 >= interactive_delay)
+            /// This lock wasn't acquired before and we make .lock() call here
+            /// so everything under this line is covered even together
+            /// with sendProgress() out of the scope
+            progress_lock.lock();
+
+            /** If data has run out, we will send the profiling data and total values to
+              * the last zero block to be able to use
+              * this information in the suffix output of stream.
+              * If the request was interrupted, then `sendTotals` and other methods could not be called,
+              *  because we have not read all the data yet,
+              *  and there could be ongoing calculations in other threads at the same time.
+              */
+            if (!isQueryCancelled())
             {
-                /// Some time passed and there is a progress.
-                after_send_progress.restart();
+                sendTotals(executor.getTotalsBlock());
+                sendExtremes(executor.getExtremesBlock());
+                sendProfileInfo(executor.getProfileInfo());
                 sendProgress();
+                sendLogs();
                 sendSelectProfileEvents();
             }
 
-            sendLogs();
+            if (state.is_connection_closed)
+                return false;
 
-            if (block)
-            {
-                if (!state.io.null_format)
-                    sendData(block);
-            }
-        }
+            sendData({});
+            last_sent_snapshots.clear();
+            return true;
+        };
 
-        /// This lock wasn't acquired before and we make .lock() call here
-        /// so everything under this line is covered even together
-        /// with sendProgress() out of the scope
-        progress_lock.lock();
-
-        /** If data has run out, we will send the profiling data and total values to
-          * the last zero block to be able to use
-          * this information in the suffix output of stream.
-          * If the request was interrupted, then `sendTotals` and other methods could not be called,
-          *  because we have not read all the data yet,
-          *  and there could be ongoing calculations in other threads at the same time.
-          */
-        if (!isQueryCancelled())
+        /// A single-threaded pipeline can be executed directly in the connection thread.
+        /// This removes the executor thread round-trips that dominate the latency of short
+        /// point queries, at the cost of handling cancellation and progress only between
+        /// result blocks.
+        if (query_context->getSettingsRef().use_inline_pipeline_executor && pipeline.getNumThreads() <= 1)
         {
-            sendTotals(executor.getTotalsBlock());
-            sendExtremes(executor.getExtremesBlock());
-            sendProfileInfo(executor.getProfileInfo());
-            sendProgress();
-            sendLogs();
-            sendSelectProfileEvents();
+            PullingPipelineExecutor executor(pipeline);
+            if (!run_executor(executor))
+                return;
+        }
+        else
+        {
+            PullingAsyncPipelineExecutor executor(pipeline);
+            if (!run_executor(executor))
+                return;
         }
-
-        if (state.is_connection_closed)
-            return;
-
-        sendData({});
-        last_sent_snapshots.clear();
     }
 
     sendProgress();
@@ -991,6 +1031,31 @@ void TCPHandler::sendSelectProfileEvents()
     sendProfileEvents();
 }
 
+void TCPHandler::sendPartialResult()
+{
+    if (client_tcp_protocol_version < DBMS_MIN_PROTOCOL_VERSION_WITH_PARTIAL_RESULT)
+        return;
+
+    if (!query_context->getSettingsRef().partial_result_update_duration_ms.totalMilliseconds())
+        return;
+
+    auto process_list_elem = query_context->getProcessListElement();
+    if (!process_list_elem)
+        return;
+
+    Block block = process_list_elem->getPartialResultsHolder()->mergeAndGet(state.last_sent_partial_result_version);
+    if (!block)
+        return;
+
+    initPartialResultBlockOutput(block);
+
+    writeVarUInt(Protocol::Server::PartialResult, *out);
+    writeStringBinary("", *out);
+
+    state.partial_result_block_out->write(block);
+    out->next();
+}
+
 void TCPHandler::sendInsertProfileEvents()
 {
     if (client_tcp_protocol_version < DBMS_MIN_PROTOCOL_VERSION_WITH_PROFILE_EVENTS_IN_INSERT)
@@ -1427,7 +1492,32 @@ void TCPHandler::receiveQuery()
     state.compression = static_cast<Protocol::Compression>(compression);
     last_block_in.compression = state.compression;
 
-    readStringBinary(state.query, *in);
+    UInt64 prepared_statement_mode = static_cast<UInt64>(Protocol::PreparedStatement::None);
+    if (client_tcp_protocol_version >= DBMS_MIN_PROTOCOL_VERSION_WITH_PREPARED_STATEMENTS)
+        readVarUInt(prepared_statement_mode, *in);
+
+    if (prepared_statement_mode == static_cast<UInt64>(Protocol::PreparedStatement::Execute))
+    {
+        UInt128 statement_hash;
+        readPODBinary(statement_hash, *in);
+
+        auto it = prepared_statements.find(statement_hash);
+        if (it == prepared_statements.end())
+            throw Exception(ErrorCodes::UNKNOWN_PREPARED_STATEMENT,
+                "No statement with hash {} was registered on this connection", getHexUIntLowercase(statement_hash));
+
+        state.query = it->second;
+        ProfileEvents::increment(ProfileEvents::PreparedStatementExecutions);
+    }
+    else
+    {
+        readStringBinary(state.query, *in);
+
+        /// The client maintains the same bound, so it knows which statements it can refer to by hash.
+        if (prepared_statement_mode == static_cast<UInt64>(Protocol::PreparedStatement::Register)
+            && prepared_statements.size() < DBMS_PREPARED_STATEMENTS_PER_CONNECTION)
+            prepared_statements.emplace(sipHash128(state.query.data(), state.query.size()), state.query);
+    }
 
     Settings passed_params;
     if (client_tcp_protocol_version >= DBMS_MIN_PROTOCOL_VERSION_WITH_PARAMETERS)
@@ -1559,7 +1649,17 @@ void TCPHandler::receiveUnexpectedQuery()
     readVarUInt(skip_uint_64, *in);
     last_block_in.compression = static_cast<Protocol::Compression>(skip_uint_64);
 
-    readStringBinary(skip_string, *in);
+    UInt64 skip_prepared_statement_mode = static_cast<UInt64>(Protocol::PreparedStatement::None);
+    if (client_tcp_protocol_version >= DBMS_MIN_PROTOCOL_VERSION_WITH_PREPARED_STATEMENTS)
+        readVarUInt(skip_prepared_statement_mode, *in);
+
+    if (skip_prepared_statement_mode == static_cast<UInt64>(Protocol::PreparedStatement::Execute))
+    {
+        UInt128 skip_hash_128;
+        readPODBinary(skip_hash_128, *in);
+    }
+    else
+        readStringBinary(skip_string, *in);
 
     if (client_tcp_protocol_version >= DBMS_MIN_PROTOCOL_VERSION_WITH_PARAMETERS)
         skip_settings.read(*in, settings_format);
@@ -1634,14 +1734,24 @@ bool TCPHandler::receiveUnexpectedData(bool throw_exception)
     String skip_external_table_name;
     readStringBinary(skip_external_table_name, *in);
 
-    std::shared_ptr<ReadBuffer> maybe_compressed_in;
-    if (last_block_in.compression == Protocol::Compression::Enable)
-        maybe_compressed_in = std::make_shared<CompressedReadBuffer>(*in, /* allow_different_codecs */ true);
+    bool read_ok;
+    if (state.block_in)
+    {
+        /// Continue the stream with the reader which was already created for it: it keeps the state
+        /// of stateful serializations (e.g. LowCardinality dictionaries shared between the blocks).
+        read_ok = !!state.block_in->read();
+    }
     else
-        maybe_compressed_in = in;
+    {
+        std::shared_ptr<ReadBuffer> maybe_compressed_in;
+        if (last_block_in.compression == Protocol::Compression::Enable)
+            maybe_compressed_in = std::make_shared<CompressedReadBuffer>(*in, /* allow_different_codecs */ true);
+        else
+            maybe_compressed_in = in;
 
-    auto skip_block_in = std::make_shared<NativeReader>(*maybe_compressed_in, client_tcp_protocol_version);
-    bool read_ok = !!skip_block_in->read();
+        auto skip_block_in = std::make_shared<NativeReader>(*maybe_compressed_in, client_tcp_protocol_version);
+        read_ok = !!skip_block_in->read();
+    }
 
     if (!read_ok)
         state.read_all_data = true;
@@ -1738,6 +1848,20 @@ void TCPHandler::initProfileEventsBlockOutput(const Block & block)
 }
 
 
+void TCPHandler::initPartialResultBlockOutput(const Block & block)
+{
+    if (!state.partial_result_block_out)
+    {
+        const Settings & query_settings = query_context->getSettingsRef();
+        state.partial_result_block_out = std::make_unique<NativeWriter>(
+            *out,
+            client_tcp_protocol_version,
+            block.cloneEmpty(),
+            !query_settings.low_cardinality_allow_in_native_format);
+    }
+}
+
+
 bool TCPHandler::isQueryCancelled()
 {
     if (state.is_cancelled || state.sent_all_data)
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <unordered_map>
+
 #include <Poco/Net/TCPServerConnection.h>
 
 #include <base/getFQDNOrHostName.h>
@@ -60,6 +62,11 @@ struct QueryState
     InternalProfileEventsQueuePtr profile_queue;
     std::unique_ptr<NativeWriter> profile_events_block_out;
 
+    /// For sending intermediate results of in-progress aggregation
+    /// (see the partial_result_update_duration_ms setting).
+    std::unique_ptr<NativeWriter> partial_result_block_out;
+    UInt64 last_sent_partial_result_version = 0;
+
     /// From where to read data for INSERT.
     std::shared_ptr<ReadBuffer> maybe_compressed_in;
     std::unique_ptr<NativeReader> block_in;
@@ -197,6 +204,10 @@ private:
     /// At the moment, only one ongoing query in the connection is supported at a time.
     QueryState state;
 
+    /// Texts of statements the client registered on this connection, by the 128-bit hash of the
+    /// text. Subsequent Query packets may carry only the hash (plus bound parameter values).
+    std::unordered_map<UInt128, String> prepared_statements;
+
     /// Last block input parameters are saved to be able to receive unexpected data packet sent after exception.
     LastBlockInputParameters last_block_in;
 
@@ -260,12 +271,14 @@ private:
     void sendProfileEvents();
     void sendSelectProfileEvents();
     void sendInsertProfileEvents();
+    void sendPartialResult();
 
     /// Creates state.block_in/block_out for blocks read/write, depending on whether compression is enabled.
     void initBlockInput();
     void initBlockOutput(const Block & block);
     void initLogsBlockOutput(const Block & block);
     void initProfileEventsBlockOutput(const Block & block);
+    void initPartialResultBlockOutput(const Block & block);
 
     bool isQueryCancelled();
 
@@ -0,0 +1,83 @@
+#include <Storages/Cache/ObjectListingCache.h>
+#include <Common/ProfileEvents.h>
+#include <ctime>
+
+namespace ProfileEvents
+{
+    extern const Event ObjectListingCacheHits;
+    extern const Event ObjectListingCacheMisses;
+    extern const Event ObjectListingCacheEvictions;
+}
+
+namespace DB
+{
+
+ObjectListingCache::ObjectListingCache(size_t max_elements_) : max_elements(max_elements_)
+{
+}
+
+void ObjectListingCache::add(const String & prefix_path, ObjectsPtr objects)
+{
+    std::lock_guard lock(mutex);
+
+    time_t now = std::time(nullptr);
+    auto it = data.find(prefix_path);
+    if (it != data.end())
+    {
+        it->second.objects = std::move(objects);
+        it->second.registration_time = now;
+        queue.splice(queue.end(), queue, it->second.iterator);
+        return;
+    }
+
+    auto queue_it = queue.insert(queue.end(), prefix_path);
+    data[prefix_path] = {std::move(objects), now, queue_it};
+    checkOverflow();
+}
+
+void ObjectListingCache::checkOverflow()
+{
+    if (queue.size() <= max_elements)
+        return;
+
+    auto key = queue.front();
+    data.erase(key);
+    queue.pop_front();
+    ProfileEvents::increment(ProfileEvents::ObjectListingCacheEvictions);
+}
+
+ObjectListingCache::ObjectsPtr ObjectListingCache::tryGet(const String & prefix_path, time_t ttl)
+{
+    std::lock_guard lock(mutex);
+    auto it = data.find(prefix_path);
+    if (it == data.end())
+    {
+        ProfileEvents::increment(ProfileEvents::ObjectListingCacheMisses);
+        return nullptr;
+    }
+
+    if (std::time(nullptr) >= it->second.registration_time + ttl)
+    {
+        /// The entry is too stale for this query, and a fresh listing
+        /// is about to be fetched anyway, so drop it right away.
+        ProfileEvents::increment(ProfileEvents::ObjectListingCacheMisses);
+        queue.erase(it->second.iterator);
+        data.erase(it);
+        return nullptr;
+    }
+
+    /// Move key to the end of queue.
+    queue.splice(queue.end(), queue, it->second.iterator);
+
+    ProfileEvents::increment(ProfileEvents::ObjectListingCacheHits);
+    return it->second.objects;
+}
+
+void ObjectListingCache::clear()
+{
+    std::lock_guard lock(mutex);
+    data.clear();
+    queue.clear();
+}
+
+}
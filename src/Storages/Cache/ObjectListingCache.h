@@ -0,0 +1,73 @@
+#pragma once
+
+#include <base/types.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace DB
+{
+
+const size_t DEFAULT_OBJECT_LISTING_CACHE_ENTRIES = 128;
+
+/// Cache of object listings obtained from external object storages (e.g. S3).
+/// It's used to avoid re-listing the same bucket prefix on every query: listing
+/// a prefix with hundreds of thousands of objects may take tens of seconds,
+/// while glob evaluation against an already fetched listing is almost free.
+/// An entry is keyed by a storage-specific path prefix ("host:port/bucket/prefix")
+/// and holds the complete listing of that prefix, so queries with different globs
+/// sharing the prefix reuse one entry.
+/// The allowed staleness is a property of the query, not of the entry, so the TTL
+/// is passed to each lookup; entries older than the TTL are treated as misses and
+/// removed. It implements LRU semantic like SchemaCache: after each access to a key
+/// we move it to the end of the queue, and if the limit of maximum elements is
+/// reached, keys are removed from the beginning of the queue.
+class ObjectListingCache
+{
+public:
+    explicit ObjectListingCache(size_t max_elements_);
+
+    struct ObjectMetadata
+    {
+        String key;
+        size_t size;
+        time_t last_modification_time;
+    };
+
+    using Objects = std::vector<ObjectMetadata>;
+    /// Listings can be large, so they are shared instead of copied;
+    /// a reader may keep using a listing after it was evicted from the cache.
+    using ObjectsPtr = std::shared_ptr<const Objects>;
+
+    /// Add a complete listing of a prefix. An existing entry is replaced:
+    /// the new listing is at least as fresh as the cached one.
+    void add(const String & prefix_path, ObjectsPtr objects);
+
+    /// Returns the cached listing if it was added not earlier than ttl seconds ago, nullptr otherwise.
+    ObjectsPtr tryGet(const String & prefix_path, time_t ttl);
+
+    void clear();
+
+private:
+    void checkOverflow();
+
+    using Queue = std::list<String>;
+    using QueueIterator = Queue::iterator;
+
+    struct Cell
+    {
+        ObjectsPtr objects;
+        time_t registration_time;
+        QueueIterator iterator;
+    };
+
+    Queue queue;
+    std::unordered_map<String, Cell> data;
+
+    size_t max_elements;
+    std::mutex mutex;
+};
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <memory>
+
+#include <Columns/IColumn.h>
+#include <Common/CacheBase.h>
+#include <Common/ProfileEvents.h>
+#include <Common/SipHash.h>
+#include <Interpreters/AggregationCommon.h>
+
+
+namespace ProfileEvents
+{
+    extern const Event ColumnsCacheHits;
+    extern const Event ColumnsCacheMisses;
+}
+
+namespace DB
+{
+
+struct ColumnsCacheCell
+{
+    ColumnPtr column;
+};
+
+/// Estimate of number of bytes in cache for one deserialized column.
+struct ColumnsCacheWeightFunction
+{
+    /// We spent additional bytes on key in hashmap, linked lists, shared pointers, etc ...
+    static constexpr size_t COLUMNS_CACHE_OVERHEAD = 128;
+
+    size_t operator()(const ColumnsCacheCell & cell) const
+    {
+        return cell.column->allocatedBytes() + COLUMNS_CACHE_OVERHEAD;
+    }
+};
+
+
+/** Cache of deserialized columns for StorageMergeTree.
+  * Stores ranges of columns of Wide parts, keyed by the part path, column name and range of granules,
+  * so that repeated reads of hot columns skip both decompression and deserialization.
+  * Parts are immutable, so entries don't need to be invalidated: entries of outdated parts
+  * stop being requested and are evicted by the cache policy.
+  */
+class ColumnsCache : public CacheBase<UInt128, ColumnsCacheCell, UInt128TrivialHash, ColumnsCacheWeightFunction>
+{
+private:
+    using Base = CacheBase<UInt128, ColumnsCacheCell, UInt128TrivialHash, ColumnsCacheWeightFunction>;
+
+public:
+    explicit ColumnsCache(size_t max_size_in_bytes)
+        : Base(max_size_in_bytes) {}
+
+    /// Calculate key from path to part, column name and range of granules.
+    static UInt128 hash(const String & path_to_part, const String & column_name, size_t from_mark, size_t rows_to_read)
+    {
+        UInt128 key;
+
+        SipHash hash;
+        hash.update(path_to_part.data(), path_to_part.size() + 1);
+        hash.update(column_name.data(), column_name.size() + 1);
+        hash.update(from_mark);
+        hash.update(rows_to_read);
+        hash.get128(key);
+
+        return key;
+    }
+
+    MappedPtr get(const Key & key)
+    {
+        auto result = Base::get(key);
+        if (result)
+            ProfileEvents::increment(ProfileEvents::ColumnsCacheHits);
+        else
+            ProfileEvents::increment(ProfileEvents::ColumnsCacheMisses);
+
+        return result;
+    }
+};
+
+using ColumnsCachePtr = std::shared_ptr<ColumnsCache>;
+
+}
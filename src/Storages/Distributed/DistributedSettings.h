@@ -16,6 +16,7 @@ class ASTStorage;
 
 #define LIST_OF_DISTRIBUTED_SETTINGS(M) \
     M(Bool, fsync_after_insert, false, "Do fsync for every inserted. Will decreases performance of inserts (only for async INSERT, i.e. insert_distributed_sync=false)", 0) \
+    M(UInt64, prewarm_connections, 0, "Number of connections per replica to establish in background at table startup, so that the first queries do not pay connection setup on the critical path. 0 - disabled.", 0) \
     M(Bool, fsync_directories, false, "Do fsync for temporary directory (that is used for async INSERT only) after all part operations (writes, renames, etc.).", 0) \
     /** Inserts settings. */ \
     M(UInt64, bytes_to_throw_insert, 0, "If more than this number of compressed bytes will be pending for async INSERT, an exception will be thrown. 0 - do not throw.", 0) \
@@ -185,6 +185,17 @@ public:
     using IndexSizeByName = std::unordered_map<std::string, IndexSize>;
     virtual IndexSizeByName getSecondaryIndexSizes() const { return {}; }
 
+    /// Optional runtime statistics about how effective each secondary index was
+    /// at dropping granules in the queries executed since server start.
+    /// Valid only for MergeTree family.
+    struct SecondaryIndexUsage
+    {
+        size_t granules_tested = 0;
+        size_t granules_dropped = 0;
+    };
+    using SecondaryIndexUsageByName = std::unordered_map<std::string, SecondaryIndexUsage>;
+    virtual SecondaryIndexUsageByName getSecondaryIndexUsage() const { return {}; }
+
     /// Get mutable version (snapshot) of storage metadata. Metadata object is
     /// multiversion, so it can be concurrently changed, but returned copy can be
     /// used without any locks.
@@ -4,7 +4,10 @@
 #include <IO/EmptyReadBuffer.h>
 #include <Storages/Kafka/KafkaConsumer.h>
 #include <Processors/Executors/StreamingFormatExecutor.h>
+#include <Common/CurrentThread.h>
+#include <Common/ThreadPool.h>
 #include <Common/logger_useful.h>
+#include <Common/scope_guard_safe.h>
 #include <Interpreters/Context.h>
 
 #include <Common/ProfileEvents.h>
@@ -93,6 +96,10 @@ Chunk KafkaSource::generateImpl()
         return {};
 
     is_finished = true;
+
+    if (storage.getNumParsingThreads() > 1)
+        return generateImplParallel();
+
     // now it's one-time usage InputStream
     // one block of the needed size (or with desired flush timeout) is formed in one internal iteration
     // otherwise external iteration will reuse that and logic will became even more fuzzy
@@ -281,6 +288,284 @@ Chunk KafkaSource::generateImpl()
     return Chunk(result_block.getColumns(), result_block.rows());
 }
 
+Chunk KafkaSource::generateImplParallel()
+{
+    const size_t num_threads = storage.getNumParsingThreads();
+
+    MutableColumns result_columns = non_virtual_header.cloneEmptyColumns();
+    MutableColumns virtual_columns = virtual_header.cloneEmptyColumns();
+
+    auto put_error_to_stream = handle_error_mode == HandleKafkaErrorMode::STREAM;
+
+    /// One polled message together with everything needed to fill the virtual columns
+    /// after parsing. The buffer points into KafkaConsumer::messages, so the batch must
+    /// be fully parsed before the next poll invalidates it.
+    struct PendingMessage
+    {
+        ReadBufferPtr buf;
+        String topic;
+        String key;
+        int64_t offset;
+        int32_t partition;
+        bool has_timestamp = false;
+        int64_t timestamp_seconds = 0;
+        int64_t timestamp_milliseconds = 0;
+        Array header_names;
+        Array header_values;
+        String payload; /// Saved only when errors are put to the stream.
+        std::optional<String> exception_message;
+        size_t rows = 0;
+    };
+
+    std::vector<PendingMessage> batch;
+    size_t total_rows = 0;
+    size_t failed_poll_attempts = 0;
+
+    auto parse_batch = [&]()
+    {
+        if (batch.empty())
+            return;
+
+        struct Shard
+        {
+            size_t begin = 0;
+            size_t end = 0;
+            MutableColumns columns;
+            std::exception_ptr exception;
+        };
+
+        const size_t num_shards = std::min(num_threads, batch.size());
+        std::vector<Shard> shards(num_shards);
+
+        ThreadPool pool(num_shards);
+        for (size_t shard_idx = 0; shard_idx < num_shards; ++shard_idx)
+        {
+            shards[shard_idx].begin = batch.size() * shard_idx / num_shards;
+            shards[shard_idx].end = batch.size() * (shard_idx + 1) / num_shards;
+
+            pool.scheduleOrThrowOnError([&, shard_idx, thread_group = CurrentThread::getGroup()]
+            {
+                SCOPE_EXIT_SAFE(
+                    if (thread_group)
+                        CurrentThread::detachQueryIfNotDetached();
+                );
+                if (thread_group)
+                    CurrentThread::attachToIfDetached(thread_group);
+
+                auto & shard = shards[shard_idx];
+                try
+                {
+                    EmptyReadBuffer empty_buf;
+                    auto input_format = FormatFactory::instance().getInputFormat(
+                        storage.getFormatName(), empty_buf, non_virtual_header, context, max_block_size);
+
+                    size_t shard_rows = 0;
+                    PendingMessage * current_message = nullptr;
+
+                    auto on_error = [&](const MutableColumns & shard_columns, Exception & e)
+                    {
+                        ProfileEvents::increment(ProfileEvents::KafkaMessagesFailed);
+
+                        if (put_error_to_stream)
+                        {
+                            current_message->exception_message = e.message();
+                            for (const auto & column : shard_columns)
+                            {
+                                // read_kafka_message could already push some rows to result_columns
+                                // before exception, we need to fix it.
+                                auto cur_rows = column->size();
+                                if (cur_rows > shard_rows)
+                                    column->popBack(cur_rows - shard_rows);
+
+                                // all data columns will get default value in case of error
+                                column->insertDefault();
+                            }
+
+                            return 1;
+                        }
+                        else
+                        {
+                            e.addMessage("while parsing Kafka message (topic: {}, partition: {}, offset: {})'",
+                                current_message->topic, current_message->partition, current_message->offset);
+                            throw;
+                        }
+                    };
+
+                    StreamingFormatExecutor executor(non_virtual_header, input_format, std::move(on_error));
+
+                    for (size_t i = shard.begin; i < shard.end; ++i)
+                    {
+                        current_message = &batch[i];
+                        current_message->rows = executor.execute(*current_message->buf);
+                        shard_rows += current_message->rows;
+                    }
+
+                    shard.columns = executor.getResultColumns();
+                }
+                catch (...)
+                {
+                    shard.exception = std::current_exception();
+                }
+            });
+        }
+        pool.wait();
+
+        /// Rethrow in the message order, so that the reported error does not depend
+        /// on which shard happened to fail first.
+        for (const auto & shard : shards)
+            if (shard.exception)
+                std::rethrow_exception(shard.exception);
+
+        for (const auto & shard : shards)
+            for (size_t i = 0; i < result_columns.size(); ++i)
+                result_columns[i]->insertRangeFrom(*shard.columns[i], 0, shard.columns[i]->size());
+
+        for (const auto & message : batch)
+        {
+            if (message.rows)
+                ProfileEvents::increment(ProfileEvents::KafkaRowsRead, message.rows);
+
+            for (size_t i = 0; i < message.rows; ++i)
+            {
+                virtual_columns[0]->insert(message.topic);
+                virtual_columns[1]->insert(message.key);
+                virtual_columns[2]->insert(message.offset);
+                virtual_columns[3]->insert(message.partition);
+                if (message.has_timestamp)
+                {
+                    virtual_columns[4]->insert(message.timestamp_seconds);
+                    virtual_columns[5]->insert(DecimalField<Decimal64>(message.timestamp_milliseconds, 3));
+                }
+                else
+                {
+                    virtual_columns[4]->insertDefault();
+                    virtual_columns[5]->insertDefault();
+                }
+                virtual_columns[6]->insert(message.header_names);
+                virtual_columns[7]->insert(message.header_values);
+                if (put_error_to_stream)
+                {
+                    if (message.exception_message)
+                    {
+                        virtual_columns[8]->insert(message.payload);
+                        virtual_columns[9]->insert(*message.exception_message);
+                    }
+                    else
+                    {
+                        virtual_columns[8]->insertDefault();
+                        virtual_columns[9]->insertDefault();
+                    }
+                }
+            }
+
+            total_rows += message.rows;
+        }
+
+        batch.clear();
+    };
+
+    while (true)
+    {
+        if (auto buf = consumer->consume())
+        {
+            ProfileEvents::increment(ProfileEvents::KafkaMessagesRead);
+
+            /// The offset is only stored here; it becomes visible to the broker with the
+            /// commit() after the whole block is flushed, so storing it before the message
+            /// is parsed does not weaken the delivery guarantees.
+            consumer->storeLastReadMessageOffset();
+
+            PendingMessage message;
+            message.buf = buf;
+            message.topic = consumer->currentTopic();
+            message.key = consumer->currentKey();
+            message.offset = consumer->currentOffset();
+            message.partition = consumer->currentPartition();
+
+            if (auto timestamp_raw = consumer->currentTimestamp())
+            {
+                auto ts = timestamp_raw->get_timestamp();
+                message.has_timestamp = true;
+                message.timestamp_seconds = std::chrono::duration_cast<std::chrono::seconds>(ts).count();
+                message.timestamp_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(ts).count();
+            }
+
+            const auto & header_list = consumer->currentHeaderList();
+            if (!header_list.empty())
+            {
+                message.header_names.reserve(header_list.size());
+                message.header_values.reserve(header_list.size());
+                for (const auto & header : header_list)
+                {
+                    message.header_names.emplace_back(header.get_name());
+                    message.header_values.emplace_back(static_cast<std::string>(header.get_value()));
+                }
+            }
+
+            if (put_error_to_stream)
+                message.payload = consumer->currentPayload();
+
+            batch.push_back(std::move(message));
+        }
+        else if (consumer->polledDataUnusable())
+        {
+            /// After a rebalance the pending buffers may already dangle.
+            batch.clear();
+            break;
+        }
+        else if (consumer->isStalled())
+        {
+            ++failed_poll_attempts;
+        }
+        else
+        {
+            // We came here in case of tombstone (or sometimes zero-length) messages, and it is not something abnormal
+            // TODO: it seems like in case of put_error_to_stream=true we may need to process those differently
+            // currently we just skip them with note in logs.
+            consumer->storeLastReadMessageOffset();
+            LOG_DEBUG(log, "Parsing of message (topic: {}, partition: {}, offset: {}) return no rows.", consumer->currentTopic(), consumer->currentPartition(), consumer->currentOffset());
+        }
+
+        if (!consumer->hasMorePolledMessages())
+        {
+            /// The next poll would invalidate the payloads the pending buffers point into.
+            parse_batch();
+
+            if (total_rows >= max_block_size || !checkTimeLimit() || failed_poll_attempts >= MAX_FAILED_POLL_ATTEMPTS)
+                break;
+        }
+    }
+
+    if (total_rows == 0)
+    {
+        return {};
+    }
+    else if (consumer->polledDataUnusable())
+    {
+        // the rows were counted already before by KafkaRowsRead,
+        // so let's count the rows we ignore separately
+        // (they will be retried after the rebalance)
+        ProfileEvents::increment(ProfileEvents::KafkaRowsRejected, total_rows);
+        return {};
+    }
+
+    auto result_block  = non_virtual_header.cloneWithColumns(std::move(result_columns));
+    auto virtual_block = virtual_header.cloneWithColumns(std::move(virtual_columns));
+
+    for (const auto & column : virtual_block.getColumnsWithTypeAndName())
+        result_block.insert(column);
+
+    auto converting_dag = ActionsDAG::makeConvertingActions(
+        result_block.cloneEmpty().getColumnsWithTypeAndName(),
+        getPort().getHeader().getColumnsWithTypeAndName(),
+        ActionsDAG::MatchColumnsMode::Name);
+
+    auto converting_actions = std::make_shared<ExpressionActions>(std::move(converting_dag));
+    converting_actions->execute(result_block);
+
+    return Chunk(result_block.getColumns(), result_block.rows());
+}
+
 Chunk KafkaSource::generate()
 {
     auto chunk = generateImpl();
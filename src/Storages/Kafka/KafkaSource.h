@@ -59,6 +59,10 @@ private:
     bool checkTimeLimit() const;
 
     Chunk generateImpl();
+    /// Used instead of generateImpl() when kafka_num_parsing_threads > 1:
+    /// messages are still polled and offsets stored on this thread, but each
+    /// polled batch is parsed by a pool of threads.
+    Chunk generateImplParallel();
 };
 
 }
@@ -849,6 +849,7 @@ void registerStorageKafka(StorageFactory & factory)
             CHECK_KAFKA_STORAGE_ARGUMENT(15, kafka_handle_error_mode, 0)
             CHECK_KAFKA_STORAGE_ARGUMENT(16, kafka_commit_on_select, 0)
             CHECK_KAFKA_STORAGE_ARGUMENT(17, kafka_max_rows_per_message, 0)
+            CHECK_KAFKA_STORAGE_ARGUMENT(18, kafka_num_parsing_threads, 0)
         }
 
         #undef CHECK_KAFKA_STORAGE_ARGUMENT
@@ -883,6 +884,13 @@ void registerStorageKafka(StorageFactory & factory)
             throw Exception(ErrorCodes::BAD_ARGUMENTS, "kafka_poll_max_batch_size can not be lower than 1");
         }
 
+        if (kafka_settings->kafka_num_parsing_threads.value > max_consumers)
+        {
+            throw Exception(ErrorCodes::BAD_ARGUMENTS, "kafka_num_parsing_threads can not be bigger than {}. "
+                            "Parsing threads of all consumers compete for the same CPU cores, "
+                            "so using a lot of them brings no additional speedup.", max_consumers);
+        }
+
         return std::make_shared<StorageKafka>(args.table_id, args.getContext(), args.columns, std::move(kafka_settings), collection_name);
     };
 
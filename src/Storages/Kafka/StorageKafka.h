@@ -74,6 +74,7 @@ public:
     NamesAndTypesList getVirtuals() const override;
     Names getVirtualColumnNames() const;
     HandleKafkaErrorMode getHandleKafkaErrorMode() const { return kafka_settings->kafka_handle_error_mode; }
+    size_t getNumParsingThreads() const { return kafka_settings->kafka_num_parsing_threads.value; }
 
 private:
     // Configuration and state
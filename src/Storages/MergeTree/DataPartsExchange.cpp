@@ -5,6 +5,7 @@
 #include <Formats/NativeWriter.h>
 #include <Disks/SingleDiskVolume.h>
 #include <Disks/createVolume.h>
+#include <IO/AsynchronousWriteBuffer.h>
 #include <IO/HTTPCommon.h>
 #include <IO/S3Common.h>
 #include <Server/HTTP/HTMLForm.h>
@@ -50,6 +51,7 @@ namespace ErrorCodes
     extern const int S3_ERROR;
     extern const int INCORRECT_PART_TYPE;
     extern const int ZERO_COPY_REPLICATION_ERROR;
+    extern const int TOO_SLOW;
 }
 
 namespace DataPartsExchange
@@ -73,13 +75,21 @@ std::string getEndpointId(const std::string & node_id)
     return "DataPartsExchange:" + node_id;
 }
 
-/// Simple functor for tracking fetch progress in system.replicated_fetches table.
+/// Simple functor for tracking fetch progress in system.replicated_fetches table
+/// and for cancelling fetches from sources which turned out to be too slow.
 struct ReplicatedFetchReadCallback
 {
     ReplicatedFetchList::Entry & replicated_fetch_entry;
+    UInt64 min_bytes_per_second;
+    UInt64 timeout_before_checking_speed_seconds;
 
-    explicit ReplicatedFetchReadCallback(ReplicatedFetchList::Entry & replicated_fetch_entry_)
+    ReplicatedFetchReadCallback(
+        ReplicatedFetchList::Entry & replicated_fetch_entry_,
+        UInt64 min_bytes_per_second_,
+        UInt64 timeout_before_checking_speed_seconds_)
         : replicated_fetch_entry(replicated_fetch_entry_)
+        , min_bytes_per_second(min_bytes_per_second_)
+        , timeout_before_checking_speed_seconds(timeout_before_checking_speed_seconds_)
     {}
 
     void operator() (size_t bytes_count)
@@ -94,6 +104,24 @@ struct ReplicatedFetchReadCallback
                     static_cast<double>(bytes_count) / replicated_fetch_entry->total_size_bytes_compressed,
                     std::memory_order_relaxed);
         }
+
+        /// A source replica which streams the part too slowly is dropped early,
+        /// so the fetch can be retried from another replica instead of inflating the replication lag.
+        if (min_bytes_per_second)
+        {
+            double elapsed_seconds = replicated_fetch_entry->watch.elapsedSeconds();
+            if (elapsed_seconds >= timeout_before_checking_speed_seconds
+                && bytes_count < min_bytes_per_second * elapsed_seconds)
+                throw Exception(
+                    ErrorCodes::TOO_SLOW,
+                    "Cancelling fetch of part {} from {}: read {} bytes in {:.2f} seconds, "
+                    "which is slower than the minimum of {} bytes per second",
+                    replicated_fetch_entry->result_part_name,
+                    replicated_fetch_entry->source_replica_path,
+                    bytes_count,
+                    elapsed_seconds,
+                    min_bytes_per_second);
+        }
     }
 };
 
@@ -534,8 +562,15 @@ MergeTreeData::MutableDataPartPtr Fetcher::fetchSelectedPart(
         nullptr,
         timeouts,
         creds,
-        DBMS_DEFAULT_BUFFER_SIZE,
         0, /* no redirects */
+        DBMS_DEFAULT_BUFFER_SIZE,
+        ReadSettings{},
+        HTTPHeaderEntries{},
+        ReadWriteBufferFromHTTP::Range{},
+        nullptr,
+        /* delay_initialization */ false,
+        /* use_external_buffer */ false,
+        /* skip_not_found_url */ false,
         static_cast<uint64_t>(data_settings->replicated_max_parallel_fetches_for_host));
 
     int server_protocol_version = parse<int>(in->getResponseCookie("server_protocol_version", "0"));
@@ -680,7 +715,10 @@ MergeTreeData::MutableDataPartPtr Fetcher::fetchSelectedPart(
         part_info.partition_id, part_name, new_part_path,
         replica_path, uri, to_detached, sum_files_size);
 
-    in->setNextCallback(ReplicatedFetchReadCallback(*entry));
+    in->setNextCallback(ReplicatedFetchReadCallback(
+        *entry,
+        data_settings->replicated_fetches_min_bytes_per_second,
+        data_settings->replicated_fetches_timeout_before_checking_speed.totalSeconds()));
 
     if (part_type == "InMemory")
     {
@@ -823,7 +861,8 @@ void Fetcher::downloadBaseOrProjectionPartToDisk(
     bool sync,
     PooledReadWriteBufferFromHTTP & in,
     MergeTreeData::DataPart::Checksums & checksums,
-    ThrottlerPtr throttler) const
+    ThrottlerPtr throttler,
+    bool defer_checksum_verification) const
 {
     size_t files;
     readBinary(files, in);
@@ -848,8 +887,28 @@ void Fetcher::downloadBaseOrProjectionPartToDisk(
                 absolute_file_path, data_part_storage->getRelativePath());
 
         written_files.emplace_back(data_part_storage->writeFile(file_name, std::min<UInt64>(file_size, DBMS_DEFAULT_BUFFER_SIZE), {}));
-        HashingWriteBuffer hashing_out(*written_files.back());
-        copyDataWithThrottler(in, hashing_out, file_size, blocker.getCounter(), throttler);
+
+        /// For large files flush to disk in a background thread, so that draining the socket
+        /// and hashing overlap with disk writes instead of alternating with them.
+        std::unique_ptr<AsynchronousWriteBuffer> async_out;
+        WriteBuffer * file_out = written_files.back().get();
+        if (file_size > DBMS_DEFAULT_BUFFER_SIZE)
+        {
+            async_out = std::make_unique<AsynchronousWriteBuffer>(*file_out);
+            file_out = async_out.get();
+        }
+
+        /// If verification is deferred, the data is written as is, and the hash sent by the
+        /// remote replica is trusted. The caller is responsible for scheduling a background
+        /// check of the part.
+        std::optional<HashingWriteBuffer> hashing_out;
+        if (!defer_checksum_verification)
+        {
+            hashing_out.emplace(*file_out);
+            file_out = &*hashing_out;
+        }
+
+        copyDataWithThrottler(in, *file_out, file_size, blocker.getCounter(), throttler);
 
         if (blocker.isCancelled())
         {
@@ -862,12 +921,15 @@ void Fetcher::downloadBaseOrProjectionPartToDisk(
         MergeTreeDataPartChecksum::uint128 expected_hash;
         readPODBinary(expected_hash, in);
 
-        if (expected_hash != hashing_out.getHash())
+        if (hashing_out && expected_hash != hashing_out->getHash())
             throw Exception(ErrorCodes::CHECKSUM_DOESNT_MATCH,
                 "Checksum mismatch for file {} transferred from {}",
                 (fs::path(data_part_storage->getFullPath()) / file_name).string(),
                 replica_path);
 
+        if (async_out)
+            async_out->finalize();
+
         if (file_name != "checksums.txt" &&
             file_name != "columns.txt" &&
             file_name != IMergeTreeDataPart::DEFAULT_COMPRESSION_CODEC_FILE_NAME)
@@ -939,6 +1001,11 @@ MergeTreeData::MutableDataPartPtr Fetcher::downloadPartToDisk(
 
     CurrentMetrics::Increment metric_increment{CurrentMetrics::ReplicatedFetch};
 
+    /// With deferred verification the part is activated after size checks only, and the
+    /// caller is responsible for scheduling a background check of the part.
+    bool defer_checksum_verification = data_settings->replicated_fetches_defer_checksum_verification
+        && !to_detached && !disk->supportZeroCopyReplication();
+
     try
     {
         for (size_t i = 0; i < projections; ++i)
@@ -950,13 +1017,13 @@ MergeTreeData::MutableDataPartPtr Fetcher::downloadPartToDisk(
             auto projection_part_storage = data_part_storage->getProjection(projection_name + ".proj");
             projection_part_storage->createDirectories();
             downloadBaseOrProjectionPartToDisk(
-                replica_path, projection_part_storage, sync, in, projection_checksum, throttler);
+                replica_path, projection_part_storage, sync, in, projection_checksum, throttler, defer_checksum_verification);
             checksums.addFile(
                 projection_name + ".proj", projection_checksum.getTotalSizeOnDisk(), projection_checksum.getTotalChecksumUInt128());
         }
 
         // Download the base part
-        downloadBaseOrProjectionPartToDisk(replica_path, data_part_storage, sync, in, checksums, throttler);
+        downloadBaseOrProjectionPartToDisk(replica_path, data_part_storage, sync, in, checksums, throttler, defer_checksum_verification);
     }
     catch (const Exception & e)
     {
@@ -99,7 +99,8 @@ private:
         bool sync,
         PooledReadWriteBufferFromHTTP & in,
         MergeTreeData::DataPart::Checksums & checksums,
-        ThrottlerPtr throttler) const;
+        ThrottlerPtr throttler,
+        bool defer_checksum_verification) const;
 
     void downloadBasePartOrProjectionPartToDiskRemoteMeta(
         const String & replica_path,
@@ -4,6 +4,7 @@
 #include <DataTypes/DataTypeArray.h>
 #include <DataTypes/DataTypeString.h>
 #include <DataTypes/DataTypesNumber.h>
+#include <IO/BufferWithOwnMemory.h>
 #include <IO/ReadBufferFromFile.h>
 #include <IO/ReadHelpers.h>
 #include <IO/WriteBufferFromFile.h>
@@ -72,26 +73,60 @@ void GinIndexPostingsBuilder::add(UInt32 row_id)
     }
 }
 
+namespace
+{
+
+/// Result of deserializing a frozen-format postings list: owns the aligned memory with the
+/// serialized bitmap blob and a read-only bitmap view which queries the blob in place,
+/// without decoding the bitmap containers into heap objects.
+struct GinIndexPostingsFrozenList
+{
+    /// Frozen views may only be created over memory with this alignment.
+    static constexpr size_t FROZEN_VIEW_ALIGNMENT = 32;
+
+    Memory<> blob;
+    const GinIndexPostingsList view;
+
+    GinIndexPostingsFrozenList(ReadBuffer & buffer, size_t byte_size)
+        : blob(byte_size, FROZEN_VIEW_ALIGNMENT)
+        , view(readAndCreateView(buffer, blob, byte_size))
+    {
+    }
+
+private:
+    static const GinIndexPostingsList readAndCreateView(ReadBuffer & buffer, Memory<> & blob, size_t byte_size)
+    {
+        buffer.readStrict(blob.data(), byte_size);
+        return GinIndexPostingsList::frozenView(blob.data(), byte_size);
+    }
+};
+
+}
+
 UInt64 GinIndexPostingsBuilder::serialize(WriteBuffer & buffer) const
 {
     UInt64 written_bytes = 0;
-    buffer.write(rowid_lst_length);
-    written_bytes += 1;
 
     if (useRoaring())
     {
-        auto size = rowid_bitmap.getSizeInBytes();
+        buffer.write(USES_FROZEN_BIT_MAP);
+        written_bytes += 1;
+
+        auto size = rowid_bitmap.getFrozenSizeInBytes();
 
         writeVarUInt(size, buffer);
         written_bytes += getLengthOfVarUInt(size);
 
         auto buf = std::make_unique<char[]>(size);
-        rowid_bitmap.write(buf.get());
+        rowid_bitmap.writeFrozen(buf.get());
         buffer.write(buf.get(), size);
         written_bytes += size;
     }
     else
     {
+        buffer.write(rowid_lst_length);
+        written_bytes += 1;
+
         for (size_t i = 0; i <  rowid_lst_length; ++i)
         {
             writeVarUInt(rowid_lst[i], buffer);
@@ -107,8 +142,20 @@ GinIndexPostingsListPtr GinIndexPostingsBuilder::deserialize(ReadBuffer & buffer
     UInt8 postings_list_size = 0;
     buffer.readStrict(reinterpret_cast<char &>(postings_list_size));
 
-    if (postings_list_size == USES_BIT_MAP)
+    if (postings_list_size == USES_FROZEN_BIT_MAP)
+    {
+        size_t size = 0;
+        readVarUInt(size, buffer);
+
+        auto frozen_list = std::make_shared<GinIndexPostingsFrozenList>(buffer, size);
+
+        /// The returned pointer aliases the view and keeps the blob alive. The view is immutable;
+        /// all consumers of postings lists perform only read-only operations on them.
+        return GinIndexPostingsListPtr(frozen_list, const_cast<GinIndexPostingsList *>(&frozen_list->view));
+    }
+    else if (postings_list_size == USES_BIT_MAP)
     {
+        /// Standard-format bitmap written by version v0 stores: need to be decoded into a heap object.
         size_t size = 0;
         readVarUInt(size, buffer);
         auto buf = std::make_unique<char[]>(size);
@@ -76,6 +76,11 @@ private:
     /// Indicates that roaring bitmap is used, see 'rowid_lst_length'.
     static constexpr UInt8 USES_BIT_MAP = 0xFF;
 
+    /// Serialization flag: the postings list is a roaring bitmap in frozen format.
+    /// Unlike USES_BIT_MAP (written by version v0 stores), frozen bitmaps are not decoded
+    /// into heap objects on reading but are queried in place in the serialized blob.
+    static constexpr UInt8 USES_FROZEN_BIT_MAP = 0xFE;
+
     /// Clear the postings list and reset it with MATCHALL flags when the size of the postings list is beyond the limit
     UInt64 size_limit;
 
@@ -207,10 +212,10 @@ private:
     enum class Format : uint8_t
     {
         v0 = 0,
-        v1 = 1, /// Initial version
+        v1 = 1, /// Bitmap postings lists are serialized in frozen format and queried in place
     };
 
-    static constexpr auto CURRENT_GIN_FILE_FORMAT_VERSION = Format::v0;
+    static constexpr auto CURRENT_GIN_FILE_FORMAT_VERSION = Format::v1;
 };
 
 using GinIndexStorePtr = std::shared_ptr<GinIndexStore>;
@@ -33,6 +33,12 @@ public:
     virtual void onCompleted() = 0;
     virtual StorageID getStorageID() = 0;
     virtual UInt64 getPriority() = 0;
+
+    /// How many bytes the task has read and written so far (0 if unknown).
+    /// The executor charges the steps of a task by this value, so a task which
+    /// has already consumed a lot of I/O is scheduled after lighter ones.
+    virtual UInt64 getProcessedBytes() const { return 0; }
+
     virtual ~IExecutableTask() = default;
 };
 
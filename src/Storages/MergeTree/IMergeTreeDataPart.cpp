@@ -551,8 +551,54 @@ void IMergeTreeDataPart::removeIfNeeded()
 }
 
 
+const IMergeTreeDataPart::Index & IMergeTreeDataPart::getIndex() const
+{
+    std::lock_guard lock(index_mutex);
+    if (!index_loaded)
+    {
+        /// Memory for the index is shared between queries - not belong to the query itself.
+        MemoryTrackerBlockerInThread temporarily_disable_memory_tracker;
+        loadIndex();
+        index_loaded = true;
+    }
+    index_last_used = time(nullptr);
+    return index;
+}
+
+void IMergeTreeDataPart::setIndex(Index index_)
+{
+    std::lock_guard lock(index_mutex);
+    if (index_loaded)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "The index of data part can be set only once");
+    index = std::move(index_);
+    index_loaded = true;
+    index_last_used = time(nullptr);
+}
+
+bool IMergeTreeDataPart::unloadIndexIfNotUsedFor(time_t timeout_seconds) const
+{
+    std::lock_guard lock(index_mutex);
+
+    if (!index_loaded || index.empty())
+        return false;
+
+    /// Only indexes which can be reloaded from disk may be unloaded.
+    if (!isStoredOnDisk()
+        || (!checksums.files.contains("primary" + getIndexExtension(false))
+            && !checksums.files.contains("primary" + getIndexExtension(true))))
+        return false;
+
+    if (index_last_used + timeout_seconds > time(nullptr))
+        return false;
+
+    index.clear();
+    index_loaded = false;
+    return true;
+}
+
 UInt64 IMergeTreeDataPart::getIndexSizeInBytes() const
 {
+    std::lock_guard lock(index_mutex);
     UInt64 res = 0;
     for (const ColumnPtr & column : index)
         res += column->byteSize();
@@ -561,6 +607,7 @@ UInt64 IMergeTreeDataPart::getIndexSizeInBytes() const
 
 UInt64 IMergeTreeDataPart::getIndexSizeInAllocatedBytes() const
 {
+    std::lock_guard lock(index_mutex);
     UInt64 res = 0;
     for (const ColumnPtr & column : index)
         res += column->allocatedBytes();
@@ -650,7 +697,8 @@ void IMergeTreeDataPart::loadColumnsChecksumsIndexes(bool require_columns_checks
         loadChecksums(require_columns_checksums);
         loadIndexGranularity();
         calculateColumnsAndSecondaryIndicesSizesOnDisk();
-        loadIndex(); /// Must be called after loadIndexGranularity as it uses the value of `index_granularity`
+        if (!storage.getSettings()->primary_key_lazy_load)
+            getIndex(); /// Must be called after loadIndexGranularity as it uses the value of `index_granularity`
         loadRowsCount(); /// Must be called after loadIndexGranularity() as it uses the value of `index_granularity`.
         loadPartitionAndMinMaxIndex();
         if (!parent_part)
@@ -686,6 +734,7 @@ void IMergeTreeDataPart::appendFilesOfColumnsChecksumsIndexes(Strings & files, b
         appendFilesOfRowsCount(files);
         appendFilesOfPartitionAndMinMaxIndex(files);
         appendFilesOfTTLInfos(files);
+        appendFilesOfColumnStatistics(files);
         appendFilesOfDefaultCompressionCodec(files);
     }
 
@@ -728,7 +777,7 @@ void IMergeTreeDataPart::appendFilesOfIndexGranularity(Strings & /* files */) co
 {
 }
 
-void IMergeTreeDataPart::loadIndex()
+void IMergeTreeDataPart::loadIndex() const
 {
     /// It can be empty in case of mutations
     if (!index_granularity.isInitialized())
@@ -1266,6 +1315,25 @@ void IMergeTreeDataPart::appendFilesOfTTLInfos(Strings & files)
     files.push_back("ttl.txt");
 }
 
+const MergeTreeColumnStatistics & IMergeTreeDataPart::getColumnStatistics() const
+{
+    std::call_once(column_statistics_loaded, [this]
+    {
+        if (!metadata_manager->exists(MergeTreeColumnStatistics::FILE_NAME))
+            return;
+
+        auto in = metadata_manager->read(MergeTreeColumnStatistics::FILE_NAME);
+        column_statistics.read(*in);
+    });
+
+    return column_statistics;
+}
+
+void IMergeTreeDataPart::appendFilesOfColumnStatistics(Strings & files)
+{
+    files.push_back(MergeTreeColumnStatistics::FILE_NAME);
+}
+
 void IMergeTreeDataPart::loadUUID()
 {
     bool exists = metadata_manager->exists(UUID_FILE_NAME);
@@ -1335,6 +1403,29 @@ void IMergeTreeDataPart::loadColumns(bool require)
     setColumns(loaded_columns, infos);
 }
 
+bool IMergeTreeDataPart::isDeduplicatedBy(const Names & columns) const
+{
+    if (!deduplicated_by_columns)
+        return false;
+
+    /// Deduplication by all columns subsumes a previous deduplication by any set of columns.
+    if (columns.empty())
+        return true;
+
+    /// The part was deduplicated by all columns, but only a subset is requested now:
+    /// rows distinct in all columns may still collide on the subset.
+    if (deduplicated_by_columns->empty())
+        return false;
+
+    /// Rows equal in `columns` are equal in any subset of them, so a previous deduplication
+    /// by a subset has already removed everything the requested one could remove.
+    for (const auto & column : *deduplicated_by_columns)
+        if (std::find(columns.begin(), columns.end(), column) == columns.end())
+            return false;
+
+    return true;
+}
+
 /// Project part / part with project parts / compact part doesn't support LWD.
 bool IMergeTreeDataPart::supportLightweightDeleteMutate() const
 {
@@ -15,6 +15,7 @@
 #include <Storages/MergeTree/MergeTreePartition.h>
 #include <Storages/MergeTree/MergeTreeDataPartChecksum.h>
 #include <Storages/MergeTree/MergeTreeDataPartTTLInfo.h>
+#include <Storages/MergeTree/MergeTreeColumnStatistics.h>
 #include <Storages/MergeTree/MergeTreeIOSettings.h>
 #include <Storages/MergeTree/KeyCondition.h>
 #include <Storages/ColumnsDescription.h>
@@ -22,6 +23,8 @@
 #include <DataTypes/Serializations/SerializationInfo.h>
 #include <Storages/MergeTree/IPartMetadataManager.h>
 
+#include <mutex>
+
 
 namespace zkutil
 {
@@ -168,6 +171,11 @@ public:
     void loadColumnsChecksumsIndexes(bool require_columns_checksums, bool check_consistency);
     void appendFilesOfColumnsChecksumsIndexes(Strings & files, bool include_projection = false) const;
 
+    /// Load marks of all columns of the part into the mark cache. Used to warm up the cache for freshly
+    /// fetched parts so that replicas which mostly receive data via fetches (e.g. hot standbys) can serve
+    /// queries at full speed right after a failover (see setting replicated_fetches_populate_mark_cache).
+    virtual void loadMarksToCache(MarkCache * /* mark_cache */) const {}
+
     String getMarksFileExtension() const { return index_granularity_info.mark_type.getFileExtension(); }
 
     /// Generate the new name for this part according to `new_part_info` and min/max dates from the old name.
@@ -227,6 +235,17 @@ public:
     /// Frozen by ALTER TABLE ... FREEZE ... It is used for information purposes in system.parts table.
     mutable std::atomic<bool> is_frozen {false};
 
+    /// Set if the part is the result of a merge with DEDUPLICATE: contains the columns the rows
+    /// were deduplicated by, empty Names means all columns. In-memory only (does not survive
+    /// server restart) and valid forever after, because the content of a part never changes.
+    /// It is set before the part is committed to the working set and may be read afterwards,
+    /// so no synchronization is needed.
+    std::optional<Names> deduplicated_by_columns;
+
+    /// Whether a new merge with DEDUPLICATE BY `columns` (empty means all columns) is a proven
+    /// no-op for this part, i.e. the part was already deduplicated by a subset of `columns`.
+    bool isDeduplicatedBy(const Names & columns) const;
+
     /// Flag for keep S3 data when zero-copy replication over S3 turned on.
     mutable bool force_keep_shared_data = false;
 
@@ -235,6 +254,12 @@ public:
 
     mutable TTLInfos ttl_infos;
 
+    /// Column statistics (statistics.bin) are written when the enable_column_statistics
+    /// merge tree setting is on. Unlike TTL infos they are loaded lazily on first access,
+    /// since the sketches cost a few KiB per column and most parts are never asked.
+    /// Returns an empty object if the part has no statistics.
+    const MergeTreeColumnStatistics & getColumnStatistics() const;
+
     /// Current state of the part. If the part is in working set already, it should be accessed via data_parts mutex
     void setState(MergeTreeDataPartState new_state) const;
     MergeTreeDataPartState getState() const;
@@ -259,10 +284,17 @@ public:
     void assertState(const std::initializer_list<MergeTreeDataPartState> & affordable_states) const;
 
     /// Primary key (correspond to primary.idx file).
-    /// Always loaded in RAM. Contains each index_granularity-th value of primary key tuple.
+    /// Contains each index_granularity-th value of primary key tuple.
+    /// Loaded into RAM on table initialization or, if primary_key_lazy_load is enabled, on first use.
     /// Note that marks (also correspond to primary key) is not always in RAM, but cached. See MarkCache.h.
     using Index = Columns;
-    Index index;
+    const Index & getIndex() const;
+    void setIndex(Index index_);
+
+    /// Unload the lazily loaded primary index from memory if it was not used for `timeout_seconds`.
+    /// It is reloaded from disk on the next getIndex() call. Returns true if the index was unloaded.
+    /// Called by the background cleanup when the primary_key_unload_timeout setting is enabled.
+    bool unloadIndexIfNotUsedFor(time_t timeout_seconds) const;
 
     MergeTreePartition partition;
 
@@ -556,8 +588,16 @@ private:
 
     virtual void appendFilesOfIndexGranularity(Strings & files) const;
 
-    /// Loads index file.
-    void loadIndex();
+    /// Primary key index. Set once by loadIndex() or setIndex(), empty if the table has no primary key.
+    /// Access it through getIndex(), under primary_key_lazy_load it is read from disk on first use.
+    mutable std::mutex index_mutex;
+    mutable Index index;
+    mutable bool index_loaded = false;
+    /// When the index was last accessed through getIndex(), for unloadIndexIfNotUsedFor().
+    mutable time_t index_last_used = 0;
+
+    /// Loads index file. Must be called under index_mutex.
+    void loadIndex() const;
 
     void appendFilesOfIndex(Strings & files) const;
 
@@ -572,6 +612,12 @@ private:
 
     static void appendFilesOfTTLInfos(Strings & files);
 
+    /// Lazily filled by getColumnStatistics(); stays empty if the part has no statistics.bin.
+    mutable MergeTreeColumnStatistics column_statistics;
+    mutable std::once_flag column_statistics_loaded;
+
+    static void appendFilesOfColumnStatistics(Strings & files);
+
     void loadPartitionAndMinMaxIndex();
 
     void calculateColumnsSizesOnDisk();
@@ -39,6 +39,11 @@ public:
 
     virtual bool canReadIncompleteGranules() const = 0;
 
+    /// Request reading of the beginning of all mark ranges in advance, right after the read task
+    /// is assigned and before the first readRows() call. For readers with asynchronous buffers
+    /// this overlaps network latency of cold reads with processing of the previous reading steps.
+    virtual void prefetchBeginOfRange() {}
+
     virtual ~IMergeTreeReader() = default;
 
     const ValueSizeMap & getAvgValueSizeHints() const;
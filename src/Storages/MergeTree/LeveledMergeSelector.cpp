@@ -0,0 +1,153 @@
+#include <Storages/MergeTree/LeveledMergeSelector.h>
+
+#include <cmath>
+
+
+namespace DB
+{
+
+namespace
+{
+
+/** Estimates best set of parts to merge within passed alternatives.
+  * Lower level is better (the merge is cheaper), ties are broken by minimal sum of sizes.
+  */
+struct Estimator
+{
+    using Iterator = LeveledMergeSelector::PartsRange::const_iterator;
+
+    void consider(Iterator begin, Iterator end, size_t sum_size, size_t level)
+    {
+        if (!has_best || level < best_level || (level == best_level && sum_size < best_size))
+        {
+            has_best = true;
+            best_level = level;
+            best_size = sum_size;
+            best_begin = begin;
+            best_end = end;
+        }
+    }
+
+    LeveledMergeSelector::PartsRange getBest() const
+    {
+        if (!has_best)
+            return {};
+        return LeveledMergeSelector::PartsRange(best_begin, best_end);
+    }
+
+    bool has_best = false;
+    size_t best_level = 0;
+    size_t best_size = 0;
+    Iterator best_begin {};
+    Iterator best_end {};
+};
+
+
+size_t levelBySize(size_t size, const LeveledMergeSelector::Settings & settings)
+{
+    size_t level = 0;
+    size_t level_upper_bound = settings.base_bytes;
+
+    while (size >= level_upper_bound)
+    {
+        ++level;
+        level_upper_bound *= settings.fan_out;
+    }
+
+    return level;
+}
+
+
+void selectWithinPartition(
+    const LeveledMergeSelector::PartsRange & parts,
+    const size_t max_total_size_to_merge,
+    Estimator & estimator,
+    const LeveledMergeSelector::Settings & settings)
+{
+    size_t parts_count = parts.size();
+    if (parts_count < 2)
+        return;
+
+    size_t max_parts_to_merge = settings.max_parts_to_merge_at_once
+        ? settings.max_parts_to_merge_at_once
+        : parts_count;
+
+    /// Look for runs of at least fan_out consecutive parts of the same level.
+    /// Parts of lower levels inside a run do not break it: merging them along
+    /// with the run only lowers write amplification.
+    for (size_t run_begin = 0; run_begin < parts_count; ++run_begin)
+    {
+        size_t run_level = levelBySize(parts[run_begin].size, settings);
+        size_t run_size = parts[run_begin].size;
+        size_t parts_at_run_level = 1;
+        size_t run_end = run_begin + 1;
+
+        while (run_end < parts_count && run_end - run_begin < max_parts_to_merge)
+        {
+            size_t level = levelBySize(parts[run_end].size, settings);
+            if (level > run_level)
+                break;
+
+            if (run_size + parts[run_end].size > max_total_size_to_merge)
+                break;
+
+            run_size += parts[run_end].size;
+            if (level == run_level)
+                ++parts_at_run_level;
+            ++run_end;
+        }
+
+        if (parts_at_run_level >= settings.fan_out)
+            estimator.consider(parts.begin() + run_begin, parts.begin() + run_end, run_size, run_level);
+    }
+}
+
+
+void settleWithinPartition(
+    const LeveledMergeSelector::PartsRange & parts,
+    const size_t max_total_size_to_merge,
+    Estimator & estimator,
+    const LeveledMergeSelector::Settings & settings)
+{
+    size_t parts_count = parts.size();
+    if (parts_count < 2)
+        return;
+
+    for (const auto & part : parts)
+        if (part.age < settings.settle_age)
+            return;
+
+    /// Merge the cheapest pair of adjacent parts. Repeated applications converge
+    /// the partition to a single part across many small tasks.
+    for (size_t i = 0; i + 1 < parts_count; ++i)
+    {
+        size_t sum_size = parts[i].size + parts[i + 1].size;
+        if (sum_size > max_total_size_to_merge)
+            continue;
+
+        estimator.consider(parts.begin() + i, parts.begin() + i + 2, sum_size, 0);
+    }
+}
+
+}
+
+
+LeveledMergeSelector::PartsRange LeveledMergeSelector::select(
+    const PartsRanges & parts_ranges,
+    size_t max_total_size_to_merge)
+{
+    Estimator estimator;
+
+    for (const auto & parts_range : parts_ranges)
+        selectWithinPartition(parts_range, max_total_size_to_merge, estimator, settings);
+
+    if (!estimator.has_best && settings.settle_age)
+    {
+        for (const auto & parts_range : parts_ranges)
+            settleWithinPartition(parts_range, max_total_size_to_merge, estimator, settings);
+    }
+
+    return estimator.getBest();
+}
+
+}
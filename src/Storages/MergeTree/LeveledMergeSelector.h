@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Storages/MergeTree/MergeSelector.h>
+
+
+namespace DB
+{
+
+/** Leveled compaction policy.
+  * Each part is assigned a level by its size: level n contains parts of size
+  *  [base_bytes * fan_out ^ n, base_bytes * fan_out ^ (n + 1)).
+  * When at least fan_out parts accumulate on one level within a partition, they are merged
+  *  into a part of the next level. The lowest qualifying level is preferred, so merges stay small.
+  * This bounds the number of parts per partition by O(fan_out * log(total size / base_bytes))
+  *  and never requires a full rewrite of a partition.
+  *
+  * Additionally, in "settle" mode (settle_age > 0), a partition that has not received
+  *  new parts for settle_age seconds is converged to a single part incrementally:
+  *  the pair of adjacent parts with the minimal sum of sizes is merged on each iteration.
+  */
+class LeveledMergeSelector : public IMergeSelector
+{
+public:
+    struct Settings
+    {
+        /// Parts smaller than base_bytes belong to level 0.
+        size_t base_bytes = 1048576;
+
+        /// Ratio of sizes between adjacent levels and the number of parts on one level that triggers a merge.
+        size_t fan_out = 10;
+
+        /// Zero means unlimited.
+        size_t max_parts_to_merge_at_once = 100;
+
+        /// If all parts of a partition are older than this, merge them pairwise down to a single part.
+        /// Zero disables settling.
+        time_t settle_age = 0;
+    };
+
+    explicit LeveledMergeSelector(const Settings & settings_) : settings(settings_) {}
+
+    PartsRange select(
+        const PartsRanges & parts_ranges,
+        size_t max_total_size_to_merge) override;
+
+private:
+    const Settings settings;
+};
+
+}
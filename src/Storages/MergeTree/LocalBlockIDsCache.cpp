@@ -0,0 +1,66 @@
+#include <Storages/MergeTree/LocalBlockIDsCache.h>
+
+#include <Common/ProfileEvents.h>
+
+namespace ProfileEvents
+{
+    extern const Event LocalBlockDedupCacheHits;
+    extern const Event LocalBlockDedupCacheMisses;
+}
+
+namespace DB
+{
+
+void LocalBlockIDsCache::add(const String & block_id, size_t max_entries)
+{
+    if (max_entries == 0)
+        return;
+
+    std::lock_guard lock(mutex);
+
+    auto it = map.find(block_id);
+    if (it != map.end())
+    {
+        /// Move to the end of the queue, it is the most recent entry now.
+        queue.splice(queue.end(), queue, it->second);
+        return;
+    }
+
+    while (queue.size() >= max_entries)
+    {
+        map.erase(queue.front());
+        queue.pop_front();
+    }
+
+    map[block_id] = queue.insert(queue.end(), block_id);
+}
+
+bool LocalBlockIDsCache::contains(const String & block_id)
+{
+    std::lock_guard lock(mutex);
+
+    auto it = map.find(block_id);
+    if (it == map.end())
+    {
+        ProfileEvents::increment(ProfileEvents::LocalBlockDedupCacheMisses);
+        return false;
+    }
+
+    queue.splice(queue.end(), queue, it->second);
+    ProfileEvents::increment(ProfileEvents::LocalBlockDedupCacheHits);
+    return true;
+}
+
+void LocalBlockIDsCache::remove(const String & block_id)
+{
+    std::lock_guard lock(mutex);
+
+    auto it = map.find(block_id);
+    if (it == map.end())
+        return;
+
+    queue.erase(it->second);
+    map.erase(it);
+}
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <base/types.h>
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace DB
+{
+
+/// A bounded in-memory set of block IDs that this replica has recently committed
+/// to (or observed as duplicates in) the `/blocks` directory in ZooKeeper.
+///
+/// It is consulted by ReplicatedMergeTreeSink before allocating a block number,
+/// so that duplicate inserts from retrying idempotent producers can skip the
+/// block allocation round trip. The cache is only a hint: entries may be stale
+/// (blocks are cleaned from ZooKeeper by the deduplication window, partitions
+/// may be dropped), so every hit must be verified against ZooKeeper, which
+/// remains the single authority for deduplication.
+class LocalBlockIDsCache
+{
+public:
+    /// Inserts the block id, evicting the least recently used entries to keep
+    /// at most `max_entries`. There is no point in keeping more entries than
+    /// the replicated_deduplication_window, because older blocks are removed
+    /// from ZooKeeper anyway.
+    void add(const String & block_id, size_t max_entries);
+
+    bool contains(const String & block_id);
+
+    /// Called when a cached block id turned out to be absent in ZooKeeper.
+    void remove(const String & block_id);
+
+private:
+    using Queue = std::list<String>;
+
+    std::mutex mutex;
+    Queue queue;
+    std::unordered_map<String, Queue::iterator> map;
+};
+
+}
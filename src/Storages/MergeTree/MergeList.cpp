@@ -88,6 +88,8 @@ MergeListElement::MergeListElement(
     /// thread_group::memory_tracker, but MemoryTrackerThreadSwitcher will reset parent).
     memory_tracker.setProfilerStep(settings.memory_profiler_step);
     memory_tracker.setSampleProbability(settings.memory_profiler_sample_probability);
+    memory_tracker.setSampleMinAllocationSize(settings.memory_profiler_sample_min_allocation_size);
+    memory_tracker.setSampleMaxAllocationSize(settings.memory_profiler_sample_max_allocation_size);
     memory_tracker.setSoftLimit(settings.memory_overcommit_ratio_denominator);
     if (settings.memory_tracker_fault_probability > 0.0)
         memory_tracker.setFaultProbability(settings.memory_tracker_fault_probability);
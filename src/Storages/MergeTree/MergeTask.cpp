@@ -30,6 +30,14 @@
 #include <Processors/Transforms/TTLCalcTransform.h>
 #include <Processors/Transforms/DistinctSortedTransform.h>
 #include <Processors/Transforms/DistinctTransform.h>
+#include <Compression/CompressionFactory.h>
+#include <Columns/ColumnSparse.h>
+#include <Common/typeid_cast.h>
+#include <DataTypes/DataTypeArray.h>
+#include <DataTypes/NestedUtils.h>
+#include <Parsers/ExpressionElementParsers.h>
+#include <Parsers/parseQuery.h>
+#include <IO/WriteBufferFromString.h>
 
 namespace DB
 {
@@ -317,6 +325,33 @@ bool MergeTask::ExecuteAndFinalizeHorizontalPart::prepare()
         ctx->blocks_are_granules_size,
         global_ctx->context->getWriteSettings());
 
+    if (global_ctx->data->getSettings()->enable_column_statistics)
+    {
+        /// Combine the input parts' statistics sketch-wise instead of recollecting them from the
+        /// merged rows. This is only sound when the merge keeps every input row: merging modes
+        /// that collapse rows, TTL removal, deduplication and lightweight deletes all make the
+        /// union an overestimate, so in those cases the output stream collects from the rows
+        /// as they stream by anyway (the constructor enabled that by default).
+        bool can_combine = ctx->merging_params.mode == MergeTreeData::MergingParams::Ordinary
+            && !ctx->need_remove_expired_values && !global_ctx->deduplicate;
+
+        MergeTreeColumnStatistics combined_statistics;
+        for (const auto & part : global_ctx->future_part->parts)
+        {
+            if (!can_combine)
+                break;
+
+            const auto & part_statistics = part->getColumnStatistics();
+            if (part_statistics.empty() || part->hasLightweightDelete())
+                can_combine = false;
+            else
+                combined_statistics.merge(part_statistics);
+        }
+
+        if (can_combine && !global_ctx->future_part->parts.empty())
+            global_ctx->to->setPrecomputedColumnStatistics(std::move(combined_statistics));
+    }
+
     global_ctx->rows_written = 0;
     ctx->initial_reservation = global_ctx->space_reservation ? global_ctx->space_reservation->getSize() : 0;
 
@@ -345,7 +380,6 @@ MergeTask::StageRuntimeContextPtr MergeTask::ExecuteAndFinalizeHorizontalPart::g
     new_ctx->column_sizes = std::move(ctx->column_sizes);
     new_ctx->compression_codec = std::move(ctx->compression_codec);
     new_ctx->tmp_disk = std::move(ctx->tmp_disk);
-    new_ctx->it_name_and_type = std::move(ctx->it_name_and_type);
     new_ctx->column_num_for_vertical_merge = std::move(ctx->column_num_for_vertical_merge);
     new_ctx->read_with_direct_io = std::move(ctx->read_with_direct_io);
     new_ctx->need_sync = std::move(ctx->need_sync);
@@ -425,6 +459,36 @@ bool MergeTask::ExecuteAndFinalizeHorizontalPart::executeImpl()
 }
 
 
+/// Batch gathering columns into groups of columns which share serialization streams:
+/// subcolumns of one Nested structure are arrays with a shared stream of offsets.
+/// Merging such a group in one pass reads and writes the shared offsets only once
+/// and iterates the row-source mask once for the whole group instead of per column.
+/// All other columns form single-element groups.
+static std::vector<NamesAndTypesList> groupColumnsBySharedStreams(const NamesAndTypesList & columns)
+{
+    std::vector<NamesAndTypesList> groups;
+    std::unordered_map<String, size_t> group_index_by_nested_table;
+
+    for (const auto & column : columns)
+    {
+        auto [nested_table, nested_subcolumn] = Nested::splitName(column.name);
+        if (!nested_subcolumn.empty() && typeid_cast<const DataTypeArray *>(column.type.get()))
+        {
+            auto [it, inserted] = group_index_by_nested_table.try_emplace(nested_table, groups.size());
+            if (inserted)
+                groups.emplace_back();
+            groups[it->second].push_back(column);
+        }
+        else
+        {
+            groups.push_back(NamesAndTypesList{column});
+        }
+    }
+
+    return groups;
+}
+
+
 bool MergeTask::VerticalMergeStage::prepareVerticalMergeForAllColumns() const
 {
      /// No need to execute this part if it is horizontal merge.
@@ -452,24 +516,100 @@ bool MergeTask::VerticalMergeStage::prepareVerticalMergeForAllColumns() const
                         "of bytes written to rows_sources file ({}). It is a bug.",
                         sum_input_rows_exact, input_rows_filtered, rows_sources_count);
 
-    ctx->rows_sources_read_buf = std::make_unique<CompressedReadBufferFromFile>(ctx->tmp_disk->readFile(fileName(ctx->rows_sources_file->path())));
+    /// Decode the row-source mask once into run-length form; all column passes share it
+    /// instead of re-reading and re-decompressing the rows_sources file for every column.
+    {
+        ctx->rows_sources_read_buf = std::make_unique<CompressedReadBufferFromFile>(ctx->tmp_disk->readFile(fileName(ctx->rows_sources_file->path())));
+        ctx->rows_sources_runs = decodeRowSourceRuns(*ctx->rows_sources_read_buf);
+        ctx->rows_sources_read_buf.reset();
+    }
 
     /// For external cycle
-    global_ctx->gathering_column_names_size = global_ctx->gathering_column_names.size();
+    ctx->column_groups = groupColumnsBySharedStreams(global_ctx->gathering_columns);
     ctx->column_num_for_vertical_merge = 0;
-    ctx->it_name_and_type = global_ctx->gathering_columns.cbegin();
 
     return false;
 }
 
+/// Chooses the most space-efficient codec for a column by trial-compressing a sample of its data
+/// with a fixed set of candidate codecs. Candidates that are not applicable to the column type
+/// (or fail on the sample) are skipped. Returns nullptr if the sample is too small to be representative.
+/// The choice is recorded per part in the usual way: every compressed frame is self-describing,
+/// so parts of one table may freely use different codecs for the same column.
+static CompressionCodecPtr selectAdaptiveCompressionCodec(
+    const ColumnWithTypeAndName & column_sample,
+    const CompressionCodecPtr & default_codec,
+    Poco::Logger * log)
+{
+    static constexpr size_t min_sample_size = 16 * 1024;
+    static constexpr size_t max_sample_size = 1024 * 1024;
+    static constexpr std::array<std::string_view, 7> candidates{
+        "LZ4", "ZSTD(1)", "ZSTD(3)", "Delta, ZSTD(1)", "DoubleDelta", "Gorilla", "T64"};
+
+    /// Serialize the sample with the default (full) serialization; all substreams are
+    /// concatenated into one buffer, which is good enough to estimate the ratio.
+    ColumnPtr full_column = recursiveRemoveSparse(column_sample.column);
+    WriteBufferFromOwnString uncompressed;
+    ISerialization::SerializeBinaryBulkSettings serialize_settings;
+    serialize_settings.getter = [&](const ISerialization::SubstreamPath &) { return &uncompressed; };
+    ISerialization::SerializeBinaryBulkStatePtr serialize_state;
+
+    auto serialization = column_sample.type->getDefaultSerialization();
+    serialization->serializeBinaryBulkStatePrefix(*full_column, serialize_settings, serialize_state);
+    serialization->serializeBinaryBulkWithMultipleStreams(*full_column, 0, full_column->size(), serialize_settings, serialize_state);
+    serialization->serializeBinaryBulkStateSuffix(serialize_settings, serialize_state);
+
+    const String & source = uncompressed.str();
+    if (source.size() < min_sample_size)
+        return nullptr;
+    auto source_size = static_cast<UInt32>(std::min(source.size(), max_sample_size));
+
+    CompressionCodecPtr best_codec = default_codec;
+    PODArray<char> compressed(default_codec->getCompressedReserveSize(source_size));
+    UInt32 best_size = default_codec->compress(source.data(), source_size, compressed.data());
+
+    ParserCodec codec_parser;
+    for (const auto & candidate : candidates)
+    {
+        try
+        {
+            auto ast = parseQuery(codec_parser, "(" + String(candidate) + ")", 0, DBMS_DEFAULT_MAX_PARSER_DEPTH);
+            auto codec = CompressionCodecFactory::instance().get(ast, column_sample.type.get());
+
+            compressed.resize(codec->getCompressedReserveSize(source_size));
+            UInt32 compressed_size = codec->compress(source.data(), source_size, compressed.data());
+
+            if (compressed_size < best_size)
+            {
+                best_size = compressed_size;
+                best_codec = codec;
+            }
+        }
+        catch (...)
+        {
+            /// The candidate is not applicable to the column type or cannot compress this data.
+        }
+    }
+
+    LOG_DEBUG(log, "Selected codec {} for column {} ({} -> {} bytes on a sample)",
+        best_codec->getCodecDesc()->formatForLogging(), column_sample.name, source_size, best_size);
+
+    return best_codec;
+}
+
+
 void MergeTask::VerticalMergeStage::prepareVerticalMergeForOneColumn() const
 {
-    const auto & [column_name, column_type] = *ctx->it_name_and_type;
-    Names column_names{column_name};
+    const auto & column_group = ctx->column_groups[ctx->column_num_for_vertical_merge];
+    Names column_names = column_group.getNames();
 
     ctx->progress_before = global_ctx->merge_list_element_ptr->progress.load(std::memory_order_relaxed);
 
-    global_ctx->column_progress = std::make_unique<MergeStageProgress>(ctx->progress_before, ctx->column_sizes->columnWeight(column_name));
+    Float64 group_weight = 0;
+    for (const auto & column_name : column_names)
+        group_weight += ctx->column_sizes->columnWeight(column_name);
+
+    global_ctx->column_progress = std::make_unique<MergeStageProgress>(ctx->progress_before, group_weight);
 
     Pipes pipes;
     for (size_t part_num = 0; part_num < global_ctx->future_part->parts.size(); ++part_num)
@@ -489,8 +629,7 @@ void MergeTask::VerticalMergeStage::prepareVerticalMergeForOneColumn() const
 
     auto pipe = Pipe::unitePipes(std::move(pipes));
 
-    ctx->rows_sources_read_buf->seek(0, 0);
-    auto transform = std::make_unique<ColumnGathererTransform>(pipe.getHeader(), pipe.numOutputPorts(), *ctx->rows_sources_read_buf);
+    auto transform = std::make_unique<ColumnGathererTransform>(pipe.getHeader(), pipe.numOutputPorts(), ctx->rows_sources_runs);
     pipe.addTransform(std::move(transform));
 
     ctx->column_parts_pipeline = QueryPipeline(std::move(pipe));
@@ -506,11 +645,28 @@ void MergeTask::VerticalMergeStage::prepareVerticalMergeForOneColumn() const
 
     ctx->executor = std::make_unique<PullingPipelineExecutor>(ctx->column_parts_pipeline);
 
+    /// Pick a codec for the column by a sample of its data. Only columns without
+    /// an explicit codec in the table definition take part, so the sampling can
+    /// only override the part-level default codec. The sampled block is written
+    /// below, after the output stream is created with the chosen codec.
+    /// Multi-column groups are skipped: the whole group shares one output stream,
+    /// so a per-column codec cannot be applied there.
+    CompressionCodecPtr column_compression_codec = ctx->compression_codec;
+    Block sampled_block;
+    if (global_ctx->data->getSettings()->vertical_merge_adaptive_compression
+        && column_group.size() == 1
+        && !global_ctx->metadata_snapshot->getColumns().hasCompressionCodec(column_group.front().name)
+        && ctx->executor->pull(sampled_block) && sampled_block.rows())
+    {
+        if (auto adaptive_codec = selectAdaptiveCompressionCodec(sampled_block.getByName(column_group.front().name), ctx->compression_codec, ctx->log))
+            column_compression_codec = adaptive_codec;
+    }
+
     ctx->column_to = std::make_unique<MergedColumnOnlyOutputStream>(
         global_ctx->new_data_part,
         global_ctx->metadata_snapshot,
         ctx->executor->getHeader(),
-        ctx->compression_codec,
+        column_compression_codec,
         /// we don't need to recalc indices here
         /// because all of them were already recalculated and written
         /// as key part of vertical merge
@@ -519,6 +675,12 @@ void MergeTask::VerticalMergeStage::prepareVerticalMergeForOneColumn() const
         global_ctx->to->getIndexGranularity());
 
     ctx->column_elems_written = 0;
+
+    if (sampled_block.rows())
+    {
+        ctx->column_elems_written += sampled_block.rows();
+        ctx->column_to->write(sampled_block);
+    }
 }
 
 
@@ -540,7 +702,7 @@ bool MergeTask::VerticalMergeStage::executeVerticalMergeForOneColumn() const
 
 void MergeTask::VerticalMergeStage::finalizeVerticalMergeForOneColumn() const
 {
-    const String & column_name = ctx->it_name_and_type->name;
+    const auto & column_group = ctx->column_groups[ctx->column_num_for_vertical_merge];
     if (global_ctx->merges_blocker->isCancelled() || global_ctx->merge_list_element_ptr->is_cancelled.load(std::memory_order_relaxed))
         throw Exception(ErrorCodes::ABORTED, "Cancelled merging parts");
 
@@ -552,8 +714,8 @@ void MergeTask::VerticalMergeStage::finalizeVerticalMergeForOneColumn() const
 
     if (global_ctx->rows_written != ctx->column_elems_written)
     {
-        throw Exception(ErrorCodes::LOGICAL_ERROR, "Written {} elements of column {}, but {} rows of PK columns",
-                        toString(ctx->column_elems_written), column_name, toString(global_ctx->rows_written));
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "Written {} elements of columns {}, but {} rows of PK columns",
+                        toString(ctx->column_elems_written), fmt::join(column_group.getNames(), ", "), toString(global_ctx->rows_written));
     }
 
     UInt64 rows = 0;
@@ -562,13 +724,16 @@ void MergeTask::VerticalMergeStage::finalizeVerticalMergeForOneColumn() const
 
     /// NOTE: 'progress' is modified by single thread, but it may be concurrently read from MergeListElement::getInfo() (StorageSystemMerges).
 
-    global_ctx->merge_list_element_ptr->columns_written += 1;
+    Float64 group_weight = 0;
+    for (const auto & column : column_group)
+        group_weight += ctx->column_sizes->columnWeight(column.name);
+
+    global_ctx->merge_list_element_ptr->columns_written += column_group.size();
     global_ctx->merge_list_element_ptr->bytes_written_uncompressed += bytes;
-    global_ctx->merge_list_element_ptr->progress.store(ctx->progress_before + ctx->column_sizes->columnWeight(column_name), std::memory_order_relaxed);
+    global_ctx->merge_list_element_ptr->progress.store(ctx->progress_before + group_weight, std::memory_order_relaxed);
 
     /// This is the external cycle increment.
     ++ctx->column_num_for_vertical_merge;
-    ++ctx->it_name_and_type;
 }
 
 
@@ -702,6 +867,11 @@ bool MergeTask::MergeProjectionsStage::finalizeProjectionsAndWholeMerge() const
         global_ctx->to->finalizePart(
             global_ctx->new_data_part, ctx->need_sync, &global_ctx->storage_columns, &global_ctx->checksums_gathered_columns);
 
+    /// Remember that the part contains no duplicates, so a repeated OPTIMIZE ... DEDUPLICATE
+    /// by a compatible set of columns can skip rewriting it.
+    if (global_ctx->deduplicate)
+        global_ctx->new_data_part->deduplicated_by_columns = global_ctx->deduplicate_by_columns;
+
     global_ctx->promise.set_value(global_ctx->new_data_part);
 
     return false;
@@ -738,7 +908,7 @@ bool MergeTask::VerticalMergeStage::executeVerticalMergeForAllColumns() const
         return false;
 
     /// This is the external cycle condition
-    if (ctx->column_num_for_vertical_merge >= global_ctx->gathering_column_names_size)
+    if (ctx->column_num_for_vertical_merge >= ctx->column_groups.size())
         return false;
 
     switch (ctx->vertical_merge_one_column_state)
@@ -152,7 +152,6 @@ private:
         MergeTreeData::DataPart::Checksums checksums_gathered_columns{};
 
         MergeAlgorithm chosen_merge_algorithm{MergeAlgorithm::Undecided};
-        size_t gathering_column_names_size{0};
 
         std::unique_ptr<MergeStageProgress> horizontal_stage_progress{nullptr};
         std::unique_ptr<MergeStageProgress> column_progress{nullptr};
@@ -213,7 +212,6 @@ private:
         Poco::Logger * log{&Poco::Logger::get("MergeTask::PrepareStage")};
 
         /// Dependencies for next stages
-        std::list<DB::NameAndTypePair>::const_iterator it_name_and_type;
         size_t column_num_for_vertical_merge{0};
         bool need_sync{false};
     };
@@ -265,12 +263,18 @@ private:
         std::optional<ColumnSizeEstimator> column_sizes;
         CompressionCodecPtr compression_codec;
         DiskPtr tmp_disk{nullptr};
-        std::list<DB::NameAndTypePair>::const_iterator it_name_and_type;
         size_t column_num_for_vertical_merge{0};
         bool read_with_direct_io{false};
         bool need_sync{false};
         /// End dependencies from previous stages
 
+        /// Gathering columns batched into groups which share serialization streams
+        /// (e.g. subcolumns of one Nested share the stream with array offsets).
+        /// Columns of a group are merged in one pass.
+        std::vector<NamesAndTypesList> column_groups;
+        /// Row sources of the merge decoded into run-length form, shared by all column passes.
+        RowSourceRunsPtr rows_sources_runs{nullptr};
+
         enum class State
         {
             NEED_PREPARE,
@@ -286,6 +290,8 @@ private:
         QueryPipeline column_parts_pipeline;
         std::unique_ptr<PullingPipelineExecutor> executor;
         std::unique_ptr<CompressedReadBufferFromFile> rows_sources_read_buf{nullptr};
+
+        Poco::Logger * log{&Poco::Logger::get("MergeTask::VerticalMergeStage")};
     };
 
     using VerticalMergeRuntimeContextPtr = std::shared_ptr<VerticalMergeRuntimeContext>;
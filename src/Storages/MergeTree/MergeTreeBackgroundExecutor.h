@@ -108,7 +108,11 @@ public:
 
     void push(TaskRuntimeDataPtr item)
     {
-        item->priority = item->task->getPriority();
+        /// Charge the task by the I/O it has already done in addition to its static priority
+        /// (the total size of source parts). This way a big merge which has read/written a lot
+        /// sinks below lighter tasks when it is pushed back between steps, i.e. it is
+        /// effectively preempted instead of monopolizing the disk until completion.
+        item->priority = item->task->getPriority() + item->task->getProcessedBytes();
         buffer.push_back(std::move(item));
         std::push_heap(buffer.begin(), buffer.end(), TaskRuntimeData::comparePtrByPriority);
     }
@@ -4,6 +4,7 @@
 #include <Storages/MergeTree/IMergeTreeReader.h>
 #include <Storages/MergeTree/MergeTreeBlockReadUtils.h>
 #include <Storages/MergeTree/RequestResponse.h>
+#include <Storages/QueryConditionCache.h>
 #include <Columns/FilterDescription.h>
 #include <Common/typeid_cast.h>
 #include <DataTypes/DataTypeNothing.h>
@@ -25,6 +26,9 @@ namespace ErrorCodes
     extern const int QUERY_WAS_CANCELLED;
 }
 
+/// Splits the PREWHERE condition into separate read steps. Defined in MergeTreeSplitPrewhereIntoReadSteps.cpp.
+bool tryBuildPrewhereSteps(PrewhereInfoPtr prewhere_info, const ExpressionActionsSettings & actions_settings, PrewhereExprInfo & prewhere);
+
 static void injectNonConstVirtualColumns(
     size_t rows,
     Block & block,
@@ -54,7 +58,8 @@ IMergeTreeSelectAlgorithm::IMergeTreeSelectAlgorithm(
     : storage(storage_)
     , storage_snapshot(storage_snapshot_)
     , prewhere_info(prewhere_info_)
-    , prewhere_actions(getPrewhereActions(prewhere_info, actions_settings))
+    , actions_settings(actions_settings)
+    , prewhere_actions(getPrewhereActions(prewhere_info, actions_settings, reader_settings_.enable_multiple_prewhere_read_steps))
     , max_block_size_rows(max_block_size_rows_)
     , preferred_block_size_bytes(preferred_block_size_bytes_)
     , preferred_max_column_in_block_size_bytes(preferred_max_column_in_block_size_bytes_)
@@ -78,7 +83,8 @@ IMergeTreeSelectAlgorithm::IMergeTreeSelectAlgorithm(
 }
 
 
-std::unique_ptr<PrewhereExprInfo> IMergeTreeSelectAlgorithm::getPrewhereActions(PrewhereInfoPtr prewhere_info, const ExpressionActionsSettings & actions_settings)
+std::unique_ptr<PrewhereExprInfo> IMergeTreeSelectAlgorithm::getPrewhereActions(
+    PrewhereInfoPtr prewhere_info, const ExpressionActionsSettings & actions_settings, bool enable_multiple_prewhere_read_steps)
 {
     std::unique_ptr<PrewhereExprInfo> prewhere_actions;
     if (prewhere_info)
@@ -98,15 +104,19 @@ std::unique_ptr<PrewhereExprInfo> IMergeTreeSelectAlgorithm::getPrewhereActions(
             prewhere_actions->steps.emplace_back(std::move(row_level_filter_step));
         }
 
-        PrewhereExprStep prewhere_step
+        if (!enable_multiple_prewhere_read_steps
+            || !tryBuildPrewhereSteps(prewhere_info, actions_settings, *prewhere_actions))
         {
-            .actions = std::make_shared<ExpressionActions>(prewhere_info->prewhere_actions, actions_settings),
-            .column_name = prewhere_info->prewhere_column_name,
-            .remove_column = prewhere_info->remove_prewhere_column,
-            .need_filter = prewhere_info->need_filter
-        };
+            PrewhereExprStep prewhere_step
+            {
+                .actions = std::make_shared<ExpressionActions>(prewhere_info->prewhere_actions, actions_settings),
+                .column_name = prewhere_info->prewhere_column_name,
+                .remove_column = prewhere_info->remove_prewhere_column,
+                .need_filter = prewhere_info->need_filter
+            };
 
-        prewhere_actions->steps.emplace_back(std::move(prewhere_step));
+            prewhere_actions->steps.emplace_back(std::move(prewhere_step));
+        }
     }
 
     return prewhere_actions;
@@ -282,6 +292,22 @@ void IMergeTreeSelectAlgorithm::initializeMergeTreeReadersForPart(
                 value_size_map, profile_callback));
         }
     }
+
+    /// Issue read requests for all reading steps of the task right away. Otherwise prefetches are
+    /// issued by each range reader on its first read, and e.g. the main columns of a query with
+    /// PREWHERE are requested only after the prewhere columns are fully read, serializing network
+    /// latency of cold reads from remote disks with the computation on previous steps.
+    bool prefetch_for_task = data_part->isStoredOnRemoteDisk()
+        ? reader_settings.read_settings.remote_fs_prefetch
+        : reader_settings.read_settings.local_fs_prefetch;
+
+    if (prefetch_for_task)
+    {
+        /// In the order the steps will need their data.
+        for (const auto & pre_reader : pre_reader_for_step)
+            pre_reader->prefetchBeginOfRange();
+        reader->prefetchBeginOfRange();
+    }
 }
 
 void IMergeTreeSelectAlgorithm::initializeRangeReaders(MergeTreeReadTask & current_task)
@@ -343,6 +369,15 @@ void IMergeTreeSelectAlgorithm::initializeRangeReadersImpl(
         range_reader = std::move(pre_range_readers.back());
         pre_range_readers.pop_back();
     }
+
+    /// Remember granules where the PREWHERE condition selected no rows, so that subsequent queries
+    /// with the same condition can skip them during index analysis. The cache is filled with the
+    /// deleted mask applied, so don't fill it when the mask is disabled.
+    if (reader_settings.query_condition_cache && reader_settings.apply_deleted_mask)
+    {
+        if (auto condition_hash = QueryConditionCache::conditionHash(prewhere_info.get()))
+            range_reader.setQueryConditionCache(reader_settings.query_condition_cache, *condition_hash);
+    }
 }
 
 static UInt64 estimateNumRows(const MergeTreeReadTask & current_task, UInt64 current_preferred_block_size_bytes,
@@ -766,9 +801,10 @@ size_t IMergeTreeSelectAlgorithm::estimateMaxBatchSizeForHugeRanges()
     /// because we have an adaptive granularity by default.
     const size_t average_granule_size_bytes = 1024 * 1024 * 10; // 10 MiB
 
-    /// We want to have one RTT per one gigabyte of data read from disk
-    /// this could be configurable.
-    const size_t max_size_for_one_request = 1024 * 1024 * 1024; // 1 GiB
+    /// Defines how much data one request to the coordinator claims: one RTT per
+    /// max_bytes_per_request of data read from disk. Smaller requests distribute the work
+    /// between replicas at a finer granularity, so a slow replica straggles the query less.
+    const size_t max_size_for_one_request = extension->max_bytes_per_request;
 
     size_t sum_average_marks_size = 0;
     /// getColumnSize is not fully implemented for compact parts
@@ -27,9 +27,12 @@ struct ParallelReadingExtension
     MergeTreeReadTaskCallback callback;
     size_t count_participating_replicas{0};
     size_t number_of_current_replica{0};
+    /// The maximum estimated amount of data one request to the coordinator may claim.
+    /// Defines the granularity of work distribution between replicas.
+    size_t max_bytes_per_request{1024 * 1024 * 1024};
     /// This is needed to estimate the number of bytes
     /// between a pair of marks to perform one request
-    /// over the network for a 1Gb of data.
+    /// over the network for max_bytes_per_request of data.
     Names colums_to_read;
 };
 
@@ -71,6 +74,11 @@ public:
 
     virtual std::string getName() const = 0;
 
+    static std::unique_ptr<PrewhereExprInfo> getPrewhereActions(
+        PrewhereInfoPtr prewhere_info,
+        const ExpressionActionsSettings & actions_settings,
+        bool enable_multiple_prewhere_read_steps);
+
 protected:
     /// This struct allow to return block with no columns but with non-zero number of rows similar to Chunk
     struct BlockAndProgress
@@ -103,8 +111,6 @@ protected:
     static void
     injectVirtualColumns(Block & block, size_t row_count, MergeTreeReadTask * task, const DataTypePtr & partition_value_type, const Names & virtual_columns);
 
-    static std::unique_ptr<PrewhereExprInfo> getPrewhereActions(PrewhereInfoPtr prewhere_info, const ExpressionActionsSettings & actions_settings);
-
     static void initializeRangeReadersImpl(
          MergeTreeRangeReader & range_reader,
          std::deque<MergeTreeRangeReader> & pre_range_readers,
@@ -133,6 +139,7 @@ protected:
     /// This step is added when the part has lightweight delete mask
     const PrewhereExprStep lightweight_delete_filter_step { nullptr, LightweightDeleteDescription::FILTER_COLUMN.name, true, true };
     PrewhereInfoPtr prewhere_info;
+    ExpressionActionsSettings actions_settings;
     std::unique_ptr<PrewhereExprInfo> prewhere_actions;
 
     UInt64 max_block_size_rows;
@@ -1,6 +1,8 @@
 #include <Storages/MergeTree/MergeTreeBlockReadUtils.h>
 #include <Storages/MergeTree/MergeTreeData.h>
+#include <Storages/MergeTree/MergeTreeBaseSelectProcessor.h>
 #include <Storages/MergeTree/IMergeTreeDataPartInfoForReader.h>
+#include <Interpreters/ExpressionActions.h>
 #include <DataTypes/NestedUtils.h>
 #include <Core/NamesAndTypes.h>
 #include <Common/checkStackSize.h>
@@ -284,10 +286,11 @@ MergeTreeReadTaskColumns getReadTaskColumns(
     const Names & required_columns,
     const Names & system_columns,
     const PrewhereInfoPtr & prewhere_info,
+    const ExpressionActionsSettings & actions_settings,
+    const MergeTreeReaderSettings & reader_settings,
     bool with_subcolumns)
 {
     Names column_names = required_columns;
-    Names pre_column_names;
 
     /// Read system columns such as lightweight delete mask "_row_exists" if it is persisted in the part
     for (const auto & name : system_columns)
@@ -309,44 +312,45 @@ MergeTreeReadTaskColumns getReadTaskColumns(
 
     if (prewhere_info)
     {
-        NameSet pre_name_set;
+        /// The steps must match the steps the select processor will execute,
+        /// so build them the same way. The row level filter is the first step there too.
+        auto prewhere_actions = IMergeTreeSelectAlgorithm::getPrewhereActions(
+            prewhere_info,
+            actions_settings,
+            reader_settings.enable_multiple_prewhere_read_steps);
 
-        /// Add column reading steps:
-        /// 1. Columns for row level filter
-        if (prewhere_info->row_level_filter)
+        NameSet columns_from_previous_steps;
+
+        /// Add a column reading step for each prewhere step.
+        for (const auto & step : prewhere_actions->steps)
         {
-            Names row_filter_column_names = prewhere_info->row_level_filter->getRequiredColumnsNames();
-            injectRequiredColumns(
-                data_part_info_for_reader, storage_snapshot, with_subcolumns, row_filter_column_names);
-            result.pre_columns.push_back(storage_snapshot->getColumnsByNames(options, row_filter_column_names));
-            pre_name_set.insert(row_filter_column_names.begin(), row_filter_column_names.end());
-        }
+            Names step_column_names = step.actions->getActionsDAG().getRequiredColumnsNames();
 
-        /// 2. Columns for prewhere
-        Names all_pre_column_names = prewhere_info->prewhere_actions->getRequiredColumnsNames();
+            injectRequiredColumns(
+                data_part_info_for_reader, storage_snapshot, with_subcolumns, step_column_names);
 
-        injectRequiredColumns(
-             data_part_info_for_reader, storage_snapshot, with_subcolumns, all_pre_column_names);
+            Names columns_to_read_in_step;
+            for (const auto & name : step_column_names)
+            {
+                if (columns_from_previous_steps.contains(name))
+                    continue;
+                columns_to_read_in_step.push_back(name);
+                columns_from_previous_steps.insert(name);
+            }
 
-        for (const auto & name : all_pre_column_names)
-        {
-            if (pre_name_set.contains(name))
-                continue;
-            pre_column_names.push_back(name);
-            pre_name_set.insert(name);
+            result.pre_columns.push_back(storage_snapshot->getColumnsByNames(options, columns_to_read_in_step));
         }
 
+        /// Remove columns read by the prewhere steps from the list of columns to read.
         Names post_column_names;
         for (const auto & name : column_names)
-            if (!pre_name_set.contains(name))
+            if (!columns_from_previous_steps.contains(name))
                 post_column_names.push_back(name);
 
         column_names = post_column_names;
     }
 
-    result.pre_columns.push_back(storage_snapshot->getColumnsByNames(options, pre_column_names));
-
-    /// 3. Rest of the requested columns
+    /// Rest of the requested columns
     result.columns = storage_snapshot->getColumnsByNames(options, column_names);
     return result;
 }
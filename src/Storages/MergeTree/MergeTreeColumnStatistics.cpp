@@ -0,0 +1,106 @@
+#include <Storages/MergeTree/MergeTreeColumnStatistics.h>
+
+#include <Columns/ColumnNullable.h>
+#include <Common/SipHash.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteHelpers.h>
+
+namespace DB
+{
+
+namespace ErrorCodes
+{
+    extern const int UNKNOWN_FORMAT_VERSION;
+}
+
+void MergeTreeColumnStatistics::ColumnStatistics::merge(const ColumnStatistics & other)
+{
+    histogram.merge(other.histogram);
+    distinct_count.merge(other.distinct_count);
+    null_count += other.null_count;
+    has_histogram |= other.has_histogram;
+}
+
+void MergeTreeColumnStatistics::update(const Block & block)
+{
+    for (const auto & elem : block)
+    {
+        auto & stat = columns[elem.name];
+
+        const IColumn * column = elem.column.get();
+        const NullMap * null_map = nullptr;
+        if (const auto * nullable = checkAndGetColumn<ColumnNullable>(column))
+        {
+            null_map = &nullable->getNullMapData();
+            column = &nullable->getNestedColumn();
+        }
+
+        bool is_numeric = isNumber(removeNullable(elem.type));
+        if (is_numeric)
+            stat.has_histogram = true;
+
+        size_t rows = column->size();
+        for (size_t i = 0; i < rows; ++i)
+        {
+            if (null_map && (*null_map)[i])
+            {
+                ++stat.null_count;
+                continue;
+            }
+
+            SipHash hash;
+            column->updateHashWithValue(i, hash);
+            stat.distinct_count.insert(hash.get64());
+
+            if (is_numeric)
+                stat.histogram.add(static_cast<Float32>(column->getFloat64(i)));
+        }
+    }
+}
+
+void MergeTreeColumnStatistics::merge(const MergeTreeColumnStatistics & other)
+{
+    for (const auto & [name, stat] : other.columns)
+        columns[name].merge(stat);
+}
+
+void MergeTreeColumnStatistics::read(ReadBuffer & in)
+{
+    UInt64 format_version;
+    readVarUInt(format_version, in);
+    if (format_version != 1)
+        throw Exception(ErrorCodes::UNKNOWN_FORMAT_VERSION, "Unknown format version {} of column statistics", format_version);
+
+    size_t num_columns;
+    readVarUInt(num_columns, in);
+    for (size_t i = 0; i < num_columns; ++i)
+    {
+        String name;
+        readStringBinary(name, in);
+
+        auto & stat = columns[name];
+        readVarUInt(stat.null_count, in);
+        readBinary(stat.has_histogram, in);
+        if (stat.has_histogram)
+            stat.histogram.deserialize(in);
+        stat.distinct_count.read(in);
+    }
+}
+
+void MergeTreeColumnStatistics::write(WriteBuffer & out)
+{
+    writeVarUInt(1, out); /// format version
+    writeVarUInt(columns.size(), out);
+    for (auto & [name, stat] : columns)
+    {
+        writeStringBinary(name, out);
+        writeVarUInt(stat.null_count, out);
+        writeBinary(stat.has_histogram, out);
+        if (stat.has_histogram)
+            stat.histogram.serialize(out);
+        stat.distinct_count.write(out);
+    }
+}
+
+}
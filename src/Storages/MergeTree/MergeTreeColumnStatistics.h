@@ -0,0 +1,48 @@
+#pragma once
+
+#include <AggregateFunctions/QuantileTDigest.h>
+#include <Common/HyperLogLogCounter.h>
+#include <Core/Block.h>
+
+#include <map>
+
+namespace DB
+{
+
+/// Statistics of the column values of one data part: an equi-depth histogram of the values
+/// (a t-digest, kept for numeric columns only) and a distinct-count sketch (HyperLogLog over
+/// 64-bit value hashes). Both representations are mergeable, so a merge combines the statistics
+/// of its input parts instead of rescanning the rows, and table-level statistics are obtained
+/// by merging the statistics of the active parts.
+struct MergeTreeColumnStatistics
+{
+    /// 2^12 buckets give ~1.6% relative error of the distinct count at ~2.5 KiB per column.
+    using DistinctCountSketch = HyperLogLogCounter<12>;
+
+    struct ColumnStatistics
+    {
+        QuantileTDigest<Float32> histogram;
+        DistinctCountSketch distinct_count;
+        UInt64 null_count = 0;
+        bool has_histogram = false;
+
+        void merge(const ColumnStatistics & other);
+    };
+
+    /// Order is important as it would be serialized and hashed for checksums
+    std::map<String, ColumnStatistics> columns;
+
+    static constexpr auto FILE_NAME = "statistics.bin";
+
+    bool empty() const { return columns.empty(); }
+
+    /// Account the rows of a block written to the part.
+    void update(const Block & block);
+    void merge(const MergeTreeColumnStatistics & other);
+
+    void read(ReadBuffer & in);
+    /// Serialization compresses the t-digests, hence non-const.
+    void write(WriteBuffer & out);
+};
+
+}
@@ -31,8 +31,10 @@
 #include <Interpreters/evaluateConstantExpression.h>
 #include <Interpreters/convertFieldToType.h>
 #include <Parsers/ASTFunction.h>
+#include <Parsers/ASTIdentifier.h>
 #include <Parsers/ASTLiteral.h>
 #include <Parsers/ASTNameTypePair.h>
+#include <Parsers/ASTOrderByElement.h>
 #include <Parsers/ASTPartition.h>
 #include <Parsers/ASTSetQuery.h>
 #include <Parsers/ASTTablesInSelectQuery.h>
@@ -41,6 +43,7 @@
 #include <Parsers/queryToString.h>
 #include <Storages/AlterCommands.h>
 #include <Storages/MergeTree/MergeTreeBaseSelectProcessor.h>
+#include <Storages/MergeTree/MergeTreeDataSelectExecutor.h>
 #include <Storages/MergeTree/MergeTreeDataPartCompact.h>
 #include <Storages/MergeTree/MergeTreeDataPartInMemory.h>
 #include <Storages/MergeTree/MergeTreeDataPartWide.h>
@@ -898,7 +901,45 @@ std::optional<UInt64> MergeTreeData::totalRowsByPartitionPredicateImpl(
     bool valid = VirtualColumnUtils::prepareFilterBlockWithQuery(query_info.query, local_context, virtual_columns_block, expression_ast);
 
     PartitionPruner partition_pruner(metadata_snapshot, query_info, local_context, true /* strict */);
-    if (partition_pruner.isUseless() && !valid)
+
+    /// The count of a part can be taken from its metadata only if the whole predicate is over
+    /// columns that are constant within a part: the partition key sources and the _part* virtual
+    /// columns. Otherwise the count may still be exact, if the predicate is over the primary key
+    /// and the primary index proves it constant over the key range of every part (e.g. a range
+    /// over the key whose bounds fall between parts). The key condition must be built in strict
+    /// mode and contain no unknown atoms, so that its check is equivalent to the predicate and
+    /// not just implied by it.
+    IdentifierNameSet predicate_columns;
+    const auto & select = query_info.query->as<ASTSelectQuery &>();
+    if (const auto & where = select.where())
+        where->collectIdentifierNames(predicate_columns);
+    if (const auto & prewhere = select.prewhere())
+        prewhere->collectIdentifierNames(predicate_columns);
+
+    NameSet columns_constant_within_part = {"_part", "_partition_id", "_part_uuid", "_partition_value"};
+    if (const auto & partition_expression = metadata_snapshot->getPartitionKey().expression)
+        for (const auto & column : partition_expression->getRequiredColumns())
+            columns_constant_within_part.insert(column);
+
+    bool predicate_is_constant_within_part = std::all_of(
+        predicate_columns.begin(), predicate_columns.end(),
+        [&](const auto & column) { return columns_constant_within_part.contains(column); });
+
+    std::optional<KeyCondition> primary_key_condition;
+    if (!predicate_is_constant_within_part)
+    {
+        if (!metadata_snapshot->hasPrimaryKey())
+            return {};
+
+        const auto & primary_key = metadata_snapshot->getPrimaryKey();
+        KeyCondition candidate(
+            query_info, local_context, primary_key.column_names, primary_key.expression, false /* single_point */, true /* strict */);
+        if (candidate.anyUnknownOrAlwaysTrue() || candidate.hasMonotonicFunctionsChain())
+            return {};
+
+        primary_key_condition.emplace(std::move(candidate));
+    }
+    else if (partition_pruner.isUseless() && !valid)
         return {};
 
     std::unordered_set<String> part_values;
@@ -916,7 +957,18 @@ std::optional<UInt64> MergeTreeData::totalRowsByPartitionPredicateImpl(
     for (const auto & part : parts)
     {
         if ((part_values.empty() || part_values.find(part->name) != part_values.end()) && !partition_pruner.canBePruned(*part))
-            res += part->rows_count;
+        {
+            if (primary_key_condition)
+            {
+                auto exact_rows = MergeTreeDataSelectExecutor::countRowsByPrimaryKeyCondition(
+                    part, metadata_snapshot, *primary_key_condition);
+                if (!exact_rows)
+                    return {};
+                res += *exact_rows;
+            }
+            else
+                res += part->rows_count;
+        }
     }
     return res;
 }
@@ -1230,6 +1282,7 @@ MergeTreeData::LoadPartResult MergeTreeData::loadDataPart(
     {
         std::lock_guard lock(part_loading_mutex);
         std::tie(it, inserted) = data_parts_indexes.insert(res.part);
+        resetActivePartsSnapshot();
     }
 
     /// Remove duplicate parts with the same checksum.
@@ -1420,6 +1473,7 @@ void MergeTreeData::loadDataPartsFromWAL(MutableDataPartsVector & parts_from_wal
 
         part->setState(DataPartState::Active);
         auto [it, inserted] = data_parts_indexes.insert(part);
+        resetActivePartsSnapshot();
 
         if (!inserted)
         {
@@ -1555,6 +1609,7 @@ void MergeTreeData::loadDataParts(bool skip_sanity_checks)
 
     auto part_lock = lockParts();
     data_parts_indexes.clear();
+    resetActivePartsSnapshot();
 
     MutableDataPartsVector broken_parts_to_detach;
     MutableDataPartsVector duplicate_parts_to_remove;
@@ -1734,38 +1789,70 @@ try
     if (is_async)
         shared_lock = lockForShare(RWLockImpl::NO_QUERY, getSettings()->lock_acquire_timeout_for_background_operations);
 
-    size_t num_loaded_parts = 0;
-    while (true)
+    size_t num_parts_to_load;
     {
-        PartLoadingTree::NodePtr part;
+        std::lock_guard lock(outdated_data_parts_mutex);
+        num_parts_to_load = outdated_unloaded_data_parts.size();
+    }
 
+    /// Outdated parts are not required to serve queries, but loading their metadata in a single
+    /// thread may lag behind for a long time on tables with a large history of merges.
+    /// Use the same degree of parallelism as for loading of active parts.
+    ThreadPool pool(std::min(static_cast<size_t>(getSettings()->max_part_loading_threads), num_parts_to_load));
+    std::atomic<size_t> num_loaded_parts = 0;
+
+    for (size_t i = 0; i < pool.getMaxThreads(); ++i)
+    {
+        pool.scheduleOrThrowOnError([&, thread_group = CurrentThread::getGroup()]
         {
-            std::lock_guard lock(outdated_data_parts_mutex);
+            SCOPE_EXIT_SAFE(
+                if (thread_group)
+                    CurrentThread::detachQueryIfNotDetached();
+            );
+            if (thread_group)
+                CurrentThread::attachToIfDetached(thread_group);
 
-            if (is_async && outdated_data_parts_loading_canceled)
+            while (true)
             {
-                LOG_DEBUG(log,
-                    "Stopped loading outdated data parts because task was canceled. "
-                    "Loaded {} parts, {} left unloaded", num_loaded_parts, outdated_unloaded_data_parts.size());
-                return;
-            }
+                PartLoadingTree::NodePtr part;
 
-            if (outdated_unloaded_data_parts.empty())
-                break;
+                {
+                    std::lock_guard lock(outdated_data_parts_mutex);
 
-            part = std::move(outdated_unloaded_data_parts.back());
-            outdated_unloaded_data_parts.pop_back();
-        }
+                    if (is_async && outdated_data_parts_loading_canceled)
+                        return;
 
-        auto res = loadDataPart(part->info, part->name, part->disk, MergeTreeDataPartState::Outdated, data_parts_mutex);
-        ++num_loaded_parts;
+                    if (outdated_unloaded_data_parts.empty())
+                        return;
 
-        if (res.is_broken)
-            res.part->renameToDetached("broken-on-start"); /// detached parts must not have '_' in prefixes
-        else if (res.part->is_duplicate)
-            res.part->remove();
-        else
-            preparePartForRemoval(res.part);
+                    part = std::move(outdated_unloaded_data_parts.back());
+                    outdated_unloaded_data_parts.pop_back();
+                }
+
+                auto res = loadDataPart(part->info, part->name, part->disk, MergeTreeDataPartState::Outdated, data_parts_mutex);
+                ++num_loaded_parts;
+
+                if (res.is_broken)
+                    res.part->renameToDetached("broken-on-start"); /// detached parts must not have '_' in prefixes
+                else if (res.part->is_duplicate)
+                    res.part->remove();
+                else
+                    preparePartForRemoval(res.part);
+            }
+        });
+    }
+
+    pool.wait();
+
+    {
+        std::lock_guard lock(outdated_data_parts_mutex);
+        if (is_async && outdated_data_parts_loading_canceled)
+        {
+            LOG_DEBUG(log,
+                "Stopped loading outdated data parts because task was canceled. "
+                "Loaded {} parts, {} left unloaded", num_loaded_parts, outdated_unloaded_data_parts.size());
+            return;
+        }
     }
 
     LOG_DEBUG(log, "Loaded {} outdated data parts {}",
@@ -2091,6 +2178,7 @@ void MergeTreeData::removePartsFinally(const MergeTreeData::DataPartsVector & pa
             (*it)->assertState({DataPartState::Deleting});
 
             data_parts_indexes.erase(it);
+            resetActivePartsSnapshot();
         }
     }
 
@@ -2498,6 +2586,24 @@ size_t MergeTreeData::clearEmptyParts()
     return parts_names_to_drop.size();
 }
 
+size_t MergeTreeData::unloadUnusedPrimaryKeys()
+{
+    const auto settings = getSettings();
+    if (!settings->primary_key_lazy_load || !settings->primary_key_unload_timeout.totalSeconds())
+        return 0;
+
+    size_t unloaded_count = 0;
+    for (const auto & part : getDataPartsVectorForInternalUsage())
+        if (part->unloadIndexIfNotUsedFor(settings->primary_key_unload_timeout.totalSeconds()))
+            ++unloaded_count;
+
+    if (unloaded_count)
+        LOG_DEBUG(log, "Unloaded primary indexes of {} parts which were not used for {} seconds",
+            unloaded_count, settings->primary_key_unload_timeout.totalSeconds());
+
+    return unloaded_count;
+}
+
 void MergeTreeData::rename(const String & new_table_path, const StorageID & new_table_id)
 {
     LOG_INFO(log, "Renaming table to path {} with ID {}", new_table_path, new_table_id.getFullTableName());
@@ -2583,6 +2689,7 @@ void MergeTreeData::dropAllData()
 
         LOG_TRACE(log, "dropAllData: removing all data parts from memory.");
         data_parts_indexes.clear();
+        resetActivePartsSnapshot();
         all_data_dropped = true;
     }
     catch (...)
@@ -2597,6 +2704,7 @@ void MergeTreeData::dropAllData()
                 data_parts_indexes.erase(part->info);
         }
 
+        resetActivePartsSnapshot();
         throw;
     }
 
@@ -3112,7 +3220,13 @@ MergeTreeDataPartType MergeTreeData::choosePartType(size_t bytes_uncompressed, s
         return MergeTreeDataPartType::Wide;
 
     if (bytes_uncompressed < settings->min_bytes_for_compact_part || rows_count < settings->min_rows_for_compact_part)
-        return MergeTreeDataPartType::InMemory;
+    {
+        /// In-memory parts occupy RAM until they are merged to disk and are replayed
+        /// from the WAL on restart, so their total size may be limited.
+        if (!settings->in_memory_parts_max_total_bytes
+            || getTotalInMemoryPartsBytes() + bytes_uncompressed <= settings->in_memory_parts_max_total_bytes)
+            return MergeTreeDataPartType::InMemory;
+    }
 
     if (bytes_uncompressed < settings->min_bytes_for_wide_part || rows_count < settings->min_rows_for_wide_part)
         return MergeTreeDataPartType::Compact;
@@ -3431,6 +3545,7 @@ void MergeTreeData::preparePartForCommit(MutableDataPartPtr & part, Transaction
         part->renameTo(part->name, true);
 
     data_parts_indexes.insert(part);
+    resetActivePartsSnapshot();
     out_transaction.addPart(part);
 }
 
@@ -3612,6 +3727,7 @@ void MergeTreeData::removePartsFromWorkingSetImmediatelyAndSetTemporaryState(con
         modifyPartState(part, MergeTreeDataPartState::Temporary);
         /// Erase immediately
         data_parts_indexes.erase(it_part);
+        resetActivePartsSnapshot();
     }
 }
 
@@ -3802,6 +3918,7 @@ void MergeTreeData::forcefullyMovePartToDetachedAndRemoveFromMemory(const MergeT
     modifyPartState(it_part, DataPartState::Deleting);
     asMutableDeletingPart(part)->renameToDetached(prefix);
     data_parts_indexes.erase(it_part);
+    resetActivePartsSnapshot();
 
     if (restore_covered && part->info.level == 0)
     {
@@ -3975,6 +4092,17 @@ size_t MergeTreeData::getTotalActiveSizeInBytes() const
 }
 
 
+size_t MergeTreeData::getTotalInMemoryPartsBytes() const
+{
+    size_t res = 0;
+    auto lock = lockParts();
+    for (const auto & part : getDataPartsStateRange(DataPartState::Active))
+        if (part->getType() == MergeTreeDataPartType::InMemory)
+            res += part->getBytesOnDisk();
+    return res;
+}
+
+
 size_t MergeTreeData::getTotalActiveSizeInRows() const
 {
     return total_active_size_rows.load(std::memory_order_acquire);
@@ -4215,6 +4343,7 @@ void MergeTreeData::swapActivePart(MergeTreeData::DataPartPtr part_copy)
 
             auto part_it = data_parts_indexes.insert(part_copy).first;
             modifyPartState(part_it, DataPartState::Active);
+            resetActivePartsSnapshot();
 
             ssize_t diff_bytes = part_copy->getBytesOnDisk() - original_active_part->getBytesOnDisk();
             ssize_t diff_rows = part_copy->rows_count - original_active_part->rows_count;
@@ -4389,6 +4518,12 @@ void MergeTreeData::addPartContributionToColumnAndSecondaryIndexSizes(const Data
         ColumnSize & total_column_size = column_sizes[column.name];
         ColumnSize part_column_size = part->getColumnSize(column.name);
         total_column_size.add(part_column_size);
+
+        for (const auto & subcolumn_name : column.type->getSubcolumnNames())
+        {
+            auto full_subcolumn_name = Nested::concatenateName(column.name, subcolumn_name);
+            column_sizes[full_subcolumn_name].add(part->getColumnSize(full_subcolumn_name));
+        }
     }
 
     auto indexes_descriptions = getInMemoryMetadataPtr()->secondary_indices;
@@ -4404,21 +4539,28 @@ void MergeTreeData::removePartContributionToColumnAndSecondaryIndexSizes(const D
 {
     for (const auto & column : part->getColumns())
     {
-        ColumnSize & total_column_size = column_sizes[column.name];
-        ColumnSize part_column_size = part->getColumnSize(column.name);
-
-        auto log_subtract = [&](size_t & from, size_t value, const char * field)
+        auto subtract_part_size = [&](const String & column_name)
         {
-            if (value > from)
-                LOG_ERROR(log, "Possibly incorrect column size subtraction: {} - {} = {}, column: {}, field: {}",
-                    from, value, from - value, column.name, field);
+            ColumnSize & total_column_size = column_sizes[column_name];
+            ColumnSize part_column_size = part->getColumnSize(column_name);
 
-            from -= value;
+            auto log_subtract = [&](size_t & from, size_t value, const char * field)
+            {
+                if (value > from)
+                    LOG_ERROR(log, "Possibly incorrect column size subtraction: {} - {} = {}, column: {}, field: {}",
+                        from, value, from - value, column_name, field);
+
+                from -= value;
+            };
+
+            log_subtract(total_column_size.data_compressed, part_column_size.data_compressed, ".data_compressed");
+            log_subtract(total_column_size.data_uncompressed, part_column_size.data_uncompressed, ".data_uncompressed");
+            log_subtract(total_column_size.marks, part_column_size.marks, ".marks");
         };
 
-        log_subtract(total_column_size.data_compressed, part_column_size.data_compressed, ".data_compressed");
-        log_subtract(total_column_size.data_uncompressed, part_column_size.data_uncompressed, ".data_uncompressed");
-        log_subtract(total_column_size.marks, part_column_size.marks, ".marks");
+        subtract_part_size(column.name);
+        for (const auto & subcolumn_name : column.type->getSubcolumnNames())
+            subtract_part_size(Nested::concatenateName(column.name, subcolumn_name));
     }
 
     auto indexes_descriptions = getInMemoryMetadataPtr()->secondary_indices;
@@ -4442,6 +4584,14 @@ void MergeTreeData::removePartContributionToColumnAndSecondaryIndexSizes(const D
     }
 }
 
+void MergeTreeData::addSecondaryIndexUsage(const String & index_name, size_t granules_tested, size_t granules_dropped) const
+{
+    std::lock_guard lock(secondary_index_usage_mutex);
+    auto & usage = secondary_index_usage[index_name];
+    usage.granules_tested += granules_tested;
+    usage.granules_dropped += granules_dropped;
+}
+
 void MergeTreeData::checkAlterPartitionIsPossible(
     const PartitionCommands & commands, const StorageMetadataPtr & /*metadata_snapshot*/, const Settings & settings) const
 {
@@ -5698,7 +5848,30 @@ MergeTreeData::DataParts MergeTreeData::getDataPartsForInternalUsage() const
 
 MergeTreeData::DataPartsVector MergeTreeData::getDataPartsVectorForInternalUsage() const
 {
-    return getDataPartsVectorForInternalUsage({DataPartState::Active});
+    /// Fast path without data_parts_mutex: between changes of the part set all readers
+    /// share the same immutable snapshot, so concurrent SELECTs do not queue behind
+    /// inserts, merges and drops just to copy the list of Active parts.
+    if (active_parts_snapshot_is_valid.load(std::memory_order_acquire))
+        if (auto snapshot = active_parts_snapshot.get())
+            return *snapshot;
+
+    auto lock = lockParts();
+    auto res = getDataPartsVectorForInternalUsage({DataPartState::Active}, lock);
+
+    /// Publish under the lock: a change of the part set invalidates the snapshot
+    /// under the same lock, so the published version cannot be stale.
+    active_parts_snapshot.set(std::make_unique<DataPartsVector>(res));
+    active_parts_snapshot_is_valid.store(true, std::memory_order_release);
+
+    return res;
+}
+
+MergeTreeColumnStatistics MergeTreeData::getColumnStatistics() const
+{
+    MergeTreeColumnStatistics result;
+    for (const auto & part : getDataPartsVectorForInternalUsage())
+        result.merge(part->getColumnStatistics());
+    return result;
 }
 
 MergeTreeData::DataPartPtr MergeTreeData::getAnyPartInPartition(
@@ -6277,7 +6450,7 @@ Block MergeTreeData::getMinMaxCountProjectionBlock(
         {
             for (const auto & part : real_parts)
             {
-                const auto & primary_key_column = *part->index[0];
+                const auto & primary_key_column = *part->getIndex()[0];
                 auto & min_column = assert_cast<ColumnAggregateFunction &>(*partition_minmax_count_columns[pos]);
                 insert(min_column, primary_key_column[0]);
             }
@@ -6288,7 +6461,7 @@ Block MergeTreeData::getMinMaxCountProjectionBlock(
         {
             for (const auto & part : real_parts)
             {
-                const auto & primary_key_column = *part->index[0];
+                const auto & primary_key_column = *part->getIndex()[0];
                 auto & max_column = assert_cast<ColumnAggregateFunction &>(*partition_minmax_count_columns[pos]);
                 insert(max_column, primary_key_column[primary_key_column.size() - 1]);
             }
@@ -6515,6 +6688,33 @@ std::optional<ProjectionCandidate> MergeTreeData::getQueryProcessingStageWithAgg
         return match;
     };
 
+    /// A normal projection stores the data re-sorted by its own ORDER BY. When the query orders by
+    /// a prefix of the projection sorting key, reading the projection allows to sort in order of
+    /// reading, e.g. to feed a full sorting merge JOIN without a full sort. Such projections are
+    /// useful even without a filter, where they are normally not considered.
+    auto order_by_matches_projection = [&](const ProjectionDescription & projection)
+    {
+        const auto order_by = select_query->orderBy();
+        if (!order_by || order_by->children.empty())
+            return false;
+
+        const auto & sorting_key_columns = projection.metadata->getSortingKeyColumns();
+        if (order_by->children.size() > sorting_key_columns.size())
+            return false;
+
+        for (size_t i = 0; i < order_by->children.size(); ++i)
+        {
+            const auto * order_by_element = order_by->children[i]->as<ASTOrderByElement>();
+            if (!order_by_element || order_by_element->direction != 1 || order_by_element->with_fill || order_by_element->collation)
+                return false;
+
+            const auto * identifier = order_by_element->children.front()->as<ASTIdentifier>();
+            if (!identifier || identifier->name() != sorting_key_columns[i])
+                return false;
+        }
+        return true;
+    };
+
     auto virtual_block = getSampleBlockWithVirtualColumns();
     auto add_projection_candidate = [&](const ProjectionDescription & projection, bool minmax_count_projection = false)
     {
@@ -6601,7 +6801,10 @@ std::optional<ProjectionCandidate> MergeTreeData::getQueryProcessingStageWithAgg
             if (analysis_result.before_aggregation && analysis_result.optimize_aggregation_in_order)
                 attach_aggregation_in_order_info();
 
-            if (analysis_result.hasWhere() || analysis_result.hasPrewhere())
+            bool use_for_sorting = settings.optimize_use_projections_for_sorting && settings.optimize_read_in_order
+                && order_by_matches_projection(projection);
+
+            if (analysis_result.hasWhere() || analysis_result.hasPrewhere() || use_for_sorting)
             {
                 const auto & actions
                     = analysis_result.before_aggregation ? analysis_result.before_aggregation : analysis_result.before_order_by;
@@ -6861,6 +7064,30 @@ MergeTreeData & MergeTreeData::checkStructureAndGetMergeTreeData(
     return checkStructureAndGetMergeTreeData(*source_table, src_snapshot, my_snapshot);
 }
 
+MergeTreeData * MergeTreeData::tryGetMergeTreeDataWithSameStructure(
+    IStorage & source_table, const StorageMetadataPtr & src_snapshot, const StorageMetadataPtr & my_snapshot) const
+{
+    MergeTreeData * src_data = dynamic_cast<MergeTreeData *>(&source_table);
+    if (!src_data)
+        return nullptr;
+
+    if (my_snapshot->getColumns().getAllPhysical().sizeOfDifference(src_snapshot->getColumns().getAllPhysical()))
+        return nullptr;
+
+    auto query_to_string = [] (const ASTPtr & ast)
+    {
+        return ast ? queryToString(ast) : "";
+    };
+
+    if (query_to_string(my_snapshot->getSortingKeyAST()) != query_to_string(src_snapshot->getSortingKeyAST())
+        || query_to_string(my_snapshot->getPartitionKeyAST()) != query_to_string(src_snapshot->getPartitionKeyAST())
+        || query_to_string(my_snapshot->getPrimaryKeyAST()) != query_to_string(src_snapshot->getPrimaryKeyAST())
+        || format_version != src_data->format_version)
+        return nullptr;
+
+    return src_data;
+}
+
 std::pair<MergeTreeData::MutableDataPartPtr, scope_guard> MergeTreeData::cloneAndLoadDataPartOnSameDisk(
     const MergeTreeData::DataPartPtr & src_part,
     const String & tmp_part_prefix,
@@ -492,6 +492,11 @@ public:
     DataParts getDataPartsForInternalUsage() const;
     DataPartsVector getDataPartsVectorForInternalUsage() const;
 
+    /// Merged column statistics of the active parts (see enable_column_statistics).
+    /// Empty if no active part carries statistics. Used by system.column_statistics
+    /// and available to the planner for selectivity estimation.
+    MergeTreeColumnStatistics getColumnStatistics() const;
+
     void filterVisibleDataParts(DataPartsVector & maybe_visible_parts, CSN snapshot_version, TransactionID current_tid) const;
 
     /// Returns parts that visible with current snapshot
@@ -527,6 +532,9 @@ public:
     /// Total size of active parts in bytes.
     size_t getTotalActiveSizeInBytes() const;
 
+    /// Total size of active parts in in-memory format in bytes.
+    size_t getTotalInMemoryPartsBytes() const;
+
     size_t getTotalActiveSizeInRows() const;
 
     size_t getPartsCount() const;
@@ -673,6 +681,10 @@ public:
 
     size_t clearEmptyParts();
 
+    /// Unload in-memory primary indexes of parts that were not queried for primary_key_unload_timeout.
+    /// They are reloaded from disk on the next use. Returns the number of unloaded indexes.
+    size_t unloadUnusedPrimaryKeys();
+
     /// After the call to dropAllData() no method can be called.
     /// Deletes the data directory and flushes the uncompressed blocks cache and the marks cache.
     void dropAllData();
@@ -803,6 +815,15 @@ public:
         return secondary_index_sizes;
     }
 
+    SecondaryIndexUsageByName getSecondaryIndexUsage() const override
+    {
+        std::lock_guard lock(secondary_index_usage_mutex);
+        return secondary_index_usage;
+    }
+
+    /// Accumulates runtime effectiveness statistics of a secondary index after a query consulted it.
+    void addSecondaryIndexUsage(const String & index_name, size_t granules_tested, size_t granules_dropped) const;
+
     /// For ATTACH/DETACH/DROP PARTITION.
     String getPartitionIDFromQuery(const ASTPtr & ast, ContextPtr context, DataPartsLock * acquired_lock = nullptr) const;
     std::unordered_set<String> getPartitionIDsFromQuery(const ASTs & asts, ContextPtr context) const;
@@ -817,6 +838,10 @@ public:
     MergeTreeData & checkStructureAndGetMergeTreeData(const StoragePtr & source_table, const StorageMetadataPtr & src_snapshot, const StorageMetadataPtr & my_snapshot) const;
     MergeTreeData & checkStructureAndGetMergeTreeData(IStorage & source_table, const StorageMetadataPtr & src_snapshot, const StorageMetadataPtr & my_snapshot) const;
 
+    /// Non-throwing version of the above: returns nullptr if the source table is not a *MergeTree*
+    /// table with the same columns, keys and format_version.
+    MergeTreeData * tryGetMergeTreeDataWithSameStructure(IStorage & source_table, const StorageMetadataPtr & src_snapshot, const StorageMetadataPtr & my_snapshot) const;
+
     struct HardlinkedFiles
     {
         /// Shared table uuid where hardlinks live
@@ -1077,6 +1102,11 @@ protected:
     /// Current secondary index sizes in compressed and uncompressed form.
     IndexSizeByName secondary_index_sizes;
 
+    /// Runtime effectiveness of secondary indexes, accumulated over the queries executed since server start.
+    /// Updated from the query path, hence mutable.
+    mutable std::mutex secondary_index_usage_mutex;
+    mutable SecondaryIndexUsageByName secondary_index_usage TSA_GUARDED_BY(secondary_index_usage_mutex);
+
     /// Engine-specific methods
     BrokenPartCallback broken_part_callback;
 
@@ -1137,6 +1167,16 @@ protected:
     DataPartsIndexes::index<TagByInfo>::type & data_parts_by_info;
     DataPartsIndexes::index<TagByStateAndInfo>::type & data_parts_by_state_and_info;
 
+    /// Copy-on-write snapshot of the set of Active parts.
+    /// It is rebuilt lazily under data_parts_mutex and invalidated by every change of the part set,
+    /// so between changes concurrent SELECTs obtain the part set without contending on data_parts_mutex
+    /// with inserts, merges and drops (see getDataPartsVectorForInternalUsage()).
+    mutable MultiVersion<DataPartsVector> active_parts_snapshot;
+    mutable std::atomic<bool> active_parts_snapshot_is_valid{false};
+
+    /// Must be called on every change of data_parts_indexes or of a part state.
+    void resetActivePartsSnapshot() const { active_parts_snapshot_is_valid.store(false, std::memory_order_release); }
+
     /// Mutex for critical sections which alter set of parts
     /// It is like truncate, drop/detach partition
     mutable std::mutex operation_with_data_parts_mutex;
@@ -1197,12 +1237,16 @@ protected:
 
     void modifyPartState(DataPartIteratorByStateAndInfo it, DataPartState state)
     {
+        resetActivePartsSnapshot();
+
         if (!data_parts_by_state_and_info.modify(it, getStateModifier(state)))
             throw Exception(ErrorCodes::LOGICAL_ERROR, "Can't modify {}", (*it)->getNameWithState());
     }
 
     void modifyPartState(DataPartIteratorByInfo it, DataPartState state)
     {
+        resetActivePartsSnapshot();
+
         if (!data_parts_by_state_and_info.modify(data_parts_indexes.project<TagByStateAndInfo>(it), getStateModifier(state)))
             throw Exception(ErrorCodes::LOGICAL_ERROR, "Can't modify {}", (*it)->getNameWithState());
     }
@@ -1213,6 +1257,8 @@ protected:
         if (it == data_parts_by_info.end() || (*it).get() != part.get())
             throw Exception(ErrorCodes::LOGICAL_ERROR, "Part {} doesn't exist", part->name);
 
+        resetActivePartsSnapshot();
+
         if (!data_parts_by_state_and_info.modify(data_parts_indexes.project<TagByStateAndInfo>(it), getStateModifier(state)))
             throw Exception(ErrorCodes::LOGICAL_ERROR, "Can't modify {}", (*it)->getNameWithState());
     }
@@ -4,6 +4,7 @@
 #include <Storages/MergeTree/MergedColumnOnlyOutputStream.h>
 #include <Storages/MergeTree/SimpleMergeSelector.h>
 #include <Storages/MergeTree/AllMergeSelector.h>
+#include <Storages/MergeTree/LeveledMergeSelector.h>
 #include <Storages/MergeTree/TTLMergeSelector.h>
 #include <Storages/MergeTree/MergeList.h>
 #include <Storages/MergeTree/MergeTreeDataWriter.h>
@@ -359,17 +360,31 @@ SelectPartsDecision MergeTreeDataMergerMutator::selectPartsToMerge(
 
     if (parts_to_merge.empty())
     {
-        SimpleMergeSelector::Settings merge_settings;
-        /// Override value from table settings
-        merge_settings.max_parts_to_merge_at_once = data_settings->max_parts_to_merge_at_once;
-        if (!data_settings->min_age_to_force_merge_on_partition_only)
-            merge_settings.min_age_to_force_merge = data_settings->min_age_to_force_merge_seconds;
+        if (data_settings->enable_leveled_compaction && !aggressive)
+        {
+            LeveledMergeSelector::Settings leveled_settings;
+            leveled_settings.base_bytes = data_settings->leveled_compaction_base_bytes;
+            leveled_settings.fan_out = std::max<size_t>(2, data_settings->leveled_compaction_fan_out);
+            leveled_settings.max_parts_to_merge_at_once = data_settings->max_parts_to_merge_at_once;
+            leveled_settings.settle_age = data_settings->leveled_compaction_settle_age_seconds;
+
+            parts_to_merge = LeveledMergeSelector(leveled_settings)
+                                .select(parts_ranges, max_total_size_to_merge);
+        }
+        else
+        {
+            SimpleMergeSelector::Settings merge_settings;
+            /// Override value from table settings
+            merge_settings.max_parts_to_merge_at_once = data_settings->max_parts_to_merge_at_once;
+            if (!data_settings->min_age_to_force_merge_on_partition_only)
+                merge_settings.min_age_to_force_merge = data_settings->min_age_to_force_merge_seconds;
 
-        if (aggressive)
-            merge_settings.base = 1;
+            if (aggressive)
+                merge_settings.base = 1;
 
-        parts_to_merge = SimpleMergeSelector(merge_settings)
-                            .select(parts_ranges, max_total_size_to_merge);
+            parts_to_merge = SimpleMergeSelector(merge_settings)
+                                .select(parts_ranges, max_total_size_to_merge);
+        }
 
         /// Do not allow to "merge" part with itself for regular merges, unless it is a TTL-merge where it is ok to remove some values with expired ttl
         if (parts_to_merge.size() == 1)
@@ -418,7 +433,9 @@ SelectPartsDecision MergeTreeDataMergerMutator::selectAllPartsToMergeWithinParti
     const StorageMetadataPtr & metadata_snapshot,
     const MergeTreeTransactionPtr & txn,
     String * out_disable_reason,
-    bool optimize_skip_merged_partitions)
+    bool optimize_skip_merged_partitions,
+    bool deduplicate,
+    const Names & deduplicate_by_columns)
 {
     MergeTreeData::DataPartsVector parts = selectAllPartsFromPartition(partition_id);
 
@@ -446,6 +463,18 @@ SelectPartsDecision MergeTreeDataMergerMutator::selectAllPartsToMergeWithinParti
         return SelectPartsDecision::NOTHING_TO_MERGE;
     }
 
+    /// Incremental OPTIMIZE ... DEDUPLICATE: if the partition is already merged into one part
+    /// which is known to be the result of a deduplicating merge by a compatible set of columns,
+    /// merging it with itself cannot remove anything, so don't rewrite it.
+    if (final && deduplicate && parts.size() == 1 && parts[0]->info.level > 0
+        && parts[0]->isDeduplicatedBy(deduplicate_by_columns)
+        && (!metadata_snapshot->hasAnyTTL() || parts[0]->checkAllTTLCalculated(metadata_snapshot)))
+    {
+        if (out_disable_reason)
+            *out_disable_reason = "Partition skipped because its single part is already deduplicated by a compatible set of columns";
+        return SelectPartsDecision::NOTHING_TO_MERGE;
+    }
+
     auto it = parts.begin();
     auto prev_it = it;
 
@@ -82,6 +82,8 @@ public:
       * final - choose to merge even a single part - that is, allow to merge one part "with itself",
       * but if setting optimize_skip_merged_partitions is true than single part with level > 0
       * and without expired TTL won't be merged with itself.
+      * A single part is also not merged with itself if `deduplicate` is set and the part is known
+      * to be already deduplicated by a compatible set of columns.
       */
     SelectPartsDecision selectAllPartsToMergeWithinPartition(
         FutureMergedMutatedPartPtr future_part,
@@ -91,7 +93,9 @@ public:
         const StorageMetadataPtr & metadata_snapshot,
         const MergeTreeTransactionPtr & txn,
         String * out_disable_reason = nullptr,
-        bool optimize_skip_merged_partitions = false);
+        bool optimize_skip_merged_partitions = false,
+        bool deduplicate = false,
+        const Names & deduplicate_by_columns = {});
 
     /** Creates a task to merge parts.
       * If `reservation != nullptr`, now and then reduces the size of the reserved space
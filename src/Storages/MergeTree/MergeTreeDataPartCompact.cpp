@@ -2,6 +2,7 @@
 #include <DataTypes/NestedUtils.h>
 #include <Storages/MergeTree/MergeTreeReaderCompact.h>
 #include <Storages/MergeTree/MergeTreeDataPartWriterCompact.h>
+#include <Storages/MergeTree/MergeTreeMarksLoader.h>
 #include <Interpreters/Context.h>
 #include <Storages/MergeTree/LoadedMergeTreeDataPartInfoForReader.h>
 #include <Compression/CompressedReadBufferFromFile.h>
@@ -142,6 +143,24 @@ void MergeTreeDataPartCompact::loadIndexGranularity()
     loadIndexGranularityImpl(index_granularity, index_granularity_info, columns.size(), getDataPartStorage());
 }
 
+void MergeTreeDataPartCompact::loadMarksToCache(MarkCache * mark_cache) const
+{
+    if (!mark_cache)
+        return;
+
+    MergeTreeMarksLoader loader(
+        getDataPartStoragePtr(),
+        mark_cache,
+        index_granularity_info.getMarksFilePath(DATA_FILE_NAME),
+        index_granularity.getMarksCount(),
+        index_granularity_info,
+        /* save_marks_in_cache = */ true,
+        storage.getContext()->getReadSettings(),
+        /* load_marks_threadpool = */ nullptr,
+        columns.size());
+    loader.loadMarks();
+}
+
 bool MergeTreeDataPartCompact::hasColumnFiles(const NameAndTypePair & column) const
 {
     if (!getColumnPosition(column.getNameInStorage()))
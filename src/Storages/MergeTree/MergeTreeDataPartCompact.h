@@ -62,6 +62,8 @@ public:
 
     String getFileNameForColumn(const NameAndTypePair & /* column */) const override { return DATA_FILE_NAME; }
 
+    void loadMarksToCache(MarkCache * mark_cache) const override;
+
     ~MergeTreeDataPartCompact() override;
 
 protected:
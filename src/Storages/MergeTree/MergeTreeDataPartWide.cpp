@@ -3,8 +3,10 @@
 #include <Storages/MergeTree/MergeTreeDataPartWriterWide.h>
 #include <Storages/MergeTree/IMergeTreeDataPartWriter.h>
 #include <Storages/MergeTree/LoadedMergeTreeDataPartInfoForReader.h>
+#include <Storages/MergeTree/MergeTreeMarksLoader.h>
 #include <DataTypes/NestedUtils.h>
 #include <Core/NamesAndTypes.h>
+#include <Interpreters/Context.h>
 
 
 namespace DB
@@ -165,6 +167,41 @@ void MergeTreeDataPartWide::loadIndexGranularity()
     loadIndexGranularityImpl(index_granularity, index_granularity_info, getDataPartStorage(), getFileNameForColumn(columns.front()));
 }
 
+void MergeTreeDataPartWide::loadMarksToCache(MarkCache * mark_cache) const
+{
+    if (!mark_cache)
+        return;
+
+    auto read_settings = storage.getContext()->getReadSettings();
+    auto marks_file_extension = index_granularity_info.mark_type.getFileExtension();
+    size_t marks_count = index_granularity.getMarksCount();
+    std::unordered_set<String> processed_streams;
+
+    for (const auto & column : columns)
+    {
+        getSerialization(column.name)->enumerateStreams([&](const ISerialization::SubstreamPath & substream_path)
+        {
+            String stream_name = ISerialization::getFileNameForStream(column, substream_path);
+
+            if (!processed_streams.insert(stream_name).second)
+                return;
+
+            if (!checksums.files.contains(stream_name + marks_file_extension))
+                return;
+
+            MergeTreeMarksLoader loader(
+                getDataPartStoragePtr(),
+                mark_cache,
+                index_granularity_info.getMarksFilePath(stream_name),
+                marks_count,
+                index_granularity_info,
+                /* save_marks_in_cache = */ true,
+                read_settings,
+                /* load_marks_threadpool = */ nullptr);
+            loader.loadMarks();
+        });
+    }
+}
 
 bool MergeTreeDataPartWide::isStoredOnRemoteDisk() const
 {
@@ -289,6 +326,39 @@ void MergeTreeDataPartWide::calculateEachColumnSizes(ColumnSizeByName & each_col
         each_columns_size[column.name] = size;
         total_size.add(size);
 
+        /// Also account the substreams of each subcolumn separately (e.g. Map keys and values),
+        /// so that the cost of reading an individual subcolumn can be estimated.
+        /// Subcolumns share substreams with the main column, so they are not added to the total size.
+        for (const auto & subcolumn_name : column.type->getSubcolumnNames())
+        {
+            NameAndTypePair subcolumn(column.name, subcolumn_name, column.type, column.type->getSubcolumnType(subcolumn_name));
+
+            SerializationPtr subcolumn_serialization;
+            if (auto it = serialization_infos.find(column.name); it != serialization_infos.end())
+                subcolumn_serialization = IDataType::getSerialization(subcolumn, *it->second);
+            else
+                subcolumn_serialization = IDataType::getSerialization(subcolumn);
+
+            ColumnSize subcolumn_size;
+            subcolumn_serialization->enumerateStreams([&](const ISerialization::SubstreamPath & substream_path)
+            {
+                String file_name = ISerialization::getFileNameForStream(subcolumn, substream_path);
+
+                auto bin_checksum = checksums.files.find(file_name + ".bin");
+                if (bin_checksum != checksums.files.end())
+                {
+                    subcolumn_size.data_compressed += bin_checksum->second.file_size;
+                    subcolumn_size.data_uncompressed += bin_checksum->second.uncompressed_size;
+                }
+
+                auto mrk_checksum = checksums.files.find(file_name + getMarksFileExtension());
+                if (mrk_checksum != checksums.files.end())
+                    subcolumn_size.marks += mrk_checksum->second.file_size;
+            });
+
+            each_columns_size[subcolumn.name] = subcolumn_size;
+        }
+
 #ifndef NDEBUG
         /// Most trivial types
         if (rows_count != 0
@@ -57,6 +57,8 @@ public:
 
     String getFileNameForColumn(const NameAndTypePair & column) const override;
 
+    void loadMarksToCache(MarkCache * mark_cache) const override;
+
     ~MergeTreeDataPartWide() override;
 
     bool hasColumnFiles(const NameAndTypePair & column) const override;
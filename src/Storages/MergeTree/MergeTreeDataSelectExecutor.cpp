@@ -10,6 +10,7 @@
 #include <Storages/MergeTree/MergeTreeDataPartUUID.h>
 #include <Storages/MergeTree/StorageFromMergeTreeDataPart.h>
 #include <Storages/MergeTree/MergeTreeIndexInverted.h>
+#include <Storages/QueryConditionCache.h>
 #include <Storages/ReadInOrderOptimizer.h>
 #include <Storages/VirtualColumnUtils.h>
 #include <Parsers/ASTIdentifier.h>
@@ -35,6 +36,7 @@
 #include <Processors/Transforms/AggregatingTransform.h>
 
 #include <Core/UUID.h>
+#include <Common/SipHash.h>
 #include <DataTypes/DataTypeDate.h>
 #include <DataTypes/DataTypeEnum.h>
 #include <DataTypes/DataTypeUUID.h>
@@ -389,8 +391,18 @@ QueryPlanPtr MergeTreeDataSelectExecutor::read(
                 SortDescription group_by_sort_description;
                 if (group_by_info && settings.optimize_aggregation_in_order)
                 {
-                    group_by_sort_description = getSortDescriptionFromGroupBy(select_query);
                     sort_description_for_merging = group_by_info->sort_description_for_merging;
+
+                    /// Group by keys may have been matched with the sorting key in arbitrary order,
+                    /// put the matched prefix first (see InterpreterSelectQuery::executeAggregation).
+                    group_by_sort_description = sort_description_for_merging;
+                    NameSet merging_columns;
+                    for (const auto & column : sort_description_for_merging)
+                        merging_columns.insert(column.column_name);
+
+                    for (const auto & column : getSortDescriptionFromGroupBy(select_query))
+                        if (!merging_columns.contains(column.column_name))
+                            group_by_sort_description.push_back(column);
                 }
                 else
                     group_by_info = nullptr;
@@ -600,6 +612,26 @@ MergeTreeDataSelectSamplingData MergeTreeDataSelectExecutor::getSampling(
     sampling.use_sampling = relative_sample_size > 0 || (settings.parallel_replicas_count > 1 && data.supportsSampling());
     bool no_data = false;   /// There is nothing left after sampling.
 
+    /// The table has no sampling key, but SAMPLE was allowed by `allow_sample_without_sampling_key`:
+    /// instead of a range over the sampling key, a pseudo-random subset of granules will be selected
+    /// after the index analysis. The selection is deterministic (it depends only on part names and
+    /// mark numbers), so all replicas see the same subset.
+    if (sampling.use_sampling && !data.supportsSampling())
+    {
+        if (sample_factor_column_queried && relative_sample_size != RelativeSize(0))
+            sampling.used_sample_factor = 1.0 / boost::rational_cast<Float64>(relative_sample_size);
+
+        sampling.use_sampling = false;
+        sampling.use_granule_sampling = true;
+        sampling.granule_sample_ratio = boost::rational_cast<Float64>(relative_sample_size);
+        sampling.granule_sample_offset = boost::rational_cast<Float64>(relative_sample_offset);
+
+        LOG_DEBUG(log, "Sampling without sampling key: will select {} of granules pseudo-randomly",
+            sampling.granule_sample_ratio);
+
+        return sampling;
+    }
+
     if (sampling.use_sampling)
     {
         if (sample_factor_column_queried && relative_sample_size != RelativeSize(0))
@@ -939,6 +971,8 @@ RangesInDataParts MergeTreeDataSelectExecutor::filterPartsByPrimaryKeyAndSkipInd
         }
     }
 
+    std::unordered_set<std::string> forced_indices_names;
+
     if (use_skip_indexes && settings.force_data_skipping_indices.changed)
     {
         const auto & indices = settings.force_data_skipping_indices.toString();
@@ -969,6 +1003,44 @@ RangesInDataParts MergeTreeDataSelectExecutor::filterPartsByPrimaryKeyAndSkipInd
                     backQuote(index_name));
             }
         }
+
+        forced_indices_names.insert(forced_indices.begin(), forced_indices.end());
+    }
+
+    /// Consulting an index that almost never drops granules is pure overhead: its granules are
+    /// still read and evaluated for all selected ranges. Skip indexes whose effectiveness observed
+    /// in the previous queries on this table is below the threshold.
+    if (use_skip_indexes && settings.skip_indexes_min_effectiveness_ratio > 0. && !parts.empty())
+    {
+        /// An index is given this many granules to prove itself before it can be disabled.
+        constexpr size_t min_granules_tested = 1000;
+
+        auto index_usage = parts.front()->storage.getSecondaryIndexUsage();
+        for (auto it = useful_indices.begin(); it != useful_indices.end();)
+        {
+            const auto & index_name = it->index->index.name;
+
+            bool ineffective = false;
+            if (auto usage_it = index_usage.find(index_name); usage_it != index_usage.end())
+            {
+                const auto & usage = usage_it->second;
+                ineffective = usage.granules_tested >= min_granules_tested
+                    && usage.granules_dropped < settings.skip_indexes_min_effectiveness_ratio * usage.granules_tested;
+            }
+
+            if (ineffective && !forced_indices_names.contains(index_name))
+            {
+                LOG_DEBUG(
+                    log,
+                    "Index {} has dropped only {}/{} granules in previous queries, will not be consulted.",
+                    backQuote(index_name),
+                    index_usage[index_name].granules_dropped,
+                    index_usage[index_name].granules_tested);
+                it = useful_indices.erase(it);
+            }
+            else
+                ++it;
+        }
     }
 
     std::atomic<size_t> sum_marks_pk = 0;
@@ -999,6 +1071,13 @@ RangesInDataParts MergeTreeDataSelectExecutor::filterPartsByPrimaryKeyAndSkipInd
         auto mark_cache = context->getIndexMarkCache();
         auto uncompressed_cache = context->getIndexUncompressedCache();
 
+        /// Hash of the PREWHERE condition for lookups in the query condition cache.
+        /// The cache is filled with the deleted mask applied, so don't consult it otherwise.
+        std::optional<UInt64> condition_hash;
+        if (reader_settings.query_condition_cache && reader_settings.apply_deleted_mask)
+            condition_hash = QueryConditionCache::conditionHash(
+                query_info.projection ? query_info.projection->prewhere_info.get() : query_info.prewhere_info.get());
+
         auto process_part = [&](size_t part_index)
         {
             auto & part = parts[part_index];
@@ -1069,6 +1148,10 @@ RangesInDataParts MergeTreeDataSelectExecutor::filterPartsByPrimaryKeyAndSkipInd
                     indices_and_condition.stat.parts_dropped.fetch_add(1, std::memory_order_relaxed);
             }
 
+            if (!ranges.ranges.empty() && condition_hash)
+                ranges.ranges = reader_settings.query_condition_cache->filterMarkRanges(
+                    QueryConditionCache::hash(part->getDataPartStorage().getFullPath(), *condition_hash), ranges.ranges);
+
             if (!ranges.ranges.empty())
             {
                 if (limits.max_rows || leaf_limits.max_rows)
@@ -1157,6 +1240,10 @@ RangesInDataParts MergeTreeDataSelectExecutor::filterPartsByPrimaryKeyAndSkipInd
             index_and_condition.stat.granules_dropped,
             index_and_condition.stat.total_granules);
 
+        if (!parts.empty())
+            parts.front()->storage.addSecondaryIndexUsage(
+                index_name, index_and_condition.stat.total_granules, index_and_condition.stat.granules_dropped);
+
         std::string description
             = index_and_condition.index->index.type + " GRANULARITY " + std::to_string(index_and_condition.index->index.granularity);
 
@@ -1188,6 +1275,59 @@ RangesInDataParts MergeTreeDataSelectExecutor::filterPartsByPrimaryKeyAndSkipInd
     return parts_with_ranges;
 }
 
+RangesInDataParts MergeTreeDataSelectExecutor::sampleRangesByGranules(
+    RangesInDataParts && parts_with_ranges,
+    const MergeTreeDataSelectSamplingData & sampling,
+    Poco::Logger * log)
+{
+    /// As with a sampling key, the interval is cut by the end of the universe: SAMPLE 0.4 OFFSET 0.8
+    /// selects only 0.2 of granules.
+    Float64 lower = sampling.granule_sample_offset;
+    Float64 upper = lower + sampling.granule_sample_ratio;
+
+    size_t total_marks = 0;
+    size_t selected_marks = 0;
+
+    RangesInDataParts sampled_parts;
+    sampled_parts.reserve(parts_with_ranges.size());
+
+    for (const auto & part_with_ranges : parts_with_ranges)
+    {
+        RangesInDataPart sampled_part(part_with_ranges.data_part, part_with_ranges.part_index_in_query);
+
+        for (const auto & range : part_with_ranges.ranges)
+        {
+            for (size_t mark = range.begin; mark < range.end; ++mark)
+            {
+                ++total_marks;
+
+                SipHash hash;
+                hash.update(part_with_ranges.data_part->name);
+                hash.update(mark);
+
+                /// Normalize the hash to [0, 1) and check it against the requested interval.
+                Float64 point = std::ldexp(static_cast<Float64>(hash.get64()), -64);
+                if (point < lower || point >= upper)
+                    continue;
+
+                ++selected_marks;
+                if (!sampled_part.ranges.empty() && sampled_part.ranges.back().end == mark)
+                    ++sampled_part.ranges.back().end;
+                else
+                    sampled_part.ranges.emplace_back(mark, mark + 1);
+            }
+        }
+
+        if (!sampled_part.ranges.empty())
+            sampled_parts.push_back(std::move(sampled_part));
+    }
+
+    LOG_DEBUG(log, "Sampling without sampling key: selected {}/{} granules in {}/{} parts",
+        selected_marks, total_marks, sampled_parts.size(), parts_with_ranges.size());
+
+    return sampled_parts;
+}
+
 std::shared_ptr<QueryIdHolder> MergeTreeDataSelectExecutor::checkLimits(
     const MergeTreeData & data,
     const ReadFromMergeTree::AnalysisResult & result,
@@ -1446,7 +1586,6 @@ MarkRanges MergeTreeDataSelectExecutor::markRangesFromPKRange(
     MarkRanges res;
 
     size_t marks_count = part->index_granularity.getMarksCount();
-    const auto & index = part->index;
     if (marks_count == 0)
         return res;
 
@@ -1463,6 +1602,7 @@ MarkRanges MergeTreeDataSelectExecutor::markRangesFromPKRange(
         return res;
     }
 
+    const auto & index = part->getIndex();
     size_t used_key_size = key_condition.getMaxKeyColumn() + 1;
     const String & part_name = part->isProjectionPart() ? fmt::format("{}.{}", part->name, part->getParentPart()->name) : part->name;
 
@@ -1585,6 +1725,17 @@ MarkRanges MergeTreeDataSelectExecutor::markRangesFromPKRange(
         /// we can use binary search algorithm to find the left and right endpoint key marks of such interval.
         /// The returned value is the minimum range of marks, containing all keys for which KeyCondition holds
 
+        /// With many small parts (e.g. a point lookup over a table with a long insertion history)
+        /// most parts do not intersect the interval at all. Check the whole part first, so that
+        /// such parts are pruned with a single index comparison instead of O(log(marks)) of them.
+        /// The exclusion search above does this implicitly by starting from the whole mark range.
+        MarkRange whole_part_range(0, marks_count);
+        if (!may_be_true_in_range(whole_part_range))
+        {
+            LOG_TRACE(log, "Not using index on part {}: the whole part does not intersect the key range", part_name);
+            return res;
+        }
+
         LOG_TRACE(log, "Running binary search on index range for part {} ({} marks)", part_name, marks_count);
 
         size_t steps = 0;
@@ -1630,6 +1781,56 @@ MarkRanges MergeTreeDataSelectExecutor::markRangesFromPKRange(
     return res;
 }
 
+std::optional<UInt64> MergeTreeDataSelectExecutor::countRowsByPrimaryKeyCondition(
+    const MergeTreeData::DataPartPtr & part,
+    const StorageMetadataPtr & metadata_snapshot,
+    const KeyCondition & key_condition)
+{
+    size_t marks_count = part->index_granularity.getMarksCount();
+    if (marks_count == 0)
+        return 0;
+
+    /// Granules of the sparse index overlap at their boundary keys: the first key of a granule
+    /// may also be the last key of the previous one. So the condition can be decided without
+    /// reading only if it is constant over the whole key range of the part. The range is the
+    /// first index entry to the last one (which is the key of the last row when the part has a
+    /// final mark) or to infinity otherwise.
+    bool has_final_mark = part->index_granularity.hasFinalMark();
+
+    const auto & index = part->getIndex();
+    const auto & primary_key = metadata_snapshot->getPrimaryKey();
+    size_t used_key_size = key_condition.getMaxKeyColumn() + 1;
+
+    /// NOTE Creating temporary Field objects to pass to KeyCondition.
+    std::vector<FieldRef> index_left(used_key_size);
+    std::vector<FieldRef> index_right(used_key_size);
+
+    for (size_t i = 0; i < used_key_size; ++i)
+    {
+        index[i]->get(0, index_left[i]);
+        // NULL_LAST
+        if (index_left[i].isNull())
+            index_left[i] = POSITIVE_INFINITY;
+
+        if (has_final_mark)
+        {
+            index[i]->get(marks_count - 1, index_right[i]);
+            if (index_right[i].isNull())
+                index_right[i] = POSITIVE_INFINITY;
+        }
+        else
+            index_right[i] = POSITIVE_INFINITY;
+    }
+
+    BoolMask match = key_condition.checkInRange(used_key_size, index_left.data(), index_right.data(), primary_key.data_types);
+
+    if (!match.can_be_true)
+        return 0;
+    if (!match.can_be_false)
+        return part->rows_count;
+    return {};
+}
+
 
 MarkRanges MergeTreeDataSelectExecutor::filterMarksUsingIndex(
     MergeTreeIndexPtr index_helper,
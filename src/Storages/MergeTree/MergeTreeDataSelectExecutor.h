@@ -73,6 +73,14 @@ public:
         const Settings & settings,
         Poco::Logger * log);
 
+    /// Count the rows of the part satisfying the key condition using only the primary index.
+    /// Returns the full or zero count when the condition is constant over the key range of the
+    /// part, and nothing when an exact answer would require reading data.
+    static std::optional<UInt64> countRowsByPrimaryKeyCondition(
+        const MergeTreeData::DataPartPtr & part,
+        const StorageMetadataPtr & metadata_snapshot,
+        const KeyCondition & key_condition);
+
 private:
     const MergeTreeData & data;
     Poco::Logger * log;
@@ -198,6 +206,15 @@ public:
         ReadFromMergeTree::IndexStats & index_stats,
         bool use_skip_indexes);
 
+    /// Sampling for tables without a sampling key (allow_sample_without_sampling_key):
+    /// keep a pseudo-random subset of already selected granules. A granule survives if the hash
+    /// of (part name, mark number) falls into the requested [offset, offset + ratio) interval,
+    /// so the selection is deterministic across replicas.
+    static RangesInDataParts sampleRangesByGranules(
+        RangesInDataParts && parts_with_ranges,
+        const MergeTreeDataSelectSamplingData & sampling,
+        Poco::Logger * log);
+
     /// Create expression for sampling.
     /// Also, calculate _sample_factor if needed.
     /// Also, update key condition with selected sampling range.
@@ -13,6 +13,12 @@ namespace DB
 class MMappedFileCache;
 using MMappedFileCachePtr = std::shared_ptr<MMappedFileCache>;
 
+class ColumnsCache;
+using ColumnsCachePtr = std::shared_ptr<ColumnsCache>;
+
+class QueryConditionCache;
+using QueryConditionCachePtr = std::shared_ptr<QueryConditionCache>;
+
 
 struct MergeTreeReaderSettings
 {
@@ -29,6 +35,17 @@ struct MergeTreeReaderSettings
     bool apply_deleted_mask = true;
     /// Put reading task in a common I/O pool, return Async state on prepare()
     bool use_asynchronous_read_from_pool = false;
+    /// If PREWHERE has conditions with different columns, execute them in separate read/filter steps.
+    bool enable_multiple_prewhere_read_steps = false;
+    /// On remote disks, read all byte ranges selected by the index into the filesystem cache
+    /// in the background before decoding starts.
+    bool prefetch_mark_ranges_into_cache = false;
+    /// Byte ranges separated by a gap up to this size are prefetched as one range.
+    size_t mark_ranges_coalesce_gap = 0;
+    /// Cache of deserialized columns for reading from Wide parts (disabled if nullptr).
+    ColumnsCachePtr columns_cache;
+    /// Cache of per-granule filter condition results (disabled if nullptr).
+    QueryConditionCachePtr query_condition_cache;
 };
 
 struct MergeTreeWriterSettings
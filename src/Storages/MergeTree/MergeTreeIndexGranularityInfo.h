@@ -30,7 +30,15 @@ struct MarkType
 };
 
 
-/// Meta information about index granularity
+/// Meta information about index granularity.
+///
+/// Granularity is a property of the whole part, not of individual columns: the primary index,
+/// the mark ranges produced by index analysis and the readers all address data by part-wide
+/// granule numbers, so the mark files of all columns must have exactly one entry per granule.
+/// Per-column granularity is therefore not expressible in this format. To limit read
+/// amplification for tables with wide values (e.g. large String blobs) use adaptive
+/// granularity (index_granularity_bytes), which sizes granules by row bytes instead of
+/// a fixed row count.
 struct MergeTreeIndexGranularityInfo
 {
 public:
@@ -312,35 +312,55 @@ bool MergeTreeIndexConditionSet::mayBeTrueOnGranule(MergeTreeIndexGranulePtr idx
     if (isUseless() || granule->empty() || (max_rows != 0 && granule->size() > max_rows))
         return true;
 
-    Block result = granule->block;
-    actions->execute(result);
+    const auto & granule_block = granule->block;
+    size_t rows = granule_block.rows();
 
-    const auto & filter_node_name = actions->getActionsDAG().getOutputs().at(0)->result_name;
-    auto column = result.getByName(filter_node_name).column->convertToFullColumnIfConst()->convertToFullColumnIfLowCardinality();
+    /// The granule cannot be skipped if the condition may be true for at least one value of
+    /// the set. Evaluate the condition over the set in batches, so that for a granule that
+    /// cannot be skipped (the common case - the matching value is likely within the first
+    /// batch) the condition is not computed for the whole set.
+    constexpr size_t batch_size = 256;
 
-    if (column->onlyNull())
-        return false;
+    for (size_t offset = 0; offset < rows; offset += batch_size)
+    {
+        size_t length = std::min(batch_size, rows - offset);
 
-    const auto * col_uint8 = typeid_cast<const ColumnUInt8 *>(column.get());
+        Block result;
+        if (length == rows)
+            result = granule_block;
+        else
+            for (const auto & column_with_type : granule_block)
+                result.insert({column_with_type.column->cut(offset, length), column_with_type.type, column_with_type.name});
 
-    const NullMap * null_map = nullptr;
+        actions->execute(result);
 
-    if (const auto * col_nullable = checkAndGetColumn<ColumnNullable>(*column))
-    {
-        col_uint8 = typeid_cast<const ColumnUInt8 *>(&col_nullable->getNestedColumn());
-        null_map = &col_nullable->getNullMapData();
-    }
+        const auto & filter_node_name = actions->getActionsDAG().getOutputs().at(0)->result_name;
+        auto column = result.getByName(filter_node_name).column->convertToFullColumnIfConst()->convertToFullColumnIfLowCardinality();
 
-    if (!col_uint8)
-        throw Exception(ErrorCodes::LOGICAL_ERROR,
-            "ColumnUInt8 expected as Set index condition result");
+        if (column->onlyNull())
+            continue;
 
-    const auto & condition = col_uint8->getData();
-    size_t column_size = column->size();
+        const auto * col_uint8 = typeid_cast<const ColumnUInt8 *>(column.get());
 
-    for (size_t i = 0; i < column_size; ++i)
-        if ((!null_map || (*null_map)[i] == 0) && condition[i] & 1)
-            return true;
+        const NullMap * null_map = nullptr;
+
+        if (const auto * col_nullable = checkAndGetColumn<ColumnNullable>(*column))
+        {
+            col_uint8 = typeid_cast<const ColumnUInt8 *>(&col_nullable->getNestedColumn());
+            null_map = &col_nullable->getNullMapData();
+        }
+
+        if (!col_uint8)
+            throw Exception(ErrorCodes::LOGICAL_ERROR,
+                "ColumnUInt8 expected as Set index condition result");
+
+        const auto & condition = col_uint8->getData();
+        size_t column_size = column->size();
+
+        for (size_t i = 0; i < column_size; ++i)
+            if ((!null_map || (*null_map)[i] == 0) && condition[i] & 1)
+                return true;
+    }
 
     return false;
 }
@@ -62,7 +62,7 @@ MergeTreeMarksLoader::~MergeTreeMarksLoader()
 }
 
 
-const MarkInCompressedFile & MergeTreeMarksLoader::getMark(size_t row_index, size_t column_index)
+MarkInCompressedFile MergeTreeMarksLoader::getMark(size_t row_index, size_t column_index)
 {
     if (!marks)
     {
@@ -87,7 +87,7 @@ const MarkInCompressedFile & MergeTreeMarksLoader::getMark(size_t row_index, siz
         throw Exception(ErrorCodes::LOGICAL_ERROR, "Column index: {} is out of range [0, {})", column_index, columns_in_mark);
 #endif
 
-    return (*marks)[row_index * columns_in_mark + column_index];
+    return marks->get(row_index * columns_in_mark + column_index);
 }
 
 
@@ -100,7 +100,9 @@ MarkCache::MappedPtr MergeTreeMarksLoader::loadMarksImpl()
     size_t mark_size = index_granularity_info.getMarkSizeInBytes(columns_in_mark);
     size_t expected_uncompressed_size = mark_size * marks_count;
 
-    auto res = std::make_shared<MarksInCompressedFile>(marks_count * columns_in_mark);
+    /// Marks are read into a plain array first and bit-packed afterwards,
+    /// because the packed representation is immutable.
+    MarksInCompressedFile::PlainArray plain_marks(marks_count * columns_in_mark);
 
     if (!index_granularity_info.mark_type.compressed && expected_uncompressed_size != file_size)
         throw Exception(
@@ -109,7 +111,19 @@ MarkCache::MappedPtr MergeTreeMarksLoader::loadMarksImpl()
             std::string(fs::path(data_part_storage->getFullPath()) / mrk_path),
             file_size, expected_uncompressed_size);
 
-    auto buffer = data_part_storage->readFile(mrk_path, read_settings.adjustBufferSize(file_size), file_size, std::nullopt);
+    auto marks_read_settings = read_settings.adjustBufferSize(file_size);
+
+    /// Mark files are reread whenever they are evicted from the mark cache, and they are usually
+    /// still hot in the OS page cache, so mapping them is cheaper than copying them through
+    /// a buffered stream. Compressed marks have to be decompressed anyway and on remote disks
+    /// the local read method does not apply.
+    if (read_settings.load_marks_with_mmap && !index_granularity_info.mark_type.compressed && !data_part_storage->isStoredOnRemoteDisk())
+    {
+        marks_read_settings.local_fs_method = LocalFSReadMethod::mmap;
+        marks_read_settings.mmap_threshold = 1;
+    }
+
+    auto buffer = data_part_storage->readFile(mrk_path, marks_read_settings, file_size, std::nullopt);
     std::unique_ptr<ReadBuffer> reader;
     if (!index_granularity_info.mark_type.compressed)
         reader = std::move(buffer);
@@ -119,7 +133,7 @@ MarkCache::MappedPtr MergeTreeMarksLoader::loadMarksImpl()
     if (!index_granularity_info.mark_type.adaptive)
     {
         /// Read directly to marks.
-        reader->readStrict(reinterpret_cast<char *>(res->data()), expected_uncompressed_size);
+        reader->readStrict(reinterpret_cast<char *>(plain_marks.data()), expected_uncompressed_size);
 
         if (!reader->eof())
             throw Exception(ErrorCodes::CANNOT_READ_ALL_DATA,
@@ -132,7 +146,9 @@ MarkCache::MappedPtr MergeTreeMarksLoader::loadMarksImpl()
         size_t granularity;
         while (!reader->eof())
         {
-            res->read(*reader, i * columns_in_mark, columns_in_mark);
+            reader->readStrict(
+                reinterpret_cast<char *>(plain_marks.data() + i * columns_in_mark),
+                columns_in_mark * sizeof(MarkInCompressedFile));
             readIntBinary(granularity, *reader);
             ++i;
         }
@@ -141,8 +157,7 @@ MarkCache::MappedPtr MergeTreeMarksLoader::loadMarksImpl()
             throw Exception(ErrorCodes::CANNOT_READ_ALL_DATA, "Cannot read all marks from file {}", mrk_path);
     }
 
-    res->protect();
-    return res;
+    return std::make_shared<MarksInCompressedFile>(plain_marks);
 }
 
 MarkCache::MappedPtr MergeTreeMarksLoader::loadMarks()
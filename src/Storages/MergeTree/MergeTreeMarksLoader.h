@@ -30,7 +30,11 @@ public:
 
     ~MergeTreeMarksLoader();
 
-    const MarkInCompressedFile & getMark(size_t row_index, size_t column_index = 0);
+    MarkInCompressedFile getMark(size_t row_index, size_t column_index = 0);
+
+    /// Load the marks (from the mark cache if they are already there). Called implicitly by getMark(),
+    /// public to allow warming up the mark cache without reading any data (see loadMarksToCache()).
+    MarkCache::MappedPtr loadMarks();
 
 private:
     DataPartStoragePtr data_part_storage;
@@ -42,8 +46,6 @@ private:
     size_t columns_in_mark;
     MarkCache::MappedPtr marks;
     ReadSettings read_settings;
-
-    MarkCache::MappedPtr loadMarks();
     std::future<MarkCache::MappedPtr> loadMarksAsync();
     MarkCache::MappedPtr loadMarksImpl();
 
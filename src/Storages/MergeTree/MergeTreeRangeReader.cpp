@@ -1,4 +1,5 @@
 #include <Storages/MergeTree/IMergeTreeReader.h>
+#include <Storages/QueryConditionCache.h>
 #include <Columns/FilterDescription.h>
 #include <Columns/ColumnConst.h>
 #include <Columns/ColumnsCommon.h>
@@ -8,6 +9,7 @@
 #include <base/range.h>
 #include <Interpreters/castColumn.h>
 #include <DataTypes/DataTypeNothing.h>
+#include <base/unaligned.h>
 #include <bit>
 
 #ifdef __SSE2__
@@ -329,7 +331,7 @@ void MergeTreeRangeReader::ReadResult::clear()
     additional_columns.clear();
 }
 
-void MergeTreeRangeReader::ReadResult::shrink(Columns & old_columns, const NumRows & rows_per_granule_previous) const
+void MergeTreeRangeReader::ReadResult::shrink(Columns & old_columns, const NumRows & rows_per_granule_previous, const NumRows & zero_heads) const
 {
     for (auto & column : old_columns)
     {
@@ -350,7 +352,7 @@ void MergeTreeRangeReader::ReadResult::shrink(Columns & old_columns, const NumRo
         for (size_t j = 0, pos = 0; j < rows_per_granule_previous.size(); pos += rows_per_granule_previous[j++])
         {
             if (rows_per_granule[j])
-                new_column->insertRangeFrom(*column, pos, rows_per_granule[j]);
+                new_column->insertRangeFrom(*column, pos + zero_heads[j], rows_per_granule[j]);
         }
         column = std::move(new_column);
     }
@@ -515,6 +517,43 @@ void MergeTreeRangeReader::ReadResult::optimize(const FilterWithCachedCount & cu
     NumRows zero_tails;
     auto total_zero_rows_in_tails = countZeroTails(filter.getData(), zero_tails, can_read_incomplete_granules);
 
+    /// Zeros at the beginning of a granule can be skipped symmetrically to zeros in the tail:
+    /// the next read steps will start reading the granule from the first row that passed the filter.
+    /// This is the typical filter shape for a point predicate on a sorted column, where the matching
+    /// rows form a contiguous range in the middle of the granule.
+    NumRows zero_heads;
+    auto total_zero_rows_in_heads = countZeroHeads(filter.getData(), zero_heads, zero_tails, can_read_incomplete_granules);
+
+    size_t total_zero_rows = total_zero_rows_in_heads + total_zero_rows_in_tails;
+
+    /// Just a guess. If only a few rows may be skipped, it's better not to skip at all.
+    bool worth_collapsing = 2 * total_zero_rows > filter.size();
+
+    /// Granules with no rows passing the filter at all (e.g. fully deleted by a lightweight DELETE)
+    /// can be skipped without reading any of the remaining columns, which is a win regardless of
+    /// the guess above. If the heads and tails alone do not justify collapsing, retry with only such
+    /// granules, so that their partial heads and tails do not force incomplete reads of the granules
+    /// that are kept.
+    if (!worth_collapsing && total_zero_rows > 0)
+    {
+        size_t rows_in_fully_zero_granules = 0;
+        for (auto i : collections::range(0, rows_per_granule.size()))
+        {
+            if (zero_tails[i] == rows_per_granule[i])
+                rows_in_fully_zero_granules += zero_tails[i];
+            else
+                zero_tails[i] = 0;
+
+            /// Fully zero granules have all their zeros counted in the tail.
+            zero_heads[i] = 0;
+        }
+
+        total_zero_rows_in_heads = 0;
+        total_zero_rows_in_tails = rows_in_fully_zero_granules;
+        total_zero_rows = rows_in_fully_zero_granules;
+        worth_collapsing = rows_in_fully_zero_granules > 0;
+    }
+
     LOG_TEST(log, "ReadResult::optimize() before: {}", dumpInfo());
 
     SCOPE_EXIT(
@@ -525,43 +564,49 @@ void MergeTreeRangeReader::ReadResult::optimize(const FilterWithCachedCount & cu
         }
     );
 
-    if (total_zero_rows_in_tails == filter.size())
+    if (total_zero_rows == filter.size())
     {
         LOG_TEST(log, "ReadResult::optimize() combined filter is const False");
         clear();
         return;
     }
-    else if (total_zero_rows_in_tails == 0 && filter.countBytesInFilter() == filter.size())
+    else if (total_zero_rows == 0 && filter.countBytesInFilter() == filter.size())
     {
         LOG_TEST(log, "ReadResult::optimize() combined filter is const True");
         setFilterConstTrue();
         return;
     }
-    /// Just a guess. If only a few rows may be skipped, it's better not to skip at all.
-    else if (2 * total_zero_rows_in_tails > filter.size())
+    else if (worth_collapsing)
     {
         const NumRows rows_per_granule_previous = rows_per_granule;
         const size_t total_rows_per_granule_previous = total_rows_per_granule;
 
+        if (total_zero_rows_in_heads && num_rows_to_skip_in_granule_heads.empty())
+            num_rows_to_skip_in_granule_heads.resize(rows_per_granule.size(), 0);
+
         for (auto i : collections::range(0, rows_per_granule.size()))
         {
-            rows_per_granule[i] -= zero_tails[i];
+            rows_per_granule[i] -= zero_heads[i] + zero_tails[i];
+            /// Head skips accumulate over steps: they are counted from the start of the granule,
+            /// while zero_heads[i] is relative to the rows that survived the previous steps.
+            if (zero_heads[i])
+                num_rows_to_skip_in_granule_heads[i] += zero_heads[i];
         }
-        num_rows_to_skip_in_last_granule += rows_per_granule_previous.back() - rows_per_granule.back();
-        total_rows_per_granule = total_rows_per_granule_previous - total_zero_rows_in_tails;
+        num_rows_to_skip_in_last_granule += zero_tails.back();
+        total_rows_per_granule = total_rows_per_granule_previous - total_zero_rows;
 
         /// Check if const 1 after shrink.
         /// We can apply shrink only if after the previous step the number of rows in the result
         /// matches the rows_per_granule info. Otherwise we will not be able to match newly added zeros in granule tails.
         if (num_rows == total_rows_per_granule_previous &&
-            filter.countBytesInFilter() + total_zero_rows_in_tails == total_rows_per_granule_previous)  /// All zeros are in tails?
+            filter.countBytesInFilter() + total_zero_rows == total_rows_per_granule_previous)  /// All zeros are in heads and tails?
         {
             setFilterConstTrue();
 
-            /// If all zeros are in granule tails, we can use shrink to filter out rows.
-            shrink(columns, rows_per_granule_previous); /// shrink acts as filtering in such case
+            /// If all zeros are in granule heads and tails, we can use shrink to filter out rows.
+            shrink(columns, rows_per_granule_previous, zero_heads); /// shrink acts as filtering in such case
             auto c = additional_columns.getColumns();
-            shrink(c, rows_per_granule_previous);
+            shrink(c, rows_per_granule_previous, zero_heads);
             additional_columns.setColumns(c);
 
             num_rows = total_rows_per_granule;
@@ -570,11 +615,11 @@ void MergeTreeRangeReader::ReadResult::optimize(const FilterWithCachedCount & cu
         }
         else
         {
-            auto new_filter = ColumnUInt8::create(filter.size() - total_zero_rows_in_tails);
+            auto new_filter = ColumnUInt8::create(filter.size() - total_zero_rows);
             IColumn::Filter & new_data = new_filter->getData();
 
-            /// Shorten the filter by removing zeros from granule tails
-            collapseZeroTails(filter.getData(), rows_per_granule_previous, new_data);
+            /// Shorten the filter by removing zeros from granule heads and tails
+            collapseZeroTails(filter.getData(), rows_per_granule_previous, zero_heads, new_data);
             if (total_rows_per_granule != new_filter->size())
                 throw Exception(ErrorCodes::LOGICAL_ERROR, "New filter size {} doesn't match number of rows to be read {}",
                     new_filter->size(), total_rows_per_granule);
@@ -642,14 +687,43 @@ size_t MergeTreeRangeReader::ReadResult::countZeroTails(const IColumn::Filter &
     return total_zero_rows_in_tails;
 }
 
-void MergeTreeRangeReader::ReadResult::collapseZeroTails(const IColumn::Filter & filter_vec, const NumRows & rows_per_granule_previous, IColumn::Filter & new_filter_vec) const
+size_t MergeTreeRangeReader::ReadResult::countZeroHeads(const IColumn::Filter & filter_vec, NumRows & zero_heads, const NumRows & zero_tails, bool can_read_incomplete_granules) const
+{
+    zero_heads.resize(0);
+    zero_heads.reserve(rows_per_granule.size());
+
+    const auto * filter_data = filter_vec.data();
+
+    size_t total_zero_rows_in_heads = 0;
+
+    for (auto i : collections::range(0, rows_per_granule.size()))
+    {
+        size_t rows_to_read = rows_per_granule[i];
+
+        /// Count the number of zeros at the beginning of filter for rows were read from current granule.
+        /// Skipping the head always leaves an incomplete granule read, and fully zero granules
+        /// are already accounted for in the tails, so their head is not counted again.
+        size_t zero_head = 0;
+        if (can_read_incomplete_granules && zero_tails[i] != rows_to_read)
+            zero_head = numZerosInHead(filter_data, filter_data + rows_to_read);
+
+        zero_heads.push_back(zero_head);
+        total_zero_rows_in_heads += zero_head;
+        filter_data += rows_to_read;
+    }
+
+    return total_zero_rows_in_heads;
+}
+
+void MergeTreeRangeReader::ReadResult::collapseZeroTails(const IColumn::Filter & filter_vec, const NumRows & rows_per_granule_previous,
+    const NumRows & zero_heads, IColumn::Filter & new_filter_vec) const
 {
     const auto * filter_data = filter_vec.data();
     auto * new_filter_data = new_filter_vec.data();
 
     for (auto i : collections::range(0, rows_per_granule.size()))
     {
-        memcpySmallAllowReadWriteOverflow15(new_filter_data, filter_data, rows_per_granule[i]);
+        memcpySmallAllowReadWriteOverflow15(new_filter_data, filter_data + zero_heads[i], rows_per_granule[i]);
         filter_data += rows_per_granule_previous[i];
         new_filter_data += rows_per_granule[i];
     }
@@ -798,6 +872,18 @@ size_t MergeTreeRangeReader::ReadResult::numZerosInTail(const UInt8 * begin, con
     return count;
 }
 
+size_t MergeTreeRangeReader::ReadResult::numZerosInHead(const UInt8 * begin, const UInt8 * end)
+{
+    /// Unlike numZerosInTail, the head scan stops at the first row that passed the filter,
+    /// which is close to the beginning for most filters, so a word-wise scan is enough.
+    const UInt8 * pos = begin;
+    while (end - pos >= 8 && unalignedLoad<UInt64>(pos) == 0)
+        pos += 8;
+    while (pos < end && *pos == 0)
+        ++pos;
+    return pos - begin;
+}
+
 MergeTreeRangeReader::MergeTreeRangeReader(
     IMergeTreeReader * merge_tree_reader_,
     MergeTreeRangeReader * prev_reader_,
@@ -942,7 +1028,11 @@ MergeTreeRangeReader::ReadResult MergeTreeRangeReader::read(size_t max_rows, Mar
 
         /// Nothing to do. Return empty result.
         if (read_result.num_rows == 0)
+        {
+            if (last_reader_in_chain && query_condition_cache)
+                updateQueryConditionCache(read_result);
             return read_result;
+        }
 
         /// Calculate and update read bytes
         size_t total_bytes = 0;
@@ -1040,6 +1130,10 @@ MergeTreeRangeReader::ReadResult MergeTreeRangeReader::read(size_t max_rows, Mar
 
     read_result.checkInternalConsistency();
 
+    /// Remember granules where nothing passed the filter while it is still aligned with rows_per_granule.
+    if (last_reader_in_chain && query_condition_cache)
+        updateQueryConditionCache(read_result);
+
     if (!read_result.can_return_prewhere_column_without_filtering)
     {
         if (!read_result.filterWasApplied())
@@ -1078,6 +1172,7 @@ MergeTreeRangeReader::ReadResult MergeTreeRangeReader::startReadingChain(size_t
     {
         leading_begin_part_offset = stream.currentPartOffset();
         leading_end_part_offset = stream.lastPartOffset();
+        result.continuation_first_mark = stream.currentMark();
     }
 
     /// Stream is lazy. result.num_added_rows is the number of rows added to block which is not equal to
@@ -1152,6 +1247,85 @@ void MergeTreeRangeReader::fillPartOffsetColumn(ReadResult & result, UInt64 lead
     result.columns.emplace_back(std::move(column));
 }
 
+void MergeTreeRangeReader::updateQueryConditionCache(const ReadResult & result)
+{
+    const auto & rows_per_granule = result.rows_per_granule;
+    const size_t num_granules = rows_per_granule.size();
+    if (num_granules == 0)
+        return;
+
+    /// The number of rows which passed all the filtering steps, per granule of this reading act.
+    /// If the final filter is still unapplied, it is aligned with rows_per_granule, so count its
+    /// bytes per granule. Otherwise the zeros left in rows_per_granule by optimize() are enough.
+    std::vector<size_t> surviving_rows(num_granules);
+    if (result.final_filter.present() && !result.filterWasApplied())
+    {
+        const auto & filter = result.final_filter.getData();
+        if (filter.size() != result.total_rows_per_granule)
+            return;
+
+        size_t offset = 0;
+        for (size_t i = 0; i < num_granules; ++i)
+        {
+            surviving_rows[i] = countBytesInFilter(filter.data(), offset, offset + rows_per_granule[i]);
+            offset += rows_per_granule[i];
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < num_granules; ++i)
+            surviving_rows[i] = rows_per_granule[i];
+    }
+
+    if (!query_condition_cache_entry)
+    {
+        const auto & data_part_info = merge_tree_reader->data_part_info_for_read;
+        auto key = QueryConditionCache::hash(data_part_info->getDataPartStorage()->getFullPath(), query_condition_hash);
+        size_t marks_count = data_part_info->getMarksCount();
+        query_condition_cache_entry = query_condition_cache->getOrSet(
+            key, [marks_count] { return std::make_shared<QueryConditionCacheEntry>(marks_count); }).first;
+    }
+
+    /// Map a granule of this reading act back to its mark. Granules before started_ranges[0]
+    /// continue a range started in a previous act, beginning at continuation_first_mark.
+    auto mark_of_granule = [&](size_t granule) -> std::optional<size_t>
+    {
+        const auto & started_ranges = result.started_ranges;
+        size_t range_index = started_ranges.size();
+        while (range_index > 0 && started_ranges[range_index - 1].num_granules_read_before_start > granule)
+            --range_index;
+
+        if (range_index == 0)
+        {
+            if (!result.continuation_first_mark)
+                return {};
+            return *result.continuation_first_mark + granule;
+        }
+
+        const auto & range_info = started_ranges[range_index - 1];
+        return range_info.range.begin + (granule - range_info.num_granules_read_before_start);
+    };
+
+    std::lock_guard lock(query_condition_cache_entry->mutex);
+    auto & matching_marks = query_condition_cache_entry->matching_marks;
+
+    for (size_t i = 0; i < num_granules; ++i)
+    {
+        if (surviving_rows[i] != 0)
+            continue;
+
+        /// A granule may be remembered as empty only if the condition was evaluated on all of its
+        /// rows in this act: the first granule may continue a granule partially read by the
+        /// previous act and the last one may be cut by the row limit, so both are skipped.
+        if (i + 1 == num_granules || (i == 0 && result.continuation_first_mark))
+            continue;
+
+        auto mark = mark_of_granule(i);
+        if (mark && *mark < matching_marks.size())
+            matching_marks[*mark] = false;
+    }
+}
+
 Columns MergeTreeRangeReader::continueReadingChain(const ReadResult & result, size_t & num_rows)
 {
     Columns columns;
@@ -1189,6 +1363,11 @@ Columns MergeTreeRangeReader::continueReadingChain(const ReadResult & result, si
             stream = Stream(range.begin, range.end, current_task_last_mark, merge_tree_reader);
         }
 
+        /// Skip rows filtered out at the beginning of the granule, so that reading
+        /// starts right at the first row that passed the filter.
+        if (!result.num_rows_to_skip_in_granule_heads.empty())
+            stream.skip(result.num_rows_to_skip_in_granule_heads[i]);
+
         bool last = i + 1 == size;
         num_rows += stream.read(columns, rows_per_granule[i], !last);
     }
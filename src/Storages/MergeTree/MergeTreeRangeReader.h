@@ -1,4 +1,5 @@
 #pragma once
+#include <optional>
 #include <Core/Block.h>
 #include <Common/logger_useful.h>
 #include <Columns/ColumnVector.h>
@@ -15,6 +16,12 @@ using ColumnUInt8 = ColumnVector<UInt8>;
 
 class IMergeTreeReader;
 class MergeTreeIndexGranularity;
+
+class QueryConditionCache;
+using QueryConditionCachePtr = std::shared_ptr<QueryConditionCache>;
+struct QueryConditionCacheEntry;
+using QueryConditionCacheEntryPtr = std::shared_ptr<QueryConditionCacheEntry>;
+
 struct PrewhereInfo;
 using PrewhereInfoPtr = std::shared_ptr<PrewhereInfo>;
 
@@ -237,7 +244,8 @@ public:
         void addNumBytesRead(size_t count) { num_bytes_read += count; }
 
         /// Shrinks columns according to the diff between current and previous rows_per_granule.
-        void shrink(Columns & old_columns, const NumRows & rows_per_granule_previous) const;
+        /// For each granule keeps rows_per_granule rows starting at offset zero_heads.
+        void shrink(Columns & old_columns, const NumRows & rows_per_granule_previous, const NumRows & zero_heads) const;
 
         /// Applies the filter to the columns and updates num_rows.
         void applyFilter(const FilterWithCachedCount & filter);
@@ -252,6 +260,10 @@ public:
         Block additional_columns;
 
         RangesInfo started_ranges;
+        /// If the first granules of this reading act continue a range started in a previous act
+        /// (and therefore have no entry in started_ranges), the mark of the first of them.
+        /// Needed to map granules back to marks when filling the query condition cache.
+        std::optional<size_t> continuation_first_mark;
         /// The number of rows read from each granule.
         /// Granule here is not number of rows between two marks
         /// It's amount of rows per single reading act
@@ -262,6 +274,10 @@ public:
         size_t num_read_rows = 0;
         /// The number of rows was removed from last granule after clear or optimize.
         size_t num_rows_to_skip_in_last_granule = 0;
+        /// The number of rows to skip at the beginning of each granule before reading.
+        /// Filled by optimize() when leading rows of a granule are filtered out (e.g. a point
+        /// predicate on a sorted column matches only the middle of the granule). Empty means no skipping.
+        NumRows num_rows_to_skip_in_granule_heads;
         /// Without any filtration.
         size_t num_bytes_read = 0;
 
@@ -278,10 +294,13 @@ public:
         /// Checks if result columns have current final_filter applied.
         bool filterWasApplied() const { return !final_filter.present() || final_filter.countBytesInFilter() == num_rows; }
 
-        /// Builds updated filter by cutting zeros in granules tails
-        void collapseZeroTails(const IColumn::Filter & filter, const NumRows & rows_per_granule_previous, IColumn::Filter & new_filter) const;
+        /// Builds updated filter by cutting zeros in granules heads and tails
+        void collapseZeroTails(const IColumn::Filter & filter, const NumRows & rows_per_granule_previous,
+            const NumRows & zero_heads, IColumn::Filter & new_filter) const;
         size_t countZeroTails(const IColumn::Filter & filter, NumRows & zero_tails, bool can_read_incomplete_granules) const;
+        size_t countZeroHeads(const IColumn::Filter & filter, NumRows & zero_heads, const NumRows & zero_tails, bool can_read_incomplete_granules) const;
         static size_t numZerosInTail(const UInt8 * begin, const UInt8 * end);
+        static size_t numZerosInHead(const UInt8 * begin, const UInt8 * end);
 
         Poco::Logger * log;
     };
@@ -290,11 +309,21 @@ public:
 
     const Block & getSampleBlock() const { return result_sample_block; }
 
+    /// Remember granules where the filter selected no rows in the query condition cache,
+    /// so that subsequent queries with the same condition skip them during index analysis.
+    /// Only makes sense for the last reader in the chain, which sees the final filter.
+    void setQueryConditionCache(QueryConditionCachePtr query_condition_cache_, UInt64 query_condition_hash_)
+    {
+        query_condition_cache = std::move(query_condition_cache_);
+        query_condition_hash = query_condition_hash_;
+    }
+
 private:
     ReadResult startReadingChain(size_t max_rows, MarkRanges & ranges);
     Columns continueReadingChain(const ReadResult & result, size_t & num_rows);
     void executePrewhereActionsAndFilterColumns(ReadResult & result) const;
     void fillPartOffsetColumn(ReadResult & result, UInt64 leading_begin_part_offset, UInt64 leading_end_part_offset);
+    void updateQueryConditionCache(const ReadResult & result);
 
     IMergeTreeReader * merge_tree_reader = nullptr;
     const MergeTreeIndexGranularity * index_granularity = nullptr;
@@ -310,6 +339,11 @@ private:
     bool is_initialized = false;
     Names non_const_virtual_column_names;
 
+    /// See setQueryConditionCache().
+    QueryConditionCachePtr query_condition_cache;
+    UInt64 query_condition_hash = 0;
+    QueryConditionCacheEntryPtr query_condition_cache_entry;
+
     Poco::Logger * log = &Poco::Logger::get("MergeTreeRangeReader");
 };
 
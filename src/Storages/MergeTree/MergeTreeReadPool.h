@@ -1,9 +1,11 @@
 #pragma once
 
 #include <Core/NamesAndTypes.h>
+#include <Interpreters/ExpressionActionsSettings.h>
 #include <Storages/MergeTree/RangesInDataPart.h>
 #include <Storages/MergeTree/MergeTreeBlockReadUtils.h>
 #include <Storages/MergeTree/MergeTreeData.h>
+#include <Storages/MergeTree/MergeTreeIOSettings.h>
 #include <Storages/SelectQueryInfo.h>
 #include <mutex>
 
@@ -76,6 +78,8 @@ public:
         RangesInDataParts && parts_,
         const StorageSnapshotPtr & storage_snapshot_,
         const PrewhereInfoPtr & prewhere_info_,
+        const ExpressionActionsSettings & actions_settings_,
+        const MergeTreeReaderSettings & reader_settings_,
         const Names & column_names_,
         const Names & virtual_column_names_,
         const BackoffSettings & backoff_settings_,
@@ -115,6 +119,8 @@ private:
     std::vector<PerPartParams> per_part_params;
 
     PrewhereInfoPtr prewhere_info;
+    ExpressionActionsSettings actions_settings;
+    MergeTreeReaderSettings reader_settings;
 
     struct Part
     {
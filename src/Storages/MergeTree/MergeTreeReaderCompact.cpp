@@ -149,6 +149,17 @@ void MergeTreeReaderCompact::fillColumnPositions()
         if (read_only_offsets[i])
             partially_read_columns.insert(column_to_read.name);
     }
+
+    for (const auto & position : column_positions)
+    {
+        if (!position)
+            continue;
+
+        if (!min_column_position || *position < *min_column_position)
+            min_column_position = *position;
+        if (!max_column_position || *position > *max_column_position)
+            max_column_position = *position;
+    }
 }
 
 size_t MergeTreeReaderCompact::readRows(
@@ -172,6 +183,8 @@ size_t MergeTreeReaderCompact::readRows(
     {
         size_t rows_to_read = data_part_info_for_read->getIndexGranularity().getMarkRows(from_mark);
 
+        prefetchGranuleRange(from_mark, current_task_last_mark);
+
         for (size_t pos = 0; pos < num_columns; ++pos)
         {
             if (!res_columns[pos])
@@ -274,6 +287,24 @@ void MergeTreeReaderCompact::readData(
 }
 
 
+void MergeTreeReaderCompact::prefetchGranuleRange(size_t from_mark, size_t current_task_last_mark)
+{
+    if (!min_column_position)
+        return;
+
+    adjustUpperBound(current_task_last_mark); /// Must go before seek.
+
+    if (!isContinuousReading(from_mark, *min_column_position))
+        seekToMark(from_mark, *min_column_position);
+
+    /// All requested columns of the granule lie in one contiguous range of the file
+    /// (columns are stored in the order of their positions) and the buffer is sized
+    /// to fit this range (see getReadBufferSize). Ask the lower layers to fetch it
+    /// in one read: the per-column reads then decode from the shared buffer and
+    /// their seeks stay within it instead of issuing separate reads.
+    data_buffer->prefetch();
+}
+
 void MergeTreeReaderCompact::seekToMark(size_t row_index, size_t column_index)
 {
     MarkInCompressedFile mark = marks_loader.getMark(row_index, column_index);
@@ -380,29 +411,44 @@ size_t MergeTreeReaderCompact::getReadBufferSize(
     const MarkRanges & mark_ranges)
 {
     size_t buffer_size = 0;
-    size_t columns_num = column_positions.size();
     size_t file_size = data_part_info_for_reader.getFileSizeOrZero(MergeTreeDataPartCompact::DATA_FILE_NAME_WITH_EXTENSION);
 
+    std::optional<size_t> min_position;
+    std::optional<size_t> max_position;
+    for (const auto & position : column_positions)
+    {
+        if (!position)
+            continue;
+
+        if (!min_position || *position < *min_position)
+            min_position = *position;
+        if (!max_position || *position > *max_position)
+            max_position = *position;
+    }
+
+    if (!min_position)
+        return 0;
+
     MarksCounter counter(data_part_info_for_reader.getMarksCount(), data_part_info_for_reader.getColumns().size());
 
     for (const auto & mark_range : mark_ranges)
     {
         for (size_t mark = mark_range.begin; mark < mark_range.end; ++mark)
         {
-            for (size_t i = 0; i < columns_num; ++i)
-            {
-                if (!column_positions[i])
-                    continue;
+            /// All requested columns of one granule are read from one contiguous range
+            /// of the file (see prefetchGranuleRange), so the buffer should fit
+            /// the union of their spans. The resulting value is capped by the configured
+            /// buffer size in adjustBufferSize.
+            size_t range_begin = marks_loader.getMark(mark, *min_position).offset_in_compressed_file;
 
-                auto it = counter.get(mark, *column_positions[i]);
-                size_t cur_offset = marks_loader.getMark(it.row, it.column).offset_in_compressed_file;
+            auto it = counter.get(mark, *max_position);
+            size_t cur_offset = marks_loader.getMark(it.row, it.column).offset_in_compressed_file;
 
-                while (it != counter.end() && cur_offset == marks_loader.getMark(it.row, it.column).offset_in_compressed_file)
-                    ++it;
+            while (it != counter.end() && cur_offset == marks_loader.getMark(it.row, it.column).offset_in_compressed_file)
+                ++it;
 
-                size_t next_offset = (it == counter.end() ? file_size : marks_loader.getMark(it.row, it.column).offset_in_compressed_file);
-                buffer_size = std::max(buffer_size, next_offset - cur_offset);
-            }
+            size_t range_end = (it == counter.end() ? file_size : marks_loader.getMark(it.row, it.column).offset_in_compressed_file);
+            buffer_size = std::max(buffer_size, range_end - range_begin);
         }
     }
 
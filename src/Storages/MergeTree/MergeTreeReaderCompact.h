@@ -66,7 +66,16 @@ private:
     void readData(const NameAndTypePair & name_and_type, ColumnPtr & column, size_t from_mark,
         size_t current_task_last_mark, size_t column_position, size_t rows_to_read, bool only_offsets);
 
-    /// Returns maximal value of granule size in compressed file from @mark_ranges.
+    /// Position the buffer at the first requested column of the granule and hint the lower
+    /// layers to fetch the whole contiguous range of the requested columns in one read.
+    void prefetchGranuleRange(size_t from_mark, size_t current_task_last_mark);
+
+    /// The first and the last (by position in the part) of the requested columns.
+    std::optional<size_t> min_column_position;
+    std::optional<size_t> max_column_position;
+
+    /// Returns maximal size in compressed file of the contiguous range
+    /// of requested columns of one granule from @mark_ranges.
     /// This value is used as size of read buffer.
     static size_t getReadBufferSize(
         const IMergeTreeDataPartInfoForReader & data_part_info_for_reader,
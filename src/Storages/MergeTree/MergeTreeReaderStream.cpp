@@ -1,9 +1,15 @@
 #include <Storages/MergeTree/MergeTreeReaderStream.h>
 #include <Compression/CachedCompressedReadBuffer.h>
+#include <Interpreters/threadPoolCallbackRunner.h>
 
 #include <base/getThreadId.h>
 #include <utility>
 
+namespace ProfileEvents
+{
+    extern const Event MergeTreeRangesPrefetched;
+    extern const Event MergeTreeRangesPrefetchedBytes;
+}
 
 namespace DB
 {
@@ -55,6 +61,67 @@ MergeTreeReaderStream::MergeTreeReaderStream(
 {
 }
 
+MergeTreeReaderStream::~MergeTreeReaderStream()
+{
+    if (range_prefetch_future.valid())
+        range_prefetch_future.wait();
+}
+
+void MergeTreeReaderStream::prefetchMarkRanges(ThreadPool & pool)
+{
+    if (range_prefetch_future.valid())
+        return;
+
+    /// Compute the coalesced byte ranges on the calling thread: marks_loader is not
+    /// thread-safe and the marks will be needed for reading anyway.
+    std::vector<std::pair<size_t, size_t>> offset_ranges;
+    for (const auto & mark_range : all_mark_ranges)
+    {
+        size_t left_offset = mark_range.begin < marks_count ? marks_loader.getMark(mark_range.begin).offset_in_compressed_file : 0;
+        size_t right_offset = getRightOffset(mark_range.end);
+
+        if (right_offset <= left_offset)
+            continue;
+
+        if (!offset_ranges.empty() && left_offset <= offset_ranges.back().second + settings.mark_ranges_coalesce_gap)
+            offset_ranges.back().second = std::max(offset_ranges.back().second, right_offset);
+        else
+            offset_ranges.emplace_back(left_offset, right_offset);
+    }
+
+    if (offset_ranges.empty())
+        return;
+
+    range_prefetch_future = scheduleFromThreadPool<void>([this, offset_ranges = std::move(offset_ranges)]
+    {
+        try
+        {
+            /// Read synchronously: this task already runs in a dedicated thread and its only
+            /// purpose is to pull the data through the filesystem cache.
+            ReadSettings prefetch_settings = settings.read_settings;
+            prefetch_settings.remote_fs_method = RemoteFSReadMethod::read;
+            prefetch_settings.remote_fs_prefetch = false;
+
+            auto buffer = data_part_storage->readFile(
+                path_prefix + data_file_extension, prefetch_settings, std::nullopt, std::nullopt);
+
+            for (const auto & [left_offset, right_offset] : offset_ranges)
+            {
+                buffer->seek(left_offset, SEEK_SET);
+                buffer->ignore(right_offset - left_offset);
+
+                ProfileEvents::increment(ProfileEvents::MergeTreeRangesPrefetched);
+                ProfileEvents::increment(ProfileEvents::MergeTreeRangesPrefetchedBytes, right_offset - left_offset);
+            }
+        }
+        catch (...)
+        {
+            /// A failed prefetch only loses the warm-up, the query will read the data itself.
+            tryLogCurrentException(__PRETTY_FUNCTION__);
+        }
+    }, pool, "PrefetchRanges");
+}
+
 void MergeTreeReaderStream::init()
 {
     if (initialized)
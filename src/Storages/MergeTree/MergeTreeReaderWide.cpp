@@ -7,8 +7,11 @@
 #include <DataTypes/DataTypeNested.h>
 #include <Interpreters/inplaceBlockConversions.h>
 #include <Interpreters/Context.h>
+#include <IO/IOThreadPool.h>
+#include <Storages/ColumnsCache.h>
 #include <Storages/MergeTree/IMergeTreeReader.h>
 #include <Storages/MergeTree/MergeTreeDataPartWide.h>
+#include <Storages/MergeTree/MergeTreeIndexGranularity.h>
 #include <Common/escapeForFileName.h>
 #include <Common/typeid_cast.h>
 
@@ -48,8 +51,21 @@ MergeTreeReaderWide::MergeTreeReaderWide(
 {
     try
     {
+        columns_need_seek.assign(columns_to_read.size(), false);
+
         for (size_t i = 0; i < columns_to_read.size(); ++i)
             addStreams(columns_to_read[i], serializations[i], profile_callback_, clock_type_);
+
+        /// Warm the filesystem cache with everything the chosen mark ranges are going to read,
+        /// so that a cold-cache query does not serialize one ranged GET per stream and range.
+        if (settings.prefetch_mark_ranges_into_cache
+            && settings.read_settings.enable_filesystem_cache
+            && data_part_info_for_read->getDataPartStorage()->isStoredOnRemoteDisk()
+            && IOThreadPool::isInitialized())
+        {
+            for (auto & [stream_name, stream] : streams)
+                stream->prefetchMarkRanges(IOThreadPool::get());
+        }
     }
     catch (...)
     {
@@ -72,6 +88,30 @@ size_t MergeTreeReaderWide::readRows(
 
         std::unordered_map<String, ISerialization::SubstreamsCache> caches;
 
+        /// Reads of whole granules that start at a mark boundary can be served from the cache
+        /// of deserialized columns, since such a read is identified by the part, the column
+        /// and the range of granules, and after it the streams can be synced by seeking to a mark.
+        ColumnsCache * columns_cache = settings.columns_cache.get();
+        std::optional<size_t> granule_aligned_end_mark;
+        if (columns_cache && !continue_reading)
+            granule_aligned_end_mark = getGranuleAlignedEndMark(from_mark, max_rows_to_read);
+
+        bool use_columns_cache = granule_aligned_end_mark.has_value();
+        std::vector<UInt128> columns_cache_keys;
+        std::vector<ColumnPtr> columns_from_cache;
+        if (use_columns_cache)
+        {
+            auto part_path = data_part_info_for_read->getDataPartStorage()->getFullPath();
+            columns_cache_keys.resize(num_columns);
+            columns_from_cache.resize(num_columns);
+            for (size_t pos = 0; pos < num_columns; ++pos)
+            {
+                columns_cache_keys[pos] = ColumnsCache::hash(part_path, columns_to_read[pos].name, from_mark, max_rows_to_read);
+                if (auto cell = columns_cache->get(columns_cache_keys[pos]))
+                    columns_from_cache[pos] = cell->column;
+            }
+        }
+
         std::unordered_set<std::string> prefetched_streams;
         if (data_part_info_for_read->getDataPartStorage()->isStoredOnRemoteDisk() ? settings.read_settings.remote_fs_prefetch : settings.read_settings.local_fs_prefetch)
         {
@@ -79,10 +119,15 @@ size_t MergeTreeReaderWide::readRows(
             /// so if reading can be asynchronous, it will also be performed in parallel for all columns.
             for (size_t pos = 0; pos < num_columns; ++pos)
             {
+                /// No need to prefetch the streams of a column served from the cache of deserialized columns.
+                if (use_columns_cache && columns_from_cache[pos])
+                    continue;
+
                 try
                 {
                     auto & cache = caches[columns_to_read[pos].getNameInStorage()];
-                    prefetch(columns_to_read[pos], serializations[pos], from_mark, continue_reading, current_task_last_mark, cache, prefetched_streams);
+                    prefetch(columns_to_read[pos], serializations[pos], from_mark,
+                        continue_reading && !columns_need_seek[pos], current_task_last_mark, cache, prefetched_streams);
                 }
                 catch (Exception & e)
                 {
@@ -105,18 +150,42 @@ size_t MergeTreeReaderWide::readRows(
             auto & column = res_columns[pos];
             try
             {
-                size_t column_size_before_reading = column->size();
-                auto & cache = caches[column_to_read.getNameInStorage()];
-
-                readData(
-                    column_to_read, serializations[pos], column,
-                    from_mark, continue_reading, current_task_last_mark,
-                    max_rows_to_read, cache, /* was_prefetched =*/ !prefetched_streams.empty());
-
-                /// For elements of Nested, column_size_before_reading may be greater than column size
-                ///  if offsets are not empty and were already read, but elements are empty.
-                if (!column->empty())
-                    read_rows = std::max(read_rows, column->size() - column_size_before_reading);
+                if (use_columns_cache && columns_from_cache[pos])
+                {
+                    const auto & cached_column = columns_from_cache[pos];
+                    if (append)
+                    {
+                        auto mutable_column = IColumn::mutate(std::move(column));
+                        mutable_column->insertRangeFrom(*cached_column, 0, cached_column->size());
+                        column = std::move(mutable_column);
+                    }
+                    else
+                        column = cached_column;
+
+                    /// The streams were not advanced, force a seek on the next actual read.
+                    columns_need_seek[pos] = true;
+                    read_rows = std::max(read_rows, cached_column->size());
+                }
+                else
+                {
+                    size_t column_size_before_reading = column->size();
+                    auto & cache = caches[column_to_read.getNameInStorage()];
+
+                    readData(
+                        column_to_read, serializations[pos], column,
+                        from_mark, continue_reading && !columns_need_seek[pos], current_task_last_mark,
+                        max_rows_to_read, cache, /* was_prefetched =*/ !prefetched_streams.empty());
+
+                    columns_need_seek[pos] = false;
+
+                    /// For elements of Nested, column_size_before_reading may be greater than column size
+                    ///  if offsets are not empty and were already read, but elements are empty.
+                    if (!column->empty())
+                        read_rows = std::max(read_rows, column->size() - column_size_before_reading);
+
+                    if (use_columns_cache && !append && !column->empty())
+                        columns_cache->set(columns_cache_keys[pos], std::make_shared<ColumnsCacheCell>(ColumnsCacheCell{column}));
+                }
             }
             catch (Exception & e)
             {
@@ -154,6 +223,58 @@ size_t MergeTreeReaderWide::readRows(
     return read_rows;
 }
 
+std::optional<size_t> MergeTreeReaderWide::getGranuleAlignedEndMark(size_t from_mark, size_t max_rows_to_read) const
+{
+    const auto & index_granularity = data_part_info_for_read->getIndexGranularity();
+    size_t marks_count = index_granularity.getMarksCount();
+
+    size_t rows = 0;
+    size_t mark = from_mark;
+    while (rows < max_rows_to_read && mark < marks_count)
+        rows += index_granularity.getMarkRows(mark++);
+
+    /// Reads to the end of the part are granule-aligned as well, no matter how many rows were requested.
+    if (rows == max_rows_to_read || mark == marks_count)
+        return mark;
+
+    return std::nullopt;
+}
+
+void MergeTreeReaderWide::prefetchBeginOfRange()
+{
+    if (all_mark_ranges.empty() || columns_to_read.empty())
+        return;
+
+    try
+    {
+        size_t current_task_last_mark = 0;
+        for (const auto & range : all_mark_ranges)
+            current_task_last_mark = std::max(current_task_last_mark, range.end);
+
+        std::unordered_map<String, ISerialization::SubstreamsCache> caches;
+        std::unordered_set<std::string> prefetched_streams;
+
+        for (size_t pos = 0; pos < columns_to_read.size(); ++pos)
+        {
+            auto & cache = caches[columns_to_read[pos].getNameInStorage()];
+            prefetch(
+                columns_to_read[pos], serializations[pos], all_mark_ranges.front().begin,
+                /* continue_reading = */ false, current_task_last_mark, cache, prefetched_streams);
+        }
+    }
+    catch (Exception & e)
+    {
+        if (e.code() != ErrorCodes::MEMORY_LIMIT_EXCEEDED)
+            data_part_info_for_read->reportBroken();
+        throw;
+    }
+    catch (...)
+    {
+        data_part_info_for_read->reportBroken();
+        throw;
+    }
+}
+
 void MergeTreeReaderWide::addStreams(
     const NameAndTypePair & name_and_type,
     const SerializationPtr & serialization,
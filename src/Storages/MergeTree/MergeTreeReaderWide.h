@@ -33,11 +33,22 @@ public:
 
     bool canReadIncompleteGranules() const override { return true; }
 
+    void prefetchBeginOfRange() override;
+
     using FileStreams = std::map<std::string, std::unique_ptr<MergeTreeReaderStream>>;
 
 private:
     FileStreams streams;
 
+    /// If the read starts at a mark boundary and ends exactly at one (or at the end of the part),
+    /// returns the mark the read ends at. Only such reads can be served from the cache
+    /// of deserialized columns, because a mark is the only position we can seek to afterwards.
+    std::optional<size_t> getGranuleAlignedEndMark(size_t from_mark, size_t max_rows_to_read) const;
+
+    /// After a column was served from the cache of deserialized columns, its file streams
+    /// lag behind the logical reading position, so the next actual read of it must seek.
+    std::vector<UInt8> columns_need_seek;
+
     void addStreams(
         const NameAndTypePair & name_and_type,
         const SerializationPtr & serialization,
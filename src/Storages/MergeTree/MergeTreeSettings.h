@@ -58,8 +58,14 @@ struct Settings;
     M(UInt64, write_ahead_log_bytes_to_fsync, 100ULL * 1024 * 1024, "Amount of bytes, accumulated in WAL to do fsync.", 0) \
     M(UInt64, write_ahead_log_interval_ms_to_fsync, 100, "Interval in milliseconds after which fsync for WAL is being done.", 0) \
     M(Bool, in_memory_parts_insert_sync, false, "If true insert of part with in-memory format will wait for fsync of WAL", 0) \
+    M(UInt64, in_memory_parts_max_total_bytes, 0, "If not zero, new parts are written in in-memory format only while the total size of active in-memory parts of the table is below this value, otherwise the on-disk format is chosen. Bounds the amount of RAM occupied by in-memory parts and the amount of WAL data to replay on restart (0 - unlimited).", 0) \
     M(UInt64, non_replicated_deduplication_window, 0, "How many last blocks of hashes should be kept on disk (0 - disabled).", 0) \
     M(UInt64, max_parts_to_merge_at_once, 100, "Max amount of parts which can be merged at once (0 - disabled). Doesn't affect OPTIMIZE FINAL query.", 0) \
+    M(Bool, enable_column_statistics, false, "Maintain per-column statistics (an equi-depth histogram and a distinct-count sketch) in each part, computed on insert and combined sketch-wise on merge. Exposed in system.column_statistics. All replicas must run a version that knows the statistics file before enabling.", 0) \
+    M(Bool, enable_leveled_compaction, false, "Use leveled compaction to select parts for background merges: parts are assigned levels by size and merged when at least 'leveled_compaction_fan_out' parts accumulate on one level. Bounds the number of parts per partition without ever requiring a full rewrite.", 0) \
+    M(UInt64, leveled_compaction_fan_out, 10, "For leveled compaction: ratio of part sizes between adjacent levels and the number of parts on one level that triggers a merge.", 0) \
+    M(UInt64, leveled_compaction_base_bytes, 1048576, "For leveled compaction: parts smaller than this belong to level 0.", 0) \
+    M(UInt64, leveled_compaction_settle_age_seconds, 0, "For leveled compaction: if a partition has not received new parts for this long, converge it to a single part by merging the cheapest pair of adjacent parts at a time (0 - disabled).", 0) \
     M(UInt64, merge_selecting_sleep_ms, 5000, "Sleep time for merge selecting when no part selected, a lower setting will trigger selecting tasks in background_schedule_pool frequently which result in large amount of requests to zookeeper in large-scale clusters", 0) \
     M(UInt64, merge_tree_clear_old_temporary_directories_interval_seconds, 60, "The period of executing the clear old temporary directories operation in background.", 0) \
     M(UInt64, merge_tree_clear_old_parts_interval_seconds, 1, "The period of executing the clear old parts operation in background.", 0) \
@@ -89,8 +95,10 @@ struct Settings;
     M(UInt64, replicated_deduplication_window_seconds_for_async_inserts, 7 * 24 * 60 * 60 /* one week */, "Similar to \"replicated_deduplication_window_for_async_inserts\", but determines old blocks by their lifetime. Hash of an inserted block will be deleted (and the block will not be deduplicated after) if it outside of one \"window\". You can set very big replicated_deduplication_window to avoid duplicating INSERTs during that period of time.", 0) \
     M(Milliseconds, async_block_ids_cache_min_update_interval_ms, 100, "minimum interval between updates of async_block_ids_cache", 0) \
     M(Bool, use_async_block_ids_cache, false, "use in-memory cache to filter duplicated async inserts based on block ids", 0) \
+    M(Bool, use_local_block_dedup_cache, false, "Consult an in-memory cache of recently committed block ids before allocating a block number for INSERT deduplication. On a cache hit only one ZooKeeper read is needed to confirm the duplicate instead of the block allocation transaction. ZooKeeper remains the authority: stale cache entries are dropped and the insert proceeds normally.", 0) \
     M(UInt64, max_replicated_logs_to_keep, 1000, "How many records may be in log, if there is inactive replica. Inactive replica becomes lost when when this number exceed.", 0) \
     M(UInt64, min_replicated_logs_to_keep, 10, "Keep about this number of last records in ZooKeeper log, even if they are obsolete. It doesn't affect work of tables: used only to diagnose ZooKeeper log before cleaning.", 0) \
+    M(UInt64, max_replicated_logs_multi_batch_size, 100, "Maximum number of log entries copied from ZooKeeper log to the replica queue in one multi transaction while pulling logs. The default is selected with a margin: ZooKeeper limits the total size of a multi request (1 MB by default), do not increase it without increasing the limit on the ZooKeeper side.", 0) \
     M(Seconds, prefer_fetch_merged_part_time_threshold, 3600, "If time passed after replication log entry creation exceeds this threshold and sum size of parts is greater than \"prefer_fetch_merged_part_size_threshold\", prefer fetching merged part from replica instead of doing merge locally. To speed up very long merges.", 0) \
     M(UInt64, prefer_fetch_merged_part_size_threshold, 10ULL * 1024 * 1024 * 1024, "If sum size of parts exceeds this threshold and time passed after replication log entry creation is greater than \"prefer_fetch_merged_part_time_threshold\", prefer fetching merged part from replica instead of doing merge locally. To speed up very long merges.", 0) \
     M(Seconds, execute_merges_on_single_replica_time_threshold, 0, "When greater than zero only a single replica starts the merge immediately, others wait up to that amount of time to download the result instead of doing merges locally. If the chosen replica doesn't finish the merge during that amount of time, fallback to standard behavior happens.", 0) \
@@ -106,6 +114,10 @@ struct Settings;
     M(Seconds, replicated_fetches_http_connection_timeout, 0, "HTTP connection timeout for part fetch requests. Inherited from default profile `http_connection_timeout` if not set explicitly.", 0) \
     M(Seconds, replicated_fetches_http_send_timeout, 0, "HTTP send timeout for part fetch requests. Inherited from default profile `http_send_timeout` if not set explicitly.", 0) \
     M(Seconds, replicated_fetches_http_receive_timeout, 0, "HTTP receive timeout for fetch part requests. Inherited from default profile `http_receive_timeout` if not set explicitly.", 0) \
+    M(UInt64, replicated_fetches_min_bytes_per_second, 0, "Minimal average speed of a single fetch in bytes per second. If the speed measured after `replicated_fetches_timeout_before_checking_speed` is lower, the fetch is cancelled (and will be retried, probably from another replica). 0 means unlimited.", 0) \
+    M(Seconds, replicated_fetches_timeout_before_checking_speed, 10, "Do not check the speed of a fetch during the first specified amount of seconds.", 0) \
+    M(Bool, replicated_fetches_defer_checksum_verification, false, "Do not hash the data of fetched parts during the fetch. The part is activated after size checks only and is verified later by the background part check thread, which detaches it as broken on mismatch. Reduces fetch CPU cost when the network path is trusted. Has no effect for fetches to 'detached' and for zero-copy replication.", 0) \
+    M(Bool, replicated_fetches_populate_mark_cache, false, "After a part is fetched and committed, load the marks of all its columns into the mark cache. Keeps replicas that receive most of their data via fetches (e.g. hot standbys) warm, so that they serve queries at full speed immediately after a failover, at the cost of background IO and mark cache space.", 0) \
     M(Bool, replicated_can_become_leader, true, "If true, Replicated tables replicas on this node will try to acquire leadership.", 0) \
     M(Seconds, zookeeper_session_expiration_check_period, 60, "ZooKeeper session expiration check period, in seconds.", 0) \
     M(Seconds, initialization_retry_period, 60, "Retry period for table initialization, in seconds.", 0) \
@@ -123,6 +135,7 @@ struct Settings;
     M(UInt64, enable_vertical_merge_algorithm, 1, "Enable usage of Vertical merge algorithm.", 0) \
     M(UInt64, vertical_merge_algorithm_min_rows_to_activate, 16 * DEFAULT_MERGE_BLOCK_SIZE, "Minimal (approximate) sum of rows in merging parts to activate Vertical merge algorithm.", 0) \
     M(UInt64, vertical_merge_algorithm_min_columns_to_activate, 11, "Minimal amount of non-PK columns to activate Vertical merge algorithm.", 0) \
+    M(Bool, vertical_merge_adaptive_compression, false, "During Vertical merge, trial-compress a sample of every gathered column with a set of candidate codecs and write the column with the most space-efficient one. Applies only to columns without an explicit compression codec in the table definition.", 0) \
     \
     /** Compatibility settings */ \
     M(Bool, compatibility_allow_sampling_expression_not_in_primary_key, false, "Allow to create a table with sampling expression not in primary key. This is needed only to temporarily allow to run the server with wrong tables for backward compatibility.", 0) \
@@ -138,6 +151,8 @@ struct Settings;
     M(Bool, materialize_ttl_recalculate_only, false, "Only recalculate ttl info when MATERIALIZE TTL", 0) \
     M(Bool, enable_mixed_granularity_parts, true, "Enable parts with adaptive and non adaptive granularity", 0) \
     M(MaxThreads, max_part_loading_threads, 0, "The number of threads to load data parts at startup.", 0) \
+    M(Bool, primary_key_lazy_load, false, "Load primary key in memory on first use instead of on table initialization. This speeds up loading of tables with a large number of parts and saves memory for parts that are never read.", 0) \
+    M(Seconds, primary_key_unload_timeout, 0, "If primary_key_lazy_load is enabled and this setting is non-zero, the in-memory primary index of a part is unloaded by the background cleanup if it was not used for the specified amount of seconds. It is reloaded from disk on the next use. 0 - never unload.", 0) \
     M(MaxThreads, max_part_removal_threads, 0, "The number of threads for concurrent removal of inactive data parts. One is usually enough, but in 'Google Compute Environment SSD Persistent Disks' file removal (unlink) operation is extraordinarily slow and you probably have to increase this number (recommended is up to 16).", 0) \
     M(UInt64, concurrent_part_removal_threshold, 100, "Activate concurrent part removal (see 'max_part_removal_threads') only if the number of inactive data parts is at least this.", 0) \
     M(String, storage_policy, "default", "Name of storage disk policy", 0) \
@@ -0,0 +1,290 @@
+#include <Storages/MergeTree/MergeTreeBaseSelectProcessor.h>
+#include <Storages/MergeTree/MergeTreeRangeReader.h>
+#include <Storages/SelectQueryInfo.h>
+#include <Interpreters/ActionsDAG.h>
+#include <Interpreters/ExpressionActions.h>
+#include <Functions/IFunctionAdaptors.h>
+#include <Functions/FunctionsLogical.h>
+#include <DataTypes/DataTypeNullable.h>
+
+namespace DB
+{
+
+namespace ErrorCodes
+{
+    extern const int LOGICAL_ERROR;
+}
+
+namespace
+{
+
+/// Stores the list of columns required to compute a node in the DAG.
+struct NodeInfo
+{
+    NameSet required_columns;
+};
+
+/// Fills the list of required columns for the node in the DAG.
+void fillRequiredColumns(const ActionsDAG::Node * node, std::unordered_map<const ActionsDAG::Node *, NodeInfo> & nodes_info)
+{
+    if (nodes_info.contains(node))
+        return;
+
+    auto & node_info = nodes_info[node];
+
+    if (node->type == ActionsDAG::ActionType::INPUT)
+    {
+        node_info.required_columns.insert(node->result_name);
+        return;
+    }
+
+    for (const auto & child : node->children)
+    {
+        fillRequiredColumns(child, nodes_info);
+        const auto & child_info = nodes_info[child];
+        node_info.required_columns.insert(child_info.required_columns.begin(), child_info.required_columns.end());
+    }
+}
+
+/// Stores the ref to the node in the new DAG that corresponds to the node in the original DAG.
+struct DAGNodeRef
+{
+    ActionsDAGPtr dag;
+    const ActionsDAG::Node * node;
+};
+
+using OriginalToNewNodeMap = std::unordered_map<const ActionsDAG::Node *, DAGNodeRef>;
+
+/// Clones the part of the original DAG responsible for computing the original_dag_node and adds it to the new DAG.
+const ActionsDAG::Node & addClonedDAGToDAG(const ActionsDAG::Node * original_dag_node, ActionsDAGPtr new_dag, OriginalToNewNodeMap & node_remap)
+{
+    /// Look for the node in the map of already known nodes.
+    if (node_remap.contains(original_dag_node))
+    {
+        /// If the node is already in the new DAG, return it.
+        const auto & node_ref = node_remap.at(original_dag_node);
+        if (node_ref.dag == new_dag)
+            return *node_ref.node;
+
+        /// If the node was computed by one of the previous steps, add it as an output of that step
+        /// and as an input of the current step. Constants are just re-added instead.
+        if (original_dag_node->type != ActionsDAG::ActionType::COLUMN)
+        {
+            node_ref.dag->addOrReplaceInOutputs(*node_ref.node);
+            const auto & new_node = new_dag->addInput(node_ref.node->result_name, node_ref.node->result_type);
+            node_remap[original_dag_node] = {new_dag, &new_node};
+            return new_node;
+        }
+    }
+
+    /// If the node is an input, add it as an input.
+    if (original_dag_node->type == ActionsDAG::ActionType::INPUT)
+    {
+        const auto & new_node = new_dag->addInput(original_dag_node->result_name, original_dag_node->result_type);
+        node_remap[original_dag_node] = {new_dag, &new_node};
+        return new_node;
+    }
+
+    /// If the node is a constant, add it as a constant.
+    if (original_dag_node->type == ActionsDAG::ActionType::COLUMN)
+    {
+        const auto & new_node = new_dag->addColumn(
+            ColumnWithTypeAndName(original_dag_node->column, original_dag_node->result_type, original_dag_node->result_name));
+        node_remap[original_dag_node] = {new_dag, &new_node};
+        return new_node;
+    }
+
+    if (original_dag_node->type == ActionsDAG::ActionType::ALIAS)
+    {
+        const auto & new_child = addClonedDAGToDAG(original_dag_node->children.front(), new_dag, node_remap);
+        const auto & new_node = new_dag->addAlias(new_child, original_dag_node->result_name);
+        node_remap[original_dag_node] = {new_dag, &new_node};
+        return new_node;
+    }
+
+    /// If the node is a function, add it as a function with cloned children.
+    if (original_dag_node->type == ActionsDAG::ActionType::FUNCTION)
+    {
+        ActionsDAG::NodeRawConstPtrs new_children;
+        for (const auto & child : original_dag_node->children)
+        {
+            const auto & new_child = addClonedDAGToDAG(child, new_dag, node_remap);
+            new_children.push_back(&new_child);
+        }
+
+        const auto & new_node = new_dag->addFunction(original_dag_node->function_base, new_children, original_dag_node->result_name);
+        node_remap[original_dag_node] = {new_dag, &new_node};
+        return new_node;
+    }
+
+    throw Exception(ErrorCodes::LOGICAL_ERROR, "Unexpected node type in PREWHERE actions: {}", original_dag_node->type);
+}
+
+/// A filter column must have a type that FilterDescription can work with.
+bool isSuitableFilterType(const DataTypePtr & type)
+{
+    return WhichDataType(removeNullable(type)).isUInt8();
+}
+
+}
+
+/// We want to build a sequence of steps that will compute parts of the prewhere condition.
+/// Each step reads some new columns and computes the conditions that require only the columns
+/// read so far. The filter produced by a step shrinks the rows that the subsequent steps need
+/// to read and compute, so cheap and selective conditions allow to skip reading heavy columns
+/// for the filtered-out granules entirely.
+/// NOTE: The result of executing the steps is exactly the same as if the original DAG was
+/// executed in a single step.
+///
+/// The steps are built in the following way:
+/// 1. List all condition nodes that are combined with AND into the PREWHERE condition
+/// 2. Collect the set of columns that are used in each condition
+/// 3. Group conditions with the same set of columns into a single read/compute step
+///    (the conditions are already ordered from cheap to heavy by MergeTreeWhereOptimizer)
+/// 4. Build DAGs for each step:
+///    - DFS from the condition root node:
+///      - If the node was not computed yet, add it to the DAG and traverse its children
+///      - If the node was already computed by one of the previous steps, add it as an output
+///        of that step and as an input of the current step
+///      - If the node was already computed by the current step, stop traversing
+/// 5. Add computation of the original DAG outputs to the steps where they were computed,
+///    and the remaining ones to the last step
+bool tryBuildPrewhereSteps(PrewhereInfoPtr prewhere_info, const ExpressionActionsSettings & actions_settings, PrewhereExprInfo & prewhere)
+{
+    if (!prewhere_info || !prewhere_info->prewhere_actions)
+        return false;
+
+    /// 1. List all condition nodes that are combined with AND into the PREWHERE condition.
+    const auto & condition_root = prewhere_info->prewhere_actions->findInOutputs(prewhere_info->prewhere_column_name);
+    const bool is_conjunction = condition_root.type == ActionsDAG::ActionType::FUNCTION
+        && condition_root.function_base->getName() == "and";
+    if (!is_conjunction)
+        return false;
+
+    auto condition_nodes = condition_root.children;
+
+    /// The filter column of each step is passed to FilterDescription, so only conditions that
+    /// have a suitable type on their own can become separate steps. Other types (e.g. wider
+    /// integers) are only valid as arguments of the original and().
+    for (const auto * condition_node : condition_nodes)
+        if (!isSuitableFilterType(condition_node->result_type))
+            return false;
+
+    /// 2. Collect the set of columns used in each condition.
+    std::unordered_map<const ActionsDAG::Node *, NodeInfo> nodes_info;
+    for (const auto & node : condition_nodes)
+        fillRequiredColumns(node, nodes_info);
+
+    /// 3. Group conditions with the same set of columns into a single read/compute step.
+    std::vector<std::vector<const ActionsDAG::Node *>> condition_groups;
+    for (const auto & node : condition_nodes)
+    {
+        const auto & node_info = nodes_info[node];
+        if (!condition_groups.empty() && nodes_info[condition_groups.back().back()].required_columns == node_info.required_columns)
+            condition_groups.back().push_back(node);
+        else
+            condition_groups.push_back({node});
+    }
+
+    /// All conditions require the same columns: splitting would not save any reads.
+    if (condition_groups.size() < 2)
+        return false;
+
+    /// 4. Build DAGs for each step.
+    struct Step
+    {
+        ActionsDAGPtr actions;
+        String column_name;
+    };
+    std::vector<Step> steps;
+
+    OriginalToNewNodeMap node_remap;
+
+    for (const auto & condition_group : condition_groups)
+    {
+        auto step_dag = std::make_shared<ActionsDAG>();
+        String result_name;
+
+        std::vector<const ActionsDAG::Node *> new_condition_nodes;
+        for (const auto * node : condition_group)
+        {
+            const auto & node_in_new_dag = addClonedDAGToDAG(node, step_dag, node_remap);
+            new_condition_nodes.push_back(&node_in_new_dag);
+        }
+
+        if (new_condition_nodes.size() > 1)
+        {
+            /// Add an AND function to combine the conditions of the group.
+            FunctionOverloadResolverPtr func_builder_and = std::make_unique<FunctionToOverloadResolverAdaptor>(std::make_shared<FunctionAnd>());
+            const auto & and_function_node = step_dag->addFunction(func_builder_and, new_condition_nodes, "");
+            step_dag->addOrReplaceInOutputs(and_function_node);
+            result_name = and_function_node.result_name;
+        }
+        else
+        {
+            const auto & result_node = *new_condition_nodes.front();
+            step_dag->addOrReplaceInOutputs(result_node);
+            result_name = result_node.result_name;
+        }
+
+        steps.push_back({std::move(step_dag), std::move(result_name)});
+    }
+
+    /// 5. Add computation of the original DAG outputs to the steps where they were computed,
+    /// and the remaining ones to the last step.
+    NameSet all_output_names;
+    for (const auto * output : prewhere_info->prewhere_actions->getOutputs())
+    {
+        all_output_names.insert(output->result_name);
+
+        if (node_remap.contains(output))
+        {
+            const auto & new_node_info = node_remap[output];
+            new_node_info.dag->addOrReplaceInOutputs(*new_node_info.node);
+        }
+        else if (output->result_name == prewhere_info->prewhere_column_name)
+        {
+            if (prewhere_info->remove_prewhere_column)
+                continue;
+
+            /// The prewhere column is kept in the result. It is the AND combination of all
+            /// conditions, but at the last step only the last condition is available. After the
+            /// filters of the previous steps are applied (the range reader guarantees that before
+            /// returning a kept filter column), the two are equal on the remaining rows, so an
+            /// alias of the last condition is enough. The types must match the original header.
+            const auto & last_step_result_node = steps.back().actions->findInOutputs(steps.back().column_name);
+            if (!last_step_result_node.result_type->equals(*output->result_type))
+                return false;
+
+            const auto & prewhere_result_node = steps.back().actions->addAlias(last_step_result_node, output->result_name);
+            steps.back().actions->addOrReplaceInOutputs(prewhere_result_node);
+            steps.back().column_name = output->result_name;
+        }
+        else
+        {
+            const auto & node_in_new_dag = addClonedDAGToDAG(output, steps.back().actions, node_remap);
+            steps.back().actions->addOrReplaceInOutputs(node_in_new_dag);
+        }
+    }
+
+    /// 6. Build the PrewhereExprInfo.
+    for (const auto & step : steps)
+    {
+        PrewhereExprStep new_step
+        {
+            .actions = std::make_shared<ExpressionActions>(step.actions, actions_settings),
+            .column_name = step.column_name,
+            /// Don't remove the column if it is among the original outputs.
+            .remove_column = !all_output_names.contains(step.column_name),
+            .need_filter = false,
+        };
+
+        prewhere.steps.push_back(std::move(new_step));
+    }
+
+    prewhere.steps.back().need_filter = prewhere_info->need_filter;
+
+    return true;
+}
+
+}
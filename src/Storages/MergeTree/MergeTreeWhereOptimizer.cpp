@@ -1,6 +1,8 @@
 #include <Storages/MergeTree/MergeTreeWhereOptimizer.h>
 #include <Storages/MergeTree/MergeTreeData.h>
 #include <Storages/MergeTree/KeyCondition.h>
+#include <Functions/FunctionFactory.h>
+#include <Interpreters/Context.h>
 #include <Interpreters/IdentifierSemantic.h>
 #include <Parsers/ASTSelectQuery.h>
 #include <Parsers/ASTFunction.h>
@@ -33,19 +35,26 @@ MergeTreeWhereOptimizer::MergeTreeWhereOptimizer(
     const StorageMetadataPtr & metadata_snapshot,
     const Names & queried_columns_,
     Poco::Logger * log_)
+    /// Subcolumns are counted too: a condition on a subcolumn (e.g. `m.keys` after rewriting
+    /// mapContains() by optimize_functions_to_subcolumns) can be moved to PREWHERE, and it is
+    /// costed by the size of the subcolumn substreams, not of the whole column.
     : table_columns{collections::map<std::unordered_set>(
-        metadata_snapshot->getColumns().getAllPhysical(), [](const NameAndTypePair & col) { return col.name; })}
+        metadata_snapshot->getColumns().get(GetColumnsOptions(GetColumnsOptions::AllPhysical).withSubcolumns()),
+        [](const NameAndTypePair & col) { return col.name; })}
     , queried_columns{queried_columns_}
     , sorting_key_names{NameSet(
           metadata_snapshot->getSortingKey().column_names.begin(), metadata_snapshot->getSortingKey().column_names.end())}
     , block_with_constants{KeyCondition::getBlockWithConstants(query_info.query->clone(), query_info.syntax_analyzer_result, context)}
     , log{log_}
     , column_sizes{std::move(column_sizes_)}
+    , context{context}
 {
     const auto & primary_key = metadata_snapshot->getPrimaryKey();
     if (!primary_key.column_names.empty())
         first_primary_key_column = primary_key.column_names[0];
 
+    move_primary_key_columns_to_prewhere = context->getSettingsRef().move_primary_key_columns_to_prewhere;
+
     for (const auto & name : queried_columns)
     {
         auto it = column_sizes.find(name);
@@ -193,8 +202,10 @@ void MergeTreeWhereOptimizer::analyzeImpl(Conditions & res, const ASTPtr & node,
             /// Condition depend on some column. Constant expressions are not moved.
             !cond.identifiers.empty()
             && !cannotBeMoved(node, is_final)
-            /// Do not take into consideration the conditions consisting only of the first primary key column
-            && !hasPrimaryKeyAtoms(node)
+            /// Do not take into consideration the conditions consisting only of the first primary key column.
+            /// The index prunes granules by them anyway; but for point lookups on wide tables filtering
+            /// by the key column in PREWHERE is still profitable, so it can be allowed by the setting.
+            && (move_primary_key_columns_to_prewhere || !hasPrimaryKeyAtoms(node))
             /// Only table columns are considered. Not array joined columns. NOTE We're assuming that aliases was expanded.
             && isSubsetOfTableColumns(cond.identifiers)
             /// Do not move conditions involving all queried columns.
@@ -407,6 +418,16 @@ bool MergeTreeWhereOptimizer::cannotBeMoved(const ASTPtr & ptr, bool is_final) c
         /// indexHint is a special function that it does not make sense to transfer to PREWHERE
         if ("indexHint" == function_ptr->name)
             return true;
+
+        /// With FINAL, PREWHERE is evaluated before the rows are collapsed, so a function
+        /// that is not deterministic in the scope of the query may give different results
+        /// for duplicates of the same key and change which of them survives.
+        if (is_final)
+        {
+            auto function = FunctionFactory::instance().tryGet(function_ptr->name, context);
+            if (!function || !function->isDeterministicInScopeOfQuery())
+                return true;
+        }
     }
     else if (auto opt_name = IdentifierSemantic::getColumnName(ptr))
     {
@@ -106,12 +106,14 @@ private:
     using StringSet = std::unordered_set<std::string>;
 
     String first_primary_key_column;
+    bool move_primary_key_columns_to_prewhere = false;
     const StringSet table_columns;
     const Names queried_columns;
     const NameSet sorting_key_names;
     const Block block_with_constants;
     Poco::Logger * log;
     std::unordered_map<std::string, UInt64> column_sizes;
+    ContextPtr context;
     UInt64 total_size_of_queried_columns = 0;
     NameSet array_joined_names;
 };
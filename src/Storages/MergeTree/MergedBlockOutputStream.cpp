@@ -39,6 +39,9 @@ MergedBlockOutputStream::MergedBlockOutputStream(
     if (data_part->isStoredOnDisk())
         data_part_storage->createDirectories();
 
+    collect_column_statistics = storage.getSettings()->enable_column_statistics
+        && data_part->isStoredOnDisk() && !data_part->getParentPart();
+
     /// We should write version metadata on part creation to distinguish it from parts that were created without transaction.
     TransactionID tid = txn ? txn->tid : Tx::PrehistoricTID;
     /// NOTE do not pass context for writing to system.transactions_info_log,
@@ -184,7 +187,7 @@ MergedBlockOutputStream::Finalizer MergedBlockOutputStream::finalizePartAsync(
 
     new_part->rows_count = rows_count;
     new_part->modification_time = time(nullptr);
-    new_part->index = writer->releaseIndexColumns();
+    new_part->setIndex(writer->releaseIndexColumns());
     new_part->checksums = checksums;
     new_part->setBytesOnDisk(checksums.getTotalSizeOnDisk());
     new_part->index_granularity = writer->getIndexGranularity();
@@ -270,6 +273,17 @@ MergedBlockOutputStream::WrittenFiles MergedBlockOutputStream::finalizePartOnDis
         written_files.emplace_back(std::move(out));
     }
 
+    if (!column_statistics.empty() && !new_part->getParentPart())
+    {
+        auto out = new_part->getDataPartStorage().writeFile(MergeTreeColumnStatistics::FILE_NAME, 4096, write_settings);
+        HashingWriteBuffer out_hashing(*out);
+        column_statistics.write(out_hashing);
+        checksums.files[MergeTreeColumnStatistics::FILE_NAME].file_size = out_hashing.count();
+        checksums.files[MergeTreeColumnStatistics::FILE_NAME].file_hash = out_hashing.getHash();
+        out->preFinalize();
+        written_files.emplace_back(std::move(out));
+    }
+
     if (!new_part->getSerializationInfos().empty())
     {
         auto out = new_part->getDataPartStorage().writeFile(IMergeTreeDataPart::SERIALIZATION_FILE_NAME, 4096, write_settings);
@@ -324,7 +338,17 @@ void MergedBlockOutputStream::writeImpl(const Block & block, const IColumn::Perm
     if (reset_columns)
         new_serialization_infos.add(block);
 
+    /// The statistics are permutation-invariant, so the unsorted block is fine.
+    if (collect_column_statistics)
+        column_statistics.update(block);
+
     rows_count += rows;
 }
 
+void MergedBlockOutputStream::setPrecomputedColumnStatistics(MergeTreeColumnStatistics statistics)
+{
+    column_statistics = std::move(statistics);
+    collect_column_statistics = false;
+}
+
 }
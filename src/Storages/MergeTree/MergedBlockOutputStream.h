@@ -65,6 +65,10 @@ public:
         const NamesAndTypesList * total_columns_list = nullptr,
         MergeTreeData::DataPart::Checksums * additional_column_checksums = nullptr);
 
+    /// For merges: write the combined statistics of the input parts into the new part
+    /// instead of collecting them from the written rows.
+    void setPrecomputedColumnStatistics(MergeTreeColumnStatistics statistics);
+
 private:
     /** If `permutation` is given, it rearranges the values in the columns when writing.
       * This is necessary to not keep the whole block in the RAM to sort it.
@@ -81,6 +85,11 @@ private:
     size_t rows_count = 0;
     CompressionCodecPtr default_codec;
     WriteSettings write_settings;
+
+    /// Collected per written block when the table enables column statistics,
+    /// unless a merge provided the combined statistics of its input parts.
+    MergeTreeColumnStatistics column_statistics;
+    bool collect_column_statistics = false;
 };
 
 using MergedBlockOutputStreamPtr = std::shared_ptr<MergedBlockOutputStream>;
@@ -43,6 +43,13 @@ public:
     StorageID getStorageID() override;
     UInt64 getPriority() override { return priority; }
 
+    UInt64 getProcessedBytes() const override
+    {
+        if (!merge_list_entry)
+            return 0;
+        return (*merge_list_entry)->bytes_read_uncompressed + (*merge_list_entry)->bytes_written_uncompressed;
+    }
+
 private:
 
     void prepare();
@@ -14,7 +14,7 @@
 #include <Processors/Sources/SourceFromSingleChunk.h>
 #include <Processors/Transforms/ExpressionTransform.h>
 #include <Processors/Transforms/MaterializingTransform.h>
-#include <Processors/Executors/PullingPipelineExecutor.h>
+#include <Processors/Executors/PullingAsyncPipelineExecutor.h>
 #include <Storages/MergeTree/StorageFromMergeTreeDataPart.h>
 #include <Storages/MergeTree/MergeTreeDataWriter.h>
 #include <Storages/MutationCommands.h>
@@ -617,6 +617,11 @@ static NameToNameVector collectFilesForRenames(
         }
     }
 
+    /// A mutation may rewrite or remove column values, which would leave the statistics of the
+    /// source part stale, so drop them conservatively. The next merge of the part recollects.
+    if (source_part->checksums.has(MergeTreeColumnStatistics::FILE_NAME))
+        rename_vector.emplace_back(MergeTreeColumnStatistics::FILE_NAME, "");
+
     return rename_vector;
 }
 
@@ -694,7 +699,7 @@ void finalizeMutatedPart(
 
     new_data_part->rows_count = source_part->rows_count;
     new_data_part->index_granularity = source_part->index_granularity;
-    new_data_part->index = source_part->index;
+    new_data_part->setIndex(source_part->getIndex());
     new_data_part->minmax_idx = source_part->minmax_idx;
     new_data_part->modification_time = time(nullptr);
     new_data_part->loadProjections(false, false);
@@ -734,7 +739,7 @@ struct MutationContext
 
     QueryPipelineBuilder mutating_pipeline_builder;
     QueryPipeline mutating_pipeline; // in
-    std::unique_ptr<PullingPipelineExecutor> mutating_executor{nullptr};
+    std::unique_ptr<PullingAsyncPipelineExecutor> mutating_executor{nullptr};
     ProgressCallback progress_callback;
     Block updated_header;
 
@@ -1030,6 +1035,10 @@ bool PartMergerWriter::mutateOriginalPartAndPrepareProjections()
     Block cur_block;
     if (MutationHelpers::checkOperationIsNotCanceled(*ctx->merges_blocker, ctx->mutate_entry) && ctx->mutating_executor->pull(cur_block))
     {
+        /// The asynchronous executor may return an empty block when the pipeline has just finished.
+        if (!cur_block)
+            return true;
+
         if (ctx->minmax_idx)
             ctx->minmax_idx->update(cur_block, ctx->data->getMinMaxColumnsNames(ctx->metadata_snapshot->getPartitionKey()));
 
@@ -1215,7 +1224,12 @@ private:
         ctx->mutating_pipeline.setProgressCallback(ctx->progress_callback);
         /// Is calculated inside MergeProgressCallback.
         ctx->mutating_pipeline.disableProfileEventUpdate();
-        ctx->mutating_executor = std::make_unique<PullingPipelineExecutor>(ctx->mutating_pipeline);
+        /// The pipeline reads with a single stream to keep the rows in their original order, but the
+        /// transforms of the chain (mutation stages, index and TTL expressions) can process different
+        /// blocks concurrently, and the asynchronous executor overlaps them with writing of the new part.
+        ctx->mutating_pipeline.setNumThreads(std::min<size_t>(
+            ctx->context->getSettingsRef().max_threads, ctx->mutating_pipeline.getProcessors().size()));
+        ctx->mutating_executor = std::make_unique<PullingAsyncPipelineExecutor>(ctx->mutating_pipeline);
 
         part_merger_writer_task = std::make_unique<PartMergerWriter>(ctx);
     }
@@ -1395,7 +1409,10 @@ private:
             ctx->mutating_pipeline.setProgressCallback(ctx->progress_callback);
             /// Is calculated inside MergeProgressCallback.
             ctx->mutating_pipeline.disableProfileEventUpdate();
-            ctx->mutating_executor = std::make_unique<PullingPipelineExecutor>(ctx->mutating_pipeline);
+            /// See the comment in MutateAllPartColumnsTask::prepare().
+            ctx->mutating_pipeline.setNumThreads(std::min<size_t>(
+                ctx->context->getSettingsRef().max_threads, ctx->mutating_pipeline.getProcessors().size()));
+            ctx->mutating_executor = std::make_unique<PullingAsyncPipelineExecutor>(ctx->mutating_pipeline);
 
             ctx->projections_to_build = std::vector<ProjectionDescriptionRawPtr>{ctx->projections_to_recalc.begin(), ctx->projections_to_recalc.end()};
 
@@ -36,6 +36,13 @@ public:
     StorageID getStorageID() override;
     bool executeStep() override;
 
+    UInt64 getProcessedBytes() const override
+    {
+        if (!merge_mutate_entry)
+            return 0;
+        return (*merge_mutate_entry)->bytes_read_uncompressed + (*merge_mutate_entry)->bytes_written_uncompressed;
+    }
+
 protected:
     using PartLogWriter =  std::function<void(const ExecutionStatus &)>;
 
@@ -69,6 +69,8 @@ void ReplicatedMergeTreeCleanupThread::iterate()
             storage.clearOldBrokenPartsFromDetachedDirectory();
     }
 
+    storage.unloadUnusedPrimaryKeys();
+
     /// This is loose condition: no problem if we actually had lost leadership at this moment
     ///  and two replicas will try to do cleanup simultaneously.
     if (storage.is_leader)
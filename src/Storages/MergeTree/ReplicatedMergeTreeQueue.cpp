@@ -620,6 +620,60 @@ int32_t ReplicatedMergeTreeQueue::pullLogsToQueue(zkutil::ZooKeeperPtr zookeeper
     {
         ::sort(log_entries.begin(), log_entries.end());
 
+        const size_t max_multi_batch_size = std::max<size_t>(1, storage.getSettings()->max_replicated_logs_multi_batch_size);
+
+        /// A batch whose multi-request was sent to ZooKeeper but is not confirmed yet.
+        /// While the confirmation is in flight we fetch the data of the next batch,
+        /// so the two round trips overlap and a lagged replica catches up roughly twice as fast.
+        struct UnconfirmedBatch
+        {
+            std::vector<LogEntryPtr> copied_entries;
+            zkutil::ZooKeeper::FutureMulti multi_future;
+        };
+        std::optional<UnconfirmedBatch> unconfirmed_batch;
+
+        auto confirm_batch = [&]
+        {
+            /// Throws if the multi-request has failed. In this case the log pointer was not moved
+            /// and nothing from this batch (and the following ones, which were not sent yet) was applied.
+            auto multi_response = unconfirmed_batch->multi_future.get();
+            auto & responses = multi_response.responses;
+            auto & copied_entries = unconfirmed_batch->copied_entries;
+
+            /// Now we have successfully updated the queue in ZooKeeper. Update it in RAM.
+
+            try
+            {
+                std::lock_guard state_lock(state_mutex);
+
+                for (size_t copied_entry_idx = 0, num_copied_entries = copied_entries.size(); copied_entry_idx < num_copied_entries; ++copied_entry_idx)
+                {
+                    String path_created = dynamic_cast<const Coordination::CreateResponse &>(*responses[copied_entry_idx]).path_created;
+                    copied_entries[copied_entry_idx]->znode_name = path_created.substr(path_created.find_last_of('/') + 1);
+
+                    std::optional<time_t> unused = false;
+                    insertUnlocked(copied_entries[copied_entry_idx], unused, state_lock);
+                }
+
+                last_queue_update = time(nullptr);
+            }
+            catch (...)
+            {
+                tryLogCurrentException(log);
+                /// If it fails, the data in RAM is incorrect. In order to avoid possible further corruption of data in ZK, we will kill ourselves.
+                /// This is possible only if there is an unknown logical error.
+                std::terminate();
+            }
+
+            if (!copied_entries.empty())
+            {
+                LOG_DEBUG(log, "Pulled {} entries to queue.", copied_entries.size());
+                merge_strategy_picker.refreshState();
+            }
+
+            unconfirmed_batch.reset();
+        };
+
         for (size_t entry_idx = 0, num_entries = log_entries.size(); entry_idx < num_entries;)
         {
             auto begin = log_entries.begin() + entry_idx;
@@ -631,9 +685,9 @@ int32_t ReplicatedMergeTreeQueue::pullLogsToQueue(zkutil::ZooKeeperPtr zookeeper
             /// Increment entry_idx before batch size increase (we copied at most current_multi_batch_size entries)
             entry_idx += current_multi_batch_size;
 
-            /// Increase the batch size exponentially, so it will saturate to MAX_MULTI_OPS.
-            if (current_multi_batch_size < MAX_MULTI_OPS)
-                current_multi_batch_size = std::min<size_t>(MAX_MULTI_OPS, current_multi_batch_size * 2);
+            /// Increase the batch size exponentially, so it will saturate to max_multi_batch_size.
+            if (current_multi_batch_size < max_multi_batch_size)
+                current_multi_batch_size = std::min<size_t>(max_multi_batch_size, current_multi_batch_size * 2);
 
             String last_entry = *last;
             if (!startsWith(last_entry, "log-"))
@@ -658,28 +712,39 @@ int32_t ReplicatedMergeTreeQueue::pullLogsToQueue(zkutil::ZooKeeperPtr zookeeper
 
             std::optional<time_t> min_unprocessed_insert_time_changed;
 
-            auto get_results = zookeeper->get(get_paths);
-            auto get_num = get_results.size();
-            for (size_t i = 0; i < get_num; ++i)
+            try
             {
-                auto res = get_results[i];
+                auto get_results = zookeeper->get(get_paths);
+                auto get_num = get_results.size();
+                for (size_t i = 0; i < get_num; ++i)
+                {
+                    auto res = get_results[i];
 
-                copied_entries.emplace_back(LogEntry::parse(res.data, res.stat));
+                    copied_entries.emplace_back(LogEntry::parse(res.data, res.stat));
 
-                ops.emplace_back(zkutil::makeCreateRequest(
-                    fs::path(replica_path) / "queue/queue-", res.data, zkutil::CreateMode::PersistentSequential));
+                    ops.emplace_back(zkutil::makeCreateRequest(
+                        fs::path(replica_path) / "queue/queue-", res.data, zkutil::CreateMode::PersistentSequential));
 
-                const auto & entry = *copied_entries.back();
-                if (entry.type == LogEntry::GET_PART || entry.type == LogEntry::ATTACH_PART)
-                {
-                    std::lock_guard state_lock(state_mutex);
-                    if (entry.create_time && (!min_unprocessed_insert_time || entry.create_time < min_unprocessed_insert_time))
+                    const auto & entry = *copied_entries.back();
+                    if (entry.type == LogEntry::GET_PART || entry.type == LogEntry::ATTACH_PART)
                     {
-                        min_unprocessed_insert_time = entry.create_time;
-                        min_unprocessed_insert_time_changed = min_unprocessed_insert_time;
+                        std::lock_guard state_lock(state_mutex);
+                        if (entry.create_time && (!min_unprocessed_insert_time || entry.create_time < min_unprocessed_insert_time))
+                        {
+                            min_unprocessed_insert_time = entry.create_time;
+                            min_unprocessed_insert_time_changed = min_unprocessed_insert_time;
+                        }
                     }
                 }
             }
+            catch (...)
+            {
+                /// The multi-request of the previous batch could have been executed in ZooKeeper,
+                /// so we must reflect it in RAM before rethrowing. If it has failed too, nothing was applied.
+                if (unconfirmed_batch)
+                    confirm_batch();
+                throw;
+            }
 
             ops.emplace_back(zkutil::makeSetRequest(
                 fs::path(replica_path) / "log_pointer", toString(last_entry_index + 1), -1));
@@ -688,40 +753,17 @@ int32_t ReplicatedMergeTreeQueue::pullLogsToQueue(zkutil::ZooKeeperPtr zookeeper
                 ops.emplace_back(zkutil::makeSetRequest(
                     fs::path(replica_path) / "min_unprocessed_insert_time", toString(*min_unprocessed_insert_time_changed), -1));
 
-            auto responses = zookeeper->multi(ops);
-
-            /// Now we have successfully updated the queue in ZooKeeper. Update it in RAM.
+            /// The multi-request of the previous batch must succeed before we send the next one:
+            /// otherwise a failed batch would be skipped by the moved log pointer.
+            if (unconfirmed_batch)
+                confirm_batch();
 
-            try
-            {
-                std::lock_guard state_lock(state_mutex);
-
-                for (size_t copied_entry_idx = 0, num_copied_entries = copied_entries.size(); copied_entry_idx < num_copied_entries; ++copied_entry_idx)
-                {
-                    String path_created = dynamic_cast<const Coordination::CreateResponse &>(*responses[copied_entry_idx]).path_created;
-                    copied_entries[copied_entry_idx]->znode_name = path_created.substr(path_created.find_last_of('/') + 1);
-
-                    std::optional<time_t> unused = false;
-                    insertUnlocked(copied_entries[copied_entry_idx], unused, state_lock);
-                }
-
-                last_queue_update = time(nullptr);
-            }
-            catch (...)
-            {
-                tryLogCurrentException(log);
-                /// If it fails, the data in RAM is incorrect. In order to avoid possible further corruption of data in ZK, we will kill ourselves.
-                /// This is possible only if there is an unknown logical error.
-                std::terminate();
-            }
-
-            if (!copied_entries.empty())
-            {
-                LOG_DEBUG(log, "Pulled {} entries to queue.", copied_entries.size());
-                merge_strategy_picker.refreshState();
-            }
+            unconfirmed_batch.emplace(UnconfirmedBatch{std::move(copied_entries), zookeeper->asyncMulti(ops)});
         }
 
+        if (unconfirmed_batch)
+            confirm_batch();
+
         storage.background_operations_assignee.trigger();
     }
 
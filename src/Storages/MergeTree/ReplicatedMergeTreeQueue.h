@@ -271,16 +271,13 @@ private:
     };
 
     using CurrentlyExecutingPtr = std::unique_ptr<CurrentlyExecuting>;
-    /// ZK contains a limit on the number or total size of operations in a multi-request.
-    /// If the limit is exceeded, the connection is simply closed.
-    /// The constant is selected with a margin. The default limit in ZK is 1 MB of data in total.
-    /// The average size of the node value in this case is less than 10 kilobytes.
-    static constexpr size_t MAX_MULTI_OPS = 100;
 
     /// Very large queue entries may appear occasionally.
-    /// We cannot process MAX_MULTI_OPS at once because it will fail.
+    /// We cannot copy a whole batch in one multi-request because ZK contains a limit on the number
+    /// or total size of operations in a multi-request (if the limit is exceeded, the connection is simply closed).
     /// But we have to process more than one entry at once because otherwise lagged replicas keep up slowly.
-    /// Let's start with one entry per transaction and increase it exponentially towards MAX_MULTI_OPS.
+    /// Let's start with one entry per transaction and increase it exponentially
+    /// towards max_replicated_logs_multi_batch_size (see MergeTreeSettings).
     /// It will allow to make some progress before failing and remain operational even in extreme cases.
     size_t current_multi_batch_size = 1;
 
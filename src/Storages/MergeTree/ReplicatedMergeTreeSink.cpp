@@ -691,7 +691,27 @@ std::vector<String> ReplicatedMergeTreeSinkImpl<async_insert>::commitPart(
         }
         else if (deduplicate_block)
             block_id_path = storage.zookeeper_path + "/blocks/" + block_id;
-        auto block_number_lock = storage.allocateBlockNumber(part->info.partition_id, zookeeper, block_id_path);
+
+        /// If this replica has recently committed a block with the same id, confirm the duplicate
+        /// with a single read instead of the block allocation transaction. The cache may be stale
+        /// (blocks expire from the deduplication window, partitions may be dropped), so ZooKeeper
+        /// stays the authority: on a stale entry we just drop it and allocate the block as usual.
+        bool known_duplicate = false;
+        if constexpr (!async_insert)
+        {
+            if (deduplicate_block && storage.getSettings()->use_local_block_dedup_cache
+                && storage.local_block_ids_cache.contains(block_id))
+            {
+                if (zookeeper->exists(block_id_path))
+                    known_duplicate = true;
+                else
+                    storage.local_block_ids_cache.remove(block_id);
+            }
+        }
+
+        std::optional<EphemeralLockInZooKeeper> block_number_lock;
+        if (!known_duplicate)
+            block_number_lock = storage.allocateBlockNumber(part->info.partition_id, zookeeper, block_id_path);
         ThreadFuzzer::maybeInjectSleep();
 
         /// Prepare transaction to ZooKeeper
@@ -814,6 +834,11 @@ std::vector<String> ReplicatedMergeTreeSinkImpl<async_insert>::commitPart(
             /// Note: race condition with DROP PARTITION operation is possible. User will get "No node" exception and it is Ok.
             existing_part_name = zookeeper->get(storage.zookeeper_path + "/blocks/" + block_id);
 
+            /// The block is confirmed to exist, remember it so that further retries
+            /// of the same insert do not pay for the block allocation.
+            if (storage.getSettings()->use_local_block_dedup_cache)
+                storage.local_block_ids_cache.add(block_id, storage.getSettings()->replicated_deduplication_window);
+
             /// If it exists on our replica, ignore it.
             if (storage.getActiveContainingPart(existing_part_name))
             {
@@ -929,6 +954,12 @@ std::vector<String> ReplicatedMergeTreeSinkImpl<async_insert>::commitPart(
             /// Lock nodes have been already deleted, do not delete them in destructor
             if (block_number_lock)
                 block_number_lock->assumeUnlocked();
+
+            if constexpr (!async_insert)
+            {
+                if (deduplicate_block && storage.getSettings()->use_local_block_dedup_cache)
+                    storage.local_block_ids_cache.add(block_id, storage.getSettings()->replicated_deduplication_window);
+            }
         }
         else if (multi_code == Coordination::Error::ZNONODE && zkutil::getFailedOpIndex(multi_code, responses) == block_unlock_op_idx)
         {
@@ -0,0 +1,60 @@
+#include <Storages/QueryConditionCache.h>
+
+#include <Interpreters/ActionsDAG.h>
+#include <Storages/SelectQueryInfo.h>
+
+
+namespace DB
+{
+
+std::optional<UInt64> QueryConditionCache::conditionHash(const PrewhereInfo * prewhere_info)
+{
+    if (!prewhere_info || !prewhere_info->prewhere_actions)
+        return {};
+
+    /// Results of row-level security filters depend on the current user and
+    /// must not be shared between queries of different users.
+    if (prewhere_info->row_level_filter)
+        return {};
+
+    SipHash hash;
+    hash.update(prewhere_info->prewhere_actions->dumpDAG());
+    hash.update(prewhere_info->prewhere_column_name);
+    return hash.get64();
+}
+
+MarkRanges QueryConditionCache::filterMarkRanges(const Key & key, const MarkRanges & mark_ranges)
+{
+    auto entry = Base::get(key);
+    if (!entry)
+    {
+        ProfileEvents::increment(ProfileEvents::QueryConditionCacheMisses);
+        return mark_ranges;
+    }
+
+    ProfileEvents::increment(ProfileEvents::QueryConditionCacheHits);
+
+    MarkRanges result;
+    std::lock_guard lock(entry->mutex);
+
+    for (const auto & mark_range : mark_ranges)
+    {
+        size_t begin = mark_range.begin;
+        for (size_t mark = mark_range.begin; mark < mark_range.end && mark < entry->matching_marks.size(); ++mark)
+        {
+            if (!entry->matching_marks[mark])
+            {
+                if (mark > begin)
+                    result.emplace_back(begin, mark);
+                begin = mark + 1;
+            }
+        }
+
+        if (mark_range.end > begin)
+            result.emplace_back(begin, mark_range.end);
+    }
+
+    return result;
+}
+
+}
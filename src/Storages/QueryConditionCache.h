@@ -0,0 +1,93 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <Common/CacheBase.h>
+#include <Common/ProfileEvents.h>
+#include <Common/SipHash.h>
+#include <Interpreters/AggregationCommon.h>
+#include <Storages/MergeTree/MarkRange.h>
+
+
+namespace ProfileEvents
+{
+    extern const Event QueryConditionCacheHits;
+    extern const Event QueryConditionCacheMisses;
+}
+
+namespace DB
+{
+
+struct PrewhereInfo;
+
+/// Per-granule verdicts of a filter condition for one data part.
+/// matching_marks[i] == false means the condition was evaluated on all rows of granule i
+/// and no row passed, so the granule can be skipped by subsequent queries with the same condition.
+struct QueryConditionCacheEntry
+{
+    explicit QueryConditionCacheEntry(size_t marks_count)
+        : matching_marks(marks_count, true) {}
+
+    /// Readers of different threads mark granules concurrently.
+    std::mutex mutex;
+    std::vector<bool> matching_marks;
+};
+
+using QueryConditionCacheEntryPtr = std::shared_ptr<QueryConditionCacheEntry>;
+
+struct QueryConditionCacheWeightFunction
+{
+    /// We spent additional bytes on key in hashmap, linked lists, shared pointers, etc ...
+    static constexpr size_t QUERY_CONDITION_CACHE_OVERHEAD = 128;
+
+    size_t operator()(const QueryConditionCacheEntry & entry) const
+    {
+        return entry.matching_marks.capacity() / 8 + QUERY_CONDITION_CACHE_OVERHEAD;
+    }
+};
+
+
+/** Cache of filter condition results at granule granularity, keyed by (part path, condition hash).
+  * Filled by MergeTreeRangeReader while it filters: granules where the condition selected no rows
+  * are remembered, and index analysis of subsequent queries with the same condition drops them
+  * from the mark ranges before any data is read.
+  * Parts are immutable (mutations produce new parts with new paths), so entries never go stale:
+  * entries of outdated parts stop being requested and are evicted by the cache policy.
+  */
+class QueryConditionCache : public CacheBase<UInt128, QueryConditionCacheEntry, UInt128TrivialHash, QueryConditionCacheWeightFunction>
+{
+private:
+    using Base = CacheBase<UInt128, QueryConditionCacheEntry, UInt128TrivialHash, QueryConditionCacheWeightFunction>;
+
+public:
+    explicit QueryConditionCache(size_t max_size_in_bytes)
+        : Base(max_size_in_bytes) {}
+
+    /// Calculate key from path to part and hash of the filter condition.
+    static UInt128 hash(const String & path_to_part, UInt64 condition_hash)
+    {
+        UInt128 key;
+
+        SipHash hash;
+        hash.update(path_to_part.data(), path_to_part.size() + 1);
+        hash.update(condition_hash);
+        hash.get128(key);
+
+        return key;
+    }
+
+    /// Hash of the PREWHERE condition, or nothing if the query has no condition suitable for
+    /// caching. Row-level security filters are deliberately not cacheable: their results depend
+    /// on the current user and must not be shared between queries.
+    static std::optional<UInt64> conditionHash(const PrewhereInfo * prewhere_info);
+
+    /// Remove the ranges of granules known to select no rows for the given condition.
+    MarkRanges filterMarkRanges(const Key & key, const MarkRanges & mark_ranges);
+};
+
+using QueryConditionCachePtr = std::shared_ptr<QueryConditionCache>;
+
+}
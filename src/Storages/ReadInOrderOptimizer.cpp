@@ -177,10 +177,12 @@ ReadInOrderOptimizer::ReadInOrderOptimizer(
     const ASTSelectQuery & query_,
     const ManyExpressionActions & elements_actions_,
     const SortDescription & required_sort_description_,
-    const TreeRewriterResultPtr & syntax_result)
+    const TreeRewriterResultPtr & syntax_result,
+    bool elements_order_is_free_)
     : elements_actions(elements_actions_)
     , required_sort_description(required_sort_description_)
     , query(query_)
+    , elements_order_is_free(elements_order_is_free_)
 {
     if (elements_actions.size() != required_sort_description.size())
         throw Exception(ErrorCodes::LOGICAL_ERROR, "Sizes of sort description and actions are mismatched");
@@ -211,13 +213,39 @@ InputOrderInfoPtr ReadInOrderOptimizer::getInputOrderImpl(
 
     size_t desc_pos = 0;
     size_t key_pos = 0;
+    std::vector<bool> matched_elements(description.size(), false);
 
     while (desc_pos < description.size() && key_pos < sorting_key_columns.size())
     {
-        if (forbidden_columns.contains(description[desc_pos].column_name))
-            break;
+        MatchResult match;
+        size_t matched_pos = desc_pos;
+
+        if (!elements_order_is_free)
+        {
+            if (forbidden_columns.contains(description[desc_pos].column_name))
+                break;
+
+            match = matchSortDescriptionAndKey(actions[desc_pos]->getActions(), description[desc_pos], sorting_key_columns[key_pos]);
+        }
+        else
+        {
+            /// The elements (e.g. GROUP BY keys) form an unordered set, so any element
+            /// that is not matched yet may continue the prefix of the sorting key.
+            for (size_t i = 0; i < description.size(); ++i)
+            {
+                if (matched_elements[i] || forbidden_columns.contains(description[i].column_name))
+                    continue;
+
+                auto candidate = matchSortDescriptionAndKey(actions[i]->getActions(), description[i], sorting_key_columns[key_pos]);
+                if (candidate.direction)
+                {
+                    match = candidate;
+                    matched_pos = i;
+                    break;
+                }
+            }
+        }
 
-        auto match = matchSortDescriptionAndKey(actions[desc_pos]->getActions(), description[desc_pos], sorting_key_columns[key_pos]);
         bool is_matched = match.direction && (desc_pos == 0 || match.direction == read_direction);
 
         if (!is_matched)
@@ -236,7 +264,8 @@ InputOrderInfoPtr ReadInOrderOptimizer::getInputOrderImpl(
         if (desc_pos == 0)
             read_direction = match.direction;
 
-        sort_description_for_merging.push_back(description[desc_pos]);
+        matched_elements[matched_pos] = true;
+        sort_description_for_merging.push_back(description[matched_pos]);
 
         ++desc_pos;
         ++key_pos;
@@ -15,11 +15,15 @@ namespace DB
 class ReadInOrderOptimizer
 {
 public:
+    /// If `elements_order_is_free` is set, the elements of required sort description may be matched
+    /// with the sorting key in any order. It is correct for GROUP BY keys, which form an unordered
+    /// set: e.g. GROUP BY b, a can be executed in order of a table sorted by (a, b).
     ReadInOrderOptimizer(
         const ASTSelectQuery & query,
         const ManyExpressionActions & elements_actions,
         const SortDescription & required_sort_description,
-        const TreeRewriterResultPtr & syntax_result);
+        const TreeRewriterResultPtr & syntax_result,
+        bool elements_order_is_free_ = false);
 
     InputOrderInfoPtr getInputOrder(const StorageMetadataPtr & metadata_snapshot, ContextPtr context, UInt64 limit = 0) const;
 
@@ -37,5 +41,6 @@ private:
     NameToNameMap array_join_result_to_source;
     SortDescription required_sort_description;
     const ASTSelectQuery & query;
+    bool elements_order_is_free;
 };
 }
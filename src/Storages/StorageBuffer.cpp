@@ -175,23 +175,43 @@ protected:
     {
         Chunk res;
 
+        if (pending_chunk)
+        {
+            res = std::move(*pending_chunk);
+            pending_chunk.reset();
+            return res;
+        }
+
         if (has_been_read)
             return res;
         has_been_read = true;
 
         std::unique_lock lock(buffer.lockForReading());
 
-        if (!buffer.data.rows())
-            return res;
+        auto read_block = [&](const Block & block) -> Chunk
+        {
+            if (!block.rows())
+                return {};
 
-        Columns columns;
-        columns.reserve(column_names_and_types.size());
+            Columns columns;
+            columns.reserve(column_names_and_types.size());
 
-        for (const auto & elem : column_names_and_types)
-            columns.emplace_back(getColumnFromBlock(buffer.data, elem));
+            for (const auto & elem : column_names_and_types)
+                columns.emplace_back(getColumnFromBlock(block, elem));
 
-        UInt64 size = columns.at(0)->size();
-        res.setColumns(std::move(columns), size);
+            UInt64 size = columns.at(0)->size();
+            return Chunk(std::move(columns), size);
+        };
+
+        /// The block which is being written to the destination table right now is still
+        /// a part of the buffer until the write succeeds, return it as well.
+        res = read_block(buffer.flushing_data);
+        Chunk chunk = read_block(buffer.data);
+
+        if (!res.hasRows())
+            res = std::move(chunk);
+        else if (chunk.hasRows())
+            pending_chunk = std::move(chunk);
 
         return res;
     }
@@ -200,6 +220,7 @@ private:
     NamesAndTypesList column_names_and_types;
     StorageBuffer::Buffer & buffer;
     bool has_been_read = false;
+    std::optional<Chunk> pending_chunk;
 };
 
 
@@ -852,12 +873,23 @@ bool StorageBuffer::flushBuffer(Buffer & buffer, bool check_thresholds, bool loc
         return true;
     }
 
-    /** For simplicity, buffer is locked during write.
-        * We could unlock buffer temporary, but it would lead to too many difficulties:
-        * - data, that is written, will not be visible for SELECTs;
-        * - new data could be appended to buffer, and in case of exception, we must merge it with old data, that has not been written;
-        * - this could lead to infinite memory growth.
+    /** Write to the destination table without holding the buffer mutex, so that inserts and
+        * SELECTs are not blocked for the whole duration of the write. The block stays readable
+        * as flushing_data meanwhile, and is merged back into the buffer if the write fails
+        * (memory growth stays limited, because the insert thresholds are checked against the
+        * merged data and the direct flush from inserts still provides backpressure).
+        *
+        * The direct flush from the insert path keeps the lock: its caller appends to the buffer
+        * right after and relies on the memory being freed. If another background write of this
+        * buffer is still in flight, fall back to writing under the lock as well, to have at most
+        * one flushing_data block per buffer.
         */
+    bool background_flush = lock && !buffer.flushing_data;
+    if (background_flush)
+    {
+        buffer.flushing_data = block_to_write;
+        lock->unlock();
+    }
 
     Stopwatch watch;
     try
@@ -868,12 +900,26 @@ bool StorageBuffer::flushBuffer(Buffer & buffer, bool check_thresholds, bool loc
     {
         ProfileEvents::increment(ProfileEvents::StorageBufferErrorOnFlush);
 
-        /// Return the block to its place in the buffer.
+        if (background_flush)
+        {
+            lock->lock();
+            buffer.flushing_data.clear();
+        }
 
-        CurrentMetrics::add(CurrentMetrics::StorageBufferRows, block_to_write.rows());
-        CurrentMetrics::add(CurrentMetrics::StorageBufferBytes, block_to_write.bytes());
+        /// Return the block to its place in the buffer.
+        if (buffer.data)
+        {
+            /// New data could have been appended to the buffer while the write was in flight,
+            /// merge it with the data that has not been written (appendBlock re-adds the metrics).
+            appendBlock(log, block_to_write, buffer.data);
+        }
+        else
+        {
+            CurrentMetrics::add(CurrentMetrics::StorageBufferRows, block_to_write.rows());
+            CurrentMetrics::add(CurrentMetrics::StorageBufferBytes, block_to_write.bytes());
 
-        buffer.data.swap(block_to_write);
+            buffer.data.swap(block_to_write);
+        }
 
         if (!buffer.first_write_time) // -V547
             buffer.first_write_time = current_time;
@@ -882,6 +928,12 @@ bool StorageBuffer::flushBuffer(Buffer & buffer, bool check_thresholds, bool loc
         throw;
     }
 
+    if (background_flush)
+    {
+        lock->lock();
+        buffer.flushing_data.clear();
+    }
+
     total_writes.rows -= block_rows;
     total_writes.bytes -= block_allocated_bytes_delta;
 
@@ -127,6 +127,12 @@ private:
         time_t first_write_time = 0;
         Block data;
 
+        /// Block which is currently being written to the destination table in background,
+        /// without holding the mutex (so that inserts and reads are not blocked by the flush).
+        /// It remains a part of the buffer for SELECTs until the write succeeds,
+        /// and is merged back into `data` if the write fails.
+        Block flushing_data;
+
         std::unique_lock<std::mutex> lockForReading() const;
         std::unique_lock<std::mutex> lockForWriting() const;
         std::unique_lock<std::mutex> tryLock() const;
@@ -27,6 +27,9 @@
 #include <Common/quoteString.h>
 #include <Common/randomSeed.h>
 #include <Common/formatReadable.h>
+#include <Common/Stopwatch.h>
+
+#include <IO/ConnectionTimeouts.h>
 
 #include <Parsers/ASTExpressionList.h>
 #include <Parsers/ASTFunction.h>
@@ -882,7 +885,33 @@ std::optional<QueryPipeline> StorageDistributed::distributedWriteBetweenDistribu
         return {};
     }
 
-    if (settings.parallel_distributed_insert_select == PARALLEL_DISTRIBUTED_INSERT_SELECT_ALL)
+    bool insert_into_local_tables = settings.parallel_distributed_insert_select == PARALLEL_DISTRIBUTED_INSERT_SELECT_ALL;
+    if (insert_into_local_tables)
+    {
+        /// Rows produced by a shard-local SELECT are written to the local destination
+        /// table on the same shard, which is correct only if the tables are co-located:
+        /// the same rows must belong to the same shard in both tables. When both tables
+        /// declare a sharding key, compare the expressions to detect this (textually,
+        /// which is conservative). If one of the keys is not declared, co-location
+        /// cannot be checked and the user's choice of the setting is trusted, as before.
+        bool sharding_key_mismatch = src_distributed.has_sharding_key && has_sharding_key
+            && src_distributed.getShardingKeyColumnName() != getShardingKeyColumnName();
+        if (sharding_key_mismatch)
+        {
+            if (local_context->getClientInfo().distributed_depth == 0)
+            {
+                LOG_WARNING(log,
+                    "Parallel distributed INSERT SELECT into local tables is not possible "
+                    "(source sharding key '{}' differs from destination sharding key '{}', "
+                    "rows would be misplaced), will push down only SELECT",
+                    src_distributed.getShardingKeyColumnName(),
+                    getShardingKeyColumnName());
+            }
+            insert_into_local_tables = false;
+        }
+    }
+
+    if (insert_into_local_tables)
     {
         new_query->table_id = StorageID(getRemoteDatabaseName(), getRemoteTableName());
         /// Reset table function for INSERT INTO remote()/cluster()
@@ -1125,8 +1154,41 @@ void StorageDistributed::initializeFromDisk()
 }
 
 
+void StorageDistributed::startup()
+{
+    if (!distributed_settings.prewarm_connections)
+        return;
+
+    /// Connection setup can be slow, do not block server startup on it.
+    prewarm_task = getContext()->getSchedulePool().createTask(
+        log->name() + "::prewarmConnections", [this] { prewarmConnections(); });
+    prewarm_task->activateAndSchedule();
+}
+
+void StorageDistributed::prewarmConnections()
+{
+    try
+    {
+        auto timeouts = ConnectionTimeouts::getTCPTimeoutsWithFailover(getContext()->getSettingsRef());
+
+        Stopwatch watch;
+        for (const auto & shard_info : getCluster()->getShardsInfo())
+            if (shard_info.hasRemoteConnections())
+                shard_info.pool->preconnect(distributed_settings.prewarm_connections, timeouts);
+
+        LOG_DEBUG(log, "Prewarmed connections in {} ms", watch.elapsedMilliseconds());
+    }
+    catch (...)
+    {
+        tryLogCurrentException(log, "Failed to prewarm connections");
+    }
+}
+
 void StorageDistributed::shutdown()
 {
+    if (prewarm_task)
+        prewarm_task->deactivate();
+
     monitors_blocker.cancelForever();
 
     std::lock_guard lock(cluster_nodes_mutex);
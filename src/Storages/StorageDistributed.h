@@ -6,6 +6,7 @@
 #include <Storages/Distributed/DistributedSettings.h>
 #include <Storages/getStructureOfRemoteTable.h>
 #include <Common/SimpleIncrement.h>
+#include <Core/BackgroundSchedulePool.h>
 #include <Client/ConnectionPool.h>
 #include <Client/ConnectionPoolWithFailover.h>
 #include <Common/logger_useful.h>
@@ -134,6 +135,7 @@ public:
     void alter(const AlterCommands & params, ContextPtr context, AlterLockHolder & table_lock_holder) override;
 
     void initializeFromDisk();
+    void startup() override;
     void shutdown() override;
     void flush() override;
     void drop() override;
@@ -159,6 +161,9 @@ public:
 private:
     void renameOnDisk(const String & new_path_to_table_data);
 
+    /// Establishes connections to remote shards in advance (see the `prewarm_connections` setting).
+    void prewarmConnections();
+
     const ExpressionActionsPtr & getShardingKeyExpr() const { return sharding_key_expr; }
     const String & getShardingKeyColumnName() const { return sharding_key_column_name; }
     const String & getRelativeDataPath() const { return relative_data_path; }
@@ -233,6 +238,9 @@ private:
 
     ActionBlocker monitors_blocker;
 
+    /// One-shot task that establishes connections to remote shards in background after startup.
+    BackgroundSchedulePool::TaskHolder prewarm_task;
+
     String relative_data_path;
 
     /// Can be empty if relative_data_path is empty. In this case, a directory for the data to be sent is not created.
@@ -1,6 +1,7 @@
 #include "StorageLogSettings.h"
 #include <Parsers/ASTCreateQuery.h>
 #include <Parsers/ASTSetQuery.h>
+#include <Common/FieldVisitorConvertToNumber.h>
 
 namespace DB
 {
@@ -16,4 +17,15 @@ String getDiskName(ASTStorage & storage_def)
     return "default";
 }
 
+bool getMinMaxIndexEnabled(const ASTStorage & storage_def)
+{
+    if (storage_def.settings)
+    {
+        for (const auto & change : storage_def.settings->changes)
+            if (change.name == "minmax_index")
+                return applyVisitor(FieldVisitorConvertToNumber<bool>(), change.value);
+    }
+    return false;
+}
+
 }
@@ -7,4 +7,8 @@ namespace DB
     class ASTStorage;
 
     String getDiskName(ASTStorage & storage_def);
+
+    /// Returns the value of the `minmax_index` setting: whether to keep a min-max index
+    /// over the stripes of a StripeLog table to skip stripes at read.
+    bool getMinMaxIndexEnabled(const ASTStorage & storage_def);
 }
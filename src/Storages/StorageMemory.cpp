@@ -139,7 +139,8 @@ public:
 
     void consume(Chunk chunk) override
     {
-        auto block = getHeader().cloneWithColumns(chunk.getColumns());
+        /// Columns are moved out of the chunk, the block takes ownership without copying.
+        auto block = getHeader().cloneWithColumns(chunk.detachColumns());
         storage_snapshot->metadata->check(block, true);
         if (!storage_snapshot->object_columns.empty())
         {
@@ -155,11 +156,11 @@ public:
             for (const auto & elem : block)
                 compressed_block.insert({ elem.column->compress(), elem.type, elem.name });
 
-            new_blocks.emplace_back(compressed_block);
+            new_blocks.emplace_back(std::move(compressed_block));
         }
         else
         {
-            new_blocks.emplace_back(block);
+            new_blocks.emplace_back(std::move(block));
         }
     }
 
@@ -176,8 +177,13 @@ public:
 
         std::lock_guard lock(storage.mutex);
 
-        auto new_data = std::make_unique<Blocks>(*(storage.data.get()));
-        new_data->insert(new_data->end(), new_blocks.begin(), new_blocks.end());
+        /// Readers may still use the old version, so the block headers are copied into the new
+        /// one, but the columns themselves are shared, not copied.
+        auto old_data = storage.data.get();
+        auto new_data = std::make_unique<Blocks>();
+        new_data->reserve(old_data->size() + new_blocks.size());
+        new_data->insert(new_data->end(), old_data->begin(), old_data->end());
+        new_data->insert(new_data->end(), std::make_move_iterator(new_blocks.begin()), std::make_move_iterator(new_blocks.end()));
 
         storage.data.set(std::move(new_data));
         storage.total_size_bytes.fetch_add(inserted_bytes, std::memory_order_relaxed);
@@ -775,6 +775,8 @@ MergeMutateSelectedEntryPtr StorageMergeTree::selectPartsToMerge(
     bool aggressive,
     const String & partition_id,
     bool final,
+    bool deduplicate,
+    const Names & deduplicate_by_columns,
     String * out_disable_reason,
     TableLockHolder & /* table_lock_holder */,
     std::unique_lock<std::mutex> & lock,
@@ -892,7 +894,8 @@ MergeMutateSelectedEntryPtr StorageMergeTree::selectPartsToMerge(
         while (true)
         {
             select_decision = merger_mutator.selectAllPartsToMergeWithinPartition(
-                future_part, can_merge, partition_id, final, metadata_snapshot, txn, out_disable_reason, optimize_skip_merged_partitions);
+                future_part, can_merge, partition_id, final, metadata_snapshot, txn, out_disable_reason, optimize_skip_merged_partitions,
+                deduplicate, deduplicate_by_columns);
             auto timeout_ms = getSettings()->lock_acquire_timeout_for_background_operations.totalMilliseconds();
             auto timeout = std::chrono::milliseconds(timeout_ms);
 
@@ -970,6 +973,8 @@ bool StorageMergeTree::merge(
             aggressive,
             partition_id,
             final,
+            deduplicate,
+            deduplicate_by_columns,
             out_disable_reason,
             table_lock_holder,
             lock,
@@ -1190,7 +1195,7 @@ bool StorageMergeTree::scheduleDataProcessingJob(BackgroundJobsAssignee & assign
         if (merger_mutator.merges_blocker.isCancelled())
             return false;
 
-        merge_entry = selectPartsToMerge(metadata_snapshot, false, {}, false, nullptr, shared_lock, lock, txn);
+        merge_entry = selectPartsToMerge(metadata_snapshot, false, {}, false, false, {}, nullptr, shared_lock, lock, txn);
 
         if (!merge_entry && !current_mutations_by_version.empty())
             mutate_entry = selectPartsToMutate(metadata_snapshot, nullptr, shared_lock, lock);
@@ -1250,6 +1255,7 @@ bool StorageMergeTree::scheduleDataProcessingJob(BackgroundJobsAssignee & assign
                 cleared_count += clearEmptyParts();
                 if (getSettings()->merge_tree_enable_clear_old_broken_detached)
                     cleared_count += clearOldBrokenPartsFromDetachedDirectory();
+                cleared_count += unloadUnusedPrimaryKeys();
                 return cleared_count;
                 /// TODO maybe take into account number of cleared objects when calculating backoff
             }, common_assignee_trigger, getStorageID()), /* need_trigger */ false);
@@ -1854,6 +1860,81 @@ void StorageMergeTree::replacePartitionFrom(const StoragePtr & source_table, con
     }
 }
 
+bool StorageMergeTree::cloneAllPartsFrom(const StoragePtr & source_table, ContextPtr local_context)
+{
+    auto lock1 = lockForShare(local_context->getCurrentQueryId(), local_context->getSettingsRef().lock_acquire_timeout);
+    auto lock2 = source_table->lockForShare(local_context->getCurrentQueryId(), local_context->getSettingsRef().lock_acquire_timeout);
+    auto source_metadata_snapshot = source_table->getInMemoryMetadataPtr();
+    auto my_metadata_snapshot = getInMemoryMetadataPtr();
+
+    MergeTreeData * src_data = tryGetMergeTreeDataWithSameStructure(*source_table, source_metadata_snapshot, my_metadata_snapshot);
+    if (!src_data)
+        return false;
+
+    /// Hardlinks require the parts of both tables to live on the same disks.
+    if (getStoragePolicy() != src_data->getStoragePolicy())
+        return false;
+
+    Stopwatch watch;
+    DataPartsVector src_parts = src_data->getVisibleDataPartsVector(local_context);
+
+    /// Cloning is all-or-nothing: decide to fall back to inserting rows before any side effects.
+    for (const DataPartPtr & src_part : src_parts)
+        if (!canReplacePartition(src_part))
+            return false;
+
+    auto merges_blocker = stopMergesAndWait();
+
+    MutableDataPartsVector dst_parts;
+    std::vector<scope_guard> dst_parts_locks;
+
+    static const String TMP_PREFIX = "tmp_clone_from_";
+
+    for (const DataPartPtr & src_part : src_parts)
+    {
+        /// This will generate unique name in scope of current server process.
+        Int64 temp_index = insert_increment.get();
+        MergeTreePartInfo dst_part_info(src_part->info.partition_id, temp_index, temp_index, src_part->info.level);
+
+        auto [dst_part, part_lock] = cloneAndLoadDataPartOnSameDisk(src_part, TMP_PREFIX, dst_part_info, my_metadata_snapshot, local_context->getCurrentTransaction(), {}, false, {});
+        dst_parts.emplace_back(std::move(dst_part));
+        dst_parts_locks.emplace_back(std::move(part_lock));
+    }
+
+    if (dst_parts.empty())
+        return true;
+
+    try
+    {
+        {
+            /// Here we use the transaction just like RAII since rare errors in renameTempPartAndReplace() are possible
+            ///  and we should be able to rollback already added (Precomitted) parts
+            Transaction transaction(*this, local_context->getCurrentTransaction().get());
+
+            auto data_parts_lock = lockParts();
+
+            for (auto part : dst_parts)
+            {
+                fillNewPartName(part, data_parts_lock);
+                renameTempPartAndReplaceUnlocked(part, transaction, data_parts_lock);
+            }
+            /// Populate transaction
+            transaction.commit(&data_parts_lock);
+        }
+
+        PartLog::addNewParts(getContext(), dst_parts, watch.elapsed());
+    }
+    catch (...)
+    {
+        PartLog::addNewParts(getContext(), dst_parts, watch.elapsed(), ExecutionStatus::fromCurrentException());
+        throw;
+    }
+
+    LOG_INFO(log, "Attached {} hardlinked clones of parts of table {} instead of inserting rows",
+        dst_parts.size(), source_table->getStorageID().getNameForLogs());
+    return true;
+}
+
 void StorageMergeTree::movePartitionToTable(const StoragePtr & dest_table, const ASTPtr & partition, ContextPtr local_context)
 {
     auto lock1 = lockForShare(local_context->getCurrentQueryId(), local_context->getSettingsRef().lock_acquire_timeout);
@@ -74,6 +74,11 @@ public:
 
     SinkToStoragePtr write(const ASTPtr & query, const StorageMetadataPtr & /*metadata_snapshot*/, ContextPtr context) override;
 
+    /// INSERT SELECT fast path: attach hardlinked clones of all parts of the source table
+    /// (see optimize_insert_select_with_part_cloning). Returns false without side effects
+    /// if the tables are not similar enough and the caller has to fall back to inserting rows.
+    bool cloneAllPartsFrom(const StoragePtr & source_table, ContextPtr local_context);
+
     /** Perform the next step in combining the parts.
       */
     bool optimize(
@@ -194,6 +199,8 @@ private:
         bool aggressive,
         const String & partition_id,
         bool final,
+        bool deduplicate,
+        const Names & deduplicate_by_columns,
         String * disable_reason,
         TableLockHolder & table_lock_holder,
         std::unique_lock<std::mutex> & lock,
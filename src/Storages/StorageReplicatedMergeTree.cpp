@@ -4166,6 +4166,17 @@ bool StorageReplicatedMergeTree::fetchPart(
             /// So let's just remove them from the queue.
             queue.removePartProducingOpsInRange(zookeeper, part->info, /* covering_entry= */ {}, entry_znode);
 
+            /// If the fetcher deferred checksum verification, hash the part lazily in the background.
+            /// On mismatch the part check thread detaches it as broken and initiates another fetch.
+            if (getSettings()->replicated_fetches_defer_checksum_verification
+                && !part_to_clone && !part->getDataPartStorage().supportZeroCopyReplication())
+                part_check_thread.enqueuePart(part_name);
+
+            /// Keep the mark cache of mostly-fetching replicas (e.g. hot standbys) warm, so that they can
+            /// serve queries at full speed immediately after a failover.
+            if (getSettings()->replicated_fetches_populate_mark_cache)
+                part->loadMarksToCache(getContext()->getMarkCache().get());
+
             write_part_log({});
         }
         else
@@ -4306,6 +4317,11 @@ MutableDataPartStoragePtr StorageReplicatedMergeTree::fetchExistsPart(
 
     ProfileEvents::increment(ProfileEvents::ReplicatedPartFetches);
 
+    /// If the fetcher deferred checksum verification, hash the part lazily in the background.
+    if (getSettings()->replicated_fetches_defer_checksum_verification
+        && !part->getDataPartStorage().supportZeroCopyReplication())
+        part_check_thread.enqueuePart(part_name);
+
     LOG_DEBUG(log, "Fetched part {} from {}", part_name, source_replica_path);
     return part->getDataPartStoragePtr();
 }
@@ -4848,7 +4864,8 @@ bool StorageReplicatedMergeTree::optimize(
             {
                 select_decision = merger_mutator.selectAllPartsToMergeWithinPartition(
                     future_merged_part, can_merge, partition_id, final, metadata_snapshot, NO_TRANSACTION_PTR,
-                    &disable_reason, query_context->getSettingsRef().optimize_skip_merged_partitions);
+                    &disable_reason, query_context->getSettingsRef().optimize_skip_merged_partitions,
+                    deduplicate, deduplicate_by_columns);
             }
 
             /// If there is nothing to merge then we treat this merge as successful (needed for optimize final optimization)
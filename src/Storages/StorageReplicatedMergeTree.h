@@ -5,6 +5,7 @@
 #include <pcg_random.hpp>
 #include <Storages/IStorage.h>
 #include <Storages/MergeTree/AsyncBlockIDsCache.h>
+#include <Storages/MergeTree/LocalBlockIDsCache.h>
 #include <Storages/IStorageCluster.h>
 #include <Storages/MergeTree/DataPartsExchange.h>
 #include <Storages/MergeTree/EphemeralLockInZooKeeper.h>
@@ -447,6 +448,9 @@ private:
 
     AsyncBlockIDsCache async_block_ids_cache;
 
+    /// Block ids of recently committed inserts, used to short circuit deduplication checks.
+    LocalBlockIDsCache local_block_ids_cache;
+
     /// A thread that checks the data of the parts, as well as the queue of the parts to be checked.
     ReplicatedMergeTreePartCheckThread part_check_thread;
 
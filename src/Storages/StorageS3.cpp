@@ -169,11 +169,23 @@ public:
             return;
         }
 
-        request.SetBucket(globbed_uri.bucket);
-        request.SetPrefix(key_prefix);
-        request.SetMaxKeys(static_cast<int>(request_settings.list_object_keys_size));
+        auto listing_cache_ttl = static_cast<time_t>(getContext()->getSettingsRef().s3_listing_cache_ttl);
+        if (listing_cache_ttl)
+        {
+            listing_cache_key = fs::path(globbed_uri.uri.getHost() + std::to_string(globbed_uri.uri.getPort())) / globbed_uri.bucket / key_prefix;
+            cached_listing = StorageS3::getListingCache(getContext()).tryGet(listing_cache_key, listing_cache_ttl);
+            if (!cached_listing)
+                listing_to_cache = std::make_shared<ObjectListingCache::Objects>();
+        }
 
-        outcome_future = listObjectsAsync();
+        if (!cached_listing)
+        {
+            request.SetBucket(globbed_uri.bucket);
+            request.SetPrefix(key_prefix);
+            request.SetMaxKeys(static_cast<int>(request_settings.list_object_keys_size));
+
+            outcome_future = listObjectsAsync();
+        }
 
         matcher = std::make_unique<re2::RE2>(makeRegexpPatternFromGlobs(globbed_uri.key));
         if (!matcher->ok())
@@ -236,10 +248,8 @@ private:
         return nextAssumeLocked();
     }
 
-    void fillInternalBufferAssumeLocked()
+    KeysWithInfo listNextBatchAssumeLocked()
     {
-        buffer.clear();
-
         assert(outcome_future.valid());
         auto outcome = outcome_future.get();
 
@@ -269,21 +279,64 @@ private:
         for (const auto & row : result_batch)
         {
             String key = row.GetKey();
+            S3::ObjectInfo info =
+            {
+                .size = size_t(row.GetSize()),
+                .last_modification_time = row.GetLastModified().Millis() / 1000,
+            };
+
+            /// The cache stores the whole listing of the prefix, before matching
+            /// against the glob, so that queries with other globs can reuse it.
+            if (listing_to_cache)
+                listing_to_cache->push_back({key, info.size, info.last_modification_time});
+
             if (recursive || re2::RE2::FullMatch(key, *matcher))
+            {
+                if (object_infos)
+                    (*object_infos)[fs::path(globbed_uri.bucket) / key] = info;
+
+                temp_buffer.emplace_back(std::move(key), std::move(info));
+            }
+        }
+
+        if (is_finished && listing_to_cache)
+            StorageS3::getListingCache(getContext()).add(listing_cache_key, std::exchange(listing_to_cache, nullptr));
+
+        return temp_buffer;
+    }
+
+    KeysWithInfo matchCachedListingAssumeLocked()
+    {
+        /// The cached listing is complete, so a single batch covers everything.
+        is_finished = true;
+
+        KeysWithInfo temp_buffer;
+        for (const auto & object : *cached_listing)
+        {
+            if (recursive || re2::RE2::FullMatch(object.key, *matcher))
             {
                 S3::ObjectInfo info =
                 {
-                    .size = size_t(row.GetSize()),
-                    .last_modification_time = row.GetLastModified().Millis() / 1000,
+                    .size = object.size,
+                    .last_modification_time = object.last_modification_time,
                 };
 
                 if (object_infos)
-                    (*object_infos)[fs::path(globbed_uri.bucket) / key] = info;
+                    (*object_infos)[fs::path(globbed_uri.bucket) / object.key] = info;
 
-                temp_buffer.emplace_back(std::move(key), std::move(info));
+                temp_buffer.emplace_back(object.key, std::move(info));
             }
         }
 
+        return temp_buffer;
+    }
+
+    void fillInternalBufferAssumeLocked()
+    {
+        buffer.clear();
+
+        KeysWithInfo temp_buffer = cached_listing ? matchCachedListingAssumeLocked() : listNextBatchAssumeLocked();
+
         if (temp_buffer.empty())
         {
             buffer_iter = buffer.begin();
@@ -379,6 +432,12 @@ private:
     Aws::S3::Model::ListObjectsV2Request request;
     S3Settings::RequestSettings request_settings;
 
+    String listing_cache_key;
+    /// If not nullptr, the keys are taken from the cached listing and no LIST requests are issued.
+    ObjectListingCache::ObjectsPtr cached_listing;
+    /// If not nullptr, the listing being fetched is accumulated here to be cached once it is complete.
+    std::shared_ptr<ObjectListingCache::Objects> listing_to_cache;
+
     ThreadPool list_objects_pool;
     ThreadPoolCallbackRunner<ListObjectsOutcome> list_objects_scheduler;
     std::future<ListObjectsOutcome> outcome_future;
@@ -1523,6 +1582,12 @@ SchemaCache & StorageS3::getSchemaCache(const ContextPtr & ctx)
     return schema_cache;
 }
 
+ObjectListingCache & StorageS3::getListingCache(const ContextPtr & ctx)
+{
+    static ObjectListingCache listing_cache(ctx->getConfigRef().getUInt("object_listing_cache_max_entries_for_s3", DEFAULT_OBJECT_LISTING_CACHE_ENTRIES));
+    return listing_cache;
+}
+
 std::optional<ColumnsDescription> StorageS3::tryGetColumnsFromCache(
     const Strings::const_iterator & begin,
     const Strings::const_iterator & end,
@@ -21,6 +21,7 @@
 #include <Interpreters/threadPoolCallbackRunner.h>
 #include <Storages/ExternalDataSourceConfiguration.h>
 #include <Storages/Cache/SchemaCache.h>
+#include <Storages/Cache/ObjectListingCache.h>
 
 namespace Aws::S3
 {
@@ -316,6 +317,8 @@ public:
 
     static SchemaCache & getSchemaCache(const ContextPtr & ctx);
 
+    static ObjectListingCache & getListingCache(const ContextPtr & ctx);
+
 private:
     friend class StorageS3Cluster;
     friend class TableFunctionS3Cluster;
@@ -10,15 +10,21 @@
 #include <Compression/CompressedReadBuffer.h>
 #include <Compression/CompressedReadBufferFromFile.h>
 #include <Compression/CompressedWriteBuffer.h>
+#include <IO/ReadHelpers.h>
 #include <IO/WriteHelpers.h>
 #include <IO/copyData.h>
 
 #include <Formats/NativeReader.h>
 #include <Formats/NativeWriter.h>
 
+#include <Columns/ColumnNullable.h>
 #include <DataTypes/DataTypeFactory.h>
+#include <DataTypes/DataTypeLowCardinality.h>
+#include <DataTypes/DataTypeNullable.h>
 
 #include <Interpreters/Context.h>
+#include <Interpreters/ExpressionActions.h>
+#include <Storages/MergeTree/KeyCondition.h>
 
 #include <Parsers/ASTLiteral.h>
 #include <Storages/StorageFactory.h>
@@ -53,6 +59,104 @@ namespace ErrorCodes
 }
 
 
+size_t MinMaxForStripe::read(ReadBuffer & istr)
+{
+    size_t stripe;
+    readVarUInt(stripe, istr);
+
+    size_t num_columns;
+    readVarUInt(num_columns, istr);
+
+    columns.clear();
+    for (size_t i = 0; i < num_columns; ++i)
+    {
+        auto & column = columns.emplace_back();
+        readBinary(column.name, istr);
+        readBinary(column.type, istr);
+
+        auto serialization = DataTypeFactory::instance().get(column.type)->getDefaultSerialization();
+        serialization->deserializeBinary(column.min, istr, {});
+        serialization->deserializeBinary(column.max, istr, {});
+
+        /// NULL_LAST, the same as in the min-max index of MergeTree.
+        if (column.min.isNull())
+            column.min = POSITIVE_INFINITY;
+        if (column.max.isNull())
+            column.max = POSITIVE_INFINITY;
+    }
+
+    return stripe;
+}
+
+void MinMaxForStripe::write(size_t stripe, WriteBuffer & ostr) const
+{
+    writeVarUInt(stripe, ostr);
+    writeVarUInt(columns.size(), ostr);
+
+    for (const auto & column : columns)
+    {
+        writeBinary(column.name, ostr);
+        writeBinary(column.type, ostr);
+
+        auto serialization = DataTypeFactory::instance().get(column.type)->getDefaultSerialization();
+        serialization->serializeBinary(column.min, ostr, {});
+        serialization->serializeBinary(column.max, ostr, {});
+    }
+}
+
+void MinMaxIndexForStripeLog::read(ReadBuffer & istr, size_t num_stripes)
+{
+    stripes.clear();
+    stripes.resize(num_stripes);
+
+    while (!istr.eof())
+    {
+        MinMaxForStripe stripe;
+        size_t stripe_num = stripe.read(istr);
+
+        /// Entries for unknown stripes may be left e.g. after restoring from a backup of another table, just ignore them.
+        if (stripe_num < num_stripes)
+            stripes[stripe_num] = std::move(stripe);
+    }
+}
+
+
+/// Extremes are meaningful only for the columns that really calculate them: see IColumn::getExtremes.
+static bool minMaxIndexApplicable(const DataTypePtr & type)
+{
+    DataTypePtr nested = removeNullable(removeLowCardinality(type));
+    return nested->isValueRepresentedByNumber() || isStringOrFixedString(nested);
+}
+
+static MinMaxForStripe buildMinMaxForStripe(const Block & block)
+{
+    MinMaxForStripe res;
+
+    for (const auto & elem : block)
+    {
+        if (!minMaxIndexApplicable(elem.type))
+            continue;
+
+        Field min;
+        Field max;
+        if (const auto * nullable = typeid_cast<const ColumnNullable *>(elem.column.get()))
+            nullable->getExtremesNullLast(min, max);
+        else
+            elem.column->getExtremes(min, max);
+
+        /// NULL_LAST, the same as in the min-max index of MergeTree.
+        if (min.isNull())
+            min = POSITIVE_INFINITY;
+        if (max.isNull())
+            max = POSITIVE_INFINITY;
+
+        res.columns.emplace_back(ColumnMinMaxForStripe{elem.name, elem.type->getName(), std::move(min), std::move(max)});
+    }
+
+    return res;
+}
+
+
 /// NOTE: The lock `StorageStripeLog::rwlock` is NOT kept locked while reading,
 /// because we read ranges of data that do not change.
 class StripeLogSource final : public ISource
@@ -216,7 +320,12 @@ public:
 
     void consume(Chunk chunk) override
     {
-        block_out->write(getHeader().cloneWithColumns(chunk.detachColumns()));
+        Block block = getHeader().cloneWithColumns(chunk.detachColumns());
+        block_out->write(block);
+
+        /// NativeWriter has just appended the index entry for this stripe.
+        if (storage.minmax_index_enabled)
+            storage.minmax_indices.stripes.push_back(buildMinMaxForStripe(block));
     }
 
     void onFinish() override
@@ -264,6 +373,7 @@ StorageStripeLog::StorageStripeLog(
     const ColumnsDescription & columns_,
     const ConstraintsDescription & constraints_,
     const String & comment,
+    bool minmax_index_enabled_,
     bool attach,
     ContextMutablePtr context_)
     : IStorage(table_id_)
@@ -272,7 +382,9 @@ StorageStripeLog::StorageStripeLog(
     , table_path(relative_path_)
     , data_file_path(table_path + "data.bin")
     , index_file_path(table_path + "index.mrk")
+    , minmax_file_path(table_path + "minmax.idx")
     , file_checker(disk, table_path + "sizes.json")
+    , minmax_index_enabled(minmax_index_enabled_)
     , max_compress_block_size(context_->getSettings().max_compress_block_size)
     , log(&Poco::Logger::get("StorageStripeLog"))
 {
@@ -290,6 +402,13 @@ StorageStripeLog::StorageStripeLog(
     {
         file_checker.setEmpty(data_file_path);
         file_checker.setEmpty(index_file_path);
+        if (minmax_index_enabled)
+            file_checker.setEmpty(minmax_file_path);
+    }
+    else if (minmax_index_enabled && !file_checker.contains(minmax_file_path))
+    {
+        /// The min-max index is enabled for a table that was created without it.
+        file_checker.setEmpty(minmax_file_path);
     }
 
     if (!attach)
@@ -326,6 +445,7 @@ void StorageStripeLog::rename(const String & new_path_to_table_data, const Stora
         table_path = new_path_to_table_data;
         data_file_path = table_path + "data.bin";
         index_file_path = table_path + "index.mrk";
+        minmax_file_path = table_path + "minmax.idx";
         file_checker.setPath(table_path + "sizes.json");
     }
     renameInMemory(new_table_id);
@@ -345,7 +465,7 @@ static std::chrono::seconds getLockTimeout(ContextPtr local_context)
 Pipe StorageStripeLog::read(
     const Names & column_names,
     const StorageSnapshotPtr & storage_snapshot,
-    SelectQueryInfo & /*query_info*/,
+    SelectQueryInfo & query_info,
     ContextPtr local_context,
     QueryProcessingStage::Enum /*processed_stage*/,
     const size_t /*max_block_size*/,
@@ -364,8 +484,19 @@ Pipe StorageStripeLog::read(
     if (!data_file_size)
         return Pipe(std::make_shared<NullSource>(storage_snapshot->getSampleBlockForColumns(column_names)));
 
+    const IndexForNativeFormat * used_indices = &indices;
+    IndexForNativeFormat pruned_indices;
+    if (minmax_index_enabled)
+    {
+        pruned_indices = selectStripesToRead(query_info, local_context);
+        used_indices = &pruned_indices;
+    }
+
+    if (used_indices->blocks.empty())
+        return Pipe(std::make_shared<NullSource>(storage_snapshot->getSampleBlockForColumns(column_names)));
+
     auto indices_for_selected_columns
-        = std::make_shared<IndexForNativeFormat>(indices.extractIndexForColumns(NameSet{column_names.begin(), column_names.end()}));
+        = std::make_shared<IndexForNativeFormat>(used_indices->extractIndexForColumns(NameSet{column_names.begin(), column_names.end()}));
 
     size_t size = indices_for_selected_columns->blocks.size();
     if (num_streams > size)
@@ -392,6 +523,85 @@ Pipe StorageStripeLog::read(
 }
 
 
+/// Decides whether a stripe may contain rows satisfying the condition by the min-max values of its columns.
+static bool stripeMayBeTrue(
+    const MinMaxForStripe & stripe,
+    const KeyCondition & condition,
+    const NamesAndTypesList & minmax_columns,
+    const DataTypes & minmax_data_types)
+{
+    std::vector<Range> hyperrectangle;
+    hyperrectangle.reserve(minmax_columns.size());
+
+    for (const auto & column : minmax_columns)
+    {
+        const ColumnMinMaxForStripe * found = nullptr;
+        for (const auto & candidate : stripe.columns)
+        {
+            if (candidate.name == column.name && candidate.type == column.type->getName())
+            {
+                found = &candidate;
+                break;
+            }
+        }
+
+        /// The min-max values of a column may be unknown, e.g. if the stripe was written before the column was added.
+        if (found)
+            hyperrectangle.emplace_back(found->min, true, found->max, true);
+        else
+            hyperrectangle.emplace_back(Range::createWholeUniverse());
+    }
+
+    return condition.checkInHyperrectangle(hyperrectangle, minmax_data_types).can_be_true;
+}
+
+IndexForNativeFormat StorageStripeLog::selectStripesToRead(const SelectQueryInfo & query_info, ContextPtr local_context) const
+{
+    if (minmax_indices.stripes.empty())
+        return indices;
+
+    NamesAndTypesList minmax_columns;
+    for (const auto & column : getInMemoryMetadataPtr()->getColumns().getAllPhysical())
+        if (minMaxIndexApplicable(column.type))
+            minmax_columns.push_back(column);
+
+    if (minmax_columns.empty())
+        return indices;
+
+    auto minmax_expr = std::make_shared<ExpressionActions>(
+        std::make_shared<ActionsDAG>(minmax_columns), ExpressionActionsSettings::fromContext(local_context));
+
+    std::optional<KeyCondition> condition;
+    if (local_context->getSettingsRef().allow_experimental_analyzer)
+        condition.emplace(query_info.filter_actions_dag, local_context, minmax_columns.getNames(), minmax_expr, NameSet{});
+    else
+        condition.emplace(query_info, local_context, minmax_columns.getNames(), minmax_expr);
+
+    if (condition->alwaysUnknownOrTrue())
+        return indices;
+
+    DataTypes minmax_data_types;
+    minmax_data_types.reserve(minmax_columns.size());
+    for (const auto & column : minmax_columns)
+        minmax_data_types.push_back(column.type);
+
+    IndexForNativeFormat res;
+    res.blocks.reserve(indices.blocks.size());
+
+    for (size_t i = 0; i != indices.blocks.size(); ++i)
+    {
+        if (i < minmax_indices.stripes.size()
+            && !stripeMayBeTrue(minmax_indices.stripes[i], *condition, minmax_columns, minmax_data_types))
+            continue;
+
+        res.blocks.push_back(indices.blocks[i]);
+    }
+
+    LOG_DEBUG(log, "MinMax index has dropped {}/{} stripes", indices.blocks.size() - res.blocks.size(), indices.blocks.size());
+    return res;
+}
+
+
 SinkToStoragePtr StorageStripeLog::write(const ASTPtr & /*query*/, const StorageMetadataPtr & metadata_snapshot, ContextPtr local_context)
 {
     WriteLock lock{rwlock, getLockTimeout(local_context)};
@@ -417,8 +627,11 @@ void StorageStripeLog::truncate(const ASTPtr &, const StorageMetadataPtr &, Cont
     disk->clearDirectory(table_path);
 
     indices.clear();
+    minmax_indices.clear();
     file_checker.setEmpty(data_file_path);
     file_checker.setEmpty(index_file_path);
+    if (minmax_index_enabled)
+        file_checker.setEmpty(minmax_file_path);
 
     indices_loaded = true;
     num_indices_saved = 0;
@@ -452,6 +665,20 @@ void StorageStripeLog::loadIndices(const WriteLock & lock /* already locked excl
         indices.read(index_in);
     }
 
+    if (minmax_index_enabled)
+    {
+        if (disk->exists(minmax_file_path))
+        {
+            CompressedReadBufferFromFile minmax_in(disk->readFile(minmax_file_path, ReadSettings{}.adjustBufferSize(4096)));
+            minmax_indices.read(minmax_in, indices.blocks.size());
+        }
+        else
+        {
+            /// There are no saved min-max values yet, e.g. the index was enabled for an existing table.
+            minmax_indices.stripes.resize(indices.blocks.size());
+        }
+    }
+
     indices_loaded = true;
     num_indices_saved = indices.blocks.size();
 
@@ -477,6 +704,20 @@ void StorageStripeLog::saveIndices(const WriteLock & /* already locked for writi
     index_out_compressed->next();
     index_out_compressed->finalize();
 
+    if (minmax_index_enabled)
+    {
+        auto minmax_out_compressed = disk->writeFile(minmax_file_path, DBMS_DEFAULT_BUFFER_SIZE, WriteMode::Append);
+        auto minmax_out = std::make_unique<CompressedWriteBuffer>(*minmax_out_compressed);
+
+        for (size_t i = start; i != num_indices; ++i)
+            if (i < minmax_indices.stripes.size() && !minmax_indices.stripes[i].columns.empty())
+                minmax_indices.stripes[i].write(i, *minmax_out);
+
+        minmax_out->next();
+        minmax_out_compressed->next();
+        minmax_out_compressed->finalize();
+    }
+
     num_indices_saved = num_indices;
 }
 
@@ -485,6 +726,9 @@ void StorageStripeLog::removeUnsavedIndices(const WriteLock & /* already locked
 {
     if (indices.blocks.size() > num_indices_saved)
         indices.blocks.resize(num_indices_saved);
+
+    if (minmax_indices.stripes.size() > num_indices_saved)
+        minmax_indices.stripes.resize(num_indices_saved);
 }
 
 
@@ -492,6 +736,8 @@ void StorageStripeLog::saveFileSizes(const WriteLock & /* already locked for wri
 {
     file_checker.update(data_file_path);
     file_checker.update(index_file_path);
+    if (minmax_index_enabled)
+        file_checker.update(minmax_file_path);
     file_checker.save();
     total_bytes = file_checker.getTotalSize();
 }
@@ -566,6 +812,19 @@ void StorageStripeLog::backupData(BackupEntriesCollector & backup_entries_collec
                 disk, hardlink_file_path, file_checker.getFileSize(index_file_path), std::nullopt, temp_dir_owner));
     }
 
+    /// minmax.idx
+    if (minmax_index_enabled && disk->exists(minmax_file_path))
+    {
+        /// We make a copy of the file because it can be changed later in write() or in truncate().
+        String minmax_file_name = fileName(minmax_file_path);
+        String hardlink_file_path = temp_dir / minmax_file_name;
+        disk->createHardLink(minmax_file_path, hardlink_file_path);
+        backup_entries_collector.addBackupEntry(
+            data_path_in_backup_fs / minmax_file_name,
+            std::make_unique<BackupEntryFromAppendOnlyFile>(
+                disk, hardlink_file_path, file_checker.getFileSize(minmax_file_path), std::nullopt, temp_dir_owner));
+    }
+
     /// sizes.json
     String files_info_path = file_checker.getPath();
     backup_entries_collector.addBackupEntry(
@@ -648,6 +907,28 @@ void StorageStripeLog::restoreDataImpl(const BackupPtr & backup, const String &
                     column.location.offset_in_compressed_file += old_data_size;
             }
 
+            /// Append the min-max index. The stripe numbers are rebased automatically
+            /// because the entries are saved with the numbers of their new positions.
+            if (minmax_index_enabled)
+            {
+                MinMaxIndexForStripeLog extra_minmax;
+                String minmax_path_in_backup = data_path_in_backup_fs / fileName(minmax_file_path);
+                if (backup->fileExists(minmax_path_in_backup))
+                {
+                    auto minmax_entry = backup->readFile(minmax_path_in_backup);
+                    auto minmax_in = minmax_entry->getReadBuffer();
+                    CompressedReadBuffer minmax_compressed_in{*minmax_in};
+                    extra_minmax.read(minmax_compressed_in, extra_indices.blocks.size());
+                }
+                else
+                {
+                    /// The backup was made without the min-max index, the restored stripes are never skipped.
+                    extra_minmax.stripes.resize(extra_indices.blocks.size());
+                }
+
+                insertAtEnd(minmax_indices.stripes, std::move(extra_minmax.stripes));
+            }
+
             insertAtEnd(indices.blocks, std::move(extra_indices.blocks));
         }
 
@@ -688,6 +969,7 @@ void registerStorageStripeLog(StorageFactory & factory)
             args.columns,
             args.constraints,
             args.comment,
+            getMinMaxIndexEnabled(*args.storage_def),
             args.attach,
             args.getContext());
     }, features);
@@ -4,6 +4,7 @@
 #include <shared_mutex>
 
 #include <Core/Defines.h>
+#include <Core/Field.h>
 #include <Storages/IStorage.h>
 #include <Formats/IndexForNativeFormat.h>
 #include <Common/FileChecker.h>
@@ -17,6 +18,40 @@ struct IndexForNativeFormat;
 class IBackup;
 using BackupPtr = std::shared_ptr<const IBackup>;
 
+/// Min-max values of one column of one stripe.
+struct ColumnMinMaxForStripe
+{
+    String name;
+    String type;
+    Field min;
+    Field max;
+};
+
+/// Min-max values of the columns of one stripe. An entry without columns carries
+/// no information, such stripes are never skipped at read.
+struct MinMaxForStripe
+{
+    std::vector<ColumnMinMaxForStripe> columns;
+
+    /// Returns the number of the stripe the entry was written for.
+    size_t read(ReadBuffer & istr);
+    void write(size_t stripe, WriteBuffer & ostr) const;
+};
+
+/** An optional min-max index over the stripes of a StripeLog table.
+  * It is kept in a separate file `minmax.idx`, so that the format of `index.mrk`
+  * (the index of the Native format) stays the same.
+  */
+struct MinMaxIndexForStripeLog
+{
+    std::vector<MinMaxForStripe> stripes;
+
+    /// Reads all the entries, placing each one by its stripe number among `num_stripes` stripes.
+    void read(ReadBuffer & istr, size_t num_stripes);
+
+    void clear() { stripes.clear(); }
+};
+
 /** Implements a table engine that is suitable for small chunks of the log.
   * In doing so, stores all the columns in a single Native file, with a nearby index.
   */
@@ -33,6 +68,7 @@ public:
         const ColumnsDescription & columns_,
         const ConstraintsDescription & constraints_,
         const String & comment,
+        bool minmax_index_enabled_,
         bool attach,
         ContextMutablePtr context_);
 
@@ -90,14 +126,21 @@ private:
     /// Restores the data of this table from backup.
     void restoreDataImpl(const BackupPtr & backup, const String & data_path_in_backup, std::chrono::seconds lock_timeout);
 
+    /// Returns the indices of only those stripes whose min-max values can satisfy the condition of the query.
+    IndexForNativeFormat selectStripesToRead(const SelectQueryInfo & query_info, ContextPtr local_context) const;
+
     const DiskPtr disk;
     String table_path;
 
     String data_file_path;
     String index_file_path;
+    String minmax_file_path;
     FileChecker file_checker;
 
+    const bool minmax_index_enabled;
+
     IndexForNativeFormat indices;
+    MinMaxIndexForStripeLog minmax_indices;
     std::atomic<bool> indices_loaded = false;
     size_t num_indices_saved = 0;
 
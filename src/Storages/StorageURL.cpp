@@ -294,6 +294,13 @@ namespace
 
                 const auto settings = context->getSettings();
                 int zstd_window_log_max = static_cast<int>(settings.zstd_window_log_max);
+
+                /// Read through pooled sessions, so that the keep-alive connections to the endpoint are
+                /// reused between the parallel sources of this query and between queries. The limit is
+                /// raised to the query parallelism, otherwise the sources would block each other on the pool.
+                size_t max_connections_per_endpoint = std::max<size_t>(
+                    {static_cast<size_t>(settings.max_threads), download_threads, DEFAULT_COUNT_OF_HTTP_CONNECTIONS_PER_ENDPOINT});
+
                 try
                 {
                     if (download_threads > 1)
@@ -376,7 +383,8 @@ namespace
                                     &context->getRemoteHostFilter(),
                                     delay_initialization,
                                     /* use_external_buffer */ false,
-                                    /* skip_url_not_found_error */ skip_url_not_found_error);
+                                    /* skip_url_not_found_error */ skip_url_not_found_error,
+                                    max_connections_per_endpoint);
 
                                 return wrapReadBufferWithCompressionMethod(
                                     std::make_unique<ParallelReadBuffer>(
@@ -400,7 +408,7 @@ namespace
                     LOG_TRACE(&Poco::Logger::get("StorageURLSource"), "Using single-threaded read buffer");
 
                     return wrapReadBufferWithCompressionMethod(
-                        std::make_unique<ReadWriteBufferFromHTTP>(
+                        std::make_unique<PooledReadWriteBufferFromHTTP>(
                             request_uri,
                             http_method,
                             callback,
@@ -414,7 +422,8 @@ namespace
                             &context->getRemoteHostFilter(),
                             delay_initialization,
                             /* use_external_buffer */ false,
-                            /* skip_url_not_found_error */ skip_url_not_found_error),
+                            /* skip_url_not_found_error */ skip_url_not_found_error,
+                            max_connections_per_endpoint),
                             compression_method,
                         zstd_window_log_max);
                 }
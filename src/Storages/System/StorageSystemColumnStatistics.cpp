@@ -0,0 +1,126 @@
+#include <Storages/System/StorageSystemColumnStatistics.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <DataTypes/DataTypeArray.h>
+#include <Storages/MergeTree/MergeTreeData.h>
+#include <Storages/VirtualColumnUtils.h>
+#include <Access/ContextAccess.h>
+#include <Databases/IDatabase.h>
+#include <Interpreters/Context.h>
+
+
+namespace DB
+{
+
+
+NamesAndTypesList StorageSystemColumnStatistics::getNamesAndTypes()
+{
+    return {
+        { "database",       std::make_shared<DataTypeString>() },
+        { "table",          std::make_shared<DataTypeString>() },
+        { "column",         std::make_shared<DataTypeString>() },
+        { "distinct_count", std::make_shared<DataTypeUInt64>() },
+        { "null_count",     std::make_shared<DataTypeUInt64>() },
+        /// Equi-depth histogram: value bounds at levels 0, 0.1, ... 1 (empty for non-numeric columns).
+        { "histogram",      std::make_shared<DataTypeArray>(std::make_shared<DataTypeFloat64>()) },
+    };
+}
+
+
+void StorageSystemColumnStatistics::fillData(MutableColumns & res_columns, ContextPtr context, const SelectQueryInfo & query_info) const
+{
+    const auto access = context->getAccess();
+    const bool check_access_for_databases = !access->isGranted(AccessType::SHOW_TABLES);
+
+    /// Collect a set of *MergeTree tables.
+    std::map<String, std::map<String, StoragePtr>> merge_tree_tables;
+    for (const auto & db : DatabaseCatalog::instance().getDatabases())
+    {
+        /// Check if database can contain MergeTree tables
+        if (!db.second->canContainMergeTreeTables())
+            continue;
+
+        const bool check_access_for_tables = check_access_for_databases && !access->isGranted(AccessType::SHOW_TABLES, db.first);
+
+        for (auto iterator = db.second->getTablesIterator(context); iterator->isValid(); iterator->next())
+        {
+            const auto & table = iterator->table();
+            if (!table)
+                continue;
+
+            if (!dynamic_cast<const MergeTreeData *>(table.get()))
+                continue;
+
+            if (check_access_for_tables && !access->isGranted(AccessType::SHOW_TABLES, db.first, iterator->name()))
+                continue;
+
+            merge_tree_tables[db.first][iterator->name()] = table;
+        }
+    }
+
+    MutableColumnPtr col_database_mut = ColumnString::create();
+    MutableColumnPtr col_table_mut = ColumnString::create();
+
+    for (auto & db : merge_tree_tables)
+    {
+        for (auto & table : db.second)
+        {
+            col_database_mut->insert(db.first);
+            col_table_mut->insert(table.first);
+        }
+    }
+
+    ColumnPtr col_database = std::move(col_database_mut);
+    ColumnPtr col_table = std::move(col_table_mut);
+
+    /// Determine what tables are needed by the conditions in the query.
+    {
+        Block filtered_block
+        {
+            { col_database, std::make_shared<DataTypeString>(), "database" },
+            { col_table, std::make_shared<DataTypeString>(), "table" },
+        };
+
+        VirtualColumnUtils::filterBlockWithQuery(query_info.query, filtered_block, context);
+
+        if (!filtered_block.rows())
+            return;
+
+        col_database = filtered_block.getByName("database").column;
+        col_table = filtered_block.getByName("table").column;
+    }
+
+    for (size_t i_storage = 0; i_storage < col_database->size(); ++i_storage)
+    {
+        auto database = (*col_database)[i_storage].safeGet<String>();
+        auto table = (*col_table)[i_storage].safeGet<String>();
+
+        MergeTreeColumnStatistics statistics;
+        {
+            const IStorage * storage = merge_tree_tables[database][table].get();
+            if (const auto * merge_tree = dynamic_cast<const MergeTreeData *>(storage))
+                statistics = merge_tree->getColumnStatistics();
+        }
+
+        for (auto & [column_name, stat] : statistics.columns)
+        {
+            Array histogram;
+            if (stat.has_histogram)
+            {
+                histogram.reserve(11);
+                for (size_t i = 0; i <= 10; ++i)
+                    histogram.emplace_back(Float64(stat.histogram.getFloat(0.1 * i)));
+            }
+
+            size_t col_num = 0;
+            res_columns[col_num++]->insert(database);
+            res_columns[col_num++]->insert(table);
+            res_columns[col_num++]->insert(column_name);
+            res_columns[col_num++]->insert(stat.distinct_count.size());
+            res_columns[col_num++]->insert(stat.null_count);
+            res_columns[col_num++]->insert(histogram);
+        }
+    }
+}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Storages/System/IStorageSystemOneBlock.h>
+
+
+namespace DB
+{
+
+class Context;
+
+
+/// Implements the `column_statistics` system table, which shows the per-column statistics
+/// (distinct-count estimate, null count and an equi-depth histogram) that MergeTree tables
+/// with enable_column_statistics maintain in their parts, aggregated per table.
+class StorageSystemColumnStatistics final : public IStorageSystemOneBlock<StorageSystemColumnStatistics>
+{
+public:
+    String getName() const override { return "SystemColumnStatistics"; }
+
+    static NamesAndTypesList getNamesAndTypes();
+
+protected:
+    using IStorageSystemOneBlock::IStorageSystemOneBlock;
+
+    void fillData(MutableColumns & res_columns, ContextPtr context, const SelectQueryInfo & query_info) const override;
+};
+
+}
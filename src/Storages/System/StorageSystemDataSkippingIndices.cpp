@@ -31,7 +31,9 @@ StorageSystemDataSkippingIndices::StorageSystemDataSkippingIndices(const Storage
             { "granularity", std::make_shared<DataTypeUInt64>() },
             { "data_compressed_bytes", std::make_shared<DataTypeUInt64>() },
             { "data_uncompressed_bytes", std::make_shared<DataTypeUInt64>() },
-            { "marks", std::make_shared<DataTypeUInt64>()}
+            { "marks", std::make_shared<DataTypeUInt64>()},
+            { "granules_tested", std::make_shared<DataTypeUInt64>()},
+            { "granules_dropped", std::make_shared<DataTypeUInt64>()}
         }));
     setInMemoryMetadata(storage_metadata);
 }
@@ -105,6 +107,7 @@ protected:
                 const auto indices = metadata_snapshot->getSecondaryIndices();
 
                 auto secondary_index_sizes = table->getSecondaryIndexSizes();
+                auto secondary_index_usage = table->getSecondaryIndexUsage();
                 for (const auto & index : indices)
                 {
                     ++rows_count;
@@ -158,6 +161,16 @@ protected:
                     /// 'marks' column
                     if (column_mask[src_index++])
                         res_columns[res_index++]->insert(secondary_index_size.marks);
+
+                    auto & index_usage = secondary_index_usage[index.name];
+
+                    /// 'granules_tested' column
+                    if (column_mask[src_index++])
+                        res_columns[res_index++]->insert(index_usage.granules_tested);
+
+                    /// 'granules_dropped' column
+                    if (column_mask[src_index++])
+                        res_columns[res_index++]->insert(index_usage.granules_dropped);
                 }
             }
         }
@@ -20,7 +20,7 @@ void StorageSystemEvents::fillData(MutableColumns & res_columns, ContextPtr cont
 {
     for (size_t i = 0, end = ProfileEvents::end(); i < end; ++i)
     {
-        UInt64 value = ProfileEvents::global_counters[i];
+        UInt64 value = ProfileEvents::getGlobalCounter(ProfileEvents::Event(i));
 
         if (0 != value || context->getSettingsRef().system_events_show_zero_values)
         {
@@ -60,6 +60,8 @@ NamesAndTypesList StorageSystemProcesses::getNamesAndTypes()
         {"written_bytes", std::make_shared<DataTypeUInt64>()},
         {"memory_usage", std::make_shared<DataTypeInt64>()},
         {"peak_memory_usage", std::make_shared<DataTypeInt64>()},
+        {"temporary_data_compressed_bytes", std::make_shared<DataTypeUInt64>()},
+        {"temporary_data_uncompressed_bytes", std::make_shared<DataTypeUInt64>()},
         {"query", std::make_shared<DataTypeString>()},
 
         {"thread_ids", std::make_shared<DataTypeArray>(std::make_shared<DataTypeUInt64>())},
@@ -129,6 +131,8 @@ void StorageSystemProcesses::fillData(MutableColumns & res_columns, ContextPtr c
         res_columns[i++]->insert(process.written_bytes);
         res_columns[i++]->insert(process.memory_usage);
         res_columns[i++]->insert(process.peak_memory_usage);
+        res_columns[i++]->insert(process.temporary_data_compressed_bytes);
+        res_columns[i++]->insert(process.temporary_data_uncompressed_bytes);
         res_columns[i++]->insert(process.query);
 
         {
@@ -46,6 +46,12 @@ namespace
     std::atomic<pid_t> expected_pid;
     const int sig = SIGRTMIN;
 
+    std::atomic<bool> signal_handler_installed = false;
+
+    /// Only one sampling pass (a read from the table or a sampleThreads() call)
+    /// may be in progress at any moment of time.
+    std::mutex sampling_mutex;
+
     std::atomic<int> sequence_num = 0;    /// For messages sent via pipe.
     std::atomic<int> data_ready_num = 0;
     std::atomic<bool> signal_latch = false;   /// Only need for thread sanitizer.
@@ -248,6 +254,60 @@ StorageSystemStackTrace::StorageSystemStackTrace(const StorageID & table_id_)
 
     if (sigaction(sig, &sa, nullptr))
         throwFromErrno("Cannot set signal handler.", ErrorCodes::CANNOT_SET_SIGNAL_HANDLER);
+
+    signal_handler_installed = true;
+}
+
+
+std::unordered_map<UInt64, std::vector<UInt64>> StorageSystemStackTrace::sampleThreads(const std::vector<UInt64> & thread_ids, const String & expected_query_id)
+{
+    /// Without the handler, SIGRTMIN would terminate the server by its default action.
+    if (!signal_handler_installed)
+        throw Exception(ErrorCodes::LOGICAL_ERROR,
+            "Cannot sample stack traces of threads: the signal handler is not installed because the system.stack_trace table was not created");
+
+    std::lock_guard lock(sampling_mutex);
+
+    std::unordered_map<UInt64, std::vector<UInt64>> res;
+
+    for (UInt64 tid : thread_ids)
+    {
+        sigval sig_value{};
+        sig_value.sival_int = sequence_num.load(std::memory_order_acquire);
+
+        if (0 != ::sigqueue(static_cast<int>(tid), sig, sig_value))
+        {
+            /// The thread may has been already finished.
+            if (ESRCH == errno)
+                continue;
+
+            throwFromErrno("Cannot send signal with sigqueue", ErrorCodes::CANNOT_SIGQUEUE);
+        }
+
+        if (wait(100) && sig_value.sival_int == data_ready_num.load(std::memory_order_acquire))
+        {
+            /// The thread id could have been reused by a thread of another query.
+            if (!expected_query_id.empty() && std::string_view(query_id_data, query_id_size) != expected_query_id)
+            {
+                ++sequence_num;
+                continue;
+            }
+
+            size_t stack_trace_size = stack_trace.getSize();
+            size_t stack_trace_offset = stack_trace.getOffset();
+
+            std::vector<UInt64> frames;
+            frames.reserve(stack_trace_size - stack_trace_offset);
+            for (size_t i = stack_trace_offset; i < stack_trace_size; ++i)
+                frames.emplace_back(reinterpret_cast<intptr_t>(stack_trace.getFramePointers()[i]));
+
+            res.emplace(tid, std::move(frames));
+        }
+
+        ++sequence_num;
+    }
+
+    return res;
 }
 
 
@@ -263,7 +323,7 @@ Pipe StorageSystemStackTrace::read(
     storage_snapshot->check(column_names);
 
     /// It shouldn't be possible to do concurrent reads from this table.
-    std::lock_guard lock(mutex);
+    std::lock_guard lock(sampling_mutex);
 
     /// Create a mask of what columns are needed in the result.
 
@@ -2,7 +2,8 @@
 
 #ifdef OS_LINUX /// Because of 'sigqueue' functions and RT signals.
 
-#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <Storages/IStorage.h>
 
 namespace Poco
@@ -37,8 +38,16 @@ public:
 
     bool isSystemStorage() const override { return true; }
 
+    /// Collect a current stack trace of each of the specified threads via the same
+    /// signal-based mechanism that serves reads from this table. Threads that have
+    /// already finished or did not respond within a timeout are omitted from the result.
+    /// If `expected_query_id` is non-empty, threads that are currently executing a different
+    /// query are omitted as well (protects from sampling a reused thread id).
+    /// May be called only after the table was created, because its constructor installs
+    /// the signal handler. Used by the /flamegraph HTTP endpoint.
+    static std::unordered_map<UInt64, std::vector<UInt64>> sampleThreads(const std::vector<UInt64> & thread_ids, const String & expected_query_id = {});
+
 protected:
-    mutable std::mutex mutex;
     Poco::Logger * log;
 };
 
@@ -344,6 +344,38 @@ def test_incremental_backup_for_log_family():
     assert instance.query("SELECT count(), sum(x) FROM test.table2") == "102\t5081\n"
 
 
+def test_content_addressed_store():
+    backup_name = new_backup_name()
+    create_and_fill_table()
+
+    assert instance.query("SELECT count(), sum(x) FROM test.table") == "100\t4950\n"
+    instance.query(
+        f"BACKUP TABLE test.table TO {backup_name} SETTINGS use_content_addressed_store = true"
+    )
+
+    # All data files must be stored as checksum-named blobs under ".store".
+    assert sorted(os.listdir(get_path_to_backup(backup_name))) == [".backup", ".store"]
+    store_path = os.path.join(get_path_to_backup(backup_name), ".store")
+    assert len(os.listdir(store_path)) > 0
+
+    instance.query("DROP TABLE test.table")
+    instance.query(f"RESTORE TABLE test.table FROM {backup_name}")
+    assert instance.query("SELECT count(), sum(x) FROM test.table") == "100\t4950\n"
+
+    # An incremental backup on top of a content-addressed one must reuse its blobs.
+    instance.query("INSERT INTO test.table VALUES (65, 'a'), (66, 'b')")
+
+    incremental_backup_name = new_backup_name()
+    instance.query(
+        f"BACKUP TABLE test.table TO {incremental_backup_name} SETTINGS base_backup = {backup_name}, use_content_addressed_store = true"
+    )
+
+    instance.query(
+        f"RESTORE TABLE test.table AS test.table2 FROM {incremental_backup_name}"
+    )
+    assert instance.query("SELECT count(), sum(x) FROM test.table2") == "102\t5081\n"
+
+
 def test_backup_not_found_or_already_exists():
     backup_name = new_backup_name()
 
@@ -1527,6 +1527,52 @@ def test_kafka_materialized_view(kafka_cluster):
     kafka_check_result(result, True)
 
 
+def test_kafka_parallel_parsing(kafka_cluster):
+    # Check that a block parsed by several threads (kafka_num_parsing_threads)
+    # is the same as the one parsed on the polling thread.
+    instance.query(
+        """
+        DROP TABLE IF EXISTS test.view;
+        DROP TABLE IF EXISTS test.consumer;
+        CREATE TABLE test.kafka (key UInt64, value UInt64)
+            ENGINE = Kafka
+            SETTINGS kafka_broker_list = 'kafka1:19092',
+                     kafka_topic_list = 'parallel_parsing',
+                     kafka_group_name = 'parallel_parsing',
+                     kafka_format = 'JSONEachRow',
+                     kafka_num_parsing_threads = 4,
+                     kafka_flush_interval_ms = 1000;
+        CREATE TABLE test.view (key UInt64, value UInt64, offset UInt64)
+            ENGINE = MergeTree()
+            ORDER BY key;
+        CREATE MATERIALIZED VIEW test.consumer TO test.view AS
+            SELECT key, value, _offset AS offset FROM test.kafka;
+    """
+    )
+
+    count = 3000
+    messages = []
+    for i in range(count):
+        messages.append(json.dumps({"key": i, "value": i * 2}))
+    kafka_produce(kafka_cluster, "parallel_parsing", messages)
+
+    while int(instance.query("SELECT count() FROM test.view")) < count:
+        time.sleep(1)
+
+    # The virtual columns must stay aligned with the rows of the messages they came from.
+    result = instance.query(
+        "SELECT count(), sum(value) = 2 * sum(key), countIf(key != offset) FROM test.view"
+    )
+    assert TSV(result) == TSV("{}\t1\t0".format(count))
+
+    instance.query(
+        """
+        DROP TABLE test.consumer;
+        DROP TABLE test.view;
+    """
+    )
+
+
 def test_kafka_recreate_kafka_table(kafka_cluster):
     """
     Checks that materialized view work properly after dropping and recreating the Kafka table.
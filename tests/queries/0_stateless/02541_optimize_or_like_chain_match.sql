@@ -0,0 +1,10 @@
+-- Chains mixing LIKE/ILIKE with match over the same column are combined into a single multiMatchAny.
+
+EXPLAIN SYNTAX SELECT materialize('Привет, World') AS s WHERE (s LIKE 'hell%') OR (s ILIKE '%привет%') OR match(s, 'Wor.d$') SETTINGS optimize_or_like_chain = 1;
+EXPLAIN SYNTAX SELECT materialize('Привет, World') AS s WHERE (s LIKE 'hell%') OR (s ILIKE '%привет%') OR match(s, 'Wor.d$') SETTINGS optimize_or_like_chain = 0;
+
+SELECT materialize('Привет, optimized World') AS s WHERE (s LIKE 'hell%') OR match(s, 'Wor.d$') SETTINGS optimize_or_like_chain = 1;
+SELECT materialize('Привет, optimized World') AS s WHERE (s LIKE 'hell%') OR match(s, 'Wor.d$') SETTINGS optimize_or_like_chain = 1, allow_experimental_analyzer = 1;
+
+SELECT materialize('Привет, World') AS s WHERE (s LIKE 'hell%') OR match(s, 'foo') SETTINGS optimize_or_like_chain = 1;
+SELECT materialize('Привет, World') AS s WHERE (s LIKE 'hell%') OR match(s, 'foo') SETTINGS optimize_or_like_chain = 1, allow_experimental_analyzer = 1;
@@ -0,0 +1,15 @@
+DROP TABLE IF EXISTS t_func_to_subcolumns_map;
+
+SET optimize_functions_to_subcolumns = 1;
+
+CREATE TABLE t_func_to_subcolumns_map (id UInt64, m Map(String, UInt64))
+ENGINE = MergeTree ORDER BY tuple();
+
+INSERT INTO t_func_to_subcolumns_map VALUES (1, map('foo', 1, 'bar', 2)) (2, map());
+
+SELECT length(m), empty(m), notEmpty(m) FROM t_func_to_subcolumns_map;
+EXPLAIN SYNTAX SELECT length(m), empty(m), notEmpty(m) FROM t_func_to_subcolumns_map;
+
+SELECT length(m), empty(m), notEmpty(m) FROM t_func_to_subcolumns_map SETTINGS allow_experimental_analyzer = 1;
+
+DROP TABLE t_func_to_subcolumns_map;
@@ -0,0 +1,39 @@
+SET parallel_window_functions = 1;
+SET max_threads = 4;
+
+-- The result must not depend on how partitions are scattered across threads.
+
+SELECT
+    number % 7 AS part,
+    sum(number) OVER (PARTITION BY number % 7 ORDER BY number ROWS BETWEEN 1 PRECEDING AND CURRENT ROW) AS s,
+    count() OVER (PARTITION BY number % 7) AS c
+FROM numbers(1000)
+ORDER BY part, s
+LIMIT 10;
+
+-- Several windows: the second window reuses the sorting of the first one,
+-- so the first window must keep a single sorted stream and only the last
+-- window is allowed to fan out.
+
+SELECT
+    part,
+    rn,
+    c
+FROM
+(
+    SELECT
+        number % 3 AS part,
+        row_number() OVER (PARTITION BY number % 3 ORDER BY number) AS rn,
+        count() OVER (PARTITION BY number % 3) AS c
+    FROM numbers(100)
+)
+ORDER BY part, rn
+LIMIT 10;
+
+-- Sanity check: the total over all partitions does not change.
+
+SELECT sum(c) FROM
+(
+    SELECT count() OVER (PARTITION BY number % 16) AS c
+    FROM numbers(10000)
+);
@@ -0,0 +1,24 @@
+SET enable_multiple_prewhere_read_steps = 1;
+
+DROP TABLE IF EXISTS test_02544;
+
+CREATE TABLE test_02544 (id1 UInt64, id2 UInt64, value1 UInt64, value2 UInt64) ENGINE=MergeTree ORDER BY id1 SETTINGS min_bytes_for_wide_part = 0;
+
+INSERT INTO test_02544 SELECT number, number % 10, number * 2, number * 3 FROM numbers(100000);
+
+-- Conditions on different columns are executed in separate steps.
+SELECT count() FROM test_02544 PREWHERE id2 = 3 AND value1 % 100 = 6 AND value2 > 1000;
+
+-- The result must be the same as with a single step.
+SELECT count() FROM test_02544 PREWHERE id2 = 3 AND value1 % 100 = 6 AND value2 > 1000 SETTINGS enable_multiple_prewhere_read_steps = 0;
+
+-- The prewhere column is kept in the result when it is used in the projection.
+SELECT id1, (id2 = 3 AND value1 % 100 = 6) AS cond FROM test_02544 PREWHERE cond WHERE id1 < 1000 ORDER BY id1;
+
+-- Rows and columns read are consistent when combined with WHERE and row granularity.
+SELECT sum(value2) FROM test_02544 PREWHERE id2 = 7 AND value1 % 10 = 4 WHERE value2 % 3 = 0;
+
+-- A condition with a type that cannot serve as a filter on its own falls back to a single step.
+SELECT count() FROM test_02544 PREWHERE id2 AND value1 % 100 = 6;
+
+DROP TABLE test_02544;
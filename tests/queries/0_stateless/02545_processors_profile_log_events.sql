@@ -0,0 +1,16 @@
+SELECT sleep(1) FORMAT Null SETTINGS log_processors_profiles = 1, log_queries = 1, log_queries_min_type = 'QUERY_FINISH';
+SYSTEM FLUSH LOGS;
+
+WITH
+    (
+        SELECT query_id
+        FROM system.query_log
+        WHERE current_database = currentDatabase() AND Settings['log_processors_profiles'] = '1'
+    ) AS query_id_
+SELECT
+    name,
+    ProfileEvents['SleepFunctionCalls'] AS sleep_calls,
+    ProfileEvents['SleepFunctionMicroseconds'] >= 1e6 AS slept_enough
+FROM system.processors_profile_log
+WHERE query_id = query_id_ AND name = 'ExpressionTransform'
+ORDER BY name;
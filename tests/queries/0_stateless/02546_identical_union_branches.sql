@@ -0,0 +1,26 @@
+SET optimize_identical_union_branches = 1;
+
+DROP TABLE IF EXISTS test_02546;
+
+CREATE TABLE test_02546 (id UInt64, value UInt64) ENGINE = MergeTree ORDER BY id;
+INSERT INTO test_02546 SELECT number, number * 2 FROM numbers(1000);
+
+-- Identical branches are executed once and the result is copied.
+SELECT count(), sum(s) FROM (SELECT sum(value) AS s FROM test_02546 GROUP BY id % 7 UNION ALL SELECT sum(value) AS s FROM test_02546 GROUP BY id % 7);
+
+-- Mix of identical and different branches.
+SELECT count() FROM (SELECT id FROM test_02546 UNION ALL SELECT id FROM test_02546 UNION ALL SELECT value FROM test_02546);
+
+-- UNION DISTINCT still deduplicates rows.
+SELECT count() FROM (SELECT id FROM test_02546 UNION DISTINCT SELECT id FROM test_02546);
+
+-- Branches with non-deterministic functions are executed separately.
+SELECT count() FROM (SELECT rand() UNION ALL SELECT rand());
+
+SELECT count() FROM (EXPLAIN SELECT id FROM test_02546 UNION ALL SELECT id FROM test_02546) WHERE explain ILIKE '%Duplicating%';
+
+SET optimize_identical_union_branches = 0;
+
+SELECT count() FROM (EXPLAIN SELECT id FROM test_02546 UNION ALL SELECT id FROM test_02546) WHERE explain ILIKE '%Duplicating%';
+
+DROP TABLE test_02546;
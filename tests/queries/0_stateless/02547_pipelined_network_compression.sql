@@ -0,0 +1,17 @@
+SET network_compression_pipelined = 1;
+
+DROP TABLE IF EXISTS test_02547;
+
+CREATE TABLE test_02547 (n UInt64, s String) ENGINE = MergeTree ORDER BY n;
+
+INSERT INTO FUNCTION remote('127.0.0.2', currentDatabase(), test_02547) SELECT number, toString(number) FROM numbers(100000);
+
+SELECT count(), sum(n) FROM test_02547;
+
+-- ZSTD over the wire goes through the same path.
+SET network_compression_method = 'ZSTD';
+INSERT INTO FUNCTION remote('127.0.0.2', currentDatabase(), test_02547) SELECT number, toString(number) FROM numbers(1000);
+
+SELECT count() FROM test_02547;
+
+DROP TABLE test_02547;
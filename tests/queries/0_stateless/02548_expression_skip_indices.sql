@@ -0,0 +1,36 @@
+-- Skip indexes over arbitrary deterministic expressions: the index statistics are
+-- computed per granule on insert/merge, and KeyCondition uses them when the query
+-- contains a syntactically equal expression.
+
+DROP TABLE IF EXISTS test_02548;
+
+CREATE TABLE test_02548
+(
+    seq UInt64,
+    user_id UInt64,
+    ts DateTime('UTC'),
+    INDEX idx_shard user_id % 100 TYPE minmax GRANULARITY 1,
+    INDEX idx_hour toStartOfHour(ts) TYPE minmax GRANULARITY 1,
+    INDEX idx_hash cityHash64(user_id) % 100 TYPE set(100) GRANULARITY 1
+)
+ENGINE = MergeTree ORDER BY seq
+SETTINGS index_granularity = 1024;
+
+-- user_id is constant within each granule, so the expression indexes can prune.
+INSERT INTO test_02548 SELECT number, intDiv(number, 1024), toDateTime('2023-01-01 00:00:00', 'UTC') + number FROM numbers(102400);
+
+SELECT count() FROM test_02548 WHERE user_id % 100 = 42;
+SELECT count() FROM test_02548 WHERE toStartOfHour(ts) = toDateTime('2023-01-01 05:00:00', 'UTC');
+SELECT count() FROM test_02548 WHERE cityHash64(user_id) % 100 >= 0;
+
+SYSTEM FLUSH LOGS;
+
+-- The modulo lookup must touch only the granules around the matching one, not the whole table.
+SELECT read_rows <= 3072 FROM system.query_log
+WHERE current_database = currentDatabase() AND type = 'QueryFinish' AND query LIKE 'SELECT count() FROM test_02548 WHERE user_id \\% 100 = 42%';
+
+-- The hour lookup reads about an hour of data, not the whole table.
+SELECT read_rows <= 8192 FROM system.query_log
+WHERE current_database = currentDatabase() AND type = 'QueryFinish' AND query LIKE 'SELECT count() FROM test_02548 WHERE toStartOfHour%';
+
+DROP TABLE test_02548;
@@ -0,0 +1,11 @@
+SET parallel_distinct = 1;
+SET max_threads = 4;
+
+SELECT count() FROM (SELECT DISTINCT number % 1000 FROM numbers_mt(1000000));
+
+SELECT DISTINCT number % 10 AS n FROM numbers_mt(100000) ORDER BY n;
+
+SELECT count() FROM (SELECT DISTINCT number % 100, number % 17 FROM numbers_mt(1000000));
+
+-- LIMIT uses a distinct limit hint, which disables the parallel path; the result must not change.
+SELECT count() FROM (SELECT DISTINCT number % 1000 FROM numbers_mt(1000000) LIMIT 100);
@@ -0,0 +1,26 @@
+-- Tags: no-random-settings, no-s3-storage
+
+DROP TABLE IF EXISTS t_marks_mmap;
+
+CREATE TABLE t_marks_mmap (a UInt64, b UInt64)
+ENGINE = MergeTree ORDER BY a
+SETTINGS index_granularity = 1024, compress_marks = 0;
+
+INSERT INTO t_marks_mmap SELECT number, number * 2 FROM numbers(100000);
+
+SET load_marks_with_mmap = 1;
+
+SELECT count(), sum(b) FROM t_marks_mmap WHERE a >= 50000;
+
+SYSTEM FLUSH LOGS;
+
+-- The first read of the part must have mapped its mark files.
+SELECT ProfileEvents['CreatedReadBufferMMap'] > 0
+FROM system.query_log
+WHERE current_database = currentDatabase()
+    AND type = 'QueryFinish'
+    AND query LIKE 'SELECT count(), sum(b) FROM t_marks_mmap%'
+ORDER BY event_time_microseconds DESC
+LIMIT 1;
+
+DROP TABLE t_marks_mmap;
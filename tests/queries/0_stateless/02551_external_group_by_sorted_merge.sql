@@ -0,0 +1,24 @@
+-- Tags: no-random-settings
+
+SET max_bytes_before_external_group_by = 1;
+SET group_by_two_level_threshold = 1000;
+SET group_by_two_level_threshold_bytes = 1;
+SET external_group_by_sorted_merge = 1;
+
+SELECT count(), sum(cnt), sum(s) FROM (SELECT number % 100000 AS k, count() AS cnt, sum(number) AS s FROM numbers_mt(1000000) GROUP BY k);
+
+SELECT k, cnt, s FROM (SELECT number % 1000 AS k, count() AS cnt, sum(number) AS s FROM numbers_mt(100000) GROUP BY k) ORDER BY k LIMIT 3;
+
+SELECT count(), sum(u) FROM (SELECT toString(number % 50000) AS k, uniqExact(number) AS u FROM numbers_mt(500000) GROUP BY k);
+
+SYSTEM FLUSH LOGS;
+
+-- The queries above must have gone through the external aggregation path.
+SELECT ProfileEvents['ExternalAggregationWritePart'] > 0, ProfileEvents['ExternalAggregationMerge'] > 0
+FROM system.query_log
+WHERE current_database = currentDatabase()
+    AND type = 'QueryFinish'
+    AND query LIKE '%uniqExact(number)%'
+    AND query NOT LIKE '%query_log%'
+ORDER BY event_time_microseconds DESC
+LIMIT 1;
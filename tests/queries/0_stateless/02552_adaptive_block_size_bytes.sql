@@ -0,0 +1,21 @@
+-- Tags: no-random-settings
+
+DROP TABLE IF EXISTS t_wide_rows;
+DROP TABLE IF EXISTS t_narrow_rows;
+
+CREATE TABLE t_wide_rows (n UInt64, payload FixedString(4096)) ENGINE = MergeTree ORDER BY n;
+INSERT INTO t_wide_rows SELECT number, toFixedString('', 4096) FROM numbers(10000);
+
+-- Wide rows: 1 MiB budget / ~4104 bytes per row allows at most 255 rows per block.
+SELECT max(blockSize()) <= 256, max(length(payload)) = 4096 FROM t_wide_rows
+SETTINGS max_block_size_bytes = 1048576;
+
+CREATE TABLE t_narrow_rows (n UInt8) ENGINE = MergeTree ORDER BY tuple();
+INSERT INTO t_narrow_rows SELECT number FROM numbers(300000);
+
+-- Narrow rows: blocks may grow beyond the default max_block_size.
+SELECT max(blockSize()) > 65536 FROM t_narrow_rows
+SETTINGS max_block_size_bytes = 4194304, preferred_block_size_bytes = 0, max_threads = 1;
+
+DROP TABLE t_wide_rows;
+DROP TABLE t_narrow_rows;
@@ -0,0 +1,52 @@
+-- Tags: no-random-settings
+
+DROP TABLE IF EXISTS t_join_proj;
+DROP TABLE IF EXISTS t_join_dim;
+
+CREATE TABLE t_join_proj
+(
+    id UInt64,
+    key UInt64,
+    value UInt64,
+    PROJECTION p_by_key (SELECT key, value ORDER BY key)
+)
+ENGINE = MergeTree ORDER BY id;
+
+INSERT INTO t_join_proj SELECT number, number % 100, number FROM numbers(10000);
+
+CREATE TABLE t_join_dim (key UInt64, name String) ENGINE = MergeTree ORDER BY key;
+INSERT INTO t_join_dim SELECT number, toString(number) FROM numbers(100);
+
+SET join_algorithm = 'full_sorting_merge';
+SET optimize_use_projections_for_sorting = 1;
+
+SELECT sum(l.value), count()
+FROM (SELECT key, value FROM t_join_proj ORDER BY key) AS l
+INNER JOIN t_join_dim AS r ON l.key = r.key;
+
+-- Both sides of the merge join are read in order (the left one through the projection),
+-- so the pipeline must not contain a full sort.
+SELECT count()
+FROM
+(
+    EXPLAIN PIPELINE
+    SELECT sum(l.value), count()
+    FROM (SELECT key, value FROM t_join_proj ORDER BY key) AS l
+    INNER JOIN t_join_dim AS r ON l.key = r.key
+)
+WHERE explain LIKE '%MergeSortingTransform%';
+
+SYSTEM FLUSH LOGS;
+
+SELECT projections[1] LIKE '%.p_by_key'
+FROM system.query_log
+WHERE current_database = currentDatabase()
+    AND type = 'QueryFinish'
+    AND query LIKE '%t_join_dim%'
+    AND query NOT LIKE '%EXPLAIN%'
+    AND query NOT LIKE '%query_log%'
+ORDER BY event_time_microseconds DESC
+LIMIT 1;
+
+DROP TABLE t_join_proj;
+DROP TABLE t_join_dim;
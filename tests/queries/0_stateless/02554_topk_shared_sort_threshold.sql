@@ -0,0 +1,14 @@
+-- Sharing the LIMIT-th row threshold between sorting streams must not change results.
+-- The threshold optimization is only active for LIMIT >= 1500.
+
+DROP TABLE IF EXISTS t_topk_shared;
+
+CREATE TABLE t_topk_shared (x UInt64, y UInt64) ENGINE = MergeTree ORDER BY tuple();
+INSERT INTO t_topk_shared SELECT (number * 2654435761) % 4294967296, number FROM numbers(1000000);
+
+SELECT sum(x), sum(y), count() FROM (SELECT x, y FROM t_topk_shared ORDER BY x LIMIT 2000) SETTINGS max_threads = 8;
+SELECT sum(x), sum(y), count() FROM (SELECT x, y FROM t_topk_shared ORDER BY x LIMIT 2000) SETTINGS max_threads = 1;
+SELECT sum(x), sum(y), count() FROM (SELECT x, y FROM t_topk_shared ORDER BY x DESC, y LIMIT 2000) SETTINGS max_threads = 8;
+SELECT sum(x), sum(y), count() FROM (SELECT x, y FROM t_topk_shared ORDER BY x DESC, y LIMIT 2000) SETTINGS max_threads = 1;
+
+DROP TABLE t_topk_shared;
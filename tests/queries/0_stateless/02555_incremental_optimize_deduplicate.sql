@@ -0,0 +1,31 @@
+-- Tags: no-replicated-database, no-random-merge-tree-settings
+
+DROP TABLE IF EXISTS t_incremental_dedup;
+
+CREATE TABLE t_incremental_dedup (a UInt64, b UInt64) ENGINE = MergeTree ORDER BY a
+SETTINGS max_bytes_to_merge_at_max_space_in_pool = 1; -- no background merges
+
+INSERT INTO t_incremental_dedup VALUES (1, 1), (2, 2);
+INSERT INTO t_incremental_dedup VALUES (1, 1), (2, 3);
+
+OPTIMIZE TABLE t_incremental_dedup FINAL DEDUPLICATE;
+SELECT count() FROM t_incremental_dedup;
+SELECT level FROM system.parts WHERE database = currentDatabase() AND table = 't_incremental_dedup' AND active;
+
+-- The part is already deduplicated by all columns: the repeated OPTIMIZE must not rewrite it.
+OPTIMIZE TABLE t_incremental_dedup FINAL DEDUPLICATE;
+SELECT level FROM system.parts WHERE database = currentDatabase() AND table = 't_incremental_dedup' AND active;
+
+-- Deduplication by fewer columns is coarser than the previous one, so the part must be rewritten.
+OPTIMIZE TABLE t_incremental_dedup FINAL DEDUPLICATE BY a;
+SELECT count() FROM t_incremental_dedup;
+SELECT level FROM system.parts WHERE database = currentDatabase() AND table = 't_incremental_dedup' AND active;
+
+-- Previous deduplication by `a` subsumes deduplication by `a, b` and by all columns: both are skipped.
+OPTIMIZE TABLE t_incremental_dedup FINAL DEDUPLICATE BY a, b;
+SELECT level FROM system.parts WHERE database = currentDatabase() AND table = 't_incremental_dedup' AND active;
+
+OPTIMIZE TABLE t_incremental_dedup FINAL DEDUPLICATE;
+SELECT level FROM system.parts WHERE database = currentDatabase() AND table = 't_incremental_dedup' AND active;
+
+DROP TABLE t_incremental_dedup;
@@ -0,0 +1,18 @@
+-- Tags: no-tsan, no-asan, no-ubsan, no-msan, no-debug, no-parallel, no-fasttest, no-random-settings
+
+SET memory_profiler_sample_probability = 1;
+SET max_untracked_memory = 0;
+SET memory_profiler_sample_min_allocation_size = 4096;
+SET memory_profiler_sample_max_allocation_size = 16384;
+SET log_queries = 1;
+
+SELECT ignore(groupArray(number), 'test memory sample size bounds') FROM numbers(1048576) SETTINGS log_comment = '02556_memory_sample_allocation_size_bounds';
+
+SET memory_profiler_sample_probability = 0;
+SYSTEM FLUSH LOGS;
+
+-- Samples within the bounds were collected, nothing outside of them was.
+-- Deallocations are logged with negative size, so compare absolute values.
+SELECT count() > 0, countIf(abs(size) < 4096 OR abs(size) > 16384)
+FROM system.trace_log
+WHERE event_date >= yesterday() AND trace_type = 'MemorySample' AND query_id = (SELECT query_id FROM system.query_log WHERE current_database = currentDatabase() AND event_date >= yesterday() AND query LIKE '%test memory sample size bounds%' AND log_comment = '02556_memory_sample_allocation_size_bounds' ORDER BY event_time DESC LIMIT 1);
@@ -0,0 +1,27 @@
+-- Tags: no-random-merge-tree-settings
+
+DROP TABLE IF EXISTS t_lwd_granules;
+
+CREATE TABLE t_lwd_granules (id UInt64, s String) ENGINE = MergeTree ORDER BY id
+SETTINGS index_granularity = 128, min_bytes_for_wide_part = 0;
+
+INSERT INTO t_lwd_granules SELECT number, toString(number) FROM numbers(10000);
+
+SET mutations_sync = 2;
+SET allow_experimental_lightweight_delete = 1;
+
+-- Delete a contiguous range covering whole granules, but only ~10% of the part,
+-- so that the fully deleted granules are skipped while most granules are kept intact.
+DELETE FROM t_lwd_granules WHERE id >= 1024 AND id < 2048;
+
+SELECT count(), sum(id) FROM t_lwd_granules;
+SELECT count() FROM t_lwd_granules WHERE s != '';
+SELECT id FROM t_lwd_granules WHERE id BETWEEN 1020 AND 1030 ORDER BY id;
+
+-- Mix in sparse deletions, so granules have partially deleted heads and tails
+-- next to the fully deleted ones.
+DELETE FROM t_lwd_granules WHERE id % 10 = 9;
+
+SELECT count(), sum(id) FROM t_lwd_granules;
+
+DROP TABLE t_lwd_granules;
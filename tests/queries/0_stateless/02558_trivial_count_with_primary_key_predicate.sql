@@ -0,0 +1,31 @@
+-- Tags: no-random-merge-tree-settings
+
+drop table if exists t_count_pk;
+
+create table t_count_pk (id UInt64, v String) engine = MergeTree order by id
+settings index_granularity = 64, max_bytes_to_merge_at_max_space_in_pool = 1;
+
+-- Three parts with disjoint primary key ranges.
+insert into t_count_pk select number, toString(number) from numbers(1000);
+insert into t_count_pk select number + 1000, '' from numbers(1000);
+insert into t_count_pk select number + 2000, '' from numbers(1000);
+
+set max_rows_to_read = 1;
+
+-- optimized: the predicate is constant over the key range of every part
+select count() from t_count_pk where id >= 1000;
+select count() from t_count_pk where id < 1000;
+select count() from t_count_pk where id between 1000 and 1999;
+select count() from t_count_pk where id >= 500000;
+
+-- non-optimized: the bound falls inside a part, an exact answer requires reading
+select count() from t_count_pk where id >= 1500; -- { serverError 158 }
+-- non-optimized: not a primary key predicate
+select count() from t_count_pk where v != ''; -- { serverError 158 }
+
+set max_rows_to_read = 0;
+
+select count() from t_count_pk where id >= 1500;
+select count() from t_count_pk where v != '';
+
+drop table t_count_pk;
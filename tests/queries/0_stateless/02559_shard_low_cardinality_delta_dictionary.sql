@@ -0,0 +1,31 @@
+-- Tags: shard
+
+-- LowCardinality columns travel shard -> initiator and client -> server in Native format
+-- with dictionaries shared between the blocks of the stream. Check that values survive
+-- the stateful encoding, including nullable dictionaries and dictionary restarts.
+
+set prefer_localhost_replica = 0;
+
+select count(), uniqExact(s) from (select s from remote('127.0.0.{1,2}', view(
+    select toLowCardinality(toString(number % 100)) as s from numbers(200000))));
+
+select s, count() from (select s from remote('127.0.0.{1,2}', view(
+    select toLowCardinality(toString(number % 10)) as s from numbers(100000)))) group by s order by s;
+
+-- More than 8192 distinct keys: the dictionary is restarted in the middle of the stream.
+select count(), uniqExact(s) from (select s from remote('127.0.0.{1,2}', view(
+    select toLowCardinality(toString(number % 100000)) as s from numbers(200000))));
+
+select count(), uniqExact(s), countIf(isNull(s)) from (select s from remote('127.0.0.{1,2}', view(
+    select toLowCardinality(nullIf(toString(number % 100), '7')) as s from numbers(200000))));
+
+-- Insert direction: the initiator streams LowCardinality blocks to the remote server.
+drop table if exists t_lc_delta;
+create table t_lc_delta (s LowCardinality(String)) engine = MergeTree order by tuple();
+
+insert into function remote('127.0.0.2', currentDatabase(), t_lc_delta)
+    select toLowCardinality(toString(number % 100)) from numbers(100000);
+
+select count(), uniqExact(s) from t_lc_delta;
+
+drop table t_lc_delta;
@@ -0,0 +1,26 @@
+-- Tags: shard
+
+-- Preliminary LIMIT BY on shards must not apply the per-group OFFSET: rows of one group
+-- are spread over the shards, so a row within the offset on one shard may be exactly
+-- the row the merged result needs. Shards keep length + offset rows per group,
+-- and the offset is applied on the initiator over the merged streams.
+
+-- Each shard owns the odd or even values of every group, so per-group offsets
+-- computed on a single shard skip the wrong rows.
+select g, v from remote('127.0.0.{1,2}', view(
+    select number % 3 as g, intDiv(number, 3) * 2 + shardNum() as v from numbers(12)
+)) order by g, v limit 1 offset 1 by g;
+
+select g, v from remote('127.0.0.{1,2}', view(
+    select number % 3 as g, intDiv(number, 3) * 2 + shardNum() as v from numbers(12)
+)) order by g, v limit 2 offset 3 by g;
+
+-- Without the offset the preliminary LIMIT BY is unchanged.
+select g, v from remote('127.0.0.{1,2}', view(
+    select number % 3 as g, intDiv(number, 3) * 2 + shardNum() as v from numbers(12)
+)) order by g, v limit 2 by g;
+
+-- Combined with plain LIMIT on top.
+select g, v from remote('127.0.0.{1,2}', view(
+    select number % 3 as g, intDiv(number, 3) * 2 + shardNum() as v from numbers(12)
+)) order by g, v limit 1 offset 1 by g limit 2;
@@ -0,0 +1,25 @@
+#!/usr/bin/env bash
+
+CURDIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+# shellcheck source=../shell_config.sh
+. "$CURDIR"/../shell_config.sh
+
+CLICKHOUSE_CLIENT="$CLICKHOUSE_CLIENT --optimize_move_to_prewhere=1"
+
+$CLICKHOUSE_CLIENT -q "drop table if exists t_estimates"
+
+$CLICKHOUSE_CLIENT -q "create table t_estimates (k UInt64, v UInt64) engine = MergeTree order by k settings index_granularity = 1000, index_granularity_bytes = 0"
+$CLICKHOUSE_CLIENT -q "insert into t_estimates select number, number from numbers(10000)"
+
+# The estimates are upper bounds: the scan estimate comes from the index analysis,
+# and is propagated through the steps above (capped by LIMIT, summed for the joined sides).
+
+$CLICKHOUSE_CLIENT -q "explain estimates = 1 select v from t_estimates where k < 5000" | grep -o "Estimated rows: [0-9]*"
+echo "-----------------"
+$CLICKHOUSE_CLIENT -q "explain estimates = 1 select v from t_estimates where k < 5000 limit 10" | grep -o "Estimated rows: [0-9]*"
+echo "-----------------"
+$CLICKHOUSE_CLIENT -q "explain estimates = 1 select sum(v) from t_estimates group by k % 10" | grep -o "Estimated rows: [0-9]*"
+echo "-----------------"
+$CLICKHOUSE_CLIENT -q "explain estimates = 1 select t1.v from t_estimates t1, t_estimates t2" | grep -o "Estimated rows: [0-9]*"
+
+$CLICKHOUSE_CLIENT -q "drop table t_estimates"
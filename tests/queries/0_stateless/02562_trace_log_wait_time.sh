@@ -0,0 +1,20 @@
+#!/usr/bin/env bash
+# Tags: no-tsan, no-parallel
+
+CUR_DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+# shellcheck source=../shell_config.sh
+. "$CUR_DIR"/../shell_config.sh
+
+# The initiator has to wait in the polling queue for the results from the remote server.
+
+query_id="$RANDOM-$CLICKHOUSE_DATABASE"
+${CLICKHOUSE_CLIENT} --query_id $query_id --query "SELECT sum(sleepEachRow(0.1)) FROM remote('127.0.0.2', numbers(3)) FORMAT Null SETTINGS trace_waits = 0, async_socket_for_remote = 1"
+
+${CLICKHOUSE_CLIENT} --query "SYSTEM FLUSH LOGS"
+${CLICKHOUSE_CLIENT} --query "SELECT count() = 0 FROM system.trace_log WHERE query_id = '$query_id' AND trace_type = 'Wait'"
+
+query_id="$RANDOM-$CLICKHOUSE_DATABASE"
+${CLICKHOUSE_CLIENT} --query_id $query_id --query "SELECT sum(sleepEachRow(0.1)) FROM remote('127.0.0.2', numbers(3)) FORMAT Null SETTINGS trace_waits = 1, async_socket_for_remote = 1"
+
+${CLICKHOUSE_CLIENT} --query "SYSTEM FLUSH LOGS"
+${CLICKHOUSE_CLIENT} --query "SELECT count() > 0, sum(empty(trace)) = 0, max(size) > 0 FROM system.trace_log WHERE query_id = '$query_id' AND trace_type = 'Wait'"
@@ -0,0 +1,19 @@
+-- Multi-column sorts over fixed-width integer keys take the fused-key path in sortBlock.
+
+SELECT a, b FROM (SELECT toInt8(number % 5 - 2) AS a, toUInt16(number % 3) AS b FROM numbers(15)) ORDER BY a ASC, b DESC;
+
+SELECT a, b FROM (SELECT toInt8(number % 5 - 2) AS a, toUInt16(number % 3) AS b FROM numbers(15)) ORDER BY a DESC, b ASC LIMIT 5;
+
+SELECT d, x FROM (SELECT toDate('2020-01-01') + number % 3 AS d, toInt32(intDiv(number, 3) - 1) AS x FROM numbers(9)) ORDER BY d ASC, x DESC;
+
+-- The keys are wider than 64 bits in total, so this falls back to the generic path. The order must be the same.
+SELECT a, b FROM (SELECT toUInt64(number % 3) AS a, toInt16(number % 4 - 2) AS b FROM numbers(12)) ORDER BY a, b;
+
+-- Blocks of >= 256 rows go through the radix sort of the fused keys.
+SELECT groupArray((a, b)) = arraySort(groupArray((a, b)))
+FROM (SELECT toUInt16((number * 137) % 997) AS a, toInt8(number % 11 - 5) AS b FROM numbers(1000) ORDER BY a, b)
+SETTINGS max_threads = 1;
+
+SELECT groupArray((a, b)) = arraySort(x -> (x.1, -x.2), groupArray((a, b)))
+FROM (SELECT toUInt16((number * 137) % 997) AS a, toInt8(number % 11 - 5) AS b FROM numbers(1000) ORDER BY a ASC, b DESC)
+SETTINGS max_threads = 1;
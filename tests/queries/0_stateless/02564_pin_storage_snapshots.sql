@@ -0,0 +1,14 @@
+DROP TABLE IF EXISTS t_pin_snapshots;
+CREATE TABLE t_pin_snapshots (k UInt32, v UInt32) ENGINE = MergeTree ORDER BY k;
+INSERT INTO t_pin_snapshots SELECT number, number * 10 FROM numbers(100);
+
+SET pin_storage_snapshots = 1;
+
+-- All the references to the table below share the snapshot taken at the first one.
+SELECT count() FROM t_pin_snapshots;
+SELECT count() FROM (SELECT k FROM t_pin_snapshots UNION ALL SELECT k FROM t_pin_snapshots);
+SELECT count() FROM t_pin_snapshots AS a INNER JOIN t_pin_snapshots AS b ON a.k = b.k;
+SELECT (SELECT count() FROM t_pin_snapshots) + count() FROM t_pin_snapshots;
+SELECT sum(v) FROM t_pin_snapshots WHERE k IN (SELECT k FROM t_pin_snapshots WHERE k < 10);
+
+DROP TABLE t_pin_snapshots;
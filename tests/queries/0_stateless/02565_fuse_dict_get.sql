@@ -0,0 +1,50 @@
+DROP DICTIONARY IF EXISTS dict_02565;
+DROP TABLE IF EXISTS dict_source_02565;
+
+CREATE TABLE dict_source_02565
+(
+    id UInt64,
+    v1 String,
+    v2 UInt64,
+    v3 Float64
+) ENGINE = Memory;
+
+INSERT INTO dict_source_02565 VALUES (1, 'a', 10, 1.5), (2, 'b', 20, 2.5);
+
+CREATE DICTIONARY dict_02565
+(
+    id UInt64,
+    v1 String,
+    v2 UInt64,
+    v3 Float64
+) PRIMARY KEY id
+LAYOUT(FLAT())
+SOURCE(CLICKHOUSE(TABLE 'dict_source_02565'))
+LIFETIME(MIN 0 MAX 0);
+
+SET optimize_fuse_dict_get = 1;
+
+-- Calls sharing the dictionary and the key are fused into one multi-attribute call.
+SELECT
+    dictGet('dict_02565', 'v1', number + 1) AS a,
+    dictGet('dict_02565', 'v2', number + 1) AS b,
+    dictGet('dict_02565', 'v3', number + 1) AS c
+FROM numbers(2);
+
+-- Same attribute with different keys is not fused.
+SELECT dictGet('dict_02565', 'v2', toUInt64(1)) + dictGet('dict_02565', 'v2', toUInt64(2));
+
+-- Calls in different clauses are fused too.
+SELECT dictGet('dict_02565', 'v1', number + 1)
+FROM numbers(2)
+WHERE dictGet('dict_02565', 'v2', number + 1) > 15;
+
+-- Duplicate attributes keep a single slot in the fused call.
+SELECT
+    dictGet('dict_02565', 'v1', number + 1),
+    dictGet('dict_02565', 'v2', number + 1),
+    dictGet('dict_02565', 'v1', number + 1)
+FROM numbers(1);
+
+DROP DICTIONARY dict_02565;
+DROP TABLE dict_source_02565;
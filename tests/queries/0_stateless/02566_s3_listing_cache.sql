@@ -0,0 +1,11 @@
+-- Tags: no-fasttest
+-- Tag no-fasttest: Depends on AWS
+
+SET s3_listing_cache_ttl = 3600;
+
+-- The first query lists the bucket and populates the cache, the second one resolves the glob against the cached listing.
+SELECT * FROM s3('http://localhost:11111/test/{a,b,c}.tsv', 'test', 'testtest', 'TSV', 'c1 UInt64, c2 UInt64, c3 UInt64') ORDER BY c1, c2, c3;
+SELECT * FROM s3('http://localhost:11111/test/{a,b,c}.tsv', 'test', 'testtest', 'TSV', 'c1 UInt64, c2 UInt64, c3 UInt64') ORDER BY c1, c2, c3;
+
+-- A different glob with the same prefix reuses the cached listing.
+SELECT count() FROM s3('http://localhost:11111/test/{a,c}.tsv', 'test', 'testtest', 'TSV', 'c1 UInt64, c2 UInt64, c3 UInt64');
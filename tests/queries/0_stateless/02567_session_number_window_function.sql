@@ -0,0 +1,41 @@
+SELECT
+    user,
+    ts,
+    sessionNumber(ts, INTERVAL 30 MINUTE) OVER (PARTITION BY user ORDER BY ts) AS session
+FROM values('user UInt8, ts DateTime(\'UTC\')',
+    (1, '2023-01-01 00:00:00'),
+    (1, '2023-01-01 00:10:00'),
+    (1, '2023-01-01 01:00:00'),
+    (1, '2023-01-01 01:20:00'),
+    (2, '2023-01-01 00:00:00'),
+    (2, '2023-01-01 00:40:00'))
+ORDER BY user, ts;
+
+-- Closed sessions are obtained by an ordinary GROUP BY over the session number.
+SELECT user, session, count(), min(ts), max(ts)
+FROM
+(
+    SELECT
+        user,
+        ts,
+        sessionNumber(ts, INTERVAL 30 MINUTE) OVER (PARTITION BY user ORDER BY ts) AS session
+    FROM values('user UInt8, ts DateTime(\'UTC\')',
+        (1, '2023-01-01 00:00:00'),
+        (1, '2023-01-01 00:10:00'),
+        (1, '2023-01-01 01:00:00'),
+        (2, '2023-01-01 00:00:00'))
+)
+GROUP BY user, session
+ORDER BY user, session;
+
+-- Subsecond gaps with DateTime64.
+SELECT sessionNumber(ts, INTERVAL 1 SECOND) OVER (ORDER BY ts) AS session
+FROM values('ts DateTime64(3, \'UTC\')',
+    '2023-01-01 00:00:00.000',
+    '2023-01-01 00:00:00.500',
+    '2023-01-01 00:00:02.000')
+ORDER BY ts;
+
+SELECT sessionNumber(now()) OVER () FROM numbers(1); -- { serverError 36 }
+SELECT sessionNumber(1, INTERVAL 1 MINUTE) OVER () FROM numbers(1); -- { serverError 36 }
+SELECT sessionNumber(now(), 10) OVER () FROM numbers(1); -- { serverError 36 }
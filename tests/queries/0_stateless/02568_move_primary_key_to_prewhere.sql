@@ -0,0 +1,20 @@
+SET optimize_move_to_prewhere = 1;
+SET convert_query_to_cnf = 0;
+
+DROP TABLE IF EXISTS t_pk_to_prewhere;
+
+CREATE TABLE t_pk_to_prewhere (id UInt64, fat_string String)
+ENGINE = MergeTree ORDER BY id
+SETTINGS min_rows_for_wide_part = 100, min_bytes_for_wide_part = 0;
+
+INSERT INTO t_pk_to_prewhere SELECT number, repeat('a', 1000) FROM numbers(1000);
+
+-- By default conditions on the first primary key column stay in WHERE.
+EXPLAIN SYNTAX SELECT * FROM t_pk_to_prewhere WHERE id = 5;
+
+SET move_primary_key_columns_to_prewhere = 1;
+
+EXPLAIN SYNTAX SELECT * FROM t_pk_to_prewhere WHERE id = 5;
+SELECT id, length(fat_string) FROM t_pk_to_prewhere WHERE id = 5;
+
+DROP TABLE t_pk_to_prewhere;
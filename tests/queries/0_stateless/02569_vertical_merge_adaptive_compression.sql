@@ -0,0 +1,21 @@
+DROP TABLE IF EXISTS t_adaptive_codec;
+
+CREATE TABLE t_adaptive_codec (key UInt64, seq UInt64, f Float64, s String)
+ENGINE = MergeTree ORDER BY key
+SETTINGS min_rows_for_wide_part = 0, min_bytes_for_wide_part = 0,
+    enable_vertical_merge_algorithm = 1,
+    vertical_merge_algorithm_min_rows_to_activate = 1,
+    vertical_merge_algorithm_min_columns_to_activate = 1,
+    vertical_merge_adaptive_compression = 1;
+
+INSERT INTO t_adaptive_codec SELECT number, number, number / 7, concat('x', toString(number % 100)) FROM numbers(50000);
+INSERT INTO t_adaptive_codec SELECT number, number, number / 7, concat('x', toString(number % 100)) FROM numbers(50000, 50000);
+
+OPTIMIZE TABLE t_adaptive_codec FINAL;
+
+SELECT count() FROM system.parts WHERE database = currentDatabase() AND table = 't_adaptive_codec' AND active;
+
+SELECT count(), sum(seq), sum(length(s)) FROM t_adaptive_codec;
+SELECT key, seq, f, s FROM t_adaptive_codec WHERE key IN (0, 49999, 99999) ORDER BY key;
+
+DROP TABLE t_adaptive_codec;
@@ -0,0 +1,25 @@
+-- Tags: zookeeper
+
+DROP TABLE IF EXISTS t_local_dedup_cache;
+
+CREATE TABLE t_local_dedup_cache (x UInt64)
+ENGINE = ReplicatedMergeTree('/clickhouse/tables/{database}/test_02570/t_local_dedup_cache', 'r1')
+ORDER BY x
+SETTINGS use_local_block_dedup_cache = 1;
+
+-- Identical inserts are deduplicated; retries after the first one are resolved by the local cache.
+INSERT INTO t_local_dedup_cache VALUES (1);
+INSERT INTO t_local_dedup_cache VALUES (1);
+INSERT INTO t_local_dedup_cache VALUES (1);
+INSERT INTO t_local_dedup_cache VALUES (2);
+INSERT INTO t_local_dedup_cache VALUES (2);
+
+SELECT x FROM t_local_dedup_cache ORDER BY x;
+
+-- The same applies to explicit deduplication tokens.
+INSERT INTO t_local_dedup_cache SETTINGS insert_deduplication_token = 'token1' VALUES (3);
+INSERT INTO t_local_dedup_cache SETTINGS insert_deduplication_token = 'token1' VALUES (4);
+
+SELECT x FROM t_local_dedup_cache WHERE x IN (3, 4) ORDER BY x;
+
+DROP TABLE t_local_dedup_cache;
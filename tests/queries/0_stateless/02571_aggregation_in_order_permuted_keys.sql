@@ -0,0 +1,23 @@
+DROP TABLE IF EXISTS t_group_by_permuted;
+
+CREATE TABLE t_group_by_permuted (a UInt32, b UInt32, v UInt64) ENGINE = MergeTree ORDER BY (a, b);
+INSERT INTO t_group_by_permuted SELECT number % 3, number % 5, number FROM numbers(100);
+
+SET optimize_aggregation_in_order = 1;
+SET max_threads = 1;
+
+-- GROUP BY keys are an unordered set, so GROUP BY b, a can be executed
+-- in order of the table sorted by (a, b) with the legacy optimizer as well.
+SET query_plan_aggregation_in_order = 0;
+
+SELECT b, a, sum(v) FROM t_group_by_permuted GROUP BY b, a ORDER BY b, a;
+
+SELECT trimLeft(explain) FROM (EXPLAIN PIPELINE SELECT b, a, sum(v) FROM t_group_by_permuted GROUP BY b, a)
+WHERE explain LIKE '%AggregatingInOrder%';
+
+-- The query plan level optimization supports permuted keys too, results must be the same.
+SET query_plan_aggregation_in_order = 1;
+
+SELECT b, a, sum(v) FROM t_group_by_permuted GROUP BY b, a ORDER BY b, a;
+
+DROP TABLE t_group_by_permuted;
@@ -0,0 +1,27 @@
+DROP TABLE IF EXISTS t_02572_sample;
+
+CREATE TABLE t_02572_sample (k UInt64, v UInt64) ENGINE = MergeTree ORDER BY k
+SETTINGS index_granularity = 10;
+
+INSERT INTO t_02572_sample SELECT number, number FROM numbers(10000);
+
+-- Without the setting SAMPLE is still rejected for tables without a sampling key.
+SELECT count() FROM t_02572_sample SAMPLE 1 / 2; -- { serverError 141 }
+
+SET allow_sample_without_sampling_key = 1;
+
+-- A pseudo-random subset of granules is selected: non-empty and strictly less than the table.
+SELECT count() > 0 AND count() < 10000 FROM t_02572_sample SAMPLE 1 / 2;
+
+-- The selection is deterministic: repeated queries see the same subset.
+SELECT (SELECT count() FROM t_02572_sample SAMPLE 1 / 2)
+    = (SELECT count() FROM t_02572_sample SAMPLE 1 / 2);
+
+-- Non-intersecting offsets select disjoint subsets covering the whole table.
+SELECT (SELECT count() FROM t_02572_sample SAMPLE 1 / 2)
+    + (SELECT count() FROM t_02572_sample SAMPLE 1 / 2 OFFSET 1 / 2) = 10000;
+
+-- _sample_factor reflects the requested sample size.
+SELECT any(_sample_factor) FROM t_02572_sample SAMPLE 1 / 4;
+
+DROP TABLE t_02572_sample;
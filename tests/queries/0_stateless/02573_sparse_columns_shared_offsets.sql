@@ -0,0 +1,18 @@
+DROP TABLE IF EXISTS t_sparse_shared_offsets;
+
+CREATE TABLE t_sparse_shared_offsets (id UInt64, u UInt64)
+ENGINE = MergeTree ORDER BY id
+SETTINGS ratio_of_defaults_for_sparse_serialization = 0.9;
+
+INSERT INTO t_sparse_shared_offsets SELECT number, number % 100 = 0 ? number : 0 FROM numbers(10000);
+
+SELECT column, serialization_kind FROM system.parts_columns
+WHERE table = 't_sparse_shared_offsets' AND database = currentDatabase() AND active AND column = 'u'
+ORDER BY column;
+
+-- Functions with the same sparse column in several arguments are executed over values only.
+SELECT sum(u * u), sum(u + u), max(u * u + u) FROM t_sparse_shared_offsets;
+SELECT id, u * u FROM t_sparse_shared_offsets WHERE u * u != 0 ORDER BY id LIMIT 5;
+SELECT countIf(u + u = 0), countIf(u * 2 = u + u) FROM t_sparse_shared_offsets;
+
+DROP TABLE t_sparse_shared_offsets;
@@ -0,0 +1,14 @@
+SET use_query_ast_cache = 1;
+
+SELECT 1 + 2 + 3 AS x_02574;
+SELECT 1 + 2 + 3 AS x_02574;
+
+SYSTEM FLUSH LOGS;
+
+SELECT ProfileEvents['QueryASTCacheHits']
+FROM system.query_log
+WHERE current_database = currentDatabase()
+    AND type = 'QueryFinish'
+    AND query LIKE '%x\_02574%'
+    AND query NOT LIKE '%query_log%'
+ORDER BY event_time_microseconds;
@@ -0,0 +1,19 @@
+-- Within a single DST regime the constant-offset fast path must match the generic per-value path.
+-- DateTime64 and Date32 arguments do not take the fast path, so they serve as the reference.
+SELECT count()
+FROM (SELECT toDateTime('2023-06-01 00:00:00', 'Europe/Paris') + number * 97 AS t FROM numbers(100000))
+WHERE toStartOfHour(t) != toStartOfHour(toDateTime64(t, 0, 'Europe/Paris'));
+
+SELECT count()
+FROM (SELECT toDateTime('2023-06-01 00:00:00', 'Europe/Paris') + number * 97 AS t FROM numbers(100000))
+WHERE toDate(t) != toDate32(t);
+
+SELECT count()
+FROM (SELECT toDateTime('2023-06-01 00:00:00', 'Europe/Paris') + number * 97 AS t FROM numbers(100000))
+WHERE toYYYYMM(t) != toYYYYMM(toDate32(t));
+
+-- Blocks touching a DST transition day take the generic path: check values around the change.
+SELECT toStartOfHour(toDateTime('2023-03-26 01:59:59', 'Europe/Paris')), toStartOfHour(toDateTime('2023-03-26 03:00:01', 'Europe/Paris'));
+
+-- Local date and month differ from UTC shortly after local midnight.
+SELECT toDate(toDateTime('2023-06-01 00:30:00', 'Europe/Paris')), toYYYYMM(toDateTime('2023-06-01 01:30:00', 'Europe/Paris'));
@@ -0,0 +1,13 @@
+SET max_threads = 1;
+
+-- Groups around the inline buffer capacity of the groupArray state.
+SELECT k, groupArray(v), groupArray(toString(v)) FROM (SELECT number % 4 AS k, number AS v FROM numbers(20) ORDER BY v) GROUP BY k ORDER BY k;
+
+-- Large groups spill to the arena.
+SELECT k, length(groupArray(v)), arraySum(groupArray(v)) FROM (SELECT number % 3 AS k, number AS v FROM numbers(1000)) GROUP BY k ORDER BY k;
+
+-- Merging of partial states across the inline/spilled boundary.
+SELECT length(groupArrayMerge(s)), arraySum(groupArrayMerge(s)) FROM (SELECT groupArrayState(number) AS s FROM numbers(1000) GROUP BY number % 100);
+
+-- groupArrayLast keeps its ring buffer over the same storage.
+SELECT groupArrayLast(3)(number) FROM numbers(10);
@@ -0,0 +1,33 @@
+SET join_algorithm = 'grace_hash';
+SET max_bytes_in_join = '10K';
+SET grace_hash_join_initial_buckets = 4;
+
+-- Sparse build keys: most probe rows are pruned, the result must not change.
+SELECT count(), sum(t1.key), sum(t2.payload)
+FROM (SELECT number AS key FROM numbers(10000)) t1
+INNER JOIN (SELECT number * 10 AS key, number AS payload FROM numbers(1000)) t2
+ON t1.key = t2.key;
+
+-- String keys.
+SELECT count()
+FROM (SELECT toString(number) AS key FROM numbers(10000)) t1
+INNER JOIN (SELECT toString(number * 7) AS key FROM numbers(1000)) t2
+ON t1.key = t2.key;
+
+-- Nullable keys: NULLs never match, non-NULL matches must survive the pruning.
+SELECT count(), sum(t2.key)
+FROM (SELECT if(number % 3 = 0, NULL, number) AS key FROM numbers(10000)) t1
+INNER JOIN (SELECT if(number % 5 = 0, NULL, number * 2) AS key FROM numbers(1000)) t2
+ON t1.key = t2.key;
+
+-- Floating point keys: pruning is disabled because of NaNs, the join still works.
+SELECT count()
+FROM (SELECT if(number % 100 = 0, nan, toFloat64(number)) AS key FROM numbers(10000)) t1
+INNER JOIN (SELECT toFloat64(number * 3) AS key FROM numbers(1000)) t2
+ON t1.key = t2.key;
+
+-- LEFT JOIN keeps unmatched probe rows, so no pruning may be applied.
+SELECT count(), countIf(t2.key != 0)
+FROM (SELECT number AS key FROM numbers(10000)) t1
+LEFT JOIN (SELECT number + 9500 AS key FROM numbers(1000)) t2
+ON t1.key = t2.key;
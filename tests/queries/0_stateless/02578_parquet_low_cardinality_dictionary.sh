@@ -0,0 +1,17 @@
+#!/usr/bin/env bash
+# Tags: no-fasttest
+
+CURDIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+# shellcheck source=../shell_config.sh
+. "$CURDIR"/../shell_config.sh
+
+# Roundtrip LowCardinality columns through Parquet with and without
+# mapping them to Parquet dictionary encoding.
+for enabled in 1 0
+do
+    $CLICKHOUSE_CLIENT -q "drop table if exists test_parquet_lc"
+    $CLICKHOUSE_CLIENT -q "create table test_parquet_lc (a LowCardinality(String), b LowCardinality(Nullable(String))) Engine = MergeTree order by tuple()"
+    $CLICKHOUSE_CLIENT -q "select toLowCardinality(toString(number % 10)) as a, toLowCardinality(if(number % 7 = 0, NULL, toString(number % 100))) as b from numbers(100000) settings output_format_parquet_low_cardinality_as_dictionary = $enabled, max_block_size = 8192 format Parquet" | $CLICKHOUSE_CLIENT -q "insert into test_parquet_lc format Parquet"
+    $CLICKHOUSE_CLIENT -q "select count(), uniqExact(a), countIf(b is null), uniqExact(b) from test_parquet_lc"
+    $CLICKHOUSE_CLIENT -q "drop table if exists test_parquet_lc"
+done
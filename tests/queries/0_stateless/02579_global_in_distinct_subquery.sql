@@ -0,0 +1,23 @@
+-- Tags: shard
+
+DROP TABLE IF EXISTS t_global_in_distinct;
+CREATE TABLE t_global_in_distinct (x UInt64) ENGINE = MergeTree ORDER BY x;
+INSERT INTO t_global_in_distinct SELECT number FROM numbers(100);
+
+-- Subquery with many duplicate values, results must not depend on the deduplication of the shipped set.
+SELECT count() FROM remote('127.0.0.{1,2}', currentDatabase(), t_global_in_distinct)
+WHERE x GLOBAL IN (SELECT intDiv(number, 10) FROM numbers(100));
+
+SELECT count() FROM remote('127.0.0.{1,2}', currentDatabase(), t_global_in_distinct)
+WHERE x GLOBAL IN (SELECT intDiv(number, 10) FROM numbers(100))
+SETTINGS distinct_global_in_subquery = 0;
+
+-- LIMIT inside the subquery must keep its semantics (DISTINCT is not added under LIMIT).
+SELECT count() FROM remote('127.0.0.{1,2}', currentDatabase(), t_global_in_distinct)
+WHERE x GLOBAL IN (SELECT intDiv(number, 10) FROM numbers(100) LIMIT 5);
+
+-- Union branches are deduplicated independently.
+SELECT count() FROM remote('127.0.0.{1,2}', currentDatabase(), t_global_in_distinct)
+WHERE x GLOBAL IN (SELECT 1 UNION ALL SELECT 1 UNION ALL SELECT 2);
+
+DROP TABLE t_global_in_distinct;
@@ -0,0 +1,9 @@
+-- Equal expressions under different aliases share one computation, results must not change.
+SELECT lower(s) AS a, lower(s) AS b, concat(lower(s), upper(s)) AS c FROM (SELECT materialize('AbC') AS s);
+
+-- Lambdas with equal signatures are different functions and must stay distinct.
+SELECT arrayMap(x -> x + 1, [1, 2]) AS a, arrayMap(x -> x * 2, [1, 2]) AS b;
+
+SELECT sum(length(lower(t)) + length(lower(t))) FROM (SELECT toString(number) AS t FROM numbers(1000));
+SELECT sum(length(lower(t)) + length(lower(t))) FROM (SELECT toString(number) AS t FROM numbers(1000))
+SETTINGS eliminate_common_subexpressions = 0;
@@ -0,0 +1,18 @@
+DROP TABLE IF EXISTS t_pk_lazy_load;
+
+CREATE TABLE t_pk_lazy_load (k UInt64, v UInt64) ENGINE = MergeTree ORDER BY k
+SETTINGS primary_key_lazy_load = 1, index_granularity = 128;
+
+INSERT INTO t_pk_lazy_load SELECT number, number * 2 FROM numbers(100000);
+
+-- After reload the primary key stays on disk until some query needs it.
+DETACH TABLE t_pk_lazy_load;
+ATTACH TABLE t_pk_lazy_load;
+
+SELECT primary_key_bytes_in_memory = 0 FROM system.parts WHERE database = currentDatabase() AND table = 't_pk_lazy_load' AND active;
+
+SELECT v FROM t_pk_lazy_load WHERE k = 99999;
+
+SELECT primary_key_bytes_in_memory > 0 FROM system.parts WHERE database = currentDatabase() AND table = 't_pk_lazy_load' AND active;
+
+DROP TABLE t_pk_lazy_load;
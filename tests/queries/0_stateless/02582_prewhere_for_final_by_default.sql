@@ -0,0 +1,20 @@
+SET optimize_move_to_prewhere = 1;
+SET convert_query_to_cnf = 0;
+
+DROP TABLE IF EXISTS t_final_prewhere;
+
+CREATE TABLE t_final_prewhere (k UInt64, y UInt64, v UInt64, payload String) ENGINE = ReplacingMergeTree(v) ORDER BY (k, y);
+
+INSERT INTO t_final_prewhere SELECT number, number * 2, 1, 'a' FROM numbers(100);
+INSERT INTO t_final_prewhere SELECT number, number * 2, 2, 'b' FROM numbers(100);
+
+-- Sorting key conditions are moved to PREWHERE by default and do not change the collapsed result.
+EXPLAIN SYNTAX SELECT payload FROM t_final_prewhere FINAL WHERE y < 20;
+SELECT count(), countIf(payload = 'b') FROM t_final_prewhere FINAL WHERE y < 20;
+
+select '';
+-- Conditions with non-deterministic functions must be evaluated after collapsing
+-- even if they depend only on sorting key columns.
+EXPLAIN SYNTAX SELECT payload FROM t_final_prewhere FINAL WHERE y < 20 + ignore(rand());
+
+DROP TABLE t_final_prewhere;
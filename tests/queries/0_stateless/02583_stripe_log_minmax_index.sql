@@ -0,0 +1,25 @@
+DROP TABLE IF EXISTS t_stripe_log_minmax;
+
+CREATE TABLE t_stripe_log_minmax (k UInt64, s String) ENGINE = StripeLog SETTINGS minmax_index = 1;
+
+INSERT INTO t_stripe_log_minmax SELECT number, toString(number) FROM numbers(100);
+INSERT INTO t_stripe_log_minmax SELECT number, toString(number) FROM numbers(100, 100);
+INSERT INTO t_stripe_log_minmax SELECT number, toString(number) FROM numbers(200, 100);
+
+-- The stripes whose min-max values cannot satisfy the condition are not read at all.
+SELECT count() FROM t_stripe_log_minmax WHERE k >= 200 SETTINGS max_rows_to_read = 100;
+SELECT count() FROM t_stripe_log_minmax WHERE k = 150 SETTINGS max_rows_to_read = 100;
+SELECT count() FROM t_stripe_log_minmax WHERE s = '150' SETTINGS max_rows_to_read = 200;
+
+-- No stripes are skipped erroneously.
+SELECT count() FROM t_stripe_log_minmax;
+SELECT count() FROM t_stripe_log_minmax WHERE k < 300;
+
+-- The min-max index survives DETACH / ATTACH.
+DETACH TABLE t_stripe_log_minmax;
+ATTACH TABLE t_stripe_log_minmax;
+
+SELECT count() FROM t_stripe_log_minmax WHERE k >= 200 SETTINGS max_rows_to_read = 100;
+SELECT count() FROM t_stripe_log_minmax;
+
+DROP TABLE t_stripe_log_minmax;
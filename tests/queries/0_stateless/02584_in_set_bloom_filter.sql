@@ -0,0 +1,4 @@
+-- The set is large enough to build the bloom pre-filter, the probes are a mix of hits and misses.
+SELECT count() FROM numbers(2000000) WHERE number IN (SELECT number * 2 FROM numbers(1100000));
+SELECT count() FROM numbers(2000000) WHERE number NOT IN (SELECT number * 2 FROM numbers(1100000));
+SELECT count() FROM numbers(2000000) WHERE toString(number) IN (SELECT toString(number * 2) FROM numbers(1100000));
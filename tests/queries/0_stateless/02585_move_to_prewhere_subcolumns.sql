@@ -0,0 +1,21 @@
+SET optimize_move_to_prewhere = 1;
+SET optimize_functions_to_subcolumns = 1;
+SET convert_query_to_cnf = 0;
+
+DROP TABLE IF EXISTS t_prewhere_subcolumns;
+
+CREATE TABLE t_prewhere_subcolumns (id UInt64, v String, m Map(String, String), tags Array(String))
+ENGINE = MergeTree ORDER BY id
+SETTINGS min_bytes_for_wide_part = 0;
+
+INSERT INTO t_prewhere_subcolumns
+SELECT number, repeat('v', 100), map('k' || toString(number % 10), 'v'), ['t' || toString(number % 10)]
+FROM numbers(1000);
+
+-- Conditions rewritten to subcolumns are moved to PREWHERE and read only the needed substreams.
+EXPLAIN SYNTAX SELECT v FROM t_prewhere_subcolumns WHERE mapContains(m, 'k1');
+EXPLAIN SYNTAX SELECT v FROM t_prewhere_subcolumns WHERE notEmpty(tags);
+
+SELECT count() FROM t_prewhere_subcolumns WHERE mapContains(m, 'k1');
+
+DROP TABLE t_prewhere_subcolumns;
@@ -0,0 +1,18 @@
+DROP TABLE IF EXISTS t_granule_head_skip;
+
+CREATE TABLE t_granule_head_skip (k UInt64, v UInt64, s String)
+ENGINE = MergeTree ORDER BY k
+SETTINGS index_granularity = 8192;
+
+INSERT INTO t_granule_head_skip SELECT number, number, toString(number) FROM numbers(100000);
+
+-- The matching rows are in the middle of a granule: both the head and the tail of the granule
+-- are filtered out by the first step and must be skipped when the remaining columns are read.
+SELECT count(), sum(v) FROM t_granule_head_skip PREWHERE k >= 20000 AND k < 20100 WHERE s != '';
+SELECT count(), min(k), max(k) FROM t_granule_head_skip PREWHERE v = 50000;
+SELECT s FROM t_granule_head_skip PREWHERE v = 99999;
+
+-- Range spanning a granule boundary: head of the first granule and tail of the second.
+SELECT count(), min(v), max(v) FROM t_granule_head_skip PREWHERE k >= 8000 AND k < 8400;
+
+DROP TABLE t_granule_head_skip;
@@ -0,0 +1,24 @@
+DROP TABLE IF EXISTS t_ineffective_skip_index;
+
+CREATE TABLE t_ineffective_skip_index (k UInt64, v UInt64, INDEX idx_v v TYPE minmax GRANULARITY 1)
+ENGINE = MergeTree ORDER BY k
+SETTINGS index_granularity = 128;
+
+INSERT INTO t_ineffective_skip_index SELECT number, number % 2 FROM numbers(200000);
+
+SET skip_indexes_min_effectiveness_ratio = 0.1;
+
+-- The first query has no statistics yet, so the index is consulted and drops nothing.
+SELECT count() FROM t_ineffective_skip_index WHERE v = 1;
+
+SELECT granules_tested >= 1000, granules_dropped FROM system.data_skipping_indices
+WHERE database = currentDatabase() AND table = 't_ineffective_skip_index';
+
+-- The observed effectiveness is below the threshold now, so the index is not consulted any more.
+SELECT count() > 0 FROM (EXPLAIN indexes = 1 SELECT count() FROM t_ineffective_skip_index WHERE v = 1) WHERE explain LIKE '%idx_v%';
+
+SET skip_indexes_min_effectiveness_ratio = 0;
+
+SELECT count() > 0 FROM (EXPLAIN indexes = 1 SELECT count() FROM t_ineffective_skip_index WHERE v = 1) WHERE explain LIKE '%idx_v%';
+
+DROP TABLE t_ineffective_skip_index;
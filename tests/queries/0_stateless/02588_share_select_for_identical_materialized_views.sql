@@ -0,0 +1,31 @@
+DROP TABLE IF EXISTS t_02588;
+DROP TABLE IF EXISTS mv1_02588;
+DROP TABLE IF EXISTS mv2_02588;
+DROP TABLE IF EXISTS mv3_02588;
+
+CREATE TABLE t_02588 (k UInt64, v UInt64) ENGINE = MergeTree ORDER BY k;
+
+CREATE MATERIALIZED VIEW mv1_02588 ENGINE = MergeTree ORDER BY k AS SELECT k, v * 2 AS v FROM t_02588 WHERE v % 2 = 0;
+CREATE MATERIALIZED VIEW mv2_02588 ENGINE = MergeTree ORDER BY k AS SELECT k, v * 2 AS v FROM t_02588 WHERE v % 2 = 0;
+CREATE MATERIALIZED VIEW mv3_02588 ENGINE = MergeTree ORDER BY k AS SELECT k, v + 1 AS v FROM t_02588;
+
+SET share_select_for_identical_materialized_views = 1;
+
+INSERT INTO t_02588 SELECT number, number FROM numbers(1000);
+
+SELECT count(), sum(v) FROM mv1_02588;
+SELECT count(), sum(v) FROM mv2_02588;
+SELECT count(), sum(v) FROM mv3_02588;
+
+SET parallel_view_processing = 1;
+
+INSERT INTO t_02588 SELECT number, number FROM numbers(1000);
+
+SELECT count(), sum(v) FROM mv1_02588;
+SELECT count(), sum(v) FROM mv2_02588;
+SELECT count(), sum(v) FROM mv3_02588;
+
+DROP TABLE mv1_02588;
+DROP TABLE mv2_02588;
+DROP TABLE mv3_02588;
+DROP TABLE t_02588;
@@ -0,0 +1,21 @@
+-- Tags: zookeeper
+
+DROP TABLE IF EXISTS t_02589_1;
+DROP TABLE IF EXISTS t_02589_2;
+
+CREATE TABLE t_02589_1 (k UInt64, v String)
+    ENGINE = ReplicatedMergeTree('/clickhouse/tables/{database}/02589/t', 'r1') ORDER BY k
+    SETTINGS replicated_fetches_defer_checksum_verification = 1;
+
+CREATE TABLE t_02589_2 (k UInt64, v String)
+    ENGINE = ReplicatedMergeTree('/clickhouse/tables/{database}/02589/t', 'r2') ORDER BY k
+    SETTINGS replicated_fetches_defer_checksum_verification = 1;
+
+INSERT INTO t_02589_1 SELECT number, toString(number) FROM numbers(100000);
+
+SYSTEM SYNC REPLICA t_02589_2;
+
+SELECT count(), sum(k) FROM t_02589_2;
+
+DROP TABLE t_02589_1;
+DROP TABLE t_02589_2;
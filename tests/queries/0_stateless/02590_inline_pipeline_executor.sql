@@ -0,0 +1,13 @@
+SET use_inline_pipeline_executor = 1;
+
+SELECT 1;
+
+SET max_threads = 1;
+
+SELECT sum(number) FROM numbers(100000);
+SELECT number FROM numbers(10) ORDER BY number DESC LIMIT 3;
+
+-- Multi-threaded pipelines keep using the asynchronous executor.
+SET max_threads = 4;
+
+SELECT sum(number) FROM numbers_mt(100000);
@@ -0,0 +1,15 @@
+-- Tags: no-parallel
+-- Tag no-parallel: Messes with internal cache
+
+-- Start with empty query result cache (QRC).
+SYSTEM DROP QUERY RESULT CACHE;
+
+-- With no identical query in flight, a query with coalescing on runs normally and stores its result.
+SELECT 1 SETTINGS enable_experimental_query_result_cache = true, query_result_cache_coalesce_identical_queries = true;
+SELECT count(*) FROM system.query_result_cache;
+
+-- The second run is served from the cache (coalescing does not get in the way of regular lookups).
+SELECT 1 SETTINGS enable_experimental_query_result_cache = true, query_result_cache_coalesce_identical_queries = true;
+SELECT count(*) FROM system.query_result_cache;
+
+SYSTEM DROP QUERY RESULT CACHE;
@@ -0,0 +1,20 @@
+#!/usr/bin/env bash
+# Tags: no-parallel, no-fasttest
+
+CURDIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+# shellcheck source=../shell_config.sh
+. "$CURDIR"/../shell_config.sh
+
+
+USER_FILES_PATH=$(clickhouse-client --query "select _path,_file from file('nonexist.txt', 'CSV', 'val1 char')" 2>&1 | grep Exception | awk '{gsub("/nonexist.txt","",$9); print $9}')
+FILE_NAME=test_02592.parquet
+DATA_FILE=$USER_FILES_PATH/$FILE_NAME
+
+$CLICKHOUSE_CLIENT -q "select number as x from numbers(100000) format Parquet settings output_format_parquet_row_group_size = 10000" > $DATA_FILE
+
+$CLICKHOUSE_CLIENT -q "select count(), sum(x) from file('$FILE_NAME', 'Parquet') settings input_format_parquet_max_decoding_threads = 4"
+
+# Parallel decoding must deliver rows in file order.
+$CLICKHOUSE_CLIENT -q "select count() from (select x, rowNumberInAllBlocks() as row from file('$FILE_NAME', 'Parquet') settings input_format_parquet_max_decoding_threads = 4, max_threads = 1) where x != row"
+
+rm $DATA_FILE
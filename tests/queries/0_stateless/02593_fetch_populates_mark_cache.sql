@@ -0,0 +1,21 @@
+-- Tags: zookeeper
+
+DROP TABLE IF EXISTS t_02593_1;
+DROP TABLE IF EXISTS t_02593_2;
+
+CREATE TABLE t_02593_1 (k UInt64, v String)
+    ENGINE = ReplicatedMergeTree('/clickhouse/tables/{database}/02593/t', 'r1') ORDER BY k
+    SETTINGS replicated_fetches_populate_mark_cache = 1;
+
+CREATE TABLE t_02593_2 (k UInt64, v String)
+    ENGINE = ReplicatedMergeTree('/clickhouse/tables/{database}/02593/t', 'r2') ORDER BY k
+    SETTINGS replicated_fetches_populate_mark_cache = 1;
+
+INSERT INTO t_02593_1 SELECT number, toString(number) FROM numbers(100000);
+
+SYSTEM SYNC REPLICA t_02593_2;
+
+SELECT count(), sum(k) FROM t_02593_2;
+
+DROP TABLE t_02593_1;
+DROP TABLE t_02593_2;
@@ -0,0 +1,17 @@
+SET optimize_fuse_array_functions = 1;
+
+SELECT arraySum(arrayMap(x -> x * 2, [1, 2, 3]));
+SELECT arrayCount(arrayMap(x -> x % 2, [1, 2, 3, 4]));
+SELECT arrayMin(arrayMap(x -> -x, [1, 2, 3])), arrayMax(arrayMap(x -> -x, [1, 2, 3]));
+SELECT arrayExists(arrayMap(x -> x > 2, [1, 2, 3])), arrayAll(arrayMap(x -> x > 0, [1, 2, 3]));
+SELECT length(arrayFilter(x -> x > 1, [1, 2, 3]));
+SELECT empty(arrayFilter(x -> x > 5, [1, 2, 3])), notEmpty(arrayFilter(x -> x > 2, [1, 2, 3]));
+
+-- arrayMap over several arrays is fused too
+SELECT arraySum(arrayMap((x, y) -> x * y, [1, 2, 3], [4, 5, 6]));
+
+-- the fused query returns the arrayCount type (UInt32), which proves the rewrite fired
+SELECT toTypeName(length(arrayFilter(x -> x > 1, [1, 2, 3])));
+
+-- no rewrite if the intermediate array is referenced via an alias
+SELECT length(arrayFilter(x -> x > 1, [1, 2, 3]) AS flt), flt;
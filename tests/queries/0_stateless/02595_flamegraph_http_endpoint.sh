@@ -0,0 +1,34 @@
+#!/usr/bin/env bash
+# Tags: no-fasttest
+
+CUR_DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+# shellcheck source=../shell_config.sh
+. "$CUR_DIR"/../shell_config.sh
+
+FLAMEGRAPH_URL="${CLICKHOUSE_PORT_HTTP_PROTO}://${CLICKHOUSE_HOST}:${CLICKHOUSE_PORT_HTTP}/flamegraph"
+
+# The endpoint requires authentication, like the query endpoint.
+${CLICKHOUSE_CURL} -sS "${FLAMEGRAPH_URL}?user=default&password=wrong" | grep -o "Authentication failed"
+
+# Without query_id the endpoint explains its usage.
+${CLICKHOUSE_CURL} -sS "${FLAMEGRAPH_URL}?user=default" | grep -o "No 'query_id' parameter specified"
+
+# A query that is not running is reported as such.
+${CLICKHOUSE_CURL} -sS "${FLAMEGRAPH_URL}?query_id=02595_no_such_query&user=default" | grep -o "is not currently executing"
+
+# Sample a long-running query and check that we got at least one collapsed stack with a count.
+QUERY_ID="02595_flamegraph_${CLICKHOUSE_DATABASE}"
+${CLICKHOUSE_CLIENT} --query_id "${QUERY_ID}" --query "SELECT sum(sipHash64(number)) FROM numbers(500000000) FORMAT Null" &
+
+# Wait until the query shows up in the process list.
+for _ in {1..100}
+do
+    if [ "$(${CLICKHOUSE_CLIENT} --query "SELECT count() FROM system.processes WHERE query_id = '${QUERY_ID}'")" == "1" ]; then
+        break
+    fi
+    sleep 0.1
+done
+
+${CLICKHOUSE_CURL} -sS "${FLAMEGRAPH_URL}?query_id=${QUERY_ID}&duration=1&interval=50&user=default" | grep -q ' [0-9]*$' && echo "got stacks"
+
+wait
@@ -0,0 +1,44 @@
+DROP TABLE IF EXISTS t_vertical_nested;
+DROP TABLE IF EXISTS t_vertical_nested_ref;
+DROP TABLE IF EXISTS t_vertical_collapsing;
+
+-- Nested subcolumns are gathered as one column group sharing the offsets stream.
+
+CREATE TABLE t_vertical_nested (k UInt64, s String, n Nested(a UInt32, b String))
+ENGINE = MergeTree ORDER BY k
+SETTINGS min_bytes_for_wide_part = 0,
+         vertical_merge_algorithm_min_rows_to_activate = 1,
+         vertical_merge_algorithm_min_columns_to_activate = 1;
+
+CREATE TABLE t_vertical_nested_ref (k UInt64, s String, n Nested(a UInt32, b String)) ENGINE = Memory;
+
+INSERT INTO t_vertical_nested SELECT number * 2, toString(number), range(number % 5), arrayMap(x -> toString(x), range(number % 5)) FROM numbers(10000);
+INSERT INTO t_vertical_nested SELECT number * 2 + 1, toString(number), range(number % 7), arrayMap(x -> toString(x), range(number % 7)) FROM numbers(10000);
+
+INSERT INTO t_vertical_nested_ref SELECT number * 2, toString(number), range(number % 5), arrayMap(x -> toString(x), range(number % 5)) FROM numbers(10000);
+INSERT INTO t_vertical_nested_ref SELECT number * 2 + 1, toString(number), range(number % 7), arrayMap(x -> toString(x), range(number % 7)) FROM numbers(10000);
+
+OPTIMIZE TABLE t_vertical_nested FINAL;
+
+SELECT count() FROM t_vertical_nested;
+SELECT count() FROM (SELECT * FROM t_vertical_nested EXCEPT SELECT * FROM t_vertical_nested_ref);
+SELECT count() FROM (SELECT * FROM t_vertical_nested_ref EXCEPT SELECT * FROM t_vertical_nested);
+
+-- Collapsing merge exercises the skip flags in the row-source mask.
+
+CREATE TABLE t_vertical_collapsing (k UInt64, sign Int8, arr Array(UInt32), s String)
+ENGINE = CollapsingMergeTree(sign) ORDER BY k
+SETTINGS min_bytes_for_wide_part = 0,
+         vertical_merge_algorithm_min_rows_to_activate = 1,
+         vertical_merge_algorithm_min_columns_to_activate = 1;
+
+INSERT INTO t_vertical_collapsing SELECT number, 1, range(number % 4), toString(number) FROM numbers(5000);
+INSERT INTO t_vertical_collapsing SELECT number, -1, range(number % 4), toString(number) FROM numbers(5000) WHERE number % 2 = 0;
+
+OPTIMIZE TABLE t_vertical_collapsing FINAL;
+
+SELECT count(), sum(k), sum(arraySum(arr)) FROM t_vertical_collapsing;
+
+DROP TABLE t_vertical_nested;
+DROP TABLE t_vertical_nested_ref;
+DROP TABLE t_vertical_collapsing;
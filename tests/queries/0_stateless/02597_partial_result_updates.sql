@@ -0,0 +1,9 @@
+-- Exercises the PartialResult protocol packets: the server periodically snapshots the
+-- intermediate aggregation state and sends it to the client, which must consume the
+-- packets without affecting the final result.
+
+SELECT sum(sipHash64(number)) > 0, count() FROM numbers_mt(20000000) GROUP BY number % 3 ORDER BY count()
+SETTINGS partial_result_update_duration_ms = 10, max_threads = 4;
+
+SELECT count(), sum(number) FROM numbers_mt(20000000)
+SETTINGS partial_result_update_duration_ms = 10;
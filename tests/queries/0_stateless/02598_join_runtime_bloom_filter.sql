@@ -0,0 +1,14 @@
+-- The runtime Bloom filter prunes probe rows before the hash table lookup
+-- and must never change the result of an INNER JOIN.
+
+SET join_algorithm = 'parallel_hash', max_threads = 4;
+
+SELECT count(), sum(l.number)
+FROM numbers(100000) AS l
+INNER JOIN (SELECT number * 10 AS key FROM numbers(1000)) AS r ON l.number = r.key
+SETTINGS join_runtime_bloom_filter_bytes = 0;
+
+SELECT count(), sum(l.number)
+FROM numbers(100000) AS l
+INNER JOIN (SELECT number * 10 AS key FROM numbers(1000)) AS r ON l.number = r.key
+SETTINGS join_runtime_bloom_filter_bytes = 65536;
@@ -0,0 +1,27 @@
+-- Tags: no-parallel
+-- no-parallel: the test inspects profile events of its own queries in query_log.
+
+DROP TABLE IF EXISTS t_02599_query_condition_cache;
+
+CREATE TABLE t_02599_query_condition_cache (k UInt64, v UInt64) ENGINE = MergeTree ORDER BY k;
+
+INSERT INTO t_02599_query_condition_cache SELECT number, number FROM numbers(1000000);
+
+SET use_query_condition_cache = 1;
+
+-- The first query remembers granules where the condition selected no rows,
+-- the second one skips them during index analysis.
+SELECT count() FROM t_02599_query_condition_cache WHERE v = 500000 SETTINGS max_threads = 1;
+SELECT count() FROM t_02599_query_condition_cache WHERE v = 500000 SETTINGS max_threads = 1;
+
+SYSTEM FLUSH LOGS;
+
+SELECT ProfileEvents['QueryConditionCacheHits'] > 0, read_rows < 1000000
+FROM system.query_log
+WHERE current_database = currentDatabase()
+    AND type = 'QueryFinish'
+    AND query LIKE 'SELECT count() FROM t_02599_query_condition_cache%'
+ORDER BY event_time_microseconds DESC
+LIMIT 1;
+
+DROP TABLE t_02599_query_condition_cache;
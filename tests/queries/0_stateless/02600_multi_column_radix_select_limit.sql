@@ -0,0 +1,15 @@
+-- Multi-column integer ORDER BY with LIMIT over blocks of >= 256 rows takes the MSD
+-- radix-select path in sortBlock when the limit is large enough (>= 2% of the block).
+
+SELECT groupArray((a, b)) = arraySlice(arraySort(groupArray((a, b))), 1, 100)
+FROM (SELECT toUInt16((number * 137) % 997) AS a, toInt8(number % 11 - 5) AS b FROM numbers(1000) ORDER BY a, b LIMIT 100)
+SETTINGS max_threads = 1, max_block_size = 65536;
+
+SELECT groupArray((a, b)) = arraySlice(arraySort(x -> (-x.1, x.2), groupArray((a, b))), 1, 100)
+FROM (SELECT toInt32((number * 137) % 997 - 500) AS a, toUInt8(number % 11) AS b FROM numbers(1000) ORDER BY a DESC, b ASC LIMIT 100)
+SETTINGS max_threads = 1, max_block_size = 65536;
+
+-- A tiny limit stays on the comparison partial sort; the order must be the same.
+SELECT groupArray((a, b)) = arraySlice(arraySort(groupArray((a, b))), 1, 5)
+FROM (SELECT toUInt16((number * 137) % 997) AS a, toInt8(number % 11 - 5) AS b FROM numbers(1000) ORDER BY a, b LIMIT 5)
+SETTINGS max_threads = 1, max_block_size = 65536;
@@ -0,0 +1,20 @@
+#!/usr/bin/env bash
+# Tags: no-fasttest
+
+CUR_DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+# shellcheck source=../shell_config.sh
+. "$CUR_DIR"/../shell_config.sh
+
+before=$(${CLICKHOUSE_CLIENT} --query "SELECT sum(value) FROM system.events WHERE event = 'PreparedStatementExecutions'")
+
+# Three executions of the same statement shape over one connection: the first one registers
+# the text, the following ones send only the hash and the bound parameter value.
+${CLICKHOUSE_CLIENT} --use_prepared_statements=1 --param_p="5" -n --query "
+    SELECT {p:UInt64} + 1;
+    SELECT {p:UInt64} + 1;
+    SELECT {p:UInt64} + 1;
+"
+
+after=$(${CLICKHOUSE_CLIENT} --query "SELECT sum(value) FROM system.events WHERE event = 'PreparedStatementExecutions'")
+
+echo $((after - before >= 2))
@@ -0,0 +1,39 @@
+-- Tags: no-parallel
+
+DROP TABLE IF EXISTS t_column_stats;
+
+CREATE TABLE t_column_stats (k UInt64, v String, n Nullable(Float64))
+ENGINE = MergeTree ORDER BY k
+SETTINGS enable_column_statistics = 1;
+
+INSERT INTO t_column_stats SELECT number, toString(number % 100), if(number % 10 = 0, NULL, number / 2) FROM numbers(1000);
+INSERT INTO t_column_stats SELECT number + 1000, toString(number % 100), NULL FROM numbers(1000);
+
+-- Distinct counts are HyperLogLog estimates (~1.6% error), so check ranges, not exact values.
+SELECT column, distinct_count BETWEEN 0.9 * expected AND 1.1 * expected, null_count, length(histogram)
+FROM system.column_statistics
+INNER JOIN (SELECT 'k' AS column, 2000 AS expected UNION ALL SELECT 'v', 100 UNION ALL SELECT 'n', 900) AS e USING (column)
+WHERE database = currentDatabase() AND table = 't_column_stats'
+ORDER BY column;
+
+-- A merge combines the sketches of the input parts instead of rescanning the rows.
+OPTIMIZE TABLE t_column_stats FINAL;
+
+SELECT column, distinct_count BETWEEN 0.9 * expected AND 1.1 * expected, null_count, length(histogram)
+FROM system.column_statistics
+INNER JOIN (SELECT 'k' AS column, 2000 AS expected UNION ALL SELECT 'v', 100 UNION ALL SELECT 'n', 900) AS e USING (column)
+WHERE database = currentDatabase() AND table = 't_column_stats'
+ORDER BY column;
+
+-- Mutations drop the statistics of rewritten parts conservatively...
+ALTER TABLE t_column_stats UPDATE v = '' WHERE k = 0 SETTINGS mutations_sync = 2;
+SELECT count() FROM system.column_statistics WHERE database = currentDatabase() AND table = 't_column_stats';
+
+-- ...and the next merge recollects them from the rows.
+OPTIMIZE TABLE t_column_stats FINAL;
+SELECT column, null_count, length(histogram)
+FROM system.column_statistics
+WHERE database = currentDatabase() AND table = 't_column_stats'
+ORDER BY column;
+
+DROP TABLE t_column_stats;
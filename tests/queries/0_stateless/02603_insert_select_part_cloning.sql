@@ -0,0 +1,31 @@
+DROP TABLE IF EXISTS t_clone_src;
+DROP TABLE IF EXISTS t_clone_dst;
+
+CREATE TABLE t_clone_src (k UInt64, v String) ENGINE = MergeTree PARTITION BY k % 2 ORDER BY k;
+CREATE TABLE t_clone_dst (k UInt64, v String) ENGINE = MergeTree PARTITION BY k % 2 ORDER BY k;
+
+INSERT INTO t_clone_src SELECT number, toString(number) FROM numbers(100);
+INSERT INTO t_clone_src SELECT number + 100, toString(number) FROM numbers(100);
+
+SET optimize_insert_select_with_part_cloning = 1;
+
+-- A bare SELECT * between tables of the same structure attaches clones of the source parts.
+INSERT INTO t_clone_dst SELECT * FROM t_clone_src;
+
+SELECT count(), sum(k) FROM t_clone_dst;
+-- Every source part was cloned one to one: 2 inserts over 2 partitions give 4 parts.
+SELECT count() FROM system.parts WHERE database = currentDatabase() AND table = 't_clone_dst' AND active;
+
+-- A WHERE clause (partial selection) falls back to row processing and still works.
+TRUNCATE TABLE t_clone_dst;
+INSERT INTO t_clone_dst SELECT * FROM t_clone_src WHERE k < 10;
+SELECT count(), sum(k) FROM t_clone_dst;
+
+-- A different structure falls back to row processing as well.
+DROP TABLE t_clone_dst;
+CREATE TABLE t_clone_dst (k UInt64, v String) ENGINE = MergeTree ORDER BY k;
+INSERT INTO t_clone_dst SELECT * FROM t_clone_src;
+SELECT count(), sum(k) FROM t_clone_dst;
+
+DROP TABLE t_clone_src;
+DROP TABLE t_clone_dst;
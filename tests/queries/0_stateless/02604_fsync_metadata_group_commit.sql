@@ -0,0 +1,18 @@
+-- Smoke test: DDL works the same when metadata fsyncs are group-committed.
+SET fsync_metadata_group_commit = 1;
+
+DROP TABLE IF EXISTS t_group_commit_1;
+DROP TABLE IF EXISTS t_group_commit_2;
+
+CREATE TABLE t_group_commit_1 (k UInt64) ENGINE = MergeTree ORDER BY k;
+CREATE TABLE t_group_commit_2 (k UInt64) ENGINE = MergeTree ORDER BY k;
+
+INSERT INTO t_group_commit_1 VALUES (1);
+INSERT INTO t_group_commit_2 VALUES (2);
+
+SELECT count() FROM system.tables WHERE database = currentDatabase() AND name LIKE 't_group_commit_%';
+SELECT k FROM t_group_commit_1;
+SELECT k FROM t_group_commit_2;
+
+DROP TABLE t_group_commit_1;
+DROP TABLE t_group_commit_2;
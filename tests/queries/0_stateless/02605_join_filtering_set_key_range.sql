@@ -0,0 +1,26 @@
+DROP TABLE IF EXISTS t_range_l;
+DROP TABLE IF EXISTS t_range_r;
+
+-- Mostly disjoint key ranges: only keys 99000..99999 can match.
+CREATE TABLE t_range_l (x UInt64, y UInt64) ENGINE = MergeTree ORDER BY y
+AS SELECT number AS x, number * 2 AS y FROM numbers(100000);
+
+CREATE TABLE t_range_r (x UInt64, y UInt64) ENGINE = MergeTree ORDER BY y
+AS SELECT number + 99000 AS x, number * 3 AS y FROM numbers(100000);
+
+SET join_algorithm = 'full_sorting_merge';
+
+-- Force the exact sets to overflow, so only the key range of the other side is left for filtering.
+SET max_rows_in_set_to_optimize_join = 1000;
+
+SELECT count(), sum(t_range_l.x) FROM t_range_l JOIN t_range_r ON t_range_l.x = t_range_r.x;
+SELECT count() FROM t_range_l JOIN t_range_r ON t_range_l.x = t_range_r.x WHERE t_range_l.y % 4 == 0;
+
+-- The same result with the optimization disabled.
+SET max_rows_in_set_to_optimize_join = 0;
+
+SELECT count(), sum(t_range_l.x) FROM t_range_l JOIN t_range_r ON t_range_l.x = t_range_r.x;
+SELECT count() FROM t_range_l JOIN t_range_r ON t_range_l.x = t_range_r.x WHERE t_range_l.y % 4 == 0;
+
+DROP TABLE t_range_l;
+DROP TABLE t_range_r;